@@ -0,0 +1,90 @@
+#ifndef HEADER_fd_src_ballet_reedsol_fd_reedsol_h
+#define HEADER_fd_src_ballet_reedsol_fd_reedsol_h
+
+/* fd_reedsol provides the systematic Reed-Solomon erasure code used to
+   protect shred FEC sets.  An FEC set of d data shreds is extended with
+   p parity ("coding") shreds such that any d of the d+p shreds suffice
+   to recover the rest.
+
+   The code is bit-for-bit compatible with the one used by Solana
+   validators (the reed-solomon-erasure crate over GF(2^8) with
+   polynomial 0x11d).  There, the encoding matrix is a (d+p) x d
+   Vandermonde matrix (row r is r^0 ... r^(d-1)) right multiplied by the
+   inverse of its top d x d block.  Equivalently, shred r of the set is
+   P(r), where P is the unique polynomial of degree less than d with
+   P(j) = data shred j for j in [0,d).  Both encoding and recovery are
+   thus evaluations of an interpolating polynomial: the coefficients are
+   cheap to compute directly in Lagrange form (no matrix inversion or
+   cache of inverted matrices is needed) and the bulk of the work is a
+   dense GF(2^8) matrix-vector product over the shred bytes.  On AVX
+   targets, GF(2^8) multiplication by a constant is done 32 (AVX2) or 64
+   (AVX-512) bytes at a time with a pair of 16-entry PSHUFB nibble
+   lookup tables.
+
+   The shred byte ranges covered by the code (the "erasure shards") are
+   defined by the shred format; fd_reedsol just operates on equal sized
+   byte arrays.  Shred i of an FEC set is data shred i for i in [0,d)
+   and parity shred i-d for i in [d,d+p). */
+
+#include "../fd_ballet_base.h"
+
+/* FD_REEDSOL_{DATA,PARITY}_SHREDS_MAX give the largest number of data
+   and parity shreds in an FEC set supported.  These match the largest
+   FEC sets accepted by Solana validators (leaders currently produce at
+   most 32 data and 32 parity shreds per set). */
+
+#define FD_REEDSOL_DATA_SHREDS_MAX   (67UL)
+#define FD_REEDSOL_PARITY_SHREDS_MAX (67UL)
+
+/* FD_REEDSOL_{SUCCESS,ERR_*} give the return codes of
+   fd_reedsol_recover. */
+
+#define FD_REEDSOL_SUCCESS     (0)  /* Recovery succeeded */
+#define FD_REEDSOL_ERR_PARTIAL (-1) /* Fewer than data_shred_cnt shreds of the set are available */
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_reedsol_encode computes the parity shreds of an FEC set.
+   data_shred[i] for i in [0,data_shred_cnt) points to the shred_sz
+   bytes covered by the code in data shred i and parity_shred[i] for i
+   in [0,parity_shred_cnt) points to where to store the shred_sz bytes
+   of parity shred i.  Assumes data_shred_cnt is in
+   [1,FD_REEDSOL_DATA_SHREDS_MAX], parity_shred_cnt is in
+   [0,FD_REEDSOL_PARITY_SHREDS_MAX] and none of the parity regions
+   overlap each other or the data regions.  There are no alignment
+   requirements. */
+
+void
+fd_reedsol_encode( ulong                 shred_sz,
+                   uchar const * const * data_shred,
+                   ulong                 data_shred_cnt,
+                   uchar * const *       parity_shred,
+                   ulong                 parity_shred_cnt );
+
+/* fd_reedsol_recover rebuilds the erased shreds of an FEC set.
+   shred[i] for i in [0,data_shred_cnt+parity_shred_cnt) points to the
+   shred_sz bytes covered by the code in shred i of the set (data shreds
+   first, then parity shreds).  erased[i] is non-zero if shred i was not
+   received, in which case the memory pointed to by shred[i] is
+   overwritten with its contents on success.  Both data and parity
+   shreds are rebuilt (rebuilt parity shreds are needed, for example,
+   to retransmit or to verify a Merkle commitment to the set).
+
+   Returns FD_REEDSOL_SUCCESS on success and FD_REEDSOL_ERR_PARTIAL if
+   fewer than data_shred_cnt shreds are available (in which case no
+   shreds are modified).  The rebuilt shreds are derived from the
+   lowest indexed data_shred_cnt available shreds; any other available
+   shreds are not inspected (in particular, it is not detected if they
+   are inconsistent with the rest of the set).  Same assumptions on
+   counts, overlap and alignment as fd_reedsol_encode. */
+
+int
+fd_reedsol_recover( ulong           shred_sz,
+                    uchar * const * shred,
+                    uchar const *   erased,
+                    ulong           data_shred_cnt,
+                    ulong           parity_shred_cnt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_reedsol_fd_reedsol_h */
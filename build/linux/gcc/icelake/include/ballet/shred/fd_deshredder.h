@@ -0,0 +1,176 @@
+#ifndef HEADER_fd_src_ballet_shred_fd_deshredder_h
+#define HEADER_fd_src_ballet_shred_fd_deshredder_h
+
+/* fd_deshredder turns incoming shreds back into entry batches, the
+   receive side counterpart of fd_shredder.
+
+   Shreds are buffered per FEC set, keyed by (slot,fec_set_idx), in a
+   pool of FEC set buffers that is sized at creation.  Each set tracks
+   which of its data and coding shreds are present.  As soon as a set
+   with missing data shreds has at least as many shreds as it has data
+   shreds, the missing shreds are recovered (fd_reedsol) and the set's
+   Merkle tree is rebuilt and checked against the set's Merkle root
+   (a set that does not check out is dropped).
+
+   Data shreds of a slot are consumed in index order.  An entry batch is
+   complete when all the data shreds from the end of the previous batch
+   up to the next data shred with FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE
+   are present.  Completed batches are emitted in order by
+   fd_deshredder_next_batch (payloads concatenated) and the FEC sets
+   they span are returned to the pool.
+
+   Memory is bounded regardless of what is received:
+
+   - Only shreds for slots in [slot_min,slot_min+slot_max) are accepted
+     (slot_min is moved forward by the caller with fd_deshredder_advance,
+     typically as the root advances) and
+
+   - when the pool is out of FEC set buffers, all the buffered sets of
+     the oldest slot are evicted to make room.  The pool should be sized
+     for the sets of all entry batches in flight (a slot's batches can
+     span a few FEC sets each) such that this only happens under
+     duress.
+
+   The deshredder checks that the shreds of an FEC set are consistent
+   with each other (signature, Merkle root, counts, indices, sizes, ...)
+   but does not verify signatures or inclusion proofs.  Shreds should be
+   authenticated before being inserted (e.g. by the shred ingest tile).
+   Only Merkle shreds are supported.  A deshredder can be located in a
+   workspace but should only be used by one thread at a time.
+
+   Typical usage:
+
+     ... for each authenticated shred received
+
+     int err = fd_deshredder_insert( deshredder, shred );
+     ... err is FD_DESHREDDER_SUCCESS or the reason the shred was
+     ... dropped
+
+     fd_shredder_batch_meta_t meta[1];
+     ulong batch_sz;
+     while( fd_deshredder_next_batch( deshredder, batch, batch_max, &batch_sz, meta ) ) {
+       ... batch_sz bytes at batch are the next entry batch of slot
+       ... meta->slot
+     } */
+
+#include "fd_shredder.h"
+
+/* FD_DESHREDDER_DATA_SHREDS_MAX and FD_DESHREDDER_PARITY_SHREDS_MAX are
+   the maximum number of data and coding shreds in an FEC set.  Sets
+   claiming more are rejected. */
+
+#define FD_DESHREDDER_DATA_SHREDS_MAX   FD_SHREDDER_DATA_SHREDS_PER_FEC_SET
+#define FD_DESHREDDER_PARITY_SHREDS_MAX FD_SHREDDER_PARITY_SHREDS_MAX
+
+/* FD_DESHREDDER_SLOT_DATA_SHREDS_MAX is the maximum number of data
+   shreds in a slot (MAX_DATA_SHREDS_PER_SLOT in the Solana Labs
+   validator).  FD_DESHREDDER_SLOT_MAX bounds slot numbers. */
+
+#define FD_DESHREDDER_SLOT_DATA_SHREDS_MAX (32768UL)
+#define FD_DESHREDDER_SLOT_MAX             (1UL<<48)
+
+/* fd_deshredder_insert return codes */
+
+#define FD_DESHREDDER_SUCCESS        ( 0) /* Shred buffered (or recovered, redundant coding shreds included) */
+#define FD_DESHREDDER_ERR_INVALID    (-1) /* Malformed shred, unsupported variant or inconsistent with its FEC set */
+#define FD_DESHREDDER_ERR_DUPLICATE  (-2) /* Shred already buffered */
+#define FD_DESHREDDER_ERR_SLOT       (-3) /* Slot outside [slot_min,slot_min+slot_max) */
+#define FD_DESHREDDER_ERR_STALE      (-4) /* Shred of data already emitted (or of a complete slot) */
+
+#define FD_DESHREDDER_ALIGN (128UL)
+
+struct fd_deshredder_private;
+typedef struct fd_deshredder_private fd_deshredder_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_deshredder_{align,footprint} return the alignment and footprint
+   required for a memory region to be used as a deshredder with a pool
+   of set_max FEC set buffers and a window of slot_max slots.  footprint
+   returns 0 if set_max is not in [1,2^20] or slot_max is not in
+   [1,2^20] (the footprint is ~77 KiB per FEC set buffer).
+
+   fd_deshredder_new formats a memory region with the appropriate
+   alignment and footprint into a deshredder with no shreds buffered and
+   slot_min==slot_min0.  Returns shmem on success and NULL on failure
+   (logs details).  Caller is not joined on return.
+   fd_deshredder_{join,leave,delete} follow the usual conventions (see
+   fd_ed25519_pubkey_cache). */
+
+FD_FN_CONST ulong
+fd_deshredder_align( void );
+
+FD_FN_CONST ulong
+fd_deshredder_footprint( ulong set_max,
+                         ulong slot_max );
+
+void *
+fd_deshredder_new( void * shmem,
+                   ulong  set_max,
+                   ulong  slot_max,
+                   ulong  slot_min0 );
+
+fd_deshredder_t * fd_deshredder_join  ( void *            shdeshredder );
+void *            fd_deshredder_leave ( fd_deshredder_t * deshredder   );
+void *            fd_deshredder_delete( void *            shdeshredder );
+
+/* fd_deshredder_insert buffers the FD_SHRED_SZ byte shred pointed to by
+   shred (copied, no alignment requirements).  Returns
+   FD_DESHREDDER_SUCCESS if the shred was buffered and an
+   FD_DESHREDDER_ERR_* code (without any change to the deshredder
+   besides evictions) if the shred was dropped.  The exception is a
+   shred that allows recovering its FEC set but the recovered set does
+   not match the set's Merkle root, in which case the whole set is
+   dropped and FD_DESHREDDER_ERR_INVALID is returned.  Batches that the
+   shred completes are available from fd_deshredder_next_batch
+   immediately after. */
+
+int
+fd_deshredder_insert( fd_deshredder_t * deshredder,
+                      uchar const *     shred );
+
+/* fd_deshredder_next_batch emits the next complete entry batch of the
+   slot of the last shred successfully inserted.  Should be called after
+   each successful insert until it returns NULL.  On success, the batch
+   payload is copied to batch (up to batch_max bytes), its size is
+   stored at *_batch_sz, meta describes the batch (as it was given to
+   the shredder, ref_tick and block_complete from the batch's last
+   shred) and meta is returned.  Returns NULL if there is no complete
+   batch.  Batches larger than batch_max are dropped (counted in
+   drop_cnt).  A batch with meta->block_complete set is the last of its
+   slot, further shreds of that slot are rejected as stale. */
+
+fd_shredder_batch_meta_t *
+fd_deshredder_next_batch( fd_deshredder_t *          deshredder,
+                          uchar *                    batch,
+                          ulong                      batch_max,
+                          ulong *                    _batch_sz,
+                          fd_shredder_batch_meta_t * meta );
+
+/* fd_deshredder_advance moves the slot window forward such that slots
+   before slot_min are not accepted anymore, dropping everything
+   buffered for them.  slot_min smaller than the current slot_min is
+   ignored.  Returns deshredder. */
+
+fd_deshredder_t *
+fd_deshredder_advance( fd_deshredder_t * deshredder,
+                       ulong             slot_min );
+
+/* Accessors.  fd_deshredder_{set_max,slot_max,slot_min} return the
+   corresponding parameters.  fd_deshredder_set_cnt returns the number
+   of FEC set buffers in use.  fd_deshredder_{recover_cnt,evict_cnt,
+   drop_cnt} return the number of FEC sets recovered, the number of FEC
+   sets evicted to make room and the number of FEC sets and batches
+   dropped as invalid or too large since the deshredder was created. */
+
+FD_FN_PURE ulong fd_deshredder_set_max    ( fd_deshredder_t const * deshredder );
+FD_FN_PURE ulong fd_deshredder_slot_max   ( fd_deshredder_t const * deshredder );
+FD_FN_PURE ulong fd_deshredder_slot_min   ( fd_deshredder_t const * deshredder );
+FD_FN_PURE ulong fd_deshredder_set_cnt    ( fd_deshredder_t const * deshredder );
+FD_FN_PURE ulong fd_deshredder_recover_cnt( fd_deshredder_t const * deshredder );
+FD_FN_PURE ulong fd_deshredder_evict_cnt  ( fd_deshredder_t const * deshredder );
+FD_FN_PURE ulong fd_deshredder_drop_cnt   ( fd_deshredder_t const * deshredder );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_shred_fd_deshredder_h */
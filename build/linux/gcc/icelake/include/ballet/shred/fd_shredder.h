@@ -0,0 +1,202 @@
+#ifndef HEADER_fd_src_ballet_shred_fd_shredder_h
+#define HEADER_fd_src_ballet_shred_fd_shredder_h
+
+/* fd_shredder turns serialized entry batches into signed Merkle data
+   and coding shreds, the leader side of block distribution.
+
+   An entry batch is split into FEC sets of up to
+   FD_SHREDDER_DATA_SHREDS_PER_FEC_SET data shreds.  The number of
+   coding shreds of an FEC set is a function of its number of data
+   shreds (fd_shredder_parity_shred_cnt, matching Solana leaders, which
+   give small sets proportionally more parity).  For each FEC set,
+   the shredder:
+
+   - writes the data shreds (headers, payload and zero padding),
+   - computes the coding shreds from the data shreds' erasure shards
+     (fd_reedsol),
+   - builds a Merkle tree (fd_bmtree20) over the shreds of the set
+     (data shreds first, each leaf is a shred from the end of its
+     signature to the start of its Merkle nodes),
+   - signs the Merkle root with the leader's key and
+   - writes the signature, the root and the shred's inclusion proof
+     into every shred of the set.
+
+   The shreds are written in place into caller provided FD_SHRED_SZ
+   byte regions (e.g. dcache chunks about to be published) and the only
+   copy of the entry batch is the one into the data shred payloads.
+
+   Typical usage:
+
+     fd_shredder_t _shredder[1];
+     fd_shredder_t * shredder = fd_shredder_join( fd_shredder_new( _shredder, public_key, private_key ) );
+
+     ... for each entry batch
+
+     fd_shredder_init_batch( shredder, batch, batch_sz, meta );
+     for(;;) {
+       ... data_shred[i] for i in [0,FD_SHREDDER_DATA_SHREDS_PER_FEC_SET) and
+       ... parity_shred[i] for i in [0,FD_SHREDDER_PARITY_SHREDS_MAX) point
+       ... to where the next shreds should go
+       fd_shredder_fec_set_t fec[1];
+       if( !fd_shredder_next_fec_set( shredder, data_shred, parity_shred, fec ) ) break;
+       ... publish the first fec->data_shred_cnt data shreds and the
+       ... first fec->parity_shred_cnt parity shreds
+     }
+
+     fd_shredder_delete( fd_shredder_leave( shredder ) ); */
+
+#include "fd_shred.h"
+#include "../ed25519/fd_ed25519.h"
+#include "../bmtree/fd_bmtree.h"
+
+/* FD_SHREDDER_DATA_SHREDS_PER_FEC_SET is the number of data shreds in
+   all but the last FEC set of an entry batch.  FD_SHREDDER_PARITY_
+   SHREDS_MAX is the maximum number of coding shreds in an FEC set.  The
+   last FEC set of a batch has as few data shreds as fit the rest of the
+   batch. */
+
+#define FD_SHREDDER_DATA_SHREDS_PER_FEC_SET (32UL)
+#define FD_SHREDDER_PARITY_SHREDS_MAX       (32UL)
+
+/* FD_SHREDDER_{ALIGN,FOOTPRINT} give the alignment and footprint of a
+   fd_shredder_t.  Like fd_sha512_t, declaration friendly. */
+
+#define FD_SHREDDER_ALIGN     (128UL)
+#define FD_SHREDDER_FOOTPRINT (4480UL)
+
+#define FD_SHREDDER_MAGIC (0xF17EDA2CE5E2ED00UL) /* FIREDANCE SHREDDER V0 */
+
+/* fd_shredder_batch_meta_t describes the entry batch being shredded. */
+
+struct fd_shredder_batch_meta {
+  ulong  slot;           /* Slot the batch belongs to */
+  ushort parent_off;     /* Slot number difference to the parent block, positive */
+  ushort version;        /* Shred version of the cluster */
+  uchar  ref_tick;       /* Tick of the slot the batch was produced at (saturated to FD_SHRED_DATA_REF_TICK_MASK) */
+  uchar  block_complete; /* Non-zero if the batch is the last of the slot */
+};
+
+typedef struct fd_shredder_batch_meta fd_shredder_batch_meta_t;
+
+/* fd_shredder_fec_set_t describes an FEC set produced by
+   fd_shredder_next_fec_set. */
+
+struct fd_shredder_fec_set {
+  ulong data_shred_cnt;   /* In [1,FD_SHREDDER_DATA_SHREDS_PER_FEC_SET] */
+  ulong parity_shred_cnt; /* In [1,FD_SHREDDER_PARITY_SHREDS_MAX] */
+  uint  fec_set_idx;      /* Index of the set's first data shred in the slot */
+  uchar merkle_root[ FD_SHRED_MERKLE_NODE_SZ ];
+};
+
+typedef struct fd_shredder_fec_set fd_shredder_fec_set_t;
+
+/* A fd_shredder_t should be treated as an opaque handle (it isn't to
+   facilitate compile time declarations).  Note that it holds a copy of
+   the leader's private key (fd_shredder_delete wipes it). */
+
+struct __attribute__((aligned(FD_SHREDDER_ALIGN))) fd_shredder_private {
+  fd_sha512_t sha[1];       /* Used for signing */
+
+  ulong magic;              /* ==FD_SHREDDER_MAGIC */
+  uchar public_key [ 32 ];
+  uchar private_key[ 32 ];
+
+  /* Current batch */
+
+  uchar const *            batch;
+  ulong                    batch_sz;
+  ulong                    batch_off;   /* Bytes of the batch shredded so far */
+  ulong                    fec_set_rem; /* FEC sets of the batch not yet produced */
+  fd_shredder_batch_meta_t meta;
+
+  /* Position in the slot */
+
+  ulong slot;                /* ULONG_MAX if no batch was ever started */
+  uint  data_idx;            /* Index of the next data shred in the slot */
+  uint  parity_idx;          /* Index of the next coding shred in the slot */
+
+  /* Merkle tree of the current FEC set (fd_bmtree20_tree_build layout,
+     127 nodes for the largest sets of 64 shreds) */
+
+  fd_bmtree20_node_t tree[ 127 ];
+};
+
+typedef struct fd_shredder_private fd_shredder_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_shredder_parity_shred_cnt returns the number of coding shreds in
+   an FEC set with data_shred_cnt data shreds, data_shred_cnt in
+   [1,FD_SHREDDER_DATA_SHREDS_PER_FEC_SET].  This is protocol defined
+   (the table gives the total number of shreds in the set, it is
+   ERASURE_BATCH_SIZE in the Solana Labs validator). */
+
+FD_FN_CONST static inline ulong
+fd_shredder_parity_shred_cnt( ulong data_shred_cnt ) {
+  static uchar const shred_cnt[ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+1UL ] = {
+     0, 18, 20, 22, 23, 25, 27, 28, 30, 32, 33, 35, 36, 38, 39, 41, 42,
+    43, 45, 46, 48, 49, 51, 52, 53, 55, 56, 58, 59, 60, 62, 63, 64
+  };
+  return (ulong)shred_cnt[ data_shred_cnt ] - data_shred_cnt;
+}
+
+/* fd_shredder_{align,footprint} return FD_SHREDDER_{ALIGN,FOOTPRINT}.
+
+   fd_shredder_new formats a memory region with suitable alignment and
+   footprint as a shredder signing with the given Ed25519 key pair
+   (32 bytes each, copied).  Returns shmem on success and NULL on
+   failure (logs details).  fd_shredder_{join,leave,delete} follow the
+   usual conventions (see fd_sha512); delete wipes the private key. */
+
+FD_FN_CONST ulong fd_shredder_align    ( void );
+FD_FN_CONST ulong fd_shredder_footprint( void );
+
+void *
+fd_shredder_new( void *       shmem,
+                 void const * public_key,
+                 void const * private_key );
+
+fd_shredder_t * fd_shredder_join  ( void *          shshredder );
+void *          fd_shredder_leave ( fd_shredder_t * shredder   );
+void *          fd_shredder_delete( void *          shshredder );
+
+/* fd_shredder_count_{fec_sets,data_shreds,parity_shreds} return the
+   number of FEC sets, data shreds and coding shreds that shredding a
+   batch of batch_sz bytes produces.  An empty batch produces one data
+   shred without payload. */
+
+FD_FN_CONST ulong fd_shredder_count_fec_sets     ( ulong batch_sz );
+FD_FN_CONST ulong fd_shredder_count_data_shreds  ( ulong batch_sz );
+FD_FN_CONST ulong fd_shredder_count_parity_shreds( ulong batch_sz );
+
+/* fd_shredder_init_batch starts shredding the batch_sz byte entry batch
+   pointed to by batch.  The shredder has a read interest in batch until
+   the batch is fully shredded.  Shred indices continue from the
+   previous batch if meta->slot is the slot of the previous batch and
+   start over at zero otherwise.  Returns shredder. */
+
+fd_shredder_t *
+fd_shredder_init_batch( fd_shredder_t *                  shredder,
+                        void const *                     batch,
+                        ulong                            batch_sz,
+                        fd_shredder_batch_meta_t const * meta );
+
+/* fd_shredder_next_fec_set produces the next FEC set of the current
+   batch.  data_shred[i] for i in [0,FD_SHREDDER_DATA_SHREDS_PER_FEC_SET)
+   and parity_shred[i] for i in [0,FD_SHREDDER_PARITY_SHREDS_MAX) point
+   to non-overlapping FD_SHRED_SZ byte regions (no alignment
+   requirements).  On return, the first fec->data_shred_cnt data shred
+   regions and the first fec->parity_shred_cnt parity shred regions
+   hold the complete, signed shreds of the set (the rest are
+   untouched).  Returns fec on success and NULL (without touching any
+   region) if the batch has been fully shredded. */
+
+fd_shredder_fec_set_t *
+fd_shredder_next_fec_set( fd_shredder_t *         shredder,
+                          uchar * const *         data_shred,
+                          uchar * const *         parity_shred,
+                          fd_shredder_fec_set_t * fec );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_shred_fd_shredder_h */
@@ -0,0 +1,180 @@
+#ifndef HEADER_fd_src_disco_shred_fd_shred_ingest_h
+#define HEADER_fd_src_disco_shred_fd_shred_ingest_h
+
+/* fd_shred_ingest provides services to authenticate and deduplicate a
+   stream of raw shreds (e.g. as received from the network or replayed
+   from a capture) before they are handed to the rest of the validator
+   (e.g. a fd_deshredder). */
+
+#include "../fd_disco_base.h"
+#include "../../ballet/shred/fd_shred.h"
+#include "../../ballet/sha512/fd_sha512.h"
+
+#if FD_HAS_HOSTED && FD_HAS_X86
+
+/* Beyond the standard FD_CNC_SIGNAL_HALT, FD_SHRED_INGEST_CNC_SIGNAL_ACK
+   can be raised by a cnc thread with an open command session while the
+   shred ingest is in the RUN state.  The shred ingest will transition
+   from ACK->RUN the next time it processes cnc signals to indicate it is
+   running normally.  If a signal other than ACK, HALT, or RUN is raised,
+   it will be logged as unexpected and transitioned by back to RUN. */
+
+#define FD_SHRED_INGEST_CNC_SIGNAL_ACK (4UL)
+
+/* A fd_shred_ingest_tile will use the fseq and cnc application regions
+   to accumulate flow control diagnostics in the standard ways (the
+   in_fseq pub / filt counters count shreds forwarded / dropped).  It
+   additionally will accumulate to the cnc application region the
+   following tile specific counters:
+
+     PARSE_FILT_CNT is the number of frags dropped because they were not a well formed Merkle shred
+     DUP_FILT_CNT   is the number of shreds dropped as duplicates of a recently forwarded shred
+     PROOF_FILT_CNT is the number of shreds dropped because their inclusion proof did not match their Merkle root
+     SIG_FILT_CNT   is the number of shreds dropped because the leader's signature of their Merkle root did not verify
+     SIG_CNT        is the number of signature verifications done (about one per FEC set)
+     SIG_HIT_CNT    is the number of shreds authenticated with a recently verified Merkle root (no verification)
+
+   As such, the cnc app region must be at least 64B in size.
+
+   Except for IN_BACKP, none of the diagnostics are cleared at
+   tile startup (as such that they can be accumulated over multiple
+   runs).  Clearing is up to monitoring scripts. */
+
+#define FD_SHRED_INGEST_CNC_DIAG_PARSE_FILT_CNT (2UL) /* On 1st cache line of app region, updated by producer, frequently */
+#define FD_SHRED_INGEST_CNC_DIAG_DUP_FILT_CNT   (3UL) /* ", frequently */
+#define FD_SHRED_INGEST_CNC_DIAG_PROOF_FILT_CNT (4UL) /* ", rarely */
+#define FD_SHRED_INGEST_CNC_DIAG_SIG_FILT_CNT   (5UL) /* ", rarely */
+#define FD_SHRED_INGEST_CNC_DIAG_SIG_CNT        (6UL) /* ", frequently */
+#define FD_SHRED_INGEST_CNC_DIAG_SIG_HIT_CNT    (7UL) /* ", frequently */
+
+/* FD_SHRED_INGEST_TILE_OUT_MAX is the maximum number of reliable
+   outputs a shred ingest tile can have.  This limit is more or less
+   arbitrary from a functional correctness POV.  It mostly exists to set
+   some practical upper bounds for things like scratch footprint. */
+
+#define FD_SHRED_INGEST_TILE_OUT_MAX FD_FRAG_META_ORIG_MAX
+
+/* FD_SHRED_INGEST_TILE_SET_MAX is the number of recently verified FEC
+   set Merkle roots remembered by a shred ingest tile.  This should
+   comfortably cover the FEC sets in flight (a slot is typically a few
+   tens of FEC sets).  Integer power of 2. */
+
+#define FD_SHRED_INGEST_TILE_SET_MAX (1024UL)
+
+/* FD_SHRED_INGEST_TILE_SCRATCH_{ALIGN,FOOTPRINT} specify the alignment
+   and footprint needed for a shred ingest tile scratch region that can
+   support out_cnt reliable outputs.  ALIGN is an integer power of 2 of
+   at least double cache line to mitigate various kinds of false
+   sharing.  FOOTPRINT will be an integer multiple of ALIGN.  out_cnt is
+   assumed to be valid (i.e. at most FD_SHRED_INGEST_TILE_OUT_MAX).
+   These are provided to facilitate compile time declarations. */
+
+#define FD_SHRED_INGEST_TILE_SCRATCH_ALIGN (128UL)
+#define FD_SHRED_INGEST_TILE_SCRATCH_FOOTPRINT( out_cnt )  \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND(      \
+  FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                        \
+    FD_FCTL_ALIGN,   FD_FCTL_FOOTPRINT( (out_cnt) )     ), \
+    FD_SHA512_ALIGN, FD_SHA512_FOOTPRINT                ), \
+    128UL,           FD_SHRED_INGEST_TILE_SET_MAX*128UL ), \
+    FD_SHRED_INGEST_TILE_SCRATCH_ALIGN )
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_shred_ingest_tile consumes a stream of raw shreds described by
+   in_mcache and republishes the shreds that are authentic and not
+   duplicates as a tango fragment stream from origin orig into the given
+   mcache and dcache.  The tile can send to out_cnt reliable consumers
+   and an arbitrary number of unreliable consumers.
+
+   Each ingress frag should hold a shred preceded by hdr_sz bytes of
+   headers (e.g. 42 for shreds replayed from an Ethernet / IPv4 / UDP
+   capture, 0 for bare shreds).  The tile is a reliable consumer of the
+   ingress.  Frags that are not exactly hdr_sz+FD_SHRED_SZ bytes, that
+   are not a Merkle shred or that are otherwise malformed are dropped
+   (legacy shreds are not supported).  The remaining shreds are
+   authenticated against leader, the 32 byte public key of the leader
+   whose shreds are accepted:
+
+   - The shred's inclusion proof is checked against the Merkle root it
+     carries (a few SHA-256 compressions per shred) and
+
+   - the leader's signature of that root is verified.  As the signature
+     of a Merkle shred covers the root of its FEC set and not the shred
+     itself, this is done once per FEC set: the tile remembers the
+     signature and root of the most recently verified FEC set for up to
+     FD_SHRED_INGEST_TILE_SET_MAX (slot,fec_set_idx) pairs and shreds
+     that match a remembered set skip the verification.
+
+   A shred is a duplicate if a shred with the same (slot,idx,type) was
+   recently forwarded, as tracked by tcache.  Only authenticated shreds
+   are inserted into the tcache such that forged shreds cannot be used
+   to suppress the genuine ones.
+
+   Forwarded shreds are published FD_SHRED_SZ bytes each (headers
+   stripped, such that the dcache mtu should be at least FD_SHRED_SZ).
+   The frag sig is a hash of (slot,idx,type) (the tcache tag), tsorig is
+   passed through from the ingress and tspub is when the shred was
+   forwarded.
+
+   When this is called, the cnc should be in the BOOT state.  Returns 0
+   on a successful run of the shred ingest tile.  That is, the tile
+   booted successfully (transitioning the cnc from BOOT->RUN), ran
+   (handling any application specific cnc signals while running), and
+   (after receiving a HALT signal) halted successfully (transitioning
+   the cnc from HALT->BOOT before return).  Returns a non-zero error
+   code if the tile fails to boot up (logs details ... the cnc will not
+   be transitioned from its original state and thus is likely bootable
+   again if its original state was BOOT).  For maximally robust
+   operation in the current implementation, all reliable consumers
+   should be halted and/or caught up before this tile is halted.
+
+   This implementation indexes chunks relative to the workspace
+   containing the dcache to facilitate easy muxing (and expects the
+   ingress chunks to be relative to the workspace containing in_mcache).
+   The dcache size should be adequate for compact writing.
+
+   cr_max, lazy and scratch have the same interpretation as in
+   fd_replay_tile (fd_shred_ingest_tile_scratch_{align,footprint} and
+   FD_SHRED_INGEST_TILE_SCRATCH_{ALIGN,FOOTPRINT} are the corresponding
+   scratch specifications).
+
+   The lifetime of the cnc, mcaches, dcache, fseqs, tcache, rng and
+   scratch used by this tile should be a superset of this tile's
+   lifetime.  While this tile is running, no other tile should use cnc
+   for its command and control, modify the tcache, publish into mcache
+   or dcache, use the rng for anything (and the rng should be seeded
+   distinctly from all other rngs in the system), or use scratch for
+   anything.  This tile uses in_fseq in the usual consumer ways and the
+   out_fseqs in the usual producer ways.  The out_fseq array and leader
+   will not be used after the tile has successfully booted
+   (transitioned the cnc from BOOT to RUN) or returned (e.g. failed to
+   boot), whichever comes first. */
+
+FD_FN_CONST ulong
+fd_shred_ingest_tile_scratch_align( void );
+
+FD_FN_CONST ulong
+fd_shred_ingest_tile_scratch_footprint( ulong out_cnt );
+
+int
+fd_shred_ingest_tile( fd_cnc_t *             cnc,       /* Local join to the shred ingest's command-and-control */
+                      ulong                  orig,      /* Origin for this shred fragment stream, in [0,FD_FRAG_META_ORIG_MAX) */
+                      fd_frag_meta_t const * in_mcache, /* Local join to the raw shred frag stream mcache */
+                      ulong *                in_fseq,   /* Local join to the fseq used to return flow control credits to the ingress */
+                      ulong                  hdr_sz,    /* Number of header bytes preceding the shred in each ingress frag */
+                      uchar const *          leader,    /* Points to the 32 byte public key of the leader */
+                      fd_tcache_t *          tcache,    /* Local join to the shred ingest's unique shred cache */
+                      fd_frag_meta_t *       mcache,    /* Local join to the shred ingest's frag stream output mcache */
+                      uchar *                dcache,    /* Local join to the shred ingest's frag stream output dcache */
+                      ulong                  out_cnt,   /* Number of reliable consumers, reliable consumers are indexed [0,out_cnt) */
+                      ulong **               out_fseq,  /* out_fseq[out_idx] is the local join to reliable consumer out_idx's fseq */
+                      ulong                  cr_max,    /* Maximum number of flow control credits, 0 means use a reasonable default */
+                      long                   lazy,      /* Lazyiness, <=0 means use a reasonable default */
+                      fd_rng_t *             rng,       /* Local join to the rng this shred ingest should use */
+                      void *                 scratch ); /* Tile scratch memory */
+
+FD_PROTOTYPES_END
+
+#endif
+
+#endif /* HEADER_fd_src_disco_shred_fd_shred_ingest_h */
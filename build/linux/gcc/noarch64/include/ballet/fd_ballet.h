@@ -0,0 +1,20 @@
+#ifndef HEADER_fd_src_ballet_fd_ballet_h
+#define HEADER_fd_src_ballet_fd_ballet_h
+
+//#include "fd_ballet_base.h"   /* Includes ../util/fd_util.h */
+//#include "sha256/fd_sha256.h" /* Includes fd_ballet_base.h */
+//#include "sha512/fd_sha512.h" /* Includes fd_ballet_base.h */
+#include "base58/fd_base58.h"
+#include "ed25519/fd_ed25519.h" /* Includes sha512/fd_sha512.h */
+#include "poh/fd_poh.h"         /* Includes sha256/fd_sha256.h */
+#include "shred/fd_shred.h"
+#include "bmtree/fd_bmtree.h"   /* Includes sha256/fd_sha256.h */
+#include "reedsol/fd_reedsol.h"
+#include "shred/fd_shredder.h"  /* Includes shred/fd_shred.h and bmtree/fd_bmtree.h */
+#include "shred/fd_deshredder.h" /* Includes shred/fd_shredder.h */
+#include "txn/fd_txn.h"         /* Includes ed25519/fd_ed25519.h */
+#include "txn/fd_alut.h"        /* Includes txn/fd_txn.h */
+#include "txn/fd_txn_build.h"   /* Includes txn/fd_txn.h */
+#include "pack/fd_pack.h"       /* Includes pack/fd_acct_lock.h */
+
+#endif /* HEADER_fd_src_ballet_fd_ballet_h */
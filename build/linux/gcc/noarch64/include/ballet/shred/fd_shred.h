@@ -0,0 +1,316 @@
+#ifndef HEADER_fd_src_ballet_shred_fd_shred_h
+#define HEADER_fd_src_ballet_shred_fd_shred_h
+
+/* Shreds form the on-wire representation of Solana block data
+   optimized for transmission over unreliable links/WAN.
+
+   ### Layout
+
+   Each shred is 1228 bytes long.
+
+      +------------------------+
+      | Common Shred Header    | 83 bytes
+      +------------------------+
+      | Data Header            | 5 bytes
+      | or Coding Header       | or 6 bytes
+      +------------------------+
+      |                        | variable
+      | Payload                | length
+      |                        |
+      +------------------------+
+
+       for Merkle shreds, followed by:
+
+      +------------------------+
+      | Merkle node #0 (root)  | 20 bytes
+      +------------------------+
+      | Merkle node #1         | 20 bytes
+      ..........................
+
+   ### Shredding
+
+   For a given input data blob (usually an entry batch),
+   data shreds are derived by simply splitting up the blob into subslices.
+
+   Each shred is sized such that it fits into a single UDP packet,
+   i.e. currently bound by the generally accepted IPv6 MTU of 1280 bytes.
+
+   ### Forward Error Correction
+
+   Coding shreds implement Reed-Solomon error correction to provide tolerance against packet loss.
+
+   Each data shred is first assigned an FEC set.
+   For the vector of data shreds in each set, a corresponding vector of coding shreds contains parity data.
+
+   FEC sets and entry batches do not necessarily align.
+
+   The Reed-Solomon code (see ballet/reedsol) covers an equal sized
+   "erasure shard" of every shred in an FEC set: for coding shreds, the
+   coding payload and for data shreds, everything past the signature
+   (the whole shred for legacy data shreds) truncated to the size of a
+   coding payload.  Thus, data shreds carry a few bytes less payload
+   than coding shreds and the bytes of a data shred between its
+   erasure shard and its Merkle nodes are zero.  See
+   fd_shred_erasure_{off,sz}.
+
+   ### Merkle Inclusion Proofs
+
+   Data and coding shreds come in two variants respectively: legacy and merkle.
+   Merkle shreds extend legacy shreds by adding FEC set inclusion proofs.
+
+   It allows the block producer to commit to the vector of shreds that make up an FEC set.
+   The inclusion proof is used to verify whether a shred is part of the FEC set commitment.
+
+   The length of the inclusion proof is indicated by the variant field.
+
+   ### Authentication
+
+   Shreds are signed by the block producer.
+   Consequentially, only the block producer is able to create valid shreds for any given block. */
+
+#include "../fd_ballet_base.h"
+#include "../../util/fd_util_base.h"
+
+/* FD_SHRED_SZ: The byte size of a shred.
+   This limit derives from the IPv6 MTU of 1280 bytes,
+   minus 48 bytes for the UDP/IPv6 headers and another 4 bytes for good measure. */
+#define FD_SHRED_SZ (1228UL)
+/* FD_SHRED_DATA_HEADER_SZ: size of all headers for data type shreds. */
+#define FD_SHRED_DATA_HEADER_SZ (0x58UL)
+/* FD_SHRED_CODE_HEADER_SZ: size of all headers for coding type shreds. */
+#define FD_SHRED_CODE_HEADER_SZ (0x59UL)
+
+/* FD_SHRED_TYPE_* identifies the type of a shred.
+   It is located at the four high bits of byte 0x40 (64) of the shred header
+   and can be extracted using the fd_shred_type() function. */
+/* FD_SHRED_TYPE_LEGACY_DATA: A shred carrying raw binary data. */
+#define FD_SHRED_TYPE_LEGACY_DATA ((uchar)0xA)
+/* FD_SHRED_TYPE_LEGACY_CODE: A shred carrying Reed-Solomon ECC. */
+#define FD_SHRED_TYPE_LEGACY_CODE ((uchar)0x5)
+/* FD_SHRED_TYPE_MERKLE_DATA: A shred carrying raw binary data and a merkle inclusion proof. */
+#define FD_SHRED_TYPE_MERKLE_DATA ((uchar)0x8)
+/* FD_SHRED_TYPE_MERKLE_CODE: A shred carrying Reed-Solomon ECC and a merkle inclusion proof. */
+#define FD_SHRED_TYPE_MERKLE_CODE ((uchar)0x4)
+
+/* FD_ED25519_SIG_SZ: the size of an Ed25519 signature in bytes. */
+#define FD_ED25519_SIG_SZ (64UL)
+/* An Ed25519 signature. */
+typedef uchar fd_ed25519_sig_t[FD_ED25519_SIG_SZ];
+
+/* FD_SHRED_MERKLE_NODE_SZ: the size of a merkle inclusion proof node in bytes. */
+#define FD_SHRED_MERKLE_NODE_SZ (20UL)
+/* A merkle inclusion proof node. */
+typedef uchar fd_shred_merkle_t[FD_SHRED_MERKLE_NODE_SZ];
+
+/* Constants relating to the data shred "flags" field. */
+
+/* Mask of the "reference tick" field in shred.data.flags */
+#define FD_SHRED_DATA_REF_TICK_MASK         ((uchar)0x3f)
+/* Mask of the "slot complete" bit in shred.data.flags */
+#define FD_SHRED_DATA_FLAG_SLOT_COMPLETE    ((uchar)0x80)
+/* Mask of the "FEC set complete" bit in shred.data.flags */
+#define FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE ((uchar)0x40)
+
+/* Primary shred data structure.
+   Relies heavily on packed fields and unaligned memory accesses. */
+struct __attribute__((packed)) fd_shred {
+  /* Ed25519 signature over the shred
+
+     For legacy type shreds, signs over content of the shred structure past this signature field.
+     For merkle type shreds, signs over the first node of the inclusion proof (merkle root). */
+  /* 0x00 */ fd_ed25519_sig_t signature;
+
+  /* Shred variant specifier
+     Consists of two four bit fields. (Deliberately not using bit fields here)
+
+     The high bits indicate the shred type.
+
+     For legacy type shreds, the low bits are set to static patterns.
+     For merkle type shreds, the low bits are set to the number of non-root nodes in the inclusion proof. */
+  /* 0x40 */ uchar  variant;
+
+  /* Slot number that this shred is part of */
+  /* 0x41 */ ulong  slot;
+
+  /* Index of this shred within the slot */
+  /* 0x49 */ uint   idx;
+
+  /* Hash of the genesis version and historical hard forks of the current chain */
+  /* 0x4d */ ushort version;
+
+  /* Index into the vector of FEC sets for this slot */
+  /* 0x4f */ uint   fec_set_idx;
+
+  union {
+    /* Common data shred header */
+    struct __attribute__((packed)) {
+      /* Slot number difference between this block and the parent block.
+         Always greater than zero. */
+      /* 0x53 */ ushort parent_off;
+
+      /* Bit field (MSB first)
+         See FD_SHRED_DATA_FLAG_*
+
+          [XX.. ....] Block complete?   0b00=no 0b11=yes (implies FEC set complete)
+          [.X.. ....] FEC Set complete?  0b0=no  0b1=yes
+          [..XX XXXX] Reference tick number */
+      /* 0x55 */ uchar  flags;
+
+      /* Size of the headers plus the data payload (i.e. the offset of
+         the first byte past the data payload) */
+      /* 0x56 */ ushort size;
+    } data;
+
+    /* Common coding shred header */
+    struct __attribute__((packed)) {
+      /* Total number of data shreds in slot */
+      /* 0x53 */ ushort data_cnt;
+
+      /* Total number of coding shreds in slot */
+      /* 0x55 */ ushort code_cnt;
+
+      /* Index within the vector of coding shreds in slot */
+      /* 0x57 */ ushort idx;
+    } code;
+  };
+};
+typedef struct fd_shred fd_shred_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_shred_parse: Parses and validates an untrusted shred header.
+   The provided buffer must be at least FD_SHRED_SZ bytes long.
+
+   The returned pointer either equals the input pointer
+   or is NULL if the given shred is malformed. */
+FD_FN_PURE fd_shred_t const *
+fd_shred_parse( uchar const * buf );
+
+/* fd_shred_type: Returns the value of the shred's type field. (FD_SHRED_TYPE_*) */
+FD_FN_CONST static inline uchar
+fd_shred_type( uchar variant ) {
+  return variant >> 4;
+}
+
+/* fd_shred_variant: Returns the encoded variant field
+   given the shred type and merkle proof length. */
+FD_FN_CONST static inline uchar
+fd_shred_variant( uchar type,
+                  uchar merkle_cnt ) {
+  merkle_cnt--;
+  if( FD_UNLIKELY( type==FD_SHRED_TYPE_LEGACY_DATA || type==FD_SHRED_TYPE_LEGACY_CODE ) ) {
+    merkle_cnt = type^0xf;
+  }
+  return (uchar)((type<<4U) | merkle_cnt);
+}
+
+/* fd_shred_header_sz: Returns the header size of a shred.
+   Returns zero if the shred has an invalid variant.
+
+   Accesses offsets up to FD_SHRED_HEADER_MIN_SZ. */
+FD_FN_CONST static inline ulong
+fd_shred_header_sz( uchar variant ) {
+  uchar shred_type = fd_shred_type( variant );
+  if( FD_LIKELY( shred_type==FD_SHRED_TYPE_MERKLE_DATA || shred_type==FD_SHRED_TYPE_LEGACY_DATA ) ) {
+    return FD_SHRED_DATA_HEADER_SZ;
+  }
+  if( FD_LIKELY( shred_type==FD_SHRED_TYPE_MERKLE_CODE || shred_type==FD_SHRED_TYPE_LEGACY_CODE ) ) {
+    return FD_SHRED_CODE_HEADER_SZ;
+  }
+  return 0;
+}
+
+/* fd_shred_merkle_cnt: Returns number of nodes in the merkle inclusion proof.
+   Returns zero if the given shred is not a merkle variant. */
+FD_FN_CONST static inline uint
+fd_shred_merkle_cnt( uchar variant ) {
+  uchar type = fd_shred_type( variant );
+  if( FD_UNLIKELY( type!=FD_SHRED_TYPE_MERKLE_DATA && type!=FD_SHRED_TYPE_MERKLE_CODE ) ) {
+    return 0;
+  }
+  return (variant&0xfU)+1U;
+}
+
+/* fd_shred_merkle_sz: Returns the size in bytes of the merkle inclusion proof.
+   Returns zero if the given shred is not a merkle variant.  */
+FD_FN_CONST static inline ulong
+fd_shred_merkle_sz( uchar variant ) {
+  return fd_shred_merkle_cnt( variant ) * FD_SHRED_MERKLE_NODE_SZ;
+}
+
+/* fd_shred_payload_sz: Returns the payload size of a shred.
+   Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_payload_sz( uchar variant ) {
+  return FD_SHRED_SZ - fd_shred_header_sz( variant ) - fd_shred_merkle_sz( variant );
+}
+
+/* fd_shred_merkle_off: Returns the byte offset of the merkle inclusion proof of a shred.
+
+   The provided shred must have passed validation in fd_shred_parse(). */
+FD_FN_CONST static inline ulong
+fd_shred_merkle_off( uchar variant ) {
+  return FD_SHRED_SZ - fd_shred_merkle_sz( variant );
+}
+
+/* fd_shred_merkle_nodes: Returns a pointer to the shred's merkle proof data.
+
+   The provided shred must have passed validation in fd_shred_parse(). */
+FD_FN_PURE static inline fd_shred_merkle_t const *
+fd_shred_merkle_nodes( fd_shred_t const * shred ) {
+  uchar const * ptr = (uchar const *)shred;
+  ptr += fd_shred_merkle_off( shred->variant );
+  return (fd_shred_merkle_t const *)ptr;
+}
+
+/* fd_shred_data_payload: Returns a pointer to a data shred payload.
+
+  The provided shred must have passed validation in fd_shred_parse(),
+  and must satisfy `type==FD_SHRED_TYPE_LEGACY_DATA || type==FD_SHRED_TYPE_MERKLE_DATA`
+  where `uchar type = fd_shred_type( shred->variant )`. */
+FD_FN_CONST static inline uchar const *
+fd_shred_data_payload( fd_shred_t const * shred ) {
+  return (uchar const *)shred + FD_SHRED_DATA_HEADER_SZ;
+}
+
+/* fd_shred_code_payload: Returns a pointer to a coding shred payload.
+
+  The provided shred must have passed validation in fd_shred_parse(),
+  and must satisfy `type==FD_SHRED_TYPE_LEGACY_CODE || type==FD_SHRED_TYPE_MERKLE_CODE`
+  where `uchar type = fd_shred_type( shred->variant )`. */
+FD_FN_CONST static inline uchar const *
+fd_shred_code_payload( fd_shred_t const * shred ) {
+  return (uchar const *)shred + FD_SHRED_CODE_HEADER_SZ;
+}
+
+/* fd_shred_erasure_off: Returns the byte offset of the erasure shard of
+   a shred (the part of the shred covered by the Reed-Solomon code).
+   Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_erasure_off( uchar variant ) {
+  uchar type = fd_shred_type( variant );
+  if( FD_LIKELY( type==FD_SHRED_TYPE_MERKLE_DATA ) ) return FD_ED25519_SIG_SZ;
+  if( FD_LIKELY( type==FD_SHRED_TYPE_LEGACY_DATA ) ) return 0UL;
+  return FD_SHRED_CODE_HEADER_SZ;
+}
+
+/* fd_shred_erasure_sz: Returns the byte size of the erasure shard of a
+   shred.  This is the same for the data and coding shreds of an FEC set
+   (whose shreds all have the same number of Merkle nodes).
+   Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_erasure_sz( uchar variant ) {
+  return FD_SHRED_SZ - FD_SHRED_CODE_HEADER_SZ - fd_shred_merkle_sz( variant );
+}
+
+/* fd_shred_data_capacity: Returns the maximum data payload size of a
+   data shred (the part of fd_shred_payload_sz covered by the erasure
+   shard).  Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_data_capacity( uchar variant ) {
+  return fd_shred_erasure_off( variant ) + fd_shred_erasure_sz( variant ) - FD_SHRED_DATA_HEADER_SZ;
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_shred_fd_shred_h */
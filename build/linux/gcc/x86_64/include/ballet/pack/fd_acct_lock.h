@@ -0,0 +1,168 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_acct_lock_h
+#define HEADER_fd_src_ballet_pack_fd_acct_lock_h
+
+/* fd_acct_lock provides an account read/write lock table.  It tracks,
+   for every account used by in-flight work (e.g. transactions a pack
+   has handed to banking but that have not finished executing yet), how
+   many in-flight transactions read the account and whether one writes
+   it.  A transaction can run concurrently with the in-flight work iff
+   none of the accounts it writes are read or written by in-flight work
+   and none of the accounts it reads are written by in-flight work.
+
+   Locks are acquired and released a transaction at a time.  Acquiring
+   is all-or-nothing: either all of the transaction's accounts are
+   locked or (on failure) the table is left unchanged.  Only the
+   transaction's static account addresses are locked; accounts loaded
+   from address lookup tables are not visible in the transaction
+   payload and need to be handled by the caller (e.g. by not running
+   such transactions concurrently with anything else).
+
+   The all zero account address (the system program) is never locked.
+   It is never writable (the runtime demotes writes to it) so it can't
+   be the cause of a conflict.
+
+   The table is an open addressed hash map with room for up to acct_max
+   distinct locked accounts.  It can be located in a workspace but
+   should only be used by one thread at a time. */
+
+#include "../txn/fd_txn.h"
+
+#define FD_ACCT_LOCK_ALIGN (128UL)
+
+/* FD_ACCT_LOCK_ACCT_MAX is the maximum acct_max supported. */
+
+#define FD_ACCT_LOCK_ACCT_MAX (1UL<<30)
+
+/* FD_ACCT_LOCK_{SUCCESS,ERR_*} give the results of
+   fd_acct_lock_txn_acquire. */
+
+#define FD_ACCT_LOCK_SUCCESS      ( 0) /* all of the transaction's accounts were locked */
+#define FD_ACCT_LOCK_ERR_CONFLICT (-1) /* an account conflicts with in-flight work (or the transaction itself) */
+#define FD_ACCT_LOCK_ERR_FULL     (-2) /* too many distinct accounts locked */
+
+/* fd_acct_lock_t is an opaque handle of a join to an account lock
+   table. */
+
+struct fd_acct_lock_private;
+typedef struct fd_acct_lock_private fd_acct_lock_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_acct_lock_{align,footprint} return the alignment and footprint
+   required for a memory region to be used as an account lock table that
+   can hold up to acct_max distinct locked accounts.  footprint returns
+   0 if acct_max is not in [1,FD_ACCT_LOCK_ACCT_MAX] (the footprint is
+   between 96 and 192 bytes per account).
+
+   fd_acct_lock_new formats a memory region with the appropriate
+   alignment and footprint into an empty account lock table.  seed
+   selects the hash function used internally (to make it hard for
+   somebody who can choose account addresses to degrade performance,
+   this should be an unpredictable value).  Returns shmem on success and
+   NULL on failure (logs details).  Caller is not joined on return.
+
+   fd_acct_lock_join joins the caller to an account lock table.  Returns
+   a handle to the caller's local join on success and NULL on failure
+   (logs details).
+
+   fd_acct_lock_leave leaves a current local join.  Returns the
+   underlying shared memory region on success and NULL on failure (logs
+   details).
+
+   fd_acct_lock_delete unformats a memory region used as an account lock
+   table.  Assumes nobody is joined.  Returns shmem on success and NULL
+   on failure (logs details). */
+
+FD_FN_CONST ulong
+fd_acct_lock_align( void );
+
+FD_FN_CONST ulong
+fd_acct_lock_footprint( ulong acct_max );
+
+void *
+fd_acct_lock_new( void * shmem,
+                  ulong  acct_max,
+                  ulong  seed );
+
+fd_acct_lock_t *
+fd_acct_lock_join( void * shlock );
+
+void *
+fd_acct_lock_leave( fd_acct_lock_t * lock );
+
+void *
+fd_acct_lock_delete( void * shlock );
+
+/* fd_acct_lock_{acct_max,acct_cnt} return the maximum / current number
+   of distinct accounts locked in the table. */
+
+FD_FN_PURE ulong fd_acct_lock_acct_max( fd_acct_lock_t const * lock );
+FD_FN_PURE ulong fd_acct_lock_acct_cnt( fd_acct_lock_t const * lock );
+
+/* fd_acct_lock_{reader_cnt,is_written} return the number of in-flight
+   readers of the account at addr / 1 if the account at addr is
+   write locked and 0 otherwise.  Both return 0 if the account is not
+   locked. */
+
+FD_FN_PURE ulong fd_acct_lock_reader_cnt( fd_acct_lock_t const * lock, fd_txn_acct_addr_t const * addr );
+FD_FN_PURE int   fd_acct_lock_is_written( fd_acct_lock_t const * lock, fd_txn_acct_addr_t const * addr );
+
+/* fd_acct_lock_acquire locks the accounts of a transaction: the
+   transaction uses the acct_cnt accounts whose addresses are at
+   acct_addr + i*FD_TXN_ACCT_ADDR_SZ for i in [0,acct_cnt) (unaligned
+   okay).  Account i is written by the transaction if i is in
+   [0,writable_signed_cnt) or [signature_cnt,writable_unsigned_end) and
+   only read otherwise (this is the static account ordering of a
+   transaction, see fd_txn.h).  Accounts that are written are write
+   locked and the others are read locked.  Returns FD_ACCT_LOCK_SUCCESS
+   on success and a FD_ACCT_LOCK_ERR_* code on failure (the table is
+   unchanged on failure).  A transaction that lists a writable account
+   more than once conflicts with itself and can never be locked (the
+   runtime would reject it anyway).
+
+   fd_acct_lock_release releases the locks acquired by a successful
+   fd_acct_lock_acquire with the same arguments.
+
+   fd_acct_lock_txn_{acquire,release} do the same for the static
+   accounts of the transaction described by txn whose payload is
+   pointed to by payload. */
+
+int
+fd_acct_lock_acquire( fd_acct_lock_t * lock,
+                      uchar const *    acct_addr,
+                      ulong            acct_cnt,
+                      ulong            writable_signed_cnt,
+                      ulong            signature_cnt,
+                      ulong            writable_unsigned_end );
+
+void
+fd_acct_lock_release( fd_acct_lock_t * lock,
+                      uchar const *    acct_addr,
+                      ulong            acct_cnt,
+                      ulong            writable_signed_cnt,
+                      ulong            signature_cnt,
+                      ulong            writable_unsigned_end );
+
+static inline int
+fd_acct_lock_txn_acquire( fd_acct_lock_t * lock,
+                          fd_txn_t const * txn,
+                          uchar const *    payload ) {
+  ulong sig_cnt  = (ulong)txn->signature_cnt;
+  ulong acct_cnt = (ulong)txn->acct_addr_cnt;
+  return fd_acct_lock_acquire( lock, payload + txn->acct_addr_off, acct_cnt,
+                               sig_cnt - (ulong)txn->readonly_signed_cnt, sig_cnt, acct_cnt - (ulong)txn->readonly_unsigned_cnt );
+}
+
+static inline void
+fd_acct_lock_txn_release( fd_acct_lock_t * lock,
+                          fd_txn_t const * txn,
+                          uchar const *    payload ) {
+  ulong sig_cnt  = (ulong)txn->signature_cnt;
+  ulong acct_cnt = (ulong)txn->acct_addr_cnt;
+  fd_acct_lock_release( lock, payload + txn->acct_addr_off, acct_cnt,
+                        sig_cnt - (ulong)txn->readonly_signed_cnt, sig_cnt, acct_cnt - (ulong)txn->readonly_unsigned_cnt );
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_acct_lock_h */
@@ -0,0 +1,132 @@
+#ifndef HEADER_fd_src_ballet_txn_fd_txn_build_h
+#define HEADER_fd_src_ballet_txn_fd_txn_build_h
+
+/* fd_txn_build serializes a transaction (legacy or v0) into the
+   canonical wire encoding, i.e. the format fd_txn_parse reads.  The
+   transaction is written directly into a caller provided buffer (e.g. a
+   dcache chunk) and the matching fd_txn_t descriptor is produced in the
+   same pass, so there is no intermediate representation to copy and no
+   need to parse the result again.
+
+   Typical usage (e.g. a load generator publishing signed transactions):
+
+     fd_txn_build_instr_t instr[1] = {{ .program_id = 2, ... }};
+     fd_txn_build_t       b[1]     = {{ .transaction_version = FD_TXN_VLEGACY,
+                                        .signature_cnt       = 1,
+                                        ...
+                                        .instr_cnt           = 1,
+                                        .instr               = instr }};
+
+     uchar * payload = fd_chunk_to_laddr( wksp, chunk );
+     ulong   payload_sz;
+     if( FD_UNLIKELY( !fd_txn_build( b, payload, FD_TXN_MTU, txn_buf, &payload_sz ) ) ) ... bad description ...
+     fd_txn_build_sign( payload, payload_sz, (fd_txn_t const *)txn_buf, 0UL, public_key, private_key, sha );
+
+   Byte ranges whose source pointer is NULL in the description (account
+   addresses, recent blockhash, instruction data, table addresses) are
+   reserved but not written such that the caller can fill them in place
+   (their location is given by the descriptor) before signing. */
+
+#include "fd_txn.h"
+
+/* fd_txn_build_instr_t describes an instruction of a transaction to
+   build.  Fields are as in fd_txn_instr_t but the account indices and
+   data are given by pointers instead of payload offsets. */
+
+struct fd_txn_build_instr {
+  uchar         program_id; /* Index of the program's account address */
+  ushort        acct_cnt;   /* Number of account indices */
+  ushort        data_sz;    /* Number of bytes of instruction data */
+  uchar const * acct;       /* Points to the acct_cnt account indices (can be NULL if acct_cnt is 0) */
+  uchar const * data;       /* Points to the data_sz bytes of instruction data (NULL to reserve) */
+};
+
+typedef struct fd_txn_build_instr fd_txn_build_instr_t;
+
+/* fd_txn_build_lut_t describes an address table lookup of a v0
+   transaction to build.  Fields are as in fd_txn_acct_addr_lut_t but
+   the table address and indices are given by pointers. */
+
+struct fd_txn_build_lut {
+  uchar const * addr;         /* Points to the FD_TXN_ACCT_ADDR_SZ byte table address (NULL to reserve) */
+  uchar         writable_cnt; /* Number of writable indices */
+  uchar         readonly_cnt; /* Number of readonly indices */
+  uchar const * writable;     /* Points to the writable_cnt writable indices (can be NULL if writable_cnt is 0) */
+  uchar const * readonly;     /* Points to the readonly_cnt readonly indices (can be NULL if readonly_cnt is 0) */
+};
+
+typedef struct fd_txn_build_lut fd_txn_build_lut_t;
+
+/* fd_txn_build_t describes a transaction to build.  The header fields
+   have the same meaning as the fd_txn_t fields of the same name. */
+
+struct fd_txn_build {
+  uchar                        transaction_version;   /* FD_TXN_VLEGACY or FD_TXN_V0 */
+  uchar                        signature_cnt;
+  uchar                        readonly_signed_cnt;
+  uchar                        readonly_unsigned_cnt;
+  ushort                       acct_addr_cnt;
+  uchar const *                acct_addr;             /* Points to acct_addr_cnt*FD_TXN_ACCT_ADDR_SZ bytes (NULL to reserve) */
+  uchar const *                recent_blockhash;      /* Points to FD_TXN_BLOCKHASH_SZ bytes (NULL to reserve) */
+  ushort                       instr_cnt;
+  fd_txn_build_instr_t const * instr;                 /* Indexed [0,instr_cnt) */
+  uchar                        addr_table_lookup_cnt; /* Must be 0 for FD_TXN_VLEGACY */
+  fd_txn_build_lut_t const *   addr_table_lookup;     /* Indexed [0,addr_table_lookup_cnt) */
+};
+
+typedef struct fd_txn_build fd_txn_build_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_txn_build_payload_sz returns the size in bytes of the serialized
+   transaction described by b (e.g. to size a dcache chunk).  Does no
+   validation of b. */
+
+FD_FN_PURE ulong
+fd_txn_build_payload_sz( fd_txn_build_t const * b );
+
+/* fd_txn_build serializes the transaction described by b into payload,
+   which has room for payload_max bytes, and the fd_txn_t describing it
+   into out_buf, which must have room for at least FD_TXN_MAX_SZ bytes.
+   The signatures are zeroed (see fd_txn_build_sign).  On success,
+   returns the footprint of the resulting fd_txn_t and stores the size of
+   the serialized transaction in *payload_sz.  Returns 0 on failure (b
+   does not describe a transaction fd_txn_parse would accept or the
+   transaction does not fit in payload_max bytes), in which case nothing
+   is written to payload, out_buf or *payload_sz.  Does no dynamic
+   allocation.
+
+   On success, fd_txn_parse of the payload succeeds and produces exactly
+   the fd_txn_t written to out_buf.  Conversely, fd_txn_build succeeds
+   with an unlimited payload_max iff fd_txn_parse would accept the
+   transaction b describes and its fd_txn_t fits in FD_TXN_MAX_SZ bytes
+   (the contents of the reserved byte ranges do not matter for this). */
+
+ulong
+fd_txn_build( fd_txn_build_t const * b,
+              uchar *                payload,
+              ulong                  payload_max,
+              void *                 out_buf,
+              ulong *                payload_sz );
+
+/* fd_txn_build_sign signs the message of the payload_sz byte
+   transaction pointed to by payload, whose fd_txn_t is txn, with the
+   given ED25519 key pair and writes the signature to signature sig_idx
+   (in [0,txn->signature_cnt)).  public_key should match the signer's
+   account address (account sig_idx).  sha is a handle of a local join
+   to a sha512 calculator used for the signing.  The signature covers
+   the whole message so all the reserved byte ranges should be filled in
+   before signing. */
+
+void
+fd_txn_build_sign( uchar *          payload,
+                   ulong            payload_sz,
+                   fd_txn_t const * txn,
+                   ulong            sig_idx,
+                   void const *     public_key,
+                   void const *     private_key,
+                   fd_sha512_t *    sha );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_txn_fd_txn_build_h */
@@ -19,19 +19,80 @@
 
      {HA,SV}_FILT_{CNT,SZ} is frank specific and the number of times a
      transaction was dropped by a verify tile due to failing signature
-     verification. */
-
-#define FD_FRANK_CNC_DIAG_IN_BACKP    FD_CNC_DIAG_IN_BACKP  /* ==0 */
-#define FD_FRANK_CNC_DIAG_BACKP_CNT   FD_CNC_DIAG_BACKP_CNT /* ==1 */
-#define FD_FRANK_CNC_DIAG_HA_FILT_CNT (2UL)                 /* updated by verify tile, frequently in ha situations, never o.w. */
-#define FD_FRANK_CNC_DIAG_HA_FILT_SZ  (3UL)                 /* " */
-#define FD_FRANK_CNC_DIAG_SV_FILT_CNT (4UL)                 /* ", ideally never */
-#define FD_FRANK_CNC_DIAG_SV_FILT_SZ  (5UL)                 /* " */
+     verification.
+
+     PKC_{HIT,MISS}_CNT is frank specific and the number of signer
+     public key lookups that hit / missed a verify tile's pubkey cache
+     (zero if the verify tile is not using a pubkey cache).
+
+     PACK_PENDING_CNT is frank specific and the number of transactions
+     currently pending in the pack tile.  PACK_EVICT_CNT is the number
+     of pending transactions the pack tile evicted to make room for
+     higher priority ones.  PACK_{MBLK,TXN,CU}_CNT are the number of
+     microblocks the pack tile scheduled and the total number of
+     transactions / estimated compute units in them.  PACK_INFLIGHT_CNT
+     is the number of transactions the pack tile has published to its
+     lanes that the lanes have not reported done yet.  For the pack
+     tile, IN_BACKP / BACKP_CNT indicate that transactions are pending
+     but no lane can take a microblock.  Note that these are past the
+     first 64 bytes of the cnc app region, so the pack tile's cnc needs
+     an app region of at least 128 bytes.
+
+     POH_{HASH,TICK,MIXIN}_CNT are frank specific and the number of
+     hashes (including mixins) the poh tile has appended to the
+     hashchain, the number of ticks it has published and the number of
+     microblock hashes it has mixed in.  POH_MIXIN_LAT_NS is the total
+     time in ns between the publication of a microblock hash by its
+     producer and it being mixed into the hashchain (divide by
+     POH_MIXIN_CNT to get the average).  The poh tile's cnc needs an app
+     region of at least 192 bytes. */
+
+#define FD_FRANK_CNC_DIAG_IN_BACKP     FD_CNC_DIAG_IN_BACKP  /* ==0 */
+#define FD_FRANK_CNC_DIAG_BACKP_CNT    FD_CNC_DIAG_BACKP_CNT /* ==1 */
+#define FD_FRANK_CNC_DIAG_HA_FILT_CNT  (2UL)                 /* updated by verify tile, frequently in ha situations, never o.w. */
+#define FD_FRANK_CNC_DIAG_HA_FILT_SZ   (3UL)                 /* " */
+#define FD_FRANK_CNC_DIAG_SV_FILT_CNT  (4UL)                 /* ", ideally never */
+#define FD_FRANK_CNC_DIAG_SV_FILT_SZ   (5UL)                 /* " */
+#define FD_FRANK_CNC_DIAG_PKC_HIT_CNT  (6UL)                 /* updated by verify tile, frequently */
+#define FD_FRANK_CNC_DIAG_PKC_MISS_CNT (7UL)                 /* " */
+
+#define FD_FRANK_CNC_DIAG_PACK_PENDING_CNT  ( 8UL)           /* updated by pack tile, frequently */
+#define FD_FRANK_CNC_DIAG_PACK_EVICT_CNT    ( 9UL)           /* ", ideally never */
+#define FD_FRANK_CNC_DIAG_PACK_MBLK_CNT     (10UL)           /* ", frequently */
+#define FD_FRANK_CNC_DIAG_PACK_TXN_CNT      (11UL)           /* " */
+#define FD_FRANK_CNC_DIAG_PACK_CU_CNT       (12UL)           /* " */
+#define FD_FRANK_CNC_DIAG_PACK_INFLIGHT_CNT (13UL)           /* " */
+
+#define FD_FRANK_CNC_DIAG_POH_HASH_CNT      (14UL)           /* updated by poh tile, frequently */
+#define FD_FRANK_CNC_DIAG_POH_TICK_CNT      (15UL)           /* " */
+#define FD_FRANK_CNC_DIAG_POH_MIXIN_CNT     (16UL)           /* " */
+#define FD_FRANK_CNC_DIAG_POH_MIXIN_LAT_NS  (17UL)           /* " */
+
+/* FD_FRANK_VERIFY_MTU is the largest frag payload a verify tile will
+   accept from its ingress (and thus the largest frag a verify tile will
+   publish).  (FIXME: recalibrate, probably smaller for today, larger for
+   later.) */
+
+#define FD_FRANK_VERIFY_MTU (1542UL)
+
+/* FD_FRANK_VERIFY_BATCH_MAX is the largest number of frags a verify
+   tile can be configured to accumulate into a batch before verifying
+   them. */
+
+#define FD_FRANK_VERIFY_BATCH_MAX (256UL)
+
+/* FD_FRANK_POH_MTU is the size of the frags published by the poh tile.
+   Each is a fd_poh_entry_t describing a tick (has_mixin zero) or a
+   microblock hash mixed into the hashchain (has_mixin non-zero), such
+   that a consumer can check the records it receives with
+   fd_poh_verify. */
+
+#define FD_FRANK_POH_MTU (80UL)
 
 FD_PROTOTYPES_BEGIN
 
-/* fd_frank_{verify,dedup,pack}_task is a fd_tile_task_t compatible
-   function whose task is to run a {verify,dedup,pack} tile.  argc is
+/* fd_frank_{verify,dedup,pack,poh}_task is a fd_tile_task_t compatible
+   function whose task is to run a {verify,dedup,pack,poh} tile.  argc is
    ignored, argv[0] points to a cstr with the tile name (for a verify,
    this is also used to find the specific verify configuration in the
    frank instance's configuration), argv[1] points to a cstr with the
@@ -56,6 +117,21 @@ int
 fd_frank_pack_task( int     argc,
                     char ** argv );
 
+int
+fd_frank_poh_task( int     argc,
+                   char ** argv );
+
+/* fd_frank_verify_synth_load_task is a fd_tile_task_t compatible
+   function whose task is to run a synthetic load tile feeding a verify
+   tile a stream of signed transactions (built with fd_txn_build) through
+   the verify's ingress.  Arguments are as above with argv[0] pointing to
+   the name of the verify tile to feed (the load is configured by that
+   verify's load pod). */
+
+int
+fd_frank_verify_synth_load_task( int     argc,
+                                 char ** argv );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_app_frank_fd_frank_h */
@@ -2,6 +2,8 @@
 
 #if FD_HAS_FRANK
 
+FD_STATIC_ASSERT( FD_DEDUP_TILE_SCRATCH_ALIGN==FD_MUX_TILE_SCRATCH_ALIGN, scratch_align );
+
 int
 fd_frank_dedup_task( int     argc,
                      char ** argv ) {
@@ -21,15 +23,46 @@ fd_frank_dedup_task( int     argc,
   uchar const * cfg_pod = fd_pod_query_subpod( pod, cfg_path );
   if( FD_UNLIKELY( !cfg_pod ) ) FD_LOG_ERR(( "path not found" ));
 
-  FD_LOG_INFO(( "joining %s.dedup.cnc", cfg_path ));
-  fd_cnc_t * cnc = fd_cnc_join( fd_wksp_pod_map( cfg_pod, "dedup.cnc" ) );
+  /* If the dedup is sharded (i.e. the configuration has a dedup.shard
+     pod), this task is either one of the shards (argv[0] is the name of
+     the shard's pod) or the dedup tile that merges the shard outputs
+     into the dedup's mcache (argv[0] is "dedup").  A shard consumes the
+     outs the verify tiles steer to it (verify.*.shard.[shard_name]).
+     Its index is the position of its pod in the dedup.shard pod (which
+     is the order the verify tiles use to steer). */
+
+  uchar const * shard_pods = fd_pod_query_subpod( cfg_pod, "dedup.shard" );
+  ulong         shard_cnt  = fd_pod_cnt_subpod( shard_pods );
+  char const  * shard_name = NULL;
+  uchar const * shard_pod  = NULL;
+  ulong         shard_idx  = 0UL;
+  if( shard_cnt ) {
+    if( FD_UNLIKELY( shard_cnt>FD_DEDUP_TILE_SHARD_MAX ) ) FD_LOG_ERR(( "too many dedup shard" ));
+    for( fd_pod_iter_t iter = fd_pod_iter_init( shard_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      if( !strcmp( info.key, argv[0] ) ) { shard_name = info.key; shard_pod = (uchar const *)info.val; break; }
+      shard_idx++;
+    }
+    if( shard_pod ) FD_LOG_INFO(( "dedup shard %s (%lu of %lu)", shard_name, shard_idx, shard_cnt ));
+    else            FD_LOG_INFO(( "merging %lu dedup shard", shard_cnt ));
+  }
+
+  uchar const * tile_pod = shard_pod ? shard_pod : fd_pod_query_subpod( cfg_pod, "dedup" );
+  if( FD_UNLIKELY( !tile_pod ) ) FD_LOG_ERR(( "%s.dedup path not found", cfg_path ));
+  char tile_path[ 128 ]; /* For logging, truncated if the shard name is unreasonably long */
+  if( shard_pod ) fd_cstr_printf( tile_path, 128UL, NULL, "dedup.shard.%s", shard_name );
+  else            fd_cstr_printf( tile_path, 128UL, NULL, "dedup" );
+
+  FD_LOG_INFO(( "joining %s.%s.cnc", cfg_path, tile_path ));
+  fd_cnc_t * cnc = fd_cnc_join( fd_wksp_pod_map( tile_pod, "cnc" ) );
   if( FD_UNLIKELY( !cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
   if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) FD_LOG_ERR(( "cnc not in boot state" ));
   /* FIXME: CNC DIAG REGION? */
 
   uchar const * verify_pods = fd_pod_query_subpod( cfg_pod, "verify" );
-  ulong in_cnt = fd_pod_cnt_subpod( verify_pods );
-  FD_LOG_INFO(( "%lu verify found", in_cnt ));
+  ulong in_cnt = (shard_cnt && !shard_pod) ? shard_cnt : fd_pod_cnt_subpod( verify_pods );
+  FD_LOG_INFO(( "%lu in found", in_cnt ));
 
   /* Join the IPC objects needed this tile instance */
 
@@ -41,58 +74,89 @@ fd_frank_dedup_task( int     argc,
   if( FD_UNLIKELY( !in_fseq ) ) FD_LOG_ERR(( "fd_alloca failed" ));
 
   ulong in_idx = 0UL;
-  for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
-    fd_pod_info_t info = fd_pod_iter_info( iter );
-    if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
-    char const  * verify_name =                info.key;
-    uchar const * verify_pod  = (uchar const *)info.val;
-
-    FD_LOG_INFO(( "joining %s.verify.%s.mcache", cfg_path, verify_name ));
-    in_mcache[ in_idx ] = fd_mcache_join( fd_wksp_pod_map( verify_pod, "mcache" ) );
-    if( FD_UNLIKELY( !in_mcache[ in_idx ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
-
-    FD_LOG_INFO(( "joining %s.verify.%s.fseq", cfg_path, verify_name ));
-    in_fseq[ in_idx ] = fd_fseq_join( fd_wksp_pod_map( verify_pod, "fseq" ) );
-    if( FD_UNLIKELY( !in_fseq[ in_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
-
-    in_idx++;
+  if( shard_cnt && !shard_pod ) { /* Merging, ins are the shard outputs */
+    for( fd_pod_iter_t iter = fd_pod_iter_init( shard_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      char const  * in_name =                info.key;
+      uchar const * in_pod  = (uchar const *)info.val;
+
+      FD_LOG_INFO(( "joining %s.dedup.shard.%s.mcache", cfg_path, in_name ));
+      in_mcache[ in_idx ] = fd_mcache_join( fd_wksp_pod_map( in_pod, "mcache" ) );
+      if( FD_UNLIKELY( !in_mcache[ in_idx ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+
+      FD_LOG_INFO(( "joining %s.dedup.shard.%s.fseq", cfg_path, in_name ));
+      in_fseq[ in_idx ] = fd_fseq_join( fd_wksp_pod_map( in_pod, "fseq" ) );
+      if( FD_UNLIKELY( !in_fseq[ in_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+
+      in_idx++;
+    }
+  } else { /* Deduping, ins are the verify outs (to this shard if sharded) */
+    for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      char const  * verify_name =                info.key;
+      uchar const * verify_pod  = (uchar const *)info.val;
+
+      uchar const * in_pod = verify_pod;
+      if( shard_pod ) {
+        in_pod = fd_pod_query_subpod( fd_pod_query_subpod( verify_pod, "shard" ), shard_name );
+        if( FD_UNLIKELY( !in_pod ) ) FD_LOG_ERR(( "%s.verify.%s.shard.%s path not found", cfg_path, verify_name, shard_name ));
+      }
+
+      FD_LOG_INFO(( "joining %s.verify.%s%s%s.mcache", cfg_path, verify_name, shard_pod ? ".shard." : "", shard_pod ? shard_name : "" ));
+      in_mcache[ in_idx ] = fd_mcache_join( fd_wksp_pod_map( in_pod, "mcache" ) );
+      if( FD_UNLIKELY( !in_mcache[ in_idx ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+
+      FD_LOG_INFO(( "joining %s.verify.%s%s%s.fseq", cfg_path, verify_name, shard_pod ? ".shard." : "", shard_pod ? shard_name : "" ));
+      in_fseq[ in_idx ] = fd_fseq_join( fd_wksp_pod_map( in_pod, "fseq" ) );
+      if( FD_UNLIKELY( !in_fseq[ in_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+
+      in_idx++;
+    }
   }
 
-  FD_LOG_INFO(( "joining %s.dedup.tcache", cfg_path ));
-  fd_tcache_t * tcache = fd_tcache_join( fd_wksp_pod_map( cfg_pod, "dedup.tcache" ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
+  fd_tcache_t * tcache = NULL;
+  if( !shard_cnt || shard_pod ) {
+    FD_LOG_INFO(( "joining %s.%s.tcache", cfg_path, tile_path ));
+    tcache = fd_tcache_join( fd_wksp_pod_map( tile_pod, "tcache" ) );
+    if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
+  }
 
-  FD_LOG_INFO(( "joining %s.dedup.mcache", cfg_path ));
-  fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( cfg_pod, "dedup.mcache" ) );
+  FD_LOG_INFO(( "joining %s.%s.mcache", cfg_path, tile_path ));
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( tile_pod, "mcache" ) );
   if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
 
-  FD_LOG_INFO(( "joining %s.dedup.fseq", cfg_path ));
-  ulong * out_fseq = fd_fseq_join( fd_wksp_pod_map( cfg_pod, "dedup.fseq" ) );
+  FD_LOG_INFO(( "joining %s.%s.fseq", cfg_path, tile_path ));
+  ulong * out_fseq = fd_fseq_join( fd_wksp_pod_map( tile_pod, "fseq" ) );
   if( FD_UNLIKELY( !out_fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
 
   /* Setup local objects used by this tile */
 
-  ulong cr_max = fd_pod_query_ulong( cfg_pod, "dedup.cr_max", 0UL ); /*  0  <> pick reasonable default */
-  long  lazy   = fd_pod_query_long ( cfg_pod, "dedup.lazy",   0L  ); /* <=0 <> pick reasonable default */
-  FD_LOG_INFO(( "configuring flow control (%s.dedup.cr_max %lu %s.dedup.lazy %li)", cfg_path, cr_max, cfg_path, lazy ));
+  ulong cr_max = fd_pod_query_ulong( tile_pod, "cr_max", 0UL ); /*  0  <> pick reasonable default */
+  long  lazy   = fd_pod_query_long ( tile_pod, "lazy",   0L  ); /* <=0 <> pick reasonable default */
+  FD_LOG_INFO(( "configuring flow control (%s.%s.cr_max %lu %s.%s.lazy %li)", cfg_path, tile_path, cr_max, cfg_path, tile_path, lazy ));
 
-  uint seed = fd_pod_query_uint( cfg_pod, "dedup.seed", (uint)fd_tile_id() ); /* use app tile_id as default */
-  FD_LOG_INFO(( "creating rng (%s.dedup.seed %u)", cfg_path, seed ));
+  uint seed = fd_pod_query_uint( tile_pod, "seed", (uint)fd_tile_id() ); /* use app tile_id as default */
+  FD_LOG_INFO(( "creating rng (%s.%s.seed %u)", cfg_path, tile_path, seed ));
   fd_rng_t _rng[ 1 ];
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
   if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_join failed" ));
 
   FD_LOG_INFO(( "creating scratch" ));
-  ulong footprint = fd_dedup_tile_scratch_footprint( in_cnt, 1UL );
-  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "fd_dedup_tile_scratch_footprint failed" ));
-  void * scratch = fd_alloca( FD_DEDUP_TILE_SCRATCH_ALIGN, footprint );
+  ulong footprint = tcache ? fd_dedup_tile_scratch_footprint( in_cnt, 1UL ) : fd_mux_tile_scratch_footprint( in_cnt, 1UL );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "fd_%s_tile_scratch_footprint failed", tcache ? "dedup" : "mux" ));
+  void * scratch = fd_alloca( FD_DEDUP_TILE_SCRATCH_ALIGN, footprint ) /* ==FD_MUX_TILE_SCRATCH_ALIGN */;
   if( FD_UNLIKELY( !scratch ) ) FD_LOG_ERR(( "fd_alloca failed" ));
 
-  /* Start deduping */
+  /* Start deduping (or merging the dedup shards) */
 
   FD_LOG_INFO(( "dedup run" ));
-  int err = fd_dedup_tile( cnc, in_cnt, in_mcache, in_fseq, tcache, mcache, 1UL, &out_fseq, cr_max, lazy, rng, scratch );
-  if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_dedup_tile failed (%i)", err ));
+  int err;
+  if( tcache ) err = fd_dedup_tile( cnc, in_cnt, in_mcache, in_fseq, tcache, fd_ulong_max( shard_cnt, 1UL ), shard_idx,
+                                    mcache, 1UL, &out_fseq, cr_max, lazy, rng, scratch );
+  else         err = fd_mux_tile  ( cnc, in_cnt, in_mcache, in_fseq, mcache, 1UL, &out_fseq, cr_max, lazy, rng, scratch );
+  if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_%s_tile failed (%i)", tcache ? "dedup" : "mux", err ));
 
   /* Clean up */
 
@@ -100,7 +164,7 @@ fd_frank_dedup_task( int     argc,
   fd_rng_delete    ( fd_rng_leave   ( rng      ) );
   fd_wksp_pod_unmap( fd_fseq_leave  ( out_fseq ) );
   fd_wksp_pod_unmap( fd_mcache_leave( mcache   ) );
-  fd_wksp_pod_unmap( fd_tcache_leave( tcache   ) );
+  if( tcache ) fd_wksp_pod_unmap( fd_tcache_leave( tcache ) );
   for( ulong in_idx=in_cnt; in_idx; in_idx-- ) {
     fd_wksp_pod_unmap( fd_fseq_leave  ( in_fseq  [ in_idx-1UL ] ) );
     fd_wksp_pod_unmap( fd_mcache_leave( in_mcache[ in_idx-1UL ] ) );
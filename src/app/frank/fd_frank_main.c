@@ -63,7 +63,35 @@ main( int     argc,
   ulong verify_cnt = fd_pod_cnt_subpod( verify_pods );
   FD_LOG_NOTICE(( "%lu verify found", verify_cnt ));
 
-  ulong tile_cnt = 3UL + verify_cnt;
+  /* The dedup is optionally sharded (it is sharded iff the
+     configuration has a dedup.shard pod).  If so, the shard tiles come
+     after the verify tiles and the dedup tile merges their outputs. */
+
+  uchar const * shard_pods = fd_pod_query_subpod( cfg_pod, "dedup.shard" );
+  ulong shard_cnt = fd_pod_cnt_subpod( shard_pods );
+  FD_LOG_NOTICE(( "%lu dedup shard found", shard_cnt ));
+  if( FD_UNLIKELY( shard_cnt>FD_DEDUP_TILE_SHARD_MAX ) ) FD_LOG_ERR(( "at most %lu dedup shard supported", FD_DEDUP_TILE_SHARD_MAX ));
+
+  /* The poh tile is optional (it is run iff the configuration has a
+     poh pod) and, if run, comes after the verify and shard tiles */
+
+  uchar const * poh_pod = fd_pod_query_subpod( cfg_pod, "poh" );
+  ulong poh_cnt = poh_pod ? 1UL : 0UL;
+  FD_LOG_NOTICE(( "%lu poh found", poh_cnt ));
+
+  /* A verify is optionally fed synthetic load (it is iff its verify
+     pod has a load pod).  The load tiles come after all the other
+     tiles. */
+
+  ulong load_cnt = 0UL;
+  for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+    fd_pod_info_t info = fd_pod_iter_info( iter );
+    if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+    load_cnt += (ulong)!!fd_pod_query_subpod( (uchar const *)info.val, "load" );
+  }
+  FD_LOG_NOTICE(( "%lu verify load found", load_cnt ));
+
+  ulong tile_cnt = 3UL + verify_cnt + shard_cnt + poh_cnt + load_cnt;
   if( FD_UNLIKELY( fd_tile_cnt()<tile_cnt ) ) FD_LOG_ERR(( "at least %lu tiles required for this config", tile_cnt ));
   if( FD_UNLIKELY( fd_tile_cnt()>tile_cnt ) ) FD_LOG_WARNING(( "only %lu tiles required for this config", tile_cnt ));
 
@@ -89,7 +117,7 @@ main( int     argc,
     tile_name[ tile_idx ] = "pack";
     tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( cfg_pod, "pack.cnc" ) );
     if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
-    if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
+    if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<128UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 128 bytes" ));
     tile_idx++;
 
     FD_LOG_NOTICE(( "joining %s.dedup.cnc", cfg_path ));
@@ -113,12 +141,52 @@ main( int     argc,
       tile_idx++;
     }
 
+    for( fd_pod_iter_t iter = fd_pod_iter_init( shard_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      char const  * shard_name =                info.key;
+      uchar const * shard_pod  = (uchar const *)info.val;
+
+      FD_LOG_NOTICE(( "joining %s.dedup.shard.%s.cnc", cfg_path, shard_name ));
+      tile_name[ tile_idx ] = shard_name;
+      tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( shard_pod, "cnc" ) );
+      if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+      if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
+      tile_idx++;
+    }
+
+    if( poh_cnt ) {
+      FD_LOG_NOTICE(( "joining %s.poh.cnc", cfg_path ));
+      tile_name[ tile_idx ] = "poh";
+      tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( poh_pod, "cnc" ) );
+      if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+      if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<192UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 192 bytes" ));
+      tile_idx++;
+    }
+
+    for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      char const  * verify_name =                info.key;
+      uchar const * load_pod    = fd_pod_query_subpod( (uchar const *)info.val, "load" );
+      if( !load_pod ) continue;
+
+      FD_LOG_NOTICE(( "joining %s.verify.%s.load.cnc", cfg_path, verify_name ));
+      tile_name[ tile_idx ] = verify_name; /* The load task finds its configuration from the name of the verify it feeds */
+      tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( load_pod, "cnc" ) );
+      if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+      if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
+      tile_idx++;
+    }
+
   } while(0);
 
   /* Boot all the tiles that main controls */
 
+  ulong load_tile_idx0 = tile_cnt - load_cnt;
+
   for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) {
-    FD_LOG_NOTICE(( "booting tile %s", tile_name[ tile_idx ] ));
+    FD_LOG_NOTICE(( "booting tile %s%s", tile_name[ tile_idx ], tile_idx<load_tile_idx0 ? "" : ".load" ));
 
     /* Note: could do this in parallel but one at a time makes
        boot logging easier to read and easier to pass args */
@@ -128,7 +196,9 @@ main( int     argc,
     case 0UL: task = main;                 break;
     case 1UL: task = fd_frank_pack_task;   break;
     case 2UL: task = fd_frank_dedup_task;  break;
-    default:  task = fd_frank_verify_task; break;
+    default:  task = (tile_idx<3UL+verify_cnt          ) ? fd_frank_verify_task :
+                     (tile_idx<3UL+verify_cnt+shard_cnt) ? fd_frank_dedup_task  :
+                     (tile_idx<load_tile_idx0          ) ? fd_frank_poh_task    : fd_frank_verify_synth_load_task; break;
     }
 
     char * task_argv[3];
@@ -184,7 +254,7 @@ main( int     argc,
   FD_LOG_NOTICE(( "app fini" ));
 
   for( ulong tile_idx=tile_cnt; tile_idx>1UL; tile_idx-- ) {
-    FD_LOG_NOTICE(( "halting tile %s", tile_name[ tile_idx-1UL ] ));
+    FD_LOG_NOTICE(( "halting tile %s%s", tile_name[ tile_idx-1UL ], tile_idx-1UL<load_tile_idx0 ? "" : ".load" ));
 
     /* Note: could do this in parallel too but doing reverse
        one-at-a-time for symmetry with boot */
@@ -228,7 +228,7 @@ printf_pct( ulong  num_now,
    them into the easy to process structure snap */
 
 struct snap {
-  ulong pmap; /* Bit {0,1,2} set <> {cnc,mcache,fseq} values are valid */
+  ulong pmap; /* Bit {0,1,2,3} set <> {cnc,mcache,fseq,poh} values are valid */
 
   long  cnc_heartbeat;
   ulong cnc_signal;
@@ -240,6 +240,11 @@ struct snap {
   ulong cnc_diag_sv_filt_cnt;
   ulong cnc_diag_sv_filt_sz;
 
+  ulong cnc_diag_poh_hash_cnt;
+  ulong cnc_diag_poh_tick_cnt;
+  ulong cnc_diag_poh_mixin_cnt;
+  ulong cnc_diag_poh_mixin_lat_ns;
+
   ulong mcache_seq;
 
   ulong fseq_seq;
@@ -255,12 +260,19 @@ struct snap {
 
 typedef struct snap snap_t;
 
+/* A tile can have up to out_max mcaches and fseqs (e.g. a verify tile
+   has one per dedup shard when the dedup is sharded).  The snapshot of
+   such a tile sums the sequence numbers and diagnostics over them (the
+   sums are only meaningful as deltas between snapshots, which is how
+   they are reported). */
+
 static void
 snap( ulong             tile_cnt,     /* Number of tiles to snapshot */
+      ulong             out_max,      /* Max number of mcaches and fseqs per tile */
       snap_t *          snap_cur,     /* Snaphot for each tile, indexed [0,tile_cnt) */
       fd_cnc_t **       tile_cnc,     /* Local cnc    joins for each tile, NULL if n/a, indexed [0,tile_cnt) */
-      fd_frag_meta_t ** tile_mcache,  /* Local mcache joins for each tile, NULL if n/a, indexed [0,tile_cnt) */
-      ulong **          tile_fseq ) { /* Local fseq   joins for each tile, NULL if n/a, indexed [0,tile_cnt) */
+      fd_frag_meta_t ** tile_mcache,  /* Local mcache joins for each tile, NULL if n/a, indexed [0,tile_cnt*out_max) */
+      ulong **          tile_fseq ) { /* Local fseq   joins for each tile, NULL if n/a, indexed [0,tile_cnt*out_max) */
 
   for( ulong tile_idx=0UL; tile_idx<tile_cnt; tile_idx++ ) {
     snap_t * snap = &snap_cur[ tile_idx ];
@@ -282,32 +294,57 @@ snap( ulong             tile_cnt,     /* Number of tiles to snapshot */
       FD_COMPILER_MFENCE();
 
       pmap |= 1UL;
-    }
 
-    fd_frag_meta_t const * mcache = tile_mcache[ tile_idx ];
-    if( FD_LIKELY( mcache ) ) {
-      ulong const * seq = (ulong const *)fd_mcache_seq_laddr_const( mcache );
-      snap->mcache_seq = fd_mcache_seq_query( seq );
+      if( fd_cnc_app_sz( cnc )>=192UL ) { /* Only the poh tile's cnc is guaranteed to be this large */
+        FD_COMPILER_MFENCE();
+        snap->cnc_diag_poh_hash_cnt     = cnc_diag[ FD_FRANK_CNC_DIAG_POH_HASH_CNT     ];
+        snap->cnc_diag_poh_tick_cnt     = cnc_diag[ FD_FRANK_CNC_DIAG_POH_TICK_CNT     ];
+        snap->cnc_diag_poh_mixin_cnt    = cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_CNT    ];
+        snap->cnc_diag_poh_mixin_lat_ns = cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_LAT_NS ];
+        FD_COMPILER_MFENCE();
 
-      pmap |= 2UL;
+        pmap |= 8UL;
+      }
     }
 
-    ulong const * fseq = tile_fseq[ tile_idx ];
-    if( FD_LIKELY( fseq ) ) {
-      snap->fseq_seq = fd_fseq_query( fseq );
-      ulong const * fseq_diag = (ulong const *)fd_fseq_app_laddr_const( fseq );
-      FD_COMPILER_MFENCE();
-      snap->fseq_diag_tot_cnt   = fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ];
-      snap->fseq_diag_tot_sz    = fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ];
-      snap->fseq_diag_filt_cnt  = fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ];
-      snap->fseq_diag_filt_sz   = fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ];
-      snap->fseq_diag_ovrnp_cnt = fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ];
-      snap->fseq_diag_ovrnr_cnt = fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ];
-      snap->fseq_diag_slow_cnt  = fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT  ];
-      FD_COMPILER_MFENCE();
-      snap->fseq_diag_tot_cnt += snap->fseq_diag_filt_cnt;
-      snap->fseq_diag_tot_sz  += snap->fseq_diag_filt_sz;
-      pmap |= 4UL;
+    snap->mcache_seq          = 0UL;
+    snap->fseq_seq            = 0UL;
+    snap->fseq_diag_tot_cnt   = 0UL;
+    snap->fseq_diag_tot_sz    = 0UL;
+    snap->fseq_diag_filt_cnt  = 0UL;
+    snap->fseq_diag_filt_sz   = 0UL;
+    snap->fseq_diag_ovrnp_cnt = 0UL;
+    snap->fseq_diag_ovrnr_cnt = 0UL;
+    snap->fseq_diag_slow_cnt  = 0UL;
+
+    for( ulong out_idx=0UL; out_idx<out_max; out_idx++ ) {
+      fd_frag_meta_t const * mcache = tile_mcache[ tile_idx*out_max + out_idx ];
+      if( FD_LIKELY( mcache ) ) {
+        ulong const * seq = (ulong const *)fd_mcache_seq_laddr_const( mcache );
+        snap->mcache_seq += fd_mcache_seq_query( seq );
+
+        pmap |= 2UL;
+      }
+
+      ulong const * fseq = tile_fseq[ tile_idx*out_max + out_idx ];
+      if( FD_LIKELY( fseq ) ) {
+        snap->fseq_seq += fd_fseq_query( fseq );
+        ulong const * fseq_diag = (ulong const *)fd_fseq_app_laddr_const( fseq );
+        FD_COMPILER_MFENCE();
+        ulong pub_cnt  = fseq_diag[ FD_FSEQ_DIAG_PUB_CNT  ];
+        ulong pub_sz   = fseq_diag[ FD_FSEQ_DIAG_PUB_SZ   ];
+        ulong filt_cnt = fseq_diag[ FD_FSEQ_DIAG_FILT_CNT ];
+        ulong filt_sz  = fseq_diag[ FD_FSEQ_DIAG_FILT_SZ  ];
+        snap->fseq_diag_ovrnp_cnt += fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ];
+        snap->fseq_diag_ovrnr_cnt += fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ];
+        snap->fseq_diag_slow_cnt  += fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT  ];
+        FD_COMPILER_MFENCE();
+        snap->fseq_diag_tot_cnt  += pub_cnt + filt_cnt;
+        snap->fseq_diag_tot_sz   += pub_sz  + filt_sz;
+        snap->fseq_diag_filt_cnt += filt_cnt;
+        snap->fseq_diag_filt_sz  += filt_sz;
+        pmap |= 4UL;
+      }
     }
 
     snap->pmap = pmap;
@@ -345,15 +382,36 @@ main( int     argc,
   uchar const * verify_pods = fd_pod_query_subpod( cfg_pod, "verify" );
   ulong verify_cnt = fd_pod_cnt_subpod( verify_pods );
   FD_LOG_INFO(( "%lu verify found", verify_cnt ));
-  ulong tile_cnt = 3UL + verify_cnt;
+
+  uchar const * shard_pods = fd_pod_query_subpod( cfg_pod, "dedup.shard" );
+  ulong shard_cnt = fd_pod_cnt_subpod( shard_pods );
+  FD_LOG_INFO(( "%lu dedup shard found", shard_cnt ));
+
+  uchar const * poh_pod = fd_pod_query_subpod( cfg_pod, "poh" );
+  ulong poh_cnt = poh_pod ? 1UL : 0UL;
+  FD_LOG_INFO(( "%lu poh found", poh_cnt ));
+
+  ulong load_cnt = 0UL;
+  for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+    fd_pod_info_t info = fd_pod_iter_info( iter );
+    if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+    load_cnt += (ulong)!!fd_pod_query_subpod( (uchar const *)info.val, "load" );
+  }
+  FD_LOG_INFO(( "%lu verify load found", load_cnt ));
+
+  ulong link_cnt = 3UL + verify_cnt + shard_cnt; /* The poh and load tiles (if any) are after the shard tiles and not part of the link table */
+  ulong tile_cnt = link_cnt + poh_cnt + load_cnt;
+  ulong out_max  = fd_ulong_max( shard_cnt, 1UL ); /* A verify has an out per dedup shard if sharded */
 
   /* Join all IPC objects for this frank instance */
 
   char const **     tile_name   = fd_alloca( alignof(char const *    ), sizeof(char const *    )*tile_cnt );
+  char *            load_name   = fd_alloca( 1UL,                       FD_LOG_NAME_MAX*fd_ulong_max( load_cnt, 1UL ) );
   fd_cnc_t **       tile_cnc    = fd_alloca( alignof(fd_cnc_t *      ), sizeof(fd_cnc_t *      )*tile_cnt );
-  fd_frag_meta_t ** tile_mcache = fd_alloca( alignof(fd_frag_meta_t *), sizeof(fd_frag_meta_t *)*tile_cnt );
-  ulong **          tile_fseq   = fd_alloca( alignof(ulong *         ), sizeof(ulong *         )*tile_cnt );
-  if( FD_UNLIKELY( (!tile_name) | (!tile_cnc) | (!tile_mcache) | (!tile_fseq) ) ) FD_LOG_ERR(( "fd_alloca failed" )); /* paranoia */
+  fd_frag_meta_t ** tile_mcache = fd_alloca( alignof(fd_frag_meta_t *), sizeof(fd_frag_meta_t *)*tile_cnt*out_max );
+  ulong **          tile_fseq   = fd_alloca( alignof(ulong *         ), sizeof(ulong *         )*tile_cnt*out_max );
+  if( FD_UNLIKELY( (!tile_name) | (!load_name) | (!tile_cnc) | (!tile_mcache) | (!tile_fseq) ) ) FD_LOG_ERR(( "fd_alloca failed" )); /* paranoia */
+  for( ulong idx=0UL; idx<tile_cnt*out_max; idx++ ) { tile_mcache[ idx ] = NULL; tile_fseq[ idx ] = NULL; }
   
   do {
     ulong tile_idx = 0UL;
@@ -363,8 +421,7 @@ main( int     argc,
     tile_cnc[ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( cfg_pod, "main.cnc" ) );
     if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
     if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
-    tile_mcache[ tile_idx ] = NULL; /* main has no mcache */
-    tile_fseq  [ tile_idx ] = NULL; /* main has no fseq */
+    /* main has no mcache or fseq */
     tile_idx++;
 
     tile_name[ tile_idx ] = "pack";
@@ -372,8 +429,7 @@ main( int     argc,
     tile_cnc[ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( cfg_pod, "pack.cnc" ) );
     if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
     if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
-    tile_mcache[ tile_idx ] = NULL; /* pack has no mcache */
-    tile_fseq  [ tile_idx ] = NULL; /* pack has no fseq */
+    /* pack has no mcache or fseq */
     tile_idx++;
 
     tile_name[ tile_idx ] = "dedup";
@@ -382,11 +438,11 @@ main( int     argc,
     if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
     if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
     FD_LOG_INFO(( "joining %s.dedup.mcache", cfg_path ));
-    tile_mcache[ tile_idx ] = fd_mcache_join( fd_wksp_pod_map( cfg_pod, "dedup.mcache" ) );
-    if( FD_UNLIKELY( !tile_mcache[ tile_idx ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+    tile_mcache[ tile_idx*out_max ] = fd_mcache_join( fd_wksp_pod_map( cfg_pod, "dedup.mcache" ) );
+    if( FD_UNLIKELY( !tile_mcache[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
     FD_LOG_INFO(( "joining %s.dedup.fseq", cfg_path ));
-    tile_fseq[ tile_idx ] = fd_fseq_join( fd_wksp_pod_map( cfg_pod, "dedup.fseq" ) );
-    if( FD_UNLIKELY( !tile_fseq[ tile_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+    tile_fseq[ tile_idx*out_max ] = fd_fseq_join( fd_wksp_pod_map( cfg_pod, "dedup.fseq" ) );
+    if( FD_UNLIKELY( !tile_fseq[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
     tile_idx++;
 
     for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
@@ -400,14 +456,94 @@ main( int     argc,
       tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( verify_pod, "cnc" ) );
       if( FD_UNLIKELY( !tile_cnc[tile_idx] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
       if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
-      FD_LOG_INFO(( "joining %s.verify.%s.mcache", cfg_path, verify_name ));
-      tile_mcache[ tile_idx ] = fd_mcache_join( fd_wksp_pod_map( verify_pod, "mcache" ) );
-      if( FD_UNLIKELY( !tile_mcache[ tile_idx ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
-      FD_LOG_INFO(( "joining %s.verify.%s.fseq", cfg_path, verify_name ));
-      tile_fseq[ tile_idx ] = fd_fseq_join( fd_wksp_pod_map( verify_pod, "fseq" ) );
-      if( FD_UNLIKELY( !tile_fseq[ tile_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+      if( !shard_cnt ) {
+        FD_LOG_INFO(( "joining %s.verify.%s.mcache", cfg_path, verify_name ));
+        tile_mcache[ tile_idx*out_max ] = fd_mcache_join( fd_wksp_pod_map( verify_pod, "mcache" ) );
+        if( FD_UNLIKELY( !tile_mcache[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+        FD_LOG_INFO(( "joining %s.verify.%s.fseq", cfg_path, verify_name ));
+        tile_fseq[ tile_idx*out_max ] = fd_fseq_join( fd_wksp_pod_map( verify_pod, "fseq" ) );
+        if( FD_UNLIKELY( !tile_fseq[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+      } else {
+        uchar const * out_pods = fd_pod_query_subpod( verify_pod, "shard" );
+        ulong out_idx = 0UL;
+        for( fd_pod_iter_t iter = fd_pod_iter_init( out_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+          fd_pod_info_t out_info = fd_pod_iter_info( iter );
+          if( FD_UNLIKELY( out_info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+          if( FD_UNLIKELY( out_idx>=out_max ) ) FD_LOG_ERR(( "too many %s.verify.%s.shard", cfg_path, verify_name ));
+          char const  * out_name =                out_info.key;
+          uchar const * out_pod  = (uchar const *)out_info.val;
+          FD_LOG_INFO(( "joining %s.verify.%s.shard.%s.mcache", cfg_path, verify_name, out_name ));
+          tile_mcache[ tile_idx*out_max + out_idx ] = fd_mcache_join( fd_wksp_pod_map( out_pod, "mcache" ) );
+          if( FD_UNLIKELY( !tile_mcache[ tile_idx*out_max + out_idx ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+          FD_LOG_INFO(( "joining %s.verify.%s.shard.%s.fseq", cfg_path, verify_name, out_name ));
+          tile_fseq[ tile_idx*out_max + out_idx ] = fd_fseq_join( fd_wksp_pod_map( out_pod, "fseq" ) );
+          if( FD_UNLIKELY( !tile_fseq[ tile_idx*out_max + out_idx ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+          out_idx++;
+        }
+      }
       tile_idx++;
     }
+
+    for( fd_pod_iter_t iter = fd_pod_iter_init( shard_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      char const  * shard_name =                info.key;
+      uchar const * shard_pod  = (uchar const *)info.val;
+
+      FD_LOG_INFO(( "joining %s.dedup.shard.%s.cnc", cfg_path, shard_name ));
+      tile_name[ tile_idx ] = shard_name;
+      tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( shard_pod, "cnc" ) );
+      if( FD_UNLIKELY( !tile_cnc[tile_idx] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+      if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
+      FD_LOG_INFO(( "joining %s.dedup.shard.%s.mcache", cfg_path, shard_name ));
+      tile_mcache[ tile_idx*out_max ] = fd_mcache_join( fd_wksp_pod_map( shard_pod, "mcache" ) );
+      if( FD_UNLIKELY( !tile_mcache[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+      FD_LOG_INFO(( "joining %s.dedup.shard.%s.fseq", cfg_path, shard_name ));
+      tile_fseq[ tile_idx*out_max ] = fd_fseq_join( fd_wksp_pod_map( shard_pod, "fseq" ) );
+      if( FD_UNLIKELY( !tile_fseq[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+      tile_idx++;
+    }
+
+    if( poh_cnt ) {
+      tile_name[ tile_idx ] = "poh";
+      FD_LOG_INFO(( "joining %s.poh.cnc", cfg_path ));
+      tile_cnc[ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( poh_pod, "cnc" ) );
+      if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+      if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<192UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 192 bytes" ));
+      FD_LOG_INFO(( "joining %s.poh.mcache", cfg_path ));
+      tile_mcache[ tile_idx*out_max ] = fd_mcache_join( fd_wksp_pod_map( poh_pod, "mcache" ) );
+      if( FD_UNLIKELY( !tile_mcache[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+      FD_LOG_INFO(( "joining %s.poh.in_fseq", cfg_path ));
+      tile_fseq[ tile_idx*out_max ] = fd_fseq_join( fd_wksp_pod_map( poh_pod, "in_fseq" ) );
+      if( FD_UNLIKELY( !tile_fseq[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+      tile_idx++;
+    }
+
+    /* A load tile is the producer of its verify's ingress */
+
+    ulong load_idx = 0UL;
+    for( fd_pod_iter_t iter = fd_pod_iter_init( verify_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      char const  * verify_name =                info.key;
+      uchar const * verify_pod  = (uchar const *)info.val;
+      uchar const * load_pod    = fd_pod_query_subpod( verify_pod, "load" );
+      if( !load_pod ) continue;
+
+      FD_LOG_INFO(( "joining %s.verify.%s.load.cnc", cfg_path, verify_name ));
+      tile_name[ tile_idx ] = fd_cstr_printf( load_name + FD_LOG_NAME_MAX*load_idx, FD_LOG_NAME_MAX, NULL, "%s.load", verify_name );
+      tile_cnc [ tile_idx ] = fd_cnc_join( fd_wksp_pod_map( load_pod, "cnc" ) );
+      if( FD_UNLIKELY( !tile_cnc[ tile_idx ] ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+      if( FD_UNLIKELY( fd_cnc_app_sz( tile_cnc[ tile_idx ] )<64UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 64 bytes" ));
+      FD_LOG_INFO(( "joining %s.verify.%s.in_mcache", cfg_path, verify_name ));
+      tile_mcache[ tile_idx*out_max ] = fd_mcache_join( fd_wksp_pod_map( verify_pod, "in_mcache" ) );
+      if( FD_UNLIKELY( !tile_mcache[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+      FD_LOG_INFO(( "joining %s.verify.%s.in_fseq", cfg_path, verify_name ));
+      tile_fseq[ tile_idx*out_max ] = fd_fseq_join( fd_wksp_pod_map( verify_pod, "in_fseq" ) );
+      if( FD_UNLIKELY( !tile_fseq[ tile_idx*out_max ] ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+      tile_idx++;
+      load_idx++;
+    }
   } while(0);
   
   /* Setup local objects used by this app */
@@ -421,7 +557,7 @@ main( int     argc,
 
   /* Get the inital reference diagnostic snapshot */
 
-  snap( tile_cnt, snap_prv, tile_cnc, tile_mcache, tile_fseq );
+  snap( tile_cnt, out_max, snap_prv, tile_cnc, tile_mcache, tile_fseq );
   long then; long tic; fd_tempo_observe_pair( &then, &tic );
 
   /* Monitor for duration ns.  Note that for duration==0, this
@@ -439,7 +575,7 @@ main( int     argc,
 
     fd_log_wait_until( then + dt_min + (long)fd_rng_ulong_roll( rng, 1UL+(ulong)(dt_max-dt_min) ) );
 
-    snap( tile_cnt, snap_cur, tile_cnc, tile_mcache, tile_fseq );
+    snap( tile_cnt, out_max, snap_cur, tile_cnc, tile_mcache, tile_fseq );
     long now; long toc; fd_tempo_observe_pair( &now, &toc );
     
     /* Pretty print a comparison between this diagnostic snapshot and
@@ -482,16 +618,17 @@ main( int     argc,
     printf( "\n" );
     printf( "         link |  tot TPS |  tot bps | uniq TPS | uniq bps |   ha tr%% | uniq bw%% | filt tr%% | filt bw%% |           ovrnp cnt |           ovrnr cnt |            slow cnt\n" );
     printf( "--------------+----------+----------+---------+----------+----------+----------+-----------+----------+---------------------+---------------------+---------------------\n" );
-    for( ulong tile_idx=2UL; tile_idx<tile_cnt; tile_idx++ ) {
+    for( ulong tile_idx=2UL; tile_idx<link_cnt; tile_idx++ ) {
       snap_t * prv = &snap_prv[ tile_idx ];
       snap_t * cur = &snap_cur[ tile_idx ];
       if( tile_idx==2UL ) printf( " %5s->%-5s", tile_name[ 2        ], tile_name[ 1 ] );
       else                printf( " %5s->%-5s", tile_name[ tile_idx ], tile_name[ 2 ] );
       long dt = now-then;
-      ulong cur_raw_cnt = cur->cnc_diag_ha_filt_cnt + cur->fseq_diag_tot_cnt;
-      ulong cur_raw_sz  = cur->cnc_diag_ha_filt_sz  + cur->fseq_diag_tot_sz;
-      ulong prv_raw_cnt = prv->cnc_diag_ha_filt_cnt + prv->fseq_diag_tot_cnt;
-      ulong prv_raw_sz  = prv->cnc_diag_ha_filt_sz  + prv->fseq_diag_tot_sz;
+      int   is_verify   = (3UL<=tile_idx) & (tile_idx<3UL+verify_cnt); /* Only verify tiles do ha filtering */
+      ulong cur_raw_cnt = (is_verify ? cur->cnc_diag_ha_filt_cnt : 0UL) + cur->fseq_diag_tot_cnt;
+      ulong cur_raw_sz  = (is_verify ? cur->cnc_diag_ha_filt_sz  : 0UL) + cur->fseq_diag_tot_sz;
+      ulong prv_raw_cnt = (is_verify ? prv->cnc_diag_ha_filt_cnt : 0UL) + prv->fseq_diag_tot_cnt;
+      ulong prv_raw_sz  = (is_verify ? prv->cnc_diag_ha_filt_sz  : 0UL) + prv->fseq_diag_tot_sz;
 
       printf( " | " ); printf_rate( 1e9, 0., cur_raw_cnt,             prv_raw_cnt,             dt );
       printf( " | " ); printf_rate( 8e9, 0., cur_raw_sz,              prv_raw_sz,              dt ); /* Assumes sz incl framing */
@@ -513,6 +650,25 @@ main( int     argc,
       printf( "\n" );
     }
     printf( "\n" );
+    if( poh_cnt ) {
+      printf( "  poh |   hash/s |   tick/s |  mixin/s |  avg mixin lat\n" );
+      printf( "------+----------+----------+----------+---------------\n" );
+      snap_t * prv = &snap_prv[ link_cnt ];
+      snap_t * cur = &snap_cur[ link_cnt ];
+      long dt = now-then;
+      printf( " %4s", tile_name[ link_cnt ] );
+      if( FD_LIKELY( cur->pmap & 8UL ) ) {
+        ulong mixin_cnt = cur->cnc_diag_poh_mixin_cnt    - prv->cnc_diag_poh_mixin_cnt;
+        ulong lat_ns    = cur->cnc_diag_poh_mixin_lat_ns - prv->cnc_diag_poh_mixin_lat_ns;
+        printf( " | " ); printf_rate( 1e9, 0., cur->cnc_diag_poh_hash_cnt,  prv->cnc_diag_poh_hash_cnt,  dt );
+        printf( " | " ); printf_rate( 1e9, 0., cur->cnc_diag_poh_tick_cnt,  prv->cnc_diag_poh_tick_cnt,  dt );
+        printf( " | " ); printf_rate( 1e9, 0., cur->cnc_diag_poh_mixin_cnt, prv->cnc_diag_poh_mixin_cnt, dt );
+        printf( " |     " ); printf_age( mixin_cnt ? (long)(lat_ns/mixin_cnt) : 0L );
+      } else {
+        printf( " |        - |        - |        - |              -" );
+      }
+      printf( "\n\n" );
+    }
 
     /* Stop once we've been monitoring for duration ns */
 
@@ -529,10 +685,12 @@ main( int     argc,
 
   FD_LOG_NOTICE(( "cleaning up" ));
   fd_rng_delete( fd_rng_leave( rng ) );
+  for( ulong idx=tile_cnt*out_max; idx; idx-- ) {
+    if( FD_LIKELY( tile_fseq  [ idx-1UL ] ) ) fd_wksp_pod_unmap( fd_fseq_leave  ( tile_fseq  [ idx-1UL ] ) );
+    if( FD_LIKELY( tile_mcache[ idx-1UL ] ) ) fd_wksp_pod_unmap( fd_mcache_leave( tile_mcache[ idx-1UL ] ) );
+  }
   for( ulong tile_idx=tile_cnt; tile_idx; tile_idx-- ) {
-    if( FD_LIKELY( tile_fseq  [ tile_idx-1UL ] ) ) fd_wksp_pod_unmap( fd_fseq_leave  ( tile_fseq  [ tile_idx-1UL ] ) );
-    if( FD_LIKELY( tile_mcache[ tile_idx-1UL ] ) ) fd_wksp_pod_unmap( fd_mcache_leave( tile_mcache[ tile_idx-1UL ] ) );
-    if( FD_LIKELY( tile_cnc   [ tile_idx-1UL ] ) ) fd_wksp_pod_unmap( fd_cnc_leave   ( tile_cnc   [ tile_idx-1UL ] ) );
+    if( FD_LIKELY( tile_cnc[ tile_idx-1UL ] ) ) fd_wksp_pod_unmap( fd_cnc_leave( tile_cnc[ tile_idx-1UL ] ) );
   }
   fd_wksp_pod_detach( pod );
   fd_halt();
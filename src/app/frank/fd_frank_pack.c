@@ -2,6 +2,36 @@
 
 #if FD_HAS_FRANK
 
+/* A fd_frank_pack_lane_t is the pack tile's local state for publishing
+   microblocks to a downstream execution lane.  A lane has its own
+   mcache, dcache and fseq (flow control, the lane consumer has copied
+   out frags before fseq) and a done fseq (completions, the lane
+   consumer has finished executing the transactions of frags before
+   done, in publication order).  ring[ s & (depth-1) ] is the pack
+   transaction published as frag s, it stays in flight in the pack until
+   done passes s. */
+
+struct fd_frank_pack_lane {
+  fd_frag_meta_t *        mcache;
+  ulong                   depth;
+  ulong *                 sync;
+  ulong                   seq;      /* Next frag to publish */
+  uchar *                 dcache;
+  fd_wksp_t *             wksp;
+  ulong                   chunk0;
+  ulong                   wmark;
+  ulong                   chunk;
+  ulong *                 fseq;
+  fd_fctl_t *             fctl;
+  ulong                   cr_avail;
+  ulong *                 done;
+  ulong                   done_seq; /* Oldest published frag not yet completed */
+  ulong                   cu;       /* Estimated compute units in flight on this lane */
+  fd_pack_txn_t const **  ring;
+};
+
+typedef struct fd_frank_pack_lane fd_frank_pack_lane_t;
+
 int
 fd_frank_pack_task( int     argc,
                     char ** argv ) {
@@ -27,7 +57,19 @@ fd_frank_pack_task( int     argc,
   fd_cnc_t * cnc = fd_cnc_join( fd_wksp_pod_map( cfg_pod, "pack.cnc" ) );
   if( FD_UNLIKELY( !cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
   if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) FD_LOG_ERR(( "cnc not in boot state" ));
-  /* FIXME: CNC DIAG REGION? */
+  ulong * cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
+  if( FD_UNLIKELY( !cnc_diag ) ) FD_LOG_ERR(( "fd_cnc_app_laddr failed" ));
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP         ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT        ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_PENDING_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_EVICT_CNT    ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_MBLK_CNT     ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_TXN_CNT      ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_CU_CNT       ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_INFLIGHT_CNT ] ) = 0UL;
+  FD_COMPILER_MFENCE();
 
   FD_LOG_INFO(( "joining %s.dedup.mcache", cfg_path ));
   fd_frag_meta_t const * mcache = fd_mcache_join( fd_wksp_pod_map( cfg_pod, "dedup.mcache" ) );
@@ -55,13 +97,80 @@ fd_frank_pack_task( int     argc,
   FD_COMPILER_MFENCE();
   fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ] = 0UL;
   fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ] = 0UL;
+  fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ] = 0UL;
+  fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ] = 0UL;
   fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ] = 0UL;
   fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ] = 0UL;
   FD_COMPILER_MFENCE();
   ulong accum_pub_cnt   = 0UL;
   ulong accum_pub_sz    = 0UL;
+  ulong accum_filt_cnt  = 0UL;
+  ulong accum_filt_sz   = 0UL;
   ulong accum_ovrnp_cnt = 0UL;
   ulong accum_ovrnr_cnt = 0UL;
+  ulong accum_evict_cnt = 0UL;
+  ulong accum_mblk_cnt  = 0UL;
+  ulong accum_txn_cnt   = 0UL;
+  ulong accum_cu_cnt    = 0UL;
+
+  uchar const * lane_pods = fd_pod_query_subpod( cfg_pod, "pack.lane" );
+  ulong lane_cnt = lane_pods ? fd_pod_cnt_subpod( lane_pods ) : 0UL;
+  FD_LOG_INFO(( "%lu lane found", lane_cnt ));
+
+  fd_frank_pack_lane_t * lane = (fd_frank_pack_lane_t *)
+    fd_alloca( alignof(fd_frank_pack_lane_t), sizeof(fd_frank_pack_lane_t)*fd_ulong_max( lane_cnt, 1UL ) );
+  if( FD_UNLIKELY( !lane ) ) FD_LOG_ERR(( "fd_alloca failed" ));
+
+  ulong lane_depth_sum = 0UL;
+  ulong lane_idx       = 0UL;
+  if( lane_pods ) for( fd_pod_iter_t iter = fd_pod_iter_init( lane_pods ); !fd_pod_iter_done( iter ); iter = fd_pod_iter_next( iter ) ) {
+    fd_pod_info_t info = fd_pod_iter_info( iter );
+    if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+    char const  *          lane_name =                info.key;
+    uchar const *          lane_pod  = (uchar const *)info.val;
+    fd_frank_pack_lane_t * l         = lane + lane_idx;
+
+    FD_LOG_INFO(( "joining %s.pack.lane.%s.mcache", cfg_path, lane_name ));
+    l->mcache = fd_mcache_join( fd_wksp_pod_map( lane_pod, "mcache" ) );
+    if( FD_UNLIKELY( !l->mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+    l->depth = fd_mcache_depth( l->mcache );
+    l->sync  = fd_mcache_seq_laddr( l->mcache );
+    l->seq   = fd_mcache_seq_query( l->sync );
+
+    FD_LOG_INFO(( "joining %s.pack.lane.%s.dcache", cfg_path, lane_name ));
+    l->dcache = fd_dcache_join( fd_wksp_pod_map( lane_pod, "dcache" ) );
+    if( FD_UNLIKELY( !l->dcache ) ) FD_LOG_ERR(( "fd_dcache_join failed" ));
+    l->wksp = fd_wksp_containing( l->dcache ); /* chunks are referenced relative to the containing workspace */
+    if( FD_UNLIKELY( !l->wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
+    l->chunk0 = fd_dcache_compact_chunk0( l->wksp, l->dcache );
+    l->wmark  = fd_dcache_compact_wmark ( l->wksp, l->dcache, FD_PACK_TXN_MTU ); /* FIXME: SAFETY CHECK THE FOOTPRINT? */
+    l->chunk  = l->chunk0;
+
+    FD_LOG_INFO(( "joining %s.pack.lane.%s.fseq", cfg_path, lane_name ));
+    l->fseq = fd_fseq_join( fd_wksp_pod_map( lane_pod, "fseq" ) );
+    if( FD_UNLIKELY( !l->fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+    ulong * lane_fseq_diag = (ulong *)fd_fseq_app_laddr( l->fseq );
+    if( FD_UNLIKELY( !lane_fseq_diag ) ) FD_LOG_ERR(( "fd_fseq_app_laddr failed" ));
+    FD_VOLATILE( lane_fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ) = 0UL; /* Managed by the fctl */
+
+    l->fctl = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( fd_alloca( FD_FCTL_ALIGN, fd_fctl_footprint( 1UL ) ),
+                                                                               1UL ) ),
+                                                    l->depth, l->fseq, &lane_fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ),
+                                1UL /*cr_burst*/, 0UL, 0UL, 0UL );
+    if( FD_UNLIKELY( !l->fctl ) ) FD_LOG_ERR(( "Unable to create flow control" ));
+    l->cr_avail = 0UL;
+
+    FD_LOG_INFO(( "joining %s.pack.lane.%s.done", cfg_path, lane_name ));
+    l->done = fd_fseq_join( fd_wksp_pod_map( lane_pod, "done" ) );
+    if( FD_UNLIKELY( !l->done ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+    l->done_seq = l->seq;
+    l->cu       = 0UL;
+    l->ring     = NULL;
+
+    lane_depth_sum += l->depth;
+    lane_idx++;
+  }
+  lane_cnt = lane_idx;
 
   /* Setup local objects used by this tile */
 
@@ -78,6 +187,52 @@ fd_frank_pack_task( int     argc,
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
   if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_join failed" ));
 
+  ulong mblk_txn_max = fd_pod_query_ulong( cfg_pod, "pack.microblock_txn_max", FD_PACK_MICROBLOCK_TXN_MAX );
+  ulong mblk_cu_max  = fd_pod_query_ulong( cfg_pod, "pack.microblock_cu_max",  12000000UL                 );
+  FD_LOG_INFO(( "configuring microblocks (%s.pack.microblock_txn_max %lu, %s.pack.microblock_cu_max %lu)",
+                cfg_path, mblk_txn_max, cfg_path, mblk_cu_max ));
+  if( FD_UNLIKELY( !mblk_txn_max || mblk_txn_max>FD_PACK_MICROBLOCK_TXN_MAX ) ) FD_LOG_ERR(( "bad microblock_txn_max" ));
+  if( FD_UNLIKELY( !mblk_cu_max ) ) FD_LOG_ERR(( "bad microblock_cu_max" ));
+
+  ulong lane_cu_max = fd_pod_query_ulong( cfg_pod, "pack.lane_cu_max", 4UL*mblk_cu_max );
+  FD_LOG_INFO(( "configuring lanes (%s.pack.lane_cu_max %lu)", cfg_path, lane_cu_max ));
+  if( FD_UNLIKELY( !lane_cu_max ) ) FD_LOG_ERR(( "bad lane_cu_max" ));
+
+  /* Without lanes, microblocks are retired as soon as they are
+     scheduled.  With lanes, each published frag is in flight until its
+     lane reports it done. */
+
+  ulong inflight_max = lane_cnt ? lane_depth_sum : mblk_txn_max;
+
+  ulong pending_max = fd_pod_query_ulong( cfg_pod, "pack.pending_max", 4096UL );
+  FD_LOG_INFO(( "creating pack (%s.pack.pending_max %lu, inflight_max %lu)", cfg_path, pending_max, inflight_max ));
+  ulong pack_footprint = fd_pack_footprint( pending_max, inflight_max );
+  if( FD_UNLIKELY( !pack_footprint ) ) FD_LOG_ERR(( "bad pending_max" ));
+  void * pack_mem = fd_wksp_alloc_laddr( wksp, fd_pack_align(), pack_footprint, 1UL );
+  if( FD_UNLIKELY( !pack_mem ) ) FD_LOG_ERR(( "fd_wksp_alloc_laddr failed" ));
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_mem, pending_max, inflight_max, fd_rng_ulong( rng ) ) );
+  if( FD_UNLIKELY( !pack ) ) FD_LOG_ERR(( "fd_pack_join failed" ));
+
+  fd_pack_txn_t const ** ring_mem = NULL;
+  if( lane_cnt ) {
+    ring_mem = (fd_pack_txn_t const **)fd_wksp_alloc_laddr( wksp, alignof(fd_pack_txn_t const *),
+                                                              lane_depth_sum*sizeof(fd_pack_txn_t const *), 1UL );
+    if( FD_UNLIKELY( !ring_mem ) ) FD_LOG_ERR(( "fd_wksp_alloc_laddr failed" ));
+    ulong off = 0UL;
+    for( ulong lane_idx=0UL; lane_idx<lane_cnt; lane_idx++ ) { lane[ lane_idx ].ring = ring_mem + off; off += lane[ lane_idx ].depth; }
+  }
+  ulong mblk_seq = 0UL; /* Microblock sequence number (used as the frag sig of the microblock's frags) */
+  int   in_backp = 0;
+
+  fd_pack_txn_t const * mblk[ FD_PACK_MICROBLOCK_TXN_MAX ];
+
+  /* Frags are copied out of the dcache speculatively into a local
+     scratch buffer and only inserted into the pack after we've verified
+     we weren't overrun while copying. */
+
+  uchar * payload = (uchar *)fd_alloca( 128UL, FD_PACK_TXN_MTU );
+  if( FD_UNLIKELY( !payload ) ) FD_LOG_ERR(( "fd_alloca failed" ));
+
   /* Start packing */
 
   FD_LOG_INFO(( "pack run" ));
@@ -91,6 +246,9 @@ fd_frank_pack_task( int     argc,
 
     if( FD_UNLIKELY( (now-then)>=0L ) ) {
 
+      /* Send synchronization info */
+      for( ulong lane_idx=0UL; lane_idx<lane_cnt; lane_idx++ ) fd_mcache_seq_update( lane[ lane_idx ].sync, lane[ lane_idx ].seq );
+
       /* Send flow control credits */
       fd_fctl_rx_cr_return( fseq, seq );
 
@@ -99,13 +257,27 @@ fd_frank_pack_task( int     argc,
       FD_COMPILER_MFENCE();
       fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ] += accum_pub_cnt;
       fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ] += accum_pub_sz;
+      fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ] += accum_filt_cnt;
+      fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ] += accum_filt_sz;
       fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ] += accum_ovrnp_cnt;
       fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ] += accum_ovrnr_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_PENDING_CNT  ] ) = fd_pack_pending_cnt( pack );
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_EVICT_CNT    ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_EVICT_CNT  ] ) + accum_evict_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_MBLK_CNT     ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_MBLK_CNT   ] ) + accum_mblk_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_TXN_CNT      ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_TXN_CNT    ] ) + accum_txn_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_CU_CNT       ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_CU_CNT     ] ) + accum_cu_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PACK_INFLIGHT_CNT ] ) = fd_pack_inflight_cnt( pack );
       FD_COMPILER_MFENCE();
       accum_pub_cnt   = 0UL;
       accum_pub_sz    = 0UL;
+      accum_filt_cnt  = 0UL;
+      accum_filt_sz   = 0UL;
       accum_ovrnp_cnt = 0UL;
       accum_ovrnr_cnt = 0UL;
+      accum_evict_cnt = 0UL;
+      accum_mblk_cnt  = 0UL;
+      accum_txn_cnt   = 0UL;
+      accum_cu_cnt    = 0UL;
 
       /* Receive command-and-control signals */
       ulong s = fd_cnc_signal_query( cnc );
@@ -114,13 +286,97 @@ fd_frank_pack_task( int     argc,
         break;
       }
 
+      /* Receive flow control credits */
+      for( ulong lane_idx=0UL; lane_idx<lane_cnt; lane_idx++ ) {
+        fd_frank_pack_lane_t * l = lane + lane_idx;
+        l->cr_avail = fd_fctl_tx_cr_update( l->fctl, l->cr_avail, l->seq );
+      }
+
       /* Reload housekeeping timer */
       then = now + (long)fd_tempo_async_reload( rng, async_min );
     }
 
-    /* See if there are any transactions waiting to be packed */
+    /* Schedule a microblock when there is nothing new to consider or
+       when the pending pool is full. */
     ulong seq_found = fd_frag_meta_seq_query( mline );
     long  diff      = fd_seq_diff( seq_found, seq );
+    if( FD_UNLIKELY( (diff<0L) | (fd_pack_pending_cnt( pack )>=pending_max) ) ) {
+
+      if( FD_UNLIKELY( !lane_cnt ) ) {
+
+        /* No lanes, retire the microblock here */
+        ulong mblk_cnt = fd_pack_schedule( pack, mblk_txn_max, mblk_cu_max, mblk );
+        for( ulong i=0UL; i<mblk_cnt; i++ ) {
+          accum_cu_cnt += (ulong)mblk[i]->compute_est;
+          fd_pack_complete( pack, mblk[i] );
+        }
+        accum_mblk_cnt += (ulong)!!mblk_cnt;
+        accum_txn_cnt  += mblk_cnt;
+
+      } else {
+
+        /* Receive completions.  Each lane completes its frags in order
+           so everything before the lane's done seq can be released.
+           Then pick the eligible lane (one with credits and room) with
+           the least estimated compute in flight. */
+        fd_frank_pack_lane_t * best      = NULL;
+        ulong                  best_room = 0UL;
+        for( ulong lane_idx=0UL; lane_idx<lane_cnt; lane_idx++ ) {
+          fd_frank_pack_lane_t * l = lane + lane_idx;
+
+          ulong done_found = fd_fseq_query( l->done );
+          if( FD_UNLIKELY( fd_seq_gt( done_found, l->seq ) ) ) done_found = l->seq; /* Lane is confused, don't trust it */
+          while( fd_seq_lt( l->done_seq, done_found ) ) {
+            fd_pack_txn_t const * txn = l->ring[ l->done_seq & (l->depth-1UL) ];
+            l->cu -= (ulong)txn->compute_est;
+            fd_pack_complete( pack, txn );
+            l->done_seq = fd_seq_inc( l->done_seq, 1UL );
+          }
+
+          ulong room = fd_ulong_min( l->cr_avail, l->depth - (ulong)fd_seq_diff( l->seq, l->done_seq ) );
+          if( (!!room) & (l->cu<lane_cu_max) & ((!best) || (l->cu<best->cu)) ) { best = l; best_room = room; }
+        }
+
+        if( FD_UNLIKELY( !best ) ) {
+          if( FD_UNLIKELY( (!in_backp) & (!!fd_pack_pending_cnt( pack )) ) ) {
+            FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP  ] ) = 1UL;
+            FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT ] )+1UL;
+            in_backp = 1;
+          }
+        } else {
+          if( FD_UNLIKELY( in_backp ) ) {
+            FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP ] ) = 0UL;
+            in_backp = 0;
+          }
+
+          ulong mblk_cnt = fd_pack_schedule( pack, fd_ulong_min( mblk_txn_max, best_room ), mblk_cu_max, mblk );
+          if( FD_LIKELY( mblk_cnt ) ) {
+
+            /* Publish the microblock to the lane, one frag per
+               transaction (the microblock is delimited by som / eom) */
+            ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
+            for( ulong i=0UL; i<mblk_cnt; i++ ) {
+              fd_pack_txn_t const * txn = mblk[i];
+              ulong                 sz  = (ulong)txn->payload_sz;
+              fd_memcpy( fd_chunk_to_laddr( best->wksp, best->chunk ), txn->payload, sz );
+              ulong ctl = fd_frag_meta_ctl( 0UL /*orig*/, !i /*som*/, i==mblk_cnt-1UL /*eom*/, 0 /*err*/ );
+              fd_mcache_publish( best->mcache, best->depth, best->seq, mblk_seq, best->chunk, sz, ctl, tspub, tspub );
+              best->ring[ best->seq & (best->depth-1UL) ] = txn;
+              best->cu   += (ulong)txn->compute_est;
+              best->chunk = fd_dcache_compact_next( best->chunk, sz, best->chunk0, best->wmark );
+              best->seq   = fd_seq_inc( best->seq, 1UL );
+              accum_cu_cnt += (ulong)txn->compute_est;
+            }
+            best->cr_avail -= mblk_cnt;
+            mblk_seq++;
+            accum_mblk_cnt++;
+            accum_txn_cnt += mblk_cnt;
+          }
+        }
+      }
+    }
+
+    /* See if there are any transactions waiting to be packed */
     if( FD_UNLIKELY( diff ) ) { /* caught up or overrun, optimize for expected sequence number ready */
       if( FD_LIKELY( diff<0L ) ) { /* caught up */
         FD_SPIN_PAUSE();
@@ -138,8 +394,10 @@ fd_frank_pack_task( int     argc,
     /* At this point, we have started receiving frag seq with details in
        mline at time now.  Speculatively processs it here. */
 
-    /* Placeholder for speculative pack operations */
-    ulong sz = (ulong)mline->sz;
+    ulong sz      = (ulong)mline->sz;
+    ulong chunk   = (ulong)mline->chunk;
+    int   too_big = sz>FD_PACK_TXN_MTU;
+    if( FD_LIKELY( !too_big ) ) fd_memcpy( payload, fd_chunk_to_laddr_const( wksp, chunk ), sz );
 
     /* Check that we weren't overrun while processing */
     seq_found = fd_frag_meta_seq_query( mline );
@@ -149,9 +407,18 @@ fd_frank_pack_task( int     argc,
       continue;
     }
 
-    /* Placeholder for non-speculative pack operations */
-    accum_pub_cnt++;
-    accum_pub_sz += sz;
+    /* Insert the transaction into the pending pool (frags that can't
+       be a valid transaction or that are lower priority than all the
+       pending transactions when the pool is full are filtered) */
+    int res = too_big ? FD_PACK_INSERT_REJECT_SZ : fd_pack_insert( pack, payload, sz );
+    if( FD_LIKELY( res>=0 ) ) {
+      accum_pub_cnt++;
+      accum_pub_sz    += sz;
+      accum_evict_cnt += (ulong)(res==FD_PACK_INSERT_ACCEPT_EVICT);
+    } else {
+      accum_filt_cnt++;
+      accum_filt_sz += sz;
+    }
 
     /* Wind up for the next iteration */
     seq   = fd_seq_inc( seq, 1UL );
@@ -162,9 +429,19 @@ fd_frank_pack_task( int     argc,
   
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
   FD_LOG_INFO(( "pack fini" ));
+  if( ring_mem ) fd_wksp_free_laddr( ring_mem );
+  fd_wksp_free_laddr( fd_pack_delete( fd_pack_leave( pack ) ) );
   fd_rng_delete    ( fd_rng_leave   ( rng    ) );
   fd_wksp_pod_unmap( fd_fseq_leave  ( fseq   ) );
   fd_wksp_pod_unmap( fd_mcache_leave( mcache ) );
+  for( ulong lane_idx=lane_cnt; lane_idx; lane_idx-- ) {
+    fd_frank_pack_lane_t * l = lane + lane_idx - 1UL;
+    fd_wksp_pod_unmap( fd_fseq_leave  ( l->done   ) );
+    fd_fctl_delete   ( fd_fctl_leave  ( l->fctl   ) );
+    fd_wksp_pod_unmap( fd_fseq_leave  ( l->fseq   ) );
+    fd_wksp_pod_unmap( fd_dcache_leave( l->dcache ) );
+    fd_wksp_pod_unmap( fd_mcache_leave( l->mcache ) );
+  }
   fd_wksp_pod_unmap( fd_cnc_leave   ( cnc    ) );
   fd_wksp_pod_detach( pod );
   return 0;
@@ -0,0 +1,340 @@
+#include "fd_frank.h"
+
+#if FD_HAS_FRANK
+
+FD_STATIC_ASSERT( FD_FRANK_POH_MTU==sizeof(fd_poh_entry_t), poh_mtu );
+
+int
+fd_frank_poh_task( int     argc,
+                   char ** argv ) {
+  (void)argc;
+  fd_log_thread_set( argv[0] );
+  FD_LOG_INFO(( "poh init" ));
+
+  /* Parse "command line" arguments */
+
+  char const * pod_gaddr = argv[1];
+  char const * cfg_path  = argv[2];
+
+  /* Load up the configuration for this frank instance */
+
+  FD_LOG_INFO(( "using configuration in pod %s at path %s", pod_gaddr, cfg_path ));
+  uchar const * pod     = fd_wksp_pod_attach( pod_gaddr );
+  uchar const * cfg_pod = fd_pod_query_subpod( pod, cfg_path );
+  if( FD_UNLIKELY( !cfg_pod ) ) FD_LOG_ERR(( "path not found" ));
+
+  uchar const * poh_pod = fd_pod_query_subpod( cfg_pod, "poh" );
+  if( FD_UNLIKELY( !poh_pod ) ) FD_LOG_ERR(( "%s.poh path not found", cfg_path ));
+
+  /* Join the IPC objects needed this tile instance */
+
+  FD_LOG_INFO(( "joining %s.poh.cnc", cfg_path ));
+  fd_cnc_t * cnc = fd_cnc_join( fd_wksp_pod_map( poh_pod, "cnc" ) );
+  if( FD_UNLIKELY( !cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
+  if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) FD_LOG_ERR(( "cnc not in boot state" ));
+  if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<192UL ) ) FD_LOG_ERR(( "cnc app sz should be at least 192 bytes" ));
+  ulong * cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
+  if( FD_UNLIKELY( !cnc_diag ) ) FD_LOG_ERR(( "fd_cnc_app_laddr failed" ));
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP         ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT        ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_HASH_CNT     ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_TICK_CNT     ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_CNT    ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_LAT_NS ] ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  FD_LOG_INFO(( "joining %s.poh.mcache", cfg_path ));
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( poh_pod, "mcache" ) );
+  if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+  ulong   depth = fd_mcache_depth( mcache );
+  ulong * sync  = fd_mcache_seq_laddr( mcache );
+  ulong   seq   = fd_mcache_seq_query( sync );
+
+  FD_LOG_INFO(( "joining %s.poh.dcache", cfg_path ));
+  uchar * dcache = fd_dcache_join( fd_wksp_pod_map( poh_pod, "dcache" ) );
+  if( FD_UNLIKELY( !dcache ) ) FD_LOG_ERR(( "fd_dcache_join failed" ));
+  fd_wksp_t * wksp = fd_wksp_containing( dcache ); /* chunks are referenced relative to the containing workspace */
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
+  ulong   chunk0 = fd_dcache_compact_chunk0( wksp, dcache );
+  ulong   wmark  = fd_dcache_compact_wmark ( wksp, dcache, FD_FRANK_POH_MTU ); /* FIXME: SAFETY CHECK THE FOOTPRINT? */
+  ulong   chunk  = chunk0;
+
+  FD_LOG_INFO(( "joining %s.poh.in_mcache", cfg_path ));
+  fd_frag_meta_t const * in_mcache = fd_mcache_join( fd_wksp_pod_map( poh_pod, "in_mcache" ) );
+  if( FD_UNLIKELY( !in_mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+  ulong         in_depth = fd_mcache_depth( in_mcache );
+  ulong const * in_sync  = fd_mcache_seq_laddr_const( in_mcache );
+  ulong         in_seq   = fd_mcache_seq_query( in_sync );
+
+  fd_frag_meta_t const * in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+
+  /* Note (chunks are referenced relative to the containing workspace
+     currently and the producer is expected to put its dcache in the
+     same workspace as its mcache).  (FIXME: VALIDATE THIS?) */
+  fd_wksp_t * in_wksp = fd_wksp_containing( in_mcache );
+  if( FD_UNLIKELY( !in_wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
+
+  FD_LOG_INFO(( "joining %s.poh.in_fseq", cfg_path ));
+  ulong * in_fseq = fd_fseq_join( fd_wksp_pod_map( poh_pod, "in_fseq" ) );
+  if( FD_UNLIKELY( !in_fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+  /* Hook up to this poh's flow control diagnostics (will be stored in
+     the poh's in_fseq) */
+  ulong * in_fseq_diag = (ulong *)fd_fseq_app_laddr( in_fseq );
+  if( FD_UNLIKELY( !in_fseq_diag ) ) FD_LOG_ERR(( "fd_fseq_app_laddr failed" ));
+  FD_COMPILER_MFENCE();
+  in_fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ] = 0UL;
+  FD_COMPILER_MFENCE();
+  ulong accum_pub_cnt   = 0UL;
+  ulong accum_pub_sz    = 0UL;
+  ulong accum_filt_cnt  = 0UL;
+  ulong accum_filt_sz   = 0UL;
+  ulong accum_ovrnp_cnt = 0UL;
+  ulong accum_ovrnr_cnt = 0UL;
+  ulong accum_hash_cnt  = 0UL;
+  ulong accum_tick_cnt  = 0UL;
+  ulong accum_mixin_cnt = 0UL;
+  long  accum_mixin_lat = 0L;  /* In ticks */
+
+  /* Setup local objects used by this tile */
+
+  long lazy = fd_pod_query_long( poh_pod, "lazy", 0L );
+  FD_LOG_INFO(( "configuring flow control (%s.poh.lazy %li)", cfg_path, lazy ));
+  if( lazy<=0L ) lazy = fd_tempo_lazy_default( in_depth );
+  FD_LOG_INFO(( "using lazy %li ns", lazy ));
+  ulong async_min = fd_tempo_async_min( lazy, 1UL /*event_cnt*/, (float)fd_tempo_tick_per_ns( NULL ) );
+  if( FD_UNLIKELY( !async_min ) ) FD_LOG_ERR(( "bad lazy" ));
+
+  double ns_per_tick = 1. / fd_tempo_tick_per_ns( NULL );
+
+  uint seed = fd_pod_query_uint( poh_pod, "seed", (uint)fd_tile_id() ); /* use app tile_id as default */
+  FD_LOG_INFO(( "creating rng (%s.poh.seed %u)", cfg_path, seed ));
+  fd_rng_t _rng[ 1 ];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+  if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_join failed" ));
+
+  ulong hashcnt_per_tick = fd_pod_query_ulong( poh_pod, "hashcnt_per_tick", 12500UL );
+  ulong hash_batch       = fd_pod_query_ulong( poh_pod, "hash_batch",       64UL    );
+  FD_LOG_INFO(( "configuring hashchain (%s.poh.hashcnt_per_tick %lu, %s.poh.hash_batch %lu)",
+                cfg_path, hashcnt_per_tick, cfg_path, hash_batch ));
+  if( FD_UNLIKELY( hashcnt_per_tick<2UL ) ) FD_LOG_ERR(( "bad hashcnt_per_tick" )); /* A tick can't be a mixin */
+  if( FD_UNLIKELY( !hash_batch          ) ) FD_LOG_ERR(( "bad hash_batch" ));
+
+  char const * start_hash  = fd_pod_query_cstr ( poh_pod, "start_hash",  NULL );
+  ulong        tick_height = fd_pod_query_ulong( poh_pod, "tick_height", 0UL  );
+  FD_LOG_INFO(( "configuring hashchain start (%s.poh.start_hash %s, %s.poh.tick_height %lu)",
+                cfg_path, start_hash ? start_hash : "(null)", cfg_path, tick_height ));
+  if( FD_UNLIKELY( !start_hash ) ) FD_LOG_ERR(( "%s.poh.start_hash not found", cfg_path ));
+
+  /* The hashchain.  It continues from start_hash (the hash of the last
+     tick of the parent slot) at tick_height ticks.  tick_hashcnt is the
+     number of hashes done so far in the current tick and entry_hashcnt
+     is the number of hashes done since the last published record.
+     tick_cnt is the current tick height. */
+
+  fd_poh_state_t poh[1];
+  if( FD_UNLIKELY( !fd_base58_decode_32( start_hash, poh->state ) ) ) FD_LOG_ERR(( "bad start_hash" ));
+  ulong tick_hashcnt  = 0UL;
+  ulong entry_hashcnt = 0UL;
+  ulong tick_cnt      = tick_height;
+
+  /* Frags are copied out of the dcache speculatively into a local
+     scratch buffer and only mixed in after we've verified we weren't
+     overrun while copying. */
+
+  uchar mixin[ FD_SHA256_HASH_SZ ];
+
+  /* Publishes the current PoH state as a record of entry_hashcnt hashes
+     (the last being a mixin of the local mixin if _has_mixin).  Output
+     consumers are not flow controlled (the hashchain can't wait on
+     them) so they should keep up or detect overruns. */
+
+# define PUBLISH( _has_mixin, _tsorig ) do {                                                          \
+    fd_poh_entry_t * _rec = (fd_poh_entry_t *)fd_chunk_to_laddr( wksp, chunk );                   \
+    _rec->hashcnt   = entry_hashcnt;                                                              \
+    _rec->has_mixin = (_has_mixin);                                                               \
+    if( (_has_mixin) ) fd_memcpy( _rec->mixin, mixin, FD_SHA256_HASH_SZ );                        \
+    else               fd_memset( _rec->mixin, 0,     FD_SHA256_HASH_SZ );                        \
+    fd_memcpy( _rec->hash, poh->state, FD_SHA256_HASH_SZ );                                       \
+    ulong _ctl   = fd_frag_meta_ctl( 0UL /*orig*/, 1 /*som*/, 1 /*eom*/, 0 /*err*/ );             \
+    ulong _tspub = fd_frag_meta_ts_comp( fd_tickcount() );                                        \
+    fd_mcache_publish( mcache, depth, seq, tick_cnt /*sig*/, chunk, FD_FRANK_POH_MTU, _ctl, (_tsorig), _tspub ); \
+    chunk         = fd_dcache_compact_next( chunk, FD_FRANK_POH_MTU, chunk0, wmark );             \
+    seq           = fd_seq_inc( seq, 1UL );                                                       \
+    entry_hashcnt = 0UL;                                                                          \
+  } while(0)
+
+  /* Does the last hash of the current tick and publishes the tick */
+
+# define TICK() do {                                                                              \
+    fd_poh_append( poh, 1UL );                                                                    \
+    entry_hashcnt++;                                                                              \
+    ulong _ts = fd_frag_meta_ts_comp( fd_tickcount() );                                           \
+    PUBLISH( 0, _ts );                                                                         \
+    accum_hash_cnt++;                                                                             \
+    accum_tick_cnt++;                                                                             \
+    tick_cnt++;                                                                                   \
+    tick_hashcnt = 0UL;                                                                           \
+  } while(0)
+
+  /* Start hashing */
+
+  FD_LOG_INFO(( "poh run" ));
+
+  long now  = fd_tickcount();
+  long then = now;            /* Do housekeeping on first iteration of run loop */
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
+  for(;;) {
+
+    /* Do housekeeping at a low rate in the background */
+
+    if( FD_UNLIKELY( (now-then)>=0L ) ) {
+
+      /* Send synchronization info */
+      fd_mcache_seq_update( sync, seq );
+
+      /* Send flow control credits */
+      fd_fctl_rx_cr_return( in_fseq, in_seq );
+
+      /* Send diagnostic info */
+      fd_cnc_heartbeat( cnc, now );
+      FD_COMPILER_MFENCE();
+      in_fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ] += accum_pub_cnt;
+      in_fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ] += accum_pub_sz;
+      in_fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ] += accum_filt_cnt;
+      in_fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ] += accum_filt_sz;
+      in_fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ] += accum_ovrnp_cnt;
+      in_fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ] += accum_ovrnr_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_HASH_CNT     ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_POH_HASH_CNT     ] ) + accum_hash_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_TICK_CNT     ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_POH_TICK_CNT     ] ) + accum_tick_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_CNT    ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_CNT    ] ) + accum_mixin_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_LAT_NS ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_POH_MIXIN_LAT_NS ] )
+                                                                     + (ulong)(0.5 + ns_per_tick*(double)accum_mixin_lat);
+      FD_COMPILER_MFENCE();
+      accum_pub_cnt   = 0UL;
+      accum_pub_sz    = 0UL;
+      accum_filt_cnt  = 0UL;
+      accum_filt_sz   = 0UL;
+      accum_ovrnp_cnt = 0UL;
+      accum_ovrnr_cnt = 0UL;
+      accum_hash_cnt  = 0UL;
+      accum_tick_cnt  = 0UL;
+      accum_mixin_cnt = 0UL;
+      accum_mixin_lat = 0L;
+
+      /* Receive command-and-control signals */
+      ulong s = fd_cnc_signal_query( cnc );
+      if( FD_UNLIKELY( s!=FD_CNC_SIGNAL_RUN ) ) {
+        if( FD_UNLIKELY( s!=FD_CNC_SIGNAL_HALT ) ) FD_LOG_ERR(( "Unexpected signal" ));
+        break;
+      }
+
+      /* Reload housekeeping timer */
+      then = now + (long)fd_tempo_async_reload( rng, async_min );
+    }
+
+    /* See if there is a microblock hash to mix in.  If not, advance the
+       hashchain by a small batch of hashes (stopping at the end of the
+       tick) and check again.  The chain never waits on the input and
+       mixins are never delayed by more than a batch. */
+
+    ulong seq_found = fd_frag_meta_seq_query( in_mline );
+    long  diff      = fd_seq_diff( seq_found, in_seq );
+    if( FD_UNLIKELY( diff ) ) { /* caught up or overrun, optimize for new frag case */
+      if( FD_LIKELY( diff<0L ) ) { /* caught up */
+        ulong n = fd_ulong_min( hash_batch, hashcnt_per_tick - 1UL - tick_hashcnt );
+        fd_poh_append( poh, n );
+        tick_hashcnt   += n;
+        entry_hashcnt  += n;
+        accum_hash_cnt += n;
+        if( FD_UNLIKELY( tick_hashcnt==hashcnt_per_tick-1UL ) ) TICK();
+        now = fd_tickcount();
+        continue;
+      }
+      /* overrun by the producer ... recover */
+      accum_ovrnp_cnt++;
+      in_seq = seq_found;
+      /* can keep processing from the new seq */
+    }
+
+    now = fd_tickcount();
+
+    /* At this point, we have started receiving frag in_seq with details
+       in in_mline at time now.  Speculatively copy out the mixin. */
+
+    ulong sz       = (ulong)in_mline->sz;
+    ulong tsorig   = (ulong)in_mline->tsorig;
+    ulong tspub    = (ulong)in_mline->tspub;
+    int   too_small = sz<FD_SHA256_HASH_SZ;
+    if( FD_LIKELY( !too_small ) ) fd_memcpy( mixin, fd_chunk_to_laddr_const( in_wksp, in_mline->chunk ), FD_SHA256_HASH_SZ );
+
+    /* Check that we weren't overrun while processing */
+    seq_found = fd_frag_meta_seq_query( in_mline );
+    if( FD_UNLIKELY( fd_seq_ne( seq_found, in_seq ) ) ) {
+      accum_ovrnr_cnt++;
+      in_seq = seq_found;
+      continue;
+    }
+
+    if( FD_UNLIKELY( too_small ) ) {
+      accum_filt_cnt++;
+      accum_filt_sz += sz;
+    } else {
+
+      /* The last hash of a tick can't be a mixin so tick first if the
+         mixin would land on it */
+      if( FD_UNLIKELY( tick_hashcnt==hashcnt_per_tick-1UL ) ) TICK();
+
+      fd_poh_mixin( poh, mixin );
+      tick_hashcnt++;
+      entry_hashcnt++;
+      PUBLISH( 1, (uint)tsorig );
+
+      accum_pub_cnt++;
+      accum_pub_sz    += sz;
+      accum_hash_cnt++;
+      accum_mixin_cnt++;
+      accum_mixin_lat += fd_long_max( fd_tickcount() - fd_frag_meta_ts_decomp( tspub, now ), 0L );
+
+      if( FD_UNLIKELY( tick_hashcnt==hashcnt_per_tick-1UL ) ) TICK();
+    }
+
+    /* Wind up for the next iteration */
+    in_seq   = fd_seq_inc( in_seq, 1UL );
+    in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+  }
+
+# undef TICK
+# undef PUBLISH
+
+  /* Clean up */
+
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
+  FD_LOG_INFO(( "poh fini" ));
+  fd_rng_delete    ( fd_rng_leave   ( rng       ) );
+  fd_wksp_pod_unmap( fd_fseq_leave  ( in_fseq   ) );
+  fd_wksp_pod_unmap( fd_mcache_leave( in_mcache ) );
+  fd_wksp_pod_unmap( fd_dcache_leave( dcache    ) );
+  fd_wksp_pod_unmap( fd_mcache_leave( mcache    ) );
+  fd_wksp_pod_unmap( fd_cnc_leave   ( cnc       ) );
+  fd_wksp_pod_detach( pod );
+  return 0;
+}
+
+#else
+
+int
+fd_frank_poh_task( int     argc,
+                   char ** argv ) {
+  (void)argc; (void)argv;
+  FD_LOG_WARNING(( "unsupported for this build target" ));
+  return 1;
+}
+
+#endif
@@ -2,6 +2,30 @@
 
 #if FD_HAS_FRANK
 
+/* A fd_frank_verify_out_t is the verify tile's local state for
+   publishing to a downstream consumer.  If the dedup is sharded, the
+   verify has one out per dedup shard (indexed in the order of the
+   dedup.shard pod) and steers each transaction to the out of the shard
+   responsible for deduping it.  Otherwise, the verify has a single out
+   consumed by the dedup. */
+
+struct fd_frank_verify_out {
+  fd_frag_meta_t * mcache;
+  ulong            depth;
+  ulong *          sync;
+  ulong            seq;     /* Next frag to publish */
+  uchar *          dcache;
+  fd_wksp_t *      wksp;
+  ulong            chunk0;
+  ulong            wmark;
+  ulong            chunk;
+  ulong *          fseq;
+  fd_fctl_t *      fctl;
+  ulong            cr_avail;
+};
+
+typedef struct fd_frank_verify_out fd_frank_verify_out_t;
+
 int
 fd_frank_verify_task( int     argc,
                       char ** argv ) {
@@ -39,36 +63,106 @@ fd_frank_verify_task( int     argc,
   int in_backp = 1;
 
   FD_COMPILER_MFENCE();
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP    ] ) = 1UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT   ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_CNT ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP     ] ) = 1UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT    ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ   ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ   ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PKC_HIT_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PKC_MISS_CNT ] ) = 0UL;
   FD_COMPILER_MFENCE();
 
-  FD_LOG_INFO(( "joining %s.verify.%s.mcache", cfg_path, verify_name ));
-  fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( verify_pod, "mcache" ) );
-  if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
-  ulong   depth = fd_mcache_depth( mcache );
-  ulong * sync  = fd_mcache_seq_laddr( mcache );
-  ulong   seq   = fd_mcache_seq_query( sync );
-
-  FD_LOG_INFO(( "joining %s.verify.%s.dcache", cfg_path, verify_name ));
-  uchar * dcache = fd_dcache_join( fd_wksp_pod_map( verify_pod, "dcache" ) );
-  if( FD_UNLIKELY( !dcache ) ) FD_LOG_ERR(( "fd_dcache_join failed" ));
-  fd_wksp_t * wksp = fd_wksp_containing( dcache ); /* chunks are referenced relative to the containing workspace */
-  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
-  ulong   chunk0 = fd_dcache_compact_chunk0( wksp, dcache );
-  ulong   wmark  = fd_dcache_compact_wmark ( wksp, dcache, 1542UL ); /* FIXME: MTU? SAFETY CHECK THE FOOTPRINT? */
-  ulong   chunk  = chunk0;
-
-  FD_LOG_INFO(( "joining %s.verify.%s.fseq", cfg_path, verify_name ));
-  ulong * fseq = fd_fseq_join( fd_wksp_pod_map( verify_pod, "fseq" ) );
-  if( FD_UNLIKELY( !fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
-  ulong * fseq_diag = (ulong *)fd_fseq_app_laddr( fseq );
-  if( FD_UNLIKELY( !fseq_diag ) ) FD_LOG_ERR(( "fd_fseq_app_laddr failed" ));
-  FD_VOLATILE( fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ) = 0UL; /* Managed by the fctl */
+  uchar const * shard_pods = fd_pod_query_subpod( cfg_pod, "dedup.shard" );
+  ulong         out_cnt    = fd_ulong_max( fd_pod_cnt_subpod( shard_pods ), 1UL );
+  if( FD_UNLIKELY( out_cnt>FD_DEDUP_TILE_SHARD_MAX ) ) FD_LOG_ERR(( "too many dedup shard" ));
+  FD_LOG_INFO(( "%lu out found", out_cnt ));
+
+  fd_frank_verify_out_t * out = (fd_frank_verify_out_t *)
+    fd_alloca( alignof(fd_frank_verify_out_t), sizeof(fd_frank_verify_out_t)*out_cnt );
+  if( FD_UNLIKELY( !out ) ) FD_LOG_ERR(( "fd_alloca failed" ));
+
+  ulong out_idx = 0UL;
+  for( fd_pod_iter_t iter = fd_pod_iter_init( shard_pods ); ; iter = fd_pod_iter_next( iter ) ) {
+    char const  * out_name = "";
+    uchar const * out_pod  = verify_pod;
+    if( shard_pods ) {
+      if( fd_pod_iter_done( iter ) ) break;
+      fd_pod_info_t info = fd_pod_iter_info( iter );
+      if( FD_UNLIKELY( info.val_type!=FD_POD_VAL_TYPE_SUBPOD ) ) continue;
+      out_name = info.key;
+      out_pod  = fd_pod_query_subpod( fd_pod_query_subpod( verify_pod, "shard" ), out_name );
+      if( FD_UNLIKELY( !out_pod ) ) FD_LOG_ERR(( "%s.verify.%s.shard.%s path not found", cfg_path, verify_name, out_name ));
+    }
+    char const * out_sep = shard_pods ? ".shard." : "";
+    fd_frank_verify_out_t * o = out + out_idx;
+
+    FD_LOG_INFO(( "joining %s.verify.%s%s%s.mcache", cfg_path, verify_name, out_sep, out_name ));
+    o->mcache = fd_mcache_join( fd_wksp_pod_map( out_pod, "mcache" ) );
+    if( FD_UNLIKELY( !o->mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+    o->depth = fd_mcache_depth( o->mcache );
+    o->sync  = fd_mcache_seq_laddr( o->mcache );
+    o->seq   = fd_mcache_seq_query( o->sync );
+
+    FD_LOG_INFO(( "joining %s.verify.%s%s%s.dcache", cfg_path, verify_name, out_sep, out_name ));
+    o->dcache = fd_dcache_join( fd_wksp_pod_map( out_pod, "dcache" ) );
+    if( FD_UNLIKELY( !o->dcache ) ) FD_LOG_ERR(( "fd_dcache_join failed" ));
+    o->wksp = fd_wksp_containing( o->dcache ); /* chunks are referenced relative to the containing workspace */
+    if( FD_UNLIKELY( !o->wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
+    o->chunk0 = fd_dcache_compact_chunk0( o->wksp, o->dcache );
+    o->wmark  = fd_dcache_compact_wmark ( o->wksp, o->dcache, FD_FRANK_VERIFY_MTU ); /* FIXME: SAFETY CHECK THE FOOTPRINT? */
+    o->chunk  = o->chunk0;
+
+    FD_LOG_INFO(( "joining %s.verify.%s%s%s.fseq", cfg_path, verify_name, out_sep, out_name ));
+    o->fseq = fd_fseq_join( fd_wksp_pod_map( out_pod, "fseq" ) );
+    if( FD_UNLIKELY( !o->fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+    ulong * fseq_diag = (ulong *)fd_fseq_app_laddr( o->fseq );
+    if( FD_UNLIKELY( !fseq_diag ) ) FD_LOG_ERR(( "fd_fseq_app_laddr failed" ));
+    FD_VOLATILE( fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ) = 0UL; /* Managed by the fctl */
+
+    out_idx++;
+    if( !shard_pods ) break;
+  }
+  if( FD_UNLIKELY( out_idx!=out_cnt ) ) FD_LOG_ERR(( "unexpected %s.dedup.shard layout", cfg_path ));
+
+  fd_wksp_t * wksp = out[0].wksp; /* For local objects that should live in the workspace of this tile's outs */
+
+  FD_LOG_INFO(( "joining %s.verify.%s.in_mcache", cfg_path, verify_name ));
+  fd_frag_meta_t const * in_mcache = fd_mcache_join( fd_wksp_pod_map( verify_pod, "in_mcache" ) );
+  if( FD_UNLIKELY( !in_mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
+  ulong         in_depth = fd_mcache_depth( in_mcache );
+  ulong const * in_sync  = fd_mcache_seq_laddr_const( in_mcache );
+  ulong         in_seq   = fd_mcache_seq_query( in_sync );
+
+  fd_frag_meta_t const * in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+
+  /* Note (chunks are referenced relative to the containing workspace
+     currently and the ingress is expected to put its dcache in the
+     same workspace as its mcache).  (FIXME: VALIDATE THIS?) */
+  fd_wksp_t * in_wksp = fd_wksp_containing( in_mcache );
+  if( FD_UNLIKELY( !in_wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
+
+  FD_LOG_INFO(( "joining %s.verify.%s.in_fseq", cfg_path, verify_name ));
+  ulong * in_fseq = fd_fseq_join( fd_wksp_pod_map( verify_pod, "in_fseq" ) );
+  if( FD_UNLIKELY( !in_fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
+  /* Hook up to this verify's flow control diagnostics (will be stored
+     in the verify's in_fseq) */
+  ulong * in_fseq_diag = (ulong *)fd_fseq_app_laddr( in_fseq );
+  if( FD_UNLIKELY( !in_fseq_diag ) ) FD_LOG_ERR(( "fd_fseq_app_laddr failed" ));
+  FD_COMPILER_MFENCE();
+  in_fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ] = 0UL;
+  in_fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ] = 0UL;
+  FD_COMPILER_MFENCE();
+  ulong accum_pub_cnt   = 0UL;
+  ulong accum_pub_sz    = 0UL;
+  ulong accum_filt_cnt  = 0UL;
+  ulong accum_filt_sz   = 0UL;
+  ulong accum_ovrnp_cnt = 0UL;
+  ulong accum_ovrnr_cnt = 0UL;
 
   /* Setup local objects used by this tile */
 
@@ -82,18 +176,27 @@ fd_frank_verify_task( int     argc,
   FD_LOG_INFO(( "%s.verify.%s.cr_refill %lu", cfg_path, verify_name, cr_refill ));
   FD_LOG_INFO(( "%s.verify.%s.lazy      %li", cfg_path, verify_name, lazy      ));
 
-  fd_fctl_t * fctl = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( fd_alloca( FD_FCTL_ALIGN,
-                                                                                                 fd_fctl_footprint( 1UL ) ),
-                                                                                      1UL ) ),
-                                                           depth, fseq, &fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ),
-                                       1UL /*cr_burst*/, cr_max, cr_resume, cr_refill );
-  if( FD_UNLIKELY( !fctl ) ) FD_LOG_ERR(( "Unable to create flow control" ));
+  for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) {
+    fd_frank_verify_out_t * o = out + out_idx;
+    ulong * fseq_diag = (ulong *)fd_fseq_app_laddr( o->fseq );
+    o->fctl = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( fd_alloca( FD_FCTL_ALIGN, fd_fctl_footprint( 1UL ) ),
+                                                                               1UL ) ),
+                                                    o->depth, o->fseq, &fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ),
+                                1UL /*cr_burst*/, cr_max, cr_resume, cr_refill );
+    if( FD_UNLIKELY( !o->fctl ) ) FD_LOG_ERR(( "Unable to create flow control" ));
+    o->cr_avail = 0UL;
+  }
   FD_LOG_INFO(( "using cr_burst %lu, cr_max %lu, cr_resume %lu, cr_refill %lu",
-                fd_fctl_cr_burst( fctl ), fd_fctl_cr_max( fctl ), fd_fctl_cr_resume( fctl ), fd_fctl_cr_refill( fctl ) ));
+                fd_fctl_cr_burst( out[0].fctl ), fd_fctl_cr_max( out[0].fctl ), fd_fctl_cr_resume( out[0].fctl ), fd_fctl_cr_refill( out[0].fctl ) ));
+
+  /* cr_avail is the number of frags that can be accepted into the batch
+     such that every one of them has a credit on whichever out it gets
+     published to (i.e. the minimum cr_avail over the outs less the
+     number of frags in the batch). */
 
   ulong cr_avail = 0UL;
 
-  if( lazy<=0L ) lazy = fd_tempo_lazy_default( depth );
+  if( lazy<=0L ) lazy = fd_tempo_lazy_default( out[0].depth );
   FD_LOG_INFO(( "using lazy %li ns", lazy ));
   ulong async_min = fd_tempo_async_min( lazy, 1UL /*event_cnt*/, (float)fd_tempo_tick_per_ns( NULL ) );
   if( FD_UNLIKELY( !async_min ) ) FD_LOG_ERR(( "bad lazy" ));
@@ -124,6 +227,59 @@ fd_frank_verify_task( int     argc,
 
   ulong accum_sv_filt_cnt = 0UL; ulong accum_sv_filt_sz = 0UL;
 
+  /* The decompressed public keys of recent signers are cached (in the
+     workspace containing this tile's dcache) such that hot signers (fee
+     payers, vote authorities, etc) don't need to be decompressed for
+     every signature. */
+
+  ulong pkc_key_max = fd_pod_query_ulong( verify_pod, "pubkey_cache", fd_pod_query_ulong( cfg_pod, "verify.pubkey_cache", 4096UL ) );
+  FD_LOG_INFO(( "configuring pubkey cache (%s.verify.%s.pubkey_cache %lu)", cfg_path, verify_name, pkc_key_max ));
+  fd_ed25519_pubkey_cache_t * pkc = NULL;
+  if( FD_LIKELY( pkc_key_max ) ) {
+    ulong pkc_footprint = fd_ed25519_pubkey_cache_footprint( pkc_key_max );
+    if( FD_UNLIKELY( !pkc_footprint ) ) FD_LOG_ERR(( "bad pubkey_cache" ));
+    void * pkc_mem = fd_wksp_alloc_laddr( wksp, fd_ed25519_pubkey_cache_align(), pkc_footprint, 1UL );
+    if( FD_UNLIKELY( !pkc_mem ) ) FD_LOG_ERR(( "fd_wksp_alloc_laddr failed" ));
+    pkc = fd_ed25519_pubkey_cache_join( fd_ed25519_pubkey_cache_new( pkc_mem, pkc_key_max, fd_rng_ulong( rng ) ) );
+    if( FD_UNLIKELY( !pkc ) ) FD_LOG_ERR(( "fd_ed25519_pubkey_cache_join failed" ));
+  }
+
+  /* Frags are accumulated into a batch and then parsed, verified and
+     published together such that the per frag overheads (flow control
+     credit checks, in overrun checks, cache misses on the signature
+     verification code and tables, etc) are amortized over the batch.
+     Each frag in the batch is copied into a local scratch buffer when
+     it is received such that the verification is not exposed to being
+     overrun by the ingress.  The verification inputs for every
+     signature in the batch are gathered into flat arrays (a parsed
+     transaction of at most FD_FRANK_VERIFY_MTU bytes has at most
+     FD_FRANK_VERIFY_MTU/96 signatures as every signature has a 64 byte
+     signature and a 32 byte public key in the payload). */
+
+  ulong batch_max = fd_pod_query_ulong( verify_pod, "batch", fd_pod_query_ulong( cfg_pod, "verify.batch", 16UL ) );
+  FD_LOG_INFO(( "configuring batching (%s.verify.%s.batch %lu)", cfg_path, verify_name, batch_max ));
+  if( FD_UNLIKELY( !((1UL<=batch_max) & (batch_max<=FD_FRANK_VERIFY_BATCH_MAX)) ) )
+    FD_LOG_ERR(( "batch should be in [1,%lu]", FD_FRANK_VERIFY_BATCH_MAX ));
+
+# define FRAG_STRIDE fd_ulong_align_up( FD_FRANK_VERIFY_MTU, 128UL )
+# define SIG_MAX     (FD_FRANK_VERIFY_MTU / (FD_TXN_SIGNATURE_SZ+FD_TXN_PUBKEY_SZ))
+
+  uchar *       batch_payload = (uchar *)      fd_alloca( 128UL,           batch_max*FRAG_STRIDE            );
+  ulong *       batch_sz      = (ulong *)      fd_alloca( alignof(ulong),  batch_max*sizeof(ulong)          );
+  ulong *       batch_tsorig  = (ulong *)      fd_alloca( alignof(ulong),  batch_max*sizeof(ulong)          );
+  ulong *       batch_sig_cnt = (ulong *)      fd_alloca( alignof(ulong),  batch_max*sizeof(ulong)          );
+  ulong *       batch_tag     = (ulong *)      fd_alloca( alignof(ulong),  batch_max*sizeof(ulong)          );
+  int *         batch_err     = (int *)        fd_alloca( alignof(int),    batch_max*sizeof(int)            );
+  void const ** sv_msg        = (void const **)fd_alloca( alignof(void *), batch_max*SIG_MAX*sizeof(void *) );
+  ulong *       sv_sz         = (ulong *)      fd_alloca( alignof(ulong),  batch_max*SIG_MAX*sizeof(ulong)  );
+  void const ** sv_sig        = (void const **)fd_alloca( alignof(void *), batch_max*SIG_MAX*sizeof(void *) );
+  void const ** sv_pub        = (void const **)fd_alloca( alignof(void *), batch_max*SIG_MAX*sizeof(void *) );
+  int *         sv_err        = (int *)        fd_alloca( alignof(int),    batch_max*SIG_MAX*sizeof(int)    );
+  ulong batch_cnt = 0UL;
+
+  uchar txn_mem[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+  fd_txn_t * txn = (fd_txn_t *)txn_mem;
+
   /* Start verifying */
 
   FD_LOG_INFO(( "verify.%s run", verify_name ));
@@ -138,11 +294,16 @@ fd_frank_verify_task( int     argc,
     if( FD_UNLIKELY( (now-then)>=0L ) ) {
 
       /* Send synchronization info */
-      fd_mcache_seq_update( sync, seq );
+      for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) fd_mcache_seq_update( out[ out_idx ].sync, out[ out_idx ].seq );
       FD_COMPILER_MFENCE();
       FD_VOLATILE( *_tcache_sync ) = tcache_oldest;
       FD_COMPILER_MFENCE();
 
+      /* Send flow control credits (frags in the current batch are not
+         done with yet but they have already been copied out of the in
+         dcache) */
+      fd_fctl_rx_cr_return( in_fseq, in_seq );
+
       /* Send diagnostic info */
       fd_cnc_heartbeat( cnc, now );
       FD_COMPILER_MFENCE();
@@ -150,11 +311,27 @@ fd_frank_verify_task( int     argc,
       FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) + accum_ha_filt_sz;
       FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) + accum_sv_filt_cnt;
       FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) + accum_sv_filt_sz;
+      if( FD_LIKELY( pkc ) ) {
+        FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PKC_HIT_CNT  ] ) = fd_ed25519_pubkey_cache_hit_cnt ( pkc );
+        FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PKC_MISS_CNT ] ) = fd_ed25519_pubkey_cache_miss_cnt( pkc );
+      }
+      in_fseq_diag[ FD_FSEQ_DIAG_PUB_CNT   ] += accum_pub_cnt;
+      in_fseq_diag[ FD_FSEQ_DIAG_PUB_SZ    ] += accum_pub_sz;
+      in_fseq_diag[ FD_FSEQ_DIAG_FILT_CNT  ] += accum_filt_cnt;
+      in_fseq_diag[ FD_FSEQ_DIAG_FILT_SZ   ] += accum_filt_sz;
+      in_fseq_diag[ FD_FSEQ_DIAG_OVRNP_CNT ] += accum_ovrnp_cnt;
+      in_fseq_diag[ FD_FSEQ_DIAG_OVRNR_CNT ] += accum_ovrnr_cnt;
       FD_COMPILER_MFENCE();
       accum_ha_filt_cnt = 0UL;
       accum_ha_filt_sz  = 0UL;
       accum_sv_filt_cnt = 0UL;
       accum_sv_filt_sz  = 0UL;
+      accum_pub_cnt     = 0UL;
+      accum_pub_sz      = 0UL;
+      accum_filt_cnt    = 0UL;
+      accum_filt_sz     = 0UL;
+      accum_ovrnp_cnt   = 0UL;
+      accum_ovrnr_cnt   = 0UL;
 
       /* Receive command-and-control signals */
       ulong s = fd_cnc_signal_query( cnc );
@@ -164,7 +341,13 @@ fd_frank_verify_task( int     argc,
       }
 
       /* Receive flow control credits */
-      cr_avail = fd_fctl_tx_cr_update( fctl, cr_avail, seq );
+      ulong cr_min = ULONG_MAX;
+      for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) {
+        fd_frank_verify_out_t * o = out + out_idx;
+        o->cr_avail = fd_fctl_tx_cr_update( o->fctl, o->cr_avail, o->seq );
+        cr_min = fd_ulong_min( cr_min, o->cr_avail );
+      }
+      cr_avail = fd_ulong_if( cr_min>batch_cnt, cr_min-batch_cnt, 0UL ); /* cr_min>=batch_cnt in practice */
       if( FD_UNLIKELY( in_backp ) ) {
         if( FD_LIKELY( cr_avail ) ) {
           FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP ] ) = 0UL;
@@ -176,40 +359,225 @@ fd_frank_verify_task( int     argc,
       then = now + (long)fd_tempo_async_reload( rng, async_min );
     }
 
-    /* Check if we are backpressured */
-    if( FD_UNLIKELY( !cr_avail ) ) {
-      if( FD_UNLIKELY( !in_backp ) ) {
-        FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP  ] ) = 1UL;
-        FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT ] )+1UL;
-        in_backp = 1;
+    /* Check if we are backpressured.  Each frag in the batch has
+       reserved a credit when it was received so we might be out of
+       credits with a batch ready to go. */
+
+    int flush = (batch_cnt==batch_max);
+    if( FD_UNLIKELY( !flush & !cr_avail ) ) {
+      if( FD_LIKELY( batch_cnt ) ) flush = 1;
+      else {
+        if( FD_UNLIKELY( !in_backp ) ) {
+          FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP  ] ) = 1UL;
+          FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT ] )+1UL;
+          in_backp = 1;
+        }
+        FD_SPIN_PAUSE();
+        now = fd_tickcount();
+        continue;
+      }
+    }
+
+    if( FD_LIKELY( !flush ) ) {
+
+      /* See if there are any transactions waiting to be verified */
+      ulong seq_found = fd_frag_meta_seq_query( in_mline );
+      long  diff      = fd_seq_diff( seq_found, in_seq );
+      if( FD_UNLIKELY( diff ) ) { /* caught up or overrun, optimize for expected sequence number ready */
+        if( FD_LIKELY( diff<0L ) ) { /* caught up */
+          if( FD_LIKELY( !batch_cnt ) ) {
+            FD_SPIN_PAUSE();
+            now = fd_tickcount();
+            continue;
+          }
+          flush = 1; /* Nothing more is immediately available so don't sit on a partial batch */
+        } else {
+          /* overrun by ingress ... recover */
+          accum_ovrnp_cnt++;
+          in_seq   = seq_found;
+          in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+          now = fd_tickcount();
+          continue;
+        }
+      }
+    }
+
+    if( FD_LIKELY( !flush ) ) {
+
+      /* At this point, we have started receiving frag in_seq with
+         details in in_mline.  Speculatively copy it into the batch. */
+
+      ulong sz       = (ulong)in_mline->sz;
+      ulong in_chunk = (ulong)in_mline->chunk;
+      ulong tsorig   = (ulong)in_mline->tsorig;
+
+      uchar * payload = batch_payload + batch_cnt*FRAG_STRIDE;
+      int     too_big = sz>FD_FRANK_VERIFY_MTU;
+      if( FD_LIKELY( !too_big ) ) fd_memcpy( payload, fd_chunk_to_laddr_const( in_wksp, in_chunk ), sz );
+
+      /* Check that we weren't overrun while copying */
+      ulong seq_found = fd_frag_meta_seq_query( in_mline );
+      if( FD_UNLIKELY( fd_seq_ne( seq_found, in_seq ) ) ) {
+        accum_ovrnr_cnt++;
+        in_seq   = seq_found;
+        in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+        now = fd_tickcount();
+        continue;
+      }
+
+      in_seq   = fd_seq_inc( in_seq, 1UL );
+      in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+
+      if( FD_UNLIKELY( too_big ) ) { /* Can't be a valid transaction */
+        accum_sv_filt_cnt++;
+        accum_sv_filt_sz += sz;
+        accum_filt_cnt++;
+        accum_filt_sz += sz;
+        now = fd_tickcount();
+        continue;
       }
-      FD_SPIN_PAUSE();
+
+      batch_sz    [ batch_cnt ] = sz;
+      batch_tsorig[ batch_cnt ] = tsorig;
+      batch_cnt++;
+      cr_avail--; /* Reserve a credit for publishing this frag */
       now = fd_tickcount();
       continue;
     }
 
-    /* Placeholder for sig verify */
-    (void)_tcache_map;
-    (void)_tcache_ring;
-    (void)tcache_depth;
-    (void)tcache_map_cnt;
-    (void)chunk;
-    (void)wmark;
-    now = fd_tickcount();
+    /* At this point, we have a batch of frags to process.  Parse the
+       batch and gather the signatures to verify. */
+
+    ulong sv_cnt = 0UL;
+    for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+      uchar const * payload = batch_payload + batch_idx*FRAG_STRIDE;
+      ulong         sz      = batch_sz[ batch_idx ];
+
+      if( FD_UNLIKELY( !fd_txn_parse( payload, sz, txn, NULL ) ) ) {
+        batch_sig_cnt[ batch_idx ] = 0UL;
+        batch_err    [ batch_idx ] = 1;
+        continue;
+      }
+
+      /* The message covered by the signatures spans from message_off to
+         the end of the payload and the signer public keys are the first
+         signature_cnt account addresses. */
+
+      ulong         sig_cnt = (ulong)txn->signature_cnt;
+      uchar const * sig     = payload + txn->signature_off;
+      uchar const * pub     = payload + txn->acct_addr_off;
+      uchar const * msg     = payload + txn->message_off;
+      ulong         msg_sz  = sz - (ulong)txn->message_off;
+      for( ulong sig_idx=0UL; sig_idx<sig_cnt; sig_idx++ ) {
+        sv_msg[ sv_cnt ] = msg;
+        sv_sz [ sv_cnt ] = msg_sz;
+        sv_sig[ sv_cnt ] = sig + sig_idx*FD_TXN_SIGNATURE_SZ;
+        sv_pub[ sv_cnt ] = pub + sig_idx*FD_TXN_PUBKEY_SZ;
+        sv_cnt++;
+      }
+      batch_sig_cnt[ batch_idx ] = sig_cnt;
+      batch_tag    [ batch_idx ] = fd_ulong_load_8( sig );
+      batch_err    [ batch_idx ] = 0;
+    }
+
+    /* Verify all the signatures in the batch, several at a time in SIMD
+       lanes.  (fd_ed25519_verify_batch's batch equation is not used as
+       the per signature subgroup checks it needs to match
+       fd_ed25519_verify make it slower than this.)  A frag fails if any
+       of its signatures fail. */
+
+    fd_ed25519_verify_multi( sv_msg, sv_sz, sv_sig, sv_pub, sv_err, sv_cnt, sha, pkc );
+
+    ulong sv_idx = 0UL;
+    for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+      int   err     = batch_err    [ batch_idx ];
+      ulong sig_cnt = batch_sig_cnt[ batch_idx ];
+      for( ulong sig_idx=0UL; sig_idx<sig_cnt; sig_idx++ ) err |= !!sv_err[ sv_idx++ ];
+      batch_err[ batch_idx ] = err;
+    }
+
+    /* Publish the survivors */
+
+    for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+      uchar const * payload = batch_payload + batch_idx*FRAG_STRIDE;
+      ulong         sz      = batch_sz[ batch_idx ];
 
+      if( FD_UNLIKELY( batch_err[ batch_idx ] ) ) {
+        accum_sv_filt_cnt++;
+        accum_sv_filt_sz += sz;
+        accum_filt_cnt++;
+        accum_filt_sz += sz;
+        continue;
+      }
+
+      /* The signature is already effectively a cryptographically secure
+         hash of the public key, private key and message.  So we use the
+         leading 64-bits of the first signature as the frag's sig for
+         dedup purposes (both the ha dedup here and the dedup tile
+         downstream).  We do the ha dedup after verification such that
+         a forged transaction cannot be used to shadow a legitimate one. */
+
+      ulong meta_sig = batch_tag[ batch_idx ];
+      meta_sig = fd_ulong_if( fd_tcache_tag_is_null( meta_sig ), 1UL, meta_sig ); /* Never insert a null tag */
+
+      int ha_dup;
+      FD_TCACHE_INSERT( ha_dup, tcache_oldest, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, meta_sig );
+      if( FD_UNLIKELY( ha_dup ) ) { /* optimize for the non dup case */
+        accum_ha_filt_cnt++;
+        accum_ha_filt_sz += sz;
+        accum_filt_cnt++;
+        accum_filt_sz += sz;
+        continue;
+      }
+
+      /* Steer the frag to the out of the dedup shard responsible for it
+         (this is the only out if the dedup is not sharded) */
+
+      fd_frank_verify_out_t * o = out + fd_dedup_tile_shard( meta_sig, out_cnt );
+
+      fd_memcpy( fd_chunk_to_laddr( o->wksp, o->chunk ), payload, sz );
+
+      ulong ctl    = fd_frag_meta_ctl( 0UL /*orig*/, 1 /*som*/, 1 /*eom*/, 0 /*err*/ );
+      ulong tsorig = batch_tsorig[ batch_idx ];
+      ulong tspub  = fd_frag_meta_ts_comp( fd_tickcount() );
+      fd_mcache_publish( o->mcache, o->depth, o->seq, meta_sig, o->chunk, sz, ctl, tsorig, tspub );
+
+      o->chunk = fd_dcache_compact_next( o->chunk, sz, o->chunk0, o->wmark );
+      o->seq   = fd_seq_inc( o->seq, 1UL );
+      o->cr_avail--;
+      accum_pub_cnt++;
+      accum_pub_sz += sz;
+    }
+
+    /* Wind up for the next batch (the credits reserved by the batch
+       have been either consumed by publishing or returned) */
+
+    batch_cnt = 0UL;
+    cr_avail  = ULONG_MAX;
+    for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) cr_avail = fd_ulong_min( cr_avail, out[ out_idx ].cr_avail );
+    now = fd_tickcount();
   }
 
+# undef SIG_MAX
+# undef FRAG_STRIDE
+
   /* Clean up */
 
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
   FD_LOG_INFO(( "verify.%s fini", verify_name ));
+  if( FD_LIKELY( pkc ) ) fd_wksp_free_laddr( fd_ed25519_pubkey_cache_delete( fd_ed25519_pubkey_cache_leave( pkc ) ) );
   fd_sha512_delete ( fd_sha512_leave( sha    ) );
   fd_tcache_delete ( fd_tcache_leave( tcache ) );
   fd_rng_delete    ( fd_rng_leave   ( rng    ) );
-  fd_fctl_delete   ( fd_fctl_leave  ( fctl   ) );
-  fd_wksp_pod_unmap( fd_fseq_leave  ( fseq   ) );
-  fd_wksp_pod_unmap( fd_dcache_leave( dcache ) );
-  fd_wksp_pod_unmap( fd_mcache_leave( mcache ) );
+  fd_wksp_pod_unmap( fd_fseq_leave  ( in_fseq   ) );
+  fd_wksp_pod_unmap( fd_mcache_leave( in_mcache ) );
+  for( ulong out_idx=out_cnt; out_idx; out_idx-- ) {
+    fd_frank_verify_out_t * o = out + out_idx - 1UL;
+    fd_fctl_delete   ( fd_fctl_leave  ( o->fctl   ) );
+    fd_wksp_pod_unmap( fd_fseq_leave  ( o->fseq   ) );
+    fd_wksp_pod_unmap( fd_dcache_leave( o->dcache ) );
+    fd_wksp_pod_unmap( fd_mcache_leave( o->mcache ) );
+  }
   fd_wksp_pod_unmap( fd_cnc_leave   ( cnc    ) );
   fd_wksp_pod_detach( pod );
   return 0;
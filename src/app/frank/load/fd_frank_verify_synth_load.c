@@ -1,16 +1,41 @@
 #include "../fd_frank.h"
 
 #if FD_HAS_FRANK
-#include <math.h>
+
+#include "../../../ballet/pack/fd_compute_budget_program.h"
+
+/* The synthetic load is a stream of signed legacy transactions in the
+   canonical wire encoding, serialized with fd_txn_build directly into
+   the ingress dcache of a verify tile.  Each transaction is a transfer
+   from a fee payer (drawn from a small set of signers such that the
+   verify's pubkey cache sees realistic hot signers and the pack sees
+   realistic write conflicts) to a random destination, with compute
+   budget instructions setting a random compute unit limit and price
+   (such that the pack has something to prioritize).  The accounts are:
+
+     0: fee payer           (signed,   writable)
+     1: destination         (unsigned, writable)
+     2: system program      (unsigned, readonly)
+     3: compute budget prog (unsigned, readonly) */
+
+#define LOAD_ACCT_CNT        (4UL)
+#define LOAD_DUP_MAX         (64UL)          /* Dups are drawn uniformly from this many recent transactions */
+#define LOAD_SIGNER_MAX      (1024UL)        /* Signer key pairs live on the tile's stack (64 bytes each) */
+#define LOAD_CU_LIMIT_MIN    (1000UL)
+#define LOAD_CU_LIMIT_MAX    (200000UL)
+#define LOAD_CU_PRICE_MAX    (1000000UL)     /* In micro-lamports per compute unit */
+
+static uchar const fd_frank_load_system_program_id[ FD_TXN_ACCT_ADDR_SZ ] = { 0 };
 
 int
-fd_frank_verify_task( int     argc,
-                      char ** argv ) {
+fd_frank_verify_synth_load_task( int     argc,
+                                 char ** argv ) {
   (void)argc;
-  fd_log_thread_set( argv[0] );
   char const * verify_name = argv[0];
-  FD_LOG_INFO(( "verify.%s init", verify_name ));
-  
+  char thread_name[ FD_LOG_NAME_MAX ];
+  fd_log_thread_set( fd_cstr_printf( thread_name, FD_LOG_NAME_MAX, NULL, "%s.load", verify_name ) );
+  FD_LOG_INFO(( "verify.%s.load init", verify_name ));
+
   /* Parse "command line" arguments */
 
   char const * pod_gaddr = argv[1];
@@ -29,10 +54,13 @@ fd_frank_verify_task( int     argc,
   uchar const * verify_pod = fd_pod_query_subpod( verify_pods, verify_name );
   if( FD_UNLIKELY( !verify_pod ) ) FD_LOG_ERR(( "%s.verify.%s path not found", cfg_path, verify_name ));
 
+  uchar const * load_pod = fd_pod_query_subpod( verify_pod, "load" );
+  if( FD_UNLIKELY( !load_pod ) ) FD_LOG_ERR(( "%s.verify.%s.load path not found", cfg_path, verify_name ));
+
   /* Join the IPC objects needed this tile instance */
 
-  FD_LOG_INFO(( "joining %s.verify.%s.cnc", cfg_path, verify_name ));
-  fd_cnc_t * cnc = fd_cnc_join( fd_wksp_pod_map( verify_pod, "cnc" ) );
+  FD_LOG_INFO(( "joining %s.verify.%s.load.cnc", cfg_path, verify_name ));
+  fd_cnc_t * cnc = fd_cnc_join( fd_wksp_pod_map( load_pod, "cnc" ) );
   if( FD_UNLIKELY( !cnc ) ) FD_LOG_ERR(( "fd_cnc_join failed" ));
   if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) FD_LOG_ERR(( "cnc not in boot state" ));
   ulong * cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
@@ -40,32 +68,38 @@ fd_frank_verify_task( int     argc,
   int in_backp = 1;
 
   FD_COMPILER_MFENCE();
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP    ] ) = 1UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT   ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_CNT ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) = 0UL;
-  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP     ] ) = 1UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_BACKP_CNT    ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ   ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ   ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PKC_HIT_CNT  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_PKC_MISS_CNT ] ) = 0UL;
   FD_COMPILER_MFENCE();
 
-  FD_LOG_INFO(( "joining %s.verify.%s.mcache", cfg_path, verify_name ));
-  fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( verify_pod, "mcache" ) );
+  /* This tile is the producer of the verify's ingress */
+
+  FD_LOG_INFO(( "joining %s.verify.%s.in_mcache", cfg_path, verify_name ));
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_wksp_pod_map( verify_pod, "in_mcache" ) );
   if( FD_UNLIKELY( !mcache ) ) FD_LOG_ERR(( "fd_mcache_join failed" ));
   ulong   depth = fd_mcache_depth( mcache );
   ulong * sync  = fd_mcache_seq_laddr( mcache );
   ulong   seq   = fd_mcache_seq_query( sync );
 
-  FD_LOG_INFO(( "joining %s.verify.%s.dcache", cfg_path, verify_name ));
-  uchar * dcache = fd_dcache_join( fd_wksp_pod_map( verify_pod, "dcache" ) );
+  FD_LOG_INFO(( "joining %s.verify.%s.in_dcache", cfg_path, verify_name ));
+  uchar * dcache = fd_dcache_join( fd_wksp_pod_map( verify_pod, "in_dcache" ) );
   if( FD_UNLIKELY( !dcache ) ) FD_LOG_ERR(( "fd_dcache_join failed" ));
   fd_wksp_t * wksp = fd_wksp_containing( dcache ); /* chunks are referenced relative to the containing workspace */
   if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "fd_wksp_containing failed" ));
-  ulong   chunk0 = fd_dcache_compact_chunk0( wksp, dcache );
-  ulong   wmark  = fd_dcache_compact_wmark ( wksp, dcache, 1542UL ); /* FIXME: MTU? SAFETY CHECK THE FOOTPRINT? */
-  ulong   chunk  = chunk0;
-
-  FD_LOG_INFO(( "joining %s.verify.%s.fseq", cfg_path, verify_name ));
-  ulong * fseq = fd_fseq_join( fd_wksp_pod_map( verify_pod, "fseq" ) );
+  if( FD_UNLIKELY( wksp!=fd_wksp_containing( mcache ) ) ) FD_LOG_ERR(( "in_dcache should be in the same wksp as in_mcache" ));
+  if( FD_UNLIKELY( !fd_dcache_compact_is_safe( wksp, dcache, FD_TXN_MTU, depth ) ) ) FD_LOG_ERR(( "in_dcache too small" ));
+  ulong chunk0 = fd_dcache_compact_chunk0( wksp, dcache );
+  ulong wmark  = fd_dcache_compact_wmark ( wksp, dcache, FD_TXN_MTU );
+  ulong chunk  = chunk0;
+
+  FD_LOG_INFO(( "joining %s.verify.%s.in_fseq", cfg_path, verify_name ));
+  ulong * fseq = fd_fseq_join( fd_wksp_pod_map( verify_pod, "in_fseq" ) );
   if( FD_UNLIKELY( !fseq ) ) FD_LOG_ERR(( "fd_fseq_join failed" ));
   ulong * fseq_diag = (ulong *)fd_fseq_app_laddr( fseq );
   if( FD_UNLIKELY( !fseq_diag ) ) FD_LOG_ERR(( "fd_fseq_app_laddr failed" ));
@@ -74,14 +108,14 @@ fd_frank_verify_task( int     argc,
   /* Setup local objects used by this tile */
 
   FD_LOG_INFO(( "configuring flow control" ));
-  ulong cr_max    = fd_pod_query_ulong( verify_pod, "cr_max",    0UL );
-  ulong cr_resume = fd_pod_query_ulong( verify_pod, "cr_resume", 0UL );
-  ulong cr_refill = fd_pod_query_ulong( verify_pod, "cr_refill", 0UL );
-  long  lazy      = fd_pod_query_long ( verify_pod, "lazy",      0L  );
-  FD_LOG_INFO(( "%s.verify.%s.cr_max    %lu", cfg_path, verify_name, cr_max    ));
-  FD_LOG_INFO(( "%s.verify.%s.cr_resume %lu", cfg_path, verify_name, cr_resume ));
-  FD_LOG_INFO(( "%s.verify.%s.cr_refill %lu", cfg_path, verify_name, cr_refill ));
-  FD_LOG_INFO(( "%s.verify.%s.lazy      %li", cfg_path, verify_name, lazy      ));
+  ulong cr_max    = fd_pod_query_ulong( load_pod, "cr_max",    0UL );
+  ulong cr_resume = fd_pod_query_ulong( load_pod, "cr_resume", 0UL );
+  ulong cr_refill = fd_pod_query_ulong( load_pod, "cr_refill", 0UL );
+  long  lazy      = fd_pod_query_long ( load_pod, "lazy",      0L  );
+  FD_LOG_INFO(( "%s.verify.%s.load.cr_max    %lu", cfg_path, verify_name, cr_max    ));
+  FD_LOG_INFO(( "%s.verify.%s.load.cr_resume %lu", cfg_path, verify_name, cr_resume ));
+  FD_LOG_INFO(( "%s.verify.%s.load.cr_refill %lu", cfg_path, verify_name, cr_refill ));
+  FD_LOG_INFO(( "%s.verify.%s.load.lazy      %li", cfg_path, verify_name, lazy      ));
 
   fd_fctl_t * fctl = fd_fctl_cfg_done( fd_fctl_cfg_rx_add( fd_fctl_join( fd_fctl_new( fd_alloca( FD_FCTL_ALIGN,
                                                                                                  fd_fctl_footprint( 1UL ) ),
@@ -99,122 +133,98 @@ fd_frank_verify_task( int     argc,
   ulong async_min = fd_tempo_async_min( lazy, 1UL /*event_cnt*/, (float)fd_tempo_tick_per_ns( NULL ) );
   if( FD_UNLIKELY( !async_min ) ) FD_LOG_ERR(( "bad lazy" ));
 
-  uint seed = fd_pod_query_uint( verify_pod, "seed", (uint)fd_tile_id() ); /* use app tile_id as default */
-  FD_LOG_INFO(( "creating rng (%s.verify.%s.seed %u)", cfg_path, verify_name, seed ));
+  uint seed = fd_pod_query_uint( load_pod, "seed", (uint)fd_tile_id() ); /* use app tile_id as default */
+  FD_LOG_INFO(( "creating rng (%s.verify.%s.load.seed %u)", cfg_path, verify_name, seed ));
   fd_rng_t _rng[ 1 ];
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
   if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_join failed" ));
 
-  /* FIXME: PROBABLY SHOULD PUT THIS IN WORKSPACE */
-# define TCACHE_DEPTH   (16UL) /* Should be ~1/2-1/4 MAP_CNT */
-# define TCACHE_MAP_CNT (64UL) /* Power of two */
-  uchar tcache_mem[ FD_TCACHE_FOOTPRINT( TCACHE_DEPTH, TCACHE_MAP_CNT ) ] __attribute__((aligned(FD_TCACHE_ALIGN)));
-  fd_tcache_t * tcache  = fd_tcache_join( fd_tcache_new( tcache_mem, TCACHE_DEPTH, TCACHE_MAP_CNT ) );
-  ulong   tcache_depth   = fd_tcache_depth       ( tcache );
-  ulong   tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ulong * _tcache_sync   = fd_tcache_oldest_laddr( tcache );
-  ulong * _tcache_ring   = fd_tcache_ring_laddr  ( tcache );
-  ulong * _tcache_map    = fd_tcache_map_laddr   ( tcache );
-  ulong   tcache_oldest  = FD_VOLATILE_CONST( *_tcache_sync );
-
-  ulong accum_ha_filt_cnt = 0UL; ulong accum_ha_filt_sz = 0UL;
-
   fd_sha512_t _sha[1];
   fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
   if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512 join failed" ));
 
-  ulong accum_sv_filt_cnt = 0UL; ulong accum_sv_filt_sz = 0UL;
+  ulong signer_cnt = fd_pod_query_ulong( load_pod, "signer_cnt", 64UL    );
+  float tps        = fd_pod_query_float( load_pod, "tps",        0.f     );
+  float dup_frac   = fd_pod_query_float( load_pod, "dup_frac",   0.01f   );
+  float errsv_frac = fd_pod_query_float( load_pod, "errsv_frac", 1e-3f   );
+  FD_LOG_INFO(( "%s.verify.%s.load.signer_cnt %lu", cfg_path, verify_name, signer_cnt        ));
+  FD_LOG_INFO(( "%s.verify.%s.load.tps        %e",  cfg_path, verify_name, (double)tps        ));
+  FD_LOG_INFO(( "%s.verify.%s.load.dup_frac   %e",  cfg_path, verify_name, (double)dup_frac   ));
+  FD_LOG_INFO(( "%s.verify.%s.load.errsv_frac %e",  cfg_path, verify_name, (double)errsv_frac ));
+  if( FD_UNLIKELY( !((1UL<=signer_cnt) & (signer_cnt<=LOAD_SIGNER_MAX)) ) ) FD_LOG_ERR(( "signer_cnt should be in [1,%lu]", LOAD_SIGNER_MAX ));
+  if( FD_UNLIKELY( !((0.f<=dup_frac  ) & (dup_frac  <=1.f))         ) ) FD_LOG_ERR(( "dup_frac should be in [0,1]" ));
+  if( FD_UNLIKELY( !((0.f<=errsv_frac) & (errsv_frac<=1.f))         ) ) FD_LOG_ERR(( "errsv_frac should be in [0,1]" ));
+
+  /* Generate the signer key pairs (the public key of a signer is its
+     fee payer account address) */
+
+  uchar * signer_private = (uchar *)fd_alloca( 32UL, signer_cnt*32UL );
+  uchar * signer_public  = (uchar *)fd_alloca( 32UL, signer_cnt*32UL );
+  if( FD_UNLIKELY( (!signer_private) | (!signer_public) ) ) FD_LOG_ERR(( "fd_alloca failed" ));
+  for( ulong signer_idx=0UL; signer_idx<signer_cnt; signer_idx++ ) {
+    uchar * private_key = signer_private + signer_idx*32UL;
+    for( ulong b=0UL; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( signer_public + signer_idx*32UL, private_key, sha );
+  }
+
+  uchar recent_blockhash[ FD_TXN_BLOCKHASH_SZ ];
+  for( ulong b=0UL; b<FD_TXN_BLOCKHASH_SZ; b++ ) recent_blockhash[b] = fd_rng_uchar( rng );
 
-  /* Start verifying */
+  /* Describe the transactions.  The account addresses and the
+     instruction data that vary from transaction to transaction are
+     reserved and filled in place after the transaction is built. */
 
-  FD_LOG_INFO(( "verify.%s run", verify_name ));
+  static uchar const transfer_acct[2] = { 0, 1 };
 
-# define SYNTH_LOAD 1
-# if SYNTH_LOAD
+  fd_txn_build_instr_t instr[3] = {
+    { .program_id = 3, .acct_cnt = 0, .data_sz =  5, .acct = NULL,          .data = NULL }, /* SetComputeUnitLimit */
+    { .program_id = 3, .acct_cnt = 0, .data_sz =  9, .acct = NULL,          .data = NULL }, /* SetComputeUnitPrice */
+    { .program_id = 2, .acct_cnt = 2, .data_sz = 12, .acct = transfer_acct, .data = NULL }  /* System transfer */
+  };
 
-  /* We assume that the distribution layer has parsed the incoming
-     packets and stripped them down to a 32 byte public key, 64 byte
-     signature (just 1 signature, which is typical though there are
-     bursts where averages up to ~1.4 signatures are seen).  (FIXME:
-     PROBABLY SHOULD DEDUCT SOME EXTRA BYTES FOR THE QUIC HEADER
-     OVERHEAD AND SIGNATURE CNT FROM THE WORST CASE HERE.)  For every
-     possible size then, we precomp a packet for each size with a valid
-     signature to serve as our reference traffic. */
+  fd_txn_build_t b[1] = {{
+    .transaction_version   = FD_TXN_VLEGACY,
+    .signature_cnt         = 1,
+    .readonly_signed_cnt   = 0,
+    .readonly_unsigned_cnt = 2,
+    .acct_addr_cnt         = (ushort)LOAD_ACCT_CNT,
+    .acct_addr             = NULL,
+    .recent_blockhash      = recent_blockhash,
+    .instr_cnt             = 3,
+    .instr                 = instr,
+    .addr_table_lookup_cnt = 0,
+    .addr_table_lookup     = NULL
+  }};
 
-# define MSG_SZ_MIN (0UL)
-# define MSG_SZ_MAX (1232UL-64UL-32UL)
-  ulong ref_msg_mem_footprint = 0UL;
-  for( ulong msg_sz=MSG_SZ_MIN; msg_sz<=MSG_SZ_MAX; msg_sz++ ) ref_msg_mem_footprint += fd_ulong_align_up( msg_sz + 96UL, 128UL );
-  uchar * ref_msg_mem = fd_alloca( 128UL, ref_msg_mem_footprint );
-  if( FD_UNLIKELY( !ref_msg_mem ) ) FD_LOG_ERR(( "fd_alloc failed" ));
+  uchar txn_mem[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+  fd_txn_t * txn = (fd_txn_t *)txn_mem;
 
-  uchar * ref_msg[ MSG_SZ_MAX - MSG_SZ_MIN + 1UL ];
-  for( ulong msg_sz=MSG_SZ_MIN; msg_sz<=MSG_SZ_MAX; msg_sz++ ) {
-    ref_msg[ msg_sz - MSG_SZ_MIN ] = ref_msg_mem;
-    uchar * public_key = ref_msg_mem;
-    uchar * sig        = public_key  + 32UL;
-    uchar * msg        = sig         + 64UL;
-    ref_msg_mem += fd_ulong_align_up( msg_sz + 96UL, 128UL );
+  /* Recently published transactions are kept such that they can be
+     republished as dups (with the same payload and thus the same
+     signature, as a client or relay retrying a transaction would).
+     Dups of transactions older than the verify's ha tcache make it to
+     the dedup tile. */
 
-    /* Generate a public_key / private_key pair for this message */
+  uchar * dup_payload = (uchar *)fd_alloca( 128UL, LOAD_DUP_MAX*FD_TXN_MTU );
+  ulong   dup_sz[ LOAD_DUP_MAX ];
+  ulong   dup_cnt = 0UL;
+  if( FD_UNLIKELY( !dup_payload ) ) FD_LOG_ERR(( "fd_alloca failed" ));
 
-    ulong private_key[4]; for( ulong i=0UL; i<4UL; i++ ) private_key[i] = fd_rng_ulong( rng );
-    fd_ed25519_public_from_private( public_key, private_key, sha );
+  uint dup_thresh   = (uint)(0.5f + dup_frac  *(float)(1UL<<32));
+  uint errsv_thresh = (uint)(0.5f + errsv_frac*(float)(1UL<<32));
 
-    /* Make a random message */
-    for( ulong b=0UL; b<msg_sz; b++ ) msg[b] = fd_rng_uchar( rng );
+  /* Transactions arrive as a Poisson process with rate tps (or as fast
+     as the verify accepts them if tps is not positive) */
 
-    /* Sign it */
-    fd_ed25519_sign( sig, msg, msg_sz, public_key, private_key, sha );
-  }
+  float txn_tau = tps>0.f ? ((float)fd_tempo_tick_per_ns( NULL )*1e9f)/tps : 0.f;
 
-  /* Sanity check the ref messages verify */
-  for( ulong msg_sz=MSG_SZ_MIN; msg_sz<=MSG_SZ_MAX; msg_sz++ ) {
-    uchar * public_key = ref_msg[ msg_sz - MSG_SZ_MIN ];
-    uchar * sig        = public_key + 32UL;
-    uchar * msg        = sig        + 64UL;
-    FD_TEST( fd_ed25519_verify( msg, msg_sz, sig, public_key, sha )==FD_ED25519_SUCCESS );
-  }
-#endif
+  /* Start generating */
 
-  long now  = fd_tickcount();
-  long then = now;            /* Do housekeeping on first iteration of run loop */
-
-# if SYNTH_LOAD
-
-  ulong ha_cnt       = fd_pod_query_ulong( verify_pod, "ha-cnt",      fd_pod_query_ulong( cfg_pod, "verify.ha-cnt",      2UL    ) );
-  float burst_avg    = fd_pod_query_float( verify_pod, "burst-avg",   fd_pod_query_float( cfg_pod, "verify.burst-avg",   324.f  ) );
-  ulong msg_max      = fd_pod_query_ulong( verify_pod, "msg-max",     fd_pod_query_ulong( cfg_pod, "verify.msg-max",     MSG_SZ_MAX ) );
-  ulong msg_framing  = fd_pod_query_ulong( verify_pod, "msg-framing", fd_pod_query_ulong( cfg_pod, "verify.msg-framing", 70UL+32UL+64UL ) );
-  float pkt_bw       = fd_pod_query_float( verify_pod, "pkt-bw",      fd_pod_query_float( cfg_pod, "verify.pkt-bw",      1e9f   ) );
-  float dup_frac     = fd_pod_query_float( verify_pod, "dup-frac",    fd_pod_query_float( cfg_pod, "verify.dup-frac",    0.01f  ) );
-  float dup_avg_age  = fd_pod_query_float( verify_pod, "dup-avg-age", fd_pod_query_float( cfg_pod, "verify.dup-avg-age", 0.0f   ) );
-  float errsv_frac   = fd_pod_query_float( verify_pod, "errsv-frac",  fd_pod_query_float( cfg_pod, "verify.errsv-frac",  1e-3f  ) );
-  FD_LOG_NOTICE(( "burst-avg %f msg-max %lu msg-framing %lu pkt-bw %e dup-frac %f dup-avg-age %f errsv-frac %e",
-                  (double)burst_avg, msg_max, msg_framing, (double)pkt_bw, (double)dup_frac, (double)dup_avg_age, (double)errsv_frac ));
-
-  float burst_bw    = pkt_bw
-                    / (1.f - ((((float)msg_framing)/((float)burst_avg)) / expm1f( -((float)msg_max)/((float)burst_avg) )));
-  float tick_per_ns = (float)fd_tempo_tick_per_ns( NULL );
-  float burst_tau   = (tick_per_ns*burst_avg)*(8e9f/burst_bw);
-  int   ctl_som     = 1;
-  ulong burst_ts    = 0UL;  /* Irrelevant value at init */
-  long  burst_next  = then;
-  ulong burst_rem;
-  do {
-    burst_next +=        (long)(0.5f + burst_tau*fd_rng_float_exp( rng ));
-    burst_rem   = (ulong)(long)(0.5f + burst_avg*fd_rng_float_exp( rng ));
-  } while( FD_UNLIKELY( !burst_rem ) );
-
-  uint  dup_thresh   = (uint)(0.5f + dup_frac*(float)(1UL<<32));
-  uint  errsv_thresh = (uint)(0.5f + errsv_frac*(float)(1UL<<32));
-
-  ulong tx_idx  = fd_tile_idx();
-  uint  dup_seq = 0U;
-  ulong ha_tag  = fd_rng_ulong( rng );
-
-# endif
+  FD_LOG_INFO(( "verify.%s.load run", verify_name ));
 
+  long now      = fd_tickcount();
+  long then     = now;            /* Do housekeeping on first iteration of run loop */
+  long txn_next = now;
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
   for(;;) {
 
@@ -224,22 +234,9 @@ fd_frank_verify_task( int     argc,
 
       /* Send synchronization info */
       fd_mcache_seq_update( sync, seq );
-      FD_COMPILER_MFENCE();
-      FD_VOLATILE( *_tcache_sync ) = tcache_oldest;
-      FD_COMPILER_MFENCE();
 
       /* Send diagnostic info */
       fd_cnc_heartbeat( cnc, now );
-      FD_COMPILER_MFENCE();
-      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_CNT ] ) + accum_ha_filt_cnt;
-      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) + accum_ha_filt_sz;
-      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) + accum_sv_filt_cnt;
-      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) + accum_sv_filt_sz;
-      FD_COMPILER_MFENCE();
-      accum_ha_filt_cnt = 0UL;
-      accum_ha_filt_sz  = 0UL;
-      accum_sv_filt_cnt = 0UL;
-      accum_sv_filt_sz  = 0UL;
 
       /* Receive command-and-control signals */
       ulong s = fd_cnc_signal_query( cnc );
@@ -262,6 +259,7 @@ fd_frank_verify_task( int     argc,
     }
 
     /* Check if we are backpressured */
+
     if( FD_UNLIKELY( !cr_avail ) ) {
       if( FD_UNLIKELY( !in_backp ) ) {
         FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_IN_BACKP  ] ) = 1UL;
@@ -273,175 +271,85 @@ fd_frank_verify_task( int     argc,
       continue;
     }
 
-#   if SYNTH_LOAD
-    /* Check if we are waiting for the next burst to start */
+    /* Check if we are waiting for the next transaction to arrive */
 
-    if( FD_LIKELY( ctl_som ) ) {
-      if( FD_UNLIKELY( now<burst_next ) ) { /* Optimize for burst starting */
-        FD_SPIN_PAUSE();
-        now = fd_tickcount();
-        continue;
-      }
-      /* We just "started receiving" the first bytes of the next burst
-         from the redudant "NIC".  Record the timestamp. */
-      burst_ts = fd_frag_meta_ts_comp( burst_next );
+    if( FD_UNLIKELY( (now-txn_next)<0L ) ) {
+      FD_SPIN_PAUSE();
+      now = fd_tickcount();
+      continue;
     }
-    ulong msg_sz = fd_ulong_min( burst_rem, msg_max );
-    burst_rem -= msg_sz;
-    int ctl_eom = !burst_rem;
-    int ctl_err = 0;
-
-    int   is_dup = fd_rng_uint( rng ) < dup_thresh;
-    uint  age    = is_dup ? (uint)(int)(1.0f + dup_avg_age*fd_rng_float_exp( rng )) : 0U;
-    dup_seq += (uint)!is_dup;
-    ulong meta_sig = fd_ulong_hash( (((ulong)tx_idx)<<32) | ((ulong)(dup_seq-age)) ); /* See note below */
-
-    ulong   ctl    = fd_frag_meta_ctl( tx_idx, ctl_som, ctl_eom, ctl_err );
-    ulong   tsorig = burst_ts;
-
-    for( ulong ha_idx=0UL; ha_idx<ha_cnt; ha_idx++ ) {
-    //if( ... probability of loss on this ha ... ) continue; /* FIXME: ADD HA LOSS MODEL */
-
-      /* We are in the process of "receiving" a burst fragment from the
-         one of the redundant "NIC"s.  Compute the details of the
-         synthetic fragment and fill the data region with a suitable
-         test pattern as fast as we can. */
-
-      /* We assume the layer feeding us has already aligned the udp
-         payload on the chunk boundary (such that udp_payload-8 is UDP
-         header, udp_payload-28 is IP4 header, udp_payload-32 is VLAN
-         tag, udp_payload-46 is ethernet header, udp_payload-54 is
-         preamble, udp_payload+msg_sz is crc and udp_payload+msg_sz+4 is
-         IFG and udp_payload_msg_sz+12 is last logical wire byte).  We
-         don't bother to fill these in from synthetic data as we ignore
-         them here (the previous layers should have already validated
-         them).  This implicity assumes that runt and jumbo frames have
-         been discarded upstream. */
-
-      /*ulong chunk  = ... already at location where next packet will be written ...; */
-      /*ulong tspub  = ... set "after" finished receiving from the "NIC" ...; */
-
-      uchar *       udp_payload = (uchar *)fd_chunk_to_laddr( wksp, chunk );
-      uchar *       d           = udp_payload;
-      uchar const * s           = ref_msg[ msg_sz ];
-      for( ulong off=0UL; off<32UL+64UL+msg_sz; off+=128UL ) {
-        __m256i avx0 = _mm256_load_si256( (__m256i const *)(s     ) );
-        __m256i avx1 = _mm256_load_si256( (__m256i const *)(s+32UL) );
-        __m256i avx2 = _mm256_load_si256( (__m256i const *)(s+64UL) );
-        __m256i avx3 = _mm256_load_si256( (__m256i const *)(s+96UL) );
-        _mm256_store_si256( (__m256i *)(d     ), avx0 );
-        _mm256_store_si256( (__m256i *)(d+32UL), avx1 );
-        _mm256_store_si256( (__m256i *)(d+64UL), avx2 );
-        _mm256_store_si256( (__m256i *)(d+96UL), avx3 );
-        s += 128UL;
-        d += 128UL;
-      }
+    ulong tsorig = fd_frag_meta_ts_comp( txn_next );
+    txn_next = fd_long_if( txn_tau>0.f, txn_next + (long)(0.5f + txn_tau*fd_rng_float_exp( rng )), now );
 
-      /* We just "finished receiving" the next fragment of the burst
-         from the "NIC".  udp_payload points to:
-            public_key(32) | sig(64) | msg(msg_sz)
-         Lightweight parse the packet. */
-
-      ulong const * public_key = (ulong const *) udp_payload;
-      ulong const * sig        = (ulong const *)(udp_payload + 32UL);
-      uchar const * msg        = (uchar const *)(udp_payload + 96UL);
-
-      /* Sig is already effectively a cryptographically secure hash of
-         public_key/private_key and message and sz.  So use this to do a
-         quick dedup of ha traffic (FIXME: POTENTIAL DOS ATTACK IF
-         SOMEBODY COULD INTERCEPT TRAFFIC AND SUBMIT PACKETS WITH SAME
-         PUBLIC KEY, SIG AND GARBAGE MESSAGE AHEAD OF THE TRAFFIC ...
-         SEEMS UNLKELY AS THEY WOULD EITHER BE BEHIND THE INBOUND OR BE
-         A MITM THAT COULD JUST DISCARD INBOUND TRAFFIC).
-
-         When running synthetic load though, we only have a very limited
-         set of messages and this dedup will be overly aggressive (as it
-         will spuriously matching earlier synthetic packets since they
-         are not resigned continuously)  So we just mock this up for the
-         time being. */
-
-      int ha_dup;
-      FD_TCACHE_INSERT( ha_dup, tcache_oldest, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, ha_tag );
-      if( FD_UNLIKELY( ha_dup ) ) { /* optimize for the non dup case */
-        accum_ha_filt_cnt++;
-        accum_ha_filt_sz += msg_framing + msg_sz;
-        now = fd_tickcount();
-        continue;
-      }
+    uchar * payload = (uchar *)fd_chunk_to_laddr( wksp, chunk );
+    ulong   sz;
 
-      /* We appear to have a message to verify.  So verify it.
+    if( FD_UNLIKELY( dup_cnt && fd_rng_uint( rng )<dup_thresh ) ) {
 
-         When running synthetic load, the synthetic data will not fail
-         at this point so we fake up some configurable rate of errors to
-         stress out the monitoring.  (We could also slightly more
-         expensively get the same effect by corrupting the udp_payload
-         region before the verify.) */
+      /* Republish a recent transaction */
 
-      int err = fd_ed25519_verify( msg, msg_sz, sig, public_key, sha );
+      ulong dup_idx = fd_rng_ulong_roll( rng, dup_cnt );
+      sz = dup_sz[ dup_idx ];
+      fd_memcpy( payload, dup_payload + dup_idx*FD_TXN_MTU, sz );
 
-      FD_TEST( !err ); /* These should always pass here */
-      if( FD_UNLIKELY( fd_rng_uint( rng )<=errsv_thresh ) ) { /* And model random failures at some low rate */
-        accum_sv_filt_cnt++;
-        accum_sv_filt_sz += msg_framing + msg_sz;
-        now = fd_tickcount();
-        continue;
-      }
+    } else {
 
-      /* Packet looks superficially good.  Forward it.  If somebody is
-         opening multiple connections (which would potentially flow
-         steered to different verify tiles) and spammed these
-         connections with the same transaction, ha dedup here is likely
-         to miss that.   But the dedup tile that muxes all the inputs
-         will take care of that.  (The use of QUIC and the like should
-         also strongly reduce the economic incentives for this
-         behavior.)
+      /* Build a new transaction in place */
 
-         When running synthetic load, we have the same problem we had
-         above.  So we use a signature that will match with the desired
-         probability. */
+      if( FD_UNLIKELY( !fd_txn_build( b, payload, FD_TXN_MTU, txn_mem, &sz ) ) ) FD_LOG_ERR(( "fd_txn_build failed" ));
 
-      /* Note that sig is now guaranteed to be not FD_TCACHE_TAG_NULL
-         and we use the least significant 64-bits of the SHA-512 hash
-         for dedup purposes. */
+      ulong         signer_idx  = fd_rng_ulong_roll( rng, signer_cnt );
+      uchar const * public_key  = signer_public  + signer_idx*32UL;
+      uchar const * private_key = signer_private + signer_idx*32UL;
 
-      now = fd_tickcount();
-      ulong tspub = fd_frag_meta_ts_comp( now );
-      fd_mcache_publish( mcache, depth, seq, meta_sig, chunk, msg_framing+msg_sz, ctl, tsorig, tspub );
+      uchar * acct_addr = payload + txn->acct_addr_off;
+      fd_memcpy( acct_addr, public_key, 32UL );
+      for( ulong w=0UL; w<4UL; w++ ) FD_STORE( ulong, acct_addr + 32UL + w*8UL, fd_rng_ulong( rng ) );
+      fd_memcpy( acct_addr + 64UL, fd_frank_load_system_program_id, FD_TXN_ACCT_ADDR_SZ );
+      fd_memcpy( acct_addr + 96UL, FD_COMPUTE_BUDGET_PROGRAM_ID,     FD_TXN_ACCT_ADDR_SZ );
 
-      chunk = fd_dcache_compact_next( chunk, msg_framing + msg_sz, chunk0, wmark );
-      seq   = fd_seq_inc( seq, 1UL );
-      cr_avail--;
-    }
-    ha_tag++;
+      uchar * cu_limit_data = payload + txn->instr[0].data_off;
+      uchar * cu_price_data = payload + txn->instr[1].data_off;
+      uchar * transfer_data = payload + txn->instr[2].data_off;
+      cu_limit_data[0] = (uchar)2;
+      FD_STORE( uint,  cu_limit_data + 1, (uint)(LOAD_CU_LIMIT_MIN + fd_rng_ulong_roll( rng, LOAD_CU_LIMIT_MAX-LOAD_CU_LIMIT_MIN+1UL )) );
+      cu_price_data[0] = (uchar)3;
+      FD_STORE( ulong, cu_price_data + 1, fd_rng_ulong_roll( rng, LOAD_CU_PRICE_MAX+1UL ) );
+      FD_STORE( uint,  transfer_data,     2U ); /* Transfer */
+      FD_STORE( ulong, transfer_data + 4, 1UL + fd_rng_ulong_roll( rng, 1000000000UL ) );
+
+      fd_txn_build_sign( payload, sz, txn, 0UL, public_key, private_key, sha );
+
+      /* Corrupt the signature of some transactions to exercise the
+         verify's signature filtering */
 
-    /* Wind up for the next iteration */
+      if( FD_UNLIKELY( fd_rng_uint( rng )<errsv_thresh ) ) payload[ txn->signature_off ] ^= (uchar)1;
 
-    if( FD_UNLIKELY( !ctl_eom ) ) ctl_som = 0;
-    else {
-      ctl_som = 1;
-      do {
-        burst_next +=        (long)(0.5f + burst_tau*fd_rng_float_exp( rng ));
-        burst_rem   = (ulong)(long)(0.5f + burst_avg*fd_rng_float_exp( rng ));
-      } while( FD_UNLIKELY( !burst_rem ) );
+      ulong dup_idx = dup_cnt<LOAD_DUP_MAX ? dup_cnt++ : fd_rng_ulong_roll( rng, LOAD_DUP_MAX );
+      dup_sz[ dup_idx ] = sz;
+      fd_memcpy( dup_payload + dup_idx*FD_TXN_MTU, payload, sz );
     }
-#   else
-    /* Placeholder for sig verify */
-    (void)_tcache_map;
-    (void)_tcache_ring;
-    (void)tcache_depth;
-    (void)tcache_map_cnt;
-    (void)chunk;
-    (void)wmark;
+
+    /* Publish the transaction to the verify.  Like the verify does, use
+       the leading 64-bits of the first signature as the frag sig (every
+       transaction has the same layout so txn is valid for dups too). */
+
+    ulong sig   = fd_ulong_load_8( payload + txn->signature_off );
+    ulong ctl   = fd_frag_meta_ctl( 0UL /*orig*/, 1 /*som*/, 1 /*eom*/, 0 /*err*/ );
+    ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_mcache_publish( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+
+    chunk = fd_dcache_compact_next( chunk, sz, chunk0, wmark );
+    seq   = fd_seq_inc( seq, 1UL );
+    cr_avail--;
     now = fd_tickcount();
-#   endif
   }
 
   /* Clean up */
 
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
-  FD_LOG_INFO(( "verify.%s fini", verify_name ));
+  FD_LOG_INFO(( "verify.%s.load fini", verify_name ));
   fd_sha512_delete ( fd_sha512_leave( sha    ) );
-  fd_tcache_delete ( fd_tcache_leave( tcache ) );
   fd_rng_delete    ( fd_rng_leave   ( rng    ) );
   fd_fctl_delete   ( fd_fctl_leave  ( fctl   ) );
   fd_wksp_pod_unmap( fd_fseq_leave  ( fseq   ) );
@@ -455,12 +363,11 @@ fd_frank_verify_task( int     argc,
 #else
 
 int
-fd_frank_verify_task( int     argc,
-                      char ** argv ) {
+fd_frank_verify_synth_load_task( int     argc,
+                                 char ** argv ) {
   (void)argc; (void)argv;
   FD_LOG_WARNING(( "unsupported for this build target" ));
   return 1;
 }
 
 #endif
-
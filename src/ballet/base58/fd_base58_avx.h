@@ -117,6 +117,44 @@ intermediate_to_raw( wl_t intermediate ) {
   return shift;
 }
 
+/* div_58_5 returns floor(x/58^5) for each ulong x in the vector and
+   stores x % 58^5 in *rem.  The batch conversions use this to reduce
+   the intermediate terms of 4 different inputs at once.
+
+   AVX2 doesn't have a 64b x 64b -> 128b multiplication, so the magic
+   multiplication is done on 32 bit halves.  58^5 = 2^5*20511149, so
+   floor(x/58^5) = floor(floor(x/2^5)/20511149).  floor(x/2^5) < 2^59,
+   so with m=ceil(2^84/20511149) (which is < 2^60), the quotient is the
+   high 64 bits of floor(x/2^5)*m shifted right by 20 (the error term is
+   at most 2^59*(m*20511149-2^84)/2^84 < 1/20511149). */
+
+static inline wl_t
+div_58_5( wl_t   x,
+          wl_t * rem ) {
+  wl_t m_lo  = wl_bcast( (long)2738892119UL ); /* low  32 bits of m=943038984009821527 */
+  wl_t m_hi  = wl_bcast( (long) 219568373UL ); /* high 32 bits of m */
+  wl_t mask  = wl_bcast( (long)0xFFFFFFFFUL );
+  wl_t r1div = wl_bcast( (long) 656356768UL ); /* 58^5 */
+
+  wl_t a    = wl_shru( x, 5 );
+  wl_t a_hi = wl_shru( a, 32 );
+
+  /* _mm256_mul_epu32 only looks at the low 32 bits of each lane */
+  wl_t ll = _mm256_mul_epu32( a,    m_lo );
+  wl_t lh = _mm256_mul_epu32( a,    m_hi );
+  wl_t hl = _mm256_mul_epu32( a_hi, m_lo );
+  wl_t hh = _mm256_mul_epu32( a_hi, m_hi );
+
+  wl_t mid = wl_add( wl_add( wl_shru( ll, 32 ), wl_and( lh, mask ) ), wl_and( hl, mask ) ); /* < 3*2^32 */
+  wl_t hi  = wl_add( wl_add( hh, wl_shru( lh, 32 ) ), wl_add( wl_shru( hl, 32 ), wl_shru( mid, 32 ) ) );
+  wl_t q   = wl_shru( hi, 20 );
+
+  /* x % 58^5 < 2^32, so only the low 32 bits of q*58^5 matter, and
+     those only depend on the low 32 bits of q. */
+  *rem = wl_and( wl_sub( x, _mm256_mul_epu32( q, r1div ) ), mask );
+  return q;
+}
+
 /* Converts each byte in the AVX2 register from raw base58 [0,58) to
    base58 digits ('1'-'z', with some skips).  Anything not in the range
    [0, 58) will be mapped arbitrarily, but won't affect other bytes. */
@@ -21,6 +21,7 @@
 
 #define BYTE_CNT     ((ulong) N)
 #define SUFFIX(s)    FD_EXPAND_THEN_CONCAT3(s,_,N)
+#define BATCH(s)     FD_EXPAND_THEN_CONCAT4(s,_,N,_batch)
 #define ENCODED_SZ() FD_EXPAND_THEN_CONCAT3(FD_BASE58_ENCODED_, N, _SZ)
 #define RAW58_SZ     (INTERMEDIATE_SZ*5UL)
 
@@ -30,12 +31,11 @@
 #define INTERMEDIATE_SZ_W_PADDING INTERMEDIATE_SZ
 #endif
 
-char *
-SUFFIX(fd_base58_encode)( uchar const * bytes,
-                          ulong       * opt_len,
-                          char        * out    ){
+/* fd_base58_private_leading_0s_{N} returns the number of leading zero
+   bytes of the N bytes pointed to by bytes. */
 
-  /* Count leading zeros (needed for final output) */
+static inline ulong
+SUFFIX(fd_base58_private_leading_0s)( uchar const * bytes ) {
 #if FD_HAS_AVX
 # if N==32
   wuc_t _bytes = wuc_ldu( bytes );
@@ -46,89 +46,24 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
   ulong in_leading_0s = count_leading_zeros_64( bytes_0, bytes_1 );
 # endif
 #else
-
   ulong in_leading_0s = 0UL;
   for( ; in_leading_0s<BYTE_CNT; in_leading_0s++ ) if( bytes[ in_leading_0s ] ) break;
 #endif
+  return in_leading_0s;
+}
 
-  /* X = sum_i bytes[i] * 2^(8*(BYTE_CNT-1-i)) */
-
-  /* Convert N to 32-bit limbs:
-     X = sum_i binary[i] * 2^(32*(BINARY_SZ-1-i)) */
-  uint binary[ BINARY_SZ ];
-  uint const * bytes_as_uint = (uint const *)bytes;
-  for( ulong i=0UL; i<BINARY_SZ; i++ ) binary[ i ] = fd_uint_bswap( bytes_as_uint[ i ] );
-
-  ulong R1div = 656356768UL; /* = 58^5 */
-
-  /* Convert to the intermediate format:
-       X = sum_i intermediate[i] * 58^(5*(INTERMEDIATE_SZ-1-i))
-     Initially, we don't require intermediate[i] < 58^5, but we do want
-     to make sure the sums don't overflow. */
-
-#if FD_HAS_AVX
-  ulong W_ATTR intermediate[ INTERMEDIATE_SZ_W_PADDING ];
-#else
-  ulong intermediate[ INTERMEDIATE_SZ_W_PADDING ];
-#endif
-
-  fd_memset( intermediate, 0, INTERMEDIATE_SZ_W_PADDING * sizeof(ulong) );
-
-# if N==32
-
-  /* The worst case is if binary[7] is (2^32)-1. In that case
-     intermediate[8] will be be just over 2^63, which is fine. */
-
-  for( ulong i=0UL; i < BINARY_SZ; i++ )
-    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
-      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
-
-# elif N==64
-
-  /* If we do it the same way as the 32B conversion, intermediate[16]
-     can overflow when the input is sufficiently large.  We'll do a
-     mini-reduction after the first 8 steps.  After the first 8 terms,
-     the largest intermediate[16] can be is 2^63.87.  Then, after
-     reduction it'll be at most 58^5, and after adding the last terms,
-     it won't exceed 2^63.1.  We do need to be cautious that the
-     mini-reduction doesn't cause overflow in intermediate[15] though.
-     Pre-mini-reduction, it's at most 2^63.05.  The mini-reduction adds
-     at most 2^64/58^5, which is negligible.  With the final terms, it
-     won't exceed 2^63.69, which is fine. Other terms are less than
-     2^63.76, so no problems there. */
-
-  for( ulong i=0UL; i < 8UL; i++ )
-    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
-      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
-  /* Mini-reduction */
-  intermediate[ 15 ] += intermediate[ 16 ]/R1div;
-  intermediate[ 16 ] %= R1div;
-  /* Finish iterations */
-  for( ulong i=8UL; i < BINARY_SZ; i++ )
-    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
-      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
-
-# else
-# error "Add support for this N"
-# endif
-
-  /* Now we make sure each term is less than 58^5. Again, we have to be
-     a bit careful of overflow.
-
-     For N==32, in the worst case, as before, intermediate[8] will be
-     just over 2^63 and intermediate[7] will be just over 2^62.6.  In
-     the first step, we'll add floor(intermediate[8]/58^5) to
-     intermediate[7].  58^5 is pretty big though, so intermediate[7]
-     barely budges, and this is still fine.
-
-     For N==64, in the worst case, the biggest entry in intermediate at
-     this point is 2^63.87, and in the worst case, we add (2^64-1)/58^5,
-     which is still about 2^63.87. */
+/* fd_base58_private_encode_finish_{N} converts the intermediate form
+   (all terms in [0,58^5)) of an N byte number that had in_leading_0s
+   leading zero bytes to the final base58 cstr.  Has the same output
+   semantics as fd_base58_encode_{N}.  With AVX, intermediate must be
+   W_ALIGN aligned and INTERMEDIATE_SZ_W_PADDING long with the padding
+   zeroed. */
 
-  for( ulong i=INTERMEDIATE_SZ-1UL; i>0UL; i-- ) {
-    intermediate[ i-1UL ] += (intermediate[ i ]/R1div);
-    intermediate[ i     ] %= R1div;
-  }
+static inline char *
+SUFFIX(fd_base58_private_encode_finish)( ulong const * intermediate,
+                                         ulong         in_leading_0s,
+                                         ulong *       opt_len,
+                                         char *        out ) {
 
 #if !FD_HAS_AVX
   /* Convert intermediate form to base 58.  This form of conversion
@@ -184,9 +119,9 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
 
 #else /* FD_HAS_AVX */
 # if N==32
-  wl_t intermediate0 = wl_ld( (long*)intermediate     );
-  wl_t intermediate1 = wl_ld( (long*)intermediate+4UL );
-  wl_t intermediate2 = wl_ld( (long*)intermediate+8UL );
+  wl_t intermediate0 = wl_ld( (long const *)intermediate     );
+  wl_t intermediate1 = wl_ld( (long const *)intermediate+4UL );
+  wl_t intermediate2 = wl_ld( (long const *)intermediate+8UL );
   wuc_t raw0 = intermediate_to_raw( intermediate0 );
   wuc_t raw1 = intermediate_to_raw( intermediate1 );
   wuc_t raw2 = intermediate_to_raw( intermediate2 );
@@ -249,11 +184,11 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
   _mm256_maskstore_epi64(  (long long int*)(out - skip), mask2, base58_0 );
 
 # elif N==64
-  wuc_t raw0 = intermediate_to_raw( wl_ld( (long*)intermediate      ) );
-  wuc_t raw1 = intermediate_to_raw( wl_ld( (long*)intermediate+4UL  ) );
-  wuc_t raw2 = intermediate_to_raw( wl_ld( (long*)intermediate+8UL  ) );
-  wuc_t raw3 = intermediate_to_raw( wl_ld( (long*)intermediate+12UL ) );
-  wuc_t raw4 = intermediate_to_raw( wl_ld( (long*)intermediate+16UL ) );
+  wuc_t raw0 = intermediate_to_raw( wl_ld( (long const *)intermediate      ) );
+  wuc_t raw1 = intermediate_to_raw( wl_ld( (long const *)intermediate+4UL  ) );
+  wuc_t raw2 = intermediate_to_raw( wl_ld( (long const *)intermediate+8UL  ) );
+  wuc_t raw3 = intermediate_to_raw( wl_ld( (long const *)intermediate+12UL ) );
+  wuc_t raw4 = intermediate_to_raw( wl_ld( (long const *)intermediate+16UL ) );
 
   wuc_t compact0, compact1, compact2;
   ten_per_slot_down_64( raw0, raw1, raw2, raw3, raw4, compact0, compact1, compact2 );
@@ -297,9 +232,106 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
   return out;
 }
 
-uchar *
-SUFFIX(fd_base58_decode)( char const * encoded,
-                          uchar      * out      ) {
+char *
+SUFFIX(fd_base58_encode)( uchar const * bytes,
+                          ulong       * opt_len,
+                          char        * out    ){
+
+  /* Count leading zeros (needed for final output) */
+
+  ulong in_leading_0s = SUFFIX(fd_base58_private_leading_0s)( bytes );
+
+  /* X = sum_i bytes[i] * 2^(8*(BYTE_CNT-1-i)) */
+
+  /* Convert N to 32-bit limbs:
+     X = sum_i binary[i] * 2^(32*(BINARY_SZ-1-i)) */
+  uint binary[ BINARY_SZ ];
+  uint const * bytes_as_uint = (uint const *)bytes;
+  for( ulong i=0UL; i<BINARY_SZ; i++ ) binary[ i ] = fd_uint_bswap( bytes_as_uint[ i ] );
+
+  ulong R1div = 656356768UL; /* = 58^5 */
+
+  /* Convert to the intermediate format:
+       X = sum_i intermediate[i] * 58^(5*(INTERMEDIATE_SZ-1-i))
+     Initially, we don't require intermediate[i] < 58^5, but we do want
+     to make sure the sums don't overflow. */
+
+#if FD_HAS_AVX
+  ulong W_ATTR intermediate[ INTERMEDIATE_SZ_W_PADDING ];
+#else
+  ulong intermediate[ INTERMEDIATE_SZ_W_PADDING ];
+#endif
+
+  fd_memset( intermediate, 0, INTERMEDIATE_SZ_W_PADDING * sizeof(ulong) );
+
+# if N==32
+
+  /* The worst case is if binary[7] is (2^32)-1. In that case
+     intermediate[8] will be be just over 2^63, which is fine. */
+
+  for( ulong i=0UL; i < BINARY_SZ; i++ )
+    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+
+# elif N==64
+
+  /* If we do it the same way as the 32B conversion, intermediate[16]
+     can overflow when the input is sufficiently large.  We'll do a
+     mini-reduction after the first 8 steps.  After the first 8 terms,
+     the largest intermediate[16] can be is 2^63.87.  Then, after
+     reduction it'll be at most 58^5, and after adding the last terms,
+     it won't exceed 2^63.1.  We do need to be cautious that the
+     mini-reduction doesn't cause overflow in intermediate[15] though.
+     Pre-mini-reduction, it's at most 2^63.05.  The mini-reduction adds
+     at most 2^64/58^5, which is negligible.  With the final terms, it
+     won't exceed 2^63.69, which is fine. Other terms are less than
+     2^63.76, so no problems there. */
+
+  for( ulong i=0UL; i < 8UL; i++ )
+    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+  /* Mini-reduction */
+  intermediate[ 15 ] += intermediate[ 16 ]/R1div;
+  intermediate[ 16 ] %= R1div;
+  /* Finish iterations */
+  for( ulong i=8UL; i < BINARY_SZ; i++ )
+    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+
+# else
+# error "Add support for this N"
+# endif
+
+  /* Now we make sure each term is less than 58^5. Again, we have to be
+     a bit careful of overflow.
+
+     For N==32, in the worst case, as before, intermediate[8] will be
+     just over 2^63 and intermediate[7] will be just over 2^62.6.  In
+     the first step, we'll add floor(intermediate[8]/58^5) to
+     intermediate[7].  58^5 is pretty big though, so intermediate[7]
+     barely budges, and this is still fine.
+
+     For N==64, in the worst case, the biggest entry in intermediate at
+     this point is 2^63.87, and in the worst case, we add (2^64-1)/58^5,
+     which is still about 2^63.87. */
+
+  for( ulong i=INTERMEDIATE_SZ-1UL; i>0UL; i-- ) {
+    intermediate[ i-1UL ] += (intermediate[ i ]/R1div);
+    intermediate[ i     ] %= R1div;
+  }
+
+  return SUFFIX(fd_base58_private_encode_finish)( intermediate, in_leading_0s, opt_len, out );
+}
+
+/* fd_base58_private_decode_intermediate_{N} validates the base58 cstr
+   encoded and converts it to the intermediate form (base 58^5, all
+   terms in [0,58^5)), which is stored in intermediate (indexed
+   [0,INTERMEDIATE_SZ)).  Returns 1 on success and 0 if encoded
+   contains an invalid character or is too long. */
+
+static inline int
+SUFFIX(fd_base58_private_decode_intermediate)( char const * encoded,
+                                               ulong *      intermediate ) {
 
   /* Validate string and count characters before the nul terminator */
 
@@ -310,10 +342,10 @@ SUFFIX(fd_base58_decode)( char const * encoded,
     /* If c<'1', this will underflow and idx will be huge */
     ulong idx = (ulong)(uchar)c - (ulong)BASE58_INVERSE_TABLE_OFFSET;
     idx = fd_ulong_min( idx, BASE58_INVERSE_TABLE_SENTINEL );
-    if( FD_UNLIKELY( base58_inverse[ idx ] == BASE58_INVALID_CHAR ) ) return NULL;
+    if( FD_UNLIKELY( base58_inverse[ idx ] == BASE58_INVALID_CHAR ) ) return 0;
   }
 
-  if( FD_UNLIKELY( char_cnt == ENCODED_SZ() ) ) return NULL; /* too long */
+  if( FD_UNLIKELY( char_cnt == ENCODED_SZ() ) ) return 0; /* too long */
 
   /* X = sum_i raw_base58[i] * 58^(RAW58_SZ-1-i) */
 
@@ -328,7 +360,6 @@ SUFFIX(fd_base58_decode)( char const * encoded,
   /* Convert to the intermediate format (base 58^5):
        X = sum_i intermediate[i] * 58^(5*(INTERMEDIATE_SZ-1-i)) */
 
-  ulong intermediate[ INTERMEDIATE_SZ ];
   for( ulong i=0UL; i<INTERMEDIATE_SZ; i++ )
     intermediate[ i ] = (ulong)raw_base58[ 5UL*i+0UL ] * 11316496UL +
                         (ulong)raw_base58[ 5UL*i+1UL ] * 195112UL   +
@@ -336,6 +367,51 @@ SUFFIX(fd_base58_decode)( char const * encoded,
                         (ulong)raw_base58[ 5UL*i+3UL ] * 58UL       +
                         (ulong)raw_base58[ 5UL*i+4UL ] * 1UL;
 
+  return 1;
+}
+
+/* fd_base58_private_decode_finish_{N} writes the N byte number given
+   by binary (base 2^32, indexed [0,BINARY_SZ), all terms but the
+   first already reduced to [0,2^32)) to out in big endian.  encoded
+   is the cstr binary was decoded from.  Has the same return value
+   semantics as fd_base58_decode_{N}. */
+
+static inline uchar *
+SUFFIX(fd_base58_private_decode_finish)( char const *  encoded,
+                                         ulong const * binary,
+                                         uchar *       out ) {
+
+  /* If the largest term is 2^32 or bigger, it means N is larger than
+     what can fit in BYTE_CNT bytes.  This can be triggered, by passing
+     a base58 string of all 'z's for example. */
+
+  if( FD_UNLIKELY( binary[ 0UL ] > 0xFFFFFFFFUL ) ) return NULL;
+
+  /* Convert each term to big endian for the final output */
+
+  uint * out_as_uint = (uint*)out;
+  for( ulong i=0UL; i<BINARY_SZ; i++ ) {
+    out_as_uint[ i ] = fd_uint_bswap( (uint)binary[ i ] );
+  }
+  /* Make sure the encoded version has the same number of leading '1's
+     as the decoded version has leading 0s. The check doesn't read past
+     the end of encoded, because '\0' != '1', so it will return NULL. */
+
+  ulong leading_zero_cnt = 0UL;
+  for( ; leading_zero_cnt<BYTE_CNT; leading_zero_cnt++ ) {
+    if( out[ leading_zero_cnt ] ) break;
+    if( FD_UNLIKELY( encoded[ leading_zero_cnt ] != '1' ) ) return NULL;
+  }
+  if( FD_UNLIKELY( encoded[ leading_zero_cnt ] == '1' ) ) return NULL;
+  return out;
+}
+
+uchar *
+SUFFIX(fd_base58_decode)( char const * encoded,
+                          uchar      * out      ) {
+
+  ulong intermediate[ INTERMEDIATE_SZ ];
+  if( FD_UNLIKELY( !SUFFIX(fd_base58_private_decode_intermediate)( encoded, intermediate ) ) ) return NULL;
 
   /* Using the table, convert to overcomplete base 2^32 (terms can be
      larger than 2^32).  We need to be careful about overflow.
@@ -368,33 +444,164 @@ SUFFIX(fd_base58_decode)( char const * encoded,
     binary[ i     ] &= 0xFFFFFFFFUL;
   }
 
-  /* If the largest term is 2^32 or bigger, it means N is larger than
-     what can fit in BYTE_CNT bytes.  This can be triggered, by passing
-     a base58 string of all 'z's for example. */
+  return SUFFIX(fd_base58_private_decode_finish)( encoded, binary, out );
+}
 
-  if( FD_UNLIKELY( binary[ 0UL ] > 0xFFFFFFFFUL ) ) return NULL;
+#if FD_HAS_AVX
 
-  /* Convert each term to big endian for the final output */
+/* fd_base58_private_encode_x4_{N} converts the 4 N byte numbers stored
+   contiguously at bytes to base58, writing the k-th cstr to
+   out+k*FD_BASE58_ENCODED_{N}_SZ and its length to opt_len[k] (if
+   opt_len is non-NULL).  This does the same math as fd_base58_encode_{N}
+   but the conversion to the intermediate form is done for all 4
+   numbers at once, with the k-th number in lane k of each vector.
+   That replaces the 64b x 64b -> 128b magic multiplications of the
+   reduction, which are inherently scalar, with div_58_5. */
+
+static inline void
+SUFFIX(fd_base58_private_encode_x4)( uchar const * bytes,
+                                     ulong *       opt_len,
+                                     char *        out ) {
+
+  ulong in_leading_0s[ 4 ];
+  for( ulong k=0UL; k<4UL; k++ ) in_leading_0s[ k ] = SUFFIX(fd_base58_private_leading_0s)( bytes+k*BYTE_CNT );
+
+  /* limb[i][k] is the i-th 32-bit limb of the k-th number */
+
+  uint W_ATTR limb[ BINARY_SZ ][ 4 ];
+  for( ulong k=0UL; k<4UL; k++ ) {
+    uint const * bytes_as_uint = (uint const *)(bytes+k*BYTE_CNT);
+    for( ulong i=0UL; i<BINARY_SZ; i++ ) limb[ i ][ k ] = fd_uint_bswap( bytes_as_uint[ i ] );
+  }
+
+  /* Same overflow analysis as the scalar version, lane by lane.
+     enc_table[i][j] is 0 for j<i, so those products are skipped. */
+
+  wl_t intermediate[ INTERMEDIATE_SZ_W_PADDING ];
+  for( ulong j=0UL; j<INTERMEDIATE_SZ_W_PADDING; j++ ) intermediate[ j ] = wl_zero();
 
-  uint * out_as_uint = (uint*)out;
   for( ulong i=0UL; i<BINARY_SZ; i++ ) {
-    out_as_uint[ i ] = fd_uint_bswap( (uint)binary[ i ] );
+    wl_t binary = _mm256_cvtepu32_epi64( _mm_load_si128( (__m128i const *)limb[ i ] ) );
+    for( ulong j=i; j<INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] = wl_add( intermediate[ j+1UL ],
+                                      _mm256_mul_epu32( binary, wl_bcast( (long)SUFFIX(enc_table)[ i ][ j ] ) ) );
+#   if N==64
+    if( i==7UL ) { /* Mini-reduction */
+      wl_t rem;
+      intermediate[ 15 ] = wl_add( intermediate[ 15 ], div_58_5( intermediate[ 16 ], &rem ) );
+      intermediate[ 16 ] = rem;
+    }
+#   endif
   }
-  /* Make sure the encoded version has the same number of leading '1's
-     as the decoded version has leading 0s. The check doesn't read past
-     the end of encoded, because '\0' != '1', so it will return NULL. */
 
-  ulong leading_zero_cnt = 0UL;
-  for( ; leading_zero_cnt<BYTE_CNT; leading_zero_cnt++ ) {
-    if( out[ leading_zero_cnt ] ) break;
-    if( FD_UNLIKELY( encoded[ leading_zero_cnt ] != '1' ) ) return NULL;
+  for( ulong i=INTERMEDIATE_SZ-1UL; i>0UL; i-- ) {
+    wl_t rem;
+    intermediate[ i-1UL ] = wl_add( intermediate[ i-1UL ], div_58_5( intermediate[ i ], &rem ) );
+    intermediate[ i     ] = rem;
   }
-  if( FD_UNLIKELY( encoded[ leading_zero_cnt ] == '1' ) ) return NULL;
+
+  /* Transpose back to one row of terms per number and finish each one
+     like the scalar version does. */
+
+  ulong W_ATTR row[ 4 ][ INTERMEDIATE_SZ_W_PADDING ];
+  for( ulong j=0UL; j<INTERMEDIATE_SZ_W_PADDING; j+=4UL ) {
+    wl_t c0, c1, c2, c3;
+    wl_transpose_4x4( intermediate[ j ], intermediate[ j+1UL ], intermediate[ j+2UL ], intermediate[ j+3UL ], c0, c1, c2, c3 );
+    wl_st( (long *)row[ 0 ]+j, c0 );
+    wl_st( (long *)row[ 1 ]+j, c1 );
+    wl_st( (long *)row[ 2 ]+j, c2 );
+    wl_st( (long *)row[ 3 ]+j, c3 );
+  }
+
+  for( ulong k=0UL; k<4UL; k++ )
+    SUFFIX(fd_base58_private_encode_finish)( row[ k ], in_leading_0s[ k ], opt_len ? opt_len+k : NULL, out+k*ENCODED_SZ() );
+}
+
+/* fd_base58_private_decode_x4_{N} decodes the 4 cstrs encoded[k] to
+   out+k*N, doing the conversion out of the intermediate form for all 4
+   at once as above.  Returns 1 on success and 0 if any of them is
+   invalid. */
+
+static inline int
+SUFFIX(fd_base58_private_decode_x4)( char const * const * encoded,
+                                     uchar *              out ) {
+
+  uint W_ATTR limb[ INTERMEDIATE_SZ ][ 4 ];
+  for( ulong k=0UL; k<4UL; k++ ) {
+    ulong intermediate[ INTERMEDIATE_SZ ];
+    if( FD_UNLIKELY( !SUFFIX(fd_base58_private_decode_intermediate)( encoded[ k ], intermediate ) ) ) return 0;
+    for( ulong i=0UL; i<INTERMEDIATE_SZ; i++ ) limb[ i ][ k ] = (uint)intermediate[ i ]; /* < 58^5 */
+  }
+
+  /* Same overflow analysis as the scalar version, lane by lane */
+
+  wl_t intermediate[ INTERMEDIATE_SZ ];
+  for( ulong i=0UL; i<INTERMEDIATE_SZ; i++ ) intermediate[ i ] = _mm256_cvtepu32_epi64( _mm_load_si128( (__m128i const *)limb[ i ] ) );
+
+  wl_t binary[ BINARY_SZ ];
+  for( ulong j=0UL; j<BINARY_SZ; j++ ) {
+    wl_t acc = wl_zero();
+    for( ulong i=0UL; i<INTERMEDIATE_SZ; i++ )
+      acc = wl_add( acc, _mm256_mul_epu32( intermediate[ i ], wl_bcast( (long)SUFFIX(dec_table)[ i ][ j ] ) ) );
+    binary[ j ] = acc;
+  }
+
+  wl_t mask = wl_bcast( (long)0xFFFFFFFFUL );
+  for( ulong i=BINARY_SZ-1UL; i>0UL; i-- ) {
+    binary[ i-1UL ] = wl_add( binary[ i-1UL ], wl_shru( binary[ i ], 32 ) );
+    binary[ i     ] = wl_and( binary[ i ], mask );
+  }
+
+  ulong W_ATTR row[ 4 ][ BINARY_SZ ];
+  for( ulong j=0UL; j<BINARY_SZ; j+=4UL ) {
+    wl_t c0, c1, c2, c3;
+    wl_transpose_4x4( binary[ j ], binary[ j+1UL ], binary[ j+2UL ], binary[ j+3UL ], c0, c1, c2, c3 );
+    wl_st( (long *)row[ 0 ]+j, c0 );
+    wl_st( (long *)row[ 1 ]+j, c1 );
+    wl_st( (long *)row[ 2 ]+j, c2 );
+    wl_st( (long *)row[ 3 ]+j, c3 );
+  }
+
+  for( ulong k=0UL; k<4UL; k++ )
+    if( FD_UNLIKELY( !SUFFIX(fd_base58_private_decode_finish)( encoded[ k ], row[ k ], out+k*BYTE_CNT ) ) ) return 0;
+  return 1;
+}
+
+#endif /* FD_HAS_AVX */
+
+char *
+BATCH(fd_base58_encode)( uchar const * bytes,
+                         ulong         cnt,
+                         ulong *       opt_len,
+                         char *        out ) {
+  ulong i = 0UL;
+#if FD_HAS_AVX
+  for( ; i+4UL<=cnt; i+=4UL )
+    SUFFIX(fd_base58_private_encode_x4)( bytes+i*BYTE_CNT, opt_len ? opt_len+i : NULL, out+i*ENCODED_SZ() );
+#endif
+  for( ; i<cnt; i++ )
+    SUFFIX(fd_base58_encode)( bytes+i*BYTE_CNT, opt_len ? opt_len+i : NULL, out+i*ENCODED_SZ() );
+  return out;
+}
+
+uchar *
+BATCH(fd_base58_decode)( char const * const * encoded,
+                         ulong                cnt,
+                         uchar *              out ) {
+  ulong i = 0UL;
+#if FD_HAS_AVX
+  for( ; i+4UL<=cnt; i+=4UL )
+    if( FD_UNLIKELY( !SUFFIX(fd_base58_private_decode_x4)( encoded+i, out+i*BYTE_CNT ) ) ) return NULL;
+#endif
+  for( ; i<cnt; i++ )
+    if( FD_UNLIKELY( !SUFFIX(fd_base58_decode)( encoded[ i ], out+i*BYTE_CNT ) ) ) return NULL;
   return out;
 }
 
+#undef INTERMEDIATE_SZ_W_PADDING
 #undef RAW58_SZ
 #undef ENCODED_SZ
+#undef BATCH
 #undef SUFFIX
 
 #undef BINARY_SZ
@@ -535,6 +535,122 @@ MAKE_TESTS(64,64    )
 
 #undef MAKE_TESTS
 
+/* test_batch{n} checks the batch conversions against the single ones
+   for random batch sizes (covering both the 4-wide and the remainder
+   path) and numbers with random amounts of leading zeros. */
+
+#define BATCH_MAX (19UL)
+
+#define MAKE_BATCH_TESTS(n)                                                                          \
+static void                                                                                          \
+test_batch##n( fd_rng_t * rng,                                                                       \
+               ulong      iter_cnt ) {                                                               \
+  static uchar bytes   [ BATCH_MAX*n ];                                                              \
+  static uchar bytes2  [ BATCH_MAX*n ];                                                              \
+  static char  buf     [ BATCH_MAX*FD_BASE58_ENCODED_##n##_SZ ];                                     \
+  static char  buf_ref [ FD_BASE58_ENCODED_##n##_SZ ];                                               \
+  char const * encoded [ BATCH_MAX ];                                                                \
+  ulong        len     [ BATCH_MAX ];                                                                \
+                                                                                                     \
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {                                                     \
+    ulong cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );                                             \
+    for( ulong i=0UL; i<cnt*n; i++ ) bytes[ i ] = fd_rng_uchar( rng );                               \
+    for( ulong i=0UL; i<cnt; i++ ) {                                                                 \
+      if( fd_rng_uint_roll( rng, 4U ) ) continue;                                                    \
+      fd_memset( bytes+i*n, 0, fd_rng_ulong_roll( rng, n+1UL ) );                                    \
+    }                                                                                                \
+                                                                                                     \
+    FD_TEST( fd_base58_encode_##n##_batch( bytes, cnt, len, buf )==buf );                            \
+    for( ulong i=0UL; i<cnt; i++ ) {                                                                 \
+      ulong len_ref;                                                                                 \
+      fd_base58_encode_##n( bytes+i*n, &len_ref, buf_ref );                                          \
+      char const * str = buf+i*FD_BASE58_ENCODED_##n##_SZ;                                           \
+      FD_TEST( !strcmp( str, buf_ref ) );                                                            \
+      FD_TEST( len[ i ]==len_ref );                                                                  \
+      encoded[ i ] = str;                                                                            \
+    }                                                                                                \
+    FD_TEST( fd_base58_encode_##n##_batch( bytes, cnt, NULL, buf )==buf );                           \
+                                                                                                     \
+    FD_TEST( fd_base58_decode_##n##_batch( encoded, cnt, bytes2 )==bytes2 );                         \
+    FD_TEST( !memcmp( bytes, bytes2, cnt*n ) );                                                      \
+                                                                                                     \
+    /* Corrupt one of the strings */                                                                 \
+    if( cnt ) {                                                                                      \
+      ulong i   = fd_rng_ulong_roll( rng, cnt );                                                     \
+      char * str = buf+i*FD_BASE58_ENCODED_##n##_SZ;                                                 \
+      str[ fd_rng_ulong_roll( rng, len[ i ] ) ] = '0';                                               \
+      FD_TEST( !fd_base58_decode_##n##_batch( encoded, cnt, bytes2 ) );                              \
+    }                                                                                                \
+  }                                                                                                  \
+                                                                                                     \
+  /* Extremes (all zero and all ones) */                                                             \
+  for( ulong fill=0UL; fill<2UL; fill++ ) {                                                          \
+    fd_memset( bytes, fill ? 0xFF : 0x00, BATCH_MAX*n );                                             \
+    fd_base58_encode_##n##_batch( bytes, BATCH_MAX, len, buf );                                      \
+    fd_base58_encode_##n( bytes, NULL, buf_ref );                                                    \
+    for( ulong i=0UL; i<BATCH_MAX; i++ ) {                                                           \
+      encoded[ i ] = buf+i*FD_BASE58_ENCODED_##n##_SZ;                                               \
+      FD_TEST( !strcmp( encoded[ i ], buf_ref ) );                                                   \
+    }                                                                                                \
+    FD_TEST( fd_base58_decode_##n##_batch( encoded, BATCH_MAX, bytes2 )==bytes2 );                   \
+    FD_TEST( !memcmp( bytes, bytes2, BATCH_MAX*n ) );                                                \
+  }                                                                                                  \
+}                                                                                                    \
+                                                                                                     \
+static void                                                                                          \
+test_batch_performance##n( fd_rng_t * rng ) {                                                        \
+  ulong const test_count = 1000UL;                                                                   \
+  ulong const batch_cnt  = 16UL;                                                                     \
+  static uchar bytes[ 16UL*n ];                                                                      \
+  static char  buf  [ 16UL*FD_BASE58_ENCODED_##n##_SZ ];                                             \
+  char const * encoded[ 16UL ];                                                                      \
+  for( ulong i=0UL; i<batch_cnt*n; i++ ) bytes[ i ] = fd_rng_uchar( rng );                           \
+  for( ulong i=0UL; i<batch_cnt; i++ ) encoded[ i ] = buf+i*FD_BASE58_ENCODED_##n##_SZ;              \
+                                                                                                     \
+  /* Warm up instruction cache */                                                                    \
+  fd_base58_encode_##n##_batch( bytes, batch_cnt, NULL, buf );                                       \
+  fd_base58_decode_##n##_batch( encoded, batch_cnt, bytes );                                         \
+                                                                                                     \
+  long single = -fd_log_wallclock();                                                                 \
+  for( ulong i=0UL; i<test_count; i++ ) {                                                            \
+    for( ulong j=0UL; j<batch_cnt; j++ ) fd_base58_encode_##n( bytes+j*n, NULL, (char *)encoded[ j ] ); \
+    FD_COMPILER_MFENCE();                                                                            \
+  }                                                                                                  \
+  single += fd_log_wallclock();                                                                      \
+                                                                                                     \
+  long batch = -fd_log_wallclock();                                                                  \
+  for( ulong i=0UL; i<test_count; i++ ) {                                                            \
+    fd_base58_encode_##n##_batch( bytes, batch_cnt, NULL, buf );                                     \
+    FD_COMPILER_MFENCE();                                                                            \
+  }                                                                                                  \
+  batch += fd_log_wallclock();                                                                       \
+                                                                                                     \
+  long single_decode = -fd_log_wallclock();                                                          \
+  for( ulong i=0UL; i<test_count; i++ ) {                                                            \
+    for( ulong j=0UL; j<batch_cnt; j++ ) FD_TEST( fd_base58_decode_##n( encoded[ j ], bytes+j*n ) ); \
+    FD_COMPILER_MFENCE();                                                                            \
+  }                                                                                                  \
+  single_decode += fd_log_wallclock();                                                               \
+                                                                                                     \
+  long batch_decode = -fd_log_wallclock();                                                           \
+  for( ulong i=0UL; i<test_count; i++ ) {                                                            \
+    FD_TEST( fd_base58_decode_##n##_batch( encoded, batch_cnt, bytes ) );                            \
+    FD_COMPILER_MFENCE();                                                                            \
+  }                                                                                                  \
+  batch_decode += fd_log_wallclock();                                                                \
+                                                                                                     \
+  double norm = 1. / (double)(test_count*batch_cnt);                                                 \
+  FD_LOG_NOTICE(( "average time per encode: single %f ns, batch %f ns", (double)single*norm, (double)batch*norm )); \
+  FD_LOG_NOTICE(( "average time per decode: single %f ns, batch %f ns",                              \
+                  (double)single_decode*norm, (double)batch_decode*norm ));                          \
+}
+
+MAKE_BATCH_TESTS(32)
+MAKE_BATCH_TESTS(64)
+
+#undef MAKE_BATCH_TESTS
+#undef BATCH_MAX
+
 #if FD_HAS_AVX
 
 #include "fd_base58_avx.h"
@@ -645,6 +761,31 @@ test_intermediate_to_raw( void ) {
   }
 }
 
+static void
+test_div_58_5( fd_rng_t * rng ) {
+  ulong const r1div = 656356768UL; /* 58^5 */
+  ulong x[ 4 ] __attribute__((aligned(32)));
+  ulong q[ 4 ] __attribute__((aligned(32)));
+  ulong r[ 4 ] __attribute__((aligned(32)));
+  for( ulong iter=0UL; iter<1000000UL; iter++ ) {
+    for( ulong k=0UL; k<4UL; k++ ) {
+      switch( fd_rng_uint_roll( rng, 4U ) ) {
+      case 0U: x[ k ] = fd_rng_ulong( rng );                                       break;
+      case 1U: x[ k ] = fd_rng_ulong( rng ) >> fd_rng_uint_roll( rng, 64U );       break;
+      case 2U: x[ k ] = r1div*fd_rng_ulong_roll( rng, ULONG_MAX/r1div+1UL ) - 1UL; break; /* just below a multiple */
+      default: x[ k ] = ULONG_MAX - fd_rng_ulong_roll( rng, r1div );               break;
+      }
+    }
+    wl_t rem;
+    wl_st( (long *)q, div_58_5( wl_ld( (long const *)x ), &rem ) );
+    wl_st( (long *)r, rem );
+    for( ulong k=0UL; k<4UL; k++ ) {
+      FD_TEST( q[ k ]==x[ k ]/r1div );
+      FD_TEST( r[ k ]==x[ k ]%r1div );
+    }
+  }
+}
+
 static void
 test_ten_per_slot_down( void ) {
 
@@ -709,6 +850,7 @@ main( int     argc,
   test_raw_to_base58();
   test_count_leading_zeros();
   test_ten_per_slot_down();
+  test_div_58_5( rng );
 # endif
 
   FD_LOG_NOTICE(( "Testing reference 256-bit conversion" ));
@@ -734,6 +876,8 @@ main( int     argc,
   test_sample32();
   test_match32( rng, cnt );
   test_performance32( rng );
+  test_batch32( rng, cnt/10UL );
+  test_batch_performance32( rng );
 
   FD_LOG_NOTICE(( "Testing 512-bit conversion" ));
   test_encode_basic64();
@@ -742,6 +886,8 @@ main( int     argc,
   test_sample64();
   test_match64( rng, cnt );
   test_performance64( rng );
+  test_batch64( rng, cnt/10UL );
+  test_batch_performance64( rng );
 
   fd_rng_delete( fd_rng_leave( rng ) );
 
@@ -1,3 +1,4 @@
 $(call add-hdrs,fd_bmtree.h)
 $(call make-unit-test,test_bmtree,test_bmtree,fd_ballet fd_util)
+$(call make-unit-test,bench_bmtree,bench_bmtree,fd_ballet fd_util)
 $(call run-unit-test,test_bmtree)
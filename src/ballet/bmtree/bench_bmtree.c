@@ -0,0 +1,97 @@
+#include "../fd_ballet.h"
+
+/* bench_bmtree benchmarks computing the root of binary Merkle trees
+   with leaf counts from 2 to 2^16 by streaming the leaves one at a time
+   (fd_bmtree*_hash_leaf + fd_bmtree*_commit_{init,append,fini}) and
+   by hashing the leaves and then each layer in batches
+   (fd_bmtree*_hash_leaf_batch + fd_bmtree*_commit_batch), checking that
+   both produce the same roots.  The 20-byte variant is run with
+   shred-sized leaf blobs (as in Merkle shred FEC sets) and the 32-byte
+   variant with hash-sized leaf blobs (as in trees over entries). */
+
+#define LEAF_MAX    (1UL<<16)
+#define BLOB_CNT    (1024UL)  /* Leaf blobs are cycled through a pool of this many */
+#define BLOB_SZ_MAX (1232UL)
+
+static uchar        blob   [ BLOB_CNT ][ BLOB_SZ_MAX ];
+static void const * data   [ LEAF_MAX ];
+static ulong        data_sz[ LEAF_MAX ];
+
+static fd_bmtree20_node_t node20[ LEAF_MAX ];
+static fd_bmtree32_node_t node32[ LEAF_MAX ];
+
+#define BENCH_BMTREE(bmt,node,hash_sz)                                                                     \
+static void                                                                                                \
+bench_##bmt( ulong leaf_cnt,                                                                               \
+             ulong blob_sz,                                                                                \
+             ulong iter_max ) {                                                                            \
+  for( ulong i=0UL; i<leaf_cnt; i++ ) { data[i] = blob[ i % BLOB_CNT ]; data_sz[i] = blob_sz; }            \
+                                                                                                           \
+  bmt##_commit_t _commit[1];                                                                               \
+  uchar          expected[ 32 ];                                                                           \
+  uchar const *  root = NULL;                                                                              \
+                                                                                                           \
+  /* Streaming */                                                                                          \
+  long dt_stream = 0L;                                                                                     \
+  for( ulong iter=0UL; iter<iter_max+1UL; iter++ ) { /* first iteration is warmup */                      \
+    long dt = -fd_log_wallclock();                                                                         \
+    bmt##_commit_t * commit = bmt##_commit_init( _commit );                                                \
+    for( ulong i=0UL; i<leaf_cnt; i++ ) {                                                                  \
+      bmt##_node_t leaf[1];                                                                                \
+      bmt##_hash_leaf( leaf, data[i], data_sz[i] );                                                        \
+      bmt##_commit_append( commit, leaf, 1UL );                                                            \
+    }                                                                                                      \
+    root = bmt##_commit_fini( commit );                                                                    \
+    dt += fd_log_wallclock();                                                                              \
+    if( iter ) dt_stream += dt;                                                                            \
+  }                                                                                                        \
+  fd_memcpy( expected, root, hash_sz );                                                                    \
+                                                                                                           \
+  /* Batched */                                                                                            \
+  long dt_batch = 0L;                                                                                      \
+  for( ulong iter=0UL; iter<iter_max+1UL; iter++ ) {                                                       \
+    long dt = -fd_log_wallclock();                                                                         \
+    bmt##_hash_leaf_batch( node, data, data_sz, leaf_cnt );                                                \
+    root = bmt##_commit_batch( node, leaf_cnt );                                                           \
+    dt += fd_log_wallclock();                                                                              \
+    if( iter ) dt_batch += dt;                                                                             \
+    if( FD_UNLIKELY( memcmp( root, expected, hash_sz ) ) ) FD_LOG_ERR(( "FAIL (leaf_cnt %lu)", leaf_cnt )); \
+  }                                                                                                        \
+                                                                                                           \
+  float leaf_tot = (float)(iter_max*leaf_cnt);                                                             \
+  FD_LOG_NOTICE(( #bmt " leaf_cnt %6lu (%4lu B leaves): stream %8.3f ns/leaf, batch %8.3f ns/leaf (%.2fx)", \
+                  leaf_cnt, blob_sz,                                                                       \
+                  (double)((float)dt_stream/leaf_tot), (double)((float)dt_batch/leaf_tot),                 \
+                  (double)((float)dt_stream/(float)dt_batch) ));                                           \
+}
+
+BENCH_BMTREE( fd_bmtree20, node20, 20UL )
+BENCH_BMTREE( fd_bmtree32, node32, 32UL )
+
+#undef BENCH_BMTREE
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong leaf_tot = fd_env_strip_cmdline_ulong( &argc, &argv, "--leaf-tot", NULL, 1UL<<18 ); /* (opt) leaves hashed per tree size */
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong i=0UL; i<BLOB_CNT; i++ ) for( ulong b=0UL; b<BLOB_SZ_MAX; b++ ) blob[i][b] = fd_rng_uchar( rng );
+
+  for( ulong leaf_cnt=2UL; leaf_cnt<=LEAF_MAX; leaf_cnt<<=1 ) {
+    ulong iter_max = fd_ulong_max( leaf_tot / leaf_cnt, 1UL );
+    bench_fd_bmtree20( leaf_cnt, BLOB_SZ_MAX, iter_max );
+  }
+
+  for( ulong leaf_cnt=2UL; leaf_cnt<=LEAF_MAX; leaf_cnt<<=1 ) {
+    ulong iter_max = fd_ulong_max( leaf_tot / leaf_cnt, 1UL );
+    bench_fd_bmtree32( leaf_cnt, 32UL, iter_max );
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -18,6 +18,7 @@
      typedef struct bmt_node bmt_node_t;
 
      bmt_node_t * bmtree_hash_leaf( bmt_node_t * node, void const * data, ulong data_sz );
+     void         bmt_hash_leaf_batch( bmt_node_t * node, void const * const * data, ulong const * data_sz, ulong cnt );
 
      // Public commit API
 
@@ -30,6 +31,16 @@
      ulong          bmt_commit_leaf_cnt ( bmt_commit_t const * bmt );
      bmt_commit_t * bmt_commit_append   ( bmt_commit_t * bmt, bmt_node_t const * leaf, ulong leaf_cnt );
      uchar *        bmt_commit_fini     ( bmt_commit_t * bmt );
+     uchar *        bmt_commit_batch    ( bmt_node_t * leaf, ulong leaf_cnt );
+
+     // Public tree / inclusion proof API
+
+     ulong   bmt_tree_align    ( void );
+     ulong   bmt_tree_footprint( ulong leaf_cnt );
+     uchar * bmt_tree_build    ( bmt_node_t * tree, ulong leaf_cnt );
+     ulong   bmt_tree_proof    ( bmt_node_t const * tree, ulong leaf_cnt, ulong leaf_idx, uchar * proof );
+     uchar * bmt_proof_root    ( bmt_node_t * root, bmt_node_t const * leaf, ulong leaf_idx, uchar const * proof, ulong proof_cnt );
+     int     bmt_proof_verify  ( uchar const * root, bmt_node_t const * leaf, ulong leaf_idx, uchar const * proof, ulong proof_cnt );
 
    See comments below for more details.
 
@@ -56,7 +67,6 @@
         (node) -> (node)
 
    Example derived methods.
-   (TODO not all of them are provided by this header file yet)
 
      4. Construct full tree:
 
@@ -154,7 +164,14 @@
 
      - Single inclusion proofs (over one leaf node)
      - Range inclusion proofs (over a contiguous range of leaf nodes)
-     - Sparse inclusion proofs (over an arbitrary subset of leaf nodes) */
+     - Sparse inclusion proofs (over an arbitrary subset of leaf nodes)
+
+   Only single inclusion proofs are provided currently.  A proof for
+   leaf i of a tree with depth d is the d-1 sibling nodes on the path
+   from leaf i to the root, bottom layer first (when a node is the last
+   node of a layer with an odd number of nodes, its sibling is itself).
+   The proof nodes are packed back to back, BMTREE_HASH_SZ bytes each
+   (this matches the proof layout in Solana Merkle shreds). */
 
 #include "../sha256/fd_sha256.h"
 
@@ -293,6 +310,54 @@ BMTREE_(hash_leaf)( BMTREE_(node_t) * node,
   return node;
 }
 
+/* BMTREE_BATCH_{CNT,LEAF_SCRATCH_SZ} give the maximum number of hashes
+   and the maximum number of leaf preimage bytes handed to
+   fd_sha256_batch_hash at a time by the batched APIs below.  (These
+   determine the stack footprint of those APIs.) */
+
+#ifndef BMTREE_BATCH_CNT
+#define BMTREE_BATCH_CNT             (64UL)
+#define BMTREE_BATCH_LEAF_SCRATCH_SZ (16384UL)
+#endif
+
+/* bmtree_hash_leaf_batch computes node[i] = bmtree_hash_leaf( data[i],
+   data_sz[i] ) for i in [0,cnt) with fd_sha256_batch_hash.  The leaf
+   prefixes are prepended by copying the leaf blobs into a scratch
+   buffer (leaves too large for the scratch are hashed individually).
+   Same restrictions as bmtree_hash_leaf. */
+
+FD_FN_UNUSED static void /* Work around -Winline */
+BMTREE_(hash_leaf_batch)( BMTREE_(node_t) *    node,
+                          void const * const * data,
+                          ulong const *        data_sz,
+                          ulong                cnt ) {
+  uchar        scratch[ BMTREE_BATCH_LEAF_SCRATCH_SZ ];
+  void const * batch_data[ BMTREE_BATCH_CNT ];
+  ulong        batch_sz  [ BMTREE_BATCH_CNT ];
+  void *       batch_hash[ BMTREE_BATCH_CNT ];
+
+  ulong batch_cnt  = 0UL;
+  ulong scratch_sz = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    ulong sz = 1UL + data_sz[i];
+    if( FD_UNLIKELY( sz>BMTREE_BATCH_LEAF_SCRATCH_SZ ) ) { BMTREE_(hash_leaf)( node+i, data[i], data_sz[i] ); continue; }
+    if( FD_UNLIKELY( (batch_cnt==BMTREE_BATCH_CNT) | (scratch_sz+sz>BMTREE_BATCH_LEAF_SCRATCH_SZ) ) ) {
+      fd_sha256_batch_hash( batch_data, batch_sz, batch_hash, batch_cnt );
+      batch_cnt  = 0UL;
+      scratch_sz = 0UL;
+    }
+    uchar * preimage = scratch + scratch_sz;
+    preimage[0] = (uchar)0;
+    fd_memcpy( preimage+1UL, data[i], data_sz[i] );
+    batch_data[ batch_cnt ] = preimage;
+    batch_sz  [ batch_cnt ] = sz;
+    batch_hash[ batch_cnt ] = node[i].hash;
+    batch_cnt++;
+    scratch_sz += sz;
+  }
+  if( FD_LIKELY( batch_cnt ) ) fd_sha256_batch_hash( batch_data, batch_sz, batch_hash, batch_cnt );
+}
+
 /* bmtree_merge computes `SHA-256([0x01]|a->hash|b->hash)` and writes
    the (truncated as necessary) result into node->hash.  In-place
    operation fine.  Returns node. */
@@ -366,6 +431,41 @@ BMTREE_(private_merge)( BMTREE_(node_t)       * node,
   return node;
 }
 
+/* bmtree_private_merge_layer computes the layer above the layer_cnt
+   nodes at layer (layer_cnt>1) with fd_sha256_batch_hash and stores the
+   (layer_cnt+1)/2 results at next.  next==layer is fine (the preimages
+   of a batch are copied out before its hashes are written and the
+   results of a batch never clobber nodes needed by a later batch).
+   Other overlap is not. */
+
+FD_FN_UNUSED static void /* Work around -Winline */
+BMTREE_(private_merge_layer)( BMTREE_(node_t) *       next,
+                              BMTREE_(node_t) const * layer,
+                              ulong                   layer_cnt ) {
+  uchar        scratch[ BMTREE_BATCH_CNT ][ 1UL+2UL*BMTREE_HASH_SZ ];
+  void const * batch_data[ BMTREE_BATCH_CNT ];
+  ulong        batch_sz  [ BMTREE_BATCH_CNT ];
+  void *       batch_hash[ BMTREE_BATCH_CNT ];
+
+  ulong next_cnt = (layer_cnt+1UL) >> 1;
+  for( ulong next_idx0=0UL; next_idx0<next_cnt; next_idx0+=BMTREE_BATCH_CNT ) {
+    ulong batch_cnt = fd_ulong_min( next_cnt-next_idx0, BMTREE_BATCH_CNT );
+    for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+      ulong   next_idx = next_idx0 + batch_idx;
+      ulong   l        = 2UL*next_idx;
+      ulong   r        = fd_ulong_min( l+1UL, layer_cnt-1UL ); /* Last node of an odd layer has one child */
+      uchar * preimage = scratch[ batch_idx ];
+      preimage[0] = (uchar)1;
+      fd_memcpy( preimage+1UL,                layer[l].hash, BMTREE_HASH_SZ );
+      fd_memcpy( preimage+1UL+BMTREE_HASH_SZ, layer[r].hash, BMTREE_HASH_SZ );
+      batch_data[ batch_idx ] = preimage;
+      batch_sz  [ batch_idx ] = 1UL+2UL*BMTREE_HASH_SZ;
+      batch_hash[ batch_idx ] = next[ next_idx ].hash;
+    }
+    fd_sha256_batch_hash( batch_data, batch_sz, batch_hash, batch_cnt );
+  }
+}
+
 /* bmtree_depth returns the number of layers in a binary Merkle tree. */
 
 FD_FN_CONST static inline ulong
@@ -495,6 +595,145 @@ BMTREE_(commit_fini)( BMTREE_(commit_t) * state ) {
   return root->hash;
 }
 
+/* bmtree_commit_batch computes the root of the tree whose leaves are
+   the leaf_cnt nodes at leaf.  Assumes leaf_cnt is positive.  This
+   produces the same root as bmtree_commit_{init,append,fini} but,
+   instead of streaming the leaves, hashes the tree a layer at a time
+   in place with fd_sha256_batch_hash (so all the leaves need to be
+   available up front).  The leaves are clobbered.  Returns a pointer to
+   the root hash (leaf[0].hash). */
+
+static inline uchar *
+BMTREE_(commit_batch)( BMTREE_(node_t) * leaf,
+                       ulong             leaf_cnt ) {
+  for( ulong layer_cnt=leaf_cnt; layer_cnt>1UL; layer_cnt=(layer_cnt+1UL)>>1 )
+    BMTREE_(private_merge_layer)( leaf, leaf, layer_cnt );
+  return leaf->hash;
+}
+
+/* bmtree_tree_{align,footprint} return the alignment and footprint
+   required for a memory region to hold all the nodes of a tree with
+   leaf_cnt leaves.  The layers are stored contiguously, the leaf layer
+   first and the root last.  footprint returns 0 if leaf_cnt is 0. */
+
+FD_FN_CONST static inline ulong
+BMTREE_(private_node_cnt)( ulong leaf_cnt ) {
+  ulong node_cnt = (ulong)(leaf_cnt>0UL); /* root */
+  for( ulong layer_cnt=leaf_cnt; layer_cnt>1UL; layer_cnt=(layer_cnt+1UL)>>1 ) node_cnt += layer_cnt;
+  return node_cnt;
+}
+
+FD_FN_CONST static inline ulong BMTREE_(tree_align)    ( void )           { return alignof(BMTREE_(node_t)); }
+FD_FN_CONST static inline ulong BMTREE_(tree_footprint)( ulong leaf_cnt ) { return BMTREE_(private_node_cnt)( leaf_cnt )*sizeof(BMTREE_(node_t)); }
+
+/* bmtree_tree_build computes all the branch nodes of a tree.  tree
+   points to a memory region with the tree alignment and footprint for
+   leaf_cnt leaves whose first leaf_cnt nodes hold the leaves (in
+   order).  Assumes leaf_cnt is positive.  On return, the branch layers
+   have been written to the region after the leaves and tree is ready
+   for use with bmtree_tree_proof.  Returns a pointer to the root hash
+   (the last node in the region).
+
+   Unlike bmtree_commit, this requires all the leaves up front and space
+   proportional to the number of leaves.  In exchange, the interior
+   nodes are retained (such that inclusion proofs can be extracted for
+   any leaf) and each layer is hashed in a single pass with
+   fd_sha256_batch_hash. */
+
+static inline uchar *
+BMTREE_(tree_build)( BMTREE_(node_t) * tree,
+                     ulong             leaf_cnt ) {
+  BMTREE_(node_t) * layer     = tree;
+  ulong             layer_cnt = leaf_cnt;
+  while( layer_cnt>1UL ) {
+    BMTREE_(node_t) * next = layer + layer_cnt;
+    BMTREE_(private_merge_layer)( next, layer, layer_cnt );
+    layer     = next;
+    layer_cnt = (layer_cnt+1UL) >> 1;
+  }
+  return layer->hash;
+}
+
+/* bmtree_tree_proof writes the inclusion proof for leaf leaf_idx of a
+   tree with leaf_cnt leaves built by bmtree_tree_build to proof.
+   Assumes leaf_idx<leaf_cnt and that proof has room for depth-1 nodes
+   of BMTREE_HASH_SZ bytes (at most 63*BMTREE_HASH_SZ bytes for any
+   practical tree).  Returns the number of nodes in the proof (i.e.
+   depth-1, 0 for a tree with 1 leaf). */
+
+static inline ulong
+BMTREE_(tree_proof)( BMTREE_(node_t) const * tree,
+                     ulong                   leaf_cnt,
+                     ulong                   leaf_idx,
+                     uchar *                 proof ) {
+  BMTREE_(node_t) const * layer     = tree;
+  ulong                   layer_cnt = leaf_cnt;
+  ulong                   idx       = leaf_idx;
+  ulong                   proof_cnt = 0UL;
+  while( layer_cnt>1UL ) {
+    ulong sibling_idx = fd_ulong_min( idx ^ 1UL, layer_cnt-1UL ); /* Last node of an odd layer is its own sibling */
+    fd_memcpy( proof + proof_cnt*BMTREE_HASH_SZ, layer[ sibling_idx ].hash, BMTREE_HASH_SZ );
+    proof_cnt++;
+    layer     += layer_cnt;
+    layer_cnt  = (layer_cnt+1UL) >> 1;
+    idx      >>= 1;
+  }
+  return proof_cnt;
+}
+
+/* bmtree_proof_root computes the root of the tree implied by an
+   inclusion proof for leaf at index leaf_idx.  proof points to
+   proof_cnt nodes packed BMTREE_HASH_SZ bytes each (unaligned fine),
+   bottom layer first.  On success, the root is stored in root and
+   returns a pointer to the root hash.  Returns NULL if the proof is not
+   well formed (leaf_idx isn't a valid index for a tree of depth
+   proof_cnt+1).  The caller should compare the result with the expected
+   root (see bmtree_proof_verify).  Costs proof_cnt merges and doesn't
+   need the leaf count. */
+
+static inline uchar *
+BMTREE_(proof_root)( BMTREE_(node_t) *       root,
+                     BMTREE_(node_t) const * leaf,
+                     ulong                   leaf_idx,
+                     uchar const *           proof,
+                     ulong                   proof_cnt ) {
+  if( FD_UNLIKELY( (proof_cnt<64UL) ? (leaf_idx>>proof_cnt) : 0UL ) ) return NULL;
+
+  BMTREE_(node_t) tmp[1];
+  BMTREE_(node_t) sibling[1];
+  *tmp = *leaf;
+  ulong idx = leaf_idx;
+  for( ulong proof_idx=0UL; proof_idx<proof_cnt; proof_idx++ ) {
+    fd_memcpy( sibling->hash, proof + proof_idx*BMTREE_HASH_SZ, BMTREE_HASH_SZ );
+    /* tmp is the right child if idx is odd.  We use fd_ulong_if to
+       encourage inlining of merge as above. */
+    int is_right = (int)(idx & 1UL);
+    BMTREE_(node_t) const * left  = (BMTREE_(node_t) const *)fd_ulong_if( is_right, (ulong)sibling, (ulong)tmp     ); /* cmov */
+    BMTREE_(node_t) const * right = (BMTREE_(node_t) const *)fd_ulong_if( is_right, (ulong)tmp,     (ulong)sibling ); /* cmov */
+    BMTREE_(private_merge)( tmp, left, right );
+    idx >>= 1;
+  }
+
+  *root = *tmp;
+  return root->hash;
+}
+
+/* bmtree_proof_verify returns 1 if the inclusion proof (as described in
+   bmtree_proof_root) shows that leaf is leaf leaf_idx of the tree whose
+   root hash is the BMTREE_HASH_SZ bytes pointed to by root and 0
+   otherwise. */
+
+FD_FN_UNUSED static int /* Work around -Winline */
+BMTREE_(proof_verify)( uchar const *           root,
+                       BMTREE_(node_t) const * leaf,
+                       ulong                   leaf_idx,
+                       uchar const *           proof,
+                       ulong                   proof_cnt ) {
+  BMTREE_(node_t) computed[1];
+  if( FD_UNLIKELY( !BMTREE_(proof_root)( computed, leaf, leaf_idx, proof, proof_cnt ) ) ) return 0;
+  return !memcmp( computed->hash, root, BMTREE_HASH_SZ );
+}
+
 FD_PROTOTYPES_END
 
 #undef BMTREE_
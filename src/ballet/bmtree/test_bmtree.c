@@ -59,6 +59,104 @@ test_bmtree20_commit( ulong        leaf_cnt,
                  leaf_cnt, FD_LOG_HEX20_FMT_ARGS( root ), FD_LOG_HEX20_FMT_ARGS( expected_root ) ));
 }
 
+/* Test inclusion proofs.  Builds trees of random leaves, checks the
+   root against the commit API, checks the proof of every leaf and that
+   corrupted proofs, leaves and indices are rejected. */
+
+#define TEST_PROOF_LEAF_MAX (300UL)
+
+#define TEST_BMTREE_PROOF(bmt,hash_sz)                                                                   \
+static void                                                                                              \
+test_##bmt##_proof( fd_rng_t * rng,                                                                      \
+                    ulong      leaf_cnt ) {                                                              \
+  static bmt##_node_t tree[ 2UL*TEST_PROOF_LEAF_MAX+64UL ];                                              \
+  FD_TEST( bmt##_tree_footprint( leaf_cnt )<=sizeof(tree) );                                             \
+  FD_TEST( fd_ulong_is_aligned( (ulong)tree, bmt##_tree_align() ) );                                     \
+                                                                                                         \
+  for( ulong i=0UL; i<leaf_cnt; i++ )                                                                    \
+    for( ulong j=0UL; j<32UL; j++ ) tree[i].hash[j] = fd_rng_uchar( rng );                               \
+                                                                                                         \
+  bmt##_commit_t _commit[1];                                                                             \
+  bmt##_commit_t * commit = bmt##_commit_init( _commit );                                                \
+  bmt##_commit_append( commit, tree, leaf_cnt );                                                         \
+  uchar * expected = bmt##_commit_fini( commit );                                                        \
+                                                                                                         \
+  static bmt##_node_t scratch[ TEST_PROOF_LEAF_MAX ];                                                    \
+  fd_memcpy( scratch, tree, leaf_cnt*sizeof(bmt##_node_t) );                                             \
+  FD_TEST( bmt##_commit_batch( scratch, leaf_cnt )==scratch->hash );                                     \
+  FD_TEST( !memcmp( scratch->hash, expected, hash_sz ) );                                                \
+                                                                                                         \
+  uchar * root = bmt##_tree_build( tree, leaf_cnt );                                                     \
+  FD_TEST( root==tree[ bmt##_tree_footprint( leaf_cnt )/sizeof(bmt##_node_t) - 1UL ].hash );             \
+  FD_TEST( !memcmp( root, expected, hash_sz ) );                                                         \
+                                                                                                         \
+  ulong depth = bmt##_private_depth( leaf_cnt );                                                         \
+  uchar proof[ 63UL*hash_sz ];                                                                           \
+  for( ulong leaf_idx=0UL; leaf_idx<leaf_cnt; leaf_idx++ ) {                                             \
+    ulong proof_cnt = bmt##_tree_proof( tree, leaf_cnt, leaf_idx, proof );                               \
+    FD_TEST( proof_cnt==depth-1UL );                                                                     \
+                                                                                                         \
+    bmt##_node_t computed[1];                                                                            \
+    FD_TEST( bmt##_proof_root( computed, tree+leaf_idx, leaf_idx, proof, proof_cnt )==computed->hash );  \
+    FD_TEST( !memcmp( computed->hash, root, hash_sz ) );                                                 \
+    FD_TEST( bmt##_proof_verify( root, tree+leaf_idx, leaf_idx, proof, proof_cnt ) );                    \
+                                                                                                         \
+    /* Index out of range for the proof depth */                                                         \
+    ulong bad_idx = leaf_idx | (1UL<<proof_cnt);                                                         \
+    FD_TEST( !bmt##_proof_root( computed, tree+leaf_idx, bad_idx, proof, proof_cnt ) );                  \
+                                                                                                         \
+    if( leaf_cnt<2UL ) continue;                                                                         \
+                                                                                                         \
+    /* Wrong leaf / wrong index / corrupted proof */                                                     \
+    ulong other_idx = (leaf_idx + 1UL + fd_rng_ulong_roll( rng, leaf_cnt-1UL )) % leaf_cnt;              \
+    if( memcmp( tree[ other_idx ].hash, tree[ leaf_idx ].hash, hash_sz ) )                               \
+      FD_TEST( !bmt##_proof_verify( root, tree+other_idx, leaf_idx, proof, proof_cnt ) );                \
+    FD_TEST( !bmt##_proof_verify( root, tree+leaf_idx, other_idx, proof, proof_cnt ) );                  \
+    ulong byte_idx = fd_rng_ulong_roll( rng, proof_cnt*hash_sz );                                        \
+    proof[ byte_idx ] = (uchar)(proof[ byte_idx ] ^ (1U << fd_rng_uint_roll( rng, 8U )));               \
+    FD_TEST( !bmt##_proof_verify( root, tree+leaf_idx, leaf_idx, proof, proof_cnt ) );                   \
+  }                                                                                                      \
+}
+
+TEST_BMTREE_PROOF( fd_bmtree20, 20UL )
+TEST_BMTREE_PROOF( fd_bmtree32, 32UL )
+
+#undef TEST_BMTREE_PROOF
+
+/* Test batched leaf hashing against hashing the leaves one at a time
+   (including leaves too large to be batched) */
+
+#define TEST_LEAF_MAX    (200UL)
+#define TEST_LEAF_SZ_MAX (20000UL)
+
+static uchar test_leaf_mem[ TEST_LEAF_MAX*TEST_LEAF_SZ_MAX ];
+
+static void
+test_hash_leaf_batch( fd_rng_t * rng ) {
+  void const *       data   [ TEST_LEAF_MAX ];
+  ulong              data_sz[ TEST_LEAF_MAX ];
+  fd_bmtree32_node_t node   [ TEST_LEAF_MAX ];
+  fd_bmtree32_node_t ref    [ TEST_LEAF_MAX ];
+
+  for( ulong i=0UL; i<TEST_LEAF_MAX*TEST_LEAF_SZ_MAX; i++ ) test_leaf_mem[i] = fd_rng_uchar( rng );
+
+  for( ulong iter=0UL; iter<100UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, TEST_LEAF_MAX+1UL );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      uint r = fd_rng_uint( rng );
+      data_sz[i] = (r & 15U) ? fd_rng_ulong_roll( rng, 1300UL ) : fd_rng_ulong_roll( rng, TEST_LEAF_SZ_MAX+1UL );
+      data   [i] = test_leaf_mem + i*TEST_LEAF_SZ_MAX;
+      fd_bmtree32_hash_leaf( ref+i, data[i], data_sz[i] );
+    }
+    fd_bmtree32_hash_leaf_batch( node, data, data_sz, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( !memcmp( node[i].hash, ref[i].hash, 32UL ) );
+
+    fd_bmtree20_node_t node20[ TEST_LEAF_MAX ];
+    fd_bmtree20_hash_leaf_batch( node20, data, data_sz, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( !memcmp( node20[i].hash, ref[i].hash, 20UL ) );
+  }
+}
+
 static void
 hash_leaf( fd_bmtree32_node_t * leaf,
            char const *         leaf_cstr ) {
@@ -102,6 +200,41 @@ main( int     argc,
   dt += fd_log_wallclock();
   FD_LOG_NOTICE(( "%.3f ns/leaf @ %lu leaves", (double)((float)dt / (float)bench_cnt), bench_cnt ));
 
+  /* Test inclusion proofs */
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_hash_leaf_batch( rng );
+
+  for( ulong leaf_cnt=1UL; leaf_cnt<=TEST_PROOF_LEAF_MAX; leaf_cnt++ ) {
+    test_fd_bmtree20_proof( rng, leaf_cnt );
+    test_fd_bmtree32_proof( rng, leaf_cnt );
+  }
+
+  /* Benchmark proof verification for a tree about the size of a Merkle
+     shred FEC set */
+
+  do {
+    static fd_bmtree20_node_t ptree[ 128UL ];
+    ulong pleaf_cnt = 64UL;
+    for( ulong i=0UL; i<pleaf_cnt; i++ ) FD_STORE( ulong, ptree[i].hash, i );
+    uchar const * proot = fd_bmtree20_tree_build( ptree, pleaf_cnt );
+    uchar proof[ 63UL*20UL ];
+    ulong proof_cnt = fd_bmtree20_tree_proof( ptree, pleaf_cnt, 37UL, proof );
+    ulong iter_cnt  = 100000UL;
+    int   ok        = 1;
+    dt = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+      FD_COMPILER_FORGET( proof_cnt );
+      ok &= fd_bmtree20_proof_verify( proot, ptree+37, 37UL, proof, proof_cnt );
+    }
+    dt += fd_log_wallclock();
+    FD_TEST( ok );
+    FD_LOG_NOTICE(( "%.3f ns/proof verify @ %lu leaves", (double)((float)dt / (float)iter_cnt), pleaf_cnt ));
+  } while(0);
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   /* Test 32-byte tree */
 
   // Source: https://github.com/solana-foundation/specs/blob/main/core/merkle-tree.md
@@ -68,13 +68,16 @@ fd_ed25519_ge_precomp_if( fd_ed25519_ge_precomp_t *       t,
   return t;
 }
 
+/* k25519_precomp is at file scope as it is also used by the lane
+   parallel double scalar multiplication in ../fd_ed25519_ge.c */
+
+#include "../table/fd_ed25519_ge_k25519_precomp.c"
+
 static fd_ed25519_ge_precomp_t *
 fd_ed25519_ge_table_select( fd_ed25519_ge_precomp_t * t,
                             int                       pos,
                             int                       b ) { /* In -8:8 */
 
-# include "../table/fd_ed25519_ge_k25519_precomp.c"
-
   int bnegative = fd_ed25519_ge_precomp_negative( b );
   int babs      = b - (int)((uint)((-bnegative) & b) << 1); /* b = b - (2*b) = -b = |b| if b<0, b - 2*0 = b = |b| o.w. */
   fd_ed25519_ge_precomp_0( t );
@@ -167,6 +170,64 @@ fd_ed25519_ge_madd( fd_ed25519_ge_p1p1_t *          r,
   return r;
 }
 
+/* The below are only used by the implementation agnostic group element
+   operations in ../fd_ed25519_ge.c (the hand vectorized operations in
+   this file fuse these into the AVX data flow directly). */
+
+/* fd_ed25519_ge_d2 is 2*d */
+
+static const fd_ed25519_fe_t fd_ed25519_ge_d2[1] = {{
+  { -21827239, -5839606, -30745221, 13898782, 229458, 15978800, -12551817, -6495438,  29715968, 9444199 }
+}};
+
+static inline fd_ed25519_ge_cached_t *
+fd_ed25519_ge_p3_to_cached( fd_ed25519_ge_cached_t *   r,
+                            fd_ed25519_ge_p3_t const * p ) {
+  fd_ed25519_fe_add ( r->YplusX,  p->Y, p->X );
+  fd_ed25519_fe_sub ( r->YminusX, p->Y, p->X );
+  fd_ed25519_fe_copy( r->Z,       p->Z       );
+  fd_ed25519_fe_mul ( r->T2d,     p->T, fd_ed25519_ge_d2 );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_add( fd_ed25519_ge_p1p1_t *         r,
+                   fd_ed25519_ge_p3_t const *     p,
+                   fd_ed25519_ge_cached_t const * q ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->X, p->Y,   p->X       );
+  fd_ed25519_fe_sub ( r->Y, p->Y,   p->X       );
+  fd_ed25519_fe_mul4( r->Z, r->X,   q->YplusX,
+                      r->Y, r->Y,   q->YminusX,
+                      r->T, q->T2d, p->T,
+                      r->X, p->Z,   q->Z       );
+  fd_ed25519_fe_add ( t0,   r->X,   r->X       );
+  fd_ed25519_fe_sub ( r->X, r->Z,   r->Y       );
+  fd_ed25519_fe_add ( r->Y, r->Z,   r->Y       );
+  fd_ed25519_fe_add ( r->Z, t0,     r->T       );
+  fd_ed25519_fe_sub ( r->T, t0,     r->T       );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_sub( fd_ed25519_ge_p1p1_t *         r,
+                   fd_ed25519_ge_p3_t const *     p,
+                   fd_ed25519_ge_cached_t const * q ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->X, p->Y,   p->X       );
+  fd_ed25519_fe_sub ( r->Y, p->Y,   p->X       );
+  fd_ed25519_fe_mul4( r->Z, r->X,   q->YminusX,
+                      r->Y, r->Y,   q->YplusX,
+                      r->T, q->T2d, p->T,
+                      r->X, p->Z,   q->Z       );
+  fd_ed25519_fe_add ( t0,   r->X,   r->X       );
+  fd_ed25519_fe_sub ( r->X, r->Z,   r->Y       );
+  fd_ed25519_fe_add ( r->Y, r->Z,   r->Y       );
+  fd_ed25519_fe_sub ( r->Z, t0,     r->T       );
+  fd_ed25519_fe_add ( r->T, t0,     r->T       );
+  return r;
+}
+
 /**********************************************************************/
 
 int
@@ -655,3 +716,87 @@ fd_ed25519_ge_double_scalarmult_vartime( fd_ed25519_ge_p2_t *       r,
 }
 
 #endif
+
+/* Lane parallel field element operations *****************************/
+
+/* A fd_ed25519_fe_lanes_t holds FD_ED25519_GE_LANE_CNT==4 independent
+   field elements, one per wl_t lane, in the fe_avx layout (so lane l
+   here is a field element of a different signature rather than a
+   different coordinate of the same group element).  These are used by
+   the lane parallel double scalar multiplication in ../fd_ed25519_ge.c.
+   Like the ref implementation, add / sub / neg_if do not reduce and
+   mul / sq / sq2 do a partial reduction. */
+
+struct fd_ed25519_fe_lanes_private {
+  long limb[40] __attribute__((aligned(64)));
+};
+
+typedef struct fd_ed25519_fe_lanes_private fd_ed25519_fe_lanes_t;
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_ld( fd_ed25519_fe_lanes_t *         h,
+                        fd_ed25519_fe_t const * const * f ) { /* FD_ED25519_GE_LANE_CNT */
+  fe_avx_ld4( h->limb, f[0], f[1], f[2], f[3] );
+  return h;
+}
+
+static inline void
+fd_ed25519_fe_lanes_st( fd_ed25519_fe_t * const *     h,     /* FD_ED25519_GE_LANE_CNT */
+                        fd_ed25519_fe_lanes_t const * f ) {
+  FE_AVX_INL_DECL( vf );
+  FE_AVX_INL_LD( vf, f->limb );
+  FE_AVX_INL_SWIZZLE_OUT4( h[0], h[1], h[2], h[3], vf );
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_add( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f,
+                         fd_ed25519_fe_lanes_t const * g ) {
+  fe_avx_add( h->limb, f->limb, g->limb );
+  return h;
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_sub( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f,
+                         fd_ed25519_fe_lanes_t const * g ) {
+  fe_avx_sub( h->limb, f->limb, g->limb );
+  return h;
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_mul( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f,
+                         fd_ed25519_fe_lanes_t const * g ) {
+  fe_avx_mul( h->limb, f->limb, g->limb );
+  return h;
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_sq( fd_ed25519_fe_lanes_t *       h,
+                        fd_ed25519_fe_lanes_t const * f ) {
+  fe_avx_sq( h->limb, f->limb );
+  return h;
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_sq2( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f ) {
+  fe_avx_sqn( h->limb, f->limb, 2,2,2,2 );
+  return h;
+}
+
+/* fd_ed25519_fe_lanes_neg_if sets lane l of h to the negation of lane l
+   of f if bit l of c is set and to lane l of f otherwise. */
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_neg_if( fd_ed25519_fe_lanes_t *       h,
+                            fd_ed25519_fe_lanes_t const * f,
+                            ulong                         c ) {
+  wl_t m = wl( -(long)(c & 1UL), -(long)((c>>1) & 1UL), -(long)((c>>2) & 1UL), -(long)((c>>3) & 1UL) );
+  for( ulong k=0UL; k<10UL; k++ ) {
+    wl_t x = wl_ld( f->limb + 4UL*k );
+    wl_st( h->limb + 4UL*k, wl_xor( x, wl_and( m, wl_xor( x, wl_sub( wl_zero(), x ) ) ) ) );
+  }
+  return h;
+}
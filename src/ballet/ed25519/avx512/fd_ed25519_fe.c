@@ -0,0 +1,355 @@
+#include "../fd_ed25519_private.h"
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_frombytes( fd_ed25519_fe_t * h,
+                         uchar const *     s ) {
+  ulong m51 = FD_ULONG_MASK_LSB(51);
+  ulong s0  = fd_ulong_load_8( s      );
+  ulong s1  = fd_ulong_load_8( s +  8 );
+  ulong s2  = fd_ulong_load_8( s + 16 );
+  ulong s3  = fd_ulong_load_8( s + 24 );
+  h->limb[0] =   s0                 & m51;
+  h->limb[1] = ((s0>>51) | (s1<<13)) & m51;
+  h->limb[2] = ((s1>>38) | (s2<<26)) & m51;
+  h->limb[3] = ((s2>>25) | (s3<<39)) & m51;
+  h->limb[4] =  (s3>>12)            & m51; /* Ignores top bit of s */
+  h->limb[5] = 0UL; h->limb[6] = 0UL; h->limb[7] = 0UL;
+  return h;
+}
+
+uchar *
+fd_ed25519_fe_tobytes( uchar *                 s,
+                       fd_ed25519_fe_t const * h ) {
+  ulong m51 = FD_ULONG_MASK_LSB(51);
+
+  ulong h0 = h->limb[0]; ulong h1 = h->limb[1]; ulong h2 = h->limb[2];
+  ulong h3 = h->limb[3]; ulong h4 = h->limb[4];
+
+  /* Limbs are in [0,2^52) on input.  Carry such that h0 and h2:4 are
+     in [0,2^51) and h1 is in [0,2^51] (the wrap around carry is at
+     most 2 so h0 is less than 2^51+38 before its second carry).  h is
+     then less than 2p. */
+
+  h1 += h0>>51; h0 &= m51;
+  h2 += h1>>51; h1 &= m51;
+  h3 += h2>>51; h2 &= m51;
+  h4 += h3>>51; h3 &= m51;
+  h0 += 19UL*(h4>>51); h4 &= m51;
+  h1 += h0>>51; h0 &= m51;
+
+  /* Compute q = floor((h+19)/2^255) in {0,1} (i.e. q is 1 if h>=p) and
+     subtract q p (i.e. add 19 q and drop the 2^255 bit). */
+
+  ulong q = (h0 + 19UL)>>51;
+  q = (h1 + q)>>51;
+  q = (h2 + q)>>51;
+  q = (h3 + q)>>51;
+  q = (h4 + q)>>51;
+
+  h0 += 19UL*q;
+
+  h1 += h0>>51; h0 &= m51;
+  h2 += h1>>51; h1 &= m51;
+  h3 += h2>>51; h2 &= m51;
+  h4 += h3>>51; h3 &= m51;
+  /**/          h4 &= m51;
+
+  /* Pack the results into s */
+
+  ulong * u = (ulong *)s;
+  u[0] =  h0      | (h1<<51);
+  u[1] = (h1>>13) | (h2<<38);
+  u[2] = (h2>>26) | (h3<<25);
+  u[3] = (h3>>39) | (h4<<12);
+  return s;
+}
+
+/* fe_avx512_mul returns f*g as a vector with limbs in [0,2^51+2^14)
+   given f and g have limbs in [0,2^52).  If dbl is non-zero (compile
+   time), it returns 2*f*g instead.
+
+   Let f_i and g_j be the limbs of f and g and let lo_ij and hi_ij be
+   the low and high 52 bits of the 104-bit product f_i g_j (such that
+   f_i g_j = lo_ij + 2^52 hi_ij).  lo_ij contributes to the limb i+j
+   of the product and hi_ij contributes 2 hi_ij to the limb i+j+1.
+   Limbs 5 and higher wrap around to limbs 0 and higher times 19 (as
+   2^255 = 19 mod p).
+
+   For j in [0,5), we rotate f such that lane k holds f_((k-j) mod 5)
+   and multiply by a broadcast g_j.  The lo_ij land in lane k = i+j for
+   the unwrapped terms (lanes k>=j) and k = i+j-5 for the wrapped terms
+   (lanes k<j).  These are accumulated separately (via write masks) in
+   la and lw such that the times 19 happens once at the end.  The hi_ij
+   are similarly accumulated in ha and hw but belong in the next limb
+   so their sum is rotated up by one lane (times 19 for the lane that
+   wraps around) at the end.
+
+   Lanes accumulate at most 5 terms less than 2^52 so the unreduced
+   limbs are less than (5+19*4)*2^52 + 2*(19*5)*2^52 < 2^61 (2^62 if
+   dbl) before the final carry. */
+
+static inline __m512i
+fe_avx512_mul( __m512i f,
+               __m512i g,
+               int     dbl ) {
+  __m512i const idx1 = _mm512_setr_epi64( 4L, 0L, 1L, 2L, 3L, 5L, 5L, 5L );
+  __m512i const idx2 = _mm512_setr_epi64( 3L, 4L, 0L, 1L, 2L, 5L, 5L, 5L );
+  __m512i const idx3 = _mm512_setr_epi64( 2L, 3L, 4L, 0L, 1L, 5L, 5L, 5L );
+  __m512i const idx4 = _mm512_setr_epi64( 1L, 2L, 3L, 4L, 0L, 5L, 5L, 5L );
+
+  __m512i f0 = f;
+  __m512i f1 = _mm512_maskz_permutexvar_epi64( (__mmask8)0x1f, idx1, f );
+  __m512i f2 = _mm512_maskz_permutexvar_epi64( (__mmask8)0x1f, idx2, f );
+  __m512i f3 = _mm512_maskz_permutexvar_epi64( (__mmask8)0x1f, idx3, f );
+  __m512i f4 = _mm512_maskz_permutexvar_epi64( (__mmask8)0x1f, idx4, f );
+
+  __m512i g0 = _mm512_permutexvar_epi64( _mm512_set1_epi64( 0L ), g );
+  __m512i g1 = _mm512_permutexvar_epi64( _mm512_set1_epi64( 1L ), g );
+  __m512i g2 = _mm512_permutexvar_epi64( _mm512_set1_epi64( 2L ), g );
+  __m512i g3 = _mm512_permutexvar_epi64( _mm512_set1_epi64( 3L ), g );
+  __m512i g4 = _mm512_permutexvar_epi64( _mm512_set1_epi64( 4L ), g );
+
+  __m512i z  = _mm512_setzero_si512();
+  __m512i la = _mm512_madd52lo_epu64( z, f0, g0 );
+  __m512i ha = _mm512_madd52hi_epu64( z, f0, g0 );
+  __m512i lw = z;
+  __m512i hw = z;
+
+  la = _mm512_mask_madd52lo_epu64( la, (__mmask8)0x1e, f1, g1 ); lw = _mm512_mask_madd52lo_epu64( lw, (__mmask8)0x01, f1, g1 );
+  ha = _mm512_mask_madd52hi_epu64( ha, (__mmask8)0x1e, f1, g1 ); hw = _mm512_mask_madd52hi_epu64( hw, (__mmask8)0x01, f1, g1 );
+  la = _mm512_mask_madd52lo_epu64( la, (__mmask8)0x1c, f2, g2 ); lw = _mm512_mask_madd52lo_epu64( lw, (__mmask8)0x03, f2, g2 );
+  ha = _mm512_mask_madd52hi_epu64( ha, (__mmask8)0x1c, f2, g2 ); hw = _mm512_mask_madd52hi_epu64( hw, (__mmask8)0x03, f2, g2 );
+  la = _mm512_mask_madd52lo_epu64( la, (__mmask8)0x18, f3, g3 ); lw = _mm512_mask_madd52lo_epu64( lw, (__mmask8)0x07, f3, g3 );
+  ha = _mm512_mask_madd52hi_epu64( ha, (__mmask8)0x18, f3, g3 ); hw = _mm512_mask_madd52hi_epu64( hw, (__mmask8)0x07, f3, g3 );
+  la = _mm512_mask_madd52lo_epu64( la, (__mmask8)0x10, f4, g4 ); lw = _mm512_mask_madd52lo_epu64( lw, (__mmask8)0x0f, f4, g4 );
+  ha = _mm512_mask_madd52hi_epu64( ha, (__mmask8)0x10, f4, g4 ); hw = _mm512_mask_madd52hi_epu64( hw, (__mmask8)0x0f, f4, g4 );
+
+# define X19(x) _mm512_add_epi64( _mm512_add_epi64( (x), _mm512_slli_epi64( (x), 1 ) ), _mm512_slli_epi64( (x), 4 ) )
+
+  __m512i l = _mm512_add_epi64( la, X19( lw ) );
+  __m512i u = _mm512_add_epi64( ha, X19( hw ) );
+  u = _mm512_maskz_permutexvar_epi64( (__mmask8)0x1f, idx1, u );
+  u = _mm512_mask_blend_epi64( (__mmask8)0x01, u, X19( u ) );
+  __m512i h = _mm512_add_epi64( l, _mm512_add_epi64( u, u ) );
+  if( dbl ) h = _mm512_add_epi64( h, h );
+
+# undef X19
+
+  return fe_avx512_carry( h );
+}
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_mul( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f,
+                   fd_ed25519_fe_t const * g ) {
+  fe_avx512_st( h, fe_avx512_mul( fe_avx512_ld( f ), fe_avx512_ld( g ), 0 ) );
+  return h;
+}
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_sq( fd_ed25519_fe_t *       h,
+                  fd_ed25519_fe_t const * f ) {
+  __m512i x = fe_avx512_ld( f );
+  fe_avx512_st( h, fe_avx512_mul( x, x, 0 ) );
+  return h;
+}
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_sq2( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f ) {
+  __m512i x = fe_avx512_ld( f );
+  fe_avx512_st( h, fe_avx512_mul( x, x, 1 ) );
+  return h;
+}
+
+void
+fd_ed25519_fe_mul2( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, fd_ed25519_fe_t const * ga,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, fd_ed25519_fe_t const * gb ) {
+  __m512i a = fe_avx512_mul( fe_avx512_ld( fa ), fe_avx512_ld( ga ), 0 );
+  __m512i b = fe_avx512_mul( fe_avx512_ld( fb ), fe_avx512_ld( gb ), 0 );
+  fe_avx512_st( ha, a ); fe_avx512_st( hb, b );
+}
+
+void
+fd_ed25519_fe_mul3( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, fd_ed25519_fe_t const * ga,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, fd_ed25519_fe_t const * gb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, fd_ed25519_fe_t const * gc ) {
+  __m512i a = fe_avx512_mul( fe_avx512_ld( fa ), fe_avx512_ld( ga ), 0 );
+  __m512i b = fe_avx512_mul( fe_avx512_ld( fb ), fe_avx512_ld( gb ), 0 );
+  __m512i c = fe_avx512_mul( fe_avx512_ld( fc ), fe_avx512_ld( gc ), 0 );
+  fe_avx512_st( ha, a ); fe_avx512_st( hb, b ); fe_avx512_st( hc, c );
+}
+
+void
+fd_ed25519_fe_mul4( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, fd_ed25519_fe_t const * ga,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, fd_ed25519_fe_t const * gb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, fd_ed25519_fe_t const * gc,
+                    fd_ed25519_fe_t * hd, fd_ed25519_fe_t const * fd, fd_ed25519_fe_t const * gd ) {
+  __m512i a = fe_avx512_mul( fe_avx512_ld( fa ), fe_avx512_ld( ga ), 0 );
+  __m512i b = fe_avx512_mul( fe_avx512_ld( fb ), fe_avx512_ld( gb ), 0 );
+  __m512i c = fe_avx512_mul( fe_avx512_ld( fc ), fe_avx512_ld( gc ), 0 );
+  __m512i d = fe_avx512_mul( fe_avx512_ld( fd ), fe_avx512_ld( gd ), 0 );
+  fe_avx512_st( ha, a ); fe_avx512_st( hb, b ); fe_avx512_st( hc, c ); fe_avx512_st( hd, d );
+}
+
+/* fe_avx512_sqn returns f^2 if n==1 and 2 f^2 otherwise */
+
+static inline __m512i
+fe_avx512_sqn( __m512i f,
+               long    n ) {
+  return n==1L ? fe_avx512_mul( f, f, 0 ) : fe_avx512_mul( f, f, 1 );
+}
+
+void
+fd_ed25519_fe_sqn2( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, long na,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, long nb ) {
+  __m512i a = fe_avx512_sqn( fe_avx512_ld( fa ), na );
+  __m512i b = fe_avx512_sqn( fe_avx512_ld( fb ), nb );
+  fe_avx512_st( ha, a ); fe_avx512_st( hb, b );
+}
+
+void
+fd_ed25519_fe_sqn3( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, long na,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, long nb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, long nc ) {
+  __m512i a = fe_avx512_sqn( fe_avx512_ld( fa ), na );
+  __m512i b = fe_avx512_sqn( fe_avx512_ld( fb ), nb );
+  __m512i c = fe_avx512_sqn( fe_avx512_ld( fc ), nc );
+  fe_avx512_st( ha, a ); fe_avx512_st( hb, b ); fe_avx512_st( hc, c );
+}
+
+void
+fd_ed25519_fe_sqn4( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, long na,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, long nb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, long nc,
+                    fd_ed25519_fe_t * hd, fd_ed25519_fe_t const * fd, long nd ) {
+  __m512i a = fe_avx512_sqn( fe_avx512_ld( fa ), na );
+  __m512i b = fe_avx512_sqn( fe_avx512_ld( fb ), nb );
+  __m512i c = fe_avx512_sqn( fe_avx512_ld( fc ), nc );
+  __m512i d = fe_avx512_sqn( fe_avx512_ld( fd ), nd );
+  fe_avx512_st( ha, a ); fe_avx512_st( hb, b ); fe_avx512_st( hc, c ); fe_avx512_st( hd, d );
+}
+
+/* fe_avx512_sq_iter returns f^(2^n) for n>=1 */
+
+static inline __m512i
+fe_avx512_sq_iter( __m512i f,
+                   int     n ) {
+  for( int i=0; i<n; i++ ) f = fe_avx512_mul( f, f, 0 );
+  return f;
+}
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_invert( fd_ed25519_fe_t *       out,
+                      fd_ed25519_fe_t const * z ) {
+
+  /* Compute z**-1 = z**(2**255 - 19 - 2) with the exponent as
+     2**255 - 21 = (2**5) * (2**250 - 1) + 11.  See the ref
+     implementation for details. */
+
+  __m512i z1 = fe_avx512_ld( z );
+  __m512i t0 = fe_avx512_mul( z1, z1, 0 );                          /* t0 = z**2 */
+  __m512i t1 = fe_avx512_sq_iter( t0, 2 );                          /* t1 = z**8 */
+  /**/    t1 = fe_avx512_mul( z1, t1, 0 );                          /* t1 = z**9 */
+  /**/    t0 = fe_avx512_mul( t0, t1, 0 );                          /* t0 = z**11 */
+  __m512i t2 = fe_avx512_mul( t0, t0, 0 );                          /* t2 = z**22 */
+  /**/    t1 = fe_avx512_mul( t1, t2, 0 );                          /* t1 = z**(2**5 - 1) */
+  /**/    t2 = fe_avx512_sq_iter( t1, 5 );
+  /**/    t1 = fe_avx512_mul( t2, t1, 0 );                          /* t1 = z**(2**10 - 1) */
+  /**/    t2 = fe_avx512_sq_iter( t1, 10 );
+  /**/    t2 = fe_avx512_mul( t2, t1, 0 );                          /* t2 = z**(2**20 - 1) */
+  __m512i t3 = fe_avx512_sq_iter( t2, 20 );
+  /**/    t2 = fe_avx512_mul( t3, t2, 0 );                          /* t2 = z**(2**40 - 1) */
+  /**/    t2 = fe_avx512_sq_iter( t2, 10 );
+  /**/    t1 = fe_avx512_mul( t2, t1, 0 );                          /* t1 = z**(2**50 - 1) */
+  /**/    t2 = fe_avx512_sq_iter( t1, 50 );
+  /**/    t2 = fe_avx512_mul( t2, t1, 0 );                          /* t2 = z**(2**100 - 1) */
+  /**/    t3 = fe_avx512_sq_iter( t2, 100 );
+  /**/    t2 = fe_avx512_mul( t3, t2, 0 );                          /* t2 = z**(2**200 - 1) */
+  /**/    t2 = fe_avx512_sq_iter( t2, 50 );
+  /**/    t1 = fe_avx512_mul( t2, t1, 0 );                          /* t1 = z**(2**250 - 1) */
+  /**/    t1 = fe_avx512_sq_iter( t1, 5 );
+  fe_avx512_st( out, fe_avx512_mul( t1, t0, 0 ) );                  /* out = z**(2**255 - 21) */
+  return out;
+}
+
+/* FE_AVX512_POW22523 computes z^(2^252-3) with the same addition chain
+   as the ref implementation.  T is the type of the state and MUL and
+   SQ_ITER are the multiplication and repeated squaring to use (allowing fd_ed25519_fe_pow22523_2 to
+   interleave two independent chains for more ILP). */
+
+#define FE_AVX512_POW22523( T, out, z, MUL, SQ_ITER ) do {                            \
+    T       _t0 = MUL( (z), (z) );                                                   \
+    T       _t1 = SQ_ITER( _t0, 2 );                                                 \
+    /**/    _t1 = MUL( (z), _t1 );                                                   \
+    /**/    _t0 = MUL( _t0, _t1 );                                                   \
+    /**/    _t0 = MUL( _t0, _t0 );                                                   \
+    /**/    _t0 = MUL( _t1, _t0 );                                                   \
+    /**/    _t1 = SQ_ITER( _t0, 5 );                                                 \
+    /**/    _t0 = MUL( _t1, _t0 );                                                   \
+    /**/    _t1 = SQ_ITER( _t0, 10 );                                                \
+    /**/    _t1 = MUL( _t1, _t0 );                                                   \
+    T       _t2 = SQ_ITER( _t1, 20 );                                                \
+    /**/    _t1 = MUL( _t2, _t1 );                                                   \
+    /**/    _t1 = SQ_ITER( _t1, 10 );                                                \
+    /**/    _t0 = MUL( _t1, _t0 );                                                   \
+    /**/    _t1 = SQ_ITER( _t0, 50 );                                                \
+    /**/    _t1 = MUL( _t1, _t0 );                                                   \
+    /**/    _t2 = SQ_ITER( _t1, 100 );                                               \
+    /**/    _t1 = MUL( _t2, _t1 );                                                   \
+    /**/    _t1 = SQ_ITER( _t1, 50 );                                                \
+    /**/    _t0 = MUL( _t1, _t0 );                                                   \
+    /**/    _t0 = SQ_ITER( _t0, 2 );                                                 \
+    (out) = MUL( _t0, (z) );                                                         \
+  } while(0)
+
+#define FE_AVX512_MUL1(a,b) fe_avx512_mul( (a), (b), 0 )
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_pow22523( fd_ed25519_fe_t *       out,
+                        fd_ed25519_fe_t const * z ) {
+  __m512i x = fe_avx512_ld( z );
+  __m512i y;
+  FE_AVX512_POW22523( __m512i, y, x, FE_AVX512_MUL1, fe_avx512_sq_iter );
+  fe_avx512_st( out, y );
+  return out;
+}
+
+/* For the 2 element version, we pack the two elements' state into a
+   struct of 2 vectors and apply each operation to both lanes so the
+   two independent dependency chains are interleaved. */
+
+struct fe_avx512_pair { __m512i a; __m512i b; };
+typedef struct fe_avx512_pair fe_avx512_pair_t;
+
+static inline fe_avx512_pair_t
+fe_avx512_pair_mul( fe_avx512_pair_t x,
+                    fe_avx512_pair_t y ) {
+  fe_avx512_pair_t r;
+  r.a = fe_avx512_mul( x.a, y.a, 0 );
+  r.b = fe_avx512_mul( x.b, y.b, 0 );
+  return r;
+}
+
+static inline fe_avx512_pair_t
+fe_avx512_pair_sq_iter( fe_avx512_pair_t x,
+                        int              n ) {
+  for( int i=0; i<n; i++ ) {
+    x.a = fe_avx512_mul( x.a, x.a, 0 );
+    x.b = fe_avx512_mul( x.b, x.b, 0 );
+  }
+  return x;
+}
+
+void
+fd_ed25519_fe_pow22523_2( fd_ed25519_fe_t * out0, fd_ed25519_fe_t const * z0,
+                          fd_ed25519_fe_t * out1, fd_ed25519_fe_t const * z1 ) {
+  fe_avx512_pair_t x; x.a = fe_avx512_ld( z0 ); x.b = fe_avx512_ld( z1 );
+  fe_avx512_pair_t y;
+  FE_AVX512_POW22523( fe_avx512_pair_t, y, x, fe_avx512_pair_mul, fe_avx512_pair_sq_iter );
+  fe_avx512_st( out0, y.a );
+  fe_avx512_st( out1, y.b );
+}
+
+#undef FE_AVX512_MUL1
+#undef FE_AVX512_POW22523
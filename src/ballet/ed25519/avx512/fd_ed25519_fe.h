@@ -0,0 +1,207 @@
+#ifndef HEADER_fd_src_ballet_ed25519_fd_ed25519_private_h
+#error "Do not include this directly; use fd_ed25519_private.h"
+#endif
+
+#include <x86intrin.h>
+
+/* See ../ref/fd_ed25519_fe.h for documentation of these APIs.
+
+   A fd_ed25519_fe_t here stores an ed25519 field element in a radix
+   2^51 5-limb representation stored in the first 5 64-bit lanes of a
+   512-bit vector (the remaining 3 lanes are always zero).  Limbs are
+   non-negative and, between API calls, strictly less than 2^52.  This
+   is exactly what the AVX-512 IFMA 52-bit multiply-accumulate
+   instructions need for their inputs and leaves one bit of headroom per
+   limb (so additions and subtractions only need a single parallel
+   carry pass to restore the invariant and a multiplication is 20
+   vpmadd52[lh]uq with no sequential carry chain).  Only tobytes does a
+   full reduction to the canonical representation. */
+
+struct fd_ed25519_fe_private {
+  ulong limb[8] __attribute__((aligned(64))); /* only 0:4 matter */
+};
+
+typedef struct fd_ed25519_fe_private fd_ed25519_fe_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* Internal helpers ***************************************************/
+
+/* fe_avx512_ld / fe_avx512_st load / store a fe to / from a vector. */
+
+static inline __m512i fe_avx512_ld( fd_ed25519_fe_t const * f ) { return _mm512_load_si512( f->limb ); }
+static inline void    fe_avx512_st( fd_ed25519_fe_t * h, __m512i x ) { _mm512_store_si512( h->limb, x ); }
+
+/* fe_avx512_carry returns a vector holding the same field element as x
+   with all limbs less than 2^51 + 2^18 given x has limbs less than
+   2^64 and lanes 5:7 zero.  This is a single parallel carry pass (each
+   limb propagates its overflow to the next limb and the overflow of
+   the most significant limb wraps around to the least significant limb
+   times 19 as 2^255 = 19 mod p).  The times 19 and the addition are
+   done in one IFMA (the carries are at most 13 bits). */
+
+static inline __m512i
+fe_avx512_carry( __m512i x ) {
+  __m512i const m51 = _mm512_set1_epi64( (long)FD_ULONG_MASK_LSB(51) );
+  __m512i const rot = _mm512_setr_epi64( 4L, 0L, 1L, 2L, 3L, 5L, 5L, 5L );
+  __m512i const k19 = _mm512_setr_epi64( 19L, 1L, 1L, 1L, 1L, 0L, 0L, 0L );
+  __m512i c = _mm512_maskz_permutexvar_epi64( (__mmask8)0x1f, rot, _mm512_srli_epi64( x, 51 ) );
+  return _mm512_madd52lo_epu64( _mm512_and_si512( x, m51 ), c, k19 );
+}
+
+/* fe_avx512_4p returns 4p = 4*(2^255-19) in limb form (each limb is at
+   least 2^53-76 such that subtracting a limb less than 2^52 from it
+   cannot go negative). */
+
+static inline __m512i
+fe_avx512_4p( void ) {
+  return _mm512_setr_epi64( (long)(FD_ULONG_MASK_LSB(53)-75UL), (long)(FD_ULONG_MASK_LSB(53)-3UL),
+                            (long)(FD_ULONG_MASK_LSB(53)-3UL),  (long)(FD_ULONG_MASK_LSB(53)-3UL),
+                            (long)(FD_ULONG_MASK_LSB(53)-3UL),  0L, 0L, 0L );
+}
+
+/* Field element API **************************************************/
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_frombytes( fd_ed25519_fe_t * h,
+                         uchar const *     s );
+
+uchar *
+fd_ed25519_fe_tobytes( uchar *                 s,
+                       fd_ed25519_fe_t const * h );
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_copy( fd_ed25519_fe_t *       h,
+                    fd_ed25519_fe_t const * f ) {
+  fe_avx512_st( h, fe_avx512_ld( f ) );
+  return h;
+}
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_0( fd_ed25519_fe_t * h ) {
+  fe_avx512_st( h, _mm512_setzero_si512() );
+  return h;
+}
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_1( fd_ed25519_fe_t * h ) {
+  fe_avx512_st( h, _mm512_setr_epi64( 1L, 0L, 0L, 0L, 0L, 0L, 0L, 0L ) );
+  return h;
+}
+
+FD_FN_UNUSED static fd_ed25519_fe_t * /* Work around -Winline */
+fd_ed25519_fe_rng( fd_ed25519_fe_t * h,
+                   fd_rng_t *        rng ) {
+  ulong m51 = FD_ULONG_MASK_LSB(51);
+  h->limb[0] = fd_rng_ulong( rng ) & m51; h->limb[1] = fd_rng_ulong( rng ) & m51;
+  h->limb[2] = fd_rng_ulong( rng ) & m51; h->limb[3] = fd_rng_ulong( rng ) & m51;
+  h->limb[4] = fd_rng_ulong( rng ) & m51; h->limb[5] = 0UL;
+  h->limb[6] = 0UL;                       h->limb[7] = 0UL;
+  return h;
+}
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_add( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f,
+                   fd_ed25519_fe_t const * g ) {
+  fe_avx512_st( h, fe_avx512_carry( _mm512_add_epi64( fe_avx512_ld( f ), fe_avx512_ld( g ) ) ) );
+  return h;
+}
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_sub( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f,
+                   fd_ed25519_fe_t const * g ) {
+  __m512i x = _mm512_sub_epi64( _mm512_add_epi64( fe_avx512_ld( f ), fe_avx512_4p() ), fe_avx512_ld( g ) );
+  fe_avx512_st( h, fe_avx512_carry( x ) );
+  return h;
+}
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_mul( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f,
+                   fd_ed25519_fe_t const * g );
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_sq( fd_ed25519_fe_t *       h,
+                  fd_ed25519_fe_t const * f );
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_invert( fd_ed25519_fe_t *       out,
+                      fd_ed25519_fe_t const * z );
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_neg( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f ) {
+  fe_avx512_st( h, fe_avx512_carry( _mm512_sub_epi64( fe_avx512_4p(), fe_avx512_ld( f ) ) ) );
+  return h;
+}
+
+static inline fd_ed25519_fe_t *
+fd_ed25519_fe_if( fd_ed25519_fe_t *       h,
+                  int                     c,
+                  fd_ed25519_fe_t const * f,
+                  fd_ed25519_fe_t const * g ) {
+  __mmask8 m = (__mmask8)(-!!c);
+  fe_avx512_st( h, _mm512_mask_blend_epi64( m, fe_avx512_ld( g ), fe_avx512_ld( f ) ) );
+  return h;
+}
+
+static inline int
+fd_ed25519_fe_isnonzero( fd_ed25519_fe_t const * f ) {
+  uchar s[32]; fd_ed25519_fe_tobytes( s, f );
+  return !!( fd_ulong_load_8( s    ) | fd_ulong_load_8( s+ 8 ) |
+             fd_ulong_load_8( s+16 ) | fd_ulong_load_8( s+24 ) );
+}
+
+static inline int
+fd_ed25519_fe_isnegative( fd_ed25519_fe_t const * f ) {
+  uchar s[32]; fd_ed25519_fe_tobytes( s, f );
+  return ((int)(uint)s[0]) & 1;
+}
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_sq2( fd_ed25519_fe_t *       h,
+                   fd_ed25519_fe_t const * f );
+
+fd_ed25519_fe_t *
+fd_ed25519_fe_pow22523( fd_ed25519_fe_t *       out,
+                        fd_ed25519_fe_t const * z );
+
+void
+fd_ed25519_fe_mul2( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, fd_ed25519_fe_t const * ga,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, fd_ed25519_fe_t const * gb );
+
+void
+fd_ed25519_fe_mul3( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, fd_ed25519_fe_t const * ga,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, fd_ed25519_fe_t const * gb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, fd_ed25519_fe_t const * gc );
+
+void
+fd_ed25519_fe_mul4( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, fd_ed25519_fe_t const * ga,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, fd_ed25519_fe_t const * gb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, fd_ed25519_fe_t const * gc,
+                    fd_ed25519_fe_t * hd, fd_ed25519_fe_t const * fd, fd_ed25519_fe_t const * gd );
+
+void
+fd_ed25519_fe_sqn2( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, long na,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, long nb );
+
+void
+fd_ed25519_fe_sqn3( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, long na,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, long nb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, long nc );
+
+void
+fd_ed25519_fe_sqn4( fd_ed25519_fe_t * ha, fd_ed25519_fe_t const * fa, long na,
+                    fd_ed25519_fe_t * hb, fd_ed25519_fe_t const * fb, long nb,
+                    fd_ed25519_fe_t * hc, fd_ed25519_fe_t const * fc, long nc,
+                    fd_ed25519_fe_t * hd, fd_ed25519_fe_t const * fd, long nd );
+
+#define FD_ED25519_FE_POW25523_2_FAST 1
+
+void
+fd_ed25519_fe_pow22523_2( fd_ed25519_fe_t * out0, fd_ed25519_fe_t const * z0,
+                          fd_ed25519_fe_t * out1, fd_ed25519_fe_t const * z1 );
+
+FD_PROTOTYPES_END
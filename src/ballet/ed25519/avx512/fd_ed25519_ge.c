@@ -0,0 +1,749 @@
+#include "../fd_ed25519_private.h"
+
+/* This is the ref group element implementation with the field element
+   constants and precomputed tables in the radix 2^51 representation
+   used by the avx512 field element implementation.  (The ref
+   implementation already groups independent field multiplications
+   into fd_ed25519_fe_mul{2,3,4} and the like so the IFMA field element
+   implementation gets the corresponding ILP.) */
+
+/* Internal use representations of a ed25519 group element:
+
+   ge_p1p1    (completed): ((X:Z),(Y:T)) satisfying x=X/Z, y=Y/T
+   ge_precomp (Duif):      (y+x,y-x,2dxy) */
+
+struct fd_ed25519_ge_p1p1_private {
+  fd_ed25519_fe_t X[1];
+  fd_ed25519_fe_t Y[1];
+  fd_ed25519_fe_t Z[1];
+  fd_ed25519_fe_t T[1];
+};
+
+typedef struct fd_ed25519_ge_p1p1_private fd_ed25519_ge_p1p1_t;
+
+struct fd_ed25519_ge_precomp_private {
+  fd_ed25519_fe_t yplusx [1];
+  fd_ed25519_fe_t yminusx[1];
+  fd_ed25519_fe_t xy2d   [1];
+};
+
+typedef struct fd_ed25519_ge_precomp_private fd_ed25519_ge_precomp_t;
+
+static inline fd_ed25519_ge_precomp_t *
+fd_ed25519_ge_precomp_0( fd_ed25519_ge_precomp_t * h ) {
+  fd_ed25519_fe_1( h->yplusx  );
+  fd_ed25519_fe_1( h->yminusx );
+  fd_ed25519_fe_0( h->xy2d    );
+  return h;
+}
+
+struct fd_ed25519_ge_cached_private {
+  fd_ed25519_fe_t YplusX [1];
+  fd_ed25519_fe_t YminusX[1];
+  fd_ed25519_fe_t Z      [1];
+  fd_ed25519_fe_t T2d    [1];
+};
+
+typedef struct fd_ed25519_ge_cached_private fd_ed25519_ge_cached_t;
+
+/* fd_ed25519_ge_d2 is 2*d */
+
+static const fd_ed25519_fe_t fd_ed25519_ge_d2[1] = {{
+  { 0x69b9426b2f159UL, 0x35050762add7aUL, 0x3cf44c0038052UL, 0x6738cc7407977UL, 0x2406d9dc56dffUL }
+}};
+
+static inline fd_ed25519_ge_cached_t *
+fd_ed25519_ge_p3_to_cached( fd_ed25519_ge_cached_t *   r,
+                            fd_ed25519_ge_p3_t const * p ) {
+  fd_ed25519_fe_add ( r->YplusX,  p->Y, p->X );
+  fd_ed25519_fe_sub ( r->YminusX, p->Y, p->X );
+  fd_ed25519_fe_copy( r->Z,       p->Z       );
+  fd_ed25519_fe_mul ( r->T2d,     p->T, fd_ed25519_ge_d2 );
+  return r;
+}
+
+/**********************************************************************/
+
+/* FIXME: THIS SEEMS UNNECESSARILY BYZANTINE (AND, IF THE POINT IS
+   DETERMINISTIC TIMING, THIS COULD BE ACHIEVED MUCH MORE CLEANLY AND
+   WITH LESS OVERHEAD). */
+
+static inline int /* In {0,1} */
+fd_ed25519_ge_precomp_negative( int b ) {
+  return (int)(((uint)b) >> 31);
+}
+
+static inline int /* In {0,1} */
+fd_ed25519_ge_precomp_equal( int b,
+                             int c ) {
+  return (int)((((uint)(b ^ c))-1U) >> 31);
+}
+
+static inline fd_ed25519_ge_precomp_t *
+fd_ed25519_ge_precomp_if( fd_ed25519_ge_precomp_t *       t,
+                          int                             c,
+                          fd_ed25519_ge_precomp_t const * u,
+                          fd_ed25519_ge_precomp_t const * v ) {
+  fd_ed25519_fe_if( t->yplusx,  c, u->yplusx,  v->yplusx  );
+  fd_ed25519_fe_if( t->yminusx, c, u->yminusx, v->yminusx );
+  fd_ed25519_fe_if( t->xy2d,    c, u->xy2d,    v->xy2d    );
+  return t;
+}
+
+/* k25519_precomp is at file scope as it is also used by the lane
+   parallel double scalar multiplication in ../fd_ed25519_ge.c */
+
+#include "../table/fd_ed25519_ge_k25519_precomp_avx512.c"
+
+static fd_ed25519_ge_precomp_t *
+fd_ed25519_ge_table_select( fd_ed25519_ge_precomp_t * t,
+                            int                       pos,
+                            int                       b ) { /* In -8:8 */
+
+  int bnegative = fd_ed25519_ge_precomp_negative( b );
+  int babs      = b - (int)((uint)((-bnegative) & b) << 1); /* b = b - (2*b) = -b = |b| if b<0, b - 2*0 = b = |b| o.w. */
+  fd_ed25519_ge_precomp_0( t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 1 ), k25519_precomp[ pos ][ 0 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 2 ), k25519_precomp[ pos ][ 1 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 3 ), k25519_precomp[ pos ][ 2 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 4 ), k25519_precomp[ pos ][ 3 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 5 ), k25519_precomp[ pos ][ 4 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 6 ), k25519_precomp[ pos ][ 5 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 7 ), k25519_precomp[ pos ][ 6 ], t );
+  fd_ed25519_ge_precomp_if( t, fd_ed25519_ge_precomp_equal( babs, 8 ), k25519_precomp[ pos ][ 7 ], t );
+  fd_ed25519_ge_precomp_t minust[1];
+  fd_ed25519_fe_copy( minust->yplusx,  t->yminusx );
+  fd_ed25519_fe_copy( minust->yminusx, t->yplusx  );
+  fd_ed25519_fe_neg ( minust->xy2d,    t->xy2d    );
+  fd_ed25519_ge_precomp_if( t, bnegative, minust, t );
+  return t;
+}
+
+/**********************************************************************/
+
+static inline fd_ed25519_ge_p2_t *
+fd_ed25519_ge_p3_to_p2( fd_ed25519_ge_p2_t *       r,
+                        fd_ed25519_ge_p3_t const * p ) {
+  fd_ed25519_fe_copy( r->X, p->X );
+  fd_ed25519_fe_copy( r->Y, p->Y );
+  fd_ed25519_fe_copy( r->Z, p->Z );
+  return r;
+}
+
+static inline fd_ed25519_ge_p2_t *
+fd_ed25519_ge_p1p1_to_p2( fd_ed25519_ge_p2_t *         r,
+                          fd_ed25519_ge_p1p1_t * const p ) {
+  fd_ed25519_fe_mul3( r->X, p->X, p->T,
+                      r->Y, p->Y, p->Z,
+                      r->Z, p->Z, p->T );
+  return r;
+}
+
+static inline fd_ed25519_ge_p3_t *
+fd_ed25519_ge_p1p1_to_p3( fd_ed25519_ge_p3_t *         r,
+                          fd_ed25519_ge_p1p1_t const * p ) {
+  fd_ed25519_fe_mul4( r->X, p->X, p->T,
+                      r->Y, p->Y, p->Z,
+                      r->Z, p->Z, p->T,
+                      r->T, p->X, p->Y );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_p2_dbl( fd_ed25519_ge_p1p1_t *     r,
+                      fd_ed25519_ge_p2_t const * p ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->Y, p->X, p->Y );
+  fd_ed25519_fe_sqn4( r->X, p->X, 1L,
+                      r->Z, p->Y, 1L,
+                      r->T, p->Z, 2L,
+                      t0,   r->Y, 1L   );
+  fd_ed25519_fe_add ( r->Y, r->Z, r->X );
+  fd_ed25519_fe_sub ( r->Z, r->Z, r->X );
+  fd_ed25519_fe_sub ( r->X, t0,   r->Y );
+  fd_ed25519_fe_sub ( r->T, r->T, r->Z );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_p3_dbl( fd_ed25519_ge_p1p1_t *     r,
+                      fd_ed25519_ge_p3_t const * p ) {
+  fd_ed25519_ge_p2_t q[1];
+  fd_ed25519_ge_p3_to_p2( q, p );
+  fd_ed25519_ge_p2_dbl  ( r, q );
+  return r;
+}
+
+FD_FN_UNUSED static fd_ed25519_ge_p1p1_t * /* Work around -Winline */
+fd_ed25519_ge_add( fd_ed25519_ge_p1p1_t *         r,
+                   fd_ed25519_ge_p3_t const *     p,
+                   fd_ed25519_ge_cached_t const * q ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->X, p->Y,   p->X       );
+  fd_ed25519_fe_sub ( r->Y, p->Y,   p->X       );
+  fd_ed25519_fe_mul4( r->Z, r->X,   q->YplusX,
+                      r->Y, r->Y,   q->YminusX,
+                      r->T, q->T2d, p->T,
+                      r->X, p->Z,   q->Z       );
+  fd_ed25519_fe_add ( t0,   r->X,   r->X       );
+  fd_ed25519_fe_sub ( r->X, r->Z,   r->Y       );
+  fd_ed25519_fe_add ( r->Y, r->Z,   r->Y       );
+  fd_ed25519_fe_add ( r->Z, t0,     r->T       );
+  fd_ed25519_fe_sub ( r->T, t0,     r->T       );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_sub( fd_ed25519_ge_p1p1_t *         r,
+                   fd_ed25519_ge_p3_t const *     p,
+                   fd_ed25519_ge_cached_t const * q ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->X, p->Y,   p->X       );
+  fd_ed25519_fe_sub ( r->Y, p->Y,   p->X       );
+  fd_ed25519_fe_mul4( r->Z, r->X,   q->YminusX,
+                      r->Y, r->Y,   q->YplusX,
+                      r->T, q->T2d, p->T,
+                      r->X, p->Z,   q->Z       );
+  fd_ed25519_fe_add ( t0,   r->X,   r->X       );
+  fd_ed25519_fe_sub ( r->X, r->Z,   r->Y       );
+  fd_ed25519_fe_add ( r->Y, r->Z,   r->Y       );
+  fd_ed25519_fe_sub ( r->Z, t0,     r->T       );
+  fd_ed25519_fe_add ( r->T, t0,     r->T       );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_madd( fd_ed25519_ge_p1p1_t *          r,
+                    fd_ed25519_ge_p3_t const *      p,
+                    fd_ed25519_ge_precomp_t const * q ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->X, p->Y,    p->X       );
+  fd_ed25519_fe_sub ( r->Y, p->Y,    p->X       );
+  fd_ed25519_fe_mul3( r->Z, r->X,    q->yplusx,
+                      r->Y, r->Y,    q->yminusx,
+                      r->T, q->xy2d, p->T       );
+  fd_ed25519_fe_add ( t0,   p->Z,    p->Z       );
+  fd_ed25519_fe_sub ( r->X, r->Z,    r->Y       );
+  fd_ed25519_fe_add ( r->Y, r->Z,    r->Y       );
+  fd_ed25519_fe_add ( r->Z, t0,      r->T       );
+  fd_ed25519_fe_sub ( r->T, t0,      r->T       );
+  return r;
+}
+
+static inline fd_ed25519_ge_p1p1_t *
+fd_ed25519_ge_msub( fd_ed25519_ge_p1p1_t *          r,
+                    fd_ed25519_ge_p3_t const *      p,
+                    fd_ed25519_ge_precomp_t const * q ) {
+  fd_ed25519_fe_t t0[1];
+  fd_ed25519_fe_add ( r->X, p->Y,    p->X       );
+  fd_ed25519_fe_sub ( r->Y, p->Y,    p->X       );
+  fd_ed25519_fe_mul3( r->Z, r->X,    q->yminusx,
+                      r->Y, r->Y,    q->yplusx,
+                      r->T, q->xy2d, p->T       );
+  fd_ed25519_fe_add ( t0,   p->Z,    p->Z       );
+  fd_ed25519_fe_sub ( r->X, r->Z,    r->Y       );
+  fd_ed25519_fe_add ( r->Y, r->Z,    r->Y       );
+  fd_ed25519_fe_sub ( r->Z, t0,      r->T       );
+  fd_ed25519_fe_add ( r->T, t0,      r->T       );
+  return r;
+}
+
+/**********************************************************************/
+
+int
+fd_ed25519_ge_frombytes_vartime( fd_ed25519_ge_p3_t * h,
+                                 uchar const *        s ) {
+
+  static const fd_ed25519_fe_t d[1] = {{
+    { 0x34dca135978a3UL, 0x1a8283b156ebdUL, 0x5e7a26001c029UL, 0x739c663a03cbbUL, 0x52036cee2b6ffUL }
+  }};
+
+  static const fd_ed25519_fe_t sqrtm1[1] = {{
+    { 0x61b274a0ea0b0UL, 0x0d5a5fc8f189dUL, 0x7ef5e9cbd0c60UL, 0x78595a6804c9eUL, 0x2b8324804fc1dUL }
+  }};
+
+  fd_ed25519_fe_t u[1];
+  fd_ed25519_fe_t v[1];
+  fd_ed25519_fe_frombytes( h->Y, s    );
+  fd_ed25519_fe_1        ( h->Z       );
+  fd_ed25519_fe_sq       ( u, h->Y    );
+  fd_ed25519_fe_mul      ( v, u, d    );
+  fd_ed25519_fe_sub      ( u, u, h->Z );    /* u = y^2-1 */
+  fd_ed25519_fe_add      ( v, v, h->Z );    /* v = dy^2+1 */
+
+  fd_ed25519_fe_t v3[1];
+  fd_ed25519_fe_sq ( v3,   v       );
+  fd_ed25519_fe_mul( v3,   v3, v   );       /* v3 = v^3 */
+  fd_ed25519_fe_sq ( h->X, v3      );      
+  fd_ed25519_fe_mul( h->X, h->X, v );      
+  fd_ed25519_fe_mul( h->X, h->X, u );       /* x = uv^7 */
+
+  fd_ed25519_fe_pow22523( h->X, h->X     ); /* x = (uv^7)^((q-5)/8) */
+  fd_ed25519_fe_mul     ( h->X, h->X, v3 );
+  fd_ed25519_fe_mul     ( h->X, h->X, u  ); /* x = uv^3(uv^7)^((q-5)/8) */
+
+  fd_ed25519_fe_t vxx  [1];
+  fd_ed25519_fe_t check[1];
+  fd_ed25519_fe_sq ( vxx,   h->X   );
+  fd_ed25519_fe_mul( vxx,   vxx, v );
+  fd_ed25519_fe_sub( check, vxx, u ); /* vx^2-u */
+  if( fd_ed25519_fe_isnonzero( check ) ) { /* unclear prob */
+    fd_ed25519_fe_add( check, vxx, u ); /* vx^2+u */
+    if( FD_UNLIKELY( fd_ed25519_fe_isnonzero( check ) ) ) return FD_ED25519_ERR_PUBKEY;
+    fd_ed25519_fe_mul( h->X, h->X, sqrtm1 );
+  }
+
+  if( fd_ed25519_fe_isnegative( h->X )!=(s[31] >> 7) ) fd_ed25519_fe_neg( h->X, h->X ); /* unclear prob */
+
+  fd_ed25519_fe_mul( h->T, h->X, h->Y );
+  return FD_ED25519_SUCCESS;
+}
+
+int
+fd_ed25519_ge_frombytes_vartime_2( fd_ed25519_ge_p3_t * h0, uchar const * s0,
+                                   fd_ed25519_ge_p3_t * h1, uchar const * s1 ) {
+
+  static const fd_ed25519_fe_t d[1] = {{
+    { 0x34dca135978a3UL, 0x1a8283b156ebdUL, 0x5e7a26001c029UL, 0x739c663a03cbbUL, 0x52036cee2b6ffUL }
+  }};
+
+  static const fd_ed25519_fe_t sqrtm1[1] = {{
+    { 0x61b274a0ea0b0UL, 0x0d5a5fc8f189dUL, 0x7ef5e9cbd0c60UL, 0x78595a6804c9eUL, 0x2b8324804fc1dUL }
+  }};
+
+  fd_ed25519_fe_t u0[1];
+  fd_ed25519_fe_t v0[1];
+  fd_ed25519_fe_t u1[1];
+  fd_ed25519_fe_t v1[1];
+  fd_ed25519_fe_frombytes  ( h0->Y, s0       );
+  fd_ed25519_fe_frombytes  ( h1->Y, s1       );
+  fd_ed25519_fe_1          ( h0->Z           );
+  fd_ed25519_fe_1          ( h1->Z           );
+  fd_ed25519_fe_sqn2       ( u0, h0->Y, 1,
+                             u1, h1->Y, 1    );
+  fd_ed25519_fe_mul2       ( v0, u0, d,
+                             v1, u1, d       );
+  fd_ed25519_fe_sub        ( u0, u0, h0->Z   );     /* u = y^2-1 */
+  fd_ed25519_fe_sub        ( u1, u1, h1->Z   );     /* u = y^2-1 */
+  fd_ed25519_fe_add        ( v0, v0, h0->Z   );     /* v = dy^2+1 */
+  fd_ed25519_fe_add        ( v1, v1, h1->Z   );     /* v = dy^2+1 */
+
+  fd_ed25519_fe_t v30_0[1]; fd_ed25519_fe_t v30_1[1];
+  fd_ed25519_fe_sqn2      ( v30_0, v0, 1,
+                            v30_1, v1, 1     );
+  fd_ed25519_fe_mul2      ( v30_0, v30_0, v0,       /* v3 = v^3 */
+                            v30_1, v30_1, v1 );     /* v3 = v^3 */
+  fd_ed25519_fe_sqn2      ( h0->X, v30_0, 1,
+                            h1->X, v30_1, 1  );
+  fd_ed25519_fe_mul2      ( h0->X, h0->X, v0,
+                            h1->X, h1->X, v1 );
+  fd_ed25519_fe_mul2      ( h0->X, h0->X, u0,       /* x = uv^7 */
+                            h1->X, h1->X, u1 );     /* x = uv^7 */
+
+  fd_ed25519_fe_pow22523_2( h0->X, h0->X,           /* x = (uv^7)^((q-5)/8) */
+                            h1->X, h1->X        );  /* x = (uv^7)^((q-5)/8) */
+  fd_ed25519_fe_mul2      ( h0->X, h0->X, v30_0,
+                            h1->X, h1->X, v30_1 );
+  fd_ed25519_fe_mul2      ( h0->X, h0->X, u0,       /* x = uv^3(uv^7)^((q-5)/8) */
+                            h1->X, h1->X, u1    );  /* x = uv^3(uv^7)^((q-5)/8) */
+
+  fd_ed25519_fe_t vxx0[1]; fd_ed25519_fe_t check0[1];
+  fd_ed25519_fe_t vxx1[1]; fd_ed25519_fe_t check1[1];
+  fd_ed25519_fe_sqn2      ( vxx0,   h0->X, 1,
+                            vxx1,   h1->X, 1 );
+  fd_ed25519_fe_mul2      ( vxx0,   vxx0, v0,
+                            vxx1,   vxx1, v1 );
+  fd_ed25519_fe_sub       ( check0, vxx0, u0 ); /* vx^2-u */
+  fd_ed25519_fe_sub       ( check1, vxx1, u1 ); /* vx^2-u */
+
+  if( fd_ed25519_fe_isnonzero( check0 ) ) { /* unclear prob */
+    fd_ed25519_fe_add( check0, vxx0, u0 );  /* vx^2+u */
+    if( FD_UNLIKELY( fd_ed25519_fe_isnonzero( check0 ) ) ) return FD_ED25519_ERR_PUBKEY;
+    fd_ed25519_fe_mul( h0->X, h0->X, sqrtm1 );
+  }
+  if( fd_ed25519_fe_isnegative( h0->X )!=(s0[31] >> 7) ) fd_ed25519_fe_neg( h0->X, h0->X ); /* unclear prob */
+  fd_ed25519_fe_mul( h0->T, h0->X, h0->Y );
+
+  if( fd_ed25519_fe_isnonzero( check1 ) ) { /* unclear prob */
+    fd_ed25519_fe_add( check1, vxx1, u1 );  /* vx^2+u */
+    if( FD_UNLIKELY( fd_ed25519_fe_isnonzero( check1 ) ) ) return FD_ED25519_ERR_PUBKEY;
+    fd_ed25519_fe_mul( h1->X, h1->X, sqrtm1 );
+  }
+  if( fd_ed25519_fe_isnegative( h1->X )!=(s1[31] >> 7) ) fd_ed25519_fe_neg( h1->X, h1->X ); /* unclear prob */
+  fd_ed25519_fe_mul( h1->T, h1->X, h1->Y );
+
+  return FD_ED25519_SUCCESS;
+}
+
+uchar *
+fd_ed25519_ge_tobytes( uchar *                    s,
+                       fd_ed25519_ge_p2_t const * h ) {
+  fd_ed25519_fe_t recip[1]; fd_ed25519_fe_invert( recip, h->Z );
+  fd_ed25519_fe_t x[1];
+  fd_ed25519_fe_t y[1];     fd_ed25519_fe_mul2( x, h->X, recip, y, h->Y, recip );
+  fd_ed25519_fe_tobytes( s, y );
+  s[31] ^= (uchar)(fd_ed25519_fe_isnegative( x ) << 7);
+  return s;
+}
+
+uchar *
+fd_ed25519_ge_p3_tobytes( uchar *                    s,
+                          fd_ed25519_ge_p3_t const * h ) {
+  fd_ed25519_fe_t recip[1]; fd_ed25519_fe_invert( recip,  h->Z  );
+  fd_ed25519_fe_t x[1];
+  fd_ed25519_fe_t y[1];     fd_ed25519_fe_mul2( x, h->X, recip, y, h->Y, recip );
+  fd_ed25519_fe_tobytes( s, y );
+  s[31] ^= (uchar)(fd_ed25519_fe_isnegative( x ) << 7);
+  return s;
+}
+
+fd_ed25519_ge_p3_t *
+fd_ed25519_ge_scalarmult_base( fd_ed25519_ge_p3_t * h,
+                               uchar const *        a ) {
+  fd_ed25519_ge_p1p1_t    r[1];
+  fd_ed25519_ge_p2_t      s[1];
+  fd_ed25519_ge_precomp_t t[1];
+
+  int e[64];
+  for( int i=0; i<32; i++ ) {
+    e[2*i+0] = (int)(( (uint)a[i]      ) & 15U);
+    e[2*i+1] = (int)((((uint)a[i]) >> 4) & 15U);
+  }
+
+  /* At this point, e[0:62] are in [0:15], e[63] is in [0:7] */
+
+  int carry = 0;
+  for( int i=0; i<63; i++ ) {
+    e[i] += carry;
+    carry = e[i] + 8;
+    carry >>= 4;
+    e[i] -= carry << 4;
+  }
+  e[63] += carry;
+
+  /* At this point, e[*] are in [-8,8] */
+
+  fd_ed25519_ge_p3_0( h );
+  for( int i=1; i<64; i+=2 ) {
+    fd_ed25519_ge_table_select( t, i/2, e[i] );
+    fd_ed25519_ge_madd        ( r, h, t );
+    fd_ed25519_ge_p1p1_to_p3  ( h, r );
+  }
+
+  fd_ed25519_ge_p3_dbl    ( r, h );
+  fd_ed25519_ge_p1p1_to_p2( s, r );
+  fd_ed25519_ge_p2_dbl    ( r, s );
+  fd_ed25519_ge_p1p1_to_p2( s, r );
+  fd_ed25519_ge_p2_dbl    ( r, s );
+  fd_ed25519_ge_p1p1_to_p2( s, r );
+  fd_ed25519_ge_p2_dbl    ( r, s );
+  fd_ed25519_ge_p1p1_to_p3( h, r );
+
+  for( int i=0; i<64; i+=2 ) {
+    fd_ed25519_ge_table_select( t, i/2, e[i] );
+    fd_ed25519_ge_madd        ( r, h, t );
+    fd_ed25519_ge_p1p1_to_p3  ( h, r    );
+  }
+
+  /* Sanitize */
+
+  fd_memset( e, 0, 64UL*sizeof(int) );
+
+  return h;
+}
+
+static int *
+fd_ed25519_ge_slide( int *         r,
+                     uchar const * a ) {
+
+  for( int i=0; i<256; i++ ) r[i] = 1 & (((uint)a[i >> 3]) >> (i & 7));
+
+  for( int i=0; i<256; i++ ) {
+    if( !r[i] ) continue;
+    for( int b=1; (b<=6) && ((i+b)<256); b++ ) {
+      if( !r[i+b] ) continue;
+      if     ( r[i] + (r[i+b] << b) <=  15 ) { r[i] += r[i+b] << b; r[i+b] = 0; }
+      else if( r[i] - (r[i+b] << b) >= -15 ) {
+        r[i] -= r[i+b] << b;
+        for( int k=i+b; k<256; k++ ) {
+          if( !r[k] ) { r[k] = 1; break; }
+          r[k] = 0;
+        }
+      } else break;
+    }
+  }
+
+  return r;
+}
+
+fd_ed25519_ge_p2_t *
+fd_ed25519_ge_double_scalarmult_vartime( fd_ed25519_ge_p2_t *       r,
+                                         uchar const *              a,
+                                         fd_ed25519_ge_p3_t const * A,
+                                         uchar const *              b ) {
+
+# include "../table/fd_ed25519_ge_bi_precomp_avx512.c"
+
+  int aslide[256]; fd_ed25519_ge_slide( aslide, a );
+  int bslide[256]; fd_ed25519_ge_slide( bslide, b );
+
+  fd_ed25519_ge_cached_t Ai[8][1]; /* A,3A,5A,7A,9A,11A,13A,15A */
+  fd_ed25519_ge_p3_t     A2[1];
+  fd_ed25519_ge_p1p1_t   t[1];
+  fd_ed25519_ge_p3_t     u[1];
+
+  fd_ed25519_ge_p3_to_cached( Ai[0], A         );
+  fd_ed25519_ge_p3_dbl      ( t,     A         );
+  fd_ed25519_ge_p1p1_to_p3  ( A2,    t         );
+  for( int i=0; i<7; i++ ) {
+    fd_ed25519_ge_add         ( t,       A2, Ai[i] );
+    fd_ed25519_ge_p1p1_to_p3  ( u,       t         );
+    fd_ed25519_ge_p3_to_cached( Ai[i+1], u         );
+  }
+
+  fd_ed25519_ge_p2_0( r );
+
+  int i;
+  for( i=255; i>=0; i-- ) if( aslide[i] || bslide[i] ) break;
+  for(      ; i>=0; i-- ) {
+    fd_ed25519_ge_p2_dbl( t, r );
+    if(      aslide[i] > 0 ) { fd_ed25519_ge_p1p1_to_p3( u, t ); fd_ed25519_ge_add ( t, u, Ai        [  aslide[i]  / 2] ); }
+    else if( aslide[i] < 0 ) { fd_ed25519_ge_p1p1_to_p3( u, t ); fd_ed25519_ge_sub ( t, u, Ai        [(-aslide[i]) / 2] ); }
+    if(      bslide[i] > 0 ) { fd_ed25519_ge_p1p1_to_p3( u, t ); fd_ed25519_ge_madd( t, u, bi_precomp[  bslide[i]  / 2] ); }
+    else if( bslide[i] < 0 ) { fd_ed25519_ge_p1p1_to_p3( u, t ); fd_ed25519_ge_msub( t, u, bi_precomp[(-bslide[i]) / 2] ); }
+    fd_ed25519_ge_p1p1_to_p2( r, t );
+  }
+
+  return r;
+}
+
+
+/* Lane parallel field element operations *****************************/
+
+/* A fd_ed25519_fe_lanes_t holds FD_ED25519_GE_LANE_CNT==8 independent
+   field elements, one per 64-bit vector lane, as 5 radix 2^51 limb
+   vectors (limb[k][l] is limb k of the lane l field element).  Limbs
+   have the same invariant as fd_ed25519_fe_t (non-negative and less
+   than 2^52 between calls).  Unlike fd_ed25519_fe_mul, where 3 of the 8
+   lanes idle and the partial products need cross lane shuffles, every
+   IFMA here does useful work: 8 products are 25 vpmadd52luq + 25
+   vpmadd52huq and the carry pass needs no shuffles at all.  These are
+   used by the lane parallel double scalar multiplication in
+   ../fd_ed25519_ge.c. */
+
+struct fd_ed25519_fe_lanes_private {
+  ulong limb[5][8] __attribute__((aligned(64)));
+};
+
+typedef struct fd_ed25519_fe_lanes_private fd_ed25519_fe_lanes_t;
+
+/* fe_lanes_carry stores into h the field elements whose limbs are
+   x0:x4 (all less than 2^63) with a single parallel carry pass (the
+   result limbs are less than 2^51 + 2^17). */
+
+static inline fd_ed25519_fe_lanes_t *
+fe_lanes_carry( fd_ed25519_fe_lanes_t * h,
+                __m512i x0, __m512i x1, __m512i x2, __m512i x3, __m512i x4 ) {
+  __m512i const m51 = _mm512_set1_epi64( (long)FD_ULONG_MASK_LSB(51) );
+  __m512i const k19 = _mm512_set1_epi64( 19L );
+  __m512i c0 = _mm512_srli_epi64( x0, 51 ); __m512i c1 = _mm512_srli_epi64( x1, 51 );
+  __m512i c2 = _mm512_srli_epi64( x2, 51 ); __m512i c3 = _mm512_srli_epi64( x3, 51 );
+  __m512i c4 = _mm512_srli_epi64( x4, 51 );
+  _mm512_store_si512( h->limb[0], _mm512_madd52lo_epu64( _mm512_and_si512( x0, m51 ), c4, k19 ) );
+  _mm512_store_si512( h->limb[1], _mm512_add_epi64( _mm512_and_si512( x1, m51 ), c0 ) );
+  _mm512_store_si512( h->limb[2], _mm512_add_epi64( _mm512_and_si512( x2, m51 ), c1 ) );
+  _mm512_store_si512( h->limb[3], _mm512_add_epi64( _mm512_and_si512( x3, m51 ), c2 ) );
+  _mm512_store_si512( h->limb[4], _mm512_add_epi64( _mm512_and_si512( x4, m51 ), c3 ) );
+  return h;
+}
+
+/* fe_lanes_reduce stores into h the field elements whose radix 2^51
+   columns are t0:t9 (all less than 2^58) */
+
+static inline fd_ed25519_fe_lanes_t *
+fe_lanes_reduce( fd_ed25519_fe_lanes_t * h,
+                 __m512i t0, __m512i t1, __m512i t2, __m512i t3, __m512i t4,
+                 __m512i t5, __m512i t6, __m512i t7, __m512i t8, __m512i t9 ) {
+# define X19(t) _mm512_add_epi64( (t), _mm512_add_epi64( _mm512_slli_epi64( (t), 1 ), _mm512_slli_epi64( (t), 4 ) ) )
+  return fe_lanes_carry( h, _mm512_add_epi64( t0, X19( t5 ) ), _mm512_add_epi64( t1, X19( t6 ) ),
+                            _mm512_add_epi64( t2, X19( t7 ) ), _mm512_add_epi64( t3, X19( t8 ) ),
+                            _mm512_add_epi64( t4, X19( t9 ) ) );
+# undef X19
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_ld( fd_ed25519_fe_lanes_t *         h,
+                        fd_ed25519_fe_t const * const * f ) { /* FD_ED25519_GE_LANE_CNT */
+  ulong   b   = (ulong)f[0]->limb;
+  __m512i idx = _mm512_setr_epi64( 0L,                        (long)((ulong)f[1]->limb - b),
+                                   (long)((ulong)f[2]->limb - b), (long)((ulong)f[3]->limb - b),
+                                   (long)((ulong)f[4]->limb - b), (long)((ulong)f[5]->limb - b),
+                                   (long)((ulong)f[6]->limb - b), (long)((ulong)f[7]->limb - b) );
+  uchar const * p = (uchar const *)f[0]->limb;
+  _mm512_store_si512( h->limb[0], _mm512_i64gather_epi64( idx, p,       1 ) );
+  _mm512_store_si512( h->limb[1], _mm512_i64gather_epi64( idx, p +  8UL, 1 ) );
+  _mm512_store_si512( h->limb[2], _mm512_i64gather_epi64( idx, p + 16UL, 1 ) );
+  _mm512_store_si512( h->limb[3], _mm512_i64gather_epi64( idx, p + 24UL, 1 ) );
+  _mm512_store_si512( h->limb[4], _mm512_i64gather_epi64( idx, p + 32UL, 1 ) );
+  return h;
+}
+
+static inline void
+fd_ed25519_fe_lanes_st( fd_ed25519_fe_t * const *     h,     /* FD_ED25519_GE_LANE_CNT */
+                        fd_ed25519_fe_lanes_t const * f ) {
+  for( ulong l=0UL; l<8UL; l++ )
+    fe_avx512_st( h[l], _mm512_setr_epi64( (long)f->limb[0][l], (long)f->limb[1][l], (long)f->limb[2][l],
+                                           (long)f->limb[3][l], (long)f->limb[4][l], 0L, 0L, 0L ) );
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_add( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f,
+                         fd_ed25519_fe_lanes_t const * g ) {
+# define ADD(k) _mm512_add_epi64( _mm512_load_si512( f->limb[k] ), _mm512_load_si512( g->limb[k] ) )
+  return fe_lanes_carry( h, ADD(0), ADD(1), ADD(2), ADD(3), ADD(4) );
+# undef ADD
+}
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_sub( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f,
+                         fd_ed25519_fe_lanes_t const * g ) {
+  __m512i const p0 = _mm512_set1_epi64( (long)(FD_ULONG_MASK_LSB(53)-75UL) ); /* 4p in limb form, see fe_avx512_4p */
+  __m512i const p1 = _mm512_set1_epi64( (long)(FD_ULONG_MASK_LSB(53)- 3UL) );
+# define SUB(k,p) _mm512_sub_epi64( _mm512_add_epi64( _mm512_load_si512( f->limb[k] ), (p) ), _mm512_load_si512( g->limb[k] ) )
+  return fe_lanes_carry( h, SUB(0,p0), SUB(1,p1), SUB(2,p1), SUB(3,p1), SUB(4,p1) );
+# undef SUB
+}
+
+/* fd_ed25519_fe_lanes_neg_if sets lane l of h to the negation of lane l
+   of f if bit l of c is set and to lane l of f otherwise. */
+
+static inline fd_ed25519_fe_lanes_t *
+fd_ed25519_fe_lanes_neg_if( fd_ed25519_fe_lanes_t *       h,
+                            fd_ed25519_fe_lanes_t const * f,
+                            ulong                         c ) {
+  __m512i const p0 = _mm512_set1_epi64( (long)(FD_ULONG_MASK_LSB(53)-75UL) );
+  __m512i const p1 = _mm512_set1_epi64( (long)(FD_ULONG_MASK_LSB(53)- 3UL) );
+  __mmask8 m = (__mmask8)c;
+# define NEG(k,p) _mm512_mask_sub_epi64( _mm512_load_si512( f->limb[k] ), m, (p), _mm512_load_si512( f->limb[k] ) )
+  return fe_lanes_carry( h, NEG(0,p0), NEG(1,p1), NEG(2,p1), NEG(3,p1), NEG(4,p1) );
+# undef NEG
+}
+
+/* fd_ed25519_fe_lanes_mul computes the 8 products f*g.  Partial
+   product f_i g_j contributes its low 52 bits to column i+j and its
+   high 52 bits to column i+j+1 (times 2 as the columns are 51 bits
+   apart).  As limbs are less than 2^52, columns are less than
+   15*2^52. */
+
+FD_FN_UNUSED static fd_ed25519_fe_lanes_t * /* Work around -Winline */
+fd_ed25519_fe_lanes_mul( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f,
+                         fd_ed25519_fe_lanes_t const * g ) {
+  __m512i f0 = _mm512_load_si512( f->limb[0] ); __m512i g0 = _mm512_load_si512( g->limb[0] );
+  __m512i f1 = _mm512_load_si512( f->limb[1] ); __m512i g1 = _mm512_load_si512( g->limb[1] );
+  __m512i f2 = _mm512_load_si512( f->limb[2] ); __m512i g2 = _mm512_load_si512( g->limb[2] );
+  __m512i f3 = _mm512_load_si512( f->limb[3] ); __m512i g3 = _mm512_load_si512( g->limb[3] );
+  __m512i f4 = _mm512_load_si512( f->limb[4] ); __m512i g4 = _mm512_load_si512( g->limb[4] );
+  __m512i z  = _mm512_setzero_si512();
+
+# define LO(a,x,y) _mm512_madd52lo_epu64( (a), (x), (y) )
+# define HI(a,x,y) _mm512_madd52hi_epu64( (a), (x), (y) )
+  __m512i l0 =          LO( z, f0,g0 );
+  __m512i l1 =       LO(LO( z, f0,g1 ), f1,g0 );
+  __m512i l2 =    LO(LO(LO( z, f0,g2 ), f1,g1 ), f2,g0 );
+  __m512i l3 = LO(LO(LO(LO( z, f0,g3 ), f1,g2 ), f2,g1 ), f3,g0 );
+  __m512i l4 = LO(LO(LO(LO(LO( z, f0,g4 ), f1,g3 ), f2,g2 ), f3,g1 ), f4,g0 );
+  __m512i l5 = LO(LO(LO(LO( z, f1,g4 ), f2,g3 ), f3,g2 ), f4,g1 );
+  __m512i l6 =    LO(LO(LO( z, f2,g4 ), f3,g3 ), f4,g2 );
+  __m512i l7 =       LO(LO( z, f3,g4 ), f4,g3 );
+  __m512i l8 =          LO( z, f4,g4 );
+  __m512i h1 =          HI( z, f0,g0 );
+  __m512i h2 =       HI(HI( z, f0,g1 ), f1,g0 );
+  __m512i h3 =    HI(HI(HI( z, f0,g2 ), f1,g1 ), f2,g0 );
+  __m512i h4 = HI(HI(HI(HI( z, f0,g3 ), f1,g2 ), f2,g1 ), f3,g0 );
+  __m512i h5 = HI(HI(HI(HI(HI( z, f0,g4 ), f1,g3 ), f2,g2 ), f3,g1 ), f4,g0 );
+  __m512i h6 = HI(HI(HI(HI( z, f1,g4 ), f2,g3 ), f3,g2 ), f4,g1 );
+  __m512i h7 =    HI(HI(HI( z, f2,g4 ), f3,g3 ), f4,g2 );
+  __m512i h8 =       HI(HI( z, f3,g4 ), f4,g3 );
+  __m512i h9 =          HI( z, f4,g4 );
+# undef HI
+# undef LO
+
+# define COL(l,h) _mm512_add_epi64( (l), _mm512_slli_epi64( (h), 1 ) )
+  return fe_lanes_reduce( h, l0, COL(l1,h1), COL(l2,h2), COL(l3,h3), COL(l4,h4),
+                             COL(l5,h5), COL(l6,h6), COL(l7,h7), COL(l8,h8), _mm512_slli_epi64( h9, 1 ) );
+# undef COL
+}
+
+/* fe_lanes_sqn computes the 8 squares f^2 (n==0) or 2 f^2 (n==1).
+   The cross products f_i f_j with i<j are computed once and doubled
+   (15+15 IFMA instead of 25+25). */
+
+static inline fd_ed25519_fe_lanes_t *
+fe_lanes_sqn( fd_ed25519_fe_lanes_t *       h,
+              fd_ed25519_fe_lanes_t const * f,
+              int                           n ) {
+  __m512i f0 = _mm512_load_si512( f->limb[0] );
+  __m512i f1 = _mm512_load_si512( f->limb[1] );
+  __m512i f2 = _mm512_load_si512( f->limb[2] );
+  __m512i f3 = _mm512_load_si512( f->limb[3] );
+  __m512i f4 = _mm512_load_si512( f->limb[4] );
+  __m512i z  = _mm512_setzero_si512();
+
+# define LO(a,x,y) _mm512_madd52lo_epu64( (a), (x), (y) )
+# define HI(a,x,y) _mm512_madd52hi_epu64( (a), (x), (y) )
+  /* Cross (x*) and diagonal (d*) terms of each column */
+  __m512i xl1 =    LO( z, f0,f1 );
+  __m512i xl2 =    LO( z, f0,f2 );                 __m512i dl2 = LO( z, f1,f1 );
+  __m512i xl3 = LO(LO( z, f0,f3 ), f1,f2 );
+  __m512i xl4 = LO(LO( z, f0,f4 ), f1,f3 );        __m512i dl4 = LO( z, f2,f2 );
+  __m512i xl5 = LO(LO( z, f1,f4 ), f2,f3 );
+  __m512i xl6 =    LO( z, f2,f4 );                 __m512i dl6 = LO( z, f3,f3 );
+  __m512i xl7 =    LO( z, f3,f4 );
+  __m512i dl0 =    LO( z, f0,f0 );                 __m512i dl8 = LO( z, f4,f4 );
+  __m512i xh2 =    HI( z, f0,f1 );
+  __m512i xh3 =    HI( z, f0,f2 );                 __m512i dh3 = HI( z, f1,f1 );
+  __m512i xh4 = HI(HI( z, f0,f3 ), f1,f2 );
+  __m512i xh5 = HI(HI( z, f0,f4 ), f1,f3 );        __m512i dh5 = HI( z, f2,f2 );
+  __m512i xh6 = HI(HI( z, f1,f4 ), f2,f3 );
+  __m512i xh7 =    HI( z, f2,f4 );                 __m512i dh7 = HI( z, f3,f3 );
+  __m512i xh8 =    HI( z, f3,f4 );
+  __m512i dh1 =    HI( z, f0,f0 );                 __m512i dh9 = HI( z, f4,f4 );
+# undef HI
+# undef LO
+
+  /* Column c is lo_c + 2 hi_c where lo_c = 2 xl_c + dl_c and hi_c = 2
+     xh_c + dh_c.  For sq2, everything is doubled one more time.  */
+
+  int s1 = 1+n; int s2 = 2+n;
+# define SL(x,s) _mm512_slli_epi64( (x), (unsigned)(s) )
+# define ADD(a,b) _mm512_add_epi64( (a), (b) )
+  __m512i t0 = SL( dl0, n );
+  __m512i t1 = ADD( SL( xl1, s1 ),                      SL( dh1, s1 ) );
+  __m512i t2 = ADD( ADD( SL( xl2, s1 ), SL( dl2, n ) ), SL( xh2, s2 ) );
+  __m512i t3 = ADD( ADD( SL( xl3, s1 ), SL( xh3, s2 ) ), SL( dh3, s1 ) );
+  __m512i t4 = ADD( ADD( SL( xl4, s1 ), SL( dl4, n ) ), SL( xh4, s2 ) );
+  __m512i t5 = ADD( ADD( SL( xl5, s1 ), SL( xh5, s2 ) ), SL( dh5, s1 ) );
+  __m512i t6 = ADD( ADD( SL( xl6, s1 ), SL( dl6, n ) ), SL( xh6, s2 ) );
+  __m512i t7 = ADD( ADD( SL( xl7, s1 ), SL( xh7, s2 ) ), SL( dh7, s1 ) );
+  __m512i t8 = ADD(      SL( dl8, n ),                  SL( xh8, s2 ) );
+  __m512i t9 =                                          SL( dh9, s1 );
+# undef ADD
+# undef SL
+
+  return fe_lanes_reduce( h, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9 );
+}
+
+FD_FN_UNUSED static fd_ed25519_fe_lanes_t * /* Work around -Winline */
+fd_ed25519_fe_lanes_sq( fd_ed25519_fe_lanes_t *       h,
+                        fd_ed25519_fe_lanes_t const * f ) {
+  return fe_lanes_sqn( h, f, 0 );
+}
+
+FD_FN_UNUSED static fd_ed25519_fe_lanes_t * /* Work around -Winline */
+fd_ed25519_fe_lanes_sq2( fd_ed25519_fe_lanes_t *       h,
+                         fd_ed25519_fe_lanes_t const * f ) {
+  return fe_lanes_sqn( h, f, 1 );
+}
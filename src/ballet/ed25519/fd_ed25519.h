@@ -100,6 +100,175 @@ fd_ed25519_verify( void const *  msg,
                    void const *  public_key,
                    fd_sha512_t * sha );
 
+/* fd_ed25519_pubkey_cache_t is an opaque handle of a join to a cache of
+   decompressed public keys.  Decompressing a public key costs a field
+   exponentiation (a few percent of a signature verification) and a
+   small set of hot signers (fee payers, vote authorities, etc)
+   typically accounts for most of the signatures seen by a verifier.
+   Passing a cache to fd_ed25519_verify_batch / fd_ed25519_verify_multi
+   skips this for public keys that recently had a signature verify
+   successfully.  Results are identical with and without a cache.
+
+   The cache holds up to key_max public keys.  When full, inserting a
+   new public key evicts an entry that has not been used recently
+   (CLOCK approximation of LRU).  Public keys are only inserted after
+   they have been used to verify a signature successfully such that
+   garbage signatures cannot be used to flush hot signers out of the
+   cache.  A cache can be located in a workspace but should only be
+   used by one thread at a time. */
+
+#define FD_ED25519_PUBKEY_CACHE_ALIGN (128UL)
+
+struct fd_ed25519_pubkey_cache_private;
+typedef struct fd_ed25519_pubkey_cache_private fd_ed25519_pubkey_cache_t;
+
+/* fd_ed25519_pubkey_cache_{align,footprint} return the alignment and
+   footprint required for a memory region to be used as a pubkey cache
+   that can hold up to key_max public keys.  footprint returns 0 if
+   key_max is not in [1,2^32) (the footprint is a few hundred bytes per
+   key).
+
+   fd_ed25519_pubkey_cache_new formats a memory region with the
+   appropriate alignment and footprint into an empty pubkey cache.
+   seed selects the hash function used internally (to make it hard for
+   somebody who can choose public keys to degrade performance, this
+   should be an unpredictable value).  Returns shmem on success and
+   NULL on failure (logs details).  Caller is not joined on return.
+
+   fd_ed25519_pubkey_cache_join joins the caller to a pubkey cache.
+   Returns a handle to the caller's local join on success and NULL on
+   failure (logs details).
+
+   fd_ed25519_pubkey_cache_leave leaves a current local join.  Returns
+   the underlying shared memory region on success and NULL on failure
+   (logs details).
+
+   fd_ed25519_pubkey_cache_delete unformats a memory region used as a
+   pubkey cache.  Assumes nobody is joined.  Returns shmem on success
+   and NULL on failure (logs details). */
+
+FD_FN_CONST ulong
+fd_ed25519_pubkey_cache_align( void );
+
+FD_FN_CONST ulong
+fd_ed25519_pubkey_cache_footprint( ulong key_max );
+
+void *
+fd_ed25519_pubkey_cache_new( void * shmem,
+                             ulong  key_max,
+                             ulong  seed );
+
+fd_ed25519_pubkey_cache_t *
+fd_ed25519_pubkey_cache_join( void * shcache );
+
+void *
+fd_ed25519_pubkey_cache_leave( fd_ed25519_pubkey_cache_t * cache );
+
+void *
+fd_ed25519_pubkey_cache_delete( void * shcache );
+
+/* fd_ed25519_pubkey_cache_{key_max,key_cnt} return the maximum / current
+   number of public keys in the cache.
+
+   fd_ed25519_pubkey_cache_{hit_cnt,miss_cnt} return the number of
+   public key lookups that found / did not find the public key in the
+   cache since the cache was created.  (A signature that needs to be
+   rechecked individually after a failed batch equation is looked up
+   again.) */
+
+FD_FN_PURE ulong fd_ed25519_pubkey_cache_key_max ( fd_ed25519_pubkey_cache_t const * cache );
+FD_FN_PURE ulong fd_ed25519_pubkey_cache_key_cnt ( fd_ed25519_pubkey_cache_t const * cache );
+FD_FN_PURE ulong fd_ed25519_pubkey_cache_hit_cnt ( fd_ed25519_pubkey_cache_t const * cache );
+FD_FN_PURE ulong fd_ed25519_pubkey_cache_miss_cnt( fd_ed25519_pubkey_cache_t const * cache );
+
+/* FD_ED25519_VERIFY_BATCH_MAX is the number of signatures
+   fd_ed25519_verify_batch checks with a single batch equation.  Larger
+   batches are processed in chunks of this many signatures. */
+
+#define FD_ED25519_VERIFY_BATCH_MAX (32UL)
+
+/* fd_ed25519_verify_batch verifies cnt messages according to the
+   ED25519 standard.  msg[i], sz[i], sig[i] and public_key[i] for i in
+   [0,cnt) have the same interpretation as the corresponding arguments
+   of fd_ed25519_verify.  err[i] will hold the result of verifying
+   signature i on return.  sha is a handle of a local join to a sha512
+   calculator.  cache is a handle of a local join to a pubkey cache
+   used to skip public key decompressions (NULL if none).
+
+   Signatures are checked FD_ED25519_VERIFY_BATCH_MAX at a time with a
+   random linear combination of the verification equations:
+
+     sum_i z_i ( [s_i]B - R_i - [h_i]A_i ) == 0
+
+   evaluated with a single multi-scalar multiplication (the z_i are
+   128-bit coefficients derived by hashing all the signatures, public
+   keys and message hashes in the batch such that they cannot be chosen
+   in advance by whoever provided the signatures).  If this batch
+   equation holds, err[i] is FD_ED25519_SUCCESS for all signatures in
+   the batch.  If not, or if any signature in the batch is obviously
+   malformed, the signatures in the batch are checked individually
+   (with fd_ed25519_verify / fd_ed25519_verify_multi) and err[i] is the
+   fd_ed25519_verify result.
+
+   A batch of signatures that each pass fd_ed25519_verify always passes
+   the batch equation.  The converse only holds (except with negligible
+   probability) when the R_i and A_i are in the prime order subgroup, as
+   small order components of different signatures can cancel out in the
+   batch equation.  Signatures whose R_i or A_i have a small order
+   component are therefore checked individually with fd_ed25519_verify
+   before the batch equation.  Thus err[i] always matches
+   fd_ed25519_verify.  The subgroup check of R_i costs a scalar
+   multiplication per signature (done in SIMD lanes like
+   fd_ed25519_verify_multi) and A_i found in the cache are only checked
+   once.  As such, this is slower per signature than
+   fd_ed25519_verify_multi on all supported targets (even when most
+   public keys are cached) and fd_ed25519_verify_multi should be
+   preferred for throughput.
+
+   Does no input argument checking.  Returns FD_ED25519_SUCCESS if all
+   signatures verified successfully and the first FD_ED25519_ERR_* code
+   in err otherwise.  Uses a few hundred KiB of stack. */
+
+int
+fd_ed25519_verify_batch( void const * const *        msg,
+                         ulong const *               sz,
+                         void const * const *        sig,
+                         void const * const *        public_key,
+                         int *                       err,
+                         ulong                       cnt,
+                         fd_sha512_t *               sha,
+                         fd_ed25519_pubkey_cache_t * cache );
+
+/* fd_ed25519_verify_multi verifies cnt messages according to the
+   ED25519 standard.  msg[i], sz[i], sig[i] and public_key[i] for i in
+   [0,cnt) have the same interpretation as the corresponding arguments
+   of fd_ed25519_verify.  err[i] will hold exactly what fd_ed25519_verify
+   would return for signature i on return.  sha is a handle of a local
+   join to a sha512 calculator.  cache is a handle of a local join to a
+   pubkey cache used to skip public key decompressions (NULL if none).
+
+   This does the same work per signature as fd_ed25519_verify but runs
+   the double scalar multiplications of several signatures in lockstep,
+   one signature per SIMD lane (8 lanes on targets with AVX-512 IFMA, 4
+   on targets with AVX and 1, i.e. no benefit, otherwise).  This
+   improves throughput per core but not the latency of an individual
+   signature.  Unlike fd_ed25519_verify_batch, the cost does not depend
+   on how many signatures in the set are invalid.
+
+   Does no input argument checking.  Returns FD_ED25519_SUCCESS if all
+   signatures verified successfully and the first FD_ED25519_ERR_* code
+   in err otherwise.  Uses tens of KiB of stack. */
+
+int
+fd_ed25519_verify_multi( void const * const *        msg,
+                         ulong const *               sz,
+                         void const * const *        sig,
+                         void const * const *        public_key,
+                         int *                       err,
+                         ulong                       cnt,
+                         fd_sha512_t *               sha,
+                         fd_ed25519_pubkey_cache_t * cache );
+
 /* fd_ed25519_strerror converts an FD_ED25519_SUCCESS / FD_ED25519_ERR_*
    code into a human readable cstr.  The lifetime of the returned
    pointer is infinite.  The returned pointer is always to a non-NULL
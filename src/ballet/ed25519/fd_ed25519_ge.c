@@ -4,7 +4,370 @@
 #include "ref/fd_ed25519_ge.c"
 #elif FD_ED25519_FE_IMPL==1
 #include "avx/fd_ed25519_ge.c"
+#elif FD_ED25519_FE_IMPL==2
+#include "avx512/fd_ed25519_ge.c"
 #else
 #error "Unsupported FD_ED25519_FE_IMPL"
 #endif
 
+
+/* Implementation agnostic group element operations *******************/
+
+fd_ed25519_ge_p2_t *
+fd_ed25519_ge_multi_scalarmult_vartime( fd_ed25519_ge_p2_t *       r,
+                                        ulong                      cnt,
+                                        uchar const *              a,
+                                        fd_ed25519_ge_p3_t const * A ) {
+
+  /* This is a straightforward generalization of the interleaved sliding
+     window method used by fd_ed25519_ge_double_scalarmult_vartime (a.k.a.
+     Straus' method).  The doublings are shared by all the points and
+     each point only costs the additions for its non-zero window digits
+     (plus 8 additions to build its table of odd multiples).  Scalars
+     that are much shorter than 256 bits (e.g. random batch
+     verification coefficients) are naturally cheap as the digits above
+     their most significant bit are zero. */
+
+  schar                  slide[ FD_ED25519_GE_MSM_MAX ][ 256 ];
+  fd_ed25519_ge_cached_t Ai   [ FD_ED25519_GE_MSM_MAX ][ 8   ][1]; /* A,3A,5A,7A,9A,11A,13A,15A */
+
+  fd_ed25519_ge_p1p1_t t[1];
+  fd_ed25519_ge_p3_t   u[1];
+  fd_ed25519_ge_p3_t   A2[1];
+
+  int top = -1;
+  for( ulong j=0UL; j<cnt; j++ ) {
+    int tmp[256]; fd_ed25519_ge_slide( tmp, a + 32UL*j );
+    for( int i=0; i<256; i++ ) {
+      slide[j][i] = (schar)tmp[i];
+      if( tmp[i] ) top = fd_int_max( top, i );
+    }
+
+    fd_ed25519_ge_p3_to_cached( Ai[j][0], A+j       );
+    fd_ed25519_ge_p3_dbl      ( t,        A+j       );
+    fd_ed25519_ge_p1p1_to_p3  ( A2,       t         );
+    for( int i=0; i<7; i++ ) {
+      fd_ed25519_ge_add         ( t,          A2, Ai[j][i] );
+      fd_ed25519_ge_p1p1_to_p3  ( u,          t            );
+      fd_ed25519_ge_p3_to_cached( Ai[j][i+1], u            );
+    }
+  }
+
+  fd_ed25519_ge_p2_0( r );
+
+  for( int i=top; i>=0; i-- ) {
+    fd_ed25519_ge_p2_dbl( t, r );
+    for( ulong j=0UL; j<cnt; j++ ) {
+      int d = (int)slide[j][i];
+      if(      d>0 ) { fd_ed25519_ge_p1p1_to_p3( u, t ); fd_ed25519_ge_add( t, u, Ai[j][   d  / 2 ] ); }
+      else if( d<0 ) { fd_ed25519_ge_p1p1_to_p3( u, t ); fd_ed25519_ge_sub( t, u, Ai[j][ (-d) / 2 ] ); }
+    }
+    fd_ed25519_ge_p1p1_to_p2( r, t );
+  }
+
+  return r;
+}
+
+#if FD_ED25519_GE_LANE_CNT>1
+
+/* Lane parallel group element operations *****************************/
+
+/* These mirror the ref group element operations with each field element
+   replaced by FD_ED25519_GE_LANE_CNT field elements of independent
+   group elements (one per SIMD lane).  The field element sequences are
+   identical to the ref ones such that the ref limb bound analysis
+   carries over to implementations that do not reduce on add / sub. */
+
+struct fd_ed25519_ge_lanes_private {
+  fd_ed25519_fe_lanes_t X[1];
+  fd_ed25519_fe_lanes_t Y[1];
+  fd_ed25519_fe_lanes_t Z[1];
+  fd_ed25519_fe_lanes_t T[1]; /* p3 and p1p1 only */
+};
+
+typedef struct fd_ed25519_ge_lanes_private fd_ed25519_ge_lanes_t;
+
+/* fd_ed25519_ge_lanes_p2_dbl computes the p1p1 r = 2 p for p2 p */
+
+static inline fd_ed25519_ge_lanes_t *
+fd_ed25519_ge_lanes_p2_dbl( fd_ed25519_ge_lanes_t *       r,
+                            fd_ed25519_ge_lanes_t const * p ) {
+  fd_ed25519_fe_lanes_t t0[1];
+  fd_ed25519_fe_lanes_sq ( r->X, p->X       );
+  fd_ed25519_fe_lanes_sq ( r->Z, p->Y       );
+  fd_ed25519_fe_lanes_sq2( r->T, p->Z       );
+  fd_ed25519_fe_lanes_add( r->Y, p->X, p->Y );
+  fd_ed25519_fe_lanes_sq ( t0,   r->Y       );
+  fd_ed25519_fe_lanes_add( r->Y, r->Z, r->X );
+  fd_ed25519_fe_lanes_sub( r->Z, r->Z, r->X );
+  fd_ed25519_fe_lanes_sub( r->X, t0,   r->Y );
+  fd_ed25519_fe_lanes_sub( r->T, r->T, r->Z );
+  return r;
+}
+
+/* fd_ed25519_ge_lanes_p1p1_to_p2 / p1p1_to_p3 convert the p1p1 p into
+   the p2 / p3 r.  In-place not fine. */
+
+static inline fd_ed25519_ge_lanes_t *
+fd_ed25519_ge_lanes_p1p1_to_p2( fd_ed25519_ge_lanes_t *       r,
+                                fd_ed25519_ge_lanes_t const * p ) {
+  fd_ed25519_fe_lanes_mul( r->X, p->X, p->T );
+  fd_ed25519_fe_lanes_mul( r->Y, p->Y, p->Z );
+  fd_ed25519_fe_lanes_mul( r->Z, p->Z, p->T );
+  return r;
+}
+
+static inline fd_ed25519_ge_lanes_t *
+fd_ed25519_ge_lanes_p1p1_to_p3( fd_ed25519_ge_lanes_t *       r,
+                                fd_ed25519_ge_lanes_t const * p ) {
+  fd_ed25519_fe_lanes_mul( r->X, p->X, p->T );
+  fd_ed25519_fe_lanes_mul( r->Y, p->Y, p->Z );
+  fd_ed25519_fe_lanes_mul( r->Z, p->Z, p->T );
+  fd_ed25519_fe_lanes_mul( r->T, p->X, p->Y );
+  return r;
+}
+
+/* fd_ed25519_ge_lanes_add computes the p1p1 r = p + q for the p3 p and
+   the cached q (YplusX,YminusX,Z,T2d).  fd_ed25519_ge_lanes_madd
+   computes the p1p1 r = p + q for the p3 p and the precomp q
+   (yplusx,yminusx,xy2d), i.e. q with an implied Z of 1.  Subtraction
+   is done by the caller loading q with YplusX / YminusX swapped and
+   T2d negated. */
+
+static inline fd_ed25519_ge_lanes_t *
+fd_ed25519_ge_lanes_add( fd_ed25519_ge_lanes_t *       r,
+                         fd_ed25519_ge_lanes_t const * p,
+                         fd_ed25519_fe_lanes_t const * q_YplusX,
+                         fd_ed25519_fe_lanes_t const * q_YminusX,
+                         fd_ed25519_fe_lanes_t const * q_Z,
+                         fd_ed25519_fe_lanes_t const * q_T2d ) {
+  fd_ed25519_fe_lanes_t t0[1];
+  fd_ed25519_fe_lanes_add( r->X, p->Y,  p->X      );
+  fd_ed25519_fe_lanes_sub( r->Y, p->Y,  p->X      );
+  fd_ed25519_fe_lanes_mul( r->Z, r->X,  q_YplusX  );
+  fd_ed25519_fe_lanes_mul( r->Y, r->Y,  q_YminusX );
+  fd_ed25519_fe_lanes_mul( r->T, q_T2d, p->T      );
+  fd_ed25519_fe_lanes_mul( r->X, p->Z,  q_Z       );
+  fd_ed25519_fe_lanes_add( t0,   r->X,  r->X      );
+  fd_ed25519_fe_lanes_sub( r->X, r->Z,  r->Y      );
+  fd_ed25519_fe_lanes_add( r->Y, r->Z,  r->Y      );
+  fd_ed25519_fe_lanes_add( r->Z, t0,    r->T      );
+  fd_ed25519_fe_lanes_sub( r->T, t0,    r->T      );
+  return r;
+}
+
+static inline fd_ed25519_ge_lanes_t *
+fd_ed25519_ge_lanes_madd( fd_ed25519_ge_lanes_t *       r,
+                          fd_ed25519_ge_lanes_t const * p,
+                          fd_ed25519_fe_lanes_t const * q_yplusx,
+                          fd_ed25519_fe_lanes_t const * q_yminusx,
+                          fd_ed25519_fe_lanes_t const * q_xy2d ) {
+  fd_ed25519_fe_lanes_t t0[1];
+  fd_ed25519_fe_lanes_add( r->X, p->Y,   p->X      );
+  fd_ed25519_fe_lanes_sub( r->Y, p->Y,   p->X      );
+  fd_ed25519_fe_lanes_mul( r->Z, r->X,   q_yplusx  );
+  fd_ed25519_fe_lanes_mul( r->Y, r->Y,   q_yminusx );
+  fd_ed25519_fe_lanes_mul( r->T, q_xy2d, p->T      );
+  fd_ed25519_fe_lanes_add( t0,   p->Z,   p->Z      );
+  fd_ed25519_fe_lanes_sub( r->X, r->Z,   r->Y      );
+  fd_ed25519_fe_lanes_add( r->Y, r->Z,   r->Y      );
+  fd_ed25519_fe_lanes_add( r->Z, t0,     r->T      );
+  fd_ed25519_fe_lanes_sub( r->T, t0,     r->T      );
+  return r;
+}
+
+/* fd_ed25519_ge_lanes_recode writes the 64 signed radix 16 digits (in
+   [-8,8]) of the 32-byte little endian scalar a (less than 2^255) into
+   e, least significant first (same as fd_ed25519_ge_scalarmult_base). */
+
+static inline void
+fd_ed25519_ge_lanes_recode( schar *       e,     /* 64 */
+                            uchar const * a ) {  /* 32 */
+  for( int i=0; i<32; i++ ) {
+    e[2*i+0] = (schar)(a[i] & 15);
+    e[2*i+1] = (schar)(a[i] >> 4);
+  }
+  int carry = 0;
+  for( int i=0; i<63; i++ ) {
+    int d = (int)e[i] + carry;
+    carry = (d + 8) >> 4;
+    e[i]  = (schar)(d - (carry << 4));
+  }
+  e[63] = (schar)((int)e[63] + carry); /* a<2^255 so this is at most 8 */
+}
+
+fd_ed25519_ge_p2_t *
+fd_ed25519_ge_double_scalarmult_vartime_lanes( fd_ed25519_ge_p2_t *       r,
+                                               uchar const *              a,
+                                               fd_ed25519_ge_p3_t const * A,
+                                               uchar const *              b ) {
+
+  /* Unlike fd_ed25519_ge_double_scalarmult_vartime, which only adds on
+     the (scalar dependent) non-zero sliding window digits, all lanes
+     have to do the same operation at the same time here.  So this uses
+     fixed width signed radix 16 windows: 4 doublings and 2 additions
+     per window for every lane.  This is a bit more group arithmetic
+     per signature than the sliding window but every SIMD lane does
+     useful work for its own signature the entire time.
+
+     The multiples of A_l are computed per lane into Ai[l][0:8] (Ai[l][j]
+     = j A_l with Ai[l][0] the identity) and the multiples of B come
+     straight from the k25519_precomp[0] table used by
+     fd_ed25519_ge_scalarmult_base (k25519_precomp[0][j-1] = j B).  A
+     table lookup then is just picking per lane pointers to the right
+     entries (and swapping the pointers of the + / - coordinates for
+     negative digits) and loading them into lanes. */
+
+# define LANE_CNT FD_ED25519_GE_LANE_CNT
+
+  schar ea[ LANE_CNT ][ 64 ];
+  schar eb[ LANE_CNT ][ 64 ];
+  for( ulong l=0UL; l<LANE_CNT; l++ ) {
+    fd_ed25519_ge_lanes_recode( ea[l], a + 32UL*l );
+    fd_ed25519_ge_lanes_recode( eb[l], b + 32UL*l );
+  }
+
+  fd_ed25519_ge_cached_t  Ai[ LANE_CNT ][ 9 ][1];
+  fd_ed25519_ge_precomp_t B0[1]; fd_ed25519_ge_precomp_0( B0 );
+
+  fd_ed25519_fe_t const * p0[ LANE_CNT ];
+  fd_ed25519_fe_t const * p1[ LANE_CNT ];
+  fd_ed25519_fe_t const * p2[ LANE_CNT ];
+  fd_ed25519_fe_t const * p3[ LANE_CNT ];
+  fd_ed25519_fe_t *       q0[ LANE_CNT ];
+  fd_ed25519_fe_t *       q1[ LANE_CNT ];
+  fd_ed25519_fe_t *       q2[ LANE_CNT ];
+  fd_ed25519_fe_t *       q3[ LANE_CNT ];
+
+  fd_ed25519_fe_lanes_t q_YplusX[1]; fd_ed25519_fe_lanes_t q_YminusX[1];
+  fd_ed25519_fe_lanes_t q_Z     [1]; fd_ed25519_fe_lanes_t q_T2d    [1];
+
+  fd_ed25519_ge_lanes_t u[1];
+  fd_ed25519_ge_lanes_t t[1];
+  fd_ed25519_ge_lanes_t v[1];
+
+  /* Compute Ai.  q_* holds A_l in cached form and u holds j A_l */
+
+  do {
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      fd_ed25519_ge_cached_t * c = Ai[l][0];
+      fd_ed25519_fe_1( c->YplusX ); fd_ed25519_fe_1( c->YminusX ); fd_ed25519_fe_1( c->Z ); fd_ed25519_fe_0( c->T2d );
+      p0[l] = A[l].X; p1[l] = A[l].Y; p2[l] = A[l].Z; p3[l] = A[l].T;
+    }
+    fd_ed25519_fe_lanes_ld( u->X, p0 ); fd_ed25519_fe_lanes_ld( u->Y, p1 );
+    fd_ed25519_fe_lanes_ld( u->Z, p2 ); fd_ed25519_fe_lanes_ld( u->T, p3 );
+
+    for( ulong l=0UL; l<LANE_CNT; l++ ) p0[l] = fd_ed25519_ge_d2;
+    fd_ed25519_fe_lanes_t d2[1]; fd_ed25519_fe_lanes_ld( d2, p0 );
+
+    fd_ed25519_fe_lanes_add( q_YplusX,  u->Y, u->X );
+    fd_ed25519_fe_lanes_sub( q_YminusX, u->Y, u->X );
+    *q_Z = *u->Z;
+    fd_ed25519_fe_lanes_mul( q_T2d,     u->T, d2   );
+
+    for( ulong j=1UL; j<9UL; j++ ) {
+      if( j>1UL ) {
+        fd_ed25519_ge_lanes_add       ( t, u, q_YplusX, q_YminusX, q_Z, q_T2d );
+        fd_ed25519_ge_lanes_p1p1_to_p3( u, t );
+      }
+      fd_ed25519_fe_lanes_t c[1];
+      for( ulong l=0UL; l<LANE_CNT; l++ ) {
+        q0[l] = Ai[l][j]->YplusX; q1[l] = Ai[l][j]->YminusX; q2[l] = Ai[l][j]->Z; q3[l] = Ai[l][j]->T2d;
+      }
+      fd_ed25519_fe_lanes_add( c, u->Y, u->X ); fd_ed25519_fe_lanes_st( q0, c    );
+      fd_ed25519_fe_lanes_sub( c, u->Y, u->X ); fd_ed25519_fe_lanes_st( q1, c    );
+      /**/                                      fd_ed25519_fe_lanes_st( q2, u->Z );
+      fd_ed25519_fe_lanes_mul( c, u->T, d2   ); fd_ed25519_fe_lanes_st( q3, c    );
+    }
+  } while(0);
+
+  /* r = identity (as a p2 in v) */
+
+  for( ulong l=0UL; l<LANE_CNT; l++ ) { p0[l] = B0->xy2d; p1[l] = B0->yplusx; }
+  fd_ed25519_fe_lanes_ld( v->X, p0 ); fd_ed25519_fe_lanes_ld( v->Y, p1 ); fd_ed25519_fe_lanes_ld( v->Z, p1 );
+
+  for( int i=63; i>=0; i-- ) {
+
+    /* v = 16 v */
+
+    fd_ed25519_ge_lanes_p2_dbl    ( t, v );
+    fd_ed25519_ge_lanes_p1p1_to_p2( v, t );
+    fd_ed25519_ge_lanes_p2_dbl    ( t, v );
+    fd_ed25519_ge_lanes_p1p1_to_p2( v, t );
+    fd_ed25519_ge_lanes_p2_dbl    ( t, v );
+    fd_ed25519_ge_lanes_p1p1_to_p2( v, t );
+    fd_ed25519_ge_lanes_p2_dbl    ( t, v );
+
+    /* v += ea[i] A (t holds v as a p1p1) */
+
+    ulong neg = 0UL;
+    ulong any = 0UL;
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      int d = (int)ea[l][i];
+      fd_ed25519_ge_cached_t const * c = Ai[l][ fd_int_abs( d ) ];
+      int s = d<0;
+      p0[l] = s ? c->YminusX : c->YplusX;
+      p1[l] = s ? c->YplusX  : c->YminusX;
+      p2[l] = c->Z;
+      p3[l] = c->T2d;
+      neg  |= ((ulong)s) << l;
+      any  |= (ulong)d;
+    }
+    if( FD_LIKELY( any ) ) { /* Vanishingly rare for all lanes to have a zero digit */
+      fd_ed25519_fe_lanes_ld    ( q_YplusX,  p0 );
+      fd_ed25519_fe_lanes_ld    ( q_YminusX, p1 );
+      fd_ed25519_fe_lanes_ld    ( q_Z,       p2 );
+      fd_ed25519_fe_lanes_ld    ( q_T2d,     p3 );
+      fd_ed25519_fe_lanes_neg_if( q_T2d, q_T2d, neg );
+      fd_ed25519_ge_lanes_p1p1_to_p3( u, t );
+      fd_ed25519_ge_lanes_add       ( t, u, q_YplusX, q_YminusX, q_Z, q_T2d );
+    }
+
+    /* v += eb[i] B */
+
+    neg = 0UL;
+    any = 0UL;
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      int d = (int)eb[l][i];
+      fd_ed25519_ge_precomp_t const * c = d ? k25519_precomp[0][ fd_int_abs( d )-1 ] : B0;
+      int s = d<0;
+      p0[l] = s ? c->yminusx : c->yplusx;
+      p1[l] = s ? c->yplusx  : c->yminusx;
+      p2[l] = c->xy2d;
+      neg  |= ((ulong)s) << l;
+      any  |= (ulong)d;
+    }
+    if( FD_LIKELY( any ) ) {
+      fd_ed25519_fe_lanes_ld    ( q_YplusX,  p0 );
+      fd_ed25519_fe_lanes_ld    ( q_YminusX, p1 );
+      fd_ed25519_fe_lanes_ld    ( q_T2d,     p2 );
+      fd_ed25519_fe_lanes_neg_if( q_T2d, q_T2d, neg );
+      fd_ed25519_ge_lanes_p1p1_to_p3( u, t );
+      fd_ed25519_ge_lanes_madd      ( t, u, q_YplusX, q_YminusX, q_T2d );
+    }
+
+    fd_ed25519_ge_lanes_p1p1_to_p2( v, t );
+  }
+
+  for( ulong l=0UL; l<LANE_CNT; l++ ) { q0[l] = r[l].X; q1[l] = r[l].Y; q2[l] = r[l].Z; }
+  fd_ed25519_fe_lanes_st( q0, v->X );
+  fd_ed25519_fe_lanes_st( q1, v->Y );
+  fd_ed25519_fe_lanes_st( q2, v->Z );
+
+# undef LANE_CNT
+
+  return r;
+}
+
+#else
+
+fd_ed25519_ge_p2_t *
+fd_ed25519_ge_double_scalarmult_vartime_lanes( fd_ed25519_ge_p2_t *       r,
+                                               uchar const *              a,
+                                               fd_ed25519_ge_p3_t const * A,
+                                               uchar const *              b ) {
+  fd_ed25519_ge_double_scalarmult_vartime( r, a, A, b );
+  return r;
+}
+
+#endif
@@ -5,8 +5,17 @@
 
 /* Field element API **************************************************/
 
+/* FD_ED25519_FE_IMPL selects the field element implementation (and the
+   matching group element implementation): 0 is the portable ref
+   implementation (radix 2^25.5 in 32-bit limbs), 1 is the 4-way AVX2
+   implementation and 2 is the AVX-512 IFMA implementation (radix 2^51
+   in 52-bit multiplier friendly 64-bit limbs).  Defaults to the
+   fastest implementation supported by the build target. */
+
 #ifndef FD_ED25519_FE_IMPL
-#if FD_HAS_AVX
+#if FD_HAS_AVX512
+#define FD_ED25519_FE_IMPL 2
+#elif FD_HAS_AVX
 #define FD_ED25519_FE_IMPL 1
 #else
 #define FD_ED25519_FE_IMPL 0
@@ -17,6 +26,8 @@
 #include "ref/fd_ed25519_fe.h"
 #elif FD_ED25519_FE_IMPL==1
 #include "avx/fd_ed25519_fe.h"
+#elif FD_ED25519_FE_IMPL==2
+#include "avx512/fd_ed25519_fe.h"
 #else
 #error "Unsupported FD_ED25519_FE_IMPL"
 #endif
@@ -95,6 +106,92 @@ fd_ed25519_ge_double_scalarmult_vartime( fd_ed25519_ge_p2_t *       r,
                                          fd_ed25519_ge_p3_t const * A,
                                          uchar const *              b );
 
+/* FD_ED25519_GE_MSM_MAX is the maximum number of points that can be
+   used in a single fd_ed25519_ge_multi_scalarmult_vartime.  This is
+   sized such that a full fd_ed25519_verify_batch batch (2 points per
+   signature plus the base point) fits in one call. */
+
+#define FD_ED25519_GE_MSM_MAX (2UL*FD_ED25519_VERIFY_BATCH_MAX+1UL)
+
+/* fd_ed25519_ge_multi_scalarmult_vartime computes:
+
+     r = sum_j [a_j] A_j
+
+   for j in [0,cnt) in variable time.  a points to cnt 32-byte little
+   endian scalars stored contiguously (a_j is at a+32*j) and A points to
+   cnt group elements.  cnt should be in [0,FD_ED25519_GE_MSM_MAX].
+   Uses a few KiB of stack per point (sized for FD_ED25519_GE_MSM_MAX
+   points).  Returns r.  This should only be used on public data. */
+
+fd_ed25519_ge_p2_t *
+fd_ed25519_ge_multi_scalarmult_vartime( fd_ed25519_ge_p2_t *       r,
+                                        ulong                      cnt,
+                                        uchar const *              a,
+                                        fd_ed25519_ge_p3_t const * A );
+
+/* FD_ED25519_GE_LANE_CNT is the number of independent double scalar
+   multiplications fd_ed25519_ge_double_scalarmult_vartime_lanes does
+   in lockstep (one per SIMD lane of the field element implementation).
+   The ref implementation has no lanes and just does them one at a
+   time. */
+
+#if FD_ED25519_FE_IMPL==0
+#define FD_ED25519_GE_LANE_CNT (1UL)
+#elif FD_ED25519_FE_IMPL==1
+#define FD_ED25519_GE_LANE_CNT (4UL)
+#else
+#define FD_ED25519_GE_LANE_CNT (8UL)
+#endif
+
+/* fd_ed25519_ge_double_scalarmult_vartime_lanes computes:
+
+     r[l] = [a_l] A[l] + [b_l] B
+
+   for l in [0,FD_ED25519_GE_LANE_CNT) where B is the base point and a_l
+   and b_l are the 32-byte little endian scalars at a+32*l and b+32*l.
+   Each r[l] is the same group element that
+   fd_ed25519_ge_double_scalarmult_vartime would produce for lane l
+   (though not necessarily with the same representation).  Scalars must
+   be less than 2^255 (e.g. reduced mod l).  All lanes are always
+   computed; callers with fewer than FD_ED25519_GE_LANE_CNT live lanes
+   should fill the rest with zero scalars and the identity.  Returns r.
+   This should only be used on public data. */
+
+fd_ed25519_ge_p2_t *
+fd_ed25519_ge_double_scalarmult_vartime_lanes( fd_ed25519_ge_p2_t *       r,   /* FD_ED25519_GE_LANE_CNT */
+                                               uchar const *              a,   /* 32*FD_ED25519_GE_LANE_CNT */
+                                               fd_ed25519_ge_p3_t const * A,   /* FD_ED25519_GE_LANE_CNT */
+                                               uchar const *              b ); /* 32*FD_ED25519_GE_LANE_CNT */
+
+/* Pubkey cache APIs **************************************************/
+
+/* fd_ed25519_pubkey_cache_query returns a pointer to the negated
+   decompressed public key (i.e. -A) cached for the 32-byte public_key
+   or NULL if public_key is not in the cache (bumping the cache hit or
+   miss count accordingly).  The returned pointer is valid until the next
+   insert into the cache.  On a hit, if opt_prime is non-NULL, *opt_prime
+   is set to 1 if A is known to be in the prime order subgroup and 0 if
+   this is not known.
+
+   fd_ed25519_pubkey_cache_insert inserts public_key into the cache with
+   the negated decompressed public key nA, evicting a not recently used
+   entry if the cache is full.  prime indicates nA is known to be in the
+   prime order subgroup.  If public_key is already in the cache, this
+   only records prime (if set).  nA should be the correct decompression
+   (e.g. of a public key that was just used to verify a signature
+   successfully). */
+
+fd_ed25519_ge_p3_t const *
+fd_ed25519_pubkey_cache_query( fd_ed25519_pubkey_cache_t * cache,
+                               uchar const *               public_key,  /* 32 */
+                               int *                       opt_prime );
+
+void
+fd_ed25519_pubkey_cache_insert( fd_ed25519_pubkey_cache_t * cache,
+                                uchar const *               public_key,  /* 32 */
+                                fd_ed25519_ge_p3_t const *  nA,
+                                int                         prime );
+
 /* User APIs **********************************************************/
 
 /* fd_ed25519_sc_reduce computes s mod l where s is a 512-bit value.  s
@@ -0,0 +1,292 @@
+#include "fd_ed25519_private.h"
+
+#define FD_ED25519_PUBKEY_CACHE_MAGIC (0xf17eda2ce7ed2550UL) /* firedancer ed25519 pubkey cache ver 0 */
+
+/* A fd_ed25519_pubkey_cache_ele_t holds a cached public key.  Elements
+   are stored in a flat array indexed [0,key_max) such that their
+   location does not change while they are in the cache (this is what
+   the CLOCK eviction sweeps over).  key is the (seeded) hash of pubkey
+   used to find the element in the map (0 if the element is not in
+   use), ref is the CLOCK reference bit and prime indicates nA is known
+   to be in the prime order subgroup. */
+
+struct fd_ed25519_pubkey_cache_ele {
+  ulong              key;
+  ulong              ref;
+  ulong              prime;
+  uchar              pubkey[ 32 ];
+  fd_ed25519_ge_p3_t nA[1];
+};
+
+typedef struct fd_ed25519_pubkey_cache_ele fd_ed25519_pubkey_cache_ele_t;
+
+/* The map maps the key of an element in use to its index. */
+
+struct fd_ed25519_pubkey_cache_slot {
+  ulong key;
+  ulong ele_idx;
+};
+
+typedef struct fd_ed25519_pubkey_cache_slot fd_ed25519_pubkey_cache_slot_t;
+
+#define MAP_NAME    fd_ed25519_pubkey_cache_map
+#define MAP_T       fd_ed25519_pubkey_cache_slot_t
+#define MAP_MEMOIZE 0
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+struct __attribute__((aligned(FD_ED25519_PUBKEY_CACHE_ALIGN))) fd_ed25519_pubkey_cache_private {
+  ulong magic;    /* ==FD_ED25519_PUBKEY_CACHE_MAGIC */
+  ulong key_max;
+  ulong seed;
+  ulong hand;     /* CLOCK hand, in [0,key_max) */
+  ulong hit_cnt;
+  ulong miss_cnt;
+  ulong map_off;  /* map and element array offsets relative to the cache */
+  ulong ele_off;
+  /* Padding to FD_ED25519_PUBKEY_CACHE_ALIGN here */
+  /* map here */
+  /* element array here */
+};
+
+/* fd_ed25519_pubkey_cache_lg_slot_cnt returns the map size for a cache
+   with key_max elements (a map fill ratio of at most 1/2). */
+
+FD_FN_CONST static inline int
+fd_ed25519_pubkey_cache_lg_slot_cnt( ulong key_max ) {
+  return fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*key_max ) );
+}
+
+FD_FN_CONST static inline ulong
+fd_ed25519_pubkey_cache_map_off( void ) {
+  return fd_ulong_align_up( sizeof(fd_ed25519_pubkey_cache_t), fd_ed25519_pubkey_cache_map_align() );
+}
+
+FD_FN_CONST static inline ulong
+fd_ed25519_pubkey_cache_ele_off( ulong key_max ) {
+  ulong map_end = fd_ed25519_pubkey_cache_map_off()
+                + fd_ed25519_pubkey_cache_map_footprint( fd_ed25519_pubkey_cache_lg_slot_cnt( key_max ) );
+  return fd_ulong_align_up( map_end, alignof(fd_ed25519_pubkey_cache_ele_t) );
+}
+
+FD_FN_PURE static inline fd_ed25519_pubkey_cache_slot_t *
+fd_ed25519_pubkey_cache_map( fd_ed25519_pubkey_cache_t * cache ) {
+  return fd_ed25519_pubkey_cache_map_join( (void *)((ulong)cache + cache->map_off) );
+}
+
+FD_FN_PURE static inline fd_ed25519_pubkey_cache_slot_t const *
+fd_ed25519_pubkey_cache_map_const( fd_ed25519_pubkey_cache_t const * cache ) {
+  return (fd_ed25519_pubkey_cache_slot_t const *)
+    fd_ed25519_pubkey_cache_map_join( (void *)((ulong)cache + cache->map_off) );
+}
+
+FD_FN_PURE static inline fd_ed25519_pubkey_cache_ele_t *
+fd_ed25519_pubkey_cache_ele( fd_ed25519_pubkey_cache_t * cache ) {
+  return (fd_ed25519_pubkey_cache_ele_t *)((ulong)cache + cache->ele_off);
+}
+
+/* fd_ed25519_pubkey_cache_key returns the map key for a public key (a
+   seeded hash of it, such that the map layout cannot be predicted by
+   somebody choosing public keys).  Never returns the null key. */
+
+FD_FN_PURE static inline ulong
+fd_ed25519_pubkey_cache_key( fd_ed25519_pubkey_cache_t const * cache,
+                             uchar const *                     public_key ) {
+  ulong key = fd_hash( cache->seed, public_key, 32UL );
+  return fd_ulong_if( !key, 1UL, key );
+}
+
+ulong
+fd_ed25519_pubkey_cache_align( void ) {
+  return FD_ED25519_PUBKEY_CACHE_ALIGN;
+}
+
+ulong
+fd_ed25519_pubkey_cache_footprint( ulong key_max ) {
+  if( FD_UNLIKELY( (!key_max) | (key_max>(ulong)UINT_MAX) ) ) return 0UL;
+  return fd_ulong_align_up( fd_ed25519_pubkey_cache_ele_off( key_max ) + key_max*sizeof(fd_ed25519_pubkey_cache_ele_t),
+                            FD_ED25519_PUBKEY_CACHE_ALIGN );
+}
+
+void *
+fd_ed25519_pubkey_cache_new( void * shmem,
+                             ulong  key_max,
+                             ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_ed25519_pubkey_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_ed25519_pubkey_cache_footprint( key_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad key_max (%lu)", key_max ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_ed25519_pubkey_cache_t * cache = (fd_ed25519_pubkey_cache_t *)shmem;
+
+  cache->key_max  = key_max;
+  cache->seed     = seed;
+  cache->hand     = 0UL;
+  cache->hit_cnt  = 0UL;
+  cache->miss_cnt = 0UL;
+  cache->map_off  = fd_ed25519_pubkey_cache_map_off();
+  cache->ele_off  = fd_ed25519_pubkey_cache_ele_off( key_max );
+
+  fd_ed25519_pubkey_cache_map_new( (void *)((ulong)shmem + cache->map_off), fd_ed25519_pubkey_cache_lg_slot_cnt( key_max ) );
+
+  /* The memset above marked all the elements as not in use */
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_ED25519_PUBKEY_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_ed25519_pubkey_cache_t *
+fd_ed25519_pubkey_cache_join( void * shcache ) {
+
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shcache, fd_ed25519_pubkey_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  fd_ed25519_pubkey_cache_t * cache = (fd_ed25519_pubkey_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_ED25519_PUBKEY_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_ed25519_pubkey_cache_leave( fd_ed25519_pubkey_cache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+void *
+fd_ed25519_pubkey_cache_delete( void * shcache ) {
+
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shcache, fd_ed25519_pubkey_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  fd_ed25519_pubkey_cache_t * cache = (fd_ed25519_pubkey_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_ED25519_PUBKEY_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
+
+ulong fd_ed25519_pubkey_cache_key_max ( fd_ed25519_pubkey_cache_t const * cache ) { return cache->key_max;  }
+ulong fd_ed25519_pubkey_cache_hit_cnt ( fd_ed25519_pubkey_cache_t const * cache ) { return cache->hit_cnt;  }
+ulong fd_ed25519_pubkey_cache_miss_cnt( fd_ed25519_pubkey_cache_t const * cache ) { return cache->miss_cnt; }
+
+ulong
+fd_ed25519_pubkey_cache_key_cnt( fd_ed25519_pubkey_cache_t const * cache ) {
+  return fd_ed25519_pubkey_cache_map_key_cnt( fd_ed25519_pubkey_cache_map_const( cache ) );
+}
+
+fd_ed25519_ge_p3_t const *
+fd_ed25519_pubkey_cache_query( fd_ed25519_pubkey_cache_t * cache,
+                               uchar const *               public_key,
+                               int *                       opt_prime ) {
+  fd_ed25519_pubkey_cache_slot_t * map  = fd_ed25519_pubkey_cache_map( cache );
+  fd_ed25519_pubkey_cache_slot_t * slot = fd_ed25519_pubkey_cache_map_query( map, fd_ed25519_pubkey_cache_key( cache, public_key ), NULL );
+
+  /* The full public key is checked as the key is only a 64-bit hash */
+
+  fd_ed25519_pubkey_cache_ele_t * ele = slot ? fd_ed25519_pubkey_cache_ele( cache ) + slot->ele_idx : NULL;
+  if( FD_UNLIKELY( (!ele) || memcmp( ele->pubkey, public_key, 32UL ) ) ) {
+    cache->miss_cnt++;
+    return NULL;
+  }
+
+  ele->ref = 1UL;
+  cache->hit_cnt++;
+  if( opt_prime ) *opt_prime = (int)ele->prime;
+  return ele->nA;
+}
+
+void
+fd_ed25519_pubkey_cache_insert( fd_ed25519_pubkey_cache_t * cache,
+                                uchar const *               public_key,
+                                fd_ed25519_ge_p3_t const *  nA,
+                                int                         prime ) {
+  fd_ed25519_pubkey_cache_slot_t * map = fd_ed25519_pubkey_cache_map( cache );
+  fd_ed25519_pubkey_cache_ele_t *  ele = fd_ed25519_pubkey_cache_ele( cache );
+
+  /* Already cached (or, with negligible probability, a different public
+     key with the same key is cached ... in which case we just don't
+     cache this one).  If the caller learned that an already cached
+     public key is in the prime order subgroup, we remember that. */
+
+  ulong key = fd_ed25519_pubkey_cache_key( cache, public_key );
+  fd_ed25519_pubkey_cache_slot_t * cached = fd_ed25519_pubkey_cache_map_query( map, key, NULL );
+  if( FD_UNLIKELY( cached ) ) {
+    fd_ed25519_pubkey_cache_ele_t * e = ele + cached->ele_idx;
+    if( prime && !memcmp( e->pubkey, public_key, 32UL ) ) e->prime = 1UL;
+    return;
+  }
+
+  /* Find an element to use by sweeping the CLOCK hand over the elements
+     until an unused element or an element that has not been referenced
+     since the hand last went by.  Terminates within 2 sweeps as the
+     hand clears the reference bits it passes. */
+
+  ulong key_max = cache->key_max;
+  ulong hand    = cache->hand;
+  fd_ed25519_pubkey_cache_ele_t * e;
+  for(;;) {
+    e = ele + hand;
+    hand = fd_ulong_if( hand+1UL<key_max, hand+1UL, 0UL );
+    if( FD_LIKELY( !e->key ) ) break;
+    if( FD_LIKELY( !e->ref ) ) {
+      fd_ed25519_pubkey_cache_map_remove( map, fd_ed25519_pubkey_cache_map_query( map, e->key, NULL ) );
+      break;
+    }
+    e->ref = 0UL;
+  }
+  cache->hand = hand;
+
+  fd_ed25519_pubkey_cache_slot_t * slot = fd_ed25519_pubkey_cache_map_insert( map, key );
+  slot->ele_idx = (ulong)(e - ele);
+
+  e->key = key;
+  e->ref   = 0UL; /* Not referenced until a query hits it */
+  e->prime = (ulong)!!prime;
+  fd_memcpy( e->pubkey, public_key, 32UL );
+  *e->nA = *nA;
+}
@@ -342,41 +342,28 @@ fd_ed25519_sign( void *        sig,
   return sig;
 }
 
-int
-fd_ed25519_verify( void const *  msg,
-                   ulong         sz,
-                   void const *  sig,
-                   void const *  public_key,
-                   fd_sha512_t * sha ) {
-  uchar const * r = (uchar const *)sig;
-  uchar const * s = r + 32;
-
-# ifndef FD_ED25519_VERIFY_USE_2POINT
-# if FD_ED25519_FE_POW25523_2_FAST
-# define FD_ED25519_VERIFY_USE_2POINT 1
-# else
-# define FD_ED25519_VERIFY_USE_2POINT 0
-# endif
-# endif
+/* fd_ed25519_verify_s_is_invalid returns non-zero if the s part of a
+   signature is not in [0,L) where:
 
-  /* Check 0 <= s < L where:
+     L = 2^252 + 27742317777372353535851937790883648493
 
-       L = 2^252 + 27742317777372353535851937790883648493
+   and zero otherwise.  s points to the 32-byte little endian s.  Since
+   s is public, this is done in variable time. */
 
-     If not the signature is publicly invalid.  Since it's public we can
-     do the check in variable time.
+static inline int
+fd_ed25519_verify_s_is_invalid( uchar const * s ) {
 
-     First check the most significant byte */
+  /* First check the most significant byte */
   /* FIXME: THIS COULD BE DONE 64-BIT AT A TIME FASTER */
 
-  if( FD_UNLIKELY( s[31]> 0x10 ) ) return FD_ED25519_ERR_SIG;
+  if( FD_UNLIKELY( s[31]> 0x10 ) ) return 1;
   if( FD_UNLIKELY( s[31]==0x10 ) ) {
 
     /* Most significant byte indicates a value close to 2^252 so check
        the rest */
 
     static uchar const allzeroes[ 15 ];
-    if( memcmp( s+16, allzeroes, 15UL )!=0 ) return 0;
+    if( memcmp( s+16, allzeroes, 15UL )!=0 ) return 1;
 
     /* 27742317777372353535851937790883648493 in little endian format */
     static uchar const l_low[16] = {
@@ -387,49 +374,547 @@ fd_ed25519_verify( void const *  msg,
     int i;
     for( i=15; i>=0; i--) {
       if( FD_LIKELY(   s[i]<l_low[i] ) ) break;
-      if( FD_UNLIKELY( s[i]>l_low[i] ) ) return FD_ED25519_ERR_SIG;
+      if( FD_UNLIKELY( s[i]>l_low[i] ) ) return 1;
     }
-    if( FD_UNLIKELY( i<0 ) ) return FD_ED25519_ERR_SIG;
+    if( FD_UNLIKELY( i<0 ) ) return 1;
   }
 
-  fd_ed25519_ge_p3_t A[1];
+  return 0;
+}
+
+/* fd_ed25519_verify_r_is_noncanonical returns non-zero if the 32-byte
+   point encoding r is not the encoding fd_ed25519_ge_tobytes would
+   produce for the point that r decompresses to and zero otherwise.
+   This happens when the encoded y is not in [0,p) or when the encoded
+   x is zero (y = +/-1) but the x sign bit is set.  Verifying
+   decompressed points (e.g. the 2-point and batch methods) needs to
+   reject these explicitly to match the compressed comparison. */
+
+static inline int
+fd_ed25519_verify_r_is_noncanonical( uchar const * r ) {
+  ulong y0 = fd_ulong_load_8( r      );
+  ulong y1 = fd_ulong_load_8( r +  8 );
+  ulong y2 = fd_ulong_load_8( r + 16 );
+  ulong y3 = fd_ulong_load_8( r + 24 ) & ~(1UL<<63);
+  int   xs = (int)(r[31]>>7);
+
+  /* y>=p=2^255-19 */
+  int y_ge_p = (y3==(ULONG_MAX>>1)) & (y2==ULONG_MAX) & (y1==ULONG_MAX) & (y0>=(ULONG_MAX-18UL));
+
+  /* y==1 or y==p-1 with the x sign bit set */
+  int y_is_1  = (y3==0UL) & (y2==0UL) & (y1==0UL) & (y0==1UL);
+  int y_is_m1 = (y3==(ULONG_MAX>>1)) & (y2==ULONG_MAX) & (y1==ULONG_MAX) & (y0==(ULONG_MAX-19UL));
+
+  return y_ge_p | (xs & (y_is_1 | y_is_m1));
+}
+
+/* FD_ED25519_VERIFY_USE_2POINT selects how the R computed by the
+   verification is compared against the r in the signature: 1
+   decompresses r along with the public key and compares the points in
+   projective coordinates (this avoids the inversion needed to compress
+   the computed R) and 0 compresses the computed R and compares the
+   encodings. */
+
+#ifndef FD_ED25519_VERIFY_USE_2POINT
+#if FD_ED25519_FE_POW25523_2_FAST
+#define FD_ED25519_VERIFY_USE_2POINT 1
+#else
+#define FD_ED25519_VERIFY_USE_2POINT 0
+#endif
+#endif
+
+/* fd_ed25519_verify_prep does everything fd_ed25519_verify does before
+   the double scalar multiplication: it checks s, decompresses the
+   negated public key into A (and, for the 2-point method, r into rD)
+   and computes the reduced message hash h.  Returns FD_ED25519_SUCCESS
+   on success or the FD_ED25519_ERR_* code fd_ed25519_verify returns
+   otherwise (A, rD and h are undefined in this case).
+
+   If nA is non-NULL, it is the already known negated public key (e.g.
+   from a pubkey cache) and is used instead of decompressing the public
+   key.  In this case, for the 2-point method, r is not decompressed
+   either and the caller should do it (such that callers can decompress
+   the r of two signatures together with fd_ed25519_verify_prep_r2). */
+
+static inline int
+fd_ed25519_verify_prep( fd_ed25519_ge_p3_t *       A,
+                        fd_ed25519_ge_p3_t *       rD,
+                        uchar *                    h,   /* 64 */
+                        void const *               msg,
+                        ulong                      sz,
+                        void const *               sig,
+                        void const *               public_key,
+                        fd_ed25519_ge_p3_t const * nA,
+                        fd_sha512_t *              sha ) {
+  uchar const * r = (uchar const *)sig;
+  uchar const * s = r + 32;
+
+  /* Check 0 <= s < L.  If not the signature is publicly invalid. */
+
+  if( FD_UNLIKELY( fd_ed25519_verify_s_is_invalid( s ) ) ) return FD_ED25519_ERR_SIG;
 
 # if FD_ED25519_VERIFY_USE_2POINT
-  /* 2-point decompression - this approach avoids doing a compression
-     (and hence an inversion) at the end */
-  fd_ed25519_ge_p3_t rD[1];
-  int err = fd_ed25519_ge_frombytes_vartime_2( A, public_key, rD, r ); if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( fd_ed25519_verify_r_is_noncanonical( r ) ) ) return FD_ED25519_ERR_MSG;
 # else
-  int err = fd_ed25519_ge_frombytes_vartime( A, public_key ); if( FD_UNLIKELY( err ) ) return err;
+  (void)rD;
 # endif
 
-  fd_ed25519_fe_neg( A->X, A->X );
-  fd_ed25519_fe_neg( A->T, A->T );
+  if( FD_LIKELY( nA ) ) *A = *nA;
+  else {
+#   if FD_ED25519_VERIFY_USE_2POINT
+    /* 2-point decompression - this approach avoids doing a compression
+       (and hence an inversion) at the end */
+    int err = fd_ed25519_ge_frombytes_vartime_2( A, public_key, rD, r ); if( FD_UNLIKELY( err ) ) return err;
+#   else
+    int err = fd_ed25519_ge_frombytes_vartime( A, public_key ); if( FD_UNLIKELY( err ) ) return err;
+#   endif
+    fd_ed25519_fe_neg( A->X, A->X );
+    fd_ed25519_fe_neg( A->T, A->T );
+  }
 
-  uchar h[ 64 ];
   fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
                   r, 32UL ), public_key, 32UL ), msg, sz ), h );
   fd_ed25519_sc_reduce( h, h );
+  return FD_ED25519_SUCCESS;
+}
 
-  fd_ed25519_ge_p2_t R[1];
-  fd_ed25519_ge_double_scalarmult_vartime( R, h, A, s );
+/* fd_ed25519_verify_prep_r2 decompresses r0 into rD0 and r1 into rD1
+   (with a single 2-point decompression).  err0 and err1 are set to the
+   FD_ED25519_ERR_PUBKEY if r0 or r1 respectively are not valid points
+   (fd_ed25519_ge_frombytes_vartime_2 only indicates if either failed,
+   so such failures are sorted out one at a time). */
+
+static void
+fd_ed25519_verify_prep_r2( fd_ed25519_ge_p3_t * rD0, uchar const * r0, int * err0,
+                           fd_ed25519_ge_p3_t * rD1, uchar const * r1, int * err1 ) {
+  if( FD_LIKELY( !fd_ed25519_ge_frombytes_vartime_2( rD0, r0, rD1, r1 ) ) ) { *err0 = FD_ED25519_SUCCESS; *err1 = FD_ED25519_SUCCESS; return; }
+  *err0 = fd_ed25519_ge_frombytes_vartime( rD0, r0 );
+  *err1 = fd_ed25519_ge_frombytes_vartime( rD1, r1 );
+}
+
+/* fd_ed25519_verify_check returns the result of fd_ed25519_verify
+   given R = [h](-A) + [s]B computed from the fd_ed25519_verify_prep
+   outputs for sig. */
 
+static inline int
+fd_ed25519_verify_check( fd_ed25519_ge_p2_t const * R,
+                         fd_ed25519_ge_p3_t const * rD,
+                         void const *               sig ) {
 # if FD_ED25519_VERIFY_USE_2POINT
+  (void)sig;
   /* Comparison:
        r.x * R.Z == R.X
-       r.y * R.Z == R.Y */
-  fd_ed25519_fe_t x_Z; fd_ed25519_fe_t y_Z;
-  fd_ed25519_fe_mul2( &x_Z, R->Z, rD->X,
-                      &y_Z, R->Z, rD->Y );
-  return (memcmp( &x_Z, R->X, 32UL ) |
-          memcmp( &y_Z, R->Y, 32UL ) ) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS;
+       r.y * R.Z == R.Y
+     (the field elements need to be compared as field elements as they
+     might not be identically represented) */
+  fd_ed25519_fe_t x_Z[1]; fd_ed25519_fe_t y_Z[1];
+  fd_ed25519_fe_mul2( x_Z, R->Z, rD->X,
+                      y_Z, R->Z, rD->Y );
+  fd_ed25519_fe_sub( x_Z, x_Z, R->X );
+  fd_ed25519_fe_sub( y_Z, y_Z, R->Y );
+  return (fd_ed25519_fe_isnonzero( x_Z ) | fd_ed25519_fe_isnonzero( y_Z )) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS;
 # else
+  (void)rD;
   uchar rcheck[ 32 ];
   fd_ed25519_ge_tobytes( rcheck, R );
-  return memcmp( rcheck, r, 32UL ) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS;
+  return memcmp( rcheck, sig, 32UL ) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS;
 # endif
 }
 
+int
+fd_ed25519_verify( void const *  msg,
+                   ulong         sz,
+                   void const *  sig,
+                   void const *  public_key,
+                   fd_sha512_t * sha ) {
+  fd_ed25519_ge_p3_t A [1];
+  fd_ed25519_ge_p3_t rD[1];
+  uchar              h [64];
+  int err = fd_ed25519_verify_prep( A, rD, h, msg, sz, sig, public_key, NULL, sha );
+  if( FD_UNLIKELY( err ) ) return err;
+
+  fd_ed25519_ge_p2_t R[1];
+  fd_ed25519_ge_double_scalarmult_vartime( R, h, A, (uchar const *)sig + 32 );
+  return fd_ed25519_verify_check( R, rD, sig );
+}
+
+/* fd_ed25519_verify_multi_flush finishes the verification of the
+   lcnt in [1,FD_ED25519_GE_LANE_CNT] signatures sig[idx[l]] whose
+   fd_ed25519_verify_prep outputs are in A[l], rD[l] and a[l] (the
+   reduced message hash) and whose s is in b[l].  hit[l] indicates if
+   A[l] came from the cache (in which case, for the 2-point method, the
+   r still needs to be decompressed into rD[l]).  Lanes lcnt and up and
+   lanes that fail here are filled in with the identity and zero
+   scalars.  Public keys not from the cache are inserted into the cache
+   (if any) when their signature verifies. */
+
+static void
+fd_ed25519_verify_multi_flush( fd_ed25519_ge_p3_t *        A,
+                               fd_ed25519_ge_p3_t *        rD,
+                               uchar *                     a,
+                               uchar *                     b,
+                               ulong const *               idx,
+                               int const *                 hit,
+                               ulong                       lcnt,
+                               void const * const *        sig,
+                               void const * const *        public_key,
+                               int *                       err,
+                               fd_ed25519_pubkey_cache_t * cache ) {
+
+# if FD_ED25519_VERIFY_USE_2POINT
+  ulong l0 = ULONG_MAX;
+  for( ulong l=0UL; l<lcnt; l++ ) {
+    if( FD_LIKELY( !hit[l] ) ) continue;
+    if( l0==ULONG_MAX ) { l0 = l; continue; }
+    fd_ed25519_verify_prep_r2( rD+l0, sig[ idx[l0] ], err + idx[l0],
+                               rD+l,  sig[ idx[l]  ], err + idx[l]  );
+    l0 = ULONG_MAX;
+  }
+  if( l0!=ULONG_MAX ) err[ idx[l0] ] = fd_ed25519_ge_frombytes_vartime( rD+l0, sig[ idx[l0] ] );
+# endif
+
+  for( ulong l=0UL; l<FD_ED25519_GE_LANE_CNT; l++ ) {
+    if( FD_LIKELY( (l<lcnt) && !err[ idx[l] ] ) ) continue;
+    fd_ed25519_ge_p3_0( A+l );
+    fd_memset( a + 32UL*l, 0, 32UL );
+    fd_memset( b + 32UL*l, 0, 32UL );
+  }
+
+  fd_ed25519_ge_p2_t R[ FD_ED25519_GE_LANE_CNT ];
+  fd_ed25519_ge_double_scalarmult_vartime_lanes( R, a, A, b );
+
+  for( ulong l=0UL; l<lcnt; l++ ) {
+    ulong i = idx[l];
+    if( FD_UNLIKELY( err[i] ) ) continue;
+    err[i] = fd_ed25519_verify_check( R+l, rD+l, sig[i] );
+    if( cache && !hit[l] && !err[i] ) fd_ed25519_pubkey_cache_insert( cache, public_key[i], A+l, 0 );
+  }
+}
+
+int
+fd_ed25519_verify_multi( void const * const *        msg,
+                         ulong const *               sz,
+                         void const * const *        sig,
+                         void const * const *        public_key,
+                         int *                       err,
+                         ulong                       cnt,
+                         fd_sha512_t *               sha,
+                         fd_ed25519_pubkey_cache_t * cache ) {
+
+  /* Signatures that get through the prep are packed into lanes (such
+     that malformed signatures do not leave holes) and the lanes are
+     finished when full (and at the end). */
+
+  fd_ed25519_ge_p3_t A  [ FD_ED25519_GE_LANE_CNT ];
+  fd_ed25519_ge_p3_t rD [ FD_ED25519_GE_LANE_CNT ];
+  uchar              a  [ FD_ED25519_GE_LANE_CNT ][ 32 ];
+  uchar              b  [ FD_ED25519_GE_LANE_CNT ][ 32 ];
+  ulong              idx[ FD_ED25519_GE_LANE_CNT ];
+  int                hit[ FD_ED25519_GE_LANE_CNT ];
+  ulong              lcnt = 0UL;
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    uchar h[ 64 ];
+    fd_ed25519_ge_p3_t const * nA = cache ? fd_ed25519_pubkey_cache_query( cache, public_key[i], NULL ) : NULL;
+    err[i] = fd_ed25519_verify_prep( A+lcnt, rD+lcnt, h, msg[i], sz[i], sig[i], public_key[i], nA, sha );
+    if( FD_UNLIKELY( err[i] ) ) continue;
+    fd_memcpy( a[lcnt], h,                             32UL );
+    fd_memcpy( b[lcnt], (uchar const *)sig[i] + 32UL, 32UL );
+    hit[ lcnt   ] = !!nA;
+    idx[ lcnt++ ] = i;
+    if( FD_UNLIKELY( lcnt==FD_ED25519_GE_LANE_CNT ) ) {
+      fd_ed25519_verify_multi_flush( A, rD, a[0], b[0], idx, hit, lcnt, sig, public_key, err, cache );
+      lcnt = 0UL;
+    }
+  }
+  if( lcnt ) fd_ed25519_verify_multi_flush( A, rD, a[0], b[0], idx, hit, lcnt, sig, public_key, err, cache );
+
+  for( ulong i=0UL; i<cnt; i++ ) if( FD_UNLIKELY( err[i] ) ) return err[i];
+  return FD_ED25519_SUCCESS;
+}
+
+/* FD_ED25519_VERIFY_BATCH_CHAL_MAX is the size of the buffer used by
+   fd_ed25519_verify_batch to gather a challenge preimage (R,A,M) for the
+   multi-buffer hash.  This covers the signatures of any transaction
+   (messages are at most a MTU sized packet). */
+
+#define FD_ED25519_VERIFY_BATCH_CHAL_MAX (1536UL)
+
+/* fd_ed25519_verify_batch_is_prime sets ok[k] to 1 if P[k] is in the
+   prime order subgroup (i.e. [L]P[k] is the identity) and 0 if P[k] has
+   a small order component, for k in [0,cnt).  The points are checked
+   FD_ED25519_GE_LANE_CNT at a time. */
+
+static void
+fd_ed25519_verify_batch_is_prime( int *                              ok,
+                                  fd_ed25519_ge_p3_t const * const * P,
+                                  ulong                              cnt ) {
+
+  /* L, little endian */
+
+  static uchar const L_bytes[ 32 ] = {
+    (uchar)0xED, (uchar)0xD3, (uchar)0xF5, (uchar)0x5C, (uchar)0x1A, (uchar)0x63, (uchar)0x12, (uchar)0x58,
+    (uchar)0xD6, (uchar)0x9C, (uchar)0xF7, (uchar)0xA2, (uchar)0xDE, (uchar)0xF9, (uchar)0xDE, (uchar)0x14,
+    (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00,
+    (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x10
+  };
+
+  fd_ed25519_ge_p3_t A[ FD_ED25519_GE_LANE_CNT ];
+  uchar              a[ FD_ED25519_GE_LANE_CNT ][ 32 ];
+  uchar              b[ FD_ED25519_GE_LANE_CNT ][ 32 ];
+  fd_memset( b, 0, sizeof(b) );
+
+  for( ulong k0=0UL; k0<cnt; k0+=FD_ED25519_GE_LANE_CNT ) {
+    ulong lcnt = fd_ulong_min( cnt-k0, FD_ED25519_GE_LANE_CNT );
+    for( ulong l=0UL; l<FD_ED25519_GE_LANE_CNT; l++ ) {
+      if( FD_LIKELY( l<lcnt ) ) { A[l] = *P[ k0+l ]; fd_memcpy( a[l], L_bytes, 32UL ); }
+      else                      { fd_ed25519_ge_p3_0( A+l ); fd_memset( a[l], 0, 32UL ); }
+    }
+
+    fd_ed25519_ge_p2_t R[ FD_ED25519_GE_LANE_CNT ];
+    fd_ed25519_ge_double_scalarmult_vartime_lanes( R, a[0], A, b[0] );
+
+    for( ulong l=0UL; l<lcnt; l++ ) {
+      fd_ed25519_fe_t t[1]; fd_ed25519_fe_sub( t, R[l].Y, R[l].Z );
+      ok[ k0+l ] = !(fd_ed25519_fe_isnonzero( R[l].X ) | fd_ed25519_fe_isnonzero( t ));
+    }
+  }
+}
+
+int
+fd_ed25519_verify_batch( void const * const *        msg,
+                         ulong const *               sz,
+                         void const * const *        sig,
+                         void const * const *        public_key,
+                         int *                       err,
+                         ulong                       cnt,
+                         fd_sha512_t *               sha,
+                         fd_ed25519_pubkey_cache_t * cache ) {
+
+  /* The base point and L-1 (i.e. -1 mod L), little endian */
+
+  static uchar const B_bytes[ 32 ] = {
+    (uchar)0x58, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66,
+    (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66,
+    (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66,
+    (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66, (uchar)0x66
+  };
+
+  static uchar const zero[ 32 ];
+
+  int ret = FD_ED25519_SUCCESS;
+
+  for( ulong idx0=0UL; idx0<cnt; idx0+=FD_ED25519_VERIFY_BATCH_MAX ) {
+    ulong batch_cnt = fd_ulong_min( cnt-idx0, FD_ED25519_VERIFY_BATCH_MAX );
+
+    /* Point / scalar pairs for the batch equation.  Pair 0 is the base
+       point, pairs 2j+1 and 2j+2 are -R_j and -A_j for the j-th
+       signature that passed the obviously malformed checks. */
+
+    fd_ed25519_ge_p3_t P[ FD_ED25519_GE_MSM_MAX ];
+    uchar              a[ FD_ED25519_GE_MSM_MAX ][ 32 ];
+    uchar              h[ FD_ED25519_VERIFY_BATCH_MAX ][ 64 ];
+    ulong              idx[ FD_ED25519_VERIFY_BATCH_MAX ];
+    int                hit[ FD_ED25519_VERIFY_BATCH_MAX ]; /* A_j came from the cache (R_j not decompressed yet) */
+    int                pri[ FD_ED25519_VERIFY_BATCH_MAX ]; /* A_j is known to be in the prime order subgroup */
+    ulong              pcnt = 0UL; /* Number of signatures in the batch equation */
+
+    for( ulong i=idx0; i<idx0+batch_cnt; i++ ) {
+      uchar const * r = (uchar const *)sig[i];
+      uchar const * s = r + 32;
+
+      /* Obviously malformed signatures are rare and get their exact
+         error code from fd_ed25519_verify */
+
+      if( FD_UNLIKELY( fd_ed25519_verify_s_is_invalid( s )      ) ||
+          FD_UNLIKELY( fd_ed25519_verify_r_is_noncanonical( r ) ) ) {
+        err[i] = fd_ed25519_verify( msg[i], sz[i], sig[i], public_key[i], sha );
+        continue;
+      }
+
+      fd_ed25519_ge_p3_t *       R  = P + 2UL*pcnt + 1UL;
+      fd_ed25519_ge_p3_t *       A  = P + 2UL*pcnt + 2UL;
+      int                        prime = 0;
+      fd_ed25519_ge_p3_t const * nA    = cache ? fd_ed25519_pubkey_cache_query( cache, public_key[i], &prime ) : NULL;
+      if( FD_LIKELY( nA ) ) *A = *nA;
+      else {
+        if( FD_UNLIKELY( fd_ed25519_ge_frombytes_vartime_2( A, public_key[i], R, r ) ) ) {
+          err[i] = fd_ed25519_verify( msg[i], sz[i], sig[i], public_key[i], sha );
+          continue;
+        }
+        fd_ed25519_fe_neg( A->X, A->X ); fd_ed25519_fe_neg( A->T, A->T );
+      }
+
+      hit[ pcnt   ] = !!nA;
+      pri[ pcnt   ] = prime;
+      idx[ pcnt++ ] = i;
+    }
+
+    if( FD_UNLIKELY( !pcnt ) ) continue;
+
+    /* Compute the challenges h_j = SHA-512(R_j,A_j,M_j) mod L of the
+       whole batch with a multi-buffer hash.  This needs each challenge
+       preimage to be contiguous so we gather them into chal (challenges
+       with unusually large messages are hashed in place instead). */
+
+    uchar        chal [ FD_ED25519_VERIFY_BATCH_MAX ][ FD_ED25519_VERIFY_BATCH_CHAL_MAX ];
+    void const * cdata[ FD_ED25519_VERIFY_BATCH_MAX ];
+    ulong        csz  [ FD_ED25519_VERIFY_BATCH_MAX ];
+    void *       chash[ FD_ED25519_VERIFY_BATCH_MAX ];
+    ulong        ccnt = 0UL;
+    for( ulong j=0UL; j<pcnt; j++ ) {
+      ulong i = idx[j];
+      if( FD_UNLIKELY( sz[i]>FD_ED25519_VERIFY_BATCH_CHAL_MAX-64UL ) ) {
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                        sig[i], 32UL ), public_key[i], 32UL ), msg[i], sz[i] ), h[j] );
+        continue;
+      }
+      fd_memcpy( chal[j],       sig[i],        32UL );
+      fd_memcpy( chal[j]+32UL,  public_key[i], 32UL );
+      if( FD_LIKELY( sz[i] ) ) fd_memcpy( chal[j]+64UL, msg[i], sz[i] );
+      cdata[ccnt] = chal[j]; csz[ccnt] = 64UL+sz[i]; chash[ccnt] = h[j]; ccnt++;
+    }
+    fd_sha512_batch_hash( cdata, csz, chash, ccnt );
+    for( ulong j=0UL; j<pcnt; j++ ) fd_ed25519_sc_reduce( h[j], h[j] );
+
+    /* Decompress the R_j of the signatures whose public key came from
+       the cache two at a time.  If any of these is not a valid point,
+       we let the individual checks below sort out the details. */
+
+    int r_ok = 1;
+    ulong j0 = ULONG_MAX;
+    for( ulong j=0UL; j<pcnt; j++ ) {
+      if( FD_LIKELY( !hit[j] ) ) continue;
+      if( j0==ULONG_MAX ) { j0 = j; continue; }
+      int err0; int err1;
+      fd_ed25519_verify_prep_r2( P + 2UL*j0 + 1UL, sig[ idx[j0] ], &err0,
+                                 P + 2UL*j  + 1UL, sig[ idx[j]  ], &err1 );
+      r_ok &= !(err0 | err1);
+      j0 = ULONG_MAX;
+    }
+    if( j0!=ULONG_MAX ) r_ok &= !fd_ed25519_ge_frombytes_vartime( P + 2UL*j0 + 1UL, sig[ idx[j0] ] );
+
+    for( ulong j=0UL; j<pcnt; j++ ) {
+      fd_ed25519_ge_p3_t * R = P + 2UL*j + 1UL;
+      fd_ed25519_fe_neg( R->X, R->X ); fd_ed25519_fe_neg( R->T, R->T );
+    }
+
+    /* The batch equation only implies the individual equations when the
+       R_j and A_j are in the prime order subgroup.  Otherwise, small
+       order components of different signatures can cancel out (e.g.
+       two signatures whose R is off by the point of order 2 always
+       pass, as the z_j are odd) and the batch would accept signatures
+       fd_ed25519_verify rejects.  So signatures with a small order
+       component in R_j or A_j are taken out of the batch and verified
+       individually (this never happens for honestly generated
+       signatures and public keys).  A_j known to be in the prime order
+       subgroup from the cache are not checked again. */
+
+    if( FD_LIKELY( r_ok ) ) {
+      fd_ed25519_ge_p3_t const * Q [ 2UL*FD_ED25519_VERIFY_BATCH_MAX ];
+      int                        ok[ 2UL*FD_ED25519_VERIFY_BATCH_MAX ];
+      ulong                      qcnt = 0UL;
+      for( ulong j=0UL; j<pcnt; j++ ) {
+        Q[ qcnt++ ] = P + 2UL*j + 1UL;
+        if( !pri[j] ) Q[ qcnt++ ] = P + 2UL*j + 2UL;
+      }
+      fd_ed25519_verify_batch_is_prime( ok, Q, qcnt );
+
+      ulong qidx = 0UL;
+      ulong jcnt = 0UL;
+      for( ulong j=0UL; j<pcnt; j++ ) {
+        int j_ok = ok[ qidx++ ];
+        if( !pri[j] ) j_ok &= ok[ qidx++ ];
+        ulong i = idx[j];
+        if( FD_UNLIKELY( !j_ok ) ) {
+          err[i] = fd_ed25519_verify( msg[i], sz[i], sig[i], public_key[i], sha );
+          continue;
+        }
+        if( jcnt<j ) {
+          P[ 2UL*jcnt+1UL ] = P[ 2UL*j+1UL ];
+          P[ 2UL*jcnt+2UL ] = P[ 2UL*j+2UL ];
+          fd_memcpy( h[jcnt], h[j], 32UL );
+          idx[ jcnt ] = i;
+        }
+        hit[ jcnt++ ] = hit[j] & pri[j]; /* From here on, hit indicates the cache does not need an update */
+      }
+      pcnt = jcnt;
+      if( FD_UNLIKELY( !pcnt ) ) continue;
+    }
+
+    /* Derive the coefficients.  seed is a hash of everything that went
+       into the batch equation and z_j is the leading 128 bits of
+       SHA-512(seed,j/4) at offset 16*(j%4).  A signature supplier thus
+       cannot predict the coefficients without fixing every signature,
+       public key and message in the batch first. */
+
+    uchar seed[ 64 ];
+    fd_sha512_init( sha );
+    for( ulong j=0UL; j<pcnt; j++ ) {
+      fd_sha512_append( sha, sig[ idx[j] ],        64UL );
+      fd_sha512_append( sha, public_key[ idx[j] ], 32UL );
+      fd_sha512_append( sha, h[j],                 32UL );
+    }
+    fd_sha512_fini( sha, seed );
+
+    uchar zbuf[ 64 ];
+    uchar b[ 32 ]; fd_memset( b, 0, 32UL ); /* b = sum_j z_j s_j mod L */
+    for( ulong j=0UL; j<pcnt; j++ ) {
+      if( !(j & 3UL) ) {
+        ulong ctr = j>>2;
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ), seed, 64UL ), &ctr, sizeof(ulong) ), zbuf );
+      }
+      uchar * z = a[ 2UL*j+1UL ];
+      fd_memcpy( z,        zbuf + 16UL*(j & 3UL), 16UL );
+      fd_memset( z + 16UL, 0,                     16UL );
+      z[0] |= (uchar)1; /* Never zero */
+
+      fd_ed25519_sc_muladd( a[ 2UL*j+2UL ], z, h[j], zero );                          /* z_j h_j */
+      fd_ed25519_sc_muladd( b,              z, (uchar const *)sig[ idx[j] ] + 32, b ); /* b += z_j s_j */
+    }
+
+    int batch_ok = 0;
+    if( FD_LIKELY( r_ok ) ) {
+      int berr = fd_ed25519_ge_frombytes_vartime( P, B_bytes ); (void)berr; /* B is a valid point */
+      fd_memcpy( a[0], b, 32UL );
+
+      fd_ed25519_ge_p2_t S[1];
+      fd_ed25519_ge_multi_scalarmult_vartime( S, 2UL*pcnt+1UL, a[0], P );
+
+      /* S should be the identity, i.e. (0:Z:Z) */
+
+      fd_ed25519_fe_t t[1]; fd_ed25519_fe_sub( t, S->Y, S->Z );
+      batch_ok = !(fd_ed25519_fe_isnonzero( S->X ) | fd_ed25519_fe_isnonzero( t ));
+    }
+
+    if( FD_LIKELY( batch_ok ) ) {
+      for( ulong j=0UL; j<pcnt; j++ ) {
+        err[ idx[j] ] = FD_ED25519_SUCCESS;
+        if( cache && !hit[j] ) fd_ed25519_pubkey_cache_insert( cache, public_key[ idx[j] ], P + 2UL*j + 2UL, 1 );
+      }
+    } else {
+
+      /* At least one signature in the batch is bad.  Find out which
+         (with exact error codes) with the lane parallel verify. */
+
+      void const * fmsg[ FD_ED25519_VERIFY_BATCH_MAX ];
+      ulong        fsz [ FD_ED25519_VERIFY_BATCH_MAX ];
+      void const * fsig[ FD_ED25519_VERIFY_BATCH_MAX ];
+      void const * fpub[ FD_ED25519_VERIFY_BATCH_MAX ];
+      int          ferr[ FD_ED25519_VERIFY_BATCH_MAX ];
+      for( ulong j=0UL; j<pcnt; j++ ) {
+        ulong i = idx[j];
+        fmsg[j] = msg[i]; fsz[j] = sz[i]; fsig[j] = sig[i]; fpub[j] = public_key[i];
+      }
+      fd_ed25519_verify_multi( fmsg, fsz, fsig, fpub, ferr, pcnt, sha, cache );
+      for( ulong j=0UL; j<pcnt; j++ ) err[ idx[j] ] = ferr[j];
+    }
+  }
+
+  for( ulong i=0UL; i<cnt; i++ ) if( FD_UNLIKELY( err[i] ) ) { ret = err[i]; break; }
+  return ret;
+}
+
 char const *
 fd_ed25519_strerror( int err ) {
   switch( err ) {
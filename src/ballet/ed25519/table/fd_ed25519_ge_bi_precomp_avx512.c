@@ -0,0 +1,50 @@
+/* DO NOT INCLUDE DIRECTLY */
+
+/* This is table/fd_ed25519_ge_bi_precomp.c with the field elements
+   converted to the radix 2^51 representation used by the avx512
+   implementation (each element reduced mod p, limbs stored
+   least significant first). */
+
+static const fd_ed25519_ge_precomp_t bi_precomp[8][1] = {
+  {{ /* Bi[0] */
+    {{{ 0x493c6f58c3b85UL, 0x0df7181c325f7UL, 0x0f50b0b3e4cb7UL, 0x5329385a44c32UL, 0x07cf9d3a33d4bUL }}},
+    {{{ 0x03905d740913eUL, 0x0ba2817d673a2UL, 0x23e2827f4e67cUL, 0x133d2e0c21a34UL, 0x44fd2f9298f81UL }}},
+    {{{ 0x11205877aaa68UL, 0x479955893d579UL, 0x50d66309b67a0UL, 0x2d42d0dbee5eeUL, 0x6f117b689f0c6UL }}},
+  }},
+  {{ /* Bi[1] */
+    {{{ 0x5b0a84cee9730UL, 0x61d10c97155e4UL, 0x4059cc8096a10UL, 0x47a608da8014fUL, 0x7a164e1b9a80fUL }}},
+    {{{ 0x11fe8a4fcd265UL, 0x7bcb8374faaccUL, 0x52f5af4ef4d4fUL, 0x5314098f98d10UL, 0x2ab91587555bdUL }}},
+    {{{ 0x6933f0dd0d889UL, 0x44386bb4c4295UL, 0x3cb6d3162508cUL, 0x26368b872a2c6UL, 0x5a2826af12b9bUL }}},
+  }},
+  {{ /* Bi[2] */
+    {{{ 0x2bc4408a5bb33UL, 0x078ebdda05442UL, 0x2ffb112354123UL, 0x375ee8df5862dUL, 0x2945ccf146e20UL }}},
+    {{{ 0x182c3a447d6baUL, 0x22964e536eff2UL, 0x192821f540053UL, 0x2f9f19e788e5cUL, 0x154a7e73eb1b5UL }}},
+    {{{ 0x3dbf1812a8285UL, 0x0fa17ba3f9797UL, 0x6f69cb49c3820UL, 0x34d5a0db3858dUL, 0x43aabe696b3bbUL }}},
+  }},
+  {{ /* Bi[3] */
+    {{{ 0x25cd0944ea3bfUL, 0x75673b81a4d63UL, 0x150b925d1c0d4UL, 0x13f38d9294114UL, 0x461bea69283c9UL }}},
+    {{{ 0x72c9aaa3221b1UL, 0x267774474f74dUL, 0x064b0e9b28085UL, 0x3f04ef53b27c9UL, 0x1d6edd5d2e531UL }}},
+    {{{ 0x36dc801b8b3a2UL, 0x0e0a7d4935e30UL, 0x1deb7cecc0d7dUL, 0x053a94e20dd2cUL, 0x7a9fbb1c6a0f9UL }}},
+  }},
+  {{ /* Bi[4] */
+    {{{ 0x6678aa6a8632fUL, 0x5ea3788d8b365UL, 0x21bd6d6994279UL, 0x7ace75919e4e3UL, 0x34b9ed338add7UL }}},
+    {{{ 0x6217e039d8064UL, 0x6dea408337e6dUL, 0x57ac112628206UL, 0x647cb65e30473UL, 0x49c05a51fadc9UL }}},
+    {{{ 0x4e8bf9045af1bUL, 0x514e33a45e0d6UL, 0x7533c5b8bfe0fUL, 0x583557b7e14c9UL, 0x73c172021b008UL }}},
+  }},
+  {{ /* Bi[5] */
+    {{{ 0x700848a802adeUL, 0x1e04605c4e5f7UL, 0x5c0d01b9767fbUL, 0x7d7889f42388bUL, 0x4275aae2546d8UL }}},
+    {{{ 0x75b0249864348UL, 0x52ee11070262bUL, 0x237ae54fb5acdUL, 0x3bfd1d03aaab5UL, 0x18ab598029d5cUL }}},
+    {{{ 0x32cc5fd6089e9UL, 0x426505c949b05UL, 0x46a18880c7ad2UL, 0x4a4221888ccdaUL, 0x3dc65522b53dfUL }}},
+  }},
+  {{ /* Bi[6] */
+    {{{ 0x0c222a2007f6dUL, 0x356b79bdb77eeUL, 0x41ee81efe12ceUL, 0x120a9bd07097dUL, 0x234fd7eec346fUL }}},
+    {{{ 0x7013b327fbf93UL, 0x1336eeded6a0dUL, 0x2b565a2bbf3afUL, 0x253ce89591955UL, 0x0267882d17602UL }}},
+    {{{ 0x0a119732ea378UL, 0x63bf1ba8e2a6cUL, 0x69f94cc90df9aUL, 0x431d1779bfc48UL, 0x497ba6fdaa097UL }}},
+  }},
+  {{ /* Bi[7] */
+    {{{ 0x6cc0313cfeaa0UL, 0x1a313848da499UL, 0x7cb534219230aUL, 0x39596dedefd60UL, 0x61e22917f12deUL }}},
+    {{{ 0x3cd86468ccf0bUL, 0x48553221ac081UL, 0x6c9464b4e0a6eUL, 0x75fba84180403UL, 0x43b5cd4218d05UL }}},
+    {{{ 0x2762f9bd0b516UL, 0x1c6e7fbddcbb3UL, 0x75909c3ace2bdUL, 0x42101972d3ec9UL, 0x511d61210ae4dUL }}},
+  }},
+};
+
@@ -0,0 +1,1356 @@
+/* DO NOT INCLUDE DIRECTLY */
+
+/* This is table/fd_ed25519_ge_k25519_precomp.c with the field elements
+   converted to the radix 2^51 representation used by the avx512
+   implementation (each element reduced mod p, limbs stored
+   least significant first).
+
+   k25519_precomp[i][j] = (j+1)*256^i*B */
+
+static fd_ed25519_ge_precomp_t const k25519_precomp[32][8][1] = {
+  {
+    {{ /* k25519_precomp[ 0][ 0] */
+      {{{ 0x493c6f58c3b85UL, 0x0df7181c325f7UL, 0x0f50b0b3e4cb7UL, 0x5329385a44c32UL, 0x07cf9d3a33d4bUL }}},
+      {{{ 0x03905d740913eUL, 0x0ba2817d673a2UL, 0x23e2827f4e67cUL, 0x133d2e0c21a34UL, 0x44fd2f9298f81UL }}},
+      {{{ 0x11205877aaa68UL, 0x479955893d579UL, 0x50d66309b67a0UL, 0x2d42d0dbee5eeUL, 0x6f117b689f0c6UL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 1] */
+      {{{ 0x4e7fc933c71d7UL, 0x2cf41feb6b244UL, 0x7581c0a7d1a76UL, 0x7172d534d32f0UL, 0x590c063fa87d2UL }}},
+      {{{ 0x1a56042b4d5a8UL, 0x189cc159ed153UL, 0x5b8deaa3cae04UL, 0x2aaf04f11b5d8UL, 0x6bb595a669c92UL }}},
+      {{{ 0x2a8b3a59b7a5fUL, 0x3abb359ef087fUL, 0x4f5a8c4db05afUL, 0x5b9a807d04205UL, 0x701af5b13ea50UL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 2] */
+      {{{ 0x5b0a84cee9730UL, 0x61d10c97155e4UL, 0x4059cc8096a10UL, 0x47a608da8014fUL, 0x7a164e1b9a80fUL }}},
+      {{{ 0x11fe8a4fcd265UL, 0x7bcb8374faaccUL, 0x52f5af4ef4d4fUL, 0x5314098f98d10UL, 0x2ab91587555bdUL }}},
+      {{{ 0x6933f0dd0d889UL, 0x44386bb4c4295UL, 0x3cb6d3162508cUL, 0x26368b872a2c6UL, 0x5a2826af12b9bUL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 3] */
+      {{{ 0x351b98efc099fUL, 0x68fbfa4a7050eUL, 0x42a49959d971bUL, 0x393e51a469efdUL, 0x680e910321e58UL }}},
+      {{{ 0x6050a056818bfUL, 0x62acc1f5532bfUL, 0x28141ccc9fa25UL, 0x24d61f471e683UL, 0x27933f4c7445aUL }}},
+      {{{ 0x3fbe9c476ff09UL, 0x0af6b982e4b42UL, 0x0ad1251ba78e5UL, 0x715aeedee7c88UL, 0x7f9d0cbf63553UL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 4] */
+      {{{ 0x2bc4408a5bb33UL, 0x078ebdda05442UL, 0x2ffb112354123UL, 0x375ee8df5862dUL, 0x2945ccf146e20UL }}},
+      {{{ 0x182c3a447d6baUL, 0x22964e536eff2UL, 0x192821f540053UL, 0x2f9f19e788e5cUL, 0x154a7e73eb1b5UL }}},
+      {{{ 0x3dbf1812a8285UL, 0x0fa17ba3f9797UL, 0x6f69cb49c3820UL, 0x34d5a0db3858dUL, 0x43aabe696b3bbUL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 5] */
+      {{{ 0x4eeeb77157131UL, 0x1201915f10741UL, 0x1669cda6c9c56UL, 0x45ec032db346dUL, 0x51e57bb6a2cc3UL }}},
+      {{{ 0x006b67b7d8ca4UL, 0x084fa44e72933UL, 0x1154ee55d6f8aUL, 0x4425d842e7390UL, 0x38b64c41ae417UL }}},
+      {{{ 0x4326702ea4b71UL, 0x06834376030b5UL, 0x0ef0512f9c380UL, 0x0f1a9f2512584UL, 0x10b8e91a9f0d6UL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 6] */
+      {{{ 0x25cd0944ea3bfUL, 0x75673b81a4d63UL, 0x150b925d1c0d4UL, 0x13f38d9294114UL, 0x461bea69283c9UL }}},
+      {{{ 0x72c9aaa3221b1UL, 0x267774474f74dUL, 0x064b0e9b28085UL, 0x3f04ef53b27c9UL, 0x1d6edd5d2e531UL }}},
+      {{{ 0x36dc801b8b3a2UL, 0x0e0a7d4935e30UL, 0x1deb7cecc0d7dUL, 0x053a94e20dd2cUL, 0x7a9fbb1c6a0f9UL }}},
+    }},
+    {{ /* k25519_precomp[ 0][ 7] */
+      {{{ 0x7596604dd3e8fUL, 0x6fc510e058b36UL, 0x3670c8db2cc0dUL, 0x297d899ce332fUL, 0x0915e76061bceUL }}},
+      {{{ 0x75dedf39234d9UL, 0x01c36ab1f3c54UL, 0x0f08fee58f5daUL, 0x0e19613a0d637UL, 0x3a9024a1320e0UL }}},
+      {{{ 0x1f5d9c9a2911aUL, 0x7117994fafcf8UL, 0x2d8a8cae28dc5UL, 0x74ab1b2090c87UL, 0x26907c5c2ecc4UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 1][ 0] */
+      {{{ 0x4dd0e632f9c1dUL, 0x2ced12622a5d9UL, 0x18de9614742daUL, 0x79ca96fdbb5d4UL, 0x6dd37d49a00eeUL }}},
+      {{{ 0x3635449aa515eUL, 0x3e178d0475dabUL, 0x50b4712a19712UL, 0x2dcc2860ff4adUL, 0x30d76d6f03d31UL }}},
+      {{{ 0x444172106e4c7UL, 0x01251afed2d88UL, 0x534fc9bed4f5aUL, 0x5d85a39cf5234UL, 0x10c697112e864UL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 1] */
+      {{{ 0x62aa08358c805UL, 0x46f440848e194UL, 0x447b771a8f52bUL, 0x377ba3269d31dUL, 0x03bf9baf55080UL }}},
+      {{{ 0x3c4277dbe5fdeUL, 0x5a335afd44c92UL, 0x0c1164099753eUL, 0x70487006fe423UL, 0x25e61cabed66fUL }}},
+      {{{ 0x3e128cc586604UL, 0x5968b2e8fc7e2UL, 0x049a3d5bd61cfUL, 0x116505b1ef6e6UL, 0x566d78634586eUL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 2] */
+      {{{ 0x54285c65a2fd0UL, 0x55e62ccf87420UL, 0x46bb961b19044UL, 0x1153405712039UL, 0x14fba5f34793bUL }}},
+      {{{ 0x7a49f9cc10834UL, 0x2b513788a22c6UL, 0x5ff4b6ef2395bUL, 0x2ec8e5af607bfUL, 0x33975bca5ecc3UL }}},
+      {{{ 0x746166985f7d4UL, 0x09939000ae79aUL, 0x5844c7964f97aUL, 0x13617e1f95b3dUL, 0x14829cea83fc5UL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 3] */
+      {{{ 0x70b2f4e71ecb8UL, 0x728148efc643cUL, 0x0753e03995b76UL, 0x5bf5fb2ab6767UL, 0x05fc3bc4535d7UL }}},
+      {{{ 0x37b8497dd95c2UL, 0x61549d6b4ffe8UL, 0x217a22db1d138UL, 0x0b9cf062eb09eUL, 0x2fd9c71e5f758UL }}},
+      {{{ 0x0b3ae52afdeddUL, 0x19da76619e497UL, 0x6fa0654d2558eUL, 0x78219d25e41d4UL, 0x373767475c651UL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 4] */
+      {{{ 0x095cb14246590UL, 0x002d82aa6ac68UL, 0x442f183bc4851UL, 0x6464f1c0a0644UL, 0x6bf5905730907UL }}},
+      {{{ 0x299fd40d1add9UL, 0x5f2de9a04e5f7UL, 0x7c0eebacc1c59UL, 0x4cca1b1f8290aUL, 0x1fbea56c3b18fUL }}},
+      {{{ 0x778f1e1415b8aUL, 0x6f75874efc1f4UL, 0x28a694019027fUL, 0x52b37a96bdc4dUL, 0x02521cf67a635UL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 5] */
+      {{{ 0x46720772f5ee4UL, 0x632c0f359d622UL, 0x2b2092ba3e252UL, 0x662257c112680UL, 0x001753d9f7cd6UL }}},
+      {{{ 0x7ee0b0a9d5294UL, 0x381fbeb4cca27UL, 0x7841f3a3e639dUL, 0x676ea30c3445fUL, 0x3fa00a7e71382UL }}},
+      {{{ 0x1232d963ddb34UL, 0x35692e70b078dUL, 0x247ca14777a1fUL, 0x6db556be8fcd0UL, 0x12b5fe2fa048eUL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 6] */
+      {{{ 0x37c26ad6f1e92UL, 0x46a0971227be5UL, 0x4722f0d2d9b4cUL, 0x3dc46204ee03aUL, 0x6f7e93c20796cUL }}},
+      {{{ 0x0fbc496fce34dUL, 0x575be6b7dae3eUL, 0x4a31585cee609UL, 0x037e9023930ffUL, 0x749b76f96fb12UL }}},
+      {{{ 0x2f604aea6ae05UL, 0x637dc939323ebUL, 0x3fdad9b048d47UL, 0x0a8b0d4045af7UL, 0x0fcec10f01e02UL }}},
+    }},
+    {{ /* k25519_precomp[ 1][ 7] */
+      {{{ 0x2d29dc4244e45UL, 0x6927b1bc147beUL, 0x0308534ac0839UL, 0x4853664033f41UL, 0x413779166feabUL }}},
+      {{{ 0x558a649fe1e44UL, 0x44635aeefcc89UL, 0x1ff434887f2baUL, 0x0f981220e2d44UL, 0x4901aa7183c51UL }}},
+      {{{ 0x1b7548c1af8f0UL, 0x7848c53368116UL, 0x01b64e7383de9UL, 0x109fbb0587c8fUL, 0x41bb887b726d1UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 2][ 0] */
+      {{{ 0x34c597c6691aeUL, 0x7a150b6990fc4UL, 0x52beb9d922274UL, 0x70eed7164861aUL, 0x0a871e070c6a9UL }}},
+      {{{ 0x07d44744346beUL, 0x282b6a564a81dUL, 0x4ed80f875236bUL, 0x6fbbe1d450c50UL, 0x4eb728c12fcdbUL }}},
+      {{{ 0x1b5994bbc8989UL, 0x74b7ba84c0660UL, 0x75678f1cdaeb8UL, 0x23206b0d6f10cUL, 0x3ee7300f2685dUL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 1] */
+      {{{ 0x27947841e7518UL, 0x32c7388dae87fUL, 0x414add3971be9UL, 0x01850832f0ef1UL, 0x7d47c6a2cfb89UL }}},
+      {{{ 0x255e49e7dd6b7UL, 0x38c2163d59ebaUL, 0x3861f2a005845UL, 0x2e11e4ccbaec9UL, 0x1381576297912UL }}},
+      {{{ 0x2d0148ef0d6e0UL, 0x3522a8de787fbUL, 0x2ee055e74f9d2UL, 0x64038f6310813UL, 0x148cf58d34c9eUL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 2] */
+      {{{ 0x72f7d9ae4756dUL, 0x7711e690ffc4aUL, 0x582a2355b0d16UL, 0x0dccfe885b6b4UL, 0x278febad4eaeaUL }}},
+      {{{ 0x492f67934f027UL, 0x7ded0815528d4UL, 0x58461511a6612UL, 0x5ea2e50de1544UL, 0x3ff2fa1ebd5dbUL }}},
+      {{{ 0x2681f8c933966UL, 0x3840521931635UL, 0x674f14a308652UL, 0x3bd9c88a94890UL, 0x4104dd02fe9c6UL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 3] */
+      {{{ 0x14e06db096ab8UL, 0x1219c89e6b024UL, 0x278abd486a2dbUL, 0x240b292609520UL, 0x0165b5a48efcaUL }}},
+      {{{ 0x2bf5e1124422aUL, 0x673146756ae56UL, 0x14ad99a87e830UL, 0x1eaca65b080fdUL, 0x2c863b00afaf5UL }}},
+      {{{ 0x0a474a0846a76UL, 0x099a5ef981e32UL, 0x2a8ae3c4bbfe6UL, 0x45c34af14832cUL, 0x591b67d9bffecUL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 4] */
+      {{{ 0x1b3719f18b55dUL, 0x754318c83d337UL, 0x27c17b7919797UL, 0x145b084089b61UL, 0x489b4f8670301UL }}},
+      {{{ 0x70d1c80b49bfaUL, 0x3d57e7d914625UL, 0x3c0722165e545UL, 0x5e5b93819e04fUL, 0x3de02ec7ca8f7UL }}},
+      {{{ 0x2102d3aeb92efUL, 0x68c22d50c3a46UL, 0x42ea89385894eUL, 0x75f9ebf55f38cUL, 0x49f5fbba496cbUL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 5] */
+      {{{ 0x5628c1e9c572eUL, 0x598b108e822abUL, 0x55d8fae29361aUL, 0x0adc8d1a97b28UL, 0x06a1a6c288675UL }}},
+      {{{ 0x49a108a5bcfd4UL, 0x6178c8e7d6612UL, 0x1f03473710375UL, 0x73a49614a6098UL, 0x5604a86dcbfa6UL }}},
+      {{{ 0x0d1d47c1764b6UL, 0x01c08316a2e51UL, 0x2b3db45c95045UL, 0x1634f818d300cUL, 0x20989e89fe274UL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 6] */
+      {{{ 0x4278b85eaec2eUL, 0x0ef59657be2ceUL, 0x72fd169588770UL, 0x2e9b205260b30UL, 0x730b9950f7059UL }}},
+      {{{ 0x777fd3a2dcc7fUL, 0x594a9fb124932UL, 0x01f8e80ca15f0UL, 0x714d13cec3269UL, 0x0403ed1d0ca67UL }}},
+      {{{ 0x32d35874ec552UL, 0x1f3048df1b929UL, 0x300d73b179b23UL, 0x6e67be5a37d0bUL, 0x5bd7454308303UL }}},
+    }},
+    {{ /* k25519_precomp[ 2][ 7] */
+      {{{ 0x4932115e7792aUL, 0x457b9bbb930b8UL, 0x68f5d8b193226UL, 0x4164e8f1ed456UL, 0x5bb7db123067fUL }}},
+      {{{ 0x2d19528b24cc2UL, 0x4ac66b8302ff3UL, 0x701c8d9fdad51UL, 0x6c1b35c5b3727UL, 0x133a78007380aUL }}},
+      {{{ 0x1f467c6ca62beUL, 0x2c4232a5dc12cUL, 0x7551dc013b087UL, 0x0690c11b03bcdUL, 0x740dca6d58f0eUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 3][ 0] */
+      {{{ 0x28c570478433cUL, 0x1d8502873a463UL, 0x7641e7eded49cUL, 0x1ecedd54cf571UL, 0x2c03f5256c2b0UL }}},
+      {{{ 0x0ee0752cfce4eUL, 0x660dd8116fbe9UL, 0x55167130fffebUL, 0x1c682b885955cUL, 0x161d25fa963eaUL }}},
+      {{{ 0x718757b53a47dUL, 0x619e18b0f2f21UL, 0x5fbdfe4c1ec04UL, 0x5d798c81ebb92UL, 0x699468bdbd96bUL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 1] */
+      {{{ 0x53de66aa91948UL, 0x045f81a599b1bUL, 0x3f7a8bd214193UL, 0x71d4da412331aUL, 0x293e1c4e6c4a2UL }}},
+      {{{ 0x72f46f4dafecfUL, 0x2948ffadef7a3UL, 0x11ecdfdf3bc04UL, 0x3c2e98ffeed25UL, 0x525219a473905UL }}},
+      {{{ 0x6134b925112e1UL, 0x6bb942bb406edUL, 0x070c445c0dde2UL, 0x411d822c4d7a3UL, 0x5b605c447f032UL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 2] */
+      {{{ 0x1fec6f0e7f04cUL, 0x3cebc692c477dUL, 0x077986a19a95eUL, 0x6eaaaa1778b0fUL, 0x2f12fef4cc5abUL }}},
+      {{{ 0x5805920c47c89UL, 0x1924771f9972cUL, 0x38bbddf9fc040UL, 0x1f7000092b281UL, 0x24a76dcea8aebUL }}},
+      {{{ 0x522b2dfc0c740UL, 0x7e8193480e148UL, 0x33fd9a04341b9UL, 0x3c863678a20bcUL, 0x5e607b2518a43UL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 3] */
+      {{{ 0x4431ca596cf14UL, 0x015da7c801405UL, 0x03c9b6f8f10b5UL, 0x0346922934017UL, 0x201f33139e457UL }}},
+      {{{ 0x31d8f6cdf1818UL, 0x1f86c4b144b16UL, 0x39875b8d73e9dUL, 0x2fbf0d9ffa7b3UL, 0x5067acab6ccddUL }}},
+      {{{ 0x27f6b08039d51UL, 0x4802f8000dfaaUL, 0x09692a062c525UL, 0x1baea91075817UL, 0x397cba8862460UL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 4] */
+      {{{ 0x5c3fbc81379e7UL, 0x41bbc255e2f02UL, 0x6a3f756998650UL, 0x1297fd4e07c42UL, 0x771b4022c1e1cUL }}},
+      {{{ 0x13093f05959b2UL, 0x1bd352f2ec618UL, 0x075789b88ea86UL, 0x61d1117ea48b9UL, 0x2339d320766e6UL }}},
+      {{{ 0x5d986513a2fa7UL, 0x63f3a99e11b0fUL, 0x28a0ecfd6b26dUL, 0x53b6835e18d8fUL, 0x331a189219971UL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 5] */
+      {{{ 0x12f3a9d7572afUL, 0x10d00e953c4caUL, 0x603df116f2f8aUL, 0x33dc276e0e088UL, 0x1ac9619ff649aUL }}},
+      {{{ 0x66f45fb4f80c6UL, 0x3cc38eeb9fea2UL, 0x107647270db1fUL, 0x710f1ea740dc8UL, 0x31167c6b83bdfUL }}},
+      {{{ 0x33842524b1068UL, 0x77dd39d30fe45UL, 0x189432141a0d0UL, 0x088fe4eb8c225UL, 0x612436341f08bUL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 6] */
+      {{{ 0x349e31a2d2638UL, 0x0137a7fa6b16cUL, 0x681ae92777edcUL, 0x222bfc5f8dc51UL, 0x1522aa3178d90UL }}},
+      {{{ 0x541db874e898dUL, 0x62d80fb841b33UL, 0x03e6ef027fa97UL, 0x7a03c9e9633e8UL, 0x46ebe2309e5efUL }}},
+      {{{ 0x02f5369614938UL, 0x356e5ada20587UL, 0x11bc89f6bf902UL, 0x036746419c8dbUL, 0x45fe70f505243UL }}},
+    }},
+    {{ /* k25519_precomp[ 3][ 7] */
+      {{{ 0x24920c8951491UL, 0x107ec61944c5eUL, 0x72752e017c01fUL, 0x122b7dda2e97aUL, 0x16619f6db57a2UL }}},
+      {{{ 0x075a6960c0b8cUL, 0x6dde1c5e41b49UL, 0x42e3f516da341UL, 0x16a03fda8e79eUL, 0x428d1623a0e39UL }}},
+      {{{ 0x74a4401a308fdUL, 0x06ed4b9558109UL, 0x746f1f6a08867UL, 0x4636f5c6f2321UL, 0x1d81592d60bd3UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 4][ 0] */
+      {{{ 0x5b69f7b85c5e8UL, 0x17a2d175650ecUL, 0x4cc3e6dbfc19eUL, 0x73e1d3873be0eUL, 0x3a5f6d51b0af8UL }}},
+      {{{ 0x68756a60dac5fUL, 0x55d757b8aec26UL, 0x3383df45f80bdUL, 0x6783f8c9f96a6UL, 0x20234a7789ecdUL }}},
+      {{{ 0x20db67178b252UL, 0x73aa3da2c0edaUL, 0x79045c01c70d3UL, 0x1b37b15251059UL, 0x7cd682353cffeUL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 1] */
+      {{{ 0x5cd6068acf4f3UL, 0x3079afc7a74ccUL, 0x58097650b64b4UL, 0x47fabac9c4e99UL, 0x3ef0253b2b2cdUL }}},
+      {{{ 0x1a45bd887fab6UL, 0x65748076dc17cUL, 0x5b98000aa11a8UL, 0x4a1ecc9080974UL, 0x2838c8863bdc0UL }}},
+      {{{ 0x3b0cf4a465030UL, 0x022b8aef57a2dUL, 0x2ad0677e925adUL, 0x4094167d7457aUL, 0x21dcb8a606a82UL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 2] */
+      {{{ 0x500fabe7731baUL, 0x7cc53c3113351UL, 0x7cf65fe080d81UL, 0x3c5d966011ba1UL, 0x5d840dbf6c6f6UL }}},
+      {{{ 0x004468c9d9fc8UL, 0x5da8554796b8cUL, 0x3b8be70950025UL, 0x6d5892da6a609UL, 0x0bc3d08194a31UL }}},
+      {{{ 0x6380d309fe18bUL, 0x4d73c2cb8ee0dUL, 0x6b882adbac0b6UL, 0x36eabdddd4cbeUL, 0x3a4276232ac19UL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 3] */
+      {{{ 0x0c172db447ecbUL, 0x3f8c505b7a77fUL, 0x6a857f97f3f10UL, 0x4fcc0567fe03aUL, 0x0770c9e824e1aUL }}},
+      {{{ 0x2432c8a7084faUL, 0x47bf73ca8a968UL, 0x1639176262867UL, 0x5e8df4f8010ceUL, 0x1ff177cea16deUL }}},
+      {{{ 0x1d99a45b5b5fdUL, 0x523674f2499ecUL, 0x0f8fa26182613UL, 0x58f7398048c98UL, 0x39f264fd41500UL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 4] */
+      {{{ 0x34aabfe097be1UL, 0x43bfc03253a33UL, 0x29bc7fe91b7f3UL, 0x0a761e4844a16UL, 0x65c621272c35fUL }}},
+      {{{ 0x53417dbe7e29cUL, 0x54573827394f5UL, 0x565eea6f650ddUL, 0x42050748dc749UL, 0x1712d73468889UL }}},
+      {{{ 0x389f8ce3193ddUL, 0x2d424b8177ce5UL, 0x073fa0d3440cdUL, 0x139020cd49e97UL, 0x22f9800ab19ceUL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 5] */
+      {{{ 0x29fdd9a6efdacUL, 0x7c694a9282840UL, 0x6f7cdeee44b3aUL, 0x55a3207b25cc3UL, 0x4171a4d38598cUL }}},
+      {{{ 0x2368a3e9ef8cbUL, 0x454aa08e2ac0bUL, 0x490923f8fa700UL, 0x372aa9ea4582fUL, 0x13f416cd64762UL }}},
+      {{{ 0x758aa99c94c8cUL, 0x5f6001700ff44UL, 0x7694e488c01bdUL, 0x0d5fde948eed6UL, 0x508214fa574bdUL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 6] */
+      {{{ 0x215bb53d003d6UL, 0x1179e792ca8c3UL, 0x1a0e96ac840a2UL, 0x22393e2bb3ab6UL, 0x3a7758a4c86cbUL }}},
+      {{{ 0x269153ed6fe4bUL, 0x72a23aef89840UL, 0x052be5299699cUL, 0x3a5e5ef132316UL, 0x22f960ec6fabaUL }}},
+      {{{ 0x111f693ae5076UL, 0x3e3bfaa94ca90UL, 0x445799476b887UL, 0x24a0912464879UL, 0x5d9fd15f8de7fUL }}},
+    }},
+    {{ /* k25519_precomp[ 4][ 7] */
+      {{{ 0x44d2aeed7521eUL, 0x50865d2c2a7e4UL, 0x2705b5238ea40UL, 0x46c70b25d3b97UL, 0x3bc187fa47eb9UL }}},
+      {{{ 0x408d36d63727fUL, 0x5faf8f6a66062UL, 0x2bb892da8de6bUL, 0x769d4f0c7e2e6UL, 0x332f35914f8fbUL }}},
+      {{{ 0x70115ea86c20cUL, 0x16d88da24ada8UL, 0x1980622662adfUL, 0x501ebbc195a9dUL, 0x450d81ce906fbUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 5][ 0] */
+      {{{ 0x4d8961cae743fUL, 0x6bdc38c7dba0eUL, 0x7d3b4a7e1b463UL, 0x0844bdee2adf3UL, 0x4cbad279663abUL }}},
+      {{{ 0x3b6a1a6205275UL, 0x2e82791d06dcfUL, 0x23d72caa93c87UL, 0x5f0b7ab68aaf4UL, 0x2de25d4ba6345UL }}},
+      {{{ 0x19024a0d71fcdUL, 0x15f65115f101aUL, 0x4e99067149708UL, 0x119d8d1cba5afUL, 0x7d7fbcefe2007UL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 1] */
+      {{{ 0x45dc5f3c29094UL, 0x3455220b579afUL, 0x070c1631e068aUL, 0x26bc0630e9b21UL, 0x4f9cd196dcd8dUL }}},
+      {{{ 0x71e6a266b2801UL, 0x09aae73e2df5dUL, 0x40dd8b219b1a3UL, 0x546fb4517de0dUL, 0x5975435e87b75UL }}},
+      {{{ 0x297d86a7b3768UL, 0x4835a2f4c6332UL, 0x070305f434160UL, 0x183dd014e56aeUL, 0x7ccdd084387a0UL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 2] */
+      {{{ 0x484186760cc93UL, 0x7435665533361UL, 0x02f686336b801UL, 0x5225446f64331UL, 0x3593ca848190cUL }}},
+      {{{ 0x6422c6d260417UL, 0x212904817bb94UL, 0x5a319deb854f5UL, 0x7a9d4e060da7dUL, 0x428bd0ed61d0cUL }}},
+      {{{ 0x3189a5e849aa7UL, 0x6acbb1f59b242UL, 0x7f6ef4753630cUL, 0x1f346292a2da9UL, 0x27398308da2d6UL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 3] */
+      {{{ 0x10e4c0a702453UL, 0x4daafa37bd734UL, 0x49f6bdc3e8961UL, 0x1feffdcecdae6UL, 0x572c2945492c3UL }}},
+      {{{ 0x38d28435ed413UL, 0x4064f19992858UL, 0x7680fbef543cdUL, 0x1aadd83d58d3cUL, 0x269597aebe8c3UL }}},
+      {{{ 0x7c745d6cd30beUL, 0x27c7755df78efUL, 0x1776833937fa3UL, 0x5405116441855UL, 0x7f985498c05bcUL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 4] */
+      {{{ 0x615520fbf6363UL, 0x0b9e9bf74da6aUL, 0x4fe8308201169UL, 0x173f76127de43UL, 0x30f2653cd69b1UL }}},
+      {{{ 0x1ce889f0be117UL, 0x36f6a94510709UL, 0x7f248720016b4UL, 0x1821ed1e1cf91UL, 0x76c2ec470a31fUL }}},
+      {{{ 0x0c938aac10c85UL, 0x41b64ed797141UL, 0x1beb1c1185e6dUL, 0x1ed5490600f07UL, 0x2f1273f159647UL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 5] */
+      {{{ 0x08bd755a70bc0UL, 0x49e3a885ce609UL, 0x16585881b5ad6UL, 0x3c27568d34f5eUL, 0x38ac1997edc5fUL }}},
+      {{{ 0x1fc7c8ae01e11UL, 0x2094d5573e8e7UL, 0x5ca3cbbf549d2UL, 0x4f920ecc54143UL, 0x5d9e572ad85b6UL }}},
+      {{{ 0x6b517a751b13bUL, 0x0cfd370b180ccUL, 0x5377925d1f41aUL, 0x34e56566008a2UL, 0x22dfcd9cbfe9eUL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 6] */
+      {{{ 0x459b4103be0a1UL, 0x59a4b3f2d2addUL, 0x7d734c8bb8eebUL, 0x2393cbe594a09UL, 0x0fe9877824cdeUL }}},
+      {{{ 0x3d2e0c30d0cd9UL, 0x3f597686671bbUL, 0x0aa587eb63999UL, 0x0e3c7b592c619UL, 0x6b2916c05448cUL }}},
+      {{{ 0x334d10aba913bUL, 0x045cdb581cfdbUL, 0x5e3e0553a8f36UL, 0x50bb3041effb2UL, 0x4c303f307ff00UL }}},
+    }},
+    {{ /* k25519_precomp[ 5][ 7] */
+      {{{ 0x403580dd94500UL, 0x48df77d92653fUL, 0x38a9fe3b349eaUL, 0x0ea89850aafe1UL, 0x416b151ab706aUL }}},
+      {{{ 0x23bd617b28c85UL, 0x6e72ee77d5a61UL, 0x1a972ff174ddeUL, 0x3e2636373c60fUL, 0x0d61b8f78b2abUL }}},
+      {{{ 0x0d7efe9c136b0UL, 0x1ab1c89640ad5UL, 0x55f82aef41f97UL, 0x46957f317ed0dUL, 0x191a2af74277eUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 6][ 0] */
+      {{{ 0x62b434f460efbUL, 0x294c6c0fad3fcUL, 0x68368937b4c0fUL, 0x5c9f82910875bUL, 0x237e7dbe00545UL }}},
+      {{{ 0x6f74bc53c1431UL, 0x1c40e5dbbd9c2UL, 0x6c8fb9cae5c97UL, 0x4845c5ce1b7daUL, 0x7e2e0e450b5ccUL }}},
+      {{{ 0x575ed6701b430UL, 0x4d3e17fa20026UL, 0x791fc888c4253UL, 0x2f1ba99078ac1UL, 0x71afa699b1115UL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 1] */
+      {{{ 0x23c1c473b50d6UL, 0x3e7671de21d48UL, 0x326fa5547a1e8UL, 0x50e4dc25fafd9UL, 0x00731fbc78f89UL }}},
+      {{{ 0x66f9b3953b61dUL, 0x555f4283cccb9UL, 0x7dd67fb1960e7UL, 0x14707a1affed4UL, 0x021142e9c2b1cUL }}},
+      {{{ 0x0c71848f81880UL, 0x44bd9d8233c86UL, 0x6e8578efe5830UL, 0x4045b6d7041b5UL, 0x4c4d6f3347e15UL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 2] */
+      {{{ 0x4ddfc988f1970UL, 0x4f6173ea365e1UL, 0x645daf9ae4588UL, 0x7d43763db623bUL, 0x38bf9500a88f9UL }}},
+      {{{ 0x7eccfc17d1fc9UL, 0x4ca280782831eUL, 0x7b8337db1d7d6UL, 0x5116def3895fbUL, 0x193fddaaa7e47UL }}},
+      {{{ 0x2c93c37e8876fUL, 0x3431a28c583faUL, 0x49049da8bd879UL, 0x4b4a8407ac11cUL, 0x6a6fb99ebf0d4UL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 3] */
+      {{{ 0x122b5b6e423c6UL, 0x21e50dff1ddd6UL, 0x73d76324e75c0UL, 0x588485495418eUL, 0x136fda9f42c5eUL }}},
+      {{{ 0x6c1bb560855ebUL, 0x71f127e13ad48UL, 0x5c6b304905aecUL, 0x3756b8e889bc7UL, 0x75f76914a3189UL }}},
+      {{{ 0x4dfb1a305bdd1UL, 0x3b3ff05811f29UL, 0x6ed62283cd92eUL, 0x65d1543ec52e1UL, 0x022183510be8dUL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 4] */
+      {{{ 0x2710143307a7fUL, 0x3d88fb48bf3abUL, 0x249eb4ec18f7aUL, 0x136115dff295fUL, 0x1387c441fd404UL }}},
+      {{{ 0x766385ead2d14UL, 0x0194f8b06095eUL, 0x08478f6823b62UL, 0x6018689d37308UL, 0x6a071ce17b806UL }}},
+      {{{ 0x3c3d187978af8UL, 0x7afe1c88276baUL, 0x51df281c8ad68UL, 0x64906bda4245dUL, 0x3171b26aaf1edUL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 5] */
+      {{{ 0x5b7d8b28a47d1UL, 0x2c2ee149e34c1UL, 0x776f5629afc53UL, 0x1f4ea50fc49a9UL, 0x6c514a6334424UL }}},
+      {{{ 0x7319097564ca8UL, 0x1844ebc233525UL, 0x21d4543fdeee1UL, 0x1ad27aaff1bd2UL, 0x221fd4873cf08UL }}},
+      {{{ 0x2204f3a156341UL, 0x537414065a464UL, 0x43c0c3bedcf83UL, 0x5557e706ea620UL, 0x48daa596fb924UL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 6] */
+      {{{ 0x61d5dc84c9793UL, 0x47de83040c29eUL, 0x189deb26507e7UL, 0x4d4e6fadc479aUL, 0x58c837fa0e8a7UL }}},
+      {{{ 0x28e665ca59cc7UL, 0x165c715940dd9UL, 0x0785f3aa11c95UL, 0x57b98d7e38469UL, 0x676dd6fccad84UL }}},
+      {{{ 0x1688596fc9058UL, 0x66f6ad403619fUL, 0x4d759a87772efUL, 0x7856e6173bea4UL, 0x1c4f73f2c6a57UL }}},
+    }},
+    {{ /* k25519_precomp[ 6][ 7] */
+      {{{ 0x6706efc7c3484UL, 0x6987839ec366dUL, 0x0731f95cf7f26UL, 0x3ae758ebce4bcUL, 0x70459adb7daf6UL }}},
+      {{{ 0x24fbd305fa0bbUL, 0x40a98cc75a1cfUL, 0x78ce1220a7533UL, 0x6217a10e1c197UL, 0x795ac80d1bf64UL }}},
+      {{{ 0x1db4991b42bb3UL, 0x469605b994372UL, 0x631e3715c9a58UL, 0x7e9cfefcf728fUL, 0x5fe162848ce21UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 7][ 0] */
+      {{{ 0x1852d5d7cb208UL, 0x60d0fbe5ce50fUL, 0x5a1e246e37b75UL, 0x51aee05ffd590UL, 0x2b44c043677daUL }}},
+      {{{ 0x1214fe194961aUL, 0x0e1ae39a9e9cbUL, 0x543c8b526f9f7UL, 0x119498067e91dUL, 0x4789d446fc917UL }}},
+      {{{ 0x487ab074eb78eUL, 0x1d33b5e8ce343UL, 0x13e419feb1b46UL, 0x2721f565de6a4UL, 0x60c52eef2bb9aUL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 1] */
+      {{{ 0x3c5c27cae6d11UL, 0x36a9491956e05UL, 0x124bac9131da6UL, 0x3b6f7de202b5dUL, 0x70d77248d9b66UL }}},
+      {{{ 0x589bc3bfd8bf1UL, 0x6f93e6aa3416bUL, 0x4c0a3d6c1ae48UL, 0x55587260b586aUL, 0x10bc9c312ccfcUL }}},
+      {{{ 0x2e84b3ec2a05bUL, 0x69da2f03c1551UL, 0x23a174661a67bUL, 0x209bca289f238UL, 0x63755bd3a976fUL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 2] */
+      {{{ 0x7101897f1acb7UL, 0x3d82cb77b07b8UL, 0x684083d7769f5UL, 0x52b28472dce07UL, 0x2763751737c52UL }}},
+      {{{ 0x7a03e2ad10853UL, 0x213dcc6ad36abUL, 0x1a6e240d5bdd6UL, 0x7c24ffcf8fedfUL, 0x0d8cc1c48bc16UL }}},
+      {{{ 0x402d36eb419a9UL, 0x7cef68c14a052UL, 0x0f1255bc2d139UL, 0x373e7d431186aUL, 0x70c2dd8a7ad16UL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 3] */
+      {{{ 0x4967db8ed7e13UL, 0x15aeed02f523aUL, 0x6149591d094bcUL, 0x672f204c17006UL, 0x32b8613816a53UL }}},
+      {{{ 0x194509f6fec0eUL, 0x528d8ca31acacUL, 0x7826d73b8b9faUL, 0x24acb99e0f9b3UL, 0x2e0fac6363948UL }}},
+      {{{ 0x7f7bee448cd64UL, 0x4e10f10da0f3cUL, 0x3936cb9ab20e9UL, 0x7a0fc4fea6cd0UL, 0x4179215c735a4UL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 4] */
+      {{{ 0x633b9286bcd34UL, 0x6cab3badb9c95UL, 0x74e387edfbdfaUL, 0x14313c58a0fd9UL, 0x31fa85662241cUL }}},
+      {{{ 0x094e7d7dced2aUL, 0x068fa738e118eUL, 0x41b640a5fee2bUL, 0x6bb709df019d4UL, 0x700344a30cd99UL }}},
+      {{{ 0x26c422e3622f4UL, 0x0f3066a05b5f0UL, 0x4e2448f0480a6UL, 0x244cde0dbf095UL, 0x24bb2312a9952UL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 5] */
+      {{{ 0x00c2af5f85c6bUL, 0x0609f4cf2883fUL, 0x6e86eb5a1ca13UL, 0x68b44a2efccd1UL, 0x0d1d2af9ffeb5UL }}},
+      {{{ 0x0ed1732de67c3UL, 0x308c369291635UL, 0x33ef348f2d250UL, 0x004475ea1a1bbUL, 0x0fee3e871e188UL }}},
+      {{{ 0x28aa132621edfUL, 0x42b244caf353bUL, 0x66b064cc2e08aUL, 0x6bb20020cbdd3UL, 0x16acd79718531UL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 6] */
+      {{{ 0x1c6c57887b6adUL, 0x5abf21fd7592bUL, 0x50bd41253867aUL, 0x3800b71273151UL, 0x164ed34b18161UL }}},
+      {{{ 0x772af2d9b1d3dUL, 0x6d486448b4e5bUL, 0x2ce58dd8d18a8UL, 0x1849f67503c8bUL, 0x123e0ef6b9302UL }}},
+      {{{ 0x6d94c192fe69aUL, 0x5475222a2690fUL, 0x693789d86b8b3UL, 0x1f5c3bdfb69dcUL, 0x78da0fc61073fUL }}},
+    }},
+    {{ /* k25519_precomp[ 7][ 7] */
+      {{{ 0x780f1680c3a94UL, 0x2a35d3cfcd453UL, 0x005e5cdc7ddf8UL, 0x6ee888078ac24UL, 0x054aa4b316b38UL }}},
+      {{{ 0x15d28e52bc66aUL, 0x30e1e0351cb7eUL, 0x30a2f74b11f8cUL, 0x39d120cd7de03UL, 0x2d25deeb256b1UL }}},
+      {{{ 0x0468d19267cb8UL, 0x38cdca9b5fbf9UL, 0x1bbb05c2ca1e2UL, 0x3b015758e9533UL, 0x134610a6ab7daUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 8][ 0] */
+      {{{ 0x265e777d1f515UL, 0x0f1f54c1e39a5UL, 0x2f01b95522646UL, 0x4fdd8db9dde6dUL, 0x654878cba97ccUL }}},
+      {{{ 0x38ec78df6b0feUL, 0x13caebea36a22UL, 0x5ebc6e54e5f6aUL, 0x32804903d0eb8UL, 0x2102fdba2b20dUL }}},
+      {{{ 0x6e405055ce6a1UL, 0x5024a35a532d3UL, 0x1f69054daf29dUL, 0x15d1d0d7a8bd5UL, 0x0ad725db29ecbUL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 1] */
+      {{{ 0x7bc0c9b056f85UL, 0x51cfebffaffd8UL, 0x44abbe94df549UL, 0x7ecbbd7e33121UL, 0x4f675f5302399UL }}},
+      {{{ 0x267b1834e2457UL, 0x6ae19c378bb88UL, 0x7457b5ed9d512UL, 0x3280d783d05fbUL, 0x4aefcffb71a03UL }}},
+      {{{ 0x536360415171eUL, 0x2313309077865UL, 0x251444334afbcUL, 0x2b0c3853756e8UL, 0x0bccbb72a2a86UL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 2] */
+      {{{ 0x55e4c50fe1296UL, 0x05fdd13efc30dUL, 0x1c0c6c380e5eeUL, 0x3e11de3fb62a8UL, 0x6678fd69108f3UL }}},
+      {{{ 0x6962feab1a9c8UL, 0x6aca28fb9a30bUL, 0x56db7ca1b9f98UL, 0x39f58497018ddUL, 0x4024f0ab59d6bUL }}},
+      {{{ 0x6fa31636863c2UL, 0x10ae5a67e42b0UL, 0x27abbf01fda31UL, 0x380a7b9e64fbcUL, 0x2d42e2108ead4UL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 3] */
+      {{{ 0x17b0d0f537593UL, 0x16263c0c9842eUL, 0x4ab827e4539a4UL, 0x6370ddb43d73aUL, 0x420bf3a79b423UL }}},
+      {{{ 0x5131594dfd29bUL, 0x3a627e98d52feUL, 0x1154041855661UL, 0x19175d09f8384UL, 0x676b2608b8d2dUL }}},
+      {{{ 0x0ba651c5b2b47UL, 0x5862363701027UL, 0x0c4d6c219c6dbUL, 0x0f03dff8658deUL, 0x745d2ffa9c0cfUL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 4] */
+      {{{ 0x6df5721d34e6aUL, 0x4f32f767a0c06UL, 0x1d5abeac76e20UL, 0x41ce9e104e1e4UL, 0x06e15be54c1dcUL }}},
+      {{{ 0x25a1e2bc9c8bdUL, 0x104c8f3b037eaUL, 0x405576fa96c98UL, 0x2e86a88e3876fUL, 0x1ae23ceb960cfUL }}},
+      {{{ 0x25d871932994aUL, 0x6b9d63b560b6eUL, 0x2df2814c8d472UL, 0x0fbbee20aa4edUL, 0x58ded861278ecUL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 5] */
+      {{{ 0x35ba8b6c2c9a8UL, 0x1dea58b3185bfUL, 0x4b455cd23bbbeUL, 0x5ec19c04883f8UL, 0x08ba696b531d5UL }}},
+      {{{ 0x73793f266c55cUL, 0x0b988a9c93b02UL, 0x09b0ea32325dbUL, 0x37cae71c17c5eUL, 0x2ff39de85485fUL }}},
+      {{{ 0x53eeec3efc57aUL, 0x2fa9fe9022efdUL, 0x699c72c138154UL, 0x72a751ebd1ff8UL, 0x120633b4947cfUL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 6] */
+      {{{ 0x531474912100aUL, 0x5afcdf7c0d057UL, 0x7a9e71b788dedUL, 0x5ef708f3b0c88UL, 0x07433be3cb393UL }}},
+      {{{ 0x4987891610042UL, 0x79d9d7f5d0172UL, 0x3c293013b9ec4UL, 0x0c2b85f39cacaUL, 0x35d30a99b4d59UL }}},
+      {{{ 0x144c05ce997f4UL, 0x4960b8a347fefUL, 0x1da11f15d74f7UL, 0x54fac19c0feadUL, 0x2d873ede7af6dUL }}},
+    }},
+    {{ /* k25519_precomp[ 8][ 7] */
+      {{{ 0x202e14e5df981UL, 0x2ea02bc3eb54cUL, 0x38875b2883564UL, 0x1298c513ae9ddUL, 0x0543618a01600UL }}},
+      {{{ 0x2316443373409UL, 0x5de95503b22afUL, 0x699201beae2dfUL, 0x3db5849ff737aUL, 0x2e773654707faUL }}},
+      {{{ 0x2bdf4974c23c1UL, 0x4b3b9c8d261bdUL, 0x26ae8b2a9bc28UL, 0x3068210165c51UL, 0x4b1443362d079UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[ 9][ 0] */
+      {{{ 0x454e91c529ccbUL, 0x24c98c6bf72cfUL, 0x0486594c3d89aUL, 0x7ae13a3d7fa3cUL, 0x17038418eaf66UL }}},
+      {{{ 0x4b7c7b66e1f7aUL, 0x4bea185efd998UL, 0x4fabc711055f8UL, 0x1fb9f7836fe38UL, 0x582f446752da6UL }}},
+      {{{ 0x17bd320324ce4UL, 0x51489117898c6UL, 0x1684d92a0410bUL, 0x6e4d90f78c5a7UL, 0x0c2a1c4bcda28UL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 1] */
+      {{{ 0x4814869bd6945UL, 0x7b7c391a45db8UL, 0x57316ac35b641UL, 0x641e31de9096aUL, 0x5a6a9b30a314dUL }}},
+      {{{ 0x5c7d06f1f0447UL, 0x7db70f80b3a49UL, 0x6cb4a3ec89a78UL, 0x43be8ad81397dUL, 0x7c558bd1c6f64UL }}},
+      {{{ 0x41524d396463dUL, 0x1586b449e1a1dUL, 0x2f17e904aed8aUL, 0x7e1d2861d3c8eUL, 0x0404a5ca0afbaUL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 2] */
+      {{{ 0x49e1b2a416fd1UL, 0x51c6a0b316c57UL, 0x575a59ed71bdcUL, 0x74c021a1fec1eUL, 0x39527516e7f8eUL }}},
+      {{{ 0x740070aa743d6UL, 0x16b64cbdd1183UL, 0x23f4b7b32eb43UL, 0x319aba58235b3UL, 0x46395bfdcadd9UL }}},
+      {{{ 0x7db2d1a5d9a9cUL, 0x79a200b85422fUL, 0x355bfaa71dd16UL, 0x00b77ea5f78aaUL, 0x76579a29e822dUL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 3] */
+      {{{ 0x4b51352b434f2UL, 0x1327bd01c2667UL, 0x434d73b60c8a1UL, 0x3e0daa89443baUL, 0x02c514bb2a277UL }}},
+      {{{ 0x68e7e49c02a17UL, 0x45795346fe8b6UL, 0x089306c8f3546UL, 0x6d89f6b2f88f6UL, 0x43a384dc9e05bUL }}},
+      {{{ 0x3d5da8bf1b645UL, 0x7ded6a96a6d09UL, 0x6c3494fee2f4dUL, 0x02c989c8b6bd4UL, 0x1160920961548UL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 4] */
+      {{{ 0x05616369b4dcdUL, 0x4ecab86ac6f47UL, 0x3c60085d700b2UL, 0x0213ee10dfceaUL, 0x2f637d7491e6eUL }}},
+      {{{ 0x5166929dacfaaUL, 0x190826b31f689UL, 0x4f55567694a7dUL, 0x705f4f7b1e522UL, 0x351e125bc5698UL }}},
+      {{{ 0x49b461af67bbeUL, 0x75915712c3a96UL, 0x69a67ef580c0dUL, 0x54d38ef70cffcUL, 0x7f182d06e7ce2UL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 5] */
+      {{{ 0x54b728e217522UL, 0x69a90971b0128UL, 0x51a40f2a963a3UL, 0x10be9ac12a6bfUL, 0x44acc043241c5UL }}},
+      {{{ 0x48e64ab0168ecUL, 0x2a2bdb8a86f4fUL, 0x7343b6b2d6929UL, 0x1d804aa8ce9a3UL, 0x67d4ac8c343e9UL }}},
+      {{{ 0x56bbb4f7a5777UL, 0x29230627c238fUL, 0x5ad1a122cd7fbUL, 0x0dea56e50e364UL, 0x556d1c8312ad7UL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 6] */
+      {{{ 0x06756b11be821UL, 0x462147e7bb03eUL, 0x26519743ebfe0UL, 0x782fc59682ab5UL, 0x097abe38cc8c7UL }}},
+      {{{ 0x740e30c8d3982UL, 0x7c2b47f4682fdUL, 0x5cd91b8c7dc1cUL, 0x77fa790f9e583UL, 0x746c6c6d1d824UL }}},
+      {{{ 0x1c9877ea52da4UL, 0x2b37b83a86189UL, 0x733af49310da5UL, 0x25e81161c04fbUL, 0x577e14a34bee8UL }}},
+    }},
+    {{ /* k25519_precomp[ 9][ 7] */
+      {{{ 0x6cebebd4dd72bUL, 0x340c1e442329fUL, 0x32347ffd1a93fUL, 0x14a89252cbbe0UL, 0x705304b8fb009UL }}},
+      {{{ 0x268ac61a73b0aUL, 0x206f234bebe1cUL, 0x5b403a7cbebe8UL, 0x7a160f09f4135UL, 0x60fa7ee96fd78UL }}},
+      {{{ 0x51d354d296ec6UL, 0x7cbf5a63b16c7UL, 0x2f50bb3cf0c14UL, 0x1feb385cac65aUL, 0x21398e0ca1635UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[10][ 0] */
+      {{{ 0x0aaf9b4b75601UL, 0x26b91b5ae44f3UL, 0x6de808d7ab1c8UL, 0x6a769675530b0UL, 0x1bbfb284e98f7UL }}},
+      {{{ 0x5058a382b33f3UL, 0x175a91816913eUL, 0x4f6cdb96b8ae8UL, 0x17347c9da81d2UL, 0x5aa3ed9d95a23UL }}},
+      {{{ 0x777e9c7d96561UL, 0x28e58f006ccacUL, 0x541bbbb2cac49UL, 0x3e63282994cecUL, 0x4a07e14e5e895UL }}},
+    }},
+    {{ /* k25519_precomp[10][ 1] */
+      {{{ 0x358cdc477a49bUL, 0x3cc88fe02e481UL, 0x721aab7f4e36bUL, 0x0408cc9469953UL, 0x50af7aed84afaUL }}},
+      {{{ 0x412cb980df999UL, 0x5e78dd8ee29dcUL, 0x171dff68c575dUL, 0x2015dd2f6ef49UL, 0x3f0bac391d313UL }}},
+      {{{ 0x7de0115f65be5UL, 0x4242c21364dc9UL, 0x6b75b64a66098UL, 0x0033c0102c085UL, 0x1921a316baebdUL }}},
+    }},
+    {{ /* k25519_precomp[10][ 2] */
+      {{{ 0x2ad9ad9f3c18bUL, 0x5ec1638339aebUL, 0x5703b6559a83bUL, 0x3fa9f4d05d612UL, 0x7b049deca062cUL }}},
+      {{{ 0x22f7edfb870fcUL, 0x569eed677b128UL, 0x30937dcb0a5afUL, 0x758039c78ea1bUL, 0x6458df41e273aUL }}},
+      {{{ 0x3e37a35444483UL, 0x661fdb7d27b99UL, 0x317761dd621e4UL, 0x7323c30026189UL, 0x6093dccbc2950UL }}},
+    }},
+    {{ /* k25519_precomp[10][ 3] */
+      {{{ 0x6eebe6084034bUL, 0x6cf01f70a8d7bUL, 0x0b41a54c6670aUL, 0x6c84b99bb55dbUL, 0x6e3180c98b647UL }}},
+      {{{ 0x39a8585e0706dUL, 0x3167ce72663feUL, 0x63d14ecdb4297UL, 0x4be21dcf970b8UL, 0x57d1ea084827aUL }}},
+      {{{ 0x2b6e7a128b071UL, 0x5b27511755dcfUL, 0x08584c2930565UL, 0x68c7bda6f4159UL, 0x363e999ddd97bUL }}},
+    }},
+    {{ /* k25519_precomp[10][ 4] */
+      {{{ 0x048dce24baec6UL, 0x2b75795ec05e3UL, 0x3bfa4c5da6dc9UL, 0x1aac8659e371eUL, 0x231f979bc6f9bUL }}},
+      {{{ 0x043c135ee1fc4UL, 0x2a11c9919f2d5UL, 0x6334cc25dbacdUL, 0x295da17b400daUL, 0x48ee9b78693a0UL }}},
+      {{{ 0x1de4bcc2af3c6UL, 0x61fc411a3eb86UL, 0x53ed19ac12ec0UL, 0x209dbc6b804e0UL, 0x079bfa9b08792UL }}},
+    }},
+    {{ /* k25519_precomp[10][ 5] */
+      {{{ 0x1ed80a2d54245UL, 0x70efec72a5e79UL, 0x42151d42a822dUL, 0x1b5ebb6d631e8UL, 0x1ef4fb1594706UL }}},
+      {{{ 0x03a51da300df4UL, 0x467b52b561c72UL, 0x4d5920210e590UL, 0x0ca769e789685UL, 0x038c77f684817UL }}},
+      {{{ 0x65ee65b167becUL, 0x052da19b850a9UL, 0x0408665656429UL, 0x7ab39596f9a4cUL, 0x575ee92a4a0bfUL }}},
+    }},
+    {{ /* k25519_precomp[10][ 6] */
+      {{{ 0x6bc450aa4d801UL, 0x4f4a6773b0ba8UL, 0x6241b0b0ebc48UL, 0x40d9c4f1d9315UL, 0x200a1e7e382f5UL }}},
+      {{{ 0x080908a182fcfUL, 0x0532913b7ba98UL, 0x3dccf78c385c3UL, 0x68002dd5eaba9UL, 0x43d4e7112cd3fUL }}},
+      {{{ 0x5b967eaf93ac5UL, 0x360acca580a31UL, 0x1c65fd5c6f262UL, 0x71c7f15c2ecabUL, 0x050eca52651e4UL }}},
+    }},
+    {{ /* k25519_precomp[10][ 7] */
+      {{{ 0x4397660e668eaUL, 0x7c2a75692f2f5UL, 0x3b29e7e6c66efUL, 0x72ba658bcda9aUL, 0x6151c09fa131aUL }}},
+      {{{ 0x31ade453f0c9cUL, 0x3dfee07737868UL, 0x611ecf7a7d411UL, 0x2637e6cbd64f6UL, 0x4b0ee6c21c58fUL }}},
+      {{{ 0x55c0dfdf05d96UL, 0x405569dcf475eUL, 0x05c5c277498bbUL, 0x18588d95dc389UL, 0x1fef24fa800f0UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[11][ 0] */
+      {{{ 0x2aff530976b86UL, 0x0d85a48c0845aUL, 0x796eb963642e0UL, 0x60bee50c4b626UL, 0x28005fe6c8340UL }}},
+      {{{ 0x653fb1aa73196UL, 0x607faec8306faUL, 0x4e85ec83e5254UL, 0x09f56900584fdUL, 0x544d49292fc86UL }}},
+      {{{ 0x7ba9f34528688UL, 0x284a20fb42d5dUL, 0x3652cd9706ffeUL, 0x6fd7baddde6b3UL, 0x72e472930f316UL }}},
+    }},
+    {{ /* k25519_precomp[11][ 1] */
+      {{{ 0x3f635d32a7627UL, 0x0cbecacde00feUL, 0x3411141eaa936UL, 0x21c1e42f3cb94UL, 0x1fee7f000fe06UL }}},
+      {{{ 0x5208c9781084fUL, 0x16468a1dc24d2UL, 0x7bf780ac540a8UL, 0x1a67eced75301UL, 0x5a9d2e8c2733aUL }}},
+      {{{ 0x305da03dbf7e5UL, 0x1228699b7aecaUL, 0x12a23b2936bc9UL, 0x2a1bda56ae6e9UL, 0x00f94051ee040UL }}},
+    }},
+    {{ /* k25519_precomp[11][ 2] */
+      {{{ 0x793bb07af9753UL, 0x1e7b6ecd4fafdUL, 0x02c7b1560fb43UL, 0x2296734cc5fb7UL, 0x47b7ffd25dd40UL }}},
+      {{{ 0x56b23c3d330b2UL, 0x37608e360d1a6UL, 0x10ae0f3c8722eUL, 0x086d9b618b637UL, 0x07d79c7e8beabUL }}},
+      {{{ 0x3fb9cbc08dd12UL, 0x75c3dd85370ffUL, 0x47f06fe2819acUL, 0x5db06ab9215edUL, 0x1c3520a35ea64UL }}},
+    }},
+    {{ /* k25519_precomp[11][ 3] */
+      {{{ 0x06f40216bc059UL, 0x3a2579b0fd9b5UL, 0x71c26407eec8cUL, 0x72ada4ab54f0bUL, 0x38750c3b66d12UL }}},
+      {{{ 0x253a6bccba34aUL, 0x427070433701aUL, 0x20b8e58f9870eUL, 0x337c861db00ccUL, 0x1c3d05775d0eeUL }}},
+      {{{ 0x6f1409422e51aUL, 0x7856bbece2d25UL, 0x13380a72f031cUL, 0x43e1080a7f3baUL, 0x0621e2c7d3304UL }}},
+    }},
+    {{ /* k25519_precomp[11][ 4] */
+      {{{ 0x61796b0dbf0f3UL, 0x73c2f9c32d6f5UL, 0x6aa8ed1537ebeUL, 0x74e92c91838f4UL, 0x5d8e589ca1002UL }}},
+      {{{ 0x060cc8259838dUL, 0x038d3f35b95f3UL, 0x56078c243a923UL, 0x2de3293241bb2UL, 0x0007d6097bd3aUL }}},
+      {{{ 0x71d950842a94bUL, 0x46b11e5c7d817UL, 0x5478bbecb4f0dUL, 0x7c3054b0a1c5dUL, 0x1583d7783c1cbUL }}},
+    }},
+    {{ /* k25519_precomp[11][ 5] */
+      {{{ 0x34704cc9d28c7UL, 0x3dee598b1f200UL, 0x16e1c98746d9eUL, 0x4050b7095afdfUL, 0x4958064e83c55UL }}},
+      {{{ 0x6a2ef5da27ae1UL, 0x28aace02e9d9dUL, 0x02459e965f0e8UL, 0x7b864d3150933UL, 0x252a5f2e81ed8UL }}},
+      {{{ 0x094265066e80dUL, 0x0a60f918d61a5UL, 0x0444bf7f30fdeUL, 0x1c40da9ed3c06UL, 0x079c170bd843bUL }}},
+    }},
+    {{ /* k25519_precomp[11][ 6] */
+      {{{ 0x6cd50c0d5d056UL, 0x5b7606ae779baUL, 0x70fbd226bdda1UL, 0x5661e53391ff9UL, 0x6768c0d7317b8UL }}},
+      {{{ 0x6ece464fa6fffUL, 0x3cc40bca460a0UL, 0x6e3a90afb8d0cUL, 0x5801abca11228UL, 0x6dec05e34ac9fUL }}},
+      {{{ 0x625e5f155c1b3UL, 0x4f32f6f723296UL, 0x5ac980105efceUL, 0x17a61165eee36UL, 0x51445e14ddcd5UL }}},
+    }},
+    {{ /* k25519_precomp[11][ 7] */
+      {{{ 0x147ab2bbea455UL, 0x1f240f2253126UL, 0x0c3de9e314e89UL, 0x21ea5a4fca45fUL, 0x12e990086e4fdUL }}},
+      {{{ 0x02b4b3b144951UL, 0x5688977966aeaUL, 0x18e176e399ffdUL, 0x2e45c5eb4938bUL, 0x13186f31e3929UL }}},
+      {{{ 0x496b37fdfbb2eUL, 0x3c2439d5f3e21UL, 0x16e60fe7e6a4dUL, 0x4d7ef889b621dUL, 0x77b2e3f05d3e9UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[12][ 0] */
+      {{{ 0x0639c12ddb0a4UL, 0x6180490cd7ab3UL, 0x3f3918297467cUL, 0x74568be1781acUL, 0x07a195152e095UL }}},
+      {{{ 0x7a9c59c2ec4deUL, 0x7e9f09e79652dUL, 0x6a3e422f22d86UL, 0x2ae8e3b836c8bUL, 0x63b795fc7ad32UL }}},
+      {{{ 0x68f02389e5fc8UL, 0x059f1bc877506UL, 0x504990e410cecUL, 0x09bd7d0feaee2UL, 0x3e8fe83d032f0UL }}},
+    }},
+    {{ /* k25519_precomp[12][ 1] */
+      {{{ 0x04c8de8efd13cUL, 0x1c67c06e6210eUL, 0x183378f7f146aUL, 0x64352ceaed289UL, 0x22d60899a6258UL }}},
+      {{{ 0x315b90570a294UL, 0x60ce108a925f1UL, 0x6eff61253c909UL, 0x003ef0e2d70b0UL, 0x75ba3b797fac4UL }}},
+      {{{ 0x1dbc070cdd196UL, 0x16d8fb1534c47UL, 0x500498183fa2aUL, 0x72f59c423de75UL, 0x0904d07b87779UL }}},
+    }},
+    {{ /* k25519_precomp[12][ 2] */
+      {{{ 0x22d6648f940b9UL, 0x197a5a1873e86UL, 0x207e4c41a54bcUL, 0x5360b3b4bd6d0UL, 0x6240aacebaf72UL }}},
+      {{{ 0x61fd4ddba919cUL, 0x7d8e991b55699UL, 0x61b31473cc76cUL, 0x7039631e631d6UL, 0x43e2143fbc1ddUL }}},
+      {{{ 0x4749c5ba295a0UL, 0x37946fa4b5f06UL, 0x724c5ab5a51f1UL, 0x65633789dd3f3UL, 0x56bdaf238db40UL }}},
+    }},
+    {{ /* k25519_precomp[12][ 3] */
+      {{{ 0x0d36cc19d3bb2UL, 0x6ec4470d72262UL, 0x6853d7018a9aeUL, 0x3aa3e4dc2c8ebUL, 0x03aa31507e1e5UL }}},
+      {{{ 0x2b9e3f53533ebUL, 0x2add727a806c5UL, 0x56955c8ce15a3UL, 0x18c4f070a290eUL, 0x1d24a86d83741UL }}},
+      {{{ 0x47648ffd4ce1fUL, 0x60a9591839e9dUL, 0x424d5f38117abUL, 0x42cc46912c10eUL, 0x43b261dc9aeb4UL }}},
+    }},
+    {{ /* k25519_precomp[12][ 4] */
+      {{{ 0x13d8b6c951364UL, 0x4c0017e8f632aUL, 0x53e559e53f9c4UL, 0x4b20146886eeaUL, 0x02b4d5e242940UL }}},
+      {{{ 0x31e1988bb79bbUL, 0x7b82f46b3bcabUL, 0x0f7a8ce827b41UL, 0x5e15816177130UL, 0x326055cf5b276UL }}},
+      {{{ 0x155cb28d18df2UL, 0x0c30d9ca11694UL, 0x2090e27ab3119UL, 0x208624e7a49b6UL, 0x27a6c809ae5d3UL }}},
+    }},
+    {{ /* k25519_precomp[12][ 5] */
+      {{{ 0x4270ac43d6954UL, 0x2ed4cd95659a5UL, 0x75c0db37528f9UL, 0x2ccbcfd2c9234UL, 0x221503603d8c2UL }}},
+      {{{ 0x6ebcd1f0db188UL, 0x74ceb4b7d1174UL, 0x7d56168df4f5cUL, 0x0bf79176fd18aUL, 0x2cb67174ff60aUL }}},
+      {{{ 0x6cdf9390be1d0UL, 0x08e519c7e2b3dUL, 0x253c3d2a50881UL, 0x21b41448e333dUL, 0x7b1df4b73890fUL }}},
+    }},
+    {{ /* k25519_precomp[12][ 6] */
+      {{{ 0x6221807f8f58cUL, 0x3fa92813a8be5UL, 0x6da98c38d5572UL, 0x01ed95554468fUL, 0x68698245d352eUL }}},
+      {{{ 0x2f2e0b3b2a224UL, 0x0c56aa22c1c92UL, 0x5fdec39f1b278UL, 0x4c90af5c7f106UL, 0x61fcef2658fc5UL }}},
+      {{{ 0x15d852a18187aUL, 0x270dbb59afb76UL, 0x7db120bcf92abUL, 0x0e7a25d714087UL, 0x46cf4c473daf0UL }}},
+    }},
+    {{ /* k25519_precomp[12][ 7] */
+      {{{ 0x46ea7f1498140UL, 0x70725690a8427UL, 0x0a73ae9f079fbUL, 0x2dd924461c62bUL, 0x1065aae50d8ccUL }}},
+      {{{ 0x525ed9ec4e5f9UL, 0x022d20660684cUL, 0x7972b70397b68UL, 0x7a03958d3f965UL, 0x29387bcd14eb5UL }}},
+      {{{ 0x44525df200d57UL, 0x2d7f94ce94385UL, 0x60d00c170ecb7UL, 0x38b0503f3d8f0UL, 0x69a198e64f1ceUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[13][ 0] */
+      {{{ 0x14434dcc5caedUL, 0x2c7909f667c20UL, 0x61a839d1fb576UL, 0x4f23800cabb76UL, 0x25b2697bd267fUL }}},
+      {{{ 0x2b2e0d91a78bcUL, 0x3990a12ccf20cUL, 0x141c2e11f2622UL, 0x0dfcefaa53320UL, 0x7369e6a92493aUL }}},
+      {{{ 0x73ffb13986864UL, 0x3282bb8f713acUL, 0x49ced78f297efUL, 0x6697027661defUL, 0x1420683db54e4UL }}},
+    }},
+    {{ /* k25519_precomp[13][ 1] */
+      {{{ 0x6bb6fc1cc5ad0UL, 0x532c8d591669dUL, 0x1af794da86c33UL, 0x0e0e9d86d24d3UL, 0x31e83b4161d08UL }}},
+      {{{ 0x0bd1e249dd197UL, 0x00bcb1820568fUL, 0x2eab1718830d4UL, 0x396fd816997e6UL, 0x60b63bebf508aUL }}},
+      {{{ 0x0c7129e062b4fUL, 0x1e526415b12fdUL, 0x461a0fd27923dUL, 0x18badf670a5b7UL, 0x55cf1eb62d550UL }}},
+    }},
+    {{ /* k25519_precomp[13][ 2] */
+      {{{ 0x6b5e37df58c52UL, 0x3bcf33986c60eUL, 0x44fb8835ceae7UL, 0x099dec18e71a4UL, 0x1a56fbaa62ba0UL }}},
+      {{{ 0x1101065c23d58UL, 0x5aa1290338b0fUL, 0x3157e9e2e7421UL, 0x0ea712017d489UL, 0x669a656457089UL }}},
+      {{{ 0x66b505c9dc9ecUL, 0x774ef86e35287UL, 0x4d1d944c0955eUL, 0x52e4c39d72b20UL, 0x13c4836799c58UL }}},
+    }},
+    {{ /* k25519_precomp[13][ 3] */
+      {{{ 0x4fb6a5d8bd080UL, 0x58ae34908589bUL, 0x3954d977baf13UL, 0x413ea597441dcUL, 0x50bdc87dc8e5bUL }}},
+      {{{ 0x25d465ab3e1b9UL, 0x0f8fe27ec2847UL, 0x2d6e6dbf04f06UL, 0x3038cfc1b3276UL, 0x66f80c93a637bUL }}},
+      {{{ 0x537836edfe111UL, 0x2be02357b2c0dUL, 0x6dcee58c8d4f8UL, 0x2d732581d6192UL, 0x1dd56444725fdUL }}},
+    }},
+    {{ /* k25519_precomp[13][ 4] */
+      {{{ 0x7e60008bac89aUL, 0x23d5c387c1852UL, 0x79e5df1f533a8UL, 0x2e6f9f1c5f0cfUL, 0x3a3a450f63a30UL }}},
+      {{{ 0x47ff83362127dUL, 0x08e39af82b1f4UL, 0x488322ef27dabUL, 0x1973738a2a1a4UL, 0x0e645912219f7UL }}},
+      {{{ 0x72f31d8394627UL, 0x07bd294a200f1UL, 0x665be00e274c6UL, 0x43de8f1b6368bUL, 0x318c8d9393a9aUL }}},
+    }},
+    {{ /* k25519_precomp[13][ 5] */
+      {{{ 0x69e29ab1dd398UL, 0x30685b3c76bacUL, 0x565cf37f24859UL, 0x57b2ac28efef9UL, 0x509a41c325950UL }}},
+      {{{ 0x45d032afffe19UL, 0x12fe49b6cde4eUL, 0x21663bc327cf1UL, 0x18a5e4c69f1ddUL, 0x224c7c679a1d5UL }}},
+      {{{ 0x06edca6f925e9UL, 0x68c8363e677b8UL, 0x60cfa25e4fbcfUL, 0x1c4c17609404eUL, 0x05bff02328a11UL }}},
+    }},
+    {{ /* k25519_precomp[13][ 6] */
+      {{{ 0x1a0dd0dc512e4UL, 0x10894bf5fcd10UL, 0x52949013f9c37UL, 0x1f50fba4735c7UL, 0x576277cdee01aUL }}},
+      {{{ 0x2137023cae00bUL, 0x15a3599eb26c6UL, 0x0687221512b3cUL, 0x253cb3a0824e9UL, 0x780b8cc3fa2a4UL }}},
+      {{{ 0x38abc234f305fUL, 0x7a280bbc103deUL, 0x398a836695dfeUL, 0x3d0af41528a1aUL, 0x5ff418726271bUL }}},
+    }},
+    {{ /* k25519_precomp[13][ 7] */
+      {{{ 0x347e813b69540UL, 0x76864c21c3cbbUL, 0x1e049dbcd74a8UL, 0x5b4d60f93749cUL, 0x29d4db8ca0a0cUL }}},
+      {{{ 0x6080c1789db9dUL, 0x4be7cef1ea731UL, 0x2f40d769d8080UL, 0x35f7d4c44a603UL, 0x106a03dc25a96UL }}},
+      {{{ 0x50aaf333353d0UL, 0x4b59a613cbb35UL, 0x223dfc0e19a76UL, 0x77d1e2bb2c564UL, 0x4ab38a51052cbUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[14][ 0] */
+      {{{ 0x7d1ef5fddc09cUL, 0x7beeaebb9dad9UL, 0x058d30ba0acfbUL, 0x5cd92eab5ae90UL, 0x3041c6bb04ed2UL }}},
+      {{{ 0x42b256768d593UL, 0x2e88459427b4fUL, 0x02b3876630701UL, 0x34878d405eae5UL, 0x29cdd1adc088aUL }}},
+      {{{ 0x2f2f9d956e148UL, 0x6b3e6ad65c1feUL, 0x5b00972b79e5dUL, 0x53d8d234c5dafUL, 0x104bbd6814049UL }}},
+    }},
+    {{ /* k25519_precomp[14][ 1] */
+      {{{ 0x59a5fd67ff163UL, 0x3a998ead0352bUL, 0x083c95fa4af9aUL, 0x6fadbfc01266fUL, 0x204f2a20fb072UL }}},
+      {{{ 0x0fd3168f1ed67UL, 0x1bb0de7784a3eUL, 0x34bcb78b20477UL, 0x0a4a26e2e2182UL, 0x5be8cc57092a7UL }}},
+      {{{ 0x43b3d30ebb079UL, 0x357aca5c61902UL, 0x5b570c5d62455UL, 0x30fb29e1e18c7UL, 0x2570fb17c2791UL }}},
+    }},
+    {{ /* k25519_precomp[14][ 2] */
+      {{{ 0x6a9550bb8245aUL, 0x511f20a1a2325UL, 0x29324d7239beeUL, 0x3343cc37516c4UL, 0x241c5f91de018UL }}},
+      {{{ 0x2367f2cb61575UL, 0x6c39ac04d87dfUL, 0x6d4958bd7e5bdUL, 0x566f4638a1532UL, 0x3dcb65ea53030UL }}},
+      {{{ 0x0172940de6caaUL, 0x6045b2e67451bUL, 0x56c07463efcb3UL, 0x0728b6bfe6e91UL, 0x08420edd5fcdfUL }}},
+    }},
+    {{ /* k25519_precomp[14][ 3] */
+      {{{ 0x0c34e04f410ceUL, 0x344edc0d0a06bUL, 0x6e45486d84d6dUL, 0x44e2ecb3863f5UL, 0x04d654f321db8UL }}},
+      {{{ 0x720ab8362fa4aUL, 0x29c4347cdd9bfUL, 0x0e798ad5f8463UL, 0x4fef18bcb0bfeUL, 0x0d9a53efbc176UL }}},
+      {{{ 0x5c116ddbdb5d5UL, 0x6d1b4bba5abcfUL, 0x4d28a48a5537aUL, 0x56b8e5b040b99UL, 0x4a7a4f2618991UL }}},
+    }},
+    {{ /* k25519_precomp[14][ 4] */
+      {{{ 0x3b291af372a4bUL, 0x60e3028fe4498UL, 0x2267bca4f6a09UL, 0x719eec242b243UL, 0x4a96314223e0eUL }}},
+      {{{ 0x718025fb15f95UL, 0x68d6b8371fe94UL, 0x3804448f7d97cUL, 0x42466fe784280UL, 0x11b50c4cddd31UL }}},
+      {{{ 0x0274408a4ffd6UL, 0x7d382aedb34ddUL, 0x40acfc9ce385dUL, 0x628bb99a45b1eUL, 0x4f4bce4dce6bcUL }}},
+    }},
+    {{ /* k25519_precomp[14][ 5] */
+      {{{ 0x2616ec49d0b6fUL, 0x1f95d8462e61cUL, 0x1ad3e9b9159c6UL, 0x79ba475a04df9UL, 0x3042cee561595UL }}},
+      {{{ 0x7ce5ae2242584UL, 0x2d25eb153d4e3UL, 0x3a8f3d09ba9c9UL, 0x0f3690d04eb8eUL, 0x73fcdd14b71c0UL }}},
+      {{{ 0x67079449bac41UL, 0x5b79c4621484fUL, 0x61069f2156b8dUL, 0x0eb26573b10afUL, 0x389e740c9a9ceUL }}},
+    }},
+    {{ /* k25519_precomp[14][ 6] */
+      {{{ 0x578f6570eac28UL, 0x644f2339c3937UL, 0x66e47b7956c2cUL, 0x34832fe1f55d0UL, 0x25c425e5d6263UL }}},
+      {{{ 0x4b3ae34dcb9ceUL, 0x47c691a15ac9fUL, 0x318e06e5d400cUL, 0x3c422d9f83eb1UL, 0x61545379465a6UL }}},
+      {{{ 0x606a6f1d7de6eUL, 0x4f1c0c46107e7UL, 0x229b1dcfbe5d8UL, 0x3acc60a7b1327UL, 0x6539a08915484UL }}},
+    }},
+    {{ /* k25519_precomp[14][ 7] */
+      {{{ 0x4dbd414bb4a19UL, 0x7930849f1dbb8UL, 0x329c5a466caf0UL, 0x6c824544feb9bUL, 0x0f65320ef019bUL }}},
+      {{{ 0x21f74c3d2f773UL, 0x024b88d08bd3aUL, 0x6e678cf054151UL, 0x43631272e747cUL, 0x11c5e4aac5cd1UL }}},
+      {{{ 0x6d1b1cafde0c6UL, 0x462c76a303a90UL, 0x3ca4e693cff9bUL, 0x3952cd45786fdUL, 0x4cabc7bdec330UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[15][ 0] */
+      {{{ 0x7788f3f78d289UL, 0x5942809b3f811UL, 0x5973277f8c29cUL, 0x010f93bc5fe67UL, 0x7ee498165acb2UL }}},
+      {{{ 0x69624089c0a2eUL, 0x0075fc8e70473UL, 0x13e84ab1d2313UL, 0x2c10bedf6953bUL, 0x639b93f0321c8UL }}},
+      {{{ 0x508e39111a1c3UL, 0x290120e912f7aUL, 0x1cbf464acae43UL, 0x15373e9576157UL, 0x0edf493c85b60UL }}},
+    }},
+    {{ /* k25519_precomp[15][ 1] */
+      {{{ 0x7c4d284764113UL, 0x7fefebf06acecUL, 0x39afb7a824100UL, 0x1b48e47e7fd65UL, 0x04c00c54d1dfaUL }}},
+      {{{ 0x48158599b5a68UL, 0x1fd75bc41d5d9UL, 0x2d9fc1fa95d3cUL, 0x7da27f20eba11UL, 0x403b92e3019d4UL }}},
+      {{{ 0x22f818b465cf8UL, 0x342901dff09b8UL, 0x31f595dc683cdUL, 0x37a57745fd682UL, 0x355bb12ab2617UL }}},
+    }},
+    {{ /* k25519_precomp[15][ 2] */
+      {{{ 0x1dac75a8c7318UL, 0x3b679d5423460UL, 0x6b8fcb7b6400eUL, 0x6c73783be5f9dUL, 0x7518eaf8e052aUL }}},
+      {{{ 0x664cc7493bbf4UL, 0x33d94761874e3UL, 0x0179e1796f613UL, 0x1890535e2867dUL, 0x0f9b8132182ecUL }}},
+      {{{ 0x059c41b7f6c32UL, 0x79e8706531491UL, 0x6c747643cb582UL, 0x2e20c0ad494e4UL, 0x47c3871bbb175UL }}},
+    }},
+    {{ /* k25519_precomp[15][ 3] */
+      {{{ 0x65d50c85066b0UL, 0x6167453361f7cUL, 0x06ba3818bb312UL, 0x6aff29baa7522UL, 0x08fea02ce8d48UL }}},
+      {{{ 0x4539771ec4f48UL, 0x7b9318badca28UL, 0x70f19afe016c5UL, 0x4ee7bb1608d23UL, 0x00b89b8576469UL }}},
+      {{{ 0x5dd7668deead0UL, 0x4096d0ba47049UL, 0x6275997219114UL, 0x29bda8a67e6aeUL, 0x473829a74f75dUL }}},
+    }},
+    {{ /* k25519_precomp[15][ 4] */
+      {{{ 0x1533aad3902c9UL, 0x1dde06b11e47bUL, 0x784bed1930b77UL, 0x1c80a92b9c867UL, 0x6c668b4d44e4dUL }}},
+      {{{ 0x2da754679c418UL, 0x3164c31be105aUL, 0x11fac2b98ef5fUL, 0x35a1aaf779256UL, 0x2078684c4833cUL }}},
+      {{{ 0x0cf217a78820cUL, 0x65024e7d2e769UL, 0x23bb5efdda82aUL, 0x19fd4b632d3c6UL, 0x7411a6054f8a4UL }}},
+    }},
+    {{ /* k25519_precomp[15][ 5] */
+      {{{ 0x2e53d18b175b4UL, 0x33e7254204af3UL, 0x3bcd7d5a1c4c5UL, 0x4c7c22af65d0fUL, 0x1ec9a872458c3UL }}},
+      {{{ 0x59d32b99dc86dUL, 0x6ac075e22a9acUL, 0x30b9220113371UL, 0x27fd9a638966eUL, 0x7c136574fb813UL }}},
+      {{{ 0x6a4d400a2509bUL, 0x041791056971cUL, 0x655d5866e075cUL, 0x2302bf3e64df8UL, 0x3add88a5c7cd6UL }}},
+    }},
+    {{ /* k25519_precomp[15][ 6] */
+      {{{ 0x298d459393046UL, 0x30bfecb3d90b8UL, 0x3d9b8ea3df8d6UL, 0x3900e96511579UL, 0x61ba1131a406aUL }}},
+      {{{ 0x15770b635dcf2UL, 0x59ecd83f79571UL, 0x2db461c0b7fbdUL, 0x73a42a981345fUL, 0x249929fccc879UL }}},
+      {{{ 0x0a0f116959029UL, 0x5974fd7b1347aUL, 0x1e0cc1c08edadUL, 0x673bdf8ad1f13UL, 0x5620310cbbd8eUL }}},
+    }},
+    {{ /* k25519_precomp[15][ 7] */
+      {{{ 0x6b5f477e285d6UL, 0x4ed91ec326cc8UL, 0x6d6537503a3fdUL, 0x626d3763988d5UL, 0x7ec846f3658ceUL }}},
+      {{{ 0x193434934d643UL, 0x0d4a2445eaa51UL, 0x7d0708ae76fe0UL, 0x39847b6c3c7e1UL, 0x37676a2a4d9d9UL }}},
+      {{{ 0x68f3f1da22ec7UL, 0x6ed8039a2736bUL, 0x2627ee04c3c75UL, 0x6ea90a647e7d1UL, 0x6daaf723399b9UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[16][ 0] */
+      {{{ 0x304bfacad8ea2UL, 0x502917d108b07UL, 0x043176ca6dd0fUL, 0x5d5158f2c1d84UL, 0x2b5449e58eb3bUL }}},
+      {{{ 0x27562eb3dbe47UL, 0x291d7b4170be7UL, 0x5d1ca67dfa8e1UL, 0x2a88061f298a2UL, 0x1304e9e71627dUL }}},
+      {{{ 0x014d26adc9cfeUL, 0x7f1691ba16f13UL, 0x5e71828f06eacUL, 0x349ed07f0fffcUL, 0x4468de2d7c2ddUL }}},
+    }},
+    {{ /* k25519_precomp[16][ 1] */
+      {{{ 0x2d8c6f86307ceUL, 0x6286ba1850973UL, 0x5e9dcb08444d4UL, 0x1a96a543362b2UL, 0x5da6427e63247UL }}},
+      {{{ 0x3355e9419469eUL, 0x1847bb8ea8a37UL, 0x1fe6588cf9b71UL, 0x6b1c9d2db6b22UL, 0x6cce7c6ffb44bUL }}},
+      {{{ 0x4c688deac22caUL, 0x6f775c3ff0352UL, 0x565603ee419bbUL, 0x6544456c61c46UL, 0x58f29abfe79f2UL }}},
+    }},
+    {{ /* k25519_precomp[16][ 2] */
+      {{{ 0x264bf710ecdf6UL, 0x708c58527896bUL, 0x42ceae6c53394UL, 0x4381b21e82b6aUL, 0x6af93724185b4UL }}},
+      {{{ 0x6cfab8de73e68UL, 0x3e6efced4bd21UL, 0x0056609500dbeUL, 0x71b7824ad85dfUL, 0x577629c4a7f41UL }}},
+      {{{ 0x0024509c6a888UL, 0x2696ab12e6644UL, 0x0cca27f4b80d8UL, 0x0c7c1f11b119eUL, 0x701f25bb0caecUL }}},
+    }},
+    {{ /* k25519_precomp[16][ 3] */
+      {{{ 0x0f6d97cbec113UL, 0x4ce97fb7c93a3UL, 0x139835a11281bUL, 0x728907ada9156UL, 0x720a5bc050955UL }}},
+      {{{ 0x0b0f8e4616cedUL, 0x1d3c4b50fb875UL, 0x2f29673dc0198UL, 0x5f4b0f1830ffaUL, 0x2e0c92bfbdc40UL }}},
+      {{{ 0x709439b805a35UL, 0x6ec48557f8187UL, 0x08a4d1ba13a2cUL, 0x076348a0bf9aeUL, 0x0e9b9cbb144efUL }}},
+    }},
+    {{ /* k25519_precomp[16][ 4] */
+      {{{ 0x69bd55db1beeeUL, 0x6e14e47f731bdUL, 0x1a35e47270eacUL, 0x66f225478df8eUL, 0x366d44191cfd3UL }}},
+      {{{ 0x2d48ffb5720adUL, 0x57b7f21a1df77UL, 0x5550effba0645UL, 0x5ec6a4098a931UL, 0x221104eb3f337UL }}},
+      {{{ 0x41743f2bc8c14UL, 0x796b0ad8773c7UL, 0x29fee5cbb689bUL, 0x122665c178734UL, 0x4167a4e6bc593UL }}},
+    }},
+    {{ /* k25519_precomp[16][ 5] */
+      {{{ 0x62665f8ce8feeUL, 0x29d101ac59857UL, 0x4d93bbba59ffcUL, 0x17b7897373f17UL, 0x34b33370cb7edUL }}},
+      {{{ 0x39d2876f62700UL, 0x001cecd1d6c87UL, 0x7f01a11747675UL, 0x2350da5a18190UL, 0x7938bb7e22552UL }}},
+      {{{ 0x591ee8681d6ccUL, 0x39db0b4ea79b8UL, 0x202220f380842UL, 0x2f276ba42e0acUL, 0x1176fc6e2dfe6UL }}},
+    }},
+    {{ /* k25519_precomp[16][ 6] */
+      {{{ 0x0e28949770eb8UL, 0x5559e88147b72UL, 0x35e1e6e63ef30UL, 0x35b109aa7ff6fUL, 0x1f6a3e54f2690UL }}},
+      {{{ 0x76cd05b9c619bUL, 0x69654b0901695UL, 0x7a53710b77f27UL, 0x79a1ea7d28175UL, 0x08fc3a4c677d5UL }}},
+      {{{ 0x4c199d30734eaUL, 0x6c622cb9acc14UL, 0x5660a55030216UL, 0x068f1199f11fbUL, 0x4f2fad0116b90UL }}},
+    }},
+    {{ /* k25519_precomp[16][ 7] */
+      {{{ 0x4d91db73bb638UL, 0x55f82538112c5UL, 0x6d85a279815deUL, 0x740b7b0cd9cf9UL, 0x3451995f2944eUL }}},
+      {{{ 0x6b24194ae4e54UL, 0x2230afded8897UL, 0x23412617d5071UL, 0x3d5d30f35969bUL, 0x445484a4972efUL }}},
+      {{{ 0x2fcd09fea7d7cUL, 0x296126b9ed22aUL, 0x4a171012a05b2UL, 0x1db92c74d5523UL, 0x10b89ca604289UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[17][ 0] */
+      {{{ 0x141be5a45f06eUL, 0x5adb38becaea7UL, 0x3fd46db41f2bbUL, 0x6d488bbb5ce39UL, 0x17d2d1d9ef0d4UL }}},
+      {{{ 0x147499718289cUL, 0x0a48a67e4c7abUL, 0x30fbc544bafe3UL, 0x0c701315fe58aUL, 0x20b878d577b75UL }}},
+      {{{ 0x2af18073f3e6aUL, 0x33aea420d24feUL, 0x298008bf4ff94UL, 0x3539171db961eUL, 0x72214f63cc65cUL }}},
+    }},
+    {{ /* k25519_precomp[17][ 1] */
+      {{{ 0x5b7b9f43b29c9UL, 0x149ea31eea3b3UL, 0x4be7713581609UL, 0x2d87960395e98UL, 0x1f24ac855a154UL }}},
+      {{{ 0x37f405307a693UL, 0x2e5e66cf2b69cUL, 0x5d84266ae9c53UL, 0x5e4eb7de853b9UL, 0x5fdf48c58171cUL }}},
+      {{{ 0x608328e9505aaUL, 0x22182841dc49aUL, 0x3ec96891d2307UL, 0x2f363fff22e03UL, 0x00ba739e2ae39UL }}},
+    }},
+    {{ /* k25519_precomp[17][ 2] */
+      {{{ 0x426f5ea88bb26UL, 0x33092e77f75c8UL, 0x1a53940d819e7UL, 0x1132e4f818613UL, 0x72297de7d518dUL }}},
+      {{{ 0x698de5c8790d6UL, 0x268b8545beb25UL, 0x6d2648b96fedfUL, 0x47988ad1db07cUL, 0x03283a3e67ad7UL }}},
+      {{{ 0x41dc7be0cb939UL, 0x1b16c66100904UL, 0x0a24c20cbc66dUL, 0x4a2e9efe48681UL, 0x05e1296846271UL }}},
+    }},
+    {{ /* k25519_precomp[17][ 3] */
+      {{{ 0x7bbc8242c4550UL, 0x59a06103b35b7UL, 0x7237e4af32033UL, 0x726421ab3537aUL, 0x78cf25d38258cUL }}},
+      {{{ 0x2eeb32d9c495aUL, 0x79e25772f9750UL, 0x6d747833bbf23UL, 0x6cdd816d5d749UL, 0x39c00c9c13698UL }}},
+      {{{ 0x66b8e31489d68UL, 0x573857e10e2b5UL, 0x13be816aa1472UL, 0x41964d3ad4bf8UL, 0x006b52076b3ffUL }}},
+    }},
+    {{ /* k25519_precomp[17][ 4] */
+      {{{ 0x37e16b9ce082dUL, 0x1882f57853eb9UL, 0x7d29eacd01fc5UL, 0x2e76a59b5e715UL, 0x7de2e9561a9f7UL }}},
+      {{{ 0x0cfe19d95781cUL, 0x312cc621c453cUL, 0x145ace6da077cUL, 0x0912bef9ce9b8UL, 0x4d57e3443bc76UL }}},
+      {{{ 0x0d4f4b6a55ecbUL, 0x7ebb0bb733bceUL, 0x7ba6a05200549UL, 0x4f6ede4e22069UL, 0x6b2a90af1a602UL }}},
+    }},
+    {{ /* k25519_precomp[17][ 5] */
+      {{{ 0x3f3245bb2d80aUL, 0x0e5f720f36efdUL, 0x3b9cccf60c06dUL, 0x084e323f37926UL, 0x465812c8276c2UL }}},
+      {{{ 0x3f4fc9ae61e97UL, 0x3bc07ebfa2d24UL, 0x3b744b55cd4a0UL, 0x72553b25721f3UL, 0x5fd8f4e9d12d3UL }}},
+      {{{ 0x3beb22a1062d9UL, 0x6a7063b82c9a8UL, 0x0a5a35dc197edUL, 0x3c80c06a53defUL, 0x05b32c2b1cb16UL }}},
+    }},
+    {{ /* k25519_precomp[17][ 6] */
+      {{{ 0x4a42c7ad58195UL, 0x5c8667e799effUL, 0x02e5e74c850a1UL, 0x3f0db614e869aUL, 0x31771a4856730UL }}},
+      {{{ 0x05eccd24da8fdUL, 0x580bbfdf07918UL, 0x7e73586873c6aUL, 0x74ceddf77f93eUL, 0x3b5556a37b471UL }}},
+      {{{ 0x0c524e14dd482UL, 0x283457496c656UL, 0x0ad6bcfb6cd45UL, 0x375d1e8b02414UL, 0x4fc079d27a733UL }}},
+    }},
+    {{ /* k25519_precomp[17][ 7] */
+      {{{ 0x48b440c86c50dUL, 0x139929cca3b86UL, 0x0f8f2e44cdf2fUL, 0x68432117ba6b2UL, 0x241170c2bae3cUL }}},
+      {{{ 0x138b089bf2f7fUL, 0x4a05bfd34ea39UL, 0x203914c925ef5UL, 0x7497fffe04e3cUL, 0x124567cecaf98UL }}},
+      {{{ 0x1ab860ac473b4UL, 0x5c0227c86a7ffUL, 0x71b12bfc24477UL, 0x006a573a83075UL, 0x3f8612966c870UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[18][ 0] */
+      {{{ 0x0fcfa36048d13UL, 0x66e7133bbb383UL, 0x64b42a8a45676UL, 0x4ea6e4f9a85cfUL, 0x26f57eee878a1UL }}},
+      {{{ 0x20cc9782a0ddeUL, 0x65d4e3070aab3UL, 0x7bc8e31547736UL, 0x09ebfb1432d98UL, 0x504aa77679736UL }}},
+      {{{ 0x32cd55687efb1UL, 0x4448f5e2f6195UL, 0x568919d460345UL, 0x034c2e0ad1a27UL, 0x4041943d9dba3UL }}},
+    }},
+    {{ /* k25519_precomp[18][ 1] */
+      {{{ 0x17743a26caaddUL, 0x48c9156f9c964UL, 0x7ef278d1e9ad0UL, 0x00ce58ea7bd01UL, 0x12d931429800dUL }}},
+      {{{ 0x0eeba43ebcc96UL, 0x384dd5395f878UL, 0x1df331a35d272UL, 0x207ecfd4af70eUL, 0x1420a1d976843UL }}},
+      {{{ 0x67799d337594fUL, 0x01647548f6018UL, 0x57fce5578f145UL, 0x009220c142a71UL, 0x1b4f92314359aUL }}},
+    }},
+    {{ /* k25519_precomp[18][ 2] */
+      {{{ 0x73030a49866b1UL, 0x2442be90b2679UL, 0x77bd3d8947dcfUL, 0x1fb55c1552028UL, 0x5ff191d56f9a2UL }}},
+      {{{ 0x4109d89150951UL, 0x225bd2d2d47cbUL, 0x57cc080e73beaUL, 0x6d71075721fcbUL, 0x239b572a7f132UL }}},
+      {{{ 0x6d433ac2d9068UL, 0x72bf930a47033UL, 0x64facf4a20eadUL, 0x365f7a2b9402aUL, 0x020c526a758f3UL }}},
+    }},
+    {{ /* k25519_precomp[18][ 3] */
+      {{{ 0x1ef59f042cc89UL, 0x3b1c24976dd26UL, 0x31d665cb16272UL, 0x28656e470c557UL, 0x452cfe0a5602cUL }}},
+      {{{ 0x034f89ed8dbbcUL, 0x73b8f948d8ef3UL, 0x786c1d323caabUL, 0x43bd4a9266e51UL, 0x02aacc4615313UL }}},
+      {{{ 0x0f7a0647877dfUL, 0x4e1cc0f93f0d4UL, 0x7ec4726ef1190UL, 0x3bdd58bf512f8UL, 0x4cfb7d7b304b8UL }}},
+    }},
+    {{ /* k25519_precomp[18][ 4] */
+      {{{ 0x699c29789ef12UL, 0x63beae321bc50UL, 0x325c340adbb35UL, 0x562e1a1e42bf6UL, 0x5b1d4cbc434d3UL }}},
+      {{{ 0x43d6cb89b75feUL, 0x3338d5b900e56UL, 0x38d327d531a53UL, 0x1b25c61d51b9fUL, 0x14b4622b39075UL }}},
+      {{{ 0x32615cc0a9f26UL, 0x57711b99cb6dfUL, 0x5a69c14e93c38UL, 0x6e88980a4c599UL, 0x2f98f71258592UL }}},
+    }},
+    {{ /* k25519_precomp[18][ 5] */
+      {{{ 0x2ae444f54a701UL, 0x615397afbc5c2UL, 0x60d7783f3f8fbUL, 0x2aa675fc486baUL, 0x1d8062e9e7614UL }}},
+      {{{ 0x4a74cb50f9e56UL, 0x531d1c2640192UL, 0x0c03d9d6c7fd2UL, 0x57ccd156610c1UL, 0x3a6ae249d806aUL }}},
+      {{{ 0x2da85a9907c5aUL, 0x6b23721ec4cafUL, 0x4d2d3a4683aa2UL, 0x7f9c6870efdefUL, 0x298b8ce8aef25UL }}},
+    }},
+    {{ /* k25519_precomp[18][ 6] */
+      {{{ 0x272ea0a2165deUL, 0x68179ef3ed06fUL, 0x4e2b9c0feac1eUL, 0x3ee290b1b63bbUL, 0x6ba6271803a7dUL }}},
+      {{{ 0x27953eff70cb2UL, 0x54f22ae0ec552UL, 0x29f3da92e2724UL, 0x242ca0c22bd18UL, 0x34b8a8404d5ceUL }}},
+      {{{ 0x6ecb583693335UL, 0x3ec76bfdfb84dUL, 0x2c895cf56a04fUL, 0x6355149d54d52UL, 0x71d62bdd465e1UL }}},
+    }},
+    {{ /* k25519_precomp[18][ 7] */
+      {{{ 0x5b5dab1f75ef5UL, 0x1e2d60cbeb9a5UL, 0x527c2175dfe57UL, 0x59e8a2b8ff51fUL, 0x1c333621262b2UL }}},
+      {{{ 0x3cc28d378df80UL, 0x72141f4968ca6UL, 0x407696bdb6d0dUL, 0x5d271b22ffcfbUL, 0x74d5f317f3172UL }}},
+      {{{ 0x7e55467d9ca81UL, 0x6a5653186f50dUL, 0x6b188ece62df1UL, 0x4c66d36844971UL, 0x4aebcc4547e9dUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[19][ 0] */
+      {{{ 0x08d9e7354b610UL, 0x26b750b6dc168UL, 0x162881e01acc9UL, 0x7966df31d01a5UL, 0x173bd9ddc9a1dUL }}},
+      {{{ 0x0071b276d01c9UL, 0x0b0d8918e025eUL, 0x75beea79ee2ebUL, 0x3c92984094db8UL, 0x5d88fbf95a3dbUL }}},
+      {{{ 0x00f1efe5872dfUL, 0x5da872318256aUL, 0x59ceb81635960UL, 0x18cf37693c764UL, 0x06e1cd13b19eaUL }}},
+    }},
+    {{ /* k25519_precomp[19][ 1] */
+      {{{ 0x3af629e5b0353UL, 0x204f1a088e8e5UL, 0x10efc9ceea82eUL, 0x589863c2fa34bUL, 0x7f3a6a1a8d837UL }}},
+      {{{ 0x0ad516f166f23UL, 0x263f56d57c81aUL, 0x13422384638caUL, 0x1331ff1af0a50UL, 0x3080603526e16UL }}},
+      {{{ 0x644395d3d800bUL, 0x2b9203dbedefcUL, 0x4b18ce656a355UL, 0x03f3466bc182cUL, 0x30d0fded2e513UL }}},
+    }},
+    {{ /* k25519_precomp[19][ 2] */
+      {{{ 0x4971e68b84750UL, 0x52ccc9779f396UL, 0x3e904ae8255c8UL, 0x4ecae46f39339UL, 0x4615084351c58UL }}},
+      {{{ 0x14d1af21233b3UL, 0x1de1989b39c0bUL, 0x52669dc6f6f9eUL, 0x43434b28c3fc7UL, 0x0a9214202c099UL }}},
+      {{{ 0x019c0aeb9a02eUL, 0x1a2c06995d792UL, 0x664cbb1571c44UL, 0x6ff0736fa80b2UL, 0x3bca0d2895ca5UL }}},
+    }},
+    {{ /* k25519_precomp[19][ 3] */
+      {{{ 0x08eb69ecc01bfUL, 0x5b4c8912df38dUL, 0x5ea7f8bc2f20eUL, 0x120e516caafafUL, 0x4ea8b4038df28UL }}},
+      {{{ 0x031bc3c5d62a4UL, 0x7d9fe0f4c081eUL, 0x43ed51467f22cUL, 0x1e6cc0c1ed109UL, 0x5631deddae8f1UL }}},
+      {{{ 0x5460af1cad202UL, 0x0b4919dd0655dUL, 0x7c4697d18c14cUL, 0x231c890bba2a4UL, 0x24ce0930542caUL }}},
+    }},
+    {{ /* k25519_precomp[19][ 4] */
+      {{{ 0x7a155fdf30b85UL, 0x1c6c6e5d487f9UL, 0x24be1134bdc5aUL, 0x1405970326f32UL, 0x549928a7324f4UL }}},
+      {{{ 0x090f5fd06c106UL, 0x6abb1021e43fdUL, 0x232bcfad711a0UL, 0x3a5c13c047f37UL, 0x41d4e3c28a06dUL }}},
+      {{{ 0x632a763ee1a2eUL, 0x6fa4bffbd5e4dUL, 0x5fd35a6ba4792UL, 0x7b55e1de99de8UL, 0x491b66dec0dcfUL }}},
+    }},
+    {{ /* k25519_precomp[19][ 5] */
+      {{{ 0x04a8ed0da64a1UL, 0x5ecfc45096ebeUL, 0x5edee93b488b2UL, 0x5b3c11a51bc8fUL, 0x4cf6b8b0b7018UL }}},
+      {{{ 0x5b13dc7ea32a7UL, 0x18fc2db73131eUL, 0x7e3651f8f57e3UL, 0x25656055fa965UL, 0x08f338d0c85eeUL }}},
+      {{{ 0x3a821991a73bdUL, 0x03be6418f5870UL, 0x1ddc18eac9ef0UL, 0x54ce09e998dc2UL, 0x530d4a82eb078UL }}},
+    }},
+    {{ /* k25519_precomp[19][ 6] */
+      {{{ 0x173456c9abf9eUL, 0x7892015100dadUL, 0x33ee14095fecbUL, 0x6ad95d67a0964UL, 0x0db3e7e00cbfbUL }}},
+      {{{ 0x43630e1f94825UL, 0x4d1956a6b4009UL, 0x213fe2df8b5e0UL, 0x05ce3a41191e6UL, 0x65ea753f10177UL }}},
+      {{{ 0x6fc3ee2096363UL, 0x7ec36b96d67acUL, 0x510ec6a0758b1UL, 0x0ed87df022109UL, 0x02a4ec1921e1aUL }}},
+    }},
+    {{ /* k25519_precomp[19][ 7] */
+      {{{ 0x06162f1cf795fUL, 0x324ddcafe5eb9UL, 0x018d5e0463218UL, 0x7e78b9092428eUL, 0x36d12b5dec067UL }}},
+      {{{ 0x6259a3b24b8a2UL, 0x188b5f4170b9cUL, 0x681c0dee15debUL, 0x4dfe665f37445UL, 0x3d143c5112780UL }}},
+      {{{ 0x5279179154557UL, 0x39f8f0741424dUL, 0x45e6eb357923dUL, 0x42c9b5edb746fUL, 0x2ef517885ba82UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[20][ 0] */
+      {{{ 0x6bffb305b2f51UL, 0x5b112b2d712ddUL, 0x35774974fe4e2UL, 0x04af87a96e3a3UL, 0x57968290bb3a0UL }}},
+      {{{ 0x7974e8c58aedcUL, 0x7757e083488c6UL, 0x601c62ae7bc8bUL, 0x45370c2ecab74UL, 0x2f1b78fab143aUL }}},
+      {{{ 0x2b8430a20e101UL, 0x1a49e1d88fee3UL, 0x38bbb47ce4d96UL, 0x1f0e7ba84d437UL, 0x7dc43e35dc2aaUL }}},
+    }},
+    {{ /* k25519_precomp[20][ 1] */
+      {{{ 0x02a5c273e9718UL, 0x32bc9dfb28b4fUL, 0x48df4f8d5db1aUL, 0x54c87976c028fUL, 0x044fb81d82d50UL }}},
+      {{{ 0x66665887dd9c3UL, 0x629760a6ab0b2UL, 0x481e6c7243e6cUL, 0x097e37046fc77UL, 0x7ef72016758ccUL }}},
+      {{{ 0x718c5a907e3d9UL, 0x3b9c98c6b383bUL, 0x006ed255eccdcUL, 0x6976538229a59UL, 0x7f79823f9c30dUL }}},
+    }},
+    {{ /* k25519_precomp[20][ 2] */
+      {{{ 0x41ff068f587baUL, 0x1c00a191bcd53UL, 0x7b56f9c209e25UL, 0x3781e5fccaabeUL, 0x64a9b0431c06dUL }}},
+      {{{ 0x4d239a3b513e8UL, 0x29723f51b1066UL, 0x642f4cf04d9c3UL, 0x4da095aa09b7aUL, 0x0a4e0373d784dUL }}},
+      {{{ 0x3d6a15b7d2919UL, 0x41aa75046a5d6UL, 0x691751ec2d3daUL, 0x23638ab6721c4UL, 0x071a7d0ace183UL }}},
+    }},
+    {{ /* k25519_precomp[20][ 3] */
+      {{{ 0x4355220e14431UL, 0x0e1362a283981UL, 0x2757cd8359654UL, 0x2e9cd7ab10d90UL, 0x7c69bcf761775UL }}},
+      {{{ 0x72daac887ba0bUL, 0x0b7f4ac5dda60UL, 0x3bdda2c0498a4UL, 0x74e67aa180160UL, 0x2c3bcc7146ea7UL }}},
+      {{{ 0x0d7eb04e8295fUL, 0x4a5ea1e6fa0feUL, 0x45e635c436c60UL, 0x28ef4a8d4d18bUL, 0x6f5a9a7322acaUL }}},
+    }},
+    {{ /* k25519_precomp[20][ 4] */
+      {{{ 0x1d4eba3d944beUL, 0x0100f15f3dce5UL, 0x61a700e367825UL, 0x5922292ab3d23UL, 0x02ab9680ee8d3UL }}},
+      {{{ 0x1000c2f41c6c5UL, 0x0219fdf737174UL, 0x314727f127de7UL, 0x7e5277d23b81eUL, 0x494e21a2e147aUL }}},
+      {{{ 0x48a85dde50d9aUL, 0x1c1f734493df4UL, 0x47bdb64866889UL, 0x59a7d048f8eecUL, 0x6b5d76cbea46bUL }}},
+    }},
+    {{ /* k25519_precomp[20][ 5] */
+      {{{ 0x141171e782522UL, 0x6806d26da7c1fUL, 0x3f31d1bc79ab9UL, 0x09f20459f5168UL, 0x16fb869c03dd3UL }}},
+      {{{ 0x7556cec0cd994UL, 0x5eb9a03b7510aUL, 0x50ad1dd91cb71UL, 0x1aa5780b48a47UL, 0x0ae333f685277UL }}},
+      {{{ 0x6199733b60962UL, 0x69b157c266511UL, 0x64740f893f1caUL, 0x03aa408fbf684UL, 0x3f81e38b8f70dUL }}},
+    }},
+    {{ /* k25519_precomp[20][ 6] */
+      {{{ 0x37f355f17c824UL, 0x07ae85334815bUL, 0x7e3abddd2e48fUL, 0x61eeabe1f45e5UL, 0x0ad3e2d34cdedUL }}},
+      {{{ 0x10fcc7ed9affeUL, 0x4248cb0e96ff2UL, 0x4311c115172e2UL, 0x4c9d41cbf6925UL, 0x50510fc104f50UL }}},
+      {{{ 0x40fc5336e249dUL, 0x3386639fb2de1UL, 0x7bbf871d17b78UL, 0x75f796b7e8004UL, 0x127c158bf0fa1UL }}},
+    }},
+    {{ /* k25519_precomp[20][ 7] */
+      {{{ 0x28fc4ae51b974UL, 0x26e89bfd2dbd4UL, 0x4e122a07665cfUL, 0x7cab1203405c3UL, 0x4ed82479d167dUL }}},
+      {{{ 0x17c422e9879a2UL, 0x28a5946c8fec3UL, 0x53ab32e912b77UL, 0x7b44da09fe0a5UL, 0x354ef87d07ef4UL }}},
+      {{{ 0x3b52260c5d975UL, 0x79d6836171fdcUL, 0x7d994f140d4bbUL, 0x1b6c404561854UL, 0x302d92d205392UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[21][ 0] */
+      {{{ 0x46fb6e4e0f177UL, 0x53497ad5265b7UL, 0x1ebdba01386fcUL, 0x0302f0cb36a3cUL, 0x0edc5f5eb426dUL }}},
+      {{{ 0x3c1a2bca4283dUL, 0x23430c7bb2f02UL, 0x1a3ea1bb58bc2UL, 0x7265763de5c61UL, 0x10e5d3b76f1caUL }}},
+      {{{ 0x3bfd653da8e67UL, 0x584953ec82a8aUL, 0x55e288fa7707bUL, 0x5395fc3931d81UL, 0x45b46c51361cbUL }}},
+    }},
+    {{ /* k25519_precomp[21][ 1] */
+      {{{ 0x54ddd8a7fe3e4UL, 0x2cecc41c619d3UL, 0x43a6562ac4d91UL, 0x4efa5aca7bdd9UL, 0x5c1c0aef32122UL }}},
+      {{{ 0x02abf314f7fa1UL, 0x391d19e8a1528UL, 0x6a2fa13895fc7UL, 0x09d8eddeaa591UL, 0x2177bfa36dcb7UL }}},
+      {{{ 0x01bbcfa79db8fUL, 0x3d84beb3666e1UL, 0x20c921d812204UL, 0x2dd843d3b32ceUL, 0x4ae619387d8abUL }}},
+    }},
+    {{ /* k25519_precomp[21][ 2] */
+      {{{ 0x17e44985bfb83UL, 0x54e32c626cc22UL, 0x096412ff38118UL, 0x6b241d61a246aUL, 0x75685abe5ba43UL }}},
+      {{{ 0x3f6aa5344a32eUL, 0x69683680f11bbUL, 0x04c3581f623aaUL, 0x701af5875cba5UL, 0x1a00d91b17bf3UL }}},
+      {{{ 0x60933eb61f2b2UL, 0x5193fe92a4dd2UL, 0x3d995a550f43eUL, 0x3556fb93a883dUL, 0x135529b623b0eUL }}},
+    }},
+    {{ /* k25519_precomp[21][ 3] */
+      {{{ 0x716bce22e83feUL, 0x33d0130b83eb8UL, 0x0952abad0afacUL, 0x309f64ed31b8aUL, 0x5972ea051590aUL }}},
+      {{{ 0x0dbd7add1d518UL, 0x119f823e2231eUL, 0x451d66e5e7de2UL, 0x500c39970f838UL, 0x79b5b81a65ca3UL }}},
+      {{{ 0x4ac20dc8f7811UL, 0x29589a9f501faUL, 0x4d810d26a6b4aUL, 0x5ede00d96b259UL, 0x4f7e9c95905f3UL }}},
+    }},
+    {{ /* k25519_precomp[21][ 4] */
+      {{{ 0x0443d355299feUL, 0x39b7d7d5aee39UL, 0x692519a2f34ecUL, 0x6e4404924cf78UL, 0x1942eec4a144aUL }}},
+      {{{ 0x74bbc5781302eUL, 0x73135bb81ec4cUL, 0x7ef671b61483cUL, 0x7264614ccd729UL, 0x31993ad92e638UL }}},
+      {{{ 0x45319ae234992UL, 0x2219d47d24fb5UL, 0x4f04488b06cf6UL, 0x53aaa9e724a12UL, 0x2a0a65314ef9cUL }}},
+    }},
+    {{ /* k25519_precomp[21][ 5] */
+      {{{ 0x61acd3c1c793aUL, 0x58b46b78779e6UL, 0x3369aacbe7af2UL, 0x509b0743074d4UL, 0x055dc39b6dea1UL }}},
+      {{{ 0x7937ff7f927c2UL, 0x0c2fa14c6a5b6UL, 0x556bddb6dd07cUL, 0x6f6acc179d108UL, 0x4cf6e218647c2UL }}},
+      {{{ 0x1227cc28d5bb6UL, 0x78ee9bff57623UL, 0x28cb2241f893aUL, 0x25b541e3c6772UL, 0x121a307710aa2UL }}},
+    }},
+    {{ /* k25519_precomp[21][ 6] */
+      {{{ 0x1713ec77483c9UL, 0x6f70572d5facbUL, 0x25ef34e22ff81UL, 0x54d944f141188UL, 0x527bb94a6ced3UL }}},
+      {{{ 0x35d5e9f034a97UL, 0x126069785bc9bUL, 0x5474ec7854ff0UL, 0x296a302a348caUL, 0x333fc76c7a40eUL }}},
+      {{{ 0x5992a995b482eUL, 0x78dc707002ac7UL, 0x5936394d01741UL, 0x4fba4281aef17UL, 0x6b89069b20a7aUL }}},
+    }},
+    {{ /* k25519_precomp[21][ 7] */
+      {{{ 0x2fa8cb5c7db77UL, 0x718e6982aa810UL, 0x39e95f81a1a1bUL, 0x5e794f3646cfbUL, 0x0473d308a7639UL }}},
+      {{{ 0x2a0416270220dUL, 0x75f248b69d025UL, 0x1cbbc16656a27UL, 0x5b9ffd6e26728UL, 0x23bc2103aa73eUL }}},
+      {{{ 0x6792603589e05UL, 0x248db9892595dUL, 0x006a53cad2d08UL, 0x20d0150f7ba73UL, 0x102f73bfde043UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[22][ 0] */
+      {{{ 0x4dae0b5511c9aUL, 0x5257fffe0d456UL, 0x54108d1eb2180UL, 0x096cc0f9baefaUL, 0x3f6bd725da4eaUL }}},
+      {{{ 0x0b9ab7f5745c6UL, 0x5caf0f8d21d63UL, 0x7debea408ea2bUL, 0x09edb93896d16UL, 0x36597d25ea5c0UL }}},
+      {{{ 0x58d7b106058acUL, 0x3cdf8d20bee69UL, 0x00a4cb765015eUL, 0x36832337c7cc9UL, 0x7b7ecc19da60dUL }}},
+    }},
+    {{ /* k25519_precomp[22][ 1] */
+      {{{ 0x64a51a77cfa9bUL, 0x29cf470ca0db5UL, 0x4b60b6e0898d9UL, 0x55d04ddffe6c7UL, 0x03bedc661bf5cUL }}},
+      {{{ 0x2373c695c690dUL, 0x4c0c8520dcf18UL, 0x384af4b7494b9UL, 0x4ab4a8ea22225UL, 0x4235ad7601743UL }}},
+      {{{ 0x0cb0d078975f5UL, 0x292313e530c4bUL, 0x38dbb9124a509UL, 0x350d0655a11f1UL, 0x0e7ce2b0cdf06UL }}},
+    }},
+    {{ /* k25519_precomp[22][ 2] */
+      {{{ 0x6fedfd94b70f9UL, 0x2383f9745bfd4UL, 0x4beae27c4c301UL, 0x75aa4416a3f3fUL, 0x615256138aeceUL }}},
+      {{{ 0x4643ac48c85a3UL, 0x6878c2735b892UL, 0x3a53523f4d877UL, 0x3a504ed8bee9dUL, 0x666e0a5d8fb46UL }}},
+      {{{ 0x3f64e4870cb0dUL, 0x61548b16d6557UL, 0x7a261773596f3UL, 0x7724d5f275d3aUL, 0x7f0bc810d514dUL }}},
+    }},
+    {{ /* k25519_precomp[22][ 3] */
+      {{{ 0x49dad737213a0UL, 0x745dee5d31075UL, 0x7b1a55e7fdbe2UL, 0x5ba988f176ea1UL, 0x1d3a907ddec5aUL }}},
+      {{{ 0x06ba426f4136fUL, 0x3cafc0606b720UL, 0x518f0a2359cdaUL, 0x5fae5e46feca7UL, 0x0d1f8dbcf8eedUL }}},
+      {{{ 0x693313ed081dcUL, 0x5b0a366901742UL, 0x40c872ca4ca7eUL, 0x6f18094009e01UL, 0x00011b44a31bfUL }}},
+    }},
+    {{ /* k25519_precomp[22][ 4] */
+      {{{ 0x61f696a0aa75cUL, 0x38b0a57ad42caUL, 0x1e59ab706fdc9UL, 0x01308d46ebfcdUL, 0x63d988a2d2851UL }}},
+      {{{ 0x7a06c3fc66c0cUL, 0x1c9bac1ba47fbUL, 0x23935c575038eUL, 0x3f0bd71c59c13UL, 0x3ac48d916e835UL }}},
+      {{{ 0x20753afbd232eUL, 0x71fbb1ed06002UL, 0x39cae47a4af3aUL, 0x0337c0b34d9c2UL, 0x33fad52b2368aUL }}},
+    }},
+    {{ /* k25519_precomp[22][ 5] */
+      {{{ 0x4c8d0c422cfe8UL, 0x760b4275971a5UL, 0x3da95bc1cad3dUL, 0x0f151ff5b7376UL, 0x3cc355ccb90a7UL }}},
+      {{{ 0x649c6c5e41e16UL, 0x60667eee6aa80UL, 0x4179d182be190UL, 0x653d9567e6979UL, 0x16c0f429a256dUL }}},
+      {{{ 0x69443903e9131UL, 0x16f4ac6f9dd36UL, 0x2ea4912e29253UL, 0x2b4643e68d25dUL, 0x631eaf426bae7UL }}},
+    }},
+    {{ /* k25519_precomp[22][ 6] */
+      {{{ 0x175b9a3700de8UL, 0x77c5f00aa48fbUL, 0x3917785ca0317UL, 0x05aa9b2c79399UL, 0x431f2c7f665f8UL }}},
+      {{{ 0x10410da66fe9fUL, 0x24d82dcb4d67dUL, 0x3e6fe0e17752dUL, 0x4dade1ecbb08fUL, 0x5599648b1ea91UL }}},
+      {{{ 0x26344858f7b19UL, 0x5f43d4a295ac0UL, 0x242a75c52acd4UL, 0x5934480220d10UL, 0x7b04715f91253UL }}},
+    }},
+    {{ /* k25519_precomp[22][ 7] */
+      {{{ 0x6c280c4e6bac6UL, 0x3ada3b361766eUL, 0x42fe5125c3b4fUL, 0x111d84d4aac22UL, 0x48d0acfa57cdeUL }}},
+      {{{ 0x5bd28acf6ae43UL, 0x16fab8f56907dUL, 0x7acb11218d5f2UL, 0x41fe02023b4dbUL, 0x59b37bf5c2f65UL }}},
+      {{{ 0x726e47dabe671UL, 0x2ec45e746f6c1UL, 0x6580e53c74686UL, 0x5eda104673f74UL, 0x16234191336d3UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[23][ 0] */
+      {{{ 0x19cd61ff38640UL, 0x060c6c4b41ba9UL, 0x75cf70ca7366fUL, 0x118a8f16c011eUL, 0x4a25707a203b9UL }}},
+      {{{ 0x499def6267ff6UL, 0x76e858108773cUL, 0x693cac5ddcb29UL, 0x00311d00a9ff4UL, 0x2cdfdfecd5d05UL }}},
+      {{{ 0x7668a53f6ed6aUL, 0x303ba2e142556UL, 0x3880584c10909UL, 0x4fe20000a261dUL, 0x5721896d248e4UL }}},
+    }},
+    {{ /* k25519_precomp[23][ 1] */
+      {{{ 0x55091a1d0da4eUL, 0x4f6bfc7c1050bUL, 0x64e4ecd2ea9beUL, 0x07eb1f28bbe70UL, 0x03c935afc4b03UL }}},
+      {{{ 0x65517fd181baeUL, 0x3e5772c76816dUL, 0x019189640898aUL, 0x1ed2a84de7499UL, 0x578edd74f63c1UL }}},
+      {{{ 0x276c6492b0c3dUL, 0x09bfc40bf932eUL, 0x588e8f11f330bUL, 0x3d16e694dc26eUL, 0x3ec2ab590288cUL }}},
+    }},
+    {{ /* k25519_precomp[23][ 2] */
+      {{{ 0x13a09ae32d1cbUL, 0x3e81eb85ab4e4UL, 0x07aaca43cae1fUL, 0x62f05d7526374UL, 0x0e1bf66c6adbaUL }}},
+      {{{ 0x0d27be4d87bb9UL, 0x56c27235db434UL, 0x72e6e0ea62d37UL, 0x5674cd06ee839UL, 0x2dd5c25a200fcUL }}},
+      {{{ 0x3d5e9792c887eUL, 0x319724dabbc55UL, 0x2b97c78680800UL, 0x7afdfdd34e6ddUL, 0x730548b35ae88UL }}},
+    }},
+    {{ /* k25519_precomp[23][ 3] */
+      {{{ 0x3094ba1d6e334UL, 0x6e126a7e3300bUL, 0x089c0aefcfbc5UL, 0x2eea11f836583UL, 0x585a2277d8784UL }}},
+      {{{ 0x551a3cba8b8eeUL, 0x3b6422be2d886UL, 0x630e1419689bcUL, 0x4653b07a7a955UL, 0x3043443b411dbUL }}},
+      {{{ 0x25f8233d48962UL, 0x6bd8f04aff431UL, 0x4f907fd9a6312UL, 0x40fd3c737d29bUL, 0x7656278950ef9UL }}},
+    }},
+    {{ /* k25519_precomp[23][ 4] */
+      {{{ 0x073a3ea86cf9dUL, 0x6e0e2abfb9c2eUL, 0x60e2a38ea33eeUL, 0x30b2429f3fe18UL, 0x28bbf484b613fUL }}},
+      {{{ 0x3cf59d51fc8c0UL, 0x7a0a0d6de4718UL, 0x55c3a3e6fb74bUL, 0x353135f884fd5UL, 0x3f4160a8c1b84UL }}},
+      {{{ 0x12f5c6f136c7cUL, 0x0fedba237de4cUL, 0x779bccebfab44UL, 0x3aea93f4d6909UL, 0x1e79cb358188fUL }}},
+    }},
+    {{ /* k25519_precomp[23][ 5] */
+      {{{ 0x153d8f5e08181UL, 0x08533bbdb2efdUL, 0x1149796129431UL, 0x17a6e36168643UL, 0x478ab52d39d1fUL }}},
+      {{{ 0x436c3eef7e3f1UL, 0x7ffd3c21f0026UL, 0x3e77bf20a2da9UL, 0x418bffc8472deUL, 0x65d7951b3a3b3UL }}},
+      {{{ 0x6a4d39252d159UL, 0x790e35900ecd4UL, 0x30725bf977786UL, 0x10a5c1635a053UL, 0x16d87a411a212UL }}},
+    }},
+    {{ /* k25519_precomp[23][ 6] */
+      {{{ 0x4d5e2d54e0583UL, 0x2e5d7b33f5f74UL, 0x3a5de3f887ebfUL, 0x6ef24bd6139b7UL, 0x1f990b577a5a6UL }}},
+      {{{ 0x57e5a42066215UL, 0x1a18b44983677UL, 0x3e652de1e6f8fUL, 0x6532be02ed8ebUL, 0x28f87c8165f38UL }}},
+      {{{ 0x44ead1be8f7d6UL, 0x5759d4f31f466UL, 0x0378149f47943UL, 0x69f3be32b4f29UL, 0x45882fe1534d6UL }}},
+    }},
+    {{ /* k25519_precomp[23][ 7] */
+      {{{ 0x49929943c6fe4UL, 0x4347072545b15UL, 0x3226bced7e7c5UL, 0x03a134ced89dfUL, 0x7dcf843ce405fUL }}},
+      {{{ 0x1345d757983d6UL, 0x222f54234cccdUL, 0x1784a3d8adbb4UL, 0x36ebeee8c2bccUL, 0x688fe5b8f626fUL }}},
+      {{{ 0x0d6484a4732c0UL, 0x7b94ac6532d92UL, 0x5771b8754850fUL, 0x48dd9df1461c8UL, 0x6739687e73271UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[24][ 0] */
+      {{{ 0x5cc9dc80c1ac0UL, 0x683671486d4cdUL, 0x76f5f1a5e8173UL, 0x6d5d3f5f9df4aUL, 0x7da0b8f68d7e7UL }}},
+      {{{ 0x02014385675a6UL, 0x6155fb53d1defUL, 0x37ea32e89927cUL, 0x059a668f5a82eUL, 0x46115aba1d4dcUL }}},
+      {{{ 0x71953c3b5da76UL, 0x6642233d37a81UL, 0x2c9658076b1bdUL, 0x5a581e63010ffUL, 0x5a5f887e83674UL }}},
+    }},
+    {{ /* k25519_precomp[24][ 1] */
+      {{{ 0x628d3a0a643b9UL, 0x01cd8640c93d2UL, 0x0b7b0cad70f2cUL, 0x3864da98144beUL, 0x43e37ae2d5d1cUL }}},
+      {{{ 0x301cf70a13d11UL, 0x2a6a1ba1891ecUL, 0x2f291fb3f3ae0UL, 0x21a7b814bea52UL, 0x3669b656e44d1UL }}},
+      {{{ 0x63f06eda6e133UL, 0x233342758070fUL, 0x098e0459cc075UL, 0x4df5ead6c7c1bUL, 0x6a21e6cd4fd5eUL }}},
+    }},
+    {{ /* k25519_precomp[24][ 2] */
+      {{{ 0x129126699b2e3UL, 0x0ee11a2603de8UL, 0x60ac2f5c74c21UL, 0x59b192a196808UL, 0x45371b07001e8UL }}},
+      {{{ 0x6170a3046e65fUL, 0x5401a46a49e38UL, 0x20add5561c4a8UL, 0x7abb4edde9e46UL, 0x586bf9f1a195fUL }}},
+      {{{ 0x3088d5ef8790bUL, 0x38c2126fcb4dbUL, 0x685bae149e3c3UL, 0x0bcd601a4e930UL, 0x0eafb03790e52UL }}},
+    }},
+    {{ /* k25519_precomp[24][ 3] */
+      {{{ 0x0805e0f75ae1dUL, 0x464cc59860a28UL, 0x248e5b7b00befUL, 0x5d99675ef8f75UL, 0x44ae3344c5435UL }}},
+      {{{ 0x555c13748042fUL, 0x4d041754232c0UL, 0x521b430866907UL, 0x3308e40fb9c39UL, 0x309acc675a02cUL }}},
+      {{{ 0x289b9bba543eeUL, 0x3ab592e28539eUL, 0x64d82abcdd83aUL, 0x3c78ec172e327UL, 0x62d5221b7f946UL }}},
+    }},
+    {{ /* k25519_precomp[24][ 4] */
+      {{{ 0x5d4263af77a3cUL, 0x23fdd2289aeb0UL, 0x7dc64f77eb9ecUL, 0x01bd28338402cUL, 0x14f29a5383922UL }}},
+      {{{ 0x4299c18d0936dUL, 0x5914183418a49UL, 0x52a18c721aed5UL, 0x2b151ba82976dUL, 0x5c0efde4bc754UL }}},
+      {{{ 0x17edc25b2d7f5UL, 0x37336a6081beeUL, 0x7b5318887e5c3UL, 0x49f6d491a5be1UL, 0x5e72365c7bee0UL }}},
+    }},
+    {{ /* k25519_precomp[24][ 5] */
+      {{{ 0x339062f08b33eUL, 0x4bbf3e657cfb2UL, 0x67af7f56e5967UL, 0x4dbd67f9ed68fUL, 0x70b20555cb734UL }}},
+      {{{ 0x3fc074571217fUL, 0x3a0d29b2b6aebUL, 0x06478ccdde59dUL, 0x55e4d051bddfaUL, 0x77f1104c47b4eUL }}},
+      {{{ 0x113c555112c4cUL, 0x7535103f9b7caUL, 0x140ed1d9a2108UL, 0x02522333bc2afUL, 0x0e34398f4a064UL }}},
+    }},
+    {{ /* k25519_precomp[24][ 6] */
+      {{{ 0x30b093e4b1928UL, 0x1ce7e7ec80312UL, 0x4e575bdf78f84UL, 0x61f7a190bed39UL, 0x6f8aded6ca379UL }}},
+      {{{ 0x522d93ecebde8UL, 0x024f045e0f6cfUL, 0x16db63426cfa1UL, 0x1b93a1fd30fd8UL, 0x5e5405368a362UL }}},
+      {{{ 0x0123dfdb7b29aUL, 0x4344356523c68UL, 0x79a527921ee5fUL, 0x74bfccb3e817eUL, 0x780de72ec8d3dUL }}},
+    }},
+    {{ /* k25519_precomp[24][ 7] */
+      {{{ 0x7eaf300f42772UL, 0x5455188354ce3UL, 0x4dcca4a3dcbacUL, 0x3d314d0bfebcbUL, 0x1defc6ad32b58UL }}},
+      {{{ 0x28545089ae7bcUL, 0x1e38fe9a0c15cUL, 0x12046e0e2377bUL, 0x6721c560aa885UL, 0x0eb28bf671928UL }}},
+      {{{ 0x3be1aef5195a7UL, 0x6f22f62bdb5ebUL, 0x39768b8523049UL, 0x43394c8fbfdbdUL, 0x467d201bf8dd2UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[25][ 0] */
+      {{{ 0x6f4bd567ae7a9UL, 0x65ac89317b783UL, 0x07d3b20fd8932UL, 0x000f208326916UL, 0x2ef9c5a5ba384UL }}},
+      {{{ 0x6919a74ef4fadUL, 0x59ed4611452bfUL, 0x691ec04ea09efUL, 0x3cbcb2700e984UL, 0x71c43c4f5ba3cUL }}},
+      {{{ 0x56df6fa9e74cdUL, 0x79c95e4cf56dfUL, 0x7be643bc609e2UL, 0x149c12ad9e878UL, 0x5a758ca390c5fUL }}},
+    }},
+    {{ /* k25519_precomp[25][ 1] */
+      {{{ 0x0918b1d61dc94UL, 0x0d350260cd19cUL, 0x7a2ab4e37b4d9UL, 0x21fea735414d7UL, 0x0a738027f639dUL }}},
+      {{{ 0x72710d9462495UL, 0x25aafaa007456UL, 0x2d21f28eaa31bUL, 0x17671ea005fd0UL, 0x2dbae244b3eb7UL }}},
+      {{{ 0x74a2f57ffe1ccUL, 0x1bc3073087301UL, 0x7ec57f4019c34UL, 0x34e082e1fa524UL, 0x2698ca635126aUL }}},
+    }},
+    {{ /* k25519_precomp[25][ 2] */
+      {{{ 0x5702f5e3dd90eUL, 0x31c9a4a70c5c7UL, 0x136a5aa78fc24UL, 0x1992f3b9f7b01UL, 0x3c004b0c4afa3UL }}},
+      {{{ 0x5318832b0ba78UL, 0x6f24b9ff17cecUL, 0x0a47f30e060c7UL, 0x58384540dc8d0UL, 0x1fb43dcc49caeUL }}},
+      {{{ 0x146ac06f4b82bUL, 0x4b500d89e7355UL, 0x3351e1c728a12UL, 0x10b9f69932fe3UL, 0x6b43fd01cd1fdUL }}},
+    }},
+    {{ /* k25519_precomp[25][ 3] */
+      {{{ 0x742583e760ef3UL, 0x73dc1573216b8UL, 0x4ae48fdd7714aUL, 0x4f85f8a13e103UL, 0x73420b2d6ff0dUL }}},
+      {{{ 0x75d4b4697c544UL, 0x11be1fff7f8f4UL, 0x119e16857f7e1UL, 0x38a14345cf5d5UL, 0x5a68d7105b52fUL }}},
+      {{{ 0x4f6cb9e851e06UL, 0x278c4471895e5UL, 0x7efcdce3d64e4UL, 0x64f6d455c4b4cUL, 0x3db5632fea34bUL }}},
+    }},
+    {{ /* k25519_precomp[25][ 4] */
+      {{{ 0x190b1829825d5UL, 0x0e7d3513225c9UL, 0x1c12be3b7abaeUL, 0x58777781e9ca6UL, 0x59197ea495df2UL }}},
+      {{{ 0x6ee2bf75dd9d8UL, 0x6c72ceb34be8dUL, 0x679c9cc345ec7UL, 0x7898df96898a4UL, 0x04321adf49d75UL }}},
+      {{{ 0x16019e4e55aaeUL, 0x74fc5f25d209cUL, 0x4566a939ded0dUL, 0x66063e716e0b7UL, 0x45eafdc1f4d70UL }}},
+    }},
+    {{ /* k25519_precomp[25][ 5] */
+      {{{ 0x64624cfccb1edUL, 0x257ab8072b6c1UL, 0x0120725676f0aUL, 0x4a018d04e8eeeUL, 0x3f73ceea5d56dUL }}},
+      {{{ 0x401858045d72bUL, 0x459e5e0ca2d30UL, 0x488b719308beaUL, 0x56f4a0d1b32b5UL, 0x5a5eebc80362dUL }}},
+      {{{ 0x7bfd10a4e8dc6UL, 0x7c899366736f4UL, 0x55ebbeaf95c01UL, 0x46db060903f8aUL, 0x2605889126621UL }}},
+    }},
+    {{ /* k25519_precomp[25][ 6] */
+      {{{ 0x18e3cc676e542UL, 0x26079d995a990UL, 0x04a7c217908b2UL, 0x1dc7603e6655aUL, 0x0dedfa10b2444UL }}},
+      {{{ 0x704a68360ff04UL, 0x3cecc3cde8b3eUL, 0x21cd5470f64ffUL, 0x6abc18d953989UL, 0x54ad0c2e4e615UL }}},
+      {{{ 0x367d5b82b522aUL, 0x0d3f4b83d7dc7UL, 0x3067f4cdbc58dUL, 0x20452da697937UL, 0x62ecb2baa77a9UL }}},
+    }},
+    {{ /* k25519_precomp[25][ 7] */
+      {{{ 0x72836afb62874UL, 0x0af3c2094b240UL, 0x0c285297f357aUL, 0x7cc2d5680d6e3UL, 0x61913d5075663UL }}},
+      {{{ 0x5795261152b3dUL, 0x7a1dbbafa3cbdUL, 0x5ad31c52588d5UL, 0x45f3a4164685cUL, 0x2e59f919a966dUL }}},
+      {{{ 0x62d361a3231daUL, 0x65284004e01b8UL, 0x656533be91d60UL, 0x6ae016c00a89fUL, 0x3ddbc2a131c05UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[26][ 0] */
+      {{{ 0x257a22796bb14UL, 0x6f360fb443e75UL, 0x680e47220eaeaUL, 0x2fcf2a5f10c18UL, 0x5ee7fb38d8320UL }}},
+      {{{ 0x40ff9ce5ec54bUL, 0x57185e261b35bUL, 0x3e254540e70a9UL, 0x1b5814003e3f8UL, 0x78968314ac04bUL }}},
+      {{{ 0x5fdcb41446a8eUL, 0x5286926ff2a71UL, 0x0f231e296b3f6UL, 0x684a357c84693UL, 0x61d0633c9bca0UL }}},
+    }},
+    {{ /* k25519_precomp[26][ 1] */
+      {{{ 0x328bcf8fc73dfUL, 0x3b4de06ff95b4UL, 0x30aa427ba11a5UL, 0x5ee31bfda6d9cUL, 0x5b23ac2df8067UL }}},
+      {{{ 0x44935ffdb2566UL, 0x12f016d176c6eUL, 0x4fbb00f16f5aeUL, 0x3fab78d99402aUL, 0x6e965fd847aedUL }}},
+      {{{ 0x2b953ee80527bUL, 0x55f5bcdb1b35aUL, 0x43a0b3fa23c66UL, 0x76e07388b820aUL, 0x79b9bbb9dd95dUL }}},
+    }},
+    {{ /* k25519_precomp[26][ 2] */
+      {{{ 0x17dae8e9f7374UL, 0x719f76102da33UL, 0x5117c2a80ca8bUL, 0x41a66b65d0936UL, 0x1ba811460accbUL }}},
+      {{{ 0x355406a3126c2UL, 0x50d1918727d76UL, 0x6e5ea0b498e0eUL, 0x0a3b6063214f2UL, 0x5065f158c9fd2UL }}},
+      {{{ 0x169fb0c429954UL, 0x59aedd9ecee10UL, 0x39916eb851802UL, 0x57917555cc538UL, 0x3981f39e58a4fUL }}},
+    }},
+    {{ /* k25519_precomp[26][ 3] */
+      {{{ 0x5dfa56de66fdeUL, 0x0058809075908UL, 0x6d3d8cb854a94UL, 0x5b2f4e970b1e3UL, 0x30f4452edcbc1UL }}},
+      {{{ 0x38a7559230a93UL, 0x52c1cde8ba31fUL, 0x2a4f2d4745a3dUL, 0x07e9d42d4a28aUL, 0x38dc083705acdUL }}},
+      {{{ 0x52782c5759740UL, 0x53f3397d990adUL, 0x3a939c7e84d15UL, 0x234c4227e39e0UL, 0x632d9a1a593f2UL }}},
+    }},
+    {{ /* k25519_precomp[26][ 4] */
+      {{{ 0x1fd11ed0c84a7UL, 0x021b3ed2757e1UL, 0x73e1de58fc1c6UL, 0x5d110c84616abUL, 0x3a5a7df28af64UL }}},
+      {{{ 0x36b15b807cba6UL, 0x3f78a9e1afed7UL, 0x0a59c2c608f1fUL, 0x52bdd8ecb81b7UL, 0x0b24f48847ed4UL }}},
+      {{{ 0x2d4be511beac7UL, 0x6bda4d99e5b9bUL, 0x17e6996914e01UL, 0x7b1f0ce7fcf80UL, 0x34fcf74475481UL }}},
+    }},
+    {{ /* k25519_precomp[26][ 5] */
+      {{{ 0x31dab78cfaa98UL, 0x4e3216e5e54b7UL, 0x249823973b689UL, 0x2584984e48885UL, 0x0119a3042fb37UL }}},
+      {{{ 0x7e04c789767caUL, 0x1671b28cfb832UL, 0x7e57ea2e1c537UL, 0x1fbaaef444141UL, 0x3d3bdc164dfa6UL }}},
+      {{{ 0x2d89ce8c2177dUL, 0x6cd12ba182cf4UL, 0x20a8ac19a7697UL, 0x539fab2cc72d9UL, 0x56c088f1ede20UL }}},
+    }},
+    {{ /* k25519_precomp[26][ 6] */
+      {{{ 0x35fac24f38f02UL, 0x7d75c6197ab03UL, 0x33e4bc2a42fa7UL, 0x1c7cd10b48145UL, 0x038b7ea483590UL }}},
+      {{{ 0x53d1110a86e17UL, 0x6416eb65f466dUL, 0x41ca6235fce20UL, 0x5c3fc8a99bb12UL, 0x09674c6b99108UL }}},
+      {{{ 0x6f82199316ff8UL, 0x05d54f1a9f3e9UL, 0x3bcc5d0bd274aUL, 0x5b284b8d2d5adUL, 0x6e5e31025969eUL }}},
+    }},
+    {{ /* k25519_precomp[26][ 7] */
+      {{{ 0x4fb0e63066222UL, 0x130f59747e660UL, 0x041868fecd41aUL, 0x3105e8c923bc6UL, 0x3058ad43d1838UL }}},
+      {{{ 0x462f587e593fbUL, 0x3d94ba7ce362dUL, 0x330f9b52667b7UL, 0x5d45a48e0f00aUL, 0x08f5114789a8dUL }}},
+      {{{ 0x40ffde57663d0UL, 0x71445d4c20647UL, 0x2653e68170f7cUL, 0x64cdee3c55ed6UL, 0x26549fa4efe3dUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[27][ 0] */
+      {{{ 0x68549af3f666eUL, 0x09e2941d4bb68UL, 0x2e8311f5dff3cUL, 0x6429ef91ffbd2UL, 0x3a10dfe132ce3UL }}},
+      {{{ 0x55a461e6bf9d6UL, 0x78eeef4b02e83UL, 0x1d34f648c16cfUL, 0x07fea2aba5132UL, 0x1926e1dc6401eUL }}},
+      {{{ 0x74e8aea17cea0UL, 0x0c743f83fbc0fUL, 0x7cb03c4bf5455UL, 0x68a8ba9917e98UL, 0x1fa1d01d861e5UL }}},
+    }},
+    {{ /* k25519_precomp[27][ 1] */
+      {{{ 0x4ac00d1df94abUL, 0x3ba2101bd271bUL, 0x7578988b9c4afUL, 0x0f2bf89f49f7eUL, 0x73fced18ee9a0UL }}},
+      {{{ 0x055947d599832UL, 0x346fe2aa41990UL, 0x0164c8079195bUL, 0x799ccfb7bba27UL, 0x773563bc6a75cUL }}},
+      {{{ 0x1e90863139cb3UL, 0x4f8b407d9a0d6UL, 0x58e24ca924f69UL, 0x7a246bbe76456UL, 0x1f426b701b864UL }}},
+    }},
+    {{ /* k25519_precomp[27][ 2] */
+      {{{ 0x635c891a12552UL, 0x26aebd38ede2fUL, 0x66dc8faddae05UL, 0x21c7d41a03786UL, 0x0b76bb1b3fa7eUL }}},
+      {{{ 0x1264c41911c01UL, 0x702f44584bdf9UL, 0x43c511fc68edeUL, 0x0482c3aed35f9UL, 0x4e1af5271d31bUL }}},
+      {{{ 0x0c1f97f92939bUL, 0x17a88956dc117UL, 0x6ee005ef99dc7UL, 0x4aa9172b231ccUL, 0x7b6dd61eb772aUL }}},
+    }},
+    {{ /* k25519_precomp[27][ 3] */
+      {{{ 0x0abf9ab01d2c7UL, 0x3880287630ae6UL, 0x32eca045beddbUL, 0x57f43365f32d0UL, 0x53fa9b659bff6UL }}},
+      {{{ 0x5c1e850f33d92UL, 0x1ec119ab9f6f5UL, 0x7f16f6de663e9UL, 0x7a7d6cb16dec6UL, 0x703e9bceaf1d2UL }}},
+      {{{ 0x4c8e994885455UL, 0x4ccb5da9cad82UL, 0x3596bc610e975UL, 0x7a80c0ddb9f5eUL, 0x398d93e5c4c61UL }}},
+    }},
+    {{ /* k25519_precomp[27][ 4] */
+      {{{ 0x77c60d2e7e3f2UL, 0x4061051763870UL, 0x67bc4e0ecd2aaUL, 0x2bb941f1373b9UL, 0x699c9c9002c30UL }}},
+      {{{ 0x3d16733e248f3UL, 0x0e2b7e14be389UL, 0x42c0ddaf6784aUL, 0x589ea1fc67850UL, 0x53b09b5ddf191UL }}},
+      {{{ 0x6a7235946f1ccUL, 0x6b99cbb2fbe60UL, 0x6d3a5d6485c62UL, 0x4839466e923c0UL, 0x51caf30c6fcddUL }}},
+    }},
+    {{ /* k25519_precomp[27][ 5] */
+      {{{ 0x2f99a18ac54c7UL, 0x398a39661ee6fUL, 0x384331e40cde3UL, 0x4cd15c4de19a6UL, 0x12ae29c189f8eUL }}},
+      {{{ 0x3a7427674e00aUL, 0x6142f4f7e74c1UL, 0x4cc93318c3a15UL, 0x6d51bac2b1ee7UL, 0x5504aa292383fUL }}},
+      {{{ 0x6c0cb1f0d01cfUL, 0x187469ef5d533UL, 0x27138883747bfUL, 0x2f52ae53a90e8UL, 0x5fd14fe958ebaUL }}},
+    }},
+    {{ /* k25519_precomp[27][ 6] */
+      {{{ 0x2fe5ebf93cb8eUL, 0x226da8acbe788UL, 0x10883a2fb7ea1UL, 0x094707842cf44UL, 0x7dd73f960725dUL }}},
+      {{{ 0x42ddf2845ab2cUL, 0x6214ffd3276bbUL, 0x00b8d181a5246UL, 0x268a6d579eb20UL, 0x093ff26e58647UL }}},
+      {{{ 0x524fe68059829UL, 0x65b75e47cb621UL, 0x15eb0a5d5cc19UL, 0x05209b3929d5aUL, 0x2f59bcbc86b47UL }}},
+    }},
+    {{ /* k25519_precomp[27][ 7] */
+      {{{ 0x1d560b691c301UL, 0x7f5bafce3ce08UL, 0x4cd561614806cUL, 0x4588b6170b188UL, 0x2aa55e3d01082UL }}},
+      {{{ 0x47d429917135fUL, 0x3eacfa07af070UL, 0x1deab46b46e44UL, 0x7a53f3ba46cdfUL, 0x5458b42e2e51aUL }}},
+      {{{ 0x192e60c07444fUL, 0x5ae8843a21daaUL, 0x6d721910b1538UL, 0x3321a95a6417eUL, 0x13e9004a8a768UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[28][ 0] */
+      {{{ 0x600c9193b877fUL, 0x21c1b8a0d7765UL, 0x379927fb38ea2UL, 0x70d7679dbe01bUL, 0x5f46040898de9UL }}},
+      {{{ 0x58845832fcedbUL, 0x135cd7f0c6e73UL, 0x53ffbdfe8e35bUL, 0x22f195e06e55bUL, 0x73937e8814bceUL }}},
+      {{{ 0x37116297bf48dUL, 0x45a9e0d069720UL, 0x25af71aa744ecUL, 0x41af0cb8aaba3UL, 0x2cf8a4e891d5eUL }}},
+    }},
+    {{ /* k25519_precomp[28][ 1] */
+      {{{ 0x5487e17d06ba2UL, 0x3872a032d6596UL, 0x65e28c09348e0UL, 0x27b6bb2ce40c2UL, 0x7a6f7f2891d6aUL }}},
+      {{{ 0x3fd8707110f67UL, 0x26f8716a92db2UL, 0x1cdaa1b753027UL, 0x504be58b52661UL, 0x2049bd6e58252UL }}},
+      {{{ 0x1fd8d6a9aef49UL, 0x7cb67b7216fa1UL, 0x67aff53c3b982UL, 0x20ea610da9628UL, 0x6011aadfc5459UL }}},
+    }},
+    {{ /* k25519_precomp[28][ 2] */
+      {{{ 0x6d0c802cbf890UL, 0x141bfed554c7bUL, 0x6dbb667ef4263UL, 0x58f3126857edcUL, 0x69ce18b779340UL }}},
+      {{{ 0x7926dcf95f83cUL, 0x42e25120e2becUL, 0x63de96df1fa15UL, 0x4f06b50f3f9ccUL, 0x6fc5cc1b0b62fUL }}},
+      {{{ 0x75528b29879cbUL, 0x79a8fd2125a3dUL, 0x27c8d4b746ab8UL, 0x0f8893f02210cUL, 0x15596b3ae5710UL }}},
+    }},
+    {{ /* k25519_precomp[28][ 3] */
+      {{{ 0x731167e5124caUL, 0x17b38e8bbe13fUL, 0x3d55b942f9056UL, 0x09c1495be913fUL, 0x3aa4e241afb6dUL }}},
+      {{{ 0x739d23f9179a2UL, 0x632fadbb9e8c4UL, 0x7c8522bfe0c48UL, 0x6ed0983ef5aa9UL, 0x0d2237687b5f4UL }}},
+      {{{ 0x138bf2a3305f5UL, 0x1f45d24d86598UL, 0x5274bad2160feUL, 0x1b6041d58d12aUL, 0x32fcaa6e4687aUL }}},
+    }},
+    {{ /* k25519_precomp[28][ 4] */
+      {{{ 0x7a4732787ccdfUL, 0x11e427c7f0640UL, 0x03659385f8c64UL, 0x5f4ead9766bfbUL, 0x746f6336c2600UL }}},
+      {{{ 0x56e8dc57d9af5UL, 0x5b3be17be4f78UL, 0x3bf928cf82f4bUL, 0x52e55600a6f11UL, 0x4627e9cefebd6UL }}},
+      {{{ 0x2f345ab6c971cUL, 0x653286e63e7e9UL, 0x51061b78a23adUL, 0x14999acb54501UL, 0x7b4917007ed66UL }}},
+    }},
+    {{ /* k25519_precomp[28][ 5] */
+      {{{ 0x41b28dd53a2ddUL, 0x37be85f87ea86UL, 0x74be3d2a85e41UL, 0x1be87fac96ca6UL, 0x1d03620fe08cdUL }}},
+      {{{ 0x5fb5cab84b064UL, 0x2513e778285b0UL, 0x457383125e043UL, 0x6bda3b56e223dUL, 0x122ba376f844fUL }}},
+      {{{ 0x232cda2b4e554UL, 0x0422ba30ff840UL, 0x751e7667b43f5UL, 0x6261755da5f3eUL, 0x02c70bf52b68eUL }}},
+    }},
+    {{ /* k25519_precomp[28][ 6] */
+      {{{ 0x532bf458d72e1UL, 0x40f96e796b59cUL, 0x22ef79d6f9da3UL, 0x501ab67beca77UL, 0x6b0697e3feb43UL }}},
+      {{{ 0x7ec4b5d0b2fbbUL, 0x200e910595450UL, 0x742057105715eUL, 0x2f07022530f60UL, 0x26334f0a409efUL }}},
+      {{{ 0x0f04adf62a3c0UL, 0x5e0edb48bb6d9UL, 0x7c34aa4fbc003UL, 0x7d74e4e5cac24UL, 0x1cc37f43441b2UL }}},
+    }},
+    {{ /* k25519_precomp[28][ 7] */
+      {{{ 0x656f1c9ceaeb9UL, 0x7031cacad5aecUL, 0x1308cd0716c57UL, 0x41c1373941942UL, 0x3a346f772f196UL }}},
+      {{{ 0x7565a5cc7324fUL, 0x01ca0d5244a11UL, 0x116b067418713UL, 0x0a57d8c55edaeUL, 0x6c6809c103803UL }}},
+      {{{ 0x55112e2da6ac8UL, 0x6363d0a3dba5aUL, 0x319c98ba6f40cUL, 0x2e84b03a36ec7UL, 0x05911b9f6ef7cUL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[29][ 0] */
+      {{{ 0x1acf3512eeaefUL, 0x2639839692a69UL, 0x669a234830507UL, 0x68b920c0603d4UL, 0x555ef9d1c64b2UL }}},
+      {{{ 0x39983f5df0ebbUL, 0x1ea2589959826UL, 0x6ce638703cdd6UL, 0x6311678898505UL, 0x6b3cecf9aa270UL }}},
+      {{{ 0x770ba3b73bd08UL, 0x11475f7e186d4UL, 0x0251bc9892bbcUL, 0x24eab9bffcc5aUL, 0x675f4de133817UL }}},
+    }},
+    {{ /* k25519_precomp[29][ 1] */
+      {{{ 0x7f6d93bdab31dUL, 0x1f3aca5bfd425UL, 0x2fa521c1c9760UL, 0x62180ce27f9cdUL, 0x60f450b882cd3UL }}},
+      {{{ 0x452036b1782fcUL, 0x02d95b07681c5UL, 0x5901cf99205b2UL, 0x290686e5eecb4UL, 0x13d99df70164cUL }}},
+      {{{ 0x35ec321e5c0caUL, 0x13ae337f44029UL, 0x4008e813f2da7UL, 0x640272f8e0c3aUL, 0x1c06de9e55edaUL }}},
+    }},
+    {{ /* k25519_precomp[29][ 2] */
+      {{{ 0x52b40ff6d69aaUL, 0x31b8809377ffaUL, 0x536625cd14c2cUL, 0x516af252e17d1UL, 0x78096f8e7d32bUL }}},
+      {{{ 0x77ad6a33ec4e2UL, 0x717c5dc11d321UL, 0x4a114559823e4UL, 0x306ce50a1e2b1UL, 0x4cf38a1fec2dbUL }}},
+      {{{ 0x2aa650dfa5ce7UL, 0x54916a8f19415UL, 0x00dc96fe71278UL, 0x55f2784e63eb8UL, 0x373cad3a26091UL }}},
+    }},
+    {{ /* k25519_precomp[29][ 3] */
+      {{{ 0x6a8fb89ddbbadUL, 0x78c35d5d97e37UL, 0x66e3674ef2cb2UL, 0x34347ac53dd8fUL, 0x21547eda5112aUL }}},
+      {{{ 0x4634d82c9f57cUL, 0x4249268a6d652UL, 0x6336d687f2ff7UL, 0x4fe4f4e26d9a0UL, 0x0040f3d945441UL }}},
+      {{{ 0x5e939fd5986d3UL, 0x12a2147019bdfUL, 0x4c466e7d09cb2UL, 0x6fa5b95d203ddUL, 0x63550a334a254UL }}},
+    }},
+    {{ /* k25519_precomp[29][ 4] */
+      {{{ 0x2584572547b49UL, 0x75c58811c1377UL, 0x4d3c637cc171bUL, 0x33d30747d34e3UL, 0x39a92bafaa7d7UL }}},
+      {{{ 0x7d6edb569cf37UL, 0x60194a5dc2ca0UL, 0x5af59745e10a6UL, 0x7a8f53e004875UL, 0x3eea62c7daf78UL }}},
+      {{{ 0x4c713e693274eUL, 0x6ed1b7a6eb3a4UL, 0x62ace697d8e15UL, 0x266b8292ab075UL, 0x68436a0665c9cUL }}},
+    }},
+    {{ /* k25519_precomp[29][ 5] */
+      {{{ 0x6d317e820107cUL, 0x090815d2ca3caUL, 0x03ff1eb1499a1UL, 0x23960f050e319UL, 0x5373669c91611UL }}},
+      {{{ 0x235e8202f3f27UL, 0x44c9f2eb61780UL, 0x630905b1d7003UL, 0x4fcc8d274ead1UL, 0x17b6e7f68ab78UL }}},
+      {{{ 0x014ab9a0e5257UL, 0x09939567f8ba5UL, 0x4b47b2a423c82UL, 0x688d7e57ac42dUL, 0x1cb4b5a678f87UL }}},
+    }},
+    {{ /* k25519_precomp[29][ 6] */
+      {{{ 0x4aa62a2a007e7UL, 0x61e0e38f62d6eUL, 0x02f888fcc4782UL, 0x7562b83f21c00UL, 0x2dc0fd2d82ef6UL }}},
+      {{{ 0x4c06b394afc6cUL, 0x4931b4bf636ccUL, 0x72b60d0322378UL, 0x25127c6818b25UL, 0x330bca78de743UL }}},
+      {{{ 0x6ff841119744eUL, 0x2c560e8e49305UL, 0x7254fefe5a57aUL, 0x67ae2c560a7dfUL, 0x3c31be1b369f1UL }}},
+    }},
+    {{ /* k25519_precomp[29][ 7] */
+      {{{ 0x0bc93f9cb4272UL, 0x3f8f9db73182dUL, 0x2b235eabae1c4UL, 0x2ddbf8729551aUL, 0x41cec1097e7d5UL }}},
+      {{{ 0x4864d08948aeeUL, 0x5d237438df61eUL, 0x2b285601f7067UL, 0x25dbcbae6d753UL, 0x330b61134262dUL }}},
+      {{{ 0x619d7a26d808aUL, 0x3c3b3c2adbef2UL, 0x6877c9eec7f52UL, 0x3beb9ebe1b66dUL, 0x26b44cd91f287UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[30][ 0] */
+      {{{ 0x7f29362730383UL, 0x7fd7951459c36UL, 0x7504c512d49e7UL, 0x087ed7e3bc55fUL, 0x7deb10149c726UL }}},
+      {{{ 0x048478f387475UL, 0x69397d9678a3eUL, 0x67c8156c976f3UL, 0x2eb4d5589226cUL, 0x2c709e6c1c10aUL }}},
+      {{{ 0x2af6a8766ee7aUL, 0x08aaa79a1d96cUL, 0x42f92d59b2fb0UL, 0x1752c40009c07UL, 0x08e68e9ff62ceUL }}},
+    }},
+    {{ /* k25519_precomp[30][ 1] */
+      {{{ 0x509d50ab8f2f9UL, 0x1b8ab247be5e5UL, 0x5d9b2e6b2e486UL, 0x4faa5479a1339UL, 0x4cb13bd738f71UL }}},
+      {{{ 0x5500a4bc130adUL, 0x127a17a938695UL, 0x02a26fa34e36dUL, 0x584d12e1ecc28UL, 0x2f1f3f87eeba3UL }}},
+      {{{ 0x48c75e515b64aUL, 0x75b6952071ef0UL, 0x5d46d42965406UL, 0x7746106989f9fUL, 0x19a1e353c0ae2UL }}},
+    }},
+    {{ /* k25519_precomp[30][ 2] */
+      {{{ 0x172cdd596bdbdUL, 0x0731ddf881684UL, 0x10426d64f8115UL, 0x71a4fd8a9a3daUL, 0x736bd3990266aUL }}},
+      {{{ 0x47560bafa05c3UL, 0x418dcabcc2fa3UL, 0x35991cecf8682UL, 0x24371a94b8c60UL, 0x41546b11c20c3UL }}},
+      {{{ 0x32d509334b3b4UL, 0x16c102cae70aaUL, 0x1720dd51bf445UL, 0x5ae662faf9821UL, 0x412295a2b87faUL }}},
+    }},
+    {{ /* k25519_precomp[30][ 3] */
+      {{{ 0x55261e293eac6UL, 0x06426759b65ccUL, 0x40265ae116a48UL, 0x6c02304bae5bcUL, 0x0760bb8d195adUL }}},
+      {{{ 0x19b88f57ed6e9UL, 0x4cdbf1904a339UL, 0x42b49cd4e4f2cUL, 0x71a2e771909d9UL, 0x14e153ebb52d2UL }}},
+      {{{ 0x61a17cde6818aUL, 0x53dad34108827UL, 0x32b32c55c55b6UL, 0x2f9165f9347a3UL, 0x6b34be9bc33acUL }}},
+    }},
+    {{ /* k25519_precomp[30][ 4] */
+      {{{ 0x469656571f2d3UL, 0x0aa61ce6f423fUL, 0x3f940d71b27a1UL, 0x185f19d73d16aUL, 0x01b9c7b62e6ddUL }}},
+      {{{ 0x72f643a78c0b2UL, 0x3de45c04f9e7bUL, 0x706d68d30fa5cUL, 0x696f63e8e2f24UL, 0x2012c18f0922dUL }}},
+      {{{ 0x355e55ac89d29UL, 0x3e8b414ec7101UL, 0x39db07c520c90UL, 0x6f41e9b77efe1UL, 0x08af5b784e4baUL }}},
+    }},
+    {{ /* k25519_precomp[30][ 5] */
+      {{{ 0x314d289cc2c4bUL, 0x23450e2f1bc4eUL, 0x0cd93392f92f4UL, 0x1370c6a946b7dUL, 0x6423c1d5afd98UL }}},
+      {{{ 0x499dc881f2533UL, 0x34ef26476c506UL, 0x4d107d2741497UL, 0x346c4bd6efdb3UL, 0x32b79d71163a1UL }}},
+      {{{ 0x5f8d9edfcb36aUL, 0x1e6e8dcbf3990UL, 0x7974f348af30aUL, 0x6e6724ef19c7cUL, 0x480a5efbc13e2UL }}},
+    }},
+    {{ /* k25519_precomp[30][ 6] */
+      {{{ 0x14ce442ce221fUL, 0x18980a72516ccUL, 0x072f80db86677UL, 0x703331fda526eUL, 0x24b31d47691c8UL }}},
+      {{{ 0x1e70b01622071UL, 0x1f163b5f8a16aUL, 0x56aaf341ad417UL, 0x7989635d830f7UL, 0x47aa27600cb7bUL }}},
+      {{{ 0x41eedc015f8c3UL, 0x7cf8d27ef854aUL, 0x289e3584693f9UL, 0x04a7857b309a7UL, 0x545b585d14ddaUL }}},
+    }},
+    {{ /* k25519_precomp[30][ 7] */
+      {{{ 0x4e4d0e3b321e1UL, 0x7451fe3d2ac40UL, 0x666f678eea98dUL, 0x038858667feadUL, 0x4d22dc3e64c8dUL }}},
+      {{{ 0x7275ea0d43a0fUL, 0x681137dd7ccf7UL, 0x1e79cbab79a38UL, 0x22a214489a66aUL, 0x0f62f9c332ba5UL }}},
+      {{{ 0x46589d63b5f39UL, 0x7eaf979ec3f96UL, 0x4ebe81572b9a8UL, 0x21b7f5d61694aUL, 0x1c0fa01a36371UL }}},
+    }},
+  },
+  {
+    {{ /* k25519_precomp[31][ 0] */
+      {{{ 0x02b0e8c936a50UL, 0x6b83b58b6cd21UL, 0x37ed8d3e72680UL, 0x0a037db9f2a62UL, 0x4005419b1d2bcUL }}},
+      {{{ 0x604b622943dffUL, 0x1c899f6741a58UL, 0x60219e2f232fbUL, 0x35fae92a7f9cbUL, 0x0fa3614f3b1caUL }}},
+      {{{ 0x3febdb9be82f0UL, 0x5e74895921400UL, 0x553ea38822706UL, 0x5a17c24cfc88cUL, 0x1fba218aef40aUL }}},
+    }},
+    {{ /* k25519_precomp[31][ 1] */
+      {{{ 0x657043e7b0194UL, 0x5c11b55efe9e7UL, 0x7737bc6a074fbUL, 0x0eae41ce355ccUL, 0x6c535d13ff776UL }}},
+      {{{ 0x49448fac8f53eUL, 0x34f74c6e8356aUL, 0x0ad780607dba2UL, 0x7213a7eb63eb6UL, 0x392e3acaa8c86UL }}},
+      {{{ 0x534e93e8a35afUL, 0x08b10fd02c997UL, 0x26ac2acb81e05UL, 0x09d8c98ce3b79UL, 0x25e17fe4d50acUL }}},
+    }},
+    {{ /* k25519_precomp[31][ 2] */
+      {{{ 0x77ff576f121a7UL, 0x4e5f9b0fc722bUL, 0x46f949b0d28c8UL, 0x4cde65d17ef26UL, 0x6bba828f89698UL }}},
+      {{{ 0x09bd71e04f676UL, 0x25ac841f2a145UL, 0x1a47eac823871UL, 0x1a8a8c36c581aUL, 0x255751442a9fbUL }}},
+      {{{ 0x1bc6690fe3901UL, 0x314132f5abc5aUL, 0x611835132d528UL, 0x5f24b8eb48a57UL, 0x559d504f7f6b7UL }}},
+    }},
+    {{ /* k25519_precomp[31][ 3] */
+      {{{ 0x091e7f6d266fdUL, 0x36060ef037389UL, 0x18788ec1d1286UL, 0x287441c478eb0UL, 0x123ea6a3354bdUL }}},
+      {{{ 0x38378b3eb54d5UL, 0x4d4aaa78f94eeUL, 0x4a002e875a74dUL, 0x10b851367b17cUL, 0x01ab12d5807e3UL }}},
+      {{{ 0x5189041e32d96UL, 0x05b062b090231UL, 0x0c91766e7b78fUL, 0x0aa0f55a138ecUL, 0x4a3961e2c918aUL }}},
+    }},
+    {{ /* k25519_precomp[31][ 4] */
+      {{{ 0x7d644f3233f1eUL, 0x1c69f9e02c064UL, 0x36ae5e5266898UL, 0x08fc1dad38b79UL, 0x68aceead9bd41UL }}},
+      {{{ 0x43be0f8e6bba0UL, 0x68fdffc614e3bUL, 0x4e91dab5b3be0UL, 0x3b1d4c9212ff0UL, 0x2cd6bce3fb1dbUL }}},
+      {{{ 0x4c90ef3d7c210UL, 0x496f5a0818716UL, 0x79cf88cc239b8UL, 0x2cb9c306cf8dbUL, 0x595760d5b508fUL }}},
+    }},
+    {{ /* k25519_precomp[31][ 5] */
+      {{{ 0x2cbebfd022790UL, 0x0b8822aec1105UL, 0x4d1cfd226bcccUL, 0x515b2fa4971beUL, 0x2cb2c5df54515UL }}},
+      {{{ 0x1bfe104aa6397UL, 0x11494ff996c25UL, 0x64251623e5800UL, 0x0d49fc5e044beUL, 0x709fa43edcb29UL }}},
+      {{{ 0x25d8c63fd2acaUL, 0x4c5cd29dffd61UL, 0x32ec0eb48af05UL, 0x18f9391f9b77cUL, 0x70f029ecf0c81UL }}},
+    }},
+    {{ /* k25519_precomp[31][ 6] */
+      {{{ 0x2afaa5e10b0b9UL, 0x61de08355254dUL, 0x0eb587de3c28dUL, 0x4f0bb9f7dbbd5UL, 0x44eca5a2a74bdUL }}},
+      {{{ 0x307b32eed3e33UL, 0x6748ab03ce8c2UL, 0x57c0d9ab810bcUL, 0x42c64a224e98cUL, 0x0b7d5d8a6c314UL }}},
+      {{{ 0x448327b95d543UL, 0x0146681e3a4baUL, 0x38714adc34e0cUL, 0x4f26f0e298e30UL, 0x272224512c7deUL }}},
+    }},
+    {{ /* k25519_precomp[31][ 7] */
+      {{{ 0x3bb8a42a975fcUL, 0x6f2d5b46b17efUL, 0x7b6a9223170e5UL, 0x053713fe3b7e6UL, 0x19735fd7f6bc2UL }}},
+      {{{ 0x492af49c5342eUL, 0x2365cdf5a0357UL, 0x32138a7ffbb60UL, 0x2a1f7d14646feUL, 0x11b5df18a44ccUL }}},
+      {{{ 0x390d042c84266UL, 0x1efe32a8fdc75UL, 0x6925ee7ae1238UL, 0x4af9281d0e832UL, 0x0fef911191df8UL }}},
+    }},
+  },
+};
+
@@ -576,6 +576,99 @@ test_sc_muladd( fd_rng_t * rng ) {
   log_bench( "fd_ed25519_sc_muladd", iter, dt );
 }
 
+/* Test vectors from RFC 8032 section 7.1 */
+
+struct test_vector {
+  char const * prv;
+  char const * pub;
+  char const * msg;
+  char const * sig;
+};
+
+typedef struct test_vector test_vector_t;
+
+static test_vector_t const test_vector[] = {
+  { "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+    "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+    "",
+    "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b" },
+  { "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+    "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+    "72",
+    "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00" },
+  { "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+    "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+    "af82",
+    "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a" },
+  { NULL, NULL, NULL, NULL }
+};
+
+static ulong
+test_hex( uchar *      out,
+          char const * hex ) {
+  ulong sz = strlen( hex ) / 2UL;
+  for( ulong i=0UL; i<sz; i++ ) {
+    int hi = hex[2UL*i    ]; hi = hi<='9' ? hi-'0' : hi-'a'+10;
+    int lo = hex[2UL*i+1UL]; lo = lo<='9' ? lo-'0' : lo-'a'+10;
+    out[i] = (uchar)((hi<<4) | lo);
+  }
+  return sz;
+}
+
+static void
+test_vectors( fd_sha512_t * sha ) {
+  for( test_vector_t const * vec=test_vector; vec->prv; vec++ ) {
+    uchar prv[32]; test_hex( prv, vec->prv );
+    uchar pub[32]; test_hex( pub, vec->pub );
+    uchar sig[64]; test_hex( sig, vec->sig );
+    uchar msg[64]; ulong sz = test_hex( msg, vec->msg );
+
+    uchar tmp[64];
+    FD_TEST( fd_ed25519_public_from_private( tmp, prv, sha )==tmp ); FD_TEST( !memcmp( tmp, pub, 32UL ) );
+    FD_TEST( fd_ed25519_sign( tmp, msg, sz, pub, prv, sha )==tmp );   FD_TEST( !memcmp( tmp, sig, 64UL ) );
+    FD_TEST( fd_ed25519_verify( msg, sz, sig, pub, sha )==FD_ED25519_SUCCESS );
+
+    sig[0] ^= (uchar)1; FD_TEST( fd_ed25519_verify( msg, sz, sig, pub, sha )!=FD_ED25519_SUCCESS ); sig[0] ^= (uchar)1;
+    pub[1] ^= (uchar)2; FD_TEST( fd_ed25519_verify( msg, sz, sig, pub, sha )!=FD_ED25519_SUCCESS ); pub[1] ^= (uchar)2;
+    sig[63] = (uchar)0x10; /* s>=L */
+    FD_TEST( fd_ed25519_verify( msg, sz, sig, pub, sha )==FD_ED25519_ERR_SIG );
+  }
+}
+
+static void
+test_ge_double_scalarmult_lanes( fd_rng_t * rng ) {
+  fd_ed25519_ge_p3_t A[ FD_ED25519_GE_LANE_CNT ];
+  fd_ed25519_ge_p2_t r[ FD_ED25519_GE_LANE_CNT ];
+  uchar              a[ FD_ED25519_GE_LANE_CNT ][ 32 ];
+  uchar              b[ FD_ED25519_GE_LANE_CNT ][ 32 ];
+
+  for( ulong rem=1000UL; rem; rem-- ) {
+    for( ulong l=0UL; l<FD_ED25519_GE_LANE_CNT; l++ ) {
+      uchar t[ 64 ];
+      fd_ed25519_sc_reduce( t, fd_rng_b512( rng, t ) ); fd_ed25519_ge_scalarmult_base( A+l, t );
+      fd_ed25519_sc_reduce( t, fd_rng_b512( rng, t ) ); fd_memcpy( a[l], t, 32UL );
+      fd_ed25519_sc_reduce( t, fd_rng_b512( rng, t ) ); fd_memcpy( b[l], t, 32UL );
+      switch( fd_rng_uint_roll( rng, 8U ) ) { /* Edge cases */
+      case 0U: fd_memset( a[l], 0, 32UL ); break;
+      case 1U: fd_memset( b[l], 0, 32UL ); break;
+      case 2U: fd_ed25519_ge_p3_0( A+l );  break;
+      case 3U: fd_memset( a[l], 0, 32UL ); a[l][0] = (uchar)fd_rng_uint_roll( rng, 256U ); break;
+      default: break;
+      }
+    }
+
+    FD_TEST( fd_ed25519_ge_double_scalarmult_vartime_lanes( r, a[0], A, b[0] )==r );
+
+    for( ulong l=0UL; l<FD_ED25519_GE_LANE_CNT; l++ ) {
+      fd_ed25519_ge_p2_t exp[1];
+      fd_ed25519_ge_double_scalarmult_vartime( exp, a[l], A+l, b[l] );
+      uchar exp_s[32]; fd_ed25519_ge_tobytes( exp_s, exp  );
+      uchar r_s  [32]; fd_ed25519_ge_tobytes( r_s,   r+l  );
+      FD_TEST( !memcmp( r_s, exp_s, 32UL ) );
+    }
+  }
+}
+
 static void
 test_public_from_private( fd_rng_t *    rng,
                           fd_sha512_t * sha ) {
@@ -778,6 +871,438 @@ test_verify( fd_rng_t *    rng,
   }
 }
 
+static void
+test_pubkey_cache( fd_rng_t *    rng,
+                   fd_sha512_t * sha ) {
+  static uchar mem[ 16384 ] __attribute__((aligned(FD_ED25519_PUBKEY_CACHE_ALIGN)));
+
+  FD_TEST( fd_ed25519_pubkey_cache_align()==FD_ED25519_PUBKEY_CACHE_ALIGN );
+  FD_TEST( !fd_ed25519_pubkey_cache_footprint( 0UL                 ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_footprint( 1UL+(ulong)UINT_MAX ) );
+  ulong footprint = fd_ed25519_pubkey_cache_footprint( 8UL );
+  FD_TEST( footprint && fd_ulong_is_aligned( footprint, FD_ED25519_PUBKEY_CACHE_ALIGN ) && footprint<=sizeof(mem) );
+
+  FD_TEST( !fd_ed25519_pubkey_cache_new( NULL,    8UL, 0UL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_new( mem+1UL, 8UL, 0UL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_new( mem,     0UL, 0UL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_join( NULL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_join( mem  ) ); /* not formatted yet */
+
+  void * shcache = fd_ed25519_pubkey_cache_new( mem, 8UL, fd_rng_ulong( rng ) ); FD_TEST( shcache==(void *)mem );
+  fd_ed25519_pubkey_cache_t * cache = fd_ed25519_pubkey_cache_join( shcache );   FD_TEST( cache );
+
+  FD_TEST( fd_ed25519_pubkey_cache_key_max ( cache )==8UL );
+  FD_TEST( fd_ed25519_pubkey_cache_key_cnt ( cache )==0UL );
+  FD_TEST( fd_ed25519_pubkey_cache_hit_cnt ( cache )==0UL );
+  FD_TEST( fd_ed25519_pubkey_cache_miss_cnt( cache )==0UL );
+
+  uchar              pub[ 32 ][ 32 ];
+  fd_ed25519_ge_p3_t nA [ 32 ];
+  for( ulong i=0UL; i<32UL; i++ ) {
+    uchar prv[ 32 ];
+    fd_ed25519_public_from_private( pub[i], fd_rng_b256( rng, prv ), sha );
+    FD_TEST( !fd_ed25519_ge_frombytes_vartime( nA+i, pub[i] ) );
+    fd_ed25519_fe_neg( nA[i].X, nA[i].X );
+    fd_ed25519_fe_neg( nA[i].T, nA[i].T );
+  }
+
+  /* Fill the cache */
+
+  for( ulong i=0UL; i<8UL; i++ ) {
+    FD_TEST( !fd_ed25519_pubkey_cache_query( cache, pub[i], NULL ) );
+    fd_ed25519_pubkey_cache_insert( cache, pub[i], nA+i, 0 );
+    fd_ed25519_pubkey_cache_insert( cache, pub[i], nA+i, 0 ); /* no-op */
+    FD_TEST( fd_ed25519_pubkey_cache_key_cnt( cache )==i+1UL );
+  }
+  FD_TEST( fd_ed25519_pubkey_cache_miss_cnt( cache )==8UL );
+
+  for( ulong i=0UL; i<8UL; i++ ) {
+    fd_ed25519_ge_p3_t const * c = fd_ed25519_pubkey_cache_query( cache, pub[i], NULL );
+    FD_TEST( c );
+    uchar b0[ 32 ]; uchar b1[ 32 ];
+    FD_TEST( !memcmp( fd_ed25519_ge_p3_tobytes( b0, c ), fd_ed25519_ge_p3_tobytes( b1, nA+i ), 32UL ) );
+  }
+  FD_TEST( fd_ed25519_pubkey_cache_hit_cnt( cache )==8UL );
+
+  /* Keys that keep getting used survive a stream of new keys (after
+     the CLOCK hand has done a sweep) and the cache never holds more
+     than key_max keys */
+
+  for( ulong i=8UL; i<32UL; i++ ) {
+    for( ulong j=0UL; j<2UL; j++ ) {
+      if( fd_ed25519_pubkey_cache_query( cache, pub[j], NULL ) ) continue;
+      FD_TEST( i<16UL );
+      fd_ed25519_pubkey_cache_insert( cache, pub[j], nA+j, 0 );
+    }
+    FD_TEST( !fd_ed25519_pubkey_cache_query( cache, pub[i], NULL ) );
+    fd_ed25519_pubkey_cache_insert( cache, pub[i], nA+i, 0 );
+    FD_TEST( fd_ed25519_pubkey_cache_key_cnt( cache )==8UL );
+  }
+  FD_TEST( fd_ed25519_pubkey_cache_query( cache, pub[0], NULL ) );
+  FD_TEST( fd_ed25519_pubkey_cache_query( cache, pub[1], NULL ) );
+  FD_TEST( fd_ed25519_pubkey_cache_query( cache, pub[31], NULL ) );
+  ulong cached_cnt = 0UL;
+  for( ulong i=0UL; i<32UL; i++ ) cached_cnt += !!fd_ed25519_pubkey_cache_query( cache, pub[i], NULL );
+  FD_TEST( cached_cnt==8UL );
+
+  FD_TEST( fd_ed25519_pubkey_cache_leave( cache )==shcache );
+  FD_TEST( fd_ed25519_pubkey_cache_delete( shcache )==shcache );
+  FD_TEST( !fd_ed25519_pubkey_cache_join( shcache ) );
+}
+
+#define TEST_VERIFY_BATCH_MAX (100UL)
+
+static void
+test_verify_batch( fd_rng_t *    rng,
+                   fd_sha512_t * sha ) {
+  static uchar _msg[ TEST_VERIFY_BATCH_MAX ][ 1024 ];
+  static uchar _pub[ TEST_VERIFY_BATCH_MAX ][   32 ];
+  static uchar _sig[ TEST_VERIFY_BATCH_MAX ][   64 ];
+  uchar        _prv[ 32 ];
+
+  void const * msg[ TEST_VERIFY_BATCH_MAX ];
+  ulong        sz [ TEST_VERIFY_BATCH_MAX ];
+  void const * sig[ TEST_VERIFY_BATCH_MAX ];
+  void const * pub[ TEST_VERIFY_BATCH_MAX ];
+  int          err[ TEST_VERIFY_BATCH_MAX ];
+
+  /* A cache much smaller than the number of signers such that it
+     churns */
+
+  static uchar cache_mem[ 16384 ] __attribute__((aligned(FD_ED25519_PUBKEY_CACHE_ALIGN)));
+  static uchar hot_mem  [ 65536 ] __attribute__((aligned(FD_ED25519_PUBKEY_CACHE_ALIGN)));
+  FD_TEST( fd_ed25519_pubkey_cache_footprint( 16UL                  )<=sizeof(cache_mem) );
+  FD_TEST( fd_ed25519_pubkey_cache_footprint( TEST_VERIFY_BATCH_MAX )<=sizeof(hot_mem)   );
+  fd_ed25519_pubkey_cache_t * cache = fd_ed25519_pubkey_cache_join( fd_ed25519_pubkey_cache_new( cache_mem, 16UL, fd_rng_ulong( rng ) ) );
+  FD_TEST( cache );
+
+  for( ulong i=0UL; i<TEST_VERIFY_BATCH_MAX; i++ ) {
+    sz [i] = (ulong)fd_rng_uint_roll( rng, 1025U );
+    for( ulong b=0; b<sz[i]; b++ ) _msg[i][b] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( _pub[i], fd_rng_b256( rng, _prv ), sha );
+    fd_ed25519_sign( _sig[i], _msg[i], sz[i], _pub[i], _prv, sha );
+    msg[i] = _msg[i]; sig[i] = _sig[i]; pub[i] = _pub[i];
+  }
+
+  /* All good signatures */
+
+  for( ulong cnt=0UL; cnt<=TEST_VERIFY_BATCH_MAX; cnt++ ) {
+    for( ulong i=0UL; i<cnt; i++ ) err[i] = -12345;
+    FD_TEST( fd_ed25519_verify_batch( msg, sz, sig, pub, err, cnt, sha, NULL )==FD_ED25519_SUCCESS );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( err[i]==FD_ED25519_SUCCESS );
+    for( ulong i=0UL; i<cnt; i++ ) err[i] = -12345;
+    FD_TEST( fd_ed25519_verify_multi( msg, sz, sig, pub, err, cnt, sha, NULL )==FD_ED25519_SUCCESS );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( err[i]==FD_ED25519_SUCCESS );
+  }
+
+  /* Randomly corrupted signatures, messages and public keys (including
+     s>=L and non-canonical R) should get exactly the fd_ed25519_verify
+     result and leave the other signatures in the batch unaffected */
+
+  for( ulong rem=1000UL; rem; rem-- ) {
+    ulong cnt     = 1UL + (ulong)fd_rng_uint_roll( rng, (uint)TEST_VERIFY_BATCH_MAX );
+    ulong bad_cnt = (ulong)fd_rng_uint_roll( rng, 4U );
+    ulong bad_idx[ 3 ]; uchar bad_save[ 3 ][ 64 ];
+    for( ulong k=0UL; k<bad_cnt; k++ ) {
+      ulong i = (ulong)fd_rng_uint_roll( rng, (uint)cnt );
+      bad_idx[k] = i;
+      uint  r = fd_rng_uint_roll( rng, 5U );
+      switch( r ) {
+      case 0U: { /* flip a sig bit */
+        fd_memcpy( bad_save[k], _sig[i], 64UL );
+        ulong idx = (ulong)fd_rng_uint_roll( rng, 512UL );
+        _sig[i][ idx>>3 ] = (uchar)(_sig[i][ idx>>3 ] ^ (1U<<(idx & 7UL)));
+        break;
+      }
+      case 1U: { /* flip a pub bit */
+        fd_memcpy( bad_save[k], _pub[i], 32UL );
+        ulong idx = (ulong)fd_rng_uint_roll( rng, 256UL );
+        _pub[i][ idx>>3 ] = (uchar)(_pub[i][ idx>>3 ] ^ (1U<<(idx & 7UL)));
+        break;
+      }
+      case 2U: { /* flip a msg bit */
+        if( !sz[i] ) { bad_idx[k] = ULONG_MAX; break; }
+        fd_memcpy( bad_save[k], _msg[i], 1UL );
+        ulong idx = (ulong)fd_rng_uint_roll( rng, 8U );
+        _msg[i][0] = (uchar)(_msg[i][0] ^ (1U<<idx));
+        break;
+      }
+      case 3U: { /* s>=L */
+        fd_memcpy( bad_save[k], _sig[i], 64UL );
+        _sig[i][63] = (uchar)(0x10U | fd_rng_uint_roll( rng, 0xF0U ));
+        break;
+      }
+      default: { /* non-canonical R (y>=p) */
+        fd_memcpy( bad_save[k], _sig[i], 64UL );
+        fd_memset( _sig[i], 0xff, 32UL ); _sig[i][31] = (uchar)0x7f; _sig[i][0] = (uchar)(0xee + fd_rng_uint_roll( rng, 0x12U ));
+        break;
+      }
+      }
+      if( bad_idx[k]!=ULONG_MAX ) bad_idx[k] = i | ((ulong)r<<32);
+    }
+
+    int err_multi[ TEST_VERIFY_BATCH_MAX ];
+    int err_cache[ TEST_VERIFY_BATCH_MAX ];
+    int err_mc   [ TEST_VERIFY_BATCH_MAX ];
+    int ret       = fd_ed25519_verify_batch( msg, sz, sig, pub, err,       cnt, sha, NULL  );
+    int ret_multi = fd_ed25519_verify_multi( msg, sz, sig, pub, err_multi, cnt, sha, NULL  );
+    int ret_cache = fd_ed25519_verify_batch( msg, sz, sig, pub, err_cache, cnt, sha, cache );
+    int ret_mc    = fd_ed25519_verify_multi( msg, sz, sig, pub, err_mc,    cnt, sha, cache );
+    int exp_ret = FD_ED25519_SUCCESS;
+    for( ulong i=0UL; i<cnt; i++ ) {
+      int exp = fd_ed25519_verify( msg[i], sz[i], sig[i], pub[i], sha );
+      FD_TEST( err[i]==exp );
+      FD_TEST( err_multi[i]==exp );
+      FD_TEST( err_cache[i]==exp );
+      FD_TEST( err_mc   [i]==exp );
+      if( exp && !exp_ret ) exp_ret = exp;
+    }
+    FD_TEST( ret      ==exp_ret );
+    FD_TEST( ret_multi==exp_ret );
+    FD_TEST( ret_cache==exp_ret );
+    FD_TEST( ret_mc   ==exp_ret );
+
+    for( ulong k=bad_cnt; k; k-- ) { /* undo in reverse order */
+      ulong j = bad_idx[k-1UL];
+      if( j==ULONG_MAX ) continue;
+      ulong i = j & 0xffffffffUL;
+      switch( j>>32 ) {
+      case 1UL: fd_memcpy( _pub[i], bad_save[k-1UL], 32UL ); break;
+      case 2UL: fd_memcpy( _msg[i], bad_save[k-1UL],  1UL ); break;
+      default:  fd_memcpy( _sig[i], bad_save[k-1UL], 64UL ); break;
+      }
+    }
+  }
+
+  FD_TEST( fd_ed25519_verify_batch( msg, sz, sig, pub, err, TEST_VERIFY_BATCH_MAX, sha, NULL )==FD_ED25519_SUCCESS );
+
+  /* Bench batch verification of good signatures vs one at a time */
+
+  for( ulong i=0UL; i<TEST_VERIFY_BATCH_MAX; i++ ) {
+    sz[i] = 128UL;
+    fd_ed25519_public_from_private( _pub[i], fd_rng_b256( rng, _prv ), sha );
+    fd_ed25519_sign( _sig[i], _msg[i], sz[i], _pub[i], _prv, sha );
+  }
+
+  ulong iter = 100UL;
+
+  long dt = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    FD_COMPILER_FORGET( sha );
+    for( ulong i=0UL; i<TEST_VERIFY_BATCH_MAX; i++ ) err[i] = fd_ed25519_verify( msg[i], sz[i], sig[i], pub[i], sha );
+    FD_COMPILER_UNPREDICTABLE( err[0] );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_ed25519_verify(good 128)", iter*TEST_VERIFY_BATCH_MAX, dt );
+
+  dt = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    FD_COMPILER_FORGET( sha );
+    fd_ed25519_verify_multi( msg, sz, sig, pub, err, TEST_VERIFY_BATCH_MAX, sha, NULL );
+    FD_COMPILER_UNPREDICTABLE( err[0] );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_ed25519_verify_multi(good 128)", iter*TEST_VERIFY_BATCH_MAX, dt );
+
+  for( ulong cnt=8UL; cnt<=TEST_VERIFY_BATCH_MAX; cnt*=2UL ) {
+    dt = fd_log_wallclock();
+    for( ulong rem=iter*(TEST_VERIFY_BATCH_MAX/cnt); rem; rem-- ) {
+      FD_COMPILER_FORGET( sha );
+      fd_ed25519_verify_batch( msg, sz, sig, pub, err, cnt, sha, NULL );
+      FD_COMPILER_UNPREDICTABLE( err[0] );
+    }
+    dt = fd_log_wallclock() - dt;
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_batch(%lu)", cnt ), iter*(TEST_VERIFY_BATCH_MAX/cnt)*cnt, dt );
+  }
+
+  /* Same with all the public keys hot in a cache */
+
+  fd_ed25519_pubkey_cache_t * hot = fd_ed25519_pubkey_cache_join( fd_ed25519_pubkey_cache_new( hot_mem, TEST_VERIFY_BATCH_MAX, 1UL ) );
+  FD_TEST( hot );
+  FD_TEST( fd_ed25519_verify_batch( msg, sz, sig, pub, err, TEST_VERIFY_BATCH_MAX, sha, hot )==FD_ED25519_SUCCESS );
+  FD_TEST( fd_ed25519_pubkey_cache_key_cnt( hot )==TEST_VERIFY_BATCH_MAX );
+  ulong hit_cnt  = fd_ed25519_pubkey_cache_hit_cnt ( hot );
+  ulong miss_cnt = fd_ed25519_pubkey_cache_miss_cnt( hot );
+
+  dt = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    FD_COMPILER_FORGET( sha );
+    fd_ed25519_verify_multi( msg, sz, sig, pub, err, TEST_VERIFY_BATCH_MAX, sha, hot );
+    FD_COMPILER_UNPREDICTABLE( err[0] );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_ed25519_verify_multi(good 128,cached)", iter*TEST_VERIFY_BATCH_MAX, dt );
+
+  dt = fd_log_wallclock();
+  for( ulong rem=iter*(TEST_VERIFY_BATCH_MAX/32UL); rem; rem-- ) {
+    FD_COMPILER_FORGET( sha );
+    fd_ed25519_verify_batch( msg, sz, sig, pub, err, 32UL, sha, hot );
+    FD_COMPILER_UNPREDICTABLE( err[0] );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_ed25519_verify_batch(32,cached)", iter*(TEST_VERIFY_BATCH_MAX/32UL)*32UL, dt );
+
+  FD_TEST( fd_ed25519_pubkey_cache_hit_cnt ( hot )==hit_cnt + iter*TEST_VERIFY_BATCH_MAX + iter*(TEST_VERIFY_BATCH_MAX/32UL)*32UL );
+  FD_TEST( fd_ed25519_pubkey_cache_miss_cnt( hot )==miss_cnt );
+  fd_ed25519_pubkey_cache_delete( fd_ed25519_pubkey_cache_leave( hot ) );
+  fd_ed25519_pubkey_cache_delete( fd_ed25519_pubkey_cache_leave( cache ) );
+}
+
+/* test_verify_batch_torsion checks that signatures whose R and/or A
+   have small order components get exactly the fd_ed25519_verify result
+   from the batch and multi paths.  Signatures are built by hand from
+   R = [r]B + [tr]T and A = [a]B + [ta]T, with T a point of order 8,
+   such that fd_ed25519_verify accepts them iff tr==-h*ta mod 8. */
+
+static void
+test_verify_torsion_sig( uchar *                    _sig,   /* 64 */
+                         uchar *                    _pub,   /* 32 */
+                         uchar const *              msg,
+                         ulong                      sz,
+                         fd_ed25519_ge_p3_t const * BT,     /* 2: B, T */
+                         uchar const *              a,
+                         ulong                      ta,
+                         int                        r_zero,
+                         long                       tr,     /* <0 means pick tr such that the signature verifies */
+                         fd_rng_t *                 rng,
+                         fd_sha512_t *              sha ) {
+  uchar              k[ 2 ][ 32 ];
+  fd_ed25519_ge_p2_t Q[1];
+
+  fd_memcpy( k[0], a, 32UL ); fd_memset( k[1], 0, 32UL ); k[1][0] = (uchar)ta;
+  fd_ed25519_ge_tobytes( _pub, fd_ed25519_ge_multi_scalarmult_vartime( Q, 2UL, k[0], BT ) );
+
+  for(;;) {
+    uchar r[ 64 ];
+    fd_ed25519_sc_reduce( r, fd_rng_b512( rng, r ) );
+    if( r_zero ) fd_memset( r, 0, 32UL );
+    ulong this_tr = tr<0L ? (ulong)fd_rng_uint_roll( rng, 8U ) : (ulong)tr;
+
+    fd_memcpy( k[0], r, 32UL ); fd_memset( k[1], 0, 32UL ); k[1][0] = (uchar)this_tr;
+    fd_ed25519_ge_tobytes( _sig, fd_ed25519_ge_multi_scalarmult_vartime( Q, 2UL, k[0], BT ) );
+
+    uchar h[ 64 ];
+    fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                    _sig, 32UL ), _pub, 32UL ), msg, sz ), h );
+    fd_ed25519_sc_reduce( h, h );
+    fd_ed25519_sc_muladd( _sig+32, h, a, r );
+
+    if( tr>=0L || !((this_tr + (ulong)h[0]*ta) & 7UL) ) break;
+  }
+}
+
+static void
+test_verify_batch_torsion( fd_rng_t *    rng,
+                           fd_sha512_t * sha ) {
+
+  /* L, little endian */
+
+  static uchar const L_bytes[ 32 ] = {
+    (uchar)0xED, (uchar)0xD3, (uchar)0xF5, (uchar)0x5C, (uchar)0x1A, (uchar)0x63, (uchar)0x12, (uchar)0x58,
+    (uchar)0xD6, (uchar)0x9C, (uchar)0xF7, (uchar)0xA2, (uchar)0xDE, (uchar)0xF9, (uchar)0xDE, (uchar)0x14,
+    (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00,
+    (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x00, (uchar)0x10
+  };
+  static uchar const zero[ 32 ];
+  static uchar const one [ 32 ] = { (uchar)1 };
+
+  /* Find a point T of order 8 as [L]P for random points P */
+
+  fd_ed25519_ge_p3_t BT[ 2 ];
+  fd_ed25519_ge_scalarmult_base( BT, one );
+  for(;;) {
+    uchar              t[ 32 ];
+    fd_ed25519_ge_p3_t P[1];
+    if( fd_ed25519_ge_frombytes_vartime( P, fd_rng_b256( rng, t ) ) ) continue;
+    fd_ed25519_ge_p2_t Q[1];
+    fd_ed25519_ge_tobytes( t, fd_ed25519_ge_double_scalarmult_vartime( Q, L_bytes, P, zero ) );
+    FD_TEST( !fd_ed25519_ge_frombytes_vartime( BT+1, t ) );
+    uchar four[ 32 ] = { (uchar)4 };
+    fd_ed25519_ge_tobytes( t, fd_ed25519_ge_double_scalarmult_vartime( Q, four, BT+1, zero ) );
+    if( memcmp( t, one, 32UL ) ) break; /* [4]T is not the identity */
+  }
+
+  static uchar cache_mem[ 16384 ] __attribute__((aligned(FD_ED25519_PUBKEY_CACHE_ALIGN)));
+  FD_TEST( fd_ed25519_pubkey_cache_footprint( 16UL )<=sizeof(cache_mem) );
+  fd_ed25519_pubkey_cache_t * cache = fd_ed25519_pubkey_cache_join( fd_ed25519_pubkey_cache_new( cache_mem, 16UL, fd_rng_ulong( rng ) ) );
+  FD_TEST( cache );
+
+  static uchar _msg[ TEST_VERIFY_BATCH_MAX ][ 64 ];
+  static uchar _pub[ TEST_VERIFY_BATCH_MAX ][ 32 ];
+  static uchar _sig[ TEST_VERIFY_BATCH_MAX ][ 64 ];
+
+  void const * msg[ TEST_VERIFY_BATCH_MAX ];
+  ulong        sz [ TEST_VERIFY_BATCH_MAX ];
+  void const * sig[ TEST_VERIFY_BATCH_MAX ];
+  void const * pub[ TEST_VERIFY_BATCH_MAX ];
+  int          err[ 4 ][ TEST_VERIFY_BATCH_MAX ];
+
+  /* A few hot signers (such that the cache sees the same tweaked public
+     keys repeatedly) */
+
+  uchar hot_a [ 4 ][ 32 ];
+  ulong hot_ta[ 4 ];
+  for( ulong k=0UL; k<4UL; k++ ) {
+    uchar t[ 64 ];
+    fd_ed25519_sc_reduce( t, fd_rng_b512( rng, t ) ); fd_memcpy( hot_a[k], t, 32UL );
+    hot_ta[k] = (ulong)fd_rng_uint_roll( rng, 8U );
+  }
+
+  for( ulong iter=0UL; iter<200UL; iter++ ) {
+    ulong cnt = 1UL + (ulong)fd_rng_uint_roll( rng, 40U );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      sz[i] = (ulong)fd_rng_uint_roll( rng, 65U );
+      for( ulong b=0UL; b<sz[i]; b++ ) _msg[i][b] = fd_rng_uchar( rng );
+      msg[i] = _msg[i]; sig[i] = _sig[i]; pub[i] = _pub[i];
+
+      uchar a[ 64 ];
+      fd_ed25519_sc_reduce( a, fd_rng_b512( rng, a ) );
+      ulong ta     = 0UL;
+      int   r_zero = 0;
+      long  tr     = 0L;
+      switch( fd_rng_uint_roll( rng, 8U ) ) {
+      case 0U: break;                                                                 /* honest */
+      case 1U: tr = 4L;                                           break;             /* R off by the point of order 2 */
+      case 2U: tr = 1L + (long)fd_rng_uint_roll( rng, 7U );       break;             /* R with a torsion component */
+      case 3U: ta = 1UL + fd_rng_uint_roll( rng, 7U ); tr = -1L;  break;             /* A with a torsion component, valid */
+      case 4U: ta = 1UL + fd_rng_uint_roll( rng, 7U ); tr = (long)fd_rng_uint_roll( rng, 8U ); break; /* same, likely invalid */
+      case 5U: fd_memset( a, 0, 32UL ); ta = fd_rng_uint_roll( rng, 8U ); tr = -1L; break; /* small order A (incl identity) */
+      case 6U: r_zero = 1; tr = (long)fd_rng_uint_roll( rng, 8U ); break;           /* small order R (incl identity) */
+      default: { ulong k = fd_rng_uint_roll( rng, 4U ); fd_memcpy( a, hot_a[k], 32UL ); ta = hot_ta[k]; tr = -1L; break; }
+      }
+      test_verify_torsion_sig( _sig[i], _pub[i], _msg[i], sz[i], BT, a, ta, r_zero, tr, rng, sha );
+    }
+
+    /* Make sure the batch sometimes has a pair of signatures whose R is
+       off by the point of order 2 (these cancel out in an unguarded
+       batch equation) */
+
+    if( (cnt>=2UL) & !(iter & 3UL) ) {
+      for( ulong i=0UL; i<2UL; i++ ) {
+        uchar a[ 64 ];
+        fd_ed25519_sc_reduce( a, fd_rng_b512( rng, a ) );
+        test_verify_torsion_sig( _sig[i], _pub[i], _msg[i], sz[i], BT, a, 0UL, 0, 4L, rng, sha );
+      }
+    }
+
+    int ret[ 4 ];
+    ret[0] = fd_ed25519_verify_batch( msg, sz, sig, pub, err[0], cnt, sha, NULL  );
+    ret[1] = fd_ed25519_verify_batch( msg, sz, sig, pub, err[1], cnt, sha, cache );
+    ret[2] = fd_ed25519_verify_batch( msg, sz, sig, pub, err[2], cnt, sha, cache ); /* public keys now likely cached */
+    ret[3] = fd_ed25519_verify_multi( msg, sz, sig, pub, err[3], cnt, sha, cache );
+    int exp_ret = FD_ED25519_SUCCESS;
+    for( ulong i=0UL; i<cnt; i++ ) {
+      int exp = fd_ed25519_verify( msg[i], sz[i], sig[i], pub[i], sha );
+      for( ulong k=0UL; k<4UL; k++ ) FD_TEST( err[k][i]==exp );
+      if( exp && !exp_ret ) exp_ret = exp;
+    }
+    for( ulong k=0UL; k<4UL; k++ ) FD_TEST( ret[k]==exp_ret );
+  }
+
+  fd_ed25519_pubkey_cache_delete( fd_ed25519_pubkey_cache_leave( cache ) );
+}
+
 /**********************************************************************/
 
 int
@@ -807,9 +1332,15 @@ main( int     argc,
   test_sc_reduce    ( rng );
   test_sc_muladd    ( rng );
 
+  test_ge_double_scalarmult_lanes( rng );
+
+  test_vectors            ( sha );
   test_public_from_private( rng, sha );
   test_sign               ( rng, sha );
   test_verify             ( rng, sha );
+  test_pubkey_cache       ( rng, sha );
+  test_verify_batch       ( rng, sha );
+  test_verify_batch_torsion( rng, sha );
 
   fd_sha512_delete( fd_sha512_leave( sha ) );
   fd_rng_delete( fd_rng_leave( rng ) );
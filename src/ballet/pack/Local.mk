@@ -1,2 +1,9 @@
+$(call add-hdrs,fd_pack.h fd_acct_lock.h)
+$(call add-objs,fd_pack fd_acct_lock fd_compute_budget_program,fd_ballet)
 $(call make-unit-test,test_compute_budget_program,test_compute_budget_program,fd_ballet fd_util)
+$(call make-unit-test,test_pack,test_pack,fd_ballet fd_util)
+$(call make-unit-test,test_acct_lock,test_acct_lock,fd_ballet fd_util)
+$(call make-unit-test,bench_acct_lock,bench_acct_lock,fd_ballet fd_util)
 $(call run-unit-test,test_compute_budget_program,)
+$(call run-unit-test,test_pack,)
+$(call run-unit-test,test_acct_lock,)
@@ -0,0 +1,167 @@
+#include "../fd_ballet.h"
+
+#if FD_HAS_HOSTED
+
+#include <stdlib.h>
+
+/* bench_acct_lock benchmarks fd_acct_lock under a synthetic steady
+   state load: a FIFO of --inflight transactions hold locks (with the
+   default parameters this is well over 100k live locked accounts), the
+   oldest in-flight transaction is retired and then candidate
+   transactions are tried in order until one acquires its locks and
+   joins the FIFO.  Transactions use --txn-acct accounts (the first
+   --txn-acct/4 are writable signers, the next --txn-acct/4 are writable
+   non-signers and the rest are readonly) drawn uniformly from
+   --universe accounts, except that each account is replaced with
+   probability --hot-prob by one of --hot-cnt hot accounts (e.g. popular
+   programs, AMM pools, token mints), which is what creates
+   conflicts. */
+
+#define POOL_MAX     (1UL<<16)
+#define TXN_ACCT_MAX (32UL)
+
+#define TXN_FOOTPRINT (((sizeof(fd_txn_t)+alignof(fd_txn_t)-1UL)/alignof(fd_txn_t))*alignof(fd_txn_t))
+
+static uchar pool_txn    [ POOL_MAX ][ TXN_FOOTPRINT ] __attribute__((aligned(alignof(fd_txn_t))));
+static uchar pool_payload[ POOL_MAX*TXN_ACCT_MAX*FD_TXN_ACCT_ADDR_SZ ]; /* Packed with a txn_acct*FD_TXN_ACCT_ADDR_SZ stride */
+static ulong fifo        [ POOL_MAX ];
+
+/* make_addr writes the address of the account with index idx to
+   out. */
+
+static void
+make_addr( uchar * out,
+           ulong   idx ) {
+  ulong h[4];
+  h[0] = fd_ulong_hash( idx ^ 0x9e3779b97f4a7c15UL );
+  h[1] = fd_ulong_hash( h[0] );
+  h[2] = fd_ulong_hash( h[1] );
+  h[3] = fd_ulong_hash( h[2] ) | 1UL; /* Never the system program */
+  memcpy( out, h, FD_TXN_ACCT_ADDR_SZ );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong acct_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--acct-max", NULL, 262144UL  ); /* (opt) table capacity */
+  ulong inflight = fd_env_strip_cmdline_ulong( &argc, &argv, "--inflight", NULL, 16384UL   ); /* (opt) txns holding locks */
+  ulong txn_acct = fd_env_strip_cmdline_ulong( &argc, &argv, "--txn-acct", NULL, 12UL      ); /* (opt) accounts per txn */
+  ulong universe = fd_env_strip_cmdline_ulong( &argc, &argv, "--universe", NULL, 1UL<<24   ); /* (opt) distinct accounts */
+  ulong hot_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--hot-cnt",  NULL, 256UL     ); /* (opt) hot accounts */
+  float hot_prob = fd_env_strip_cmdline_float( &argc, &argv, "--hot-prob", NULL, 0.002f    ); /* (opt) per account */
+  ulong iter_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",     NULL, 4000000UL ); /* (opt) txns retired */
+  uint  seed     = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",     NULL, 0U        ); /* (opt) rng seed */
+
+  if( FD_UNLIKELY( (!inflight) | (inflight>POOL_MAX/2UL)         ) ) FD_LOG_ERR(( "--inflight should be in [1,%lu]", POOL_MAX/2UL ));
+  if( FD_UNLIKELY( (txn_acct<4UL) | (txn_acct>TXN_ACCT_MAX)      ) ) FD_LOG_ERR(( "--txn-acct should be in [4,%lu]", TXN_ACCT_MAX ));
+  if( FD_UNLIKELY( (!hot_cnt) | (hot_cnt>universe)               ) ) FD_LOG_ERR(( "--hot-cnt should be in [1,universe]" ));
+  if( FD_UNLIKELY( !((0.f<=hot_prob) & (hot_prob<=1.f))          ) ) FD_LOG_ERR(( "--hot-prob should be in [0,1]" ));
+
+  FD_LOG_NOTICE(( "Configuring (--acct-max %lu --inflight %lu --txn-acct %lu --universe %lu --hot-cnt %lu --hot-prob %g --iter %lu --seed %u)",
+                  acct_max, inflight, txn_acct, universe, hot_cnt, (double)hot_prob, iter_max, seed ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  ulong footprint = fd_acct_lock_footprint( acct_max );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "bad --acct-max" ));
+  void * mem = aligned_alloc( fd_acct_lock_align(), footprint );
+  if( FD_UNLIKELY( !mem ) ) FD_LOG_ERR(( "aligned_alloc failed" ));
+  fd_acct_lock_t * lock = fd_acct_lock_join( fd_acct_lock_new( mem, acct_max, fd_rng_ulong( rng ) ) );
+  if( FD_UNLIKELY( !lock ) ) FD_LOG_ERR(( "fd_acct_lock_join failed" ));
+
+  FD_LOG_NOTICE(( "Generating %lu transactions", POOL_MAX ));
+
+  uint  hot_thresh = (uint)((double)hot_prob*(double)UINT_MAX);
+  ulong sig_cnt    = txn_acct/4UL;
+  for( ulong t=0UL; t<POOL_MAX; t++ ) {
+    fd_txn_t * txn = (fd_txn_t *)pool_txn[t];
+    fd_memset( txn, 0, TXN_FOOTPRINT );
+    txn->signature_cnt         = (uchar)sig_cnt;
+    txn->readonly_signed_cnt   = (uchar)0;
+    txn->readonly_unsigned_cnt = (uchar)(txn_acct-2UL*sig_cnt);
+    txn->acct_addr_cnt         = (ushort)txn_acct;
+    txn->acct_addr_off         = (ushort)0;
+    for( ulong i=0UL; i<txn_acct; i++ ) {
+      ulong idx = (fd_rng_uint( rng )<hot_thresh) ? fd_rng_ulong_roll( rng, hot_cnt ) : fd_rng_ulong_roll( rng, universe );
+      make_addr( pool_payload + (t*txn_acct+i)*FD_TXN_ACCT_ADDR_SZ, idx );
+    }
+  }
+
+  /* Fill the FIFO */
+
+  ulong next     = 0UL; /* Next candidate */
+  ulong fifo_cnt = 0UL;
+  ulong try_cnt  = 0UL;
+  while( fifo_cnt<inflight ) {
+    ulong t = next; next = (next+1UL) & (POOL_MAX-1UL); try_cnt++;
+    int err = fd_acct_lock_txn_acquire( lock, (fd_txn_t const *)pool_txn[t], pool_payload + t*txn_acct*FD_TXN_ACCT_ADDR_SZ );
+    if( FD_UNLIKELY( err==FD_ACCT_LOCK_ERR_FULL ) ) FD_LOG_ERR(( "--acct-max too small" ));
+    if( !err ) fifo[ fifo_cnt++ ] = t;
+    if( FD_UNLIKELY( try_cnt>4UL*POOL_MAX ) ) FD_LOG_ERR(( "can't reach --inflight; reduce contention" ));
+  }
+
+  FD_LOG_NOTICE(( "Warmed up (%lu in-flight txns, %lu live locked accounts, %lu tries)",
+                  fifo_cnt, fd_acct_lock_acct_cnt( lock ), try_cnt ));
+
+  /* Steady state.  Candidates are drawn round robin from the pool.
+     As the pool is at least twice the FIFO, a candidate is normally not
+     in-flight (if it is, it conflicts with itself as every transaction
+     writes its signers). */
+
+  ulong head     = 0UL; /* Oldest in-flight in fifo (circular buffer of inflight) */
+  ulong acq_cnt  = 0UL;
+  ulong conf_cnt = 0UL;
+  ulong live_sum = 0UL;
+
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_max; iter++ ) {
+    ulong r = fifo[ head ];
+    fd_acct_lock_txn_release( lock, (fd_txn_t const *)pool_txn[r], pool_payload + r*txn_acct*FD_TXN_ACCT_ADDR_SZ );
+    for(;;) {
+      ulong t = next; next = (next+1UL) & (POOL_MAX-1UL);
+      int err = fd_acct_lock_txn_acquire( lock, (fd_txn_t const *)pool_txn[t], pool_payload + t*txn_acct*FD_TXN_ACCT_ADDR_SZ );
+      acq_cnt++;
+      if( FD_LIKELY( !err ) ) { fifo[ head ] = t; break; }
+      if( FD_UNLIKELY( err==FD_ACCT_LOCK_ERR_FULL ) ) FD_LOG_ERR(( "--acct-max too small" ));
+      conf_cnt++;
+    }
+    head = (head+1UL==inflight) ? 0UL : head+1UL;
+    if( FD_UNLIKELY( !(iter & 1023UL) ) ) live_sum += fd_acct_lock_acct_cnt( lock );
+  }
+  dt += fd_log_wallclock();
+
+  double ns_per_op = (double)dt / (double)(iter_max + acq_cnt); /* Ops are releases + acquire attempts */
+  FD_LOG_NOTICE(( "%lu releases, %lu acquire attempts (%.2f%% conflicted), avg %.0f live locked accounts",
+                  iter_max, acq_cnt, 100.*(double)conf_cnt/(double)fd_ulong_max( acq_cnt, 1UL ),
+                  (double)live_sum/(double)fd_ulong_max( (iter_max+1023UL)>>10, 1UL ) ));
+  FD_LOG_NOTICE(( "%.1f ns/op, %.2f Mtxn/s/core retired, %.1f ns/acct",
+                  ns_per_op, 1e3*(double)iter_max/(double)dt, ns_per_op/(double)txn_acct ));
+
+  while( fifo_cnt ) {
+    ulong t = fifo[ --fifo_cnt ];
+    fd_acct_lock_txn_release( lock, (fd_txn_t const *)pool_txn[t], pool_payload + t*txn_acct*FD_TXN_ACCT_ADDR_SZ );
+  }
+  FD_TEST( !fd_acct_lock_acct_cnt( lock ) );
+
+  free( fd_acct_lock_delete( fd_acct_lock_leave( lock ) ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
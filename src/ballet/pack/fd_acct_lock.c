@@ -0,0 +1,311 @@
+#include "fd_acct_lock.h"
+
+#define FD_ACCT_LOCK_MAGIC (0xf17eda2ce7ac1000UL) /* firedancer acct lock ver 0 */
+
+/* A fd_acct_lock_key_t is the map key of an account: its address and
+   the table's seeded hash of it (see fd_acct_lock_private_key).  The
+   hash is computed once per lookup and carried with the key as the map
+   template only sees the key (so the entries don't memoize it again). */
+
+struct fd_acct_lock_key {
+  fd_txn_acct_addr_t addr;
+  ulong              hash;
+};
+
+typedef struct fd_acct_lock_key fd_acct_lock_key_t;
+
+/* A fd_acct_lock_ent_t is the lock state of an account.  An entry is
+   only in the map while the account has readers or a writer.  (Note
+   that the entry can't have both.) */
+
+struct fd_acct_lock_ent {
+  fd_acct_lock_key_t key;
+  uint               reader_cnt;
+  uint               writer;
+};
+
+typedef struct fd_acct_lock_ent fd_acct_lock_ent_t;
+
+#define FD_ACCT_LOCK_NULL ((fd_acct_lock_key_t){ .addr={ .ul={ 0UL, 0UL, 0UL, 0UL } }, .hash=0UL })
+
+#define MAP_NAME              fd_acct_lock_map
+#define MAP_T                 fd_acct_lock_ent_t
+#define MAP_KEY_T             fd_acct_lock_key_t
+#define MAP_KEY_NULL          FD_ACCT_LOCK_NULL
+#define MAP_KEY_INVAL(k)      (!((k).addr.ul[0] | (k).addr.ul[1] | (k).addr.ul[2] | (k).addr.ul[3]))
+#define MAP_KEY_EQUAL(k0,k1)  (((k0).hash==(k1).hash) &&                                                 \
+                               ((k0).addr.ul[0]==(k1).addr.ul[0]) & ((k0).addr.ul[1]==(k1).addr.ul[1]) & \
+                               ((k0).addr.ul[2]==(k1).addr.ul[2]) & ((k0).addr.ul[3]==(k1).addr.ul[3]))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_KEY_HASH(k)       ((uint)(k).hash)
+#define MAP_MEMOIZE           0
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+struct __attribute__((aligned(FD_ACCT_LOCK_ALIGN))) fd_acct_lock_private {
+  ulong magic;    /* ==FD_ACCT_LOCK_MAGIC */
+  ulong acct_max;
+  ulong seed;
+  ulong map_off;  /* Offset of the map relative to the lock */
+  /* Padding to map align here */
+  /* map here */
+};
+
+/* fd_acct_lock_lg_slot_cnt returns the log2 of the number of map slots
+   used for acct_max accounts.  The map is kept at most half full such
+   that probe sequences stay short. */
+
+FD_FN_CONST static inline int
+fd_acct_lock_lg_slot_cnt( ulong acct_max ) {
+  return fd_ulong_find_msb( 2UL*acct_max-1UL ) + 1;
+}
+
+FD_FN_CONST static inline ulong
+fd_acct_lock_map_off( void ) {
+  return fd_ulong_align_up( sizeof(fd_acct_lock_t), fd_acct_lock_map_align() );
+}
+
+FD_FN_PURE static inline fd_acct_lock_ent_t *
+fd_acct_lock_map( fd_acct_lock_t const * lock ) {
+  return fd_acct_lock_map_join( (void *)((ulong)lock + lock->map_off) );
+}
+
+/* fd_acct_lock_private_key returns the map key for the account whose
+   address is at addr (unaligned okay).  The hash is seeded such that
+   the map layout cannot be predicted by somebody choosing account
+   addresses (e.g. to make many of them collide). */
+
+static inline fd_acct_lock_key_t
+fd_acct_lock_private_key( fd_acct_lock_t const * lock,
+                          void const *           addr ) {
+  fd_acct_lock_key_t key;
+  memcpy( key.addr.b, addr, FD_TXN_ACCT_ADDR_SZ );
+  key.hash = fd_hash( lock->seed, key.addr.b, FD_TXN_ACCT_ADDR_SZ );
+  return key;
+}
+
+ulong
+fd_acct_lock_align( void ) {
+  return FD_ACCT_LOCK_ALIGN;
+}
+
+ulong
+fd_acct_lock_footprint( ulong acct_max ) {
+  if( FD_UNLIKELY( (!acct_max) | (acct_max>FD_ACCT_LOCK_ACCT_MAX) ) ) return 0UL;
+  return fd_ulong_align_up( fd_acct_lock_map_off() + fd_acct_lock_map_footprint( fd_acct_lock_lg_slot_cnt( acct_max ) ),
+                            FD_ACCT_LOCK_ALIGN );
+}
+
+void *
+fd_acct_lock_new( void * shmem,
+                  ulong  acct_max,
+                  ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_acct_lock_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_acct_lock_footprint( acct_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad acct_max (%lu)", acct_max ));
+    return NULL;
+  }
+
+  fd_acct_lock_t * lock = (fd_acct_lock_t *)shmem;
+
+  lock->acct_max = acct_max;
+  lock->seed     = seed;
+  lock->map_off  = fd_acct_lock_map_off();
+
+  fd_acct_lock_map_new( (void *)((ulong)shmem + lock->map_off), fd_acct_lock_lg_slot_cnt( acct_max ) );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( lock->magic ) = FD_ACCT_LOCK_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_acct_lock_t *
+fd_acct_lock_join( void * shlock ) {
+
+  if( FD_UNLIKELY( !shlock ) ) {
+    FD_LOG_WARNING(( "NULL shlock" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shlock, fd_acct_lock_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shlock" ));
+    return NULL;
+  }
+
+  fd_acct_lock_t * lock = (fd_acct_lock_t *)shlock;
+  if( FD_UNLIKELY( lock->magic!=FD_ACCT_LOCK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return lock;
+}
+
+void *
+fd_acct_lock_leave( fd_acct_lock_t * lock ) {
+
+  if( FD_UNLIKELY( !lock ) ) {
+    FD_LOG_WARNING(( "NULL lock" ));
+    return NULL;
+  }
+
+  return (void *)lock;
+}
+
+void *
+fd_acct_lock_delete( void * shlock ) {
+
+  if( FD_UNLIKELY( !shlock ) ) {
+    FD_LOG_WARNING(( "NULL shlock" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shlock, fd_acct_lock_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shlock" ));
+    return NULL;
+  }
+
+  fd_acct_lock_t * lock = (fd_acct_lock_t *)shlock;
+  if( FD_UNLIKELY( lock->magic!=FD_ACCT_LOCK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( lock->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shlock;
+}
+
+ulong fd_acct_lock_acct_max( fd_acct_lock_t const * lock ) { return lock->acct_max; }
+ulong fd_acct_lock_acct_cnt( fd_acct_lock_t const * lock ) { return fd_acct_lock_map_key_cnt( fd_acct_lock_map( lock ) ); }
+
+ulong
+fd_acct_lock_reader_cnt( fd_acct_lock_t const *     lock,
+                         fd_txn_acct_addr_t const * addr ) {
+  fd_acct_lock_ent_t * ent = fd_acct_lock_map_query( fd_acct_lock_map( lock ), fd_acct_lock_private_key( lock, addr ), NULL );
+  return ent ? (ulong)ent->reader_cnt : 0UL;
+}
+
+int
+fd_acct_lock_is_written( fd_acct_lock_t const *     lock,
+                         fd_txn_acct_addr_t const * addr ) {
+  fd_acct_lock_ent_t * ent = fd_acct_lock_map_query( fd_acct_lock_map( lock ), fd_acct_lock_private_key( lock, addr ), NULL );
+  return ent ? (int)ent->writer : 0;
+}
+
+/* fd_acct_lock_private_keys computes the map keys of the accounts
+   [i0,i0+cnt) of a transaction into key[j] for j in [0,cnt).  Acquire
+   and release compute the keys FD_ACCT_LOCK_KEY_BATCH accounts at a
+   time ahead of the map operations such that the (independent) hashes
+   can overlap instead of each one stalling its account's probe. */
+
+#define FD_ACCT_LOCK_KEY_BATCH (16UL)
+
+static inline void
+fd_acct_lock_private_keys( fd_acct_lock_t const * lock,
+                           uchar const *          acct_addr,
+                           ulong                  i0,
+                           ulong                  cnt,
+                           fd_acct_lock_key_t *   key ) {
+  for( ulong j=0UL; j<cnt; j++ ) key[j] = fd_acct_lock_private_key( lock, acct_addr + (i0+j)*FD_TXN_ACCT_ADDR_SZ );
+}
+
+/* fd_acct_lock_private_unlock releases one lock on the account with
+   map key key (which is assumed to be locked as indicated). */
+
+static inline void
+fd_acct_lock_private_unlock( fd_acct_lock_ent_t * map,
+                             fd_acct_lock_key_t   key,
+                             int                  writable ) {
+  if( FD_UNLIKELY( fd_acct_lock_map_key_inval( key ) ) ) return;
+  fd_acct_lock_ent_t * ent = fd_acct_lock_map_query( map, key, NULL );
+  if( FD_UNLIKELY( !ent ) ) return; /* Not locked, caller error */
+  if( writable ) ent->writer = 0U;
+  else           ent->reader_cnt--;
+  if( !(ent->reader_cnt | ent->writer) ) fd_acct_lock_map_remove( map, ent );
+}
+
+#define FD_ACCT_LOCK_IS_WRITABLE(i) (((i)<writable_signed_cnt) | (((i)>=signature_cnt) & ((i)<writable_unsigned_end)))
+
+int
+fd_acct_lock_acquire( fd_acct_lock_t * lock,
+                      uchar const *    acct_addr,
+                      ulong            acct_cnt,
+                      ulong            writable_signed_cnt,
+                      ulong            signature_cnt,
+                      ulong            writable_unsigned_end ) {
+
+  fd_acct_lock_ent_t * map      = fd_acct_lock_map( lock );
+  ulong                acct_max = lock->acct_max;
+
+  /* Lock the accounts one at a time.  Locking an account checks against
+     the locks taken for the transaction's earlier accounts too such
+     that a transaction that lists a writable account twice conflicts
+     with itself. */
+
+  fd_acct_lock_key_t key[ FD_ACCT_LOCK_KEY_BATCH ];
+  int   err = FD_ACCT_LOCK_SUCCESS;
+  ulong i;
+  for( i=0UL; i<acct_cnt; i++ ) {
+    ulong j = i & (FD_ACCT_LOCK_KEY_BATCH-1UL);
+    if( FD_UNLIKELY( !j ) ) fd_acct_lock_private_keys( lock, acct_addr, i, fd_ulong_min( acct_cnt-i, FD_ACCT_LOCK_KEY_BATCH ), key );
+    if( FD_UNLIKELY( fd_acct_lock_map_key_inval( key[j] ) ) ) continue;
+    int writable = FD_ACCT_LOCK_IS_WRITABLE( i );
+
+    fd_acct_lock_ent_t * ent = fd_acct_lock_map_query( map, key[j], NULL );
+    if( FD_LIKELY( !ent ) ) {
+      if( FD_UNLIKELY( fd_acct_lock_map_key_cnt( map )>=acct_max ) ) { err = FD_ACCT_LOCK_ERR_FULL; break; }
+      ent = fd_acct_lock_map_insert( map, key[j] ); /* Can't fail */
+      ent->reader_cnt = 0U;
+      ent->writer     = 0U;
+    } else if( FD_UNLIKELY( ent->writer | (uint)(writable & !!ent->reader_cnt) ) ) {
+      err = FD_ACCT_LOCK_ERR_CONFLICT;
+      break;
+    }
+
+    if( writable ) ent->writer = 1U;
+    else           ent->reader_cnt++;
+  }
+
+  /* On failure, undo the locks taken on accounts [0,i) */
+
+  if( FD_UNLIKELY( err ) )
+    while( i ) {
+      i--;
+      fd_acct_lock_private_unlock( map, fd_acct_lock_private_key( lock, acct_addr + i*FD_TXN_ACCT_ADDR_SZ ), FD_ACCT_LOCK_IS_WRITABLE( i ) );
+    }
+
+  return err;
+}
+
+void
+fd_acct_lock_release( fd_acct_lock_t * lock,
+                      uchar const *    acct_addr,
+                      ulong            acct_cnt,
+                      ulong            writable_signed_cnt,
+                      ulong            signature_cnt,
+                      ulong            writable_unsigned_end ) {
+  fd_acct_lock_ent_t * map = fd_acct_lock_map( lock );
+  fd_acct_lock_key_t   key[ FD_ACCT_LOCK_KEY_BATCH ];
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    ulong j = i & (FD_ACCT_LOCK_KEY_BATCH-1UL);
+    if( FD_UNLIKELY( !j ) ) fd_acct_lock_private_keys( lock, acct_addr, i, fd_ulong_min( acct_cnt-i, FD_ACCT_LOCK_KEY_BATCH ), key );
+    fd_acct_lock_private_unlock( map, key[j], FD_ACCT_LOCK_IS_WRITABLE( i ) );
+  }
+}
+
+#undef FD_ACCT_LOCK_IS_WRITABLE
@@ -0,0 +1,86 @@
+#include "fd_compute_budget_program.h"
+
+/* fd_compute_budget_program_private_scan runs
+   fd_compute_budget_program_parse on the data of each instruction of
+   txn (whose payload is p) whose program is the compute budget program,
+   in instruction order, accumulating into cbp.  Returns a
+   FD_COMPUTE_BUDGET_PROGRAM_STATUS_*, stopping at the first instruction
+   that fails. */
+
+static uchar
+fd_compute_budget_program_private_scan( fd_txn_t const *                    t,
+                                        uchar const *                       p,
+                                        fd_compute_budget_program_state_t * cbp ) {
+  uchar const * acct_addr = p + t->acct_addr_off;
+  ulong         acct_cnt  = (ulong)t->acct_addr_cnt;
+  ulong         instr_cnt = (ulong)t->instr_cnt;
+  for( ulong i=0UL; i<instr_cnt; i++ ) {
+    fd_txn_instr_t const * instr = t->instr + i;
+    ulong program_id = (ulong)instr->program_id;
+    /* Programs can't be loaded from address lookup tables (not checked
+       by the parser) */
+    if( FD_UNLIKELY( program_id>=acct_cnt ) ) return FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_PROGRAM;
+    if( FD_UNLIKELY( !memcmp( acct_addr + FD_TXN_ACCT_ADDR_SZ*program_id, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ) ) )
+      if( FD_UNLIKELY( !fd_compute_budget_program_parse( p + instr->data_off, (ulong)instr->data_sz, cbp ) ) )
+        return FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_BUDGET;
+  }
+  return FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK;
+}
+
+uchar
+fd_compute_budget_program_extract( fd_txn_t const * txn,
+                                   uchar const *    payload,
+                                   ulong *          out_rewards,
+                                   uint *           out_compute ) {
+  fd_compute_budget_program_state_t cbp[1];
+  fd_compute_budget_program_init( cbp );
+  uchar status = fd_compute_budget_program_private_scan( txn, payload, cbp );
+  if( FD_LIKELY( status==FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK ) )
+    fd_compute_budget_program_finalize( cbp, (ulong)txn->instr_cnt, out_rewards, out_compute );
+  return status;
+}
+
+ulong
+fd_compute_budget_program_batch( fd_txn_t const * const *                    txn,
+                                 uchar const * const *                       payload,
+                                 ulong                                       txn_cnt,
+                                 fd_compute_budget_program_summary_t const * out ) {
+  ulong ok_cnt = 0UL;
+  for( ulong txn_idx=0UL; txn_idx<txn_cnt; txn_idx++ ) {
+    fd_txn_t const * t = txn    [ txn_idx ];
+    uchar const *    p = payload[ txn_idx ];
+
+    /* Prefetch the next transaction's account addresses, which is where
+       most of the cache misses are. */
+    if( FD_LIKELY( txn_idx+1UL<txn_cnt ) ) {
+      __builtin_prefetch( txn    [ txn_idx+1UL ] );
+      __builtin_prefetch( payload[ txn_idx+1UL ] + 64UL );
+    }
+
+    fd_compute_budget_program_state_t cbp[1];
+    fd_compute_budget_program_init( cbp );
+    uchar status = fd_compute_budget_program_private_scan( t, p, cbp );
+
+    out->status[ txn_idx ] = status;
+    if( FD_UNLIKELY( status!=FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK ) ) continue;
+
+    ulong priority_rewards;
+    uint  compute_units;
+    fd_compute_budget_program_finalize( cbp, (ulong)t->instr_cnt, &priority_rewards, &compute_units );
+
+    ulong acct_cnt      = (ulong)t->acct_addr_cnt;
+    ulong signature_cnt = (ulong)t->signature_cnt;
+    ulong writable_cnt  = (signature_cnt - (ulong)t->readonly_signed_cnt)
+                        + (acct_cnt - signature_cnt - (ulong)t->readonly_unsigned_cnt)
+                        + (ulong)t->addr_table_adtl_writable_cnt;
+
+    out->compute_units        [ txn_idx ] = compute_units;
+    out->priority_rewards     [ txn_idx ] = priority_rewards;
+    out->micro_lamports_per_cu[ txn_idx ] = cbp->micro_lamports_per_cu;
+    out->heap_size            [ txn_idx ] = cbp->heap_size;
+    out->signature_cnt        [ txn_idx ] = (uchar)signature_cnt;
+    out->writable_cnt         [ txn_idx ] = (ushort)writable_cnt;
+    ok_cnt++;
+  }
+  return ok_cnt;
+}
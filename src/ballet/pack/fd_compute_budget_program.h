@@ -202,6 +202,77 @@ fd_compute_budget_program_finalize( fd_compute_budget_program_state_t const * st
   } else total_fee = state->total_fee;
   *out_rewards = total_fee;
 }
+
+/* fd_compute_budget_program_summary_t is the structure-of-arrays output
+   of fd_compute_budget_program_batch.  Each member points to a caller
+   owned array indexed [0,txn_cnt).  For the txn_idx-th transaction:
+
+     status[ txn_idx ]                 is one of FD_COMPUTE_BUDGET_PROGRAM_STATUS_*
+     compute_units[ txn_idx ]          is the compute unit limit (as
+                                       out_compute of finalize)
+     priority_rewards[ txn_idx ]       is the total priority fee in
+                                       lamports (as out_rewards of
+                                       finalize, i.e. the CU price applied
+                                       to the CU limit)
+     micro_lamports_per_cu[ txn_idx ]  is the requested CU price (0 if
+                                       none or if the deprecated total fee
+                                       instruction was used)
+     heap_size[ txn_idx ]              is the requested heap size in bytes
+                                       (0 if none)
+     signature_cnt[ txn_idx ]          is the number of signatures
+     writable_cnt[ txn_idx ]           is the number of writable accounts
+                                       (including those loaded from
+                                       address lookup tables)
+
+   The other members are undefined for a transaction whose status is
+   not FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK. */
+
+#define FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK          ((uchar)0) /* success */
+#define FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_PROGRAM ((uchar)1) /* an instruction's program is not a static account */
+#define FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_BUDGET  ((uchar)2) /* invalid compute budget program instructions */
+
+struct fd_compute_budget_program_summary {
+  uchar  * status;
+  uint   * compute_units;
+  ulong  * priority_rewards;
+  ulong  * micro_lamports_per_cu;
+  uint   * heap_size;
+  uchar  * signature_cnt;
+  ushort * writable_cnt;
+};
+typedef struct fd_compute_budget_program_summary fd_compute_budget_program_summary_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_compute_budget_program_extract extracts the compute budget of the
+   parsed transaction txn whose payload is payload.  Returns one of
+   FD_COMPUTE_BUDGET_PROGRAM_STATUS_*.  On OK, stores the priority fee
+   and compute unit limit in *out_rewards and *out_compute (as
+   finalize).  Equivalent to running fd_compute_budget_program_parse on
+   the data of each instruction whose program is the compute budget
+   program, in order, followed by finalize. */
+
+uchar
+fd_compute_budget_program_extract( fd_txn_t const * txn,
+                                   uchar const *    payload,
+                                   ulong *          out_rewards,
+                                   uint *           out_compute );
+
+/* fd_compute_budget_program_batch is the same as extract for txn_cnt
+   parsed transactions.  txn[ txn_idx ] is the fd_txn_t of the
+   transaction whose payload is payload[ txn_idx ].  Writes the summary
+   of each transaction to out (see above) and returns the number of
+   transactions with status OK.  The next transaction is prefetched while
+   the current one is processed. */
+
+ulong
+fd_compute_budget_program_batch( fd_txn_t const * const *                    txn,
+                                 uchar const * const *                       payload,
+                                 ulong                                       txn_cnt,
+                                 fd_compute_budget_program_summary_t const * out );
+
+FD_PROTOTYPES_END
+
 #undef FD_COMPUTE_BUDGET_PROGRAM_FLAG_SET_CU
 #undef FD_COMPUTE_BUDGET_PROGRAM_FLAG_SET_FEE
 #undef FD_COMPUTE_BUDGET_PROGRAM_FLAG_SET_HEAP
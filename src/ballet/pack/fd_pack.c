@@ -0,0 +1,529 @@
+#include "fd_pack.h"
+#include "fd_compute_budget_program.h"
+
+#define FD_PACK_MAGIC (0xf17eda2ce7ac0000UL) /* firedancer pack ver 0 */
+
+/* FD_PACK_SCHEDULE_SCAN_MAX is the maximum number of pending
+   transactions fd_pack_schedule considers per microblock. */
+
+#define FD_PACK_SCHEDULE_SCAN_MAX (4UL*FD_PACK_MICROBLOCK_TXN_MAX)
+
+/* A fd_pack_ord_t is the pool's heap entry for a pending transaction.
+   rewards and compute_est are copied from the transaction such that
+   heap operations don't touch the (large) transactions. */
+
+struct fd_pack_ord {
+  ulong rewards;
+  uint  compute_est;
+  uint  txn_idx;
+};
+
+typedef struct fd_pack_ord fd_pack_ord_t;
+
+/* fd_pack_ord_lt returns 1 if x has strictly lower reward per compute
+   unit than y and 0 otherwise.  This is the cross multiplied
+   x.rewards/x.compute_est < y.rewards/y.compute_est.  The products can
+   exceed 64-bits so they are done in double precision (ties between
+   nearly identical priorities can resolve either way). */
+
+FD_FN_CONST static inline int
+fd_pack_ord_lt( fd_pack_ord_t x,
+                fd_pack_ord_t y ) {
+  return ((double)x.rewards*(double)y.compute_est) < ((double)y.rewards*(double)x.compute_est);
+}
+
+/* The pool is a max-min heap on priority (Atkinson et al, "Min-max
+   heaps and generalized priority queues", CACM 1986): heap[i] for i in
+   [0,cnt) is a binary heap whose even levels (the root is level 0) are
+   max levels and odd levels are min levels.  An element on a max (min)
+   level has priority no lower (no higher) than any of its descendants.
+   Thus heap[0] is the highest priority pending transaction (scheduled
+   next) and the lowest priority one (evicted next) is heap[0] if cnt is
+   1 and the lower of heap[1] and heap[2] otherwise.  Inserting and
+   removing either one are O(lg cnt).  (This is not built on
+   util/tmpl/fd_prq.c as fd_prq only gives O(1) access to one end of
+   the order.  Evicting from the other end would need to scan the cnt/2
+   leaves on every insert into a full pool.) */
+
+FD_FN_CONST static inline int
+fd_pack_heap_is_max_level( ulong idx ) {
+  return !(fd_ulong_find_msb( idx+1UL ) & 1);
+}
+
+/* fd_pack_heap_out_of_order returns 1 if x has lower (max non-zero)
+   or higher (max zero) priority than y, i.e. x should not be an
+   ancestor of y on a max (min) level. */
+
+FD_FN_CONST static inline int
+fd_pack_heap_out_of_order( int           max,
+                           fd_pack_ord_t x,
+                           fd_pack_ord_t y ) {
+  return max ? fd_pack_ord_lt( x, y ) : fd_pack_ord_lt( y, x );
+}
+
+static inline void
+fd_pack_heap_swap( fd_pack_ord_t * heap,
+                   ulong           i,
+                   ulong           j ) {
+  fd_pack_ord_t t = heap[i]; heap[i] = heap[j]; heap[j] = t;
+}
+
+/* fd_pack_heap_bubble_up restores the heap property for an element at
+   heap[idx] that might be out of order with its ancestors. */
+
+static void
+fd_pack_heap_bubble_up( fd_pack_ord_t * heap,
+                        ulong           idx ) {
+  if( FD_UNLIKELY( !idx ) ) return;
+  int   max = fd_pack_heap_is_max_level( idx );
+  ulong par = (idx-1UL)>>1;
+  if( fd_pack_heap_out_of_order( !max, heap[par], heap[idx] ) ) { /* The parent is on the other kind of level */
+    fd_pack_heap_swap( heap, idx, par );
+    idx = par;
+    max = !max;
+  }
+  while( idx>=3UL ) { /* Has a grandparent */
+    ulong gp = (((idx-1UL)>>1)-1UL)>>1;
+    if( !fd_pack_heap_out_of_order( max, heap[gp], heap[idx] ) ) break;
+    fd_pack_heap_swap( heap, idx, gp );
+    idx = gp;
+  }
+}
+
+/* fd_pack_heap_trickle_down restores the heap property for an element
+   at heap[idx] that might be out of order with its descendants. */
+
+static void
+fd_pack_heap_trickle_down( fd_pack_ord_t * heap,
+                           ulong           cnt,
+                           ulong           idx ) {
+  int max = fd_pack_heap_is_max_level( idx );
+  for(;;) {
+    ulong c = 2UL*idx + 1UL;
+    if( c>=cnt ) break;
+
+    /* m is the most out of order of idx's children and grandchildren
+       (the highest priority one on a max level, lowest on a min) */
+
+    ulong m = c;
+    if( c+1UL<cnt && fd_pack_heap_out_of_order( max, heap[m], heap[c+1UL] ) ) m = c+1UL;
+    ulong g1 = fd_ulong_min( 2UL*c + 5UL, cnt );
+    for( ulong g=2UL*c+1UL; g<g1; g++ ) if( fd_pack_heap_out_of_order( max, heap[m], heap[g] ) ) m = g;
+
+    if( !fd_pack_heap_out_of_order( max, heap[idx], heap[m] ) ) break;
+    fd_pack_heap_swap( heap, idx, m );
+    if( m<=c+1UL ) break; /* A child, its descendants are fine */
+
+    ulong par = (m-1UL)>>1; /* On the other kind of level */
+    if( fd_pack_heap_out_of_order( !max, heap[par], heap[m] ) ) fd_pack_heap_swap( heap, m, par );
+    idx = m;
+  }
+}
+
+/* fd_pack_heap_min_idx returns the index of the lowest priority element
+   of a heap with cnt>0 elements. */
+
+FD_FN_PURE static inline ulong
+fd_pack_heap_min_idx( fd_pack_ord_t const * heap,
+                      ulong                 cnt ) {
+  if( FD_UNLIKELY( cnt<3UL ) ) return cnt-1UL;
+  return fd_ulong_if( fd_pack_ord_lt( heap[2], heap[1] ), 2UL, 1UL );
+}
+
+/* fd_pack_heap_insert inserts ord into a heap with cnt elements (room
+   for at least cnt+1).  fd_pack_heap_remove removes heap[idx] from a
+   heap with cnt>idx elements.  idx should be 0 (the highest priority
+   element) or fd_pack_heap_min_idx (the lowest). */
+
+static inline void
+fd_pack_heap_insert( fd_pack_ord_t * heap,
+                     ulong           cnt,
+                     fd_pack_ord_t   ord ) {
+  heap[cnt] = ord;
+  fd_pack_heap_bubble_up( heap, cnt );
+}
+
+static inline void
+fd_pack_heap_remove( fd_pack_ord_t * heap,
+                     ulong           cnt,
+                     ulong           idx ) {
+  cnt--;
+  if( FD_UNLIKELY( idx==cnt ) ) return;
+  heap[idx] = heap[cnt];
+  fd_pack_heap_trickle_down( heap, cnt, idx );
+}
+
+struct __attribute__((aligned(FD_PACK_ALIGN))) fd_pack_private {
+  ulong magic;        /* ==FD_PACK_MAGIC */
+  ulong pending_max;
+  ulong inflight_max;
+  ulong inflight_cnt;
+  ulong lut_inflight; /* 1 if the in-flight transaction is one with lookup tables (it is then the only one) */
+  ulong free_cnt;     /* Number of free transactions, free[i] for i in [0,free_cnt) are their indices */
+  ulong pending_cnt;  /* Number of pending transactions, heap[i] for i in [0,pending_cnt) are their ords */
+  ulong heap_off;     /* Offsets relative to the pack */
+  ulong lock_off;
+  ulong free_off;
+  ulong txn_off;
+  fd_pack_ord_t defer[ FD_PACK_SCHEDULE_SCAN_MAX ];
+  uchar txn_scratch[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+  /* Padding to FD_PACK_ALIGN here */
+  /* heap here */
+  /* account lock table here (room for the accounts of inflight_max transactions) */
+  /* free stack here (txn_cnt uint) */
+  /* txn array here (txn_cnt fd_pack_txn_t) */
+};
+
+/* The pool has room for pending_max pending transactions,
+   inflight_max in-flight transactions and one more such that there is
+   always a free transaction to parse an incoming transaction into
+   (before deciding whether it gets in). */
+
+FD_FN_CONST static inline ulong
+fd_pack_txn_cnt( ulong pending_max,
+                 ulong inflight_max ) {
+  return pending_max + inflight_max + 1UL;
+}
+
+FD_FN_CONST static inline ulong
+fd_pack_heap_off( void ) {
+  return fd_ulong_align_up( sizeof(fd_pack_t), alignof(fd_pack_ord_t) );
+}
+
+FD_FN_CONST static inline ulong
+fd_pack_lock_off( ulong pending_max ) {
+  return fd_ulong_align_up( fd_pack_heap_off() + pending_max*sizeof(fd_pack_ord_t), fd_acct_lock_align() );
+}
+
+FD_FN_CONST static inline ulong
+fd_pack_free_off( ulong pending_max,
+                  ulong inflight_max ) {
+  return fd_ulong_align_up( fd_pack_lock_off( pending_max ) + fd_acct_lock_footprint( inflight_max*FD_PACK_TXN_ACCT_MAX ),
+                            alignof(uint) );
+}
+
+FD_FN_CONST static inline ulong
+fd_pack_txn_off( ulong pending_max,
+                 ulong inflight_max ) {
+  return fd_ulong_align_up( fd_pack_free_off( pending_max, inflight_max ) + fd_pack_txn_cnt( pending_max, inflight_max )*sizeof(uint),
+                            alignof(fd_pack_txn_t) );
+}
+
+FD_FN_PURE static inline fd_pack_ord_t *  fd_pack_heap( fd_pack_t * pack ) { return (fd_pack_ord_t *) ((ulong)pack + pack->heap_off); }
+FD_FN_PURE static inline fd_acct_lock_t * fd_pack_lock( fd_pack_t * pack ) { return (fd_acct_lock_t *)((ulong)pack + pack->lock_off); }
+FD_FN_PURE static inline uint *           fd_pack_free( fd_pack_t * pack ) { return (uint *)          ((ulong)pack + pack->free_off); }
+FD_FN_PURE static inline fd_pack_txn_t *  fd_pack_txn ( fd_pack_t * pack ) { return (fd_pack_txn_t *) ((ulong)pack + pack->txn_off ); }
+
+ulong
+fd_pack_align( void ) {
+  return FD_PACK_ALIGN;
+}
+
+ulong
+fd_pack_footprint( ulong pending_max,
+                   ulong inflight_max ) {
+  if( FD_UNLIKELY( (!pending_max) | (pending_max>=(ulong)UINT_MAX) ) ) return 0UL;
+  if( FD_UNLIKELY( (!inflight_max) | (inflight_max>FD_ACCT_LOCK_ACCT_MAX/FD_PACK_TXN_ACCT_MAX) ) ) return 0UL;
+  if( FD_UNLIKELY( fd_pack_txn_cnt( pending_max, inflight_max )>(ulong)UINT_MAX ) ) return 0UL;
+  return fd_ulong_align_up( fd_pack_txn_off( pending_max, inflight_max ) + fd_pack_txn_cnt( pending_max, inflight_max )*sizeof(fd_pack_txn_t),
+                            FD_PACK_ALIGN );
+}
+
+void *
+fd_pack_new( void * shmem,
+             ulong  pending_max,
+             ulong  inflight_max,
+             ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_pack_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_pack_footprint( pending_max, inflight_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad pending_max (%lu) or inflight_max (%lu)", pending_max, inflight_max ));
+    return NULL;
+  }
+
+  fd_pack_t * pack = (fd_pack_t *)shmem;
+
+  ulong txn_cnt = fd_pack_txn_cnt( pending_max, inflight_max );
+
+  pack->pending_max  = pending_max;
+  pack->inflight_max = inflight_max;
+  pack->inflight_cnt = 0UL;
+  pack->lut_inflight = 0UL;
+  pack->free_cnt     = txn_cnt;
+  pack->pending_cnt  = 0UL;
+  pack->heap_off     = fd_pack_heap_off();
+  pack->lock_off     = fd_pack_lock_off( pending_max );
+  pack->free_off     = fd_pack_free_off( pending_max, inflight_max );
+  pack->txn_off      = fd_pack_txn_off ( pending_max, inflight_max );
+
+  if( FD_UNLIKELY( !fd_acct_lock_new( (void *)((ulong)shmem + pack->lock_off), inflight_max*FD_PACK_TXN_ACCT_MAX, seed ) ) ) return NULL;
+
+  uint * free = fd_pack_free( pack );
+  for( ulong i=0UL; i<txn_cnt; i++ ) free[i] = (uint)i;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pack->magic ) = FD_PACK_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_pack_t *
+fd_pack_join( void * shpack ) {
+
+  if( FD_UNLIKELY( !shpack ) ) {
+    FD_LOG_WARNING(( "NULL shpack" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpack, fd_pack_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpack" ));
+    return NULL;
+  }
+
+  fd_pack_t * pack = (fd_pack_t *)shpack;
+  if( FD_UNLIKELY( pack->magic!=FD_PACK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_acct_lock_join( (void *)((ulong)shpack + pack->lock_off) ) ) ) return NULL;
+
+  return pack;
+}
+
+void *
+fd_pack_leave( fd_pack_t * pack ) {
+
+  if( FD_UNLIKELY( !pack ) ) {
+    FD_LOG_WARNING(( "NULL pack" ));
+    return NULL;
+  }
+
+  return (void *)pack;
+}
+
+void *
+fd_pack_delete( void * shpack ) {
+
+  if( FD_UNLIKELY( !shpack ) ) {
+    FD_LOG_WARNING(( "NULL shpack" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpack, fd_pack_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpack" ));
+    return NULL;
+  }
+
+  fd_pack_t * pack = (fd_pack_t *)shpack;
+  if( FD_UNLIKELY( pack->magic!=FD_PACK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  fd_acct_lock_delete( (void *)((ulong)shpack + pack->lock_off) );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pack->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shpack;
+}
+
+ulong fd_pack_pending_max ( fd_pack_t const * pack ) { return pack->pending_max;  }
+ulong fd_pack_pending_cnt ( fd_pack_t const * pack ) { return pack->pending_cnt;  }
+ulong fd_pack_inflight_max( fd_pack_t const * pack ) { return pack->inflight_max; }
+ulong fd_pack_inflight_cnt( fd_pack_t const * pack ) { return pack->inflight_cnt; }
+
+/* fd_pack_private_has_dup_acct returns 1 if any of the acct_cnt
+   account addresses at acct_addr appears more than once and 0
+   otherwise.  acct_cnt is at most FD_PACK_TXN_ACCT_MAX, so this simply
+   compares all pairs (the first 8 bytes of each first). */
+
+static int
+fd_pack_private_has_dup_acct( uchar const * acct_addr,
+                              ulong         acct_cnt ) {
+  ulong key[ FD_PACK_TXN_ACCT_MAX ];
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    uchar const * addr = acct_addr + FD_TXN_ACCT_ADDR_SZ*i;
+    ulong         k    = fd_ulong_load_8( addr );
+    for( ulong j=0UL; j<i; j++ )
+      if( FD_UNLIKELY( key[j]==k ) && !memcmp( acct_addr + FD_TXN_ACCT_ADDR_SZ*j, addr, FD_TXN_ACCT_ADDR_SZ ) ) return 1;
+    key[i] = k;
+  }
+  return 0;
+}
+
+int
+fd_pack_insert( fd_pack_t *   pack,
+                uchar const * payload,
+                ulong         payload_sz ) {
+
+  if( FD_UNLIKELY( payload_sz>FD_PACK_TXN_MTU ) ) return FD_PACK_INSERT_REJECT_SZ;
+
+  /* Parse the transaction in place in a free transaction (there is
+     always at least one, see above) such that the offsets produced by
+     the parser refer to the pack's copy. */
+
+  uint *          free    = fd_pack_free( pack );
+  ulong           txn_idx = (ulong)free[ pack->free_cnt-1UL ];
+  fd_pack_txn_t * ptxn    = fd_pack_txn( pack ) + txn_idx;
+
+  fd_memcpy( ptxn->payload, payload, payload_sz );
+
+  fd_txn_t * txn = (fd_txn_t *)pack->txn_scratch;
+  if( FD_UNLIKELY( !fd_txn_parse( ptxn->payload, payload_sz, txn, NULL ) ) ) return FD_PACK_INSERT_REJECT_PARSE;
+
+  /* The runtime rejects transactions that list an account more than
+     once.  Such a transaction would also conflict with itself in the
+     account lock table and thus could never be scheduled. */
+
+  if( FD_UNLIKELY( fd_pack_private_has_dup_acct( ptxn->payload + txn->acct_addr_off, (ulong)txn->acct_addr_cnt ) ) )
+    return FD_PACK_INSERT_REJECT_ACCT_DUP;
+
+  /* Extract the compute unit limit and prioritization fee */
+
+  ulong priority_rewards;
+  uint  compute;
+  uchar status = fd_compute_budget_program_extract( txn, ptxn->payload, &priority_rewards, &compute );
+  if( FD_UNLIKELY( status!=FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK ) )
+    return status==FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_PROGRAM ? FD_PACK_INSERT_REJECT_PARSE : FD_PACK_INSERT_REJECT_BUDGET;
+
+  ulong sig_rewards = FD_PACK_FEE_PER_SIGNATURE*(ulong)txn->signature_cnt;
+  ulong rewards     = sig_rewards + priority_rewards;
+  rewards           = fd_ulong_if( rewards<sig_rewards, ULONG_MAX, rewards ); /* saturate */
+
+  ptxn->rewards           = rewards;
+  ptxn->compute_est       = (uint)fd_ulong_max( fd_ulong_min( (ulong)compute, FD_PACK_TXN_CU_MAX ), 1UL );
+  ptxn->payload_sz        = (ushort)payload_sz;
+  ptxn->acct_addr_off     = txn->acct_addr_off;
+  ptxn->acct_addr_cnt     = txn->acct_addr_cnt;
+  ptxn->writable_signed   = (uchar)(txn->signature_cnt - txn->readonly_signed_cnt);
+  ptxn->signature_cnt     = txn->signature_cnt;
+  ptxn->writable_unsigned = (ushort)(txn->acct_addr_cnt - txn->readonly_unsigned_cnt);
+  ptxn->has_lut           = (uchar)!!txn->addr_table_lookup_cnt;
+
+  fd_pack_ord_t ord[1];
+  ord->rewards     = ptxn->rewards;
+  ord->compute_est = ptxn->compute_est;
+  ord->txn_idx     = (uint)txn_idx;
+
+  /* If the pool is full, evict the lowest priority pending transaction
+     if the new one has strictly higher priority. */
+
+  fd_pack_ord_t * heap = fd_pack_heap( pack );
+  ulong           cnt  = pack->pending_cnt;
+  int res;
+  if( FD_LIKELY( cnt<pack->pending_max ) ) {
+    pack->free_cnt--;
+    res = FD_PACK_INSERT_ACCEPT;
+  } else {
+    ulong min_idx = fd_pack_heap_min_idx( heap, cnt );
+    if( FD_UNLIKELY( !fd_pack_ord_lt( heap[min_idx], *ord ) ) ) return FD_PACK_INSERT_REJECT_PRIORITY;
+    free[ pack->free_cnt-1UL ] = heap[min_idx].txn_idx; /* The evicted transaction replaces the new one on the free stack */
+    fd_pack_heap_remove( heap, cnt--, min_idx );
+    res = FD_PACK_INSERT_ACCEPT_EVICT;
+  }
+
+  fd_pack_heap_insert( heap, cnt, *ord );
+  pack->pending_cnt = cnt+1UL;
+  return res;
+}
+
+/* fd_pack_private_{acquire,release} lock / unlock the accounts of a
+   (non lookup table) transaction in the pack's account lock table. */
+
+static inline int
+fd_pack_private_acquire( fd_acct_lock_t *      lock,
+                         fd_pack_txn_t const * txn ) {
+  return fd_acct_lock_acquire( lock, txn->payload + txn->acct_addr_off, (ulong)txn->acct_addr_cnt,
+                               (ulong)txn->writable_signed, (ulong)txn->signature_cnt, (ulong)txn->writable_unsigned );
+}
+
+static inline void
+fd_pack_private_release( fd_acct_lock_t *      lock,
+                         fd_pack_txn_t const * txn ) {
+  fd_acct_lock_release( lock, txn->payload + txn->acct_addr_off, (ulong)txn->acct_addr_cnt,
+                        (ulong)txn->writable_signed, (ulong)txn->signature_cnt, (ulong)txn->writable_unsigned );
+}
+
+ulong
+fd_pack_schedule( fd_pack_t *            pack,
+                  ulong                  txn_max,
+                  ulong                  cu_max,
+                  fd_pack_txn_t const ** out ) {
+
+  ulong inflight_cnt = pack->inflight_cnt;
+  if( FD_UNLIKELY( pack->lut_inflight ) ) return 0UL; /* Nothing runs concurrently with a lookup table transaction */
+  txn_max = fd_ulong_min( fd_ulong_min( fd_ulong_max( txn_max, 1UL ), FD_PACK_MICROBLOCK_TXN_MAX ), pack->inflight_max - inflight_cnt );
+
+  fd_pack_ord_t *  heap  = fd_pack_heap( pack );
+  fd_pack_txn_t *  txn0  = fd_pack_txn ( pack );
+  fd_acct_lock_t * lock  = fd_pack_lock( pack );
+  fd_pack_ord_t *  defer = pack->defer;
+
+  ulong pending_cnt = pack->pending_cnt;
+  ulong cnt         = 0UL;
+  ulong cu          = 0UL;
+  ulong defer_cnt   = 0UL;
+  while( (!!pending_cnt) & (cnt<txn_max) & (cu<cu_max) & (defer_cnt<FD_PACK_SCHEDULE_SCAN_MAX) ) {
+    fd_pack_ord_t         ord = heap[0];
+    fd_pack_txn_t const * txn = txn0 + ord.txn_idx;
+
+    if( FD_UNLIKELY( txn->has_lut ) ) {
+      if( (!cnt) & (!defer_cnt) ) {
+        /* Highest priority pending transaction.  Schedule it alone if
+           nothing is in flight and otherwise wait for the in-flight
+           transactions to drain. */
+        if( inflight_cnt ) break;
+        fd_pack_heap_remove( heap, pending_cnt--, 0UL );
+        pack->lut_inflight = 1UL;
+        out[ cnt++ ] = txn;
+        break;
+      }
+      fd_pack_heap_remove( heap, pending_cnt--, 0UL );
+      defer[ defer_cnt++ ] = ord;
+      continue;
+    }
+
+    fd_pack_heap_remove( heap, pending_cnt--, 0UL );
+
+    int ok = (!cnt) || (cu+(ulong)txn->compute_est<=cu_max); /* First transaction always fits */
+    if( FD_LIKELY( ok ) ) ok = !fd_pack_private_acquire( lock, txn );
+    if( FD_UNLIKELY( !ok ) ) {
+      defer[ defer_cnt++ ] = ord;
+      continue;
+    }
+
+    out[ cnt++ ] = txn;
+    cu += (ulong)txn->compute_est;
+  }
+  pack->inflight_cnt = inflight_cnt + cnt;
+
+  /* Put the skipped transactions back */
+
+  for( ulong i=0UL; i<defer_cnt; i++ ) fd_pack_heap_insert( heap, pending_cnt++, defer[i] );
+  pack->pending_cnt = pending_cnt;
+
+  return cnt;
+}
+
+void
+fd_pack_complete( fd_pack_t *           pack,
+                  fd_pack_txn_t const * txn ) {
+  if( FD_UNLIKELY( txn->has_lut ) ) pack->lut_inflight = 0UL;
+  else                              fd_pack_private_release( fd_pack_lock( pack ), txn );
+  fd_pack_free( pack )[ pack->free_cnt++ ] = (uint)(txn - fd_pack_txn( pack ));
+  pack->inflight_cnt--;
+}
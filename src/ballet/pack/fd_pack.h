@@ -0,0 +1,207 @@
+#ifndef HEADER_fd_src_ballet_pack_fd_pack_h
+#define HEADER_fd_src_ballet_pack_fd_pack_h
+
+/* fd_pack provides APIs for the core of a block packer.  Transactions
+   (raw payloads, as they came over the wire) are inserted into a
+   bounded pool of pending transactions ordered by the reward the leader
+   collects for including the transaction per compute unit the
+   transaction can consume.  Microblocks are then scheduled from the
+   pool greedily in priority order such that no scheduled transaction
+   conflicts with any other transaction that has been scheduled but not
+   completed yet (i.e. if an in-flight transaction writes an account,
+   no other in-flight transaction reads or writes that account).  This
+   allows the transactions in a microblock to be executed in parallel
+   in any order and microblocks to be executed in parallel with each
+   other (e.g. on different execution lanes).
+
+   When the pool is full, inserting a transaction evicts the lowest
+   priority pending transaction (or rejects the new transaction if it
+   does not have strictly higher priority than it).  As such, a flood
+   of low priority transactions cannot push out high priority ones.
+
+   The pool stores a copy of each pending payload, so callers do not
+   need to keep payloads around after inserting them.  A pack can be
+   located in a workspace but should only be used by one thread at a
+   time. */
+
+#include "fd_acct_lock.h"
+
+#define FD_PACK_ALIGN (128UL)
+
+/* FD_PACK_TXN_MTU is the largest transaction payload a pack will
+   accept (the Solana transaction MTU). */
+
+#define FD_PACK_TXN_MTU (1232UL)
+
+/* FD_PACK_FEE_PER_SIGNATURE is the base fee (in lamports) a transaction
+   pays per signature.  FD_PACK_TXN_CU_MAX is the maximum number of
+   compute units a transaction can consume (larger compute unit limit
+   requests get clamped to this by the runtime). */
+
+#define FD_PACK_FEE_PER_SIGNATURE (5000UL)
+#define FD_PACK_TXN_CU_MAX        (1400000UL)
+
+/* FD_PACK_MICROBLOCK_TXN_MAX is the maximum number of transactions
+   fd_pack_schedule will put in a microblock. */
+
+#define FD_PACK_MICROBLOCK_TXN_MAX (64UL)
+
+/* FD_PACK_TXN_ACCT_MAX is an upper bound on the number of static
+   accounts a transaction that fits in FD_PACK_TXN_MTU can have. */
+
+#define FD_PACK_TXN_ACCT_MAX (FD_PACK_TXN_MTU/FD_TXN_ACCT_ADDR_SZ)
+
+/* FD_PACK_INSERT_* give the results of fd_pack_insert.  Non-negative
+   values indicate the transaction was accepted into the pool and
+   negative values indicate it was not. */
+
+#define FD_PACK_INSERT_ACCEPT          ( 0) /* accepted, pool had room */
+#define FD_PACK_INSERT_ACCEPT_EVICT    ( 1) /* accepted, the lowest priority pending transaction was evicted to make room */
+#define FD_PACK_INSERT_REJECT_SZ       (-1) /* payload larger than FD_PACK_TXN_MTU */
+#define FD_PACK_INSERT_REJECT_PARSE    (-2) /* payload is not a valid transaction */
+#define FD_PACK_INSERT_REJECT_BUDGET   (-3) /* transaction has invalid compute budget program instructions */
+#define FD_PACK_INSERT_REJECT_PRIORITY (-4) /* pool full and transaction not higher priority than any pending */
+#define FD_PACK_INSERT_REJECT_ACCT_DUP (-5) /* transaction lists an account address more than once */
+
+/* A fd_pack_txn_t is a transaction in a pack.  rewards is the total
+   number of lamports the leader collects for including the transaction
+   (signature fees plus prioritization fee, saturated at ULONG_MAX).
+   compute_est is the maximum number of compute units the transaction
+   can consume, in [1,FD_PACK_TXN_CU_MAX].  payload[i] for i in
+   [0,payload_sz) is the transaction's payload.  The remaining fields
+   are for internal use. */
+
+struct fd_pack_txn {
+  ulong  rewards;
+  uint   compute_est;
+  ushort payload_sz;
+  ushort acct_addr_off;     /* Location of the transaction's static account addresses in payload */
+  ushort acct_addr_cnt;     /* Number of static account addresses */
+  uchar  writable_signed;   /* Accounts [0,writable_signed) are writable */
+  uchar  signature_cnt;     /* Accounts [signature_cnt,writable_unsigned) are writable */
+  ushort writable_unsigned; /* All other static accounts are readonly */
+  uchar  has_lut;           /* Non-zero if the transaction loads accounts from address lookup tables */
+  uchar  _pad[9];
+  uchar  payload[ FD_PACK_TXN_MTU ];
+};
+
+typedef struct fd_pack_txn fd_pack_txn_t;
+
+/* fd_pack_t is an opaque handle of a join to a pack. */
+
+struct fd_pack_private;
+typedef struct fd_pack_private fd_pack_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_pack_{align,footprint} return the alignment and footprint
+   required for a memory region to be used as a pack with room for up to
+   pending_max pending transactions and up to inflight_max in-flight
+   transactions.  footprint returns 0 if pending_max or inflight_max is
+   zero or too large (the footprint is a little more than
+   FD_PACK_TXN_MTU per pending transaction and roughly 4 KiB per
+   in-flight transaction).
+
+   fd_pack_new formats a memory region with the appropriate alignment
+   and footprint into an empty pack.  seed seeds the hash function of
+   the pack's account lock table (see fd_acct_lock_new, this should be
+   an unpredictable value).  Returns shmem on success and NULL on
+   failure (logs details).  Caller is not joined on return.
+
+   fd_pack_join joins the caller to a pack.  Returns a handle to the
+   caller's local join on success and NULL on failure (logs details).
+
+   fd_pack_leave leaves a current local join.  Returns the underlying
+   shared memory region on success and NULL on failure (logs details).
+
+   fd_pack_delete unformats a memory region used as a pack.  Assumes
+   nobody is joined.  Returns shmem on success and NULL on failure (logs
+   details). */
+
+FD_FN_CONST ulong
+fd_pack_align( void );
+
+FD_FN_CONST ulong
+fd_pack_footprint( ulong pending_max,
+                   ulong inflight_max );
+
+void *
+fd_pack_new( void * shmem,
+             ulong  pending_max,
+             ulong  inflight_max,
+             ulong  seed );
+
+fd_pack_t *
+fd_pack_join( void * shpack );
+
+void *
+fd_pack_leave( fd_pack_t * pack );
+
+void *
+fd_pack_delete( void * shpack );
+
+/* fd_pack_{pending_max,pending_cnt} return the maximum / current number
+   of transactions pending in the pack.  fd_pack_{inflight_max,
+   inflight_cnt} return the maximum / current number of transactions
+   that have been scheduled but not completed. */
+
+FD_FN_PURE ulong fd_pack_pending_max ( fd_pack_t const * pack );
+FD_FN_PURE ulong fd_pack_pending_cnt ( fd_pack_t const * pack );
+FD_FN_PURE ulong fd_pack_inflight_max( fd_pack_t const * pack );
+FD_FN_PURE ulong fd_pack_inflight_cnt( fd_pack_t const * pack );
+
+/* fd_pack_insert parses the transaction payload[i] for i in
+   [0,payload_sz), extracts its compute unit limit and prioritization
+   fee from its compute budget program instructions and inserts it into
+   the pool of pending transactions.  Returns a FD_PACK_INSERT_* code
+   (see above).  The pack has no interest in payload on return. */
+
+int
+fd_pack_insert( fd_pack_t *   pack,
+                uchar const * payload,
+                ulong         payload_sz );
+
+/* fd_pack_schedule schedules a microblock of up to txn_max pending
+   transactions (txn_max is clamped to [1,FD_PACK_MICROBLOCK_TXN_MAX]
+   and to the room left for in-flight transactions) whose compute unit
+   estimates sum to at most cu_max.  Transactions are taken in priority
+   order, skipping (but leaving pending) any transaction that conflicts
+   with an in-flight transaction (including the ones already in the
+   microblock) or that does not fit in the remaining compute budget.
+   To bound the work done per call, only the few highest priority
+   pending transactions are considered.
+
+   The first transaction in a microblock is accepted even if its compute
+   unit estimate is larger than cu_max such that no pending transaction
+   can be starved.  Transactions that load accounts from address lookup
+   tables can't be checked for conflicts here (the tables are on chain)
+   and thus are only scheduled when nothing else is in flight (and
+   nothing else is scheduled until they complete).  When the highest
+   priority pending transaction is such a transaction, scheduling
+   pauses until the in-flight transactions complete such that it isn't
+   starved.
+
+   Returns the number of transactions in the microblock.  out[i] for i
+   in [0,cnt) points to the scheduled transactions in priority order.
+   These are no longer pending but in flight until passed to
+   fd_pack_complete (they are valid until then).  Returns 0 if no
+   pending transaction can be scheduled at this time.
+
+   fd_pack_complete indicates that the in-flight transaction txn (as
+   returned by fd_pack_schedule) has finished executing.  Its accounts
+   are no longer considered in use and the pack has no interest in txn
+   on return. */
+
+ulong
+fd_pack_schedule( fd_pack_t *            pack,
+                  ulong                  txn_max,
+                  ulong                  cu_max,
+                  fd_pack_txn_t const ** out );
+
+void
+fd_pack_complete( fd_pack_t *           pack,
+                  fd_pack_txn_t const * txn );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_pack_fd_pack_h */
@@ -0,0 +1,266 @@
+#include "../fd_ballet.h"
+
+#define ACCT_MAX     (1024UL)
+#define UNIVERSE     (256UL)  /* Accounts used by the randomized test are numbered [1,UNIVERSE] */
+#define INFLIGHT_MAX (64UL)
+#define TXN_ACCT_MAX (40UL)   /* Spans several of the lock table's key batches */
+
+static uchar lock_mem[ 256UL*1024UL ] __attribute__((aligned(FD_ACCT_LOCK_ALIGN)));
+
+/* A test transaction (only the fields fd_acct_lock looks at are
+   populated and the account addresses are at the start of the
+   payload). */
+
+struct test_txn {
+  uchar txn_mem[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+  uchar payload[ TXN_ACCT_MAX*FD_TXN_ACCT_ADDR_SZ ];
+  ulong acct    [ TXN_ACCT_MAX ];
+  int   writable[ TXN_ACCT_MAX ];
+};
+
+typedef struct test_txn test_txn_t;
+
+#define TXN(t) ((fd_txn_t *)(t)->txn_mem)
+
+static test_txn_t inflight[ INFLIGHT_MAX ];
+static test_txn_t scratch [ 1 ];
+
+/* make_txn populates t with a transaction that has sig_cnt signers
+   (ro_signed of them readonly) and non-signers (ro_unsigned of them
+   readonly) using the accounts acct[i] for i in [0,acct_cnt) (in the
+   order given, 0 is the system program). */
+
+static void
+make_txn( test_txn_t *  t,
+          ulong const * acct,
+          ulong         acct_cnt,
+          ulong         sig_cnt,
+          ulong         ro_signed,
+          ulong         ro_unsigned ) {
+  FD_TEST( acct_cnt<=TXN_ACCT_MAX );
+  fd_memset( t->txn_mem, 0, sizeof(t->txn_mem) );
+  TXN( t )->signature_cnt         = (uchar)sig_cnt;
+  TXN( t )->readonly_signed_cnt   = (uchar)ro_signed;
+  TXN( t )->readonly_unsigned_cnt = (uchar)ro_unsigned;
+  TXN( t )->acct_addr_cnt         = (ushort)acct_cnt;
+  TXN( t )->acct_addr_off         = (ushort)0;
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    fd_memset( t->payload + i*FD_TXN_ACCT_ADDR_SZ, 0, FD_TXN_ACCT_ADDR_SZ );
+    memcpy( t->payload + i*FD_TXN_ACCT_ADDR_SZ + 7UL, acct+i, sizeof(ulong) ); /* Unaligned on purpose */
+    t->acct    [i] = acct[i];
+    t->writable[i] = (i<sig_cnt-ro_signed) | ((i>=sig_cnt) & (i<acct_cnt-ro_unsigned));
+  }
+}
+
+static fd_txn_acct_addr_t
+addr_of( ulong acct ) {
+  fd_txn_acct_addr_t addr;
+  fd_memset( addr.b, 0, FD_TXN_ACCT_ADDR_SZ );
+  memcpy( addr.b + 7UL, &acct, sizeof(ulong) );
+  return addr;
+}
+
+static int acquire( fd_acct_lock_t * lock, test_txn_t const * t ) { return fd_acct_lock_txn_acquire( lock, TXN( t ), t->payload ); }
+static void release( fd_acct_lock_t * lock, test_txn_t const * t ) { fd_acct_lock_txn_release( lock, TXN( t ), t->payload ); }
+
+/* Reference model of the lock table for the randomized test */
+
+static ulong ref_reader_cnt[ UNIVERSE+1UL ];
+static int   ref_writer    [ UNIVERSE+1UL ];
+
+static void
+check_ref( fd_acct_lock_t const * lock ) {
+  ulong cnt = 0UL;
+  for( ulong a=1UL; a<=UNIVERSE; a++ ) {
+    fd_txn_acct_addr_t addr = addr_of( a );
+    FD_TEST( fd_acct_lock_reader_cnt( lock, &addr )==ref_reader_cnt[a] );
+    FD_TEST( fd_acct_lock_is_written( lock, &addr )==ref_writer    [a] );
+    cnt += (ulong)(ref_reader_cnt[a] || ref_writer[a]);
+  }
+  FD_TEST( fd_acct_lock_acct_cnt( lock )==cnt );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_acct_lock_align()==FD_ACCT_LOCK_ALIGN );
+  FD_TEST( !fd_acct_lock_footprint( 0UL                       ) );
+  FD_TEST( !fd_acct_lock_footprint( FD_ACCT_LOCK_ACCT_MAX+1UL ) );
+  ulong footprint = fd_acct_lock_footprint( ACCT_MAX );
+  FD_LOG_NOTICE(( "footprint %lu", footprint ));
+  FD_TEST( footprint && footprint<=sizeof(lock_mem) );
+
+  FD_TEST( !fd_acct_lock_new( NULL,           ACCT_MAX, 0UL ) );
+  FD_TEST( !fd_acct_lock_new( lock_mem+1UL,   ACCT_MAX, 0UL ) );
+  FD_TEST( !fd_acct_lock_new( lock_mem,       0UL,      0UL ) );
+  FD_TEST( !fd_acct_lock_join( NULL                    ) );
+
+  fd_acct_lock_t * lock = fd_acct_lock_join( fd_acct_lock_new( lock_mem, ACCT_MAX, fd_rng_ulong( rng ) ) );
+  FD_TEST( lock );
+  FD_TEST( fd_acct_lock_acct_max( lock )==ACCT_MAX );
+  FD_TEST( !fd_acct_lock_acct_cnt( lock ) );
+
+  test_txn_t * t0 = inflight+0;
+  test_txn_t * t1 = inflight+1;
+  test_txn_t * t2 = inflight+2;
+
+  /* Readers share, writers are exclusive.  t0 writes 1 and reads 2 and
+     the system program. */
+
+  make_txn( t0, (ulong[]){ 1UL, 2UL, 0UL }, 3UL, 1UL, 0UL, 2UL );
+  FD_TEST( acquire( lock, t0 )==FD_ACCT_LOCK_SUCCESS );
+  FD_TEST( fd_acct_lock_acct_cnt( lock )==2UL );
+  fd_txn_acct_addr_t a1 = addr_of( 1UL ); fd_txn_acct_addr_t a2 = addr_of( 2UL ); fd_txn_acct_addr_t a3 = addr_of( 3UL );
+  FD_TEST(  fd_acct_lock_is_written( lock, &a1 ) ); FD_TEST( !fd_acct_lock_reader_cnt( lock, &a1 ) );
+  FD_TEST( !fd_acct_lock_is_written( lock, &a2 ) ); FD_TEST(  fd_acct_lock_reader_cnt( lock, &a2 )==1UL );
+
+  make_txn( t1, (ulong[]){ 3UL, 2UL, 0UL }, 3UL, 1UL, 0UL, 2UL ); /* Writes 3, reads 2 */
+  FD_TEST( acquire( lock, t1 )==FD_ACCT_LOCK_SUCCESS );
+  FD_TEST( fd_acct_lock_reader_cnt( lock, &a2 )==2UL );
+
+  make_txn( t2, (ulong[]){ 4UL, 1UL }, 2UL, 1UL, 0UL, 1UL ); /* Reads write locked 1 */
+  FD_TEST( acquire( lock, t2 )==FD_ACCT_LOCK_ERR_CONFLICT );
+  make_txn( t2, (ulong[]){ 4UL, 3UL }, 2UL, 2UL, 0UL, 0UL ); /* Writes write locked 3 */
+  FD_TEST( acquire( lock, t2 )==FD_ACCT_LOCK_ERR_CONFLICT );
+  make_txn( t2, (ulong[]){ 4UL, 2UL }, 2UL, 1UL, 0UL, 0UL ); /* Writes read locked 2 */
+  FD_TEST( acquire( lock, t2 )==FD_ACCT_LOCK_ERR_CONFLICT );
+
+  /* Failures leave the table unchanged (4 was locked before the
+     conflict was detected) */
+
+  fd_txn_acct_addr_t a4 = addr_of( 4UL );
+  FD_TEST( fd_acct_lock_acct_cnt( lock )==3UL );
+  FD_TEST( !fd_acct_lock_is_written( lock, &a4 ) );
+  FD_TEST( fd_acct_lock_reader_cnt( lock, &a2 )==2UL );
+
+  /* A transaction that writes an account twice conflicts with itself,
+     one that reads an account twice doesn't */
+
+  make_txn( t2, (ulong[]){ 4UL, 5UL, 4UL }, 3UL, 1UL, 0UL, 0UL );
+  FD_TEST( acquire( lock, t2 )==FD_ACCT_LOCK_ERR_CONFLICT );
+  FD_TEST( fd_acct_lock_acct_cnt( lock )==3UL );
+  make_txn( t2, (ulong[]){ 4UL, 5UL, 5UL }, 3UL, 1UL, 0UL, 2UL );
+  FD_TEST( acquire( lock, t2 )==FD_ACCT_LOCK_SUCCESS );
+  fd_txn_acct_addr_t a5 = addr_of( 5UL );
+  FD_TEST( fd_acct_lock_reader_cnt( lock, &a5 )==2UL );
+  release( lock, t2 );
+  FD_TEST( !fd_acct_lock_reader_cnt( lock, &a5 ) );
+
+  /* Releasing unlocks */
+
+  release( lock, t0 );
+  FD_TEST( !fd_acct_lock_is_written( lock, &a1 ) );
+  FD_TEST( fd_acct_lock_reader_cnt( lock, &a2 )==1UL );
+  make_txn( t2, (ulong[]){ 4UL, 1UL }, 2UL, 1UL, 0UL, 1UL );
+  FD_TEST( acquire( lock, t2 )==FD_ACCT_LOCK_SUCCESS );
+  release( lock, t2 );
+  release( lock, t1 );
+  FD_TEST( !fd_acct_lock_acct_cnt( lock ) );
+  FD_TEST( !fd_acct_lock_reader_cnt( lock, &a2 ) ); FD_TEST( !fd_acct_lock_is_written( lock, &a3 ) );
+
+  /* Capacity */
+
+  FD_TEST( fd_acct_lock_delete( fd_acct_lock_leave( lock ) )==lock_mem );
+  FD_TEST( !fd_acct_lock_join( lock_mem ) );
+  lock = fd_acct_lock_join( fd_acct_lock_new( lock_mem, 4UL, fd_rng_ulong( rng ) ) );
+  FD_TEST( lock );
+  make_txn( t0, (ulong[]){ 1UL, 2UL, 3UL }, 3UL, 1UL, 0UL, 2UL );
+  FD_TEST( acquire( lock, t0 )==FD_ACCT_LOCK_SUCCESS );
+  make_txn( t1, (ulong[]){ 4UL, 2UL, 5UL }, 3UL, 1UL, 0UL, 2UL );
+  FD_TEST( acquire( lock, t1 )==FD_ACCT_LOCK_ERR_FULL );
+  FD_TEST( fd_acct_lock_acct_cnt( lock )==3UL );
+  FD_TEST( fd_acct_lock_reader_cnt( lock, &a2 )==1UL );
+  make_txn( t1, (ulong[]){ 4UL, 2UL, 3UL }, 3UL, 1UL, 0UL, 2UL );
+  FD_TEST( acquire( lock, t1 )==FD_ACCT_LOCK_SUCCESS );
+  FD_TEST( fd_acct_lock_acct_cnt( lock )==4UL );
+  release( lock, t0 );
+  release( lock, t1 );
+  FD_TEST( !fd_acct_lock_acct_cnt( lock ) );
+  FD_TEST( fd_acct_lock_delete( fd_acct_lock_leave( lock ) )==lock_mem );
+
+  /* Randomized test against a reference model */
+
+  lock = fd_acct_lock_join( fd_acct_lock_new( lock_mem, ACCT_MAX, fd_rng_ulong( rng ) ) );
+  FD_TEST( lock );
+
+  ulong inflight_cnt = 0UL;
+  ulong ok_cnt       = 0UL;
+  ulong fail_cnt     = 0UL;
+  for( ulong iter=0UL; iter<200000UL; iter++ ) {
+    uint r = fd_rng_uint( rng );
+    if( inflight_cnt && ((inflight_cnt==INFLIGHT_MAX) | !(r & 3U)) ) {
+
+      /* Release a random in-flight transaction */
+
+      ulong        idx = fd_rng_ulong_roll( rng, inflight_cnt );
+      test_txn_t * t   = inflight + idx;
+      release( lock, t );
+      for( ulong i=0UL; i<(ulong)TXN( t )->acct_addr_cnt; i++ ) {
+        if( !t->acct[i] ) continue;
+        if( t->writable[i] ) ref_writer[ t->acct[i] ] = 0;
+        else                 ref_reader_cnt[ t->acct[i] ]--;
+      }
+      if( idx!=inflight_cnt-1UL ) inflight[ idx ] = inflight[ inflight_cnt-1UL ];
+      inflight_cnt--;
+
+    } else {
+
+      /* Try to acquire a random transaction.  Occasionally use
+         duplicate accounts and the system program. */
+
+      ulong acct_cnt = 1UL + fd_rng_ulong_roll( rng, TXN_ACCT_MAX );
+      ulong acct[ TXN_ACCT_MAX ];
+      for( ulong i=0UL; i<acct_cnt; i++ ) acct[i] = 1UL + fd_rng_ulong_roll( rng, UNIVERSE );
+      if( !(r & 0x70U) ) acct[ fd_rng_ulong_roll( rng, acct_cnt ) ] = acct[ fd_rng_ulong_roll( rng, acct_cnt ) ];
+      if( !(r & 0x380U) ) acct[ fd_rng_ulong_roll( rng, acct_cnt ) ] = 0UL;
+      ulong sig_cnt     = 1UL + fd_rng_ulong_roll( rng, acct_cnt );
+      ulong ro_signed   = fd_rng_ulong_roll( rng, sig_cnt );
+      ulong ro_unsigned = fd_rng_ulong_roll( rng, acct_cnt-sig_cnt+1UL );
+      make_txn( scratch, acct, acct_cnt, sig_cnt, ro_signed, ro_unsigned );
+
+      /* Expected result */
+
+      int   expect_ok = 1;
+      ulong rd[ UNIVERSE+1UL ]; int wr[ UNIVERSE+1UL ];
+      memcpy( rd, ref_reader_cnt, sizeof(rd) ); memcpy( wr, ref_writer, sizeof(wr) );
+      for( ulong i=0UL; i<acct_cnt; i++ ) {
+        ulong a = acct[i];
+        if( !a ) continue;
+        if( wr[a] | (scratch->writable[i] & !!rd[a]) ) { expect_ok = 0; break; }
+        if( scratch->writable[i] ) wr[a] = 1;
+        else                       rd[a]++;
+      }
+
+      int err = acquire( lock, scratch );
+      FD_TEST( err==(expect_ok ? FD_ACCT_LOCK_SUCCESS : FD_ACCT_LOCK_ERR_CONFLICT) );
+      if( expect_ok ) {
+        memcpy( ref_reader_cnt, rd, sizeof(rd) ); memcpy( ref_writer, wr, sizeof(wr) );
+        inflight[ inflight_cnt++ ] = *scratch;
+        ok_cnt++;
+      } else {
+        fail_cnt++;
+      }
+    }
+
+    if( !(iter & 1023UL) ) check_ref( lock );
+  }
+  check_ref( lock );
+  FD_LOG_NOTICE(( "acquired %lu, conflicted %lu", ok_cnt, fail_cnt ));
+  FD_TEST( ok_cnt && fail_cnt );
+
+  while( inflight_cnt ) release( lock, inflight + (--inflight_cnt) );
+  FD_TEST( !fd_acct_lock_acct_cnt( lock ) );
+
+  FD_TEST( fd_acct_lock_leave( NULL )==NULL );
+  FD_TEST( fd_acct_lock_delete( fd_acct_lock_leave( lock ) )==lock_mem );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
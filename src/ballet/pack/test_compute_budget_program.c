@@ -237,6 +237,149 @@ test_txn( uchar * payload,
   FD_TEST( (ulong)compute==expected_max_cu );
 }
 
+/* ref_summary is the straightforward per-transaction reference for
+   fd_compute_budget_program_batch. */
+
+static uchar
+ref_summary( uchar const *    payload,
+             fd_txn_t const * txn,
+             uint *           compute,
+             ulong *          rewards,
+             ulong *          price,
+             uint *           heap,
+             ushort *         writable ) {
+  fd_compute_budget_program_state_t state;
+  fd_compute_budget_program_init( &state );
+  uchar const * addresses = payload + txn->acct_addr_off;
+  for( ulong i=0UL; i<txn->instr_cnt; i++ ) {
+    if( txn->instr[ i ].program_id>=txn->acct_addr_cnt ) return FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_PROGRAM;
+    if( !memcmp( addresses+FD_TXN_ACCT_ADDR_SZ*txn->instr[ i ].program_id, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ) ) {
+      if( !fd_compute_budget_program_parse( payload+txn->instr[ i ].data_off, txn->instr[ i ].data_sz, &state ) )
+        return FD_COMPUTE_BUDGET_PROGRAM_STATUS_ERR_BUDGET;
+    }
+  }
+  fd_compute_budget_program_finalize( &state, txn->instr_cnt, rewards, compute );
+  *price    = state.micro_lamports_per_cu;
+  *heap     = state.heap_size;
+  *writable = (ushort)( txn->signature_cnt - txn->readonly_signed_cnt
+                      + txn->acct_addr_cnt - txn->signature_cnt - txn->readonly_unsigned_cnt
+                      + txn->addr_table_adtl_writable_cnt );
+  return FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK;
+}
+
+/* test_batch checks fd_compute_budget_program_batch and
+   fd_compute_budget_program_extract against ref_summary on random
+   mutations of the given transactions.  Half of the mutations target
+   instruction data such that the compute budget instructions get
+   corrupted regularly.  Some mutations copy the compute budget program
+   address over an account address such that transactions that invoke it
+   through another account index or list it more than once get covered. */
+
+#define BATCH_MAX (16UL)
+
+static uchar batch_payload[ BATCH_MAX ][ 1232UL ];
+static uchar batch_txn    [ BATCH_MAX ][ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+
+static uchar  b_status  [ BATCH_MAX ];
+static uint   b_compute [ BATCH_MAX ];
+static ulong  b_rewards [ BATCH_MAX ];
+static ulong  b_price   [ BATCH_MAX ];
+static uint   b_heap    [ BATCH_MAX ];
+static uchar  b_sig     [ BATCH_MAX ];
+static ushort b_writable[ BATCH_MAX ];
+
+static fd_compute_budget_program_summary_t const batch_out[1] = {{
+  .status                = b_status,
+  .compute_units         = b_compute,
+  .priority_rewards      = b_rewards,
+  .micro_lamports_per_cu = b_price,
+  .heap_size             = b_heap,
+  .signature_cnt         = b_sig,
+  .writable_cnt          = b_writable
+}};
+
+void
+test_batch( fd_rng_t *          rng,
+            uchar const * const txn[],
+            ulong const         txn_sz[],
+            ulong               txn_cnt ) {
+  fd_txn_t const * batch_t[ BATCH_MAX ];
+  uchar const *    batch_p[ BATCH_MAX ];
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) { batch_t[ j ] = (fd_txn_t const *)batch_txn[ j ]; batch_p[ j ] = batch_payload[ j ]; }
+
+  ulong status_cnt[ 3 ] = { 0UL, 0UL, 0UL };
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong batch_cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      ulong t;
+      do {
+        t = fd_rng_ulong_roll( rng, txn_cnt );
+        fd_memcpy( batch_payload[ j ], txn[ t ], txn_sz[ t ] );
+        FD_TEST( fd_txn_parse( batch_payload[ j ], txn_sz[ t ], batch_txn[ j ], NULL ) );
+        fd_txn_t const * parsed_txn = batch_t[ j ];
+        ulong mut_cnt = fd_rng_ulong_roll( rng, 3UL );
+        for( ulong k=0UL; k<mut_cnt; k++ ) {
+          if( !fd_rng_ulong_roll( rng, 8UL ) ) {
+            ulong acct_idx = fd_rng_ulong_roll( rng, parsed_txn->acct_addr_cnt );
+            fd_memcpy( batch_payload[ j ] + parsed_txn->acct_addr_off + FD_TXN_ACCT_ADDR_SZ*acct_idx, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ );
+            continue;
+          }
+          ulong off;
+          fd_txn_instr_t const * instr = parsed_txn->instr + fd_rng_ulong_roll( rng, parsed_txn->instr_cnt );
+          if( fd_rng_uint( rng ) & 1U && instr->data_sz ) off = instr->data_off + fd_rng_ulong_roll( rng, instr->data_sz );
+          else                                            off = parsed_txn->message_off + fd_rng_ulong_roll( rng, txn_sz[ t ]-parsed_txn->message_off );
+          batch_payload[ j ][ off ] = (uchar)fd_rng_ulong_roll( rng, 1UL<<fd_rng_ulong_roll( rng, 9UL ) );
+        }
+      } while( !fd_txn_parse( batch_payload[ j ], txn_sz[ t ], batch_txn[ j ], NULL ) );
+    }
+
+    ulong ok_cnt     = fd_compute_budget_program_batch( batch_t, batch_p, batch_cnt, batch_out );
+    ulong ref_ok_cnt = 0UL;
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      uint compute; ulong rewards; ulong price; uint heap; ushort writable;
+      uchar status = ref_summary( batch_p[ j ], batch_t[ j ], &compute, &rewards, &price, &heap, &writable );
+      FD_TEST( b_status[ j ]==status );
+      status_cnt[ status ]++;
+      ulong x_rewards; uint x_compute;
+      FD_TEST( fd_compute_budget_program_extract( batch_t[ j ], batch_p[ j ], &x_rewards, &x_compute )==status );
+      if( status!=FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK ) continue;
+      FD_TEST( x_compute==compute && x_rewards==rewards );
+      FD_TEST( b_compute [ j ]==compute                   );
+      FD_TEST( b_rewards [ j ]==rewards                   );
+      FD_TEST( b_price   [ j ]==price                     );
+      FD_TEST( b_heap    [ j ]==heap                      );
+      FD_TEST( b_sig     [ j ]==batch_t[ j ]->signature_cnt );
+      FD_TEST( b_writable[ j ]==writable                  );
+      ref_ok_cnt++;
+    }
+    FD_TEST( ok_cnt==ref_ok_cnt );
+  }
+  FD_LOG_NOTICE(( "ok %lu err_program %lu err_budget %lu", status_cnt[ 0 ], status_cnt[ 1 ], status_cnt[ 2 ] ));
+  for( ulong k=0UL; k<3UL; k++ ) FD_TEST( status_cnt[ k ] );
+
+  /* Performance on a mix of the unmodified transactions */
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+    ulong t = j % txn_cnt;
+    fd_memcpy( batch_payload[ j ], txn[ t ], txn_sz[ t ] );
+    FD_TEST( fd_txn_parse( batch_payload[ j ], txn_sz[ t ], batch_txn[ j ], NULL ) );
+  }
+  const ulong test_count = 1000000UL/BATCH_MAX;
+  long dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<test_count; i++ ) {
+    for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+      FD_TEST( ref_summary( batch_p[ j ], batch_t[ j ], b_compute+j, b_rewards+j, b_price+j, b_heap+j, b_writable+j )
+               ==FD_COMPUTE_BUDGET_PROGRAM_STATUS_OK );
+    }
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "Average time per transaction (reference): %f ns", (double)dt/(double)(test_count*BATCH_MAX) ));
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<test_count; i++ ) FD_TEST( fd_compute_budget_program_batch( batch_t, batch_p, BATCH_MAX, batch_out )==BATCH_MAX );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "Average time per transaction (batch):     %f ns", (double)dt/(double)(test_count*BATCH_MAX) ));
+}
+
 int
 test_duplicate( ulong request_units_deprecated_cnt,
                 ulong request_heap_frame_cnt,
@@ -290,6 +433,11 @@ main( int     argc,
   FD_TEST( test_duplicate( 1, 0, 1, 0 ) == 0 );
   FD_TEST( test_duplicate( 1, 0, 0, 1 ) == 0 );
 
+  *cu_limit = 500000U; *ulamports = 15001UL; /* Restore txn2 */
+  uchar const * txn   [4] = { txn1,         txn2,         txn3,         txn4         };
+  ulong         txn_sz[4] = { sizeof(txn1), sizeof(txn2), sizeof(txn3), sizeof(txn4) };
+  test_batch( rng, txn, txn_sz, 4UL );
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
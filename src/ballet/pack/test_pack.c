@@ -0,0 +1,401 @@
+#include "../fd_ballet.h"
+#include "fd_compute_budget_program.h"
+
+#define PENDING_MAX  (1024UL)
+#define INFLIGHT_MAX (256UL)
+
+static uchar pack_mem[ 4000000UL ] __attribute__((aligned(FD_PACK_ALIGN)));
+static ulong rewards [ 4UL*PENDING_MAX ];
+
+#define SORT_NAME        sort_rewards_descend
+#define SORT_KEY_T       ulong
+#define SORT_BEFORE(a,b) ((a)>(b))
+#include "../../util/tmpl/fd_sort.c"
+
+/* make_txn serializes a transaction into buf and returns its size.
+   The transaction has sig_cnt signers (the first 8 bytes of the first
+   signature are tag), writes the accounts in w[i] for i in [0,w_cnt)
+   and reads the accounts in r[i] for i in [0,r_cnt) (accounts are
+   numbered by small non-zero integers, the first sig_cnt accounts are
+   the signers).  cu_limit and price, if non-zero, are requested with
+   compute budget program instructions.  If lut is non-zero, it is a v0
+   transaction that loads an account from an address lookup table. */
+
+static ulong
+make_txn( uchar *       buf,
+          ulong         tag,
+          ulong         sig_cnt,
+          ulong const * w,
+          ulong         w_cnt,
+          ulong const * r,
+          ulong         r_cnt,
+          uint          cu_limit,
+          ulong         price,
+          int           lut ) {
+  FD_TEST( (1UL<=sig_cnt) & (sig_cnt<=w_cnt) );
+  uchar * p = buf;
+  *p++ = (uchar)sig_cnt;
+  for( ulong i=0UL; i<sig_cnt; i++ ) { fd_memset( p, 0, 64UL ); if( !i ) memcpy( p, &tag, 8UL ); p += 64UL; }
+  if( lut ) *p++ = (uchar)0x80;
+  *p++ = (uchar)sig_cnt;
+  *p++ = (uchar)0;                 /* Signers are all writable */
+  *p++ = (uchar)(r_cnt+1UL);       /* Read accounts and the compute budget program are readonly */
+  *p++ = (uchar)(w_cnt+r_cnt+1UL); /* < 128 */
+  for( ulong i=0UL; i<w_cnt; i++ ) { fd_memset( p, 0, 32UL ); memcpy( p, w+i, 8UL ); p += 32UL; }
+  for( ulong i=0UL; i<r_cnt; i++ ) { fd_memset( p, 0, 32UL ); memcpy( p, r+i, 8UL ); p += 32UL; }
+  memcpy( p, FD_COMPUTE_BUDGET_PROGRAM_ID, 32UL ); p += 32UL;
+  fd_memset( p, 0xbb, 32UL ); p += 32UL; /* Recent blockhash */
+  uchar cbp_idx = (uchar)(w_cnt+r_cnt);
+  *p++ = (uchar)((!!cu_limit) + (!!price));
+  if( cu_limit ) { *p++ = cbp_idx; *p++ = (uchar)0; *p++ = (uchar)5; *p++ = (uchar)2; memcpy( p, &cu_limit, 4UL ); p += 4UL; }
+  if( price    ) { *p++ = cbp_idx; *p++ = (uchar)0; *p++ = (uchar)9; *p++ = (uchar)3; memcpy( p, &price,    8UL ); p += 8UL; }
+  if( lut ) {
+    *p++ = (uchar)1;
+    fd_memset( p, 0xcc, 32UL ); p += 32UL;
+    *p++ = (uchar)1; *p++ = (uchar)0; /* One writable account */
+    *p++ = (uchar)0;                  /* No readonly accounts */
+  }
+  return (ulong)(p - buf);
+}
+
+static ulong
+txn_tag( fd_pack_txn_t const * txn ) {
+  ulong tag; memcpy( &tag, txn->payload + 1UL, 8UL ); return tag;
+}
+
+/* expected_rewards returns the rewards for a transaction made by
+   make_txn with a cu_limit. */
+
+static ulong
+expected_rewards( ulong sig_cnt,
+                  ulong cu_limit,
+                  ulong price ) {
+  return FD_PACK_FEE_PER_SIGNATURE*sig_cnt + (cu_limit*price + 999999UL)/1000000UL;
+}
+
+/* conflicts returns 1 if txn conflicts with any of the cnt transactions
+   in mblk (brute force).  complete completes the cnt transactions in
+   mblk. */
+
+static int
+txn_acct_writable( fd_pack_txn_t const * txn,
+                   ulong                 i ) {
+  return (i<txn->writable_signed) | ((i>=txn->signature_cnt) & (i<txn->writable_unsigned));
+}
+
+static int
+conflicts( fd_pack_txn_t const *  txn,
+           fd_pack_txn_t const ** mblk,
+           ulong                  cnt ) {
+  for( ulong j=0UL; j<cnt; j++ ) {
+    fd_pack_txn_t const * other = mblk[j];
+    for( ulong a=0UL; a<txn->acct_addr_cnt; a++ ) for( ulong b=0UL; b<other->acct_addr_cnt; b++ ) {
+      uchar const * x = txn  ->payload + txn  ->acct_addr_off + 32UL*a;
+      uchar const * y = other->payload + other->acct_addr_off + 32UL*b;
+      if( memcmp( x, y, 32UL ) ) continue;
+      if( txn_acct_writable( txn, a ) | txn_acct_writable( other, b ) ) return 1;
+    }
+  }
+  return 0;
+}
+
+static void
+complete( fd_pack_t *            pack,
+          fd_pack_txn_t const ** mblk,
+          ulong                  cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) fd_pack_complete( pack, mblk[i] );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_pack_align()==FD_PACK_ALIGN );
+  FD_TEST( !fd_pack_footprint( 0UL,              INFLIGHT_MAX ) );
+  FD_TEST( !fd_pack_footprint( (ulong)UINT_MAX, INFLIGHT_MAX ) );
+  FD_TEST( !fd_pack_footprint( PENDING_MAX,      0UL          ) );
+  FD_TEST( !fd_pack_footprint( PENDING_MAX,      1UL<<30      ) );
+  ulong footprint = fd_pack_footprint( PENDING_MAX, INFLIGHT_MAX );
+  FD_TEST( footprint && footprint<=sizeof(pack_mem) && fd_ulong_is_aligned( footprint, FD_PACK_ALIGN ) );
+
+  FD_TEST( !fd_pack_new( NULL,         PENDING_MAX, INFLIGHT_MAX, 0UL ) );
+  FD_TEST( !fd_pack_new( pack_mem+1UL, PENDING_MAX, INFLIGHT_MAX, 0UL ) );
+  FD_TEST( !fd_pack_new( pack_mem,     0UL,         INFLIGHT_MAX, 0UL ) );
+  FD_TEST( !fd_pack_new( pack_mem,     PENDING_MAX, 0UL,          0UL ) );
+
+  uchar                 buf[ 2048 ];
+  fd_pack_txn_t const * out[ FD_PACK_MICROBLOCK_TXN_MAX ];
+
+  /* Rejects */
+
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_mem, 4UL, 2UL, fd_rng_ulong( rng ) ) );
+  FD_TEST( pack );
+  FD_TEST( fd_pack_pending_max ( pack )==4UL );
+  FD_TEST( fd_pack_pending_cnt ( pack )==0UL );
+  FD_TEST( fd_pack_inflight_max( pack )==2UL );
+  FD_TEST( fd_pack_inflight_cnt( pack )==0UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out ) );
+
+  ulong w[ 8 ]; ulong r[ 8 ];
+  w[0] = 1UL;
+  ulong sz = make_txn( buf, 0UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 1UL, 0 );
+  FD_TEST( fd_pack_insert( pack, buf, FD_PACK_TXN_MTU+1UL )==FD_PACK_INSERT_REJECT_SZ    );
+  FD_TEST( fd_pack_insert( pack, buf, sz-1UL              )==FD_PACK_INSERT_REJECT_PARSE );
+  buf[ sz-20UL ] = (uchar)0xff; /* Make the first instruction's program_id out of bounds */
+  FD_TEST( fd_pack_insert( pack, buf, sz                  )==FD_PACK_INSERT_REJECT_PARSE );
+  sz = make_txn( buf, 0UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 1UL, 0 );
+  buf[ sz-9UL ] = (uchar)2; /* Turn SetComputeUnitPrice into a (malformed) duplicate SetComputeUnitLimit */
+  FD_TEST( fd_pack_insert( pack, buf, sz                  )==FD_PACK_INSERT_REJECT_BUDGET );
+  FD_TEST( fd_pack_pending_cnt( pack )==0UL );
+
+  /* Eviction: a full pool keeps the highest reward per CU transactions */
+
+  for( ulong i=0UL; i<4UL; i++ ) {
+    w[0] = 1UL+i;
+    sz = make_txn( buf, 10UL+i, 1UL, w, 1UL, NULL, 0UL, 100000U, 1000UL*(i+1UL), 0 );
+    FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_ACCEPT );
+  }
+  FD_TEST( fd_pack_pending_cnt( pack )==4UL );
+  w[0] = 5UL;
+  sz = make_txn( buf, 20UL, 1UL, w, 1UL, NULL, 0UL, 100000U,  500UL, 0 ); /* Lower than everything */
+  FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_REJECT_PRIORITY );
+  sz = make_txn( buf, 10UL, 1UL, w, 1UL, NULL, 0UL, 100000U, 1000UL, 0 ); /* Same as the lowest */
+  FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_REJECT_PRIORITY );
+  sz = make_txn( buf, 21UL, 1UL, w, 1UL, NULL, 0UL,  50000U, 9000UL, 0 );
+  FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_ACCEPT_EVICT );
+  FD_TEST( fd_pack_pending_cnt( pack )==4UL );
+
+  /* At most inflight_max transactions are in flight */
+
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==2UL );
+  FD_TEST( txn_tag( out[0] )==21UL && txn_tag( out[1] )==13UL );
+  FD_TEST( out[0]->rewards    ==expected_rewards( 1UL, 50000UL, 9000UL ) );
+  FD_TEST( out[0]->compute_est==50000U );
+  FD_TEST( fd_pack_inflight_cnt( pack )==2UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out ) );
+  fd_pack_complete( pack, out[1] );
+  FD_TEST( fd_pack_inflight_cnt( pack )==1UL );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out+1 )==1UL && txn_tag( out[1] )==12UL );
+  complete( pack, out, 2UL );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==1UL && txn_tag( out[0] )==11UL );
+  complete( pack, out, 1UL );
+  FD_TEST( fd_pack_pending_cnt ( pack )==0UL );
+  FD_TEST( fd_pack_inflight_cnt( pack )==0UL );
+
+  FD_TEST( fd_pack_delete( fd_pack_leave( pack ) )==pack_mem );
+  FD_TEST( !fd_pack_join( pack_mem ) );
+
+  pack = fd_pack_join( fd_pack_new( pack_mem, PENDING_MAX, INFLIGHT_MAX, fd_rng_ulong( rng ) ) );
+  FD_TEST( pack );
+
+  /* Conflicts: A writes 1 (high), B writes 1 (mid), C and D read 2,
+     E writes 2 (low).  A, C and D can go together.  B can't go until A
+     completes and E can't go until C and D complete. */
+
+  w[0] = 10UL; w[1] = 1UL;             sz = make_txn( buf, 1UL, 1UL, w, 2UL, NULL, 0UL, 1000U, 5000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  w[0] = 11UL; w[1] = 1UL;             sz = make_txn( buf, 2UL, 1UL, w, 2UL, NULL, 0UL, 1000U, 4000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  w[0] = 12UL;             r[0] = 2UL; sz = make_txn( buf, 3UL, 1UL, w, 1UL, r,    1UL, 1000U, 3000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  w[0] = 13UL;             r[0] = 2UL; sz = make_txn( buf, 4UL, 1UL, w, 1UL, r,    1UL, 1000U, 2000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  w[0] = 14UL; w[1] = 2UL;             sz = make_txn( buf, 5UL, 1UL, w, 2UL, NULL, 0UL, 1000U, 1000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+
+  fd_pack_txn_t const * mblk[ FD_PACK_MICROBLOCK_TXN_MAX ];
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, mblk )==3UL );
+  FD_TEST( txn_tag( mblk[0] )==1UL && txn_tag( mblk[1] )==3UL && txn_tag( mblk[2] )==4UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out ) );
+  fd_pack_complete( pack, mblk[0] );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==1UL && txn_tag( out[0] )==2UL );
+  fd_pack_complete( pack, mblk[1] );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out+1 ) );
+  fd_pack_complete( pack, mblk[2] );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out+1 )==1UL && txn_tag( out[1] )==5UL );
+  complete( pack, out, 2UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out ) );
+  FD_TEST( !fd_pack_inflight_cnt( pack ) );
+
+  /* Compute budget and txn_max: the first transaction always fits */
+
+  for( ulong i=0UL; i<4UL; i++ ) {
+    w[0] = 20UL+i;
+    sz = make_txn( buf, 30UL+i, 1UL, w, 1UL, NULL, 0UL, 300000U, 1000UL*(4UL-i), 0 );
+    FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_ACCEPT );
+  }
+  FD_TEST( fd_pack_schedule( pack, 4UL, 100000UL, out )==1UL && txn_tag( out[0] )==30UL ); complete( pack, out, 1UL );
+  FD_TEST( fd_pack_schedule( pack, 4UL, 600000UL, out )==2UL && txn_tag( out[0] )==31UL && txn_tag( out[1] )==32UL ); complete( pack, out, 2UL );
+  FD_TEST( fd_pack_schedule( pack, 0UL, ULONG_MAX, out )==1UL && txn_tag( out[0] )==33UL ); complete( pack, out, 1UL );
+
+  /* Transactions with lookup tables go alone: they wait for the
+     in-flight transactions to drain and nothing goes while they are in
+     flight. */
+
+  w[0] = 40UL; sz = make_txn( buf, 40UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 3000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  w[0] = 41UL; sz = make_txn( buf, 41UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 2000UL, 1 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  w[0] = 42UL; sz = make_txn( buf, 42UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 1000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==2UL && txn_tag( out[0] )==40UL && txn_tag( out[1] )==42UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, mblk ) );
+  complete( pack, out, 2UL );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==1UL && txn_tag( out[0] )==41UL && out[0]->has_lut );
+  w[0] = 43UL; sz = make_txn( buf, 43UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 1000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, mblk ) );
+  complete( pack, out, 1UL );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==1UL && txn_tag( out[0] )==43UL );
+  complete( pack, out, 1UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out ) );
+
+  /* Transactions that list an account twice are rejected (the runtime
+     rejects them and they would conflict with themselves).  A flood of
+     high priority ones while work is in flight doesn't keep lower
+     priority transactions from being scheduled. */
+
+  w[0] = 50UL; sz = make_txn( buf, 50UL, 1UL, w, 1UL, NULL, 0UL, 1000U, 1000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, mblk )==1UL && txn_tag( mblk[0] )==50UL );
+  for( ulong i=0UL; i<4UL*FD_PACK_MICROBLOCK_TXN_MAX+1UL; i++ ) { /* More than fd_pack_schedule scans per call */
+    w[0] = 60UL+i; w[1] = 50UL; w[2] = 60UL+i;
+    sz = make_txn( buf, 60UL+i, 1UL, w, 3UL, NULL, 0UL, 1000U, 1000000UL, 0 ); /* Writes twice */
+    FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_REJECT_ACCT_DUP );
+    r[0] = 52UL; r[1] = 52UL;
+    sz = make_txn( buf, 60UL+i, 1UL, w, 1UL, r, 2UL, 1000U, 1000000UL, 0 );    /* Reads twice */
+    FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_REJECT_ACCT_DUP );
+  }
+  w[0] = 51UL; r[0] = 52UL; sz = make_txn( buf, 51UL, 1UL, w, 1UL, r, 1UL, 1000U, 1000UL, 0 ); FD_TEST( fd_pack_insert( pack, buf, sz )>=0 );
+  FD_TEST( fd_pack_pending_cnt( pack )==1UL );
+  FD_TEST( fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out )==1UL && txn_tag( out[0] )==51UL );
+  complete( pack, out,  1UL );
+  complete( pack, mblk, 1UL );
+  FD_TEST( !fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out ) );
+  FD_TEST( !fd_pack_pending_cnt( pack ) && !fd_pack_inflight_cnt( pack ) );
+
+  /* Randomized: transactions over a small set of accounts, completed
+     in random order.  Every transaction inserted comes out exactly once
+     and never conflicts with the transactions in flight. */
+
+  static uchar seen[ 1UL<<16 ];
+  fd_pack_txn_t const * inflight[ INFLIGHT_MAX ];
+  for( ulong iter=0UL; iter<100UL; iter++ ) {
+    ulong txn_cnt = fd_rng_ulong_roll( rng, PENDING_MAX+1UL );
+    fd_memset( seen, 0, txn_cnt );
+    for( ulong t=0UL; t<txn_cnt; t++ ) {
+      ulong sig_cnt = 1UL + fd_rng_ulong_roll( rng, 3UL );
+      ulong w_cnt   = sig_cnt + fd_rng_ulong_roll( rng, 4UL );
+      ulong r_cnt   = fd_rng_ulong_roll( rng, 5UL );
+      /* Distinct accounts within a transaction */
+      ulong acct[ 16 ]; ulong acct_cnt = 0UL;
+      while( acct_cnt<w_cnt+r_cnt ) {
+        ulong a = 1UL + fd_rng_ulong_roll( rng, 64UL );
+        int dup = 0; for( ulong k=0UL; k<acct_cnt; k++ ) dup |= acct[k]==a;
+        if( !dup ) acct[ acct_cnt++ ] = a;
+      }
+      sz = make_txn( buf, t, sig_cnt, acct, w_cnt, acct+w_cnt, r_cnt,
+                     (uint)(1000UL + fd_rng_ulong_roll( rng, 1000000UL )), fd_rng_ulong_roll( rng, 100000UL ), 0 );
+      FD_TEST( fd_pack_insert( pack, buf, sz )==FD_PACK_INSERT_ACCEPT );
+    }
+    FD_TEST( fd_pack_pending_cnt( pack )==txn_cnt );
+
+    ulong out_cnt      = 0UL;
+    ulong inflight_cnt = 0UL;
+    for(;;) {
+      ulong txn_max = 1UL + fd_rng_ulong_roll( rng, FD_PACK_MICROBLOCK_TXN_MAX );
+      ulong cnt     = fd_pack_schedule( pack, txn_max, 12000000UL, out );
+      if( !cnt ) {
+        if( !inflight_cnt ) break;
+        complete( pack, inflight, inflight_cnt );
+        inflight_cnt = 0UL;
+        continue;
+      }
+      FD_TEST( cnt<=txn_max && inflight_cnt+cnt<=INFLIGHT_MAX );
+      ulong cu = 0UL;
+      for( ulong i=0UL; i<cnt; i++ ) {
+        ulong tag = txn_tag( out[i] );
+        FD_TEST( tag<txn_cnt && !seen[tag] );
+        seen[tag] = 1;
+        FD_TEST( !conflicts( out[i], out, i ) );
+        FD_TEST( !conflicts( out[i], inflight, inflight_cnt ) );
+        cu += out[i]->compute_est;
+      }
+      FD_TEST( cnt==1UL || cu<=12000000UL );
+      out_cnt += cnt;
+      for( ulong i=0UL; i<cnt; i++ ) inflight[ inflight_cnt++ ] = out[i];
+      FD_TEST( fd_pack_inflight_cnt( pack )==inflight_cnt );
+
+      /* Complete a random subset of the in-flight transactions */
+
+      ulong done_cnt = fd_rng_ulong_roll( rng, inflight_cnt+1UL );
+      for( ulong i=0UL; i<done_cnt; i++ ) {
+        ulong j = fd_rng_ulong_roll( rng, inflight_cnt );
+        fd_pack_complete( pack, inflight[j] );
+        inflight[j] = inflight[ --inflight_cnt ];
+      }
+    }
+    FD_TEST( out_cnt==txn_cnt );
+    FD_TEST( !fd_pack_pending_cnt( pack ) && !fd_pack_inflight_cnt( pack ) );
+  }
+
+  /* Randomized eviction: inserting more than pending_max transactions
+     keeps (up to ties) the pending_max highest priority ones.  All the
+     transactions have the same compute estimate so priority order is
+     rewards order. */
+
+  for( ulong t=0UL; t<4UL*PENDING_MAX; t++ ) {
+    ulong price = 1UL + fd_rng_ulong_roll( rng, 1000000UL );
+    rewards[t] = expected_rewards( 1UL, 100000UL, price );
+    w[0] = 1UL + t;
+    sz = make_txn( buf, t, 1UL, w, 1UL, NULL, 0UL, 100000U, price, 0 );
+    int res = fd_pack_insert( pack, buf, sz );
+    FD_TEST( t<PENDING_MAX ? res==FD_PACK_INSERT_ACCEPT : (res==FD_PACK_INSERT_ACCEPT_EVICT || res==FD_PACK_INSERT_REJECT_PRIORITY) );
+  }
+  FD_TEST( fd_pack_pending_cnt( pack )==PENDING_MAX );
+  sort_rewards_descend_inplace( rewards, 4UL*PENDING_MAX );
+  ulong out_cnt = 0UL;
+  for(;;) {
+    ulong cnt = fd_pack_schedule( pack, FD_PACK_MICROBLOCK_TXN_MAX, ULONG_MAX, out );
+    if( !cnt ) break;
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( out[i]->rewards==rewards[ out_cnt+i ] );
+    complete( pack, out, cnt );
+    out_cnt += cnt;
+  }
+  FD_TEST( out_cnt==PENDING_MAX );
+
+  /* Randomized interleaved inserts and schedules against a brute force
+     model of the pending pool (rewards[i] for i in [0,pending_cnt)) */
+
+  ulong pending_cnt = 0UL;
+  for( ulong t=0UL; t<16UL*PENDING_MAX; t++ ) {
+    if( fd_rng_uint_roll( rng, 3U ) ) {
+      ulong price = 1UL + fd_rng_ulong_roll( rng, 1000000UL );
+      ulong r     = expected_rewards( 1UL, 100000UL, price );
+      w[0] = 1UL + t;
+      sz = make_txn( buf, t, 1UL, w, 1UL, NULL, 0UL, 100000U, price, 0 );
+      int res = fd_pack_insert( pack, buf, sz );
+      if( pending_cnt<PENDING_MAX ) {
+        FD_TEST( res==FD_PACK_INSERT_ACCEPT );
+        rewards[ pending_cnt++ ] = r;
+      } else {
+        ulong min_idx = 0UL;
+        for( ulong i=1UL; i<pending_cnt; i++ ) if( rewards[i]<rewards[min_idx] ) min_idx = i;
+        FD_TEST( res==( r>rewards[min_idx] ? FD_PACK_INSERT_ACCEPT_EVICT : FD_PACK_INSERT_REJECT_PRIORITY ) );
+        if( res==FD_PACK_INSERT_ACCEPT_EVICT ) rewards[min_idx] = r;
+      }
+    } else {
+      ulong cnt = fd_pack_schedule( pack, 1UL, ULONG_MAX, out );
+      FD_TEST( cnt==fd_ulong_min( pending_cnt, 1UL ) );
+      if( cnt ) {
+        ulong max_idx = 0UL;
+        for( ulong i=1UL; i<pending_cnt; i++ ) if( rewards[i]>rewards[max_idx] ) max_idx = i;
+        FD_TEST( out[0]->rewards==rewards[max_idx] );
+        rewards[max_idx] = rewards[ --pending_cnt ];
+        complete( pack, out, cnt );
+      }
+    }
+    FD_TEST( fd_pack_pending_cnt( pack )==pending_cnt );
+  }
+
+  FD_TEST( fd_pack_delete( fd_pack_leave( pack ) )==pack_mem );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
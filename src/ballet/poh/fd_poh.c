@@ -1,17 +1,189 @@
 #include "fd_poh.h"
 
+/* FD_POH_APPEND_IMPL selects the fd_poh_append implementation.  All
+   implementations hash the chain with a dedicated single block SHA-256
+   kernel: a PoH iteration hashes exactly 32 bytes, so the message block
+   is the previous hash followed by constant padding and length words
+   and there is no buffering or length bookkeeping to do per iteration.
+   The chain state stays in registers between iterations.
+
+   0 is a portable scalar kernel and 1 uses the SHA extensions.  Like
+   fd_sha256_core_shaext, 1 assumes FD_HAS_AVX targets support the SHA
+   extensions.  Defaults to the fastest implementation supported by the
+   build target.  (A hash chain is inherently sequential, so there is
+   nothing to gain from lane parallel AVX implementations here.
+   Computing the message schedule in vector registers was measured to be
+   slower than the scalar kernel, as the rounds dominate.) */
+
+#ifndef FD_POH_APPEND_IMPL
+#if FD_HAS_AVX
+#define FD_POH_APPEND_IMPL 1
+#else
+#define FD_POH_APPEND_IMPL 0
+#endif
+#endif
+
+static uint const fd_poh_K[64] __attribute__((aligned(64))) = {
+  0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+  0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+  0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+  0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+  0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+  0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+  0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+  0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+static uint const fd_poh_IV[8] = {
+  0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU, 0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+};
+
+/* Message words 8 through 15 of a PoH iteration's block: the 0x80
+   terminator right after the 32-byte message, zeros and the message
+   length in bits (256) at the end. */
+
+#define FD_POH_PAD_W8  (0x80000000U)
+#define FD_POH_PAD_W15 (256U)
+
+#if FD_POH_APPEND_IMPL==1
+
+#include <x86intrin.h>
+
+/* The usual SHA extension formulation (message schedule 4 words at a
+   time) specialized for a 32-byte message.  The state is kept in the
+   ABEF / CDGH order these instructions use.  The previous hash, as
+   message words, is recovered from the state by shuffling words (no
+   byte swapping is needed between iterations).  This is only compiled
+   with the SHA extensions enabled (the rest of the build doesn't assume
+   them). */
+
+__attribute__((target("sha,sse4.1")))
 fd_poh_state_t *
 fd_poh_append( fd_poh_state_t * poh,
                ulong            n ) {
-  fd_sha256_t sha;
+
+  __m128i const bswap   = _mm_setr_epi8( 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12 );
+  __m128i const abef_iv = _mm_setr_epi32( (int)fd_poh_IV[5], (int)fd_poh_IV[4], (int)fd_poh_IV[1], (int)fd_poh_IV[0] );
+  __m128i const cdgh_iv = _mm_setr_epi32( (int)fd_poh_IV[7], (int)fd_poh_IV[6], (int)fd_poh_IV[3], (int)fd_poh_IV[2] );
+  __m128i const pad0    = _mm_setr_epi32( (int)FD_POH_PAD_W8, 0, 0, 0 );
+  __m128i const pad1    = _mm_setr_epi32( 0, 0, 0, (int)FD_POH_PAD_W15 );
+
+  __m128i h0 = _mm_shuffle_epi8( _mm_load_si128( (__m128i const *)(poh->state     ) ), bswap ); /* A B C D */
+  __m128i h1 = _mm_shuffle_epi8( _mm_load_si128( (__m128i const *)(poh->state+16UL) ), bswap ); /* E F G H */
+
   while( n-- ) {
-    fd_sha256_init( &sha );
-    fd_sha256_append( &sha, poh->state, FD_SHA256_HASH_SZ );
-    fd_sha256_fini( &sha, poh->state );
+    __m128i abef = abef_iv;
+    __m128i cdgh = cdgh_iv;
+    __m128i w[4];
+    w[0] = h0; w[1] = h1; w[2] = pad0; w[3] = pad1;
+
+    /* Quad round i: w[i] = msg2( msg1( w[i-4], w[i-3] ) + alignr( w[i-1], w[i-2] ), w[i-1] ) for i>=4 */
+
+#   define QUAD_ROUND( i ) do {                                                               \
+      if( (i)>=4 ) {                                                                          \
+        __m128i x = _mm_sha256msg1_epu32( w[(i)&3], w[((i)-3)&3] );                           \
+        x = _mm_add_epi32( x, _mm_alignr_epi8( w[((i)-1)&3], w[((i)-2)&3], 4 ) );             \
+        w[(i)&3] = _mm_sha256msg2_epu32( x, w[((i)-1)&3] );                                   \
+      }                                                                                       \
+      __m128i m = _mm_add_epi32( w[(i)&3], _mm_load_si128( (__m128i const *)(fd_poh_K + 4*(i)) ) ); \
+      cdgh = _mm_sha256rnds2_epu32( cdgh, abef, m );                                          \
+      abef = _mm_sha256rnds2_epu32( abef, cdgh, _mm_shuffle_epi32( m, 0x0e ) );               \
+    } while(0)
+
+    QUAD_ROUND(  0 ); QUAD_ROUND(  1 ); QUAD_ROUND(  2 ); QUAD_ROUND(  3 );
+    QUAD_ROUND(  4 ); QUAD_ROUND(  5 ); QUAD_ROUND(  6 ); QUAD_ROUND(  7 );
+    QUAD_ROUND(  8 ); QUAD_ROUND(  9 ); QUAD_ROUND( 10 ); QUAD_ROUND( 11 );
+    QUAD_ROUND( 12 ); QUAD_ROUND( 13 ); QUAD_ROUND( 14 ); QUAD_ROUND( 15 );
+
+#   undef QUAD_ROUND
+
+    abef = _mm_add_epi32( abef, abef_iv );                       /* F E B A */
+    cdgh = _mm_add_epi32( cdgh, cdgh_iv );                       /* H G D C */
+    h0   = _mm_shuffle_epi32( _mm_unpackhi_epi64( cdgh, abef ), 0x1b ); /* D C B A -> A B C D */
+    h1   = _mm_shuffle_epi32( _mm_unpacklo_epi64( cdgh, abef ), 0x1b ); /* H G F E -> E F G H */
   }
+
+  _mm_store_si128( (__m128i *)(poh->state     ), _mm_shuffle_epi8( h0, bswap ) );
+  _mm_store_si128( (__m128i *)(poh->state+16UL), _mm_shuffle_epi8( h1, bswap ) );
   return poh;
 }
 
+#elif FD_POH_APPEND_IMPL==0
+
+#define FD_POH_ROTR(x,n)  fd_uint_rotate_right( (x), (n) )
+#define FD_POH_S0(x)      (FD_POH_ROTR( (x), 2 ) ^ FD_POH_ROTR( (x),13 ) ^ FD_POH_ROTR( (x),22 ))
+#define FD_POH_S1(x)      (FD_POH_ROTR( (x), 6 ) ^ FD_POH_ROTR( (x),11 ) ^ FD_POH_ROTR( (x),25 ))
+#define FD_POH_s0(x)      (FD_POH_ROTR( (x), 7 ) ^ FD_POH_ROTR( (x),18 ) ^ ((x)>> 3))
+#define FD_POH_s1(x)      (FD_POH_ROTR( (x),17 ) ^ FD_POH_ROTR( (x),19 ) ^ ((x)>>10))
+#define FD_POH_CH(x,y,z)  (((x)&(y)) ^ ((~(x))&(z)))
+#define FD_POH_MAJ(x,y,z) (((x)&(y)) ^ ((x)&(z)) ^ ((y)&(z)))
+
+/* fd_poh_private_schedule computes wk[i] = W[i] + K[i] for the 64
+   rounds of a PoH iteration's block whose first 8 message words are
+   h[0..7]. */
+
+static inline void
+fd_poh_private_schedule( uint *       wk,
+                         uint const * h ) {
+  uint W[64];
+  for( ulong i=0UL; i< 8UL; i++ ) W[i] = h[i];
+  W[8] = FD_POH_PAD_W8;
+  for( ulong i=9UL; i<15UL; i++ ) W[i] = 0U;
+  W[15] = FD_POH_PAD_W15;
+  for( ulong i=16UL; i<64UL; i++ ) W[i] = FD_POH_s1( W[i-2] ) + W[i-7] + FD_POH_s0( W[i-15] ) + W[i-16];
+  for( ulong i=0UL; i<64UL; i++ ) wk[i] = W[i] + fd_poh_K[i];
+}
+
+fd_poh_state_t *
+fd_poh_append( fd_poh_state_t * poh,
+               ulong            n ) {
+
+  uint h[8];
+  for( ulong i=0UL; i<8UL; i++ ) h[i] = fd_uint_bswap( FD_LOAD( uint, poh->state + 4UL*i ) );
+
+  uint wk[64] __attribute__((aligned(64)));
+  while( n-- ) {
+    fd_poh_private_schedule( wk, h );
+
+    uint a = fd_poh_IV[0]; uint b = fd_poh_IV[1]; uint c = fd_poh_IV[2]; uint d = fd_poh_IV[3];
+    uint e = fd_poh_IV[4]; uint f = fd_poh_IV[5]; uint g = fd_poh_IV[6]; uint k = fd_poh_IV[7];
+
+#   define ROUND(a,b,c,d,e,f,g,h,i) do {                                     \
+      uint t1 = (h) + FD_POH_S1( e ) + FD_POH_CH( (e),(f),(g) ) + wk[(i)];   \
+      uint t2 = FD_POH_S0( a ) + FD_POH_MAJ( (a),(b),(c) );                   \
+      (d) += t1;                                                              \
+      (h)  = t1 + t2;                                                         \
+    } while(0)
+
+    for( ulong i=0UL; i<64UL; i+=8UL ) {
+      ROUND( a,b,c,d,e,f,g,k, i    ); ROUND( k,a,b,c,d,e,f,g, i+1UL );
+      ROUND( g,k,a,b,c,d,e,f, i+2UL ); ROUND( f,g,k,a,b,c,d,e, i+3UL );
+      ROUND( e,f,g,k,a,b,c,d, i+4UL ); ROUND( d,e,f,g,k,a,b,c, i+5UL );
+      ROUND( c,d,e,f,g,k,a,b, i+6UL ); ROUND( b,c,d,e,f,g,k,a, i+7UL );
+    }
+
+#   undef ROUND
+
+    h[0] = a + fd_poh_IV[0]; h[1] = b + fd_poh_IV[1]; h[2] = c + fd_poh_IV[2]; h[3] = d + fd_poh_IV[3];
+    h[4] = e + fd_poh_IV[4]; h[5] = f + fd_poh_IV[5]; h[6] = g + fd_poh_IV[6]; h[7] = k + fd_poh_IV[7];
+  }
+
+  for( ulong i=0UL; i<8UL; i++ ) FD_STORE( uint, poh->state + 4UL*i, fd_uint_bswap( h[i] ) );
+  return poh;
+}
+
+#undef FD_POH_MAJ
+#undef FD_POH_CH
+#undef FD_POH_s1
+#undef FD_POH_s0
+#undef FD_POH_S1
+#undef FD_POH_S0
+#undef FD_POH_ROTR
+
+#else
+#error "Unsupported FD_POH_APPEND_IMPL"
+#endif
+
 fd_poh_state_t *
 fd_poh_mixin( fd_poh_state_t * FD_RESTRICT poh,
               uchar const *    FD_RESTRICT mixin ) {
@@ -22,3 +194,437 @@ fd_poh_mixin( fd_poh_state_t * FD_RESTRICT poh,
   fd_sha256_fini( &sha, poh->state );
   return poh;
 }
+
+/* FD_POH_BATCH_IMPL selects the lane implementation used by
+   fd_poh_verify: 0 verifies entries one at a time with fd_poh_append, 1
+   hashes 2 chains at a time with interleaved SHA extension instruction
+   streams (a single stream is latency bound), 2 hashes 8 chains at a
+   time in the 32-bit lanes of AVX2 vectors and 3 hashes 16 chains at a
+   time in the 32-bit lanes of AVX-512 vectors.  Like fd_poh_append, 1
+   assumes FD_HAS_AVX targets support the SHA extensions.  Defaults to
+   the fastest implementation supported by the build target.
+
+   Each implementation provides FD_POH_LANE_CNT, fd_poh_lane_load (sets
+   the PoH state of lane l to a 32-byte hash), fd_poh_lane_store (the
+   reverse) and fd_poh_lane_core (does n PoH appends on every lane) for
+   a lane state of 8*FD_POH_LANE_CNT uints (64-byte aligned, layout
+   implementation defined). */
+
+#ifndef FD_POH_BATCH_IMPL
+#if FD_HAS_AVX512
+#define FD_POH_BATCH_IMPL 3
+#elif FD_HAS_AVX
+#define FD_POH_BATCH_IMPL 1
+#else
+#define FD_POH_BATCH_IMPL 0
+#endif
+#endif
+
+#if FD_POH_BATCH_IMPL==0
+
+#define FD_POH_LANE_CNT (1UL)
+
+static inline void
+fd_poh_lane_load( uint *        state,
+                  ulong         l,
+                  uchar const * hash ) {
+  (void)l;
+  fd_memcpy( state, hash, FD_SHA256_HASH_SZ );
+}
+
+static inline void
+fd_poh_lane_store( uint const * state,
+                   ulong        l,
+                   uchar *      hash ) {
+  (void)l;
+  fd_memcpy( hash, state, FD_SHA256_HASH_SZ );
+}
+
+static inline void
+fd_poh_lane_core( uint * state,
+                  ulong  n ) {
+  fd_poh_append( (fd_poh_state_t *)state, n );
+}
+
+#elif FD_POH_BATCH_IMPL==1
+
+#include <x86intrin.h>
+
+#define FD_POH_LANE_CNT (2UL)
+
+/* The state of lane l is kept as host order words at state+8*l (i.e.
+   A B C D E F G H). */
+
+static inline void
+fd_poh_lane_load( uint *        state,
+                  ulong         l,
+                  uchar const * hash ) {
+  for( ulong k=0UL; k<8UL; k++ ) state[ 8UL*l+k ] = fd_uint_bswap( FD_LOAD( uint, hash + 4UL*k ) );
+}
+
+static inline void
+fd_poh_lane_store( uint const * state,
+                   ulong        l,
+                   uchar *      hash ) {
+  for( ulong k=0UL; k<8UL; k++ ) FD_STORE( uint, hash + 4UL*k, fd_uint_bswap( state[ 8UL*l+k ] ) );
+}
+
+/* Same as the FD_POH_APPEND_IMPL 1 fd_poh_append with the instructions
+   for the lanes interleaved */
+
+__attribute__((target("sha,sse4.1")))
+static void
+fd_poh_lane_core( uint * state,
+                  ulong  n ) {
+
+  __m128i const abef_iv = _mm_setr_epi32( (int)fd_poh_IV[5], (int)fd_poh_IV[4], (int)fd_poh_IV[1], (int)fd_poh_IV[0] );
+  __m128i const cdgh_iv = _mm_setr_epi32( (int)fd_poh_IV[7], (int)fd_poh_IV[6], (int)fd_poh_IV[3], (int)fd_poh_IV[2] );
+  __m128i const pad0    = _mm_setr_epi32( (int)FD_POH_PAD_W8, 0, 0, 0 );
+  __m128i const pad1    = _mm_setr_epi32( 0, 0, 0, (int)FD_POH_PAD_W15 );
+
+  __m128i h0[ FD_POH_LANE_CNT ];
+  __m128i h1[ FD_POH_LANE_CNT ];
+  for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {
+    h0[l] = _mm_load_si128( (__m128i const *)(state+8UL*l    ) );
+    h1[l] = _mm_load_si128( (__m128i const *)(state+8UL*l+4UL) );
+  }
+
+  while( n-- ) {
+    __m128i abef[ FD_POH_LANE_CNT ];
+    __m128i cdgh[ FD_POH_LANE_CNT ];
+    __m128i w   [ FD_POH_LANE_CNT ][ 4 ];
+    for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {
+      abef[l] = abef_iv; cdgh[l] = cdgh_iv;
+      w[l][0] = h0[l]; w[l][1] = h1[l]; w[l][2] = pad0; w[l][3] = pad1;
+    }
+
+#   define QUAD_ROUND( i ) do {                                                               \
+      __m128i k = _mm_load_si128( (__m128i const *)(fd_poh_K + 4*(i)) );                      \
+      for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {                                            \
+        if( (i)>=4 ) {                                                                        \
+          __m128i x = _mm_sha256msg1_epu32( w[l][(i)&3], w[l][((i)-3)&3] );                   \
+          x = _mm_add_epi32( x, _mm_alignr_epi8( w[l][((i)-1)&3], w[l][((i)-2)&3], 4 ) );     \
+          w[l][(i)&3] = _mm_sha256msg2_epu32( x, w[l][((i)-1)&3] );                           \
+        }                                                                                     \
+        __m128i m = _mm_add_epi32( w[l][(i)&3], k );                                          \
+        cdgh[l] = _mm_sha256rnds2_epu32( cdgh[l], abef[l], m );                               \
+        abef[l] = _mm_sha256rnds2_epu32( abef[l], cdgh[l], _mm_shuffle_epi32( m, 0x0e ) );    \
+      }                                                                                       \
+    } while(0)
+
+    QUAD_ROUND(  0 ); QUAD_ROUND(  1 ); QUAD_ROUND(  2 ); QUAD_ROUND(  3 );
+    QUAD_ROUND(  4 ); QUAD_ROUND(  5 ); QUAD_ROUND(  6 ); QUAD_ROUND(  7 );
+    QUAD_ROUND(  8 ); QUAD_ROUND(  9 ); QUAD_ROUND( 10 ); QUAD_ROUND( 11 );
+    QUAD_ROUND( 12 ); QUAD_ROUND( 13 ); QUAD_ROUND( 14 ); QUAD_ROUND( 15 );
+
+#   undef QUAD_ROUND
+
+    for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {
+      __m128i abef_ = _mm_add_epi32( abef[l], abef_iv );                    /* F E B A */
+      __m128i cdgh_ = _mm_add_epi32( cdgh[l], cdgh_iv );                    /* H G D C */
+      h0[l] = _mm_shuffle_epi32( _mm_unpackhi_epi64( cdgh_, abef_ ), 0x1b ); /* A B C D */
+      h1[l] = _mm_shuffle_epi32( _mm_unpacklo_epi64( cdgh_, abef_ ), 0x1b ); /* E F G H */
+    }
+  }
+
+  for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {
+    _mm_store_si128( (__m128i *)(state+8UL*l    ), h0[l] );
+    _mm_store_si128( (__m128i *)(state+8UL*l+4UL), h1[l] );
+  }
+}
+
+#else
+
+/* The lane parallel implementations.  The round function below is
+   written once in terms of the FD_POH_LANE_* vector ops defined by each
+   implementation. */
+
+#if FD_POH_BATCH_IMPL==2
+
+#include "../../util/simd/fd_avx.h"
+
+#define FD_POH_LANE_CNT (8UL)
+
+#define FD_POH_LANE_T           wu_t
+#define FD_POH_LANE_BCAST(x)    wu_bcast( x )
+#define FD_POH_LANE_ADD(a,b)    wu_add( (a), (b) )
+#define FD_POH_LANE_XOR3(a,b,c) wu_xor( wu_xor( (a), (b) ), (c) )
+#define FD_POH_LANE_ROR(a,n)    wu_ror( (a), (n) )
+#define FD_POH_LANE_SHR(a,n)    wu_shr( (a), (n) )
+#define FD_POH_LANE_CH(x,y,z)   wu_xor( wu_and( (x), (y) ), wu_andnot( (x), (z) ) )
+#define FD_POH_LANE_MAJ(x,y,z)  wu_or( wu_and( (x), (y) ), wu_and( wu_or( (x), (y) ), (z) ) )
+#define FD_POH_LANE_LD(p)       wu_ld( (p) )
+#define FD_POH_LANE_ST(p,x)     wu_st( (p), (x) )
+
+#elif FD_POH_BATCH_IMPL==3
+
+#include <x86intrin.h>
+
+#define FD_POH_LANE_CNT (16UL)
+
+/* The ternary logic immediates are the truth tables of x^y^z, x?y:z and
+   majority(x,y,z) */
+
+#define FD_POH_LANE_T           __m512i
+#define FD_POH_LANE_BCAST(x)    _mm512_set1_epi32( (int)(x) )
+#define FD_POH_LANE_ADD(a,b)    _mm512_add_epi32( (a), (b) )
+#define FD_POH_LANE_XOR3(a,b,c) _mm512_ternarylogic_epi32( (a), (b), (c), 0x96 )
+#define FD_POH_LANE_ROR(a,n)    _mm512_ror_epi32( (a), (n) )
+#define FD_POH_LANE_SHR(a,n)    _mm512_srli_epi32( (a), (n) )
+#define FD_POH_LANE_CH(x,y,z)   _mm512_ternarylogic_epi32( (x), (y), (z), 0xca )
+#define FD_POH_LANE_MAJ(x,y,z)  _mm512_ternarylogic_epi32( (x), (y), (z), 0xe8 )
+#define FD_POH_LANE_LD(p)       _mm512_load_si512( (p) )
+#define FD_POH_LANE_ST(p,x)     _mm512_store_si512( (p), (x) )
+
+#else
+#error "Unsupported FD_POH_BATCH_IMPL"
+#endif
+
+/* The state is kept as host order words in lane major order (word k of
+   lane l is at state[k*FD_POH_LANE_CNT+l]).  As the message words of a
+   PoH iteration are the previous state words, no transposes are needed
+   between iterations. */
+
+static inline void
+fd_poh_lane_load( uint *        state,
+                  ulong         l,
+                  uchar const * hash ) {
+  for( ulong k=0UL; k<8UL; k++ ) state[ k*FD_POH_LANE_CNT+l ] = fd_uint_bswap( FD_LOAD( uint, hash + 4UL*k ) );
+}
+
+static inline void
+fd_poh_lane_store( uint const * state,
+                   ulong        l,
+                   uchar *      hash ) {
+  for( ulong k=0UL; k<8UL; k++ ) FD_STORE( uint, hash + 4UL*k, fd_uint_bswap( state[ k*FD_POH_LANE_CNT+l ] ) );
+}
+
+static void
+fd_poh_lane_core( uint * state,
+                  ulong  n ) {
+
+# define Sigma0(x) FD_POH_LANE_XOR3( FD_POH_LANE_ROR( (x), 2 ), FD_POH_LANE_ROR( (x),13 ), FD_POH_LANE_ROR( (x),22 ) )
+# define Sigma1(x) FD_POH_LANE_XOR3( FD_POH_LANE_ROR( (x), 6 ), FD_POH_LANE_ROR( (x),11 ), FD_POH_LANE_ROR( (x),25 ) )
+# define sigma0(x) FD_POH_LANE_XOR3( FD_POH_LANE_ROR( (x), 7 ), FD_POH_LANE_ROR( (x),18 ), FD_POH_LANE_SHR( (x), 3 ) )
+# define sigma1(x) FD_POH_LANE_XOR3( FD_POH_LANE_ROR( (x),17 ), FD_POH_LANE_ROR( (x),19 ), FD_POH_LANE_SHR( (x),10 ) )
+
+  FD_POH_LANE_T s[8];
+  for( ulong k=0UL; k<8UL; k++ ) s[k] = FD_POH_LANE_LD( state + k*FD_POH_LANE_CNT );
+
+  while( n-- ) {
+    FD_POH_LANE_T X[16];
+    for( ulong k=0UL; k< 8UL; k++ ) X[k] = s[k];
+    X[8] = FD_POH_LANE_BCAST( FD_POH_PAD_W8 );
+    for( ulong k=9UL; k<15UL; k++ ) X[k] = FD_POH_LANE_BCAST( 0U );
+    X[15] = FD_POH_LANE_BCAST( FD_POH_PAD_W15 );
+
+    FD_POH_LANE_T a = FD_POH_LANE_BCAST( fd_poh_IV[0] );
+    FD_POH_LANE_T b = FD_POH_LANE_BCAST( fd_poh_IV[1] );
+    FD_POH_LANE_T c = FD_POH_LANE_BCAST( fd_poh_IV[2] );
+    FD_POH_LANE_T d = FD_POH_LANE_BCAST( fd_poh_IV[3] );
+    FD_POH_LANE_T e = FD_POH_LANE_BCAST( fd_poh_IV[4] );
+    FD_POH_LANE_T f = FD_POH_LANE_BCAST( fd_poh_IV[5] );
+    FD_POH_LANE_T g = FD_POH_LANE_BCAST( fd_poh_IV[6] );
+    FD_POH_LANE_T h = FD_POH_LANE_BCAST( fd_poh_IV[7] );
+
+    for( ulong i=0UL; i<64UL; i++ ) {
+      if( i>=16UL ) {
+        FD_POH_LANE_T s0 = sigma0( X[(i+ 1UL) & 15UL] );
+        FD_POH_LANE_T s1 = sigma1( X[(i+14UL) & 15UL] );
+        X[i & 15UL] = FD_POH_LANE_ADD( FD_POH_LANE_ADD( X[i & 15UL], X[(i+9UL) & 15UL] ), FD_POH_LANE_ADD( s0, s1 ) );
+      }
+      FD_POH_LANE_T T1 = FD_POH_LANE_ADD( FD_POH_LANE_ADD( FD_POH_LANE_ADD( h, Sigma1( e ) ), FD_POH_LANE_CH( e, f, g ) ),
+                                          FD_POH_LANE_ADD( X[i & 15UL], FD_POH_LANE_BCAST( fd_poh_K[i] ) ) );
+      FD_POH_LANE_T T2 = FD_POH_LANE_ADD( Sigma0( a ), FD_POH_LANE_MAJ( a, b, c ) );
+      h = g;
+      g = f;
+      f = e;
+      e = FD_POH_LANE_ADD( d, T1 );
+      d = c;
+      c = b;
+      b = a;
+      a = FD_POH_LANE_ADD( T1, T2 );
+    }
+
+    s[0] = FD_POH_LANE_ADD( a, FD_POH_LANE_BCAST( fd_poh_IV[0] ) );
+    s[1] = FD_POH_LANE_ADD( b, FD_POH_LANE_BCAST( fd_poh_IV[1] ) );
+    s[2] = FD_POH_LANE_ADD( c, FD_POH_LANE_BCAST( fd_poh_IV[2] ) );
+    s[3] = FD_POH_LANE_ADD( d, FD_POH_LANE_BCAST( fd_poh_IV[3] ) );
+    s[4] = FD_POH_LANE_ADD( e, FD_POH_LANE_BCAST( fd_poh_IV[4] ) );
+    s[5] = FD_POH_LANE_ADD( f, FD_POH_LANE_BCAST( fd_poh_IV[5] ) );
+    s[6] = FD_POH_LANE_ADD( g, FD_POH_LANE_BCAST( fd_poh_IV[6] ) );
+    s[7] = FD_POH_LANE_ADD( h, FD_POH_LANE_BCAST( fd_poh_IV[7] ) );
+  }
+
+  for( ulong k=0UL; k<8UL; k++ ) FD_POH_LANE_ST( state + k*FD_POH_LANE_CNT, s[k] );
+
+# undef Sigma0
+# undef Sigma1
+# undef sigma0
+# undef sigma1
+}
+
+#endif
+
+/* fd_poh_entry_check returns 1 if entry e, whose PoH state after all
+   but its mixin (if any) is poh, ends on its claimed hash and 0
+   otherwise.  Clobbers poh. */
+
+static inline int
+fd_poh_entry_check( fd_poh_entry_t const * e,
+                    fd_poh_state_t *       poh ) {
+  if( e->has_mixin ) fd_poh_mixin( poh, e->mixin );
+  return !memcmp( poh->state, e->hash, FD_SHA256_HASH_SZ );
+}
+
+ulong
+fd_poh_verify( uchar const *          start,
+               fd_poh_entry_t const * entry,
+               ulong                  entry_cnt ) {
+
+  /* Each lane works through the appends of one entry at a time.  When a
+     lane finishes its entry, the entry is checked and the lane is
+     restarted on the next entry not yet started.  Lanes thus stay busy
+     even when entry hash counts are wildly different.  Idle lanes (at
+     the end) hash garbage and their results are ignored.  Once a
+     mismatch is found, entries after it are not started (or are
+     abandoned) as they can't change the result. */
+
+  uint  state[ 8UL*FD_POH_LANE_CNT ] __attribute__((aligned(64)));
+  ulong rem  [ FD_POH_LANE_CNT ]; /* Appends left for the lane's entry, 0 if lane idle */
+  ulong idx  [ FD_POH_LANE_CNT ]; /* Entry verified by the lane */
+
+  fd_memset( state, 0, sizeof(state) );
+  for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) rem[l] = 0UL;
+
+  ulong nxt  = 0UL;       /* Next entry to start */
+  ulong bad  = entry_cnt; /* First mismatching entry found so far */
+  ulong busy = 0UL;       /* Number of non-idle lanes */
+
+  for(;;) {
+
+    /* Start entries on idle lanes.  Entries that need no appends are
+       checked right away. */
+
+    for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {
+      while( (!rem[l]) & (nxt<bad) ) {
+        ulong                  i    = nxt++;
+        fd_poh_entry_t const * e    = entry + i;
+        uchar const *          prev = i ? entry[i-1UL].hash : start;
+        ulong                  r    = e->hashcnt - (ulong)(e->has_mixin && e->hashcnt);
+        if( FD_UNLIKELY( !r ) ) {
+          fd_poh_state_t poh;
+          fd_memcpy( poh.state, prev, FD_SHA256_HASH_SZ );
+          if( FD_UNLIKELY( !fd_poh_entry_check( e, &poh ) ) ) bad = i;
+          continue;
+        }
+        fd_poh_lane_load( state, l, prev );
+        rem[l] = r;
+        idx[l] = i;
+        busy++;
+      }
+    }
+
+    if( FD_UNLIKELY( !busy ) ) break;
+
+    /* Advance all lanes until the next one finishes */
+
+    ulong n = ULONG_MAX;
+    for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) if( rem[l] ) n = fd_ulong_min( n, rem[l] );
+
+    fd_poh_lane_core( state, n );
+
+    for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ ) {
+      if( !rem[l] ) continue;
+      rem[l] -= n;
+      if( rem[l] ) continue;
+      busy--;
+      fd_poh_state_t poh;
+      fd_poh_lane_store( state, l, poh.state );
+      if( FD_UNLIKELY( !fd_poh_entry_check( entry + idx[l], &poh ) ) ) bad = fd_ulong_min( bad, idx[l] );
+    }
+
+    /* Abandon entries after a mismatch */
+
+    for( ulong l=0UL; l<FD_POH_LANE_CNT; l++ )
+      if( FD_UNLIKELY( rem[l] && idx[l]>bad ) ) { rem[l] = 0UL; busy--; }
+  }
+
+  return bad;
+}
+
+/* fd_poh_verify_task_t describes a range of entries verified by a tile
+   for fd_poh_verify_tiles. */
+
+struct fd_poh_verify_task {
+  uchar const *          start;
+  fd_poh_entry_t const * entry;
+  ulong                  entry_cnt;
+  ulong                  res;
+};
+
+typedef struct fd_poh_verify_task fd_poh_verify_task_t;
+
+static int
+fd_poh_verify_tile_main( int     argc,
+                         char ** argv ) {
+  (void)argc;
+  fd_poh_verify_task_t * task = (fd_poh_verify_task_t *)fd_type_pun( argv );
+  task->res = fd_poh_verify( task->start, task->entry, task->entry_cnt );
+  return 0;
+}
+
+ulong
+fd_poh_verify_tiles( uchar const *          start,
+                     fd_poh_entry_t const * entry,
+                     ulong                  entry_cnt,
+                     ulong                  tile_idx0,
+                     ulong                  tile_idx1 ) {
+
+  ulong tile_cnt = fd_ulong_if( tile_idx1>tile_idx0, tile_idx1-tile_idx0, 0UL );
+  ulong task_cnt = fd_ulong_min( tile_cnt, FD_TILE_MAX-1UL ) + 1UL; /* Caller's range is the last one */
+
+  if( FD_UNLIKELY( (task_cnt==1UL) | (entry_cnt<2UL) ) ) return fd_poh_verify( start, entry, entry_cnt );
+
+  /* Split the entries into task_cnt ranges of roughly the same number
+     of appends (each entry is counted as at least 1 append as every
+     entry has some fixed overhead).  Ranges can be empty. */
+
+  ulong tot = 0UL;
+  for( ulong i=0UL; i<entry_cnt; i++ ) tot += fd_ulong_max( entry[i].hashcnt, 1UL );
+
+  fd_poh_verify_task_t task[ FD_TILE_MAX ];
+
+  ulong i   = 0UL;
+  ulong cum = 0UL;
+  for( ulong t=0UL; t<task_cnt; t++ ) {
+    ulong i0     = i;
+    ulong thresh = (tot/task_cnt)*(t+1UL) + ((tot%task_cnt)*(t+1UL))/task_cnt; /* floor(tot*(t+1)/task_cnt) without overflow */
+    while( (i<entry_cnt) & (cum<thresh) ) cum += fd_ulong_max( entry[i++].hashcnt, 1UL );
+    if( t==task_cnt-1UL ) i = entry_cnt;
+    task[t].start     = i0 ? entry[i0-1UL].hash : start;
+    task[t].entry     = entry + i0;
+    task[t].entry_cnt = i - i0;
+    task[t].res       = 0UL;
+  }
+
+  /* Dispatch all but the last range to the tiles (ranges that can't be
+     dispatched are done by the caller) and do the last range here. */
+
+  fd_tile_exec_t * exec[ FD_TILE_MAX ];
+  for( ulong t=0UL; t<task_cnt-1UL; t++ ) {
+    exec[t] = task[t].entry_cnt ? fd_tile_exec_new( tile_idx0+t, fd_poh_verify_tile_main, 0, (char **)fd_type_pun( task+t ) )
+                                : NULL;
+    if( FD_UNLIKELY( !exec[t] ) ) fd_poh_verify_tile_main( 0, (char **)fd_type_pun( task+t ) );
+  }
+
+  fd_poh_verify_tile_main( 0, (char **)fd_type_pun( task+task_cnt-1UL ) );
+
+  for( ulong t=0UL; t<task_cnt-1UL; t++ ) if( exec[t] ) fd_tile_exec_delete( exec[t], NULL );
+
+  /* The first mismatch is in the first range with a mismatch */
+
+  for( ulong t=0UL; t<task_cnt; t++ )
+    if( FD_UNLIKELY( task[t].res<task[t].entry_cnt ) ) return (ulong)(task[t].entry - entry) + task[t].res;
+  return entry_cnt;
+}
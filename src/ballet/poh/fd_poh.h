@@ -13,6 +13,23 @@ struct __attribute__((aligned(32))) fd_poh_state {
 
 typedef struct fd_poh_state fd_poh_state_t;
 
+/* A fd_poh_entry_t describes the PoH part of a ledger entry: the entry
+   advances the PoH state hashcnt times (num_hashes) and, if has_mixin,
+   the last of those is a mixin of mixin (the hash of the entry's
+   transactions) instead of a plain append.  hash is the PoH state the
+   entry claims to end on.  An entry with hashcnt 0 and no mixin leaves
+   the PoH state unchanged and an entry with hashcnt 0 and a mixin is
+   treated as hashcnt 1 (matching the Solana reference). */
+
+struct fd_poh_entry {
+  ulong hashcnt;
+  int   has_mixin;
+  uchar mixin[ FD_SHA256_HASH_SZ ];
+  uchar hash [ FD_SHA256_HASH_SZ ];
+};
+
+typedef struct fd_poh_entry fd_poh_entry_t;
+
 FD_PROTOTYPES_BEGIN
 
 /* fd_poh_append performs n recursive hash operations. */
@@ -27,6 +44,37 @@ fd_poh_state_t *
 fd_poh_mixin( fd_poh_state_t * FD_RESTRICT poh,
               uchar const *    FD_RESTRICT mixin );
 
+/* fd_poh_verify verifies the PoH chain of entry_cnt consecutive
+   entries (e.g. a slot's entries) starting from the 32-byte PoH state
+   start (i.e. entry i starts from entry[i-1].hash or from start if i is
+   0).  Returns the index of the first entry whose hash doesn't match its
+   claimed hash and entry_cnt if all entries match.
+
+   As every entry starts from a claimed hash, the entries are verified
+   independently, several at a time in the lanes of a multi-buffer
+   SHA-256 kernel (see FD_POH_BATCH_IMPL in fd_poh.c).  Verifying a slot
+   is thus much faster than recomputing its chain sequentially.
+
+   fd_poh_verify_tiles is the same but additionally splits the entries
+   into ranges of roughly equal hash counts, one for the caller and one
+   for each of the tiles [tile_idx0,tile_idx1), and verifies the ranges
+   in parallel.  The tiles are assumed to be idle and the caller blocks
+   until all ranges are done (ranges whose tile can't be dispatched to
+   are verified by the caller).  Typically called from tile 0 with tile
+   range [1,fd_tile_cnt()). */
+
+ulong
+fd_poh_verify( uchar const *          start,
+               fd_poh_entry_t const * entry,
+               ulong                  entry_cnt );
+
+ulong
+fd_poh_verify_tiles( uchar const *          start,
+                     fd_poh_entry_t const * entry,
+                     ulong                  entry_cnt,
+                     ulong                  tile_idx0,
+                     ulong                  tile_idx1 );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_poh_fd_poh_h */
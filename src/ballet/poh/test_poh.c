@@ -47,6 +47,25 @@ test_poh_append_one( void ) {
   }
 }
 
+/* Ensure that chains of fd_poh_append of random lengths match the
+   simple hashing API. */
+static void
+test_poh_append_chain( fd_rng_t * rng ) {
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    fd_poh_state_t poh;
+    for( ulong i=0UL; i<FD_SHA256_HASH_SZ; i++ ) poh.state[i] = fd_rng_uchar( rng );
+
+    uchar expected[FD_SHA256_HASH_SZ];
+    fd_memcpy( expected, poh.state, FD_SHA256_HASH_SZ );
+
+    ulong n = fd_rng_ulong_roll( rng, 64UL );
+    fd_poh_append( &poh, n );
+    for( ulong i=0UL; i<n; i++ ) fd_sha256_hash( expected, FD_SHA256_HASH_SZ, expected );
+
+    FD_TEST( !memcmp( poh.state, expected, FD_SHA256_HASH_SZ ) );
+  }
+}
+
 /* Ensure that fd_poh_mixin matches the simple hashing API. */
 static void
 test_poh_mixin( void ) {
@@ -187,6 +206,125 @@ bench_poh_sequential( void ) {
   ulong hashes = iter*batch_sz;
   double secs = (double)dt / 1e9;
   FD_LOG_NOTICE(( "PoH sequential: ~%.3f MH/s", ((double)hashes/secs)/1e6 ));
+
+  /* for reference, the same chain with the generic hashing API */
+  dt = fd_log_wallclock();
+  for( ulong rem=hashes/8UL; rem; rem-- ) fd_sha256_hash( poh.state, FD_SHA256_HASH_SZ, poh.state );
+  dt = fd_log_wallclock() - dt;
+
+  secs = (double)dt / 1e9;
+  FD_LOG_NOTICE(( "PoH sequential (fd_sha256_hash): ~%.3f MH/s", ((double)(hashes/8UL)/secs)/1e6 ));
+}
+
+/* test_poh_make_entries fills entry[0,entry_cnt) with a valid chain of
+   random entries (with up to hashcnt_max hashes each) starting from
+   start. */
+
+static void
+test_poh_make_entries( fd_rng_t *       rng,
+                       uchar const *    start,
+                       fd_poh_entry_t * entry,
+                       ulong            entry_cnt,
+                       ulong            hashcnt_max ) {
+  fd_poh_state_t poh;
+  fd_memcpy( poh.state, start, FD_SHA256_HASH_SZ );
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    fd_poh_entry_t * e = entry + i;
+    e->hashcnt   = fd_rng_ulong_roll( rng, hashcnt_max+1UL );
+    e->has_mixin = (int)fd_rng_uint_roll( rng, 2U );
+    for( ulong j=0UL; j<FD_SHA256_HASH_SZ; j++ ) e->mixin[j] = fd_rng_uchar( rng );
+    if( e->has_mixin ) {
+      fd_poh_append( &poh, fd_ulong_max( e->hashcnt, 1UL ) - 1UL );
+      fd_poh_mixin ( &poh, e->mixin );
+    } else {
+      fd_poh_append( &poh, e->hashcnt );
+    }
+    fd_memcpy( e->hash, poh.state, FD_SHA256_HASH_SZ );
+  }
+}
+
+#define TEST_ENTRY_MAX (128UL)
+
+static fd_poh_entry_t test_entry[ TEST_ENTRY_MAX ];
+
+/* Ensure fd_poh_verify{,_tiles} accept valid chains and report the
+   first mismatching entry of corrupted ones. */
+
+static void
+test_poh_verify( fd_rng_t * rng ) {
+  ulong tile_cnt = fd_tile_cnt();
+  for( ulong iter=0UL; iter<200UL; iter++ ) {
+    uchar start[FD_SHA256_HASH_SZ];
+    for( ulong i=0UL; i<FD_SHA256_HASH_SZ; i++ ) start[i] = fd_rng_uchar( rng );
+
+    static ulong const hashcnt_max[4] = { 0UL, 1UL, 8UL, 300UL };
+    ulong entry_cnt = fd_rng_ulong_roll( rng, TEST_ENTRY_MAX+1UL );
+    test_poh_make_entries( rng, start, test_entry, entry_cnt, hashcnt_max[ iter & 3UL ] );
+
+    FD_TEST( fd_poh_verify      ( start, test_entry, entry_cnt              )==entry_cnt );
+    FD_TEST( fd_poh_verify_tiles( start, test_entry, entry_cnt, 1UL, tile_cnt )==entry_cnt );
+    if( !entry_cnt ) continue;
+
+    /* Corrupt a claimed hash, a mixin or a hash count (entries after a
+       corrupted one start from a wrong hash so will mismatch too).  The
+       hash count of an entry with hashcnt 0 and a mixin is changed to 2
+       as 1 is equivalent. */
+
+    ulong j = fd_rng_ulong_roll( rng, entry_cnt );
+    fd_poh_entry_t save = test_entry[j];
+    switch( fd_rng_uint_roll( rng, 3U ) ) {
+    case 0U: test_entry[j].hash[ fd_rng_ulong_roll( rng, FD_SHA256_HASH_SZ ) ] ^= (uchar)1; break;
+    case 1U: test_entry[j].has_mixin = !test_entry[j].has_mixin;                           break;
+    default: test_entry[j].hashcnt  += (test_entry[j].has_mixin & !test_entry[j].hashcnt) ? 2UL : 1UL; break;
+    }
+
+    FD_TEST( fd_poh_verify      ( start, test_entry, entry_cnt              )==j );
+    FD_TEST( fd_poh_verify_tiles( start, test_entry, entry_cnt, 1UL, tile_cnt )==j );
+
+    /* A later mismatch doesn't change the result */
+
+    ulong k = j + fd_rng_ulong_roll( rng, entry_cnt-j );
+    test_entry[k].hash[0] ^= (uchar)0x80;
+    FD_TEST( fd_poh_verify      ( start, test_entry, entry_cnt              )==j );
+    FD_TEST( fd_poh_verify_tiles( start, test_entry, entry_cnt, 1UL, tile_cnt )==j );
+    test_entry[k].hash[0] ^= (uchar)0x80;
+
+    test_entry[j] = save;
+    FD_TEST( fd_poh_verify( start, test_entry, entry_cnt )==entry_cnt );
+  }
+}
+
+/* bench_poh_verify verifies a slot sized chain (800000 hashes, as in
+   mainnet block 0) split into entries. */
+
+static void
+bench_poh_verify( fd_rng_t * rng ) {
+  ulong entry_cnt = TEST_ENTRY_MAX;
+  ulong hashcnt   = 800000UL / entry_cnt;
+
+  uchar start[FD_SHA256_HASH_SZ] = {0};
+  fd_poh_state_t poh;
+  fd_memcpy( poh.state, start, FD_SHA256_HASH_SZ );
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    test_entry[i].hashcnt   = hashcnt;
+    test_entry[i].has_mixin = (int)fd_rng_uint_roll( rng, 2U );
+    for( ulong j=0UL; j<FD_SHA256_HASH_SZ; j++ ) test_entry[i].mixin[j] = fd_rng_uchar( rng );
+    fd_poh_append( &poh, hashcnt - (ulong)test_entry[i].has_mixin );
+    if( test_entry[i].has_mixin ) fd_poh_mixin( &poh, test_entry[i].mixin );
+    fd_memcpy( test_entry[i].hash, poh.state, FD_SHA256_HASH_SZ );
+  }
+
+  ulong iter = 10UL;
+  long  dt   = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) FD_TEST( fd_poh_verify( start, test_entry, entry_cnt )==entry_cnt );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "PoH verify: ~%.3f MH/s", ((double)(iter*entry_cnt*hashcnt)/((double)dt/1e9))/1e6 ));
+
+  ulong tile_cnt = fd_tile_cnt();
+  dt = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) FD_TEST( fd_poh_verify_tiles( start, test_entry, entry_cnt, 1UL, tile_cnt )==entry_cnt );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "PoH verify (%lu tiles): ~%.3f MH/s", tile_cnt, ((double)(iter*entry_cnt*hashcnt)/((double)dt/1e9))/1e6 ));
 }
 
 int main( int argc,
@@ -196,6 +334,10 @@ int main( int argc,
   test_poh_append_nop();
   test_poh_append_one();
 
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  test_poh_append_chain( rng );
+  test_poh_verify( rng );
+
   test_poh_mixin();
 
   for( fd_poh_test_vector_t const * v = poh_test_vectors; v->name; v++ ) {
@@ -203,6 +345,9 @@ int main( int argc,
   }
 
   bench_poh_sequential();
+  bench_poh_verify( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
@@ -0,0 +1,77 @@
+#include "../fd_ballet.h"
+
+/* bench_reedsol benchmarks fd_reedsol_encode and fd_reedsol_recover on
+   FEC sets of shred sized blobs.  Throughput is reported in data shred
+   bytes per second (i.e. the size of the payload protected by the set
+   per unit time).  Recovery is benchmarked with all the data shreds
+   erased (the worst case, as much work as encoding with a different
+   set of points) and with a single data shred erased (the common case
+   with low packet loss). */
+
+#define SHRED_SZ (1228UL)
+
+static uchar mem[ FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX ][ SHRED_SZ ];
+
+static void
+bench( ulong d,
+       ulong p,
+       ulong iter_max ) {
+  ulong n = d+p;
+
+  uchar *       shred [ FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX ];
+  uchar         erased[ FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX ];
+  uchar const * data  [ FD_REEDSOL_DATA_SHREDS_MAX ];
+  for( ulong j=0UL; j<n; j++ ) shred[j] = mem[j];
+  for( ulong k=0UL; k<d; k++ ) data[k]  = mem[k];
+
+  /* Encode */
+
+  long dt_enc = 0L;
+  for( ulong iter=0UL; iter<iter_max+1UL; iter++ ) { /* first iteration is warmup */
+    long dt = -fd_log_wallclock();
+    fd_reedsol_encode( SHRED_SZ, data, d, shred+d, p );
+    dt += fd_log_wallclock();
+    if( iter ) dt_enc += dt;
+  }
+
+  /* Recover with min(d,p) data shreds erased and with one erased */
+
+  long dt_rec[2] = { 0L, 0L };
+  for( ulong r=0UL; r<2UL; r++ ) {
+    ulong erase_cnt = r ? 1UL : fd_ulong_min( d, p );
+    for( ulong j=0UL; j<n; j++ ) erased[j] = (uchar)(j<erase_cnt);
+    for( ulong iter=0UL; iter<iter_max+1UL; iter++ ) {
+      long dt = -fd_log_wallclock();
+      int err = fd_reedsol_recover( SHRED_SZ, shred, erased, d, p );
+      dt += fd_log_wallclock();
+      if( FD_UNLIKELY( err!=FD_REEDSOL_SUCCESS ) ) FD_LOG_ERR(( "FAIL" ));
+      if( iter ) dt_rec[r] += dt;
+    }
+  }
+
+  double data_tot = (double)(iter_max*d*SHRED_SZ);
+  FD_LOG_NOTICE(( "%2lu:%-2lu shreds: encode %7.3f GB/s (%7.3f us/set), recover %2lu erased %7.3f GB/s, recover 1 erased %7.3f GB/s",
+                  d, p,
+                  data_tot / (double)dt_enc, 1e-3*(double)dt_enc/(double)iter_max,
+                  fd_ulong_min( d, p ), data_tot / (double)dt_rec[0],
+                  data_tot / (double)dt_rec[1] ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong iter_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-max", NULL, 2000UL );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong j=0UL; j<FD_REEDSOL_DATA_SHREDS_MAX; j++ ) for( ulong b=0UL; b<SHRED_SZ; b++ ) mem[j][b] = fd_rng_uchar( rng );
+
+  static ulong const cfg[][2] = { { 1UL, 1UL }, { 4UL, 4UL }, { 8UL, 8UL }, { 16UL, 16UL }, { 32UL, 32UL }, { 32UL, 8UL }, { 67UL, 67UL } };
+  for( ulong i=0UL; i<sizeof(cfg)/sizeof(cfg[0]); i++ ) bench( cfg[i][0], cfg[i][1], iter_max );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,294 @@
+#include "fd_reedsol.h"
+
+#include "table/fd_reedsol_gf_tbl.c"
+
+/* FD_REEDSOL_IMPL selects the implementation of the GF(2^8) dense
+   matrix-vector product at the heart of encoding and recovery: 0 is
+   portable and does one byte at a time with the nibble tables, 1 does
+   32 bytes at a time with AVX2 PSHUFB nibble lookups, 2 does 64 bytes
+   at a time with AVX-512 PSHUFB nibble lookups and 3 does 64 bytes at
+   a time with AVX-512 GF2P8AFFINEQB (a single instruction per multiply
+   by a constant instead of two lookups and a xor).  Defaults to the
+   fastest implementation supported by the build target (GFNI is not
+   implied by AVX-512, so 3 is only used if the compiler targets it). */
+
+#ifndef FD_REEDSOL_IMPL
+#if FD_HAS_AVX512 && defined(__GFNI__)
+#define FD_REEDSOL_IMPL 3
+#elif FD_HAS_AVX512
+#define FD_REEDSOL_IMPL 2
+#elif FD_HAS_AVX
+#define FD_REEDSOL_IMPL 1
+#else
+#define FD_REEDSOL_IMPL 0
+#endif
+#endif
+
+/* FD_REEDSOL_PRIVATE_{SRC,DST}_MAX bound the number of points in an
+   interpolation (sources) and the number of points at which it is
+   evaluated (destinations).  Since recovery needs data_shred_cnt
+   sources, there are at most parity_shred_cnt destinations. */
+
+#define FD_REEDSOL_PRIVATE_SRC_MAX FD_REEDSOL_DATA_SHREDS_MAX
+#define FD_REEDSOL_PRIVATE_DST_MAX FD_REEDSOL_PARITY_SHREDS_MAX
+
+/* fd_reedsol_private_coef computes the matrix C such that evaluating
+   at the points dst_x[i] for i in [0,dst_cnt) the polynomial of degree
+   less than src_cnt that takes the value src_k at the point src_x[k]
+   for k in [0,src_cnt) is dst_i = sum_k C[i][k] src_k.  In Lagrange
+   form, with N(x) = prod_j (x - src_x[j]) and w_k = 1 / prod_{j!=k}
+   (src_x[k] - src_x[j]):
+
+     C[i][k] = w_k N(dst_x[i]) / (dst_x[i] - src_x[k])
+
+   (in GF(2^8), - is ^).  The points must be distinct.  This is done in
+   the log domain such that it is just table lookups and adds, O(
+   src_cnt (src_cnt + dst_cnt) ) in total (negligible next to the
+   O( src_cnt dst_cnt shred_sz ) product). */
+
+static void
+fd_reedsol_private_coef( uchar         coef[ FD_REEDSOL_PRIVATE_DST_MAX ][ FD_REEDSOL_PRIVATE_SRC_MAX ],
+                         uchar const * src_x,
+                         ulong         src_cnt,
+                         uchar const * dst_x,
+                         ulong         dst_cnt ) {
+  ulong log_w[ FD_REEDSOL_PRIVATE_SRC_MAX ];
+  for( ulong k=0UL; k<src_cnt; k++ ) {
+    ulong s = 0UL;
+    for( ulong j=0UL; j<src_cnt; j++ ) if( j!=k ) s += (ulong)fd_reedsol_gf_log[ src_x[k] ^ src_x[j] ];
+    log_w[k] = 255UL - (s % 255UL); /* in [1,255], fine as an exponent */
+  }
+
+  for( ulong i=0UL; i<dst_cnt; i++ ) {
+    ulong log_d[ FD_REEDSOL_PRIVATE_SRC_MAX ];
+    ulong log_n = 0UL;
+    for( ulong k=0UL; k<src_cnt; k++ ) {
+      log_d[k] = (ulong)fd_reedsol_gf_log[ dst_x[i] ^ src_x[k] ];
+      log_n   += log_d[k];
+    }
+    log_n %= 255UL;
+    for( ulong k=0UL; k<src_cnt; k++ )
+      coef[i][k] = fd_reedsol_gf_exp[ (log_w[k] + log_n + 255UL - log_d[k]) % 255UL ];
+  }
+}
+
+/* fd_reedsol_private_mul_scalar computes dst[i][b] = sum_k coef[i][k]
+   src[k][b] for i in [0,dst_cnt) and b in [0,sz) one byte at a
+   time.  This is the portable implementation and handles the shreds
+   too short for the vector implementations. */
+
+static void
+fd_reedsol_private_mul_scalar( ulong                 sz,
+                               uchar const * const * src,
+                               ulong                 src_cnt,
+                               uchar * const *       dst,
+                               ulong                 dst_cnt,
+                               uchar                 coef[ FD_REEDSOL_PRIVATE_DST_MAX ][ FD_REEDSOL_PRIVATE_SRC_MAX ] ) {
+  for( ulong i=0UL; i<dst_cnt; i++ ) {
+    uchar * d = dst[i];
+    for( ulong b=0UL; b<sz; b++ ) d[b] = (uchar)0;
+    for( ulong k=0UL; k<src_cnt; k++ ) {
+      uchar const * tbl = fd_reedsol_gf_nib[ coef[i][k] ];
+      uchar const * s   = src[k];
+      for( ulong b=0UL; b<sz; b++ ) { uint x = (uint)s[b]; d[b] ^= (uchar)(tbl[ x & 15U ] ^ tbl[ 16U + (x>>4) ]); }
+    }
+  }
+}
+
+#if FD_REEDSOL_IMPL==0
+
+static void
+fd_reedsol_private_mul( ulong                 sz,
+                        uchar const * const * src,
+                        ulong                 src_cnt,
+                        uchar * const *       dst,
+                        ulong                 dst_cnt,
+                        uchar                 coef[ FD_REEDSOL_PRIVATE_DST_MAX ][ FD_REEDSOL_PRIVATE_SRC_MAX ] ) {
+  fd_reedsol_private_mul_scalar( sz, src, src_cnt, dst, dst_cnt, coef );
+}
+
+#else
+
+/* The vector implementations.  The product below is written once in
+   terms of the REEDSOL_VEC_* ops defined by each implementation.
+   REEDSOL_VEC_MUL(c,x) multiplies each byte of x by the constant c.
+   For the PSHUFB variants, the nibble split of x is common to all the
+   constants x is multiplied by and the compiler hoists it. */
+
+#include <x86intrin.h>
+
+#if FD_REEDSOL_IMPL==1
+
+#define REEDSOL_VEC_SZ       (32UL)
+#define REEDSOL_VEC_T        __m256i
+#define REEDSOL_VEC_ZERO()   _mm256_setzero_si256()
+#define REEDSOL_VEC_LDU(p)   _mm256_loadu_si256( (__m256i const *)(p) )
+#define REEDSOL_VEC_STU(p,x) _mm256_storeu_si256( (__m256i *)(p), (x) )
+#define REEDSOL_VEC_XOR(a,b) _mm256_xor_si256( (a), (b) )
+#define REEDSOL_VEC_TBL(p)   _mm256_broadcastsi128_si256( _mm_load_si128( (__m128i const *)(p) ) )
+#define REEDSOL_VEC_MUL(c,x)                                                                                       \
+  _mm256_xor_si256( _mm256_shuffle_epi8( REEDSOL_VEC_TBL( fd_reedsol_gf_nib[ (c) ]        ),                       \
+                                         _mm256_and_si256( (x), _mm256_set1_epi8( 0x0f ) ) ),                      \
+                    _mm256_shuffle_epi8( REEDSOL_VEC_TBL( fd_reedsol_gf_nib[ (c) ] + 16UL ),                       \
+                                         _mm256_and_si256( _mm256_srli_epi16( (x), 4 ), _mm256_set1_epi8( 0x0f ) ) ) )
+
+#elif FD_REEDSOL_IMPL==2
+
+#define REEDSOL_VEC_SZ       (64UL)
+#define REEDSOL_VEC_T        __m512i
+#define REEDSOL_VEC_ZERO()   _mm512_setzero_si512()
+#define REEDSOL_VEC_LDU(p)   _mm512_loadu_si512( (void const *)(p) )
+#define REEDSOL_VEC_STU(p,x) _mm512_storeu_si512( (void *)(p), (x) )
+#define REEDSOL_VEC_XOR(a,b) _mm512_xor_si512( (a), (b) )
+#define REEDSOL_VEC_TBL(p)   _mm512_broadcast_i32x4( _mm_load_si128( (__m128i const *)(p) ) )
+#define REEDSOL_VEC_MUL(c,x)                                                                                       \
+  _mm512_xor_si512( _mm512_shuffle_epi8( REEDSOL_VEC_TBL( fd_reedsol_gf_nib[ (c) ]        ),                       \
+                                         _mm512_and_si512( (x), _mm512_set1_epi8( 0x0f ) ) ),                      \
+                    _mm512_shuffle_epi8( REEDSOL_VEC_TBL( fd_reedsol_gf_nib[ (c) ] + 16UL ),                       \
+                                         _mm512_and_si512( _mm512_srli_epi16( (x), 4 ), _mm512_set1_epi8( 0x0f ) ) ) )
+
+#elif FD_REEDSOL_IMPL==3
+
+#define REEDSOL_VEC_SZ       (64UL)
+#define REEDSOL_VEC_T        __m512i
+#define REEDSOL_VEC_ZERO()   _mm512_setzero_si512()
+#define REEDSOL_VEC_LDU(p)   _mm512_loadu_si512( (void const *)(p) )
+#define REEDSOL_VEC_STU(p,x) _mm512_storeu_si512( (void *)(p), (x) )
+#define REEDSOL_VEC_XOR(a,b) _mm512_xor_si512( (a), (b) )
+#define REEDSOL_VEC_MUL(c,x) _mm512_gf2p8affine_epi64_epi8( (x), _mm512_set1_epi64( (long)fd_reedsol_gf_aff[ (c) ] ), 0 )
+
+#else
+#error "Unsupported FD_REEDSOL_IMPL"
+#endif
+
+/* REEDSOL_GRP is the number of destinations computed per pass over the
+   sources.  Each source vector load (and nibble split) is amortized
+   over this many destinations while keeping everything in registers
+   (more accumulators didn't help in practice, even with AVX-512's
+   larger register file). */
+
+#define REEDSOL_GRP (4UL)
+
+/* fd_reedsol_private_mul_grp computes grp_cnt (a compile time constant
+   after inlining) destinations a vector at a time.  A ragged end is
+   handled by recomputing the last full vector of the shreds (the
+   destinations don't overlap the sources, so recomputing bytes is
+   harmless). */
+
+static inline __attribute__((always_inline)) void
+fd_reedsol_private_mul_grp( ulong                 sz,
+                            uchar const * const * src,
+                            ulong                 src_cnt,
+                            uchar * const *       dst,
+                            uchar                 coef[][ FD_REEDSOL_PRIVATE_SRC_MAX ],
+                            ulong                 grp_cnt ) {
+  ulong off = 0UL;
+  for(;;) {
+    REEDSOL_VEC_T acc[ REEDSOL_GRP ];
+    for( ulong t=0UL; t<grp_cnt; t++ ) acc[t] = REEDSOL_VEC_ZERO();
+
+    for( ulong k=0UL; k<src_cnt; k++ ) {
+      REEDSOL_VEC_T x = REEDSOL_VEC_LDU( src[k] + off );
+      for( ulong t=0UL; t<grp_cnt; t++ ) acc[t] = REEDSOL_VEC_XOR( acc[t], REEDSOL_VEC_MUL( coef[t][k], x ) );
+    }
+
+    for( ulong t=0UL; t<grp_cnt; t++ ) REEDSOL_VEC_STU( dst[t] + off, acc[t] );
+
+    if( FD_UNLIKELY( off+REEDSOL_VEC_SZ>=sz ) ) break;
+    off = fd_ulong_min( off+REEDSOL_VEC_SZ, sz-REEDSOL_VEC_SZ );
+  }
+}
+
+static void
+fd_reedsol_private_mul( ulong                 sz,
+                        uchar const * const * src,
+                        ulong                 src_cnt,
+                        uchar * const *       dst,
+                        ulong                 dst_cnt,
+                        uchar                 coef[ FD_REEDSOL_PRIVATE_DST_MAX ][ FD_REEDSOL_PRIVATE_SRC_MAX ] ) {
+  if( FD_UNLIKELY( sz<REEDSOL_VEC_SZ ) ) {
+    fd_reedsol_private_mul_scalar( sz, src, src_cnt, dst, dst_cnt, coef );
+    return;
+  }
+
+  ulong i = 0UL;
+  for( ; i+REEDSOL_GRP<=dst_cnt; i+=REEDSOL_GRP ) fd_reedsol_private_mul_grp( sz, src, src_cnt, dst+i, coef+i, REEDSOL_GRP );
+  switch( dst_cnt-i ) {
+  case 3UL: fd_reedsol_private_mul_grp( sz, src, src_cnt, dst+i, coef+i, 3UL ); break;
+  case 2UL: fd_reedsol_private_mul_grp( sz, src, src_cnt, dst+i, coef+i, 2UL ); break;
+  case 1UL: fd_reedsol_private_mul_grp( sz, src, src_cnt, dst+i, coef+i, 1UL ); break;
+  default: break;
+  }
+}
+
+#undef REEDSOL_GRP
+#undef REEDSOL_VEC_MUL
+#undef REEDSOL_VEC_TBL
+#undef REEDSOL_VEC_XOR
+#undef REEDSOL_VEC_STU
+#undef REEDSOL_VEC_LDU
+#undef REEDSOL_VEC_ZERO
+#undef REEDSOL_VEC_T
+#undef REEDSOL_VEC_SZ
+
+#endif
+
+void
+fd_reedsol_encode( ulong                 shred_sz,
+                   uchar const * const * data_shred,
+                   ulong                 data_shred_cnt,
+                   uchar * const *       parity_shred,
+                   ulong                 parity_shred_cnt ) {
+  if( FD_UNLIKELY( !parity_shred_cnt ) ) return;
+
+  /* Data shred k is P(k) and parity shred i is P(data_shred_cnt+i) */
+
+  uchar src_x[ FD_REEDSOL_PRIVATE_SRC_MAX ];
+  uchar dst_x[ FD_REEDSOL_PRIVATE_DST_MAX ];
+  for( ulong k=0UL; k<data_shred_cnt;   k++ ) src_x[k] = (uchar)k;
+  for( ulong i=0UL; i<parity_shred_cnt; i++ ) dst_x[i] = (uchar)(data_shred_cnt+i);
+
+  uchar coef[ FD_REEDSOL_PRIVATE_DST_MAX ][ FD_REEDSOL_PRIVATE_SRC_MAX ];
+  fd_reedsol_private_coef( coef, src_x, data_shred_cnt, dst_x, parity_shred_cnt );
+  fd_reedsol_private_mul( shred_sz, data_shred, data_shred_cnt, parity_shred, parity_shred_cnt, coef );
+}
+
+int
+fd_reedsol_recover( ulong           shred_sz,
+                    uchar * const * shred,
+                    uchar const *   erased,
+                    ulong           data_shred_cnt,
+                    ulong           parity_shred_cnt ) {
+  ulong shred_cnt = data_shred_cnt + parity_shred_cnt;
+
+  /* Interpolate from the first data_shred_cnt available shreds and
+     evaluate at the erased ones.  Since at least data_shred_cnt shreds
+     must be available, at most parity_shred_cnt are erased. */
+
+  uchar const * src  [ FD_REEDSOL_PRIVATE_SRC_MAX ];
+  uchar *       dst  [ FD_REEDSOL_PRIVATE_DST_MAX ];
+  uchar         src_x[ FD_REEDSOL_PRIVATE_SRC_MAX ];
+  uchar         dst_x[ FD_REEDSOL_PRIVATE_DST_MAX ];
+  ulong         src_cnt = 0UL;
+  ulong         dst_cnt = 0UL;
+
+  for( ulong i=0UL; i<shred_cnt; i++ ) {
+    if( erased[i] ) {
+      if( FD_UNLIKELY( dst_cnt==parity_shred_cnt ) ) return FD_REEDSOL_ERR_PARTIAL;
+      dst  [ dst_cnt ] = shred[i];
+      dst_x[ dst_cnt ] = (uchar)i;
+      dst_cnt++;
+    } else if( src_cnt<data_shred_cnt ) {
+      src  [ src_cnt ] = shred[i];
+      src_x[ src_cnt ] = (uchar)i;
+      src_cnt++;
+    }
+  }
+
+  if( FD_UNLIKELY( !dst_cnt ) ) return FD_REEDSOL_SUCCESS;
+
+  uchar coef[ FD_REEDSOL_PRIVATE_DST_MAX ][ FD_REEDSOL_PRIVATE_SRC_MAX ];
+  fd_reedsol_private_coef( coef, src_x, src_cnt, dst_x, dst_cnt );
+  fd_reedsol_private_mul( shred_sz, src, src_cnt, dst, dst_cnt, coef );
+  return FD_REEDSOL_SUCCESS;
+}
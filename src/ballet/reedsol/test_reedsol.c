@@ -0,0 +1,162 @@
+#include "fd_reedsol.h"
+
+/* The reference implementation below follows the construction used by
+   the reed-solomon-erasure crate literally (bitwise GF(2^8) multiplies,
+   a Vandermonde matrix and a Gauss-Jordan inverse of its top block) so
+   that it is independent of the Lagrange formulation and the tables
+   used by fd_reedsol. */
+
+static uchar gf_mul_tbl[ 256 ][ 256 ];
+
+static uchar
+gf_mul_slow( uint a,
+             uint b ) {
+  uint r = 0U;
+  while( b ) {
+    if( b & 1U ) r ^= a;
+    a <<= 1;
+    if( a & 0x100U ) a ^= 0x11dU;
+    b >>= 1;
+  }
+  return (uchar)r;
+}
+
+static uchar
+gf_inv( uchar a ) {
+  for( uint b=1U; b<256U; b++ ) if( gf_mul_tbl[ a ][ b ]==(uchar)1 ) return (uchar)b;
+  FD_LOG_ERR(( "no inverse" ));
+  return (uchar)0;
+}
+
+#define N_MAX (FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX)
+
+static uchar ref_mat[ N_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+
+/* ref_matrix computes into ref_mat the (d+p) x d encoding matrix */
+
+static void
+ref_matrix( ulong d,
+            ulong p ) {
+  static uchar vdm[ N_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+  static uchar inv[ FD_REEDSOL_DATA_SHREDS_MAX ][ 2UL*FD_REEDSOL_DATA_SHREDS_MAX ];
+
+  for( ulong r=0UL; r<d+p; r++ ) {
+    uchar x = (uchar)1; /* 0^0 == 1 */
+    for( ulong c=0UL; c<d; c++ ) { vdm[r][c] = x; x = gf_mul_tbl[ x ][ r ]; }
+  }
+
+  for( ulong r=0UL; r<d; r++ ) for( ulong c=0UL; c<2UL*d; c++ ) inv[r][c] = c<d ? vdm[r][c] : (uchar)((c-d)==r);
+  for( ulong c=0UL; c<d; c++ ) {
+    ulong piv = c; while( !inv[piv][c] ) piv++;
+    for( ulong j=0UL; j<2UL*d; j++ ) { uchar t = inv[c][j]; inv[c][j] = inv[piv][j]; inv[piv][j] = t; }
+    uchar s = gf_inv( inv[c][c] );
+    for( ulong j=0UL; j<2UL*d; j++ ) inv[c][j] = gf_mul_tbl[ s ][ inv[c][j] ];
+    for( ulong r=0UL; r<d; r++ ) {
+      if( r==c || !inv[r][c] ) continue;
+      uchar f = inv[r][c];
+      for( ulong j=0UL; j<2UL*d; j++ ) inv[r][j] ^= gf_mul_tbl[ f ][ inv[c][j] ];
+    }
+  }
+
+  for( ulong r=0UL; r<d+p; r++ ) for( ulong c=0UL; c<d; c++ ) {
+    uchar s = (uchar)0;
+    for( ulong j=0UL; j<d; j++ ) s ^= gf_mul_tbl[ vdm[r][j] ][ inv[j][d+c] ];
+    ref_mat[r][c] = s;
+  }
+}
+
+#define SZ_MAX (2UL*1228UL)
+
+static uchar data_mem  [ FD_REEDSOL_DATA_SHREDS_MAX   ][ SZ_MAX+64UL ];
+static uchar parity_mem[ FD_REEDSOL_PARITY_SHREDS_MAX ][ SZ_MAX+64UL ];
+static uchar expect    [ N_MAX                        ][ SZ_MAX ];
+
+static void
+test_known_answer( void ) {
+  /* From the reed-solomon-erasure (and Backblaze JavaReedSolomon) test
+     suites: 5 data shards, 5 parity shards */
+  static uchar const data  [ 5 ][ 2 ] = { {  0,  1 }, {  4,  5 }, {  2,  3 }, {  6,  7 }, {  8,  9 } };
+  static uchar const parity[ 5 ][ 2 ] = { { 12, 13 }, { 10, 11 }, { 14, 15 }, { 90, 91 }, { 94, 95 } };
+
+  uchar         out[ 5 ][ 2 ];
+  uchar const * d  [ 5 ];
+  uchar *       p  [ 5 ];
+  for( ulong i=0UL; i<5UL; i++ ) { d[i] = data[i]; p[i] = out[i]; }
+  fd_reedsol_encode( 2UL, d, 5UL, p, 5UL );
+  FD_TEST( !memcmp( out, parity, 10UL ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  for( uint a=0U; a<256U; a++ ) for( uint b=0U; b<256U; b++ ) gf_mul_tbl[ a ][ b ] = gf_mul_slow( a, b );
+
+  test_known_answer();
+
+  ulong iter_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-max", NULL, 500UL );
+  for( ulong iter=0UL; iter<iter_max; iter++ ) {
+    ulong d  = 1UL + fd_rng_ulong_roll( rng, FD_REEDSOL_DATA_SHREDS_MAX );
+    ulong p  = fd_rng_ulong_roll( rng, FD_REEDSOL_PARITY_SHREDS_MAX+1UL );
+    ulong sz = (iter & 1UL) ? 1228UL : 1UL + fd_rng_ulong_roll( rng, SZ_MAX ); /* Shred sized and ragged */
+    ulong n  = d+p;
+
+    /* Encode unaligned shreds and compare against the reference */
+
+    uchar const * data  [ FD_REEDSOL_DATA_SHREDS_MAX   ];
+    uchar *       parity[ FD_REEDSOL_PARITY_SHREDS_MAX ];
+    for( ulong k=0UL; k<d; k++ ) {
+      uchar * m = data_mem[k] + fd_rng_ulong_roll( rng, 64UL );
+      for( ulong b=0UL; b<sz; b++ ) m[b] = fd_rng_uchar( rng );
+      data[k] = m;
+    }
+    for( ulong i=0UL; i<p; i++ ) parity[i] = parity_mem[i] + fd_rng_ulong_roll( rng, 64UL );
+
+    fd_reedsol_encode( sz, data, d, parity, p );
+
+    ref_matrix( d, p );
+    for( ulong r=0UL; r<n; r++ ) for( ulong b=0UL; b<sz; b++ ) {
+      uchar s = (uchar)0;
+      for( ulong c=0UL; c<d; c++ ) s ^= gf_mul_tbl[ ref_mat[r][c] ][ data[c][b] ];
+      expect[r][b] = s;
+    }
+    for( ulong k=0UL; k<d; k++ ) FD_TEST( !memcmp( expect[k  ], data  [k], sz ) ); /* Systematic */
+    for( ulong i=0UL; i<p; i++ ) FD_TEST( !memcmp( expect[d+i], parity[i], sz ) );
+
+    /* Erase a random subset of shreds and recover them */
+
+    uchar * shred [ N_MAX ];
+    uchar   erased[ N_MAX ];
+    for( ulong k=0UL; k<d; k++ ) shred[k  ] = (uchar *)data[k];
+    for( ulong i=0UL; i<p; i++ ) shred[d+i] = parity[i];
+
+    ulong erase_cnt = fd_rng_ulong_roll( rng, p+2UL ); /* Sometimes one too many */
+    if( !(iter & 3UL) ) erase_cnt = fd_ulong_min( p, d ); /* Sometimes all the data we can */
+    for( ulong j=0UL; j<n; j++ ) erased[j] = (uchar)0;
+    for( ulong e=0UL; e<fd_ulong_min( erase_cnt, n ); ) {
+      ulong j = (iter & 3UL) ? fd_rng_ulong_roll( rng, n ) : e;
+      if( erased[j] ) continue;
+      erased[j] = (uchar)1;
+      e++;
+    }
+    for( ulong j=0UL; j<n; j++ ) if( erased[j] ) fd_memset( shred[j], 0xa5, sz );
+
+    int err = fd_reedsol_recover( sz, shred, erased, d, p );
+    if( erase_cnt>p ) {
+      FD_TEST( err==FD_REEDSOL_ERR_PARTIAL );
+      for( ulong j=0UL; j<n; j++ ) if( erased[j] ) for( ulong b=0UL; b<sz; b++ ) FD_TEST( shred[j][b]==(uchar)0xa5 );
+    } else {
+      FD_TEST( err==FD_REEDSOL_SUCCESS );
+      for( ulong j=0UL; j<n; j++ ) FD_TEST( !memcmp( expect[j], shred[j], sz ) );
+    }
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
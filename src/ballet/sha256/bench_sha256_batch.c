@@ -0,0 +1,198 @@
+#include "../fd_ballet.h"
+
+#if FD_HAS_HOSTED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+/* bench_sha256_batch validates fd_sha256_batch_hash against NIST CAVP
+   SHA-256 message response files and then benchmarks it against
+   fd_sha256_hash for batches of messages of various sizes (e.g. 33 and
+   65 bytes are the sizes of Merkle tree leaf and branch node preimages
+   and 1232 is a transaction MTU).  Run from the repository root or use
+   --rsp to point at the response files. */
+
+#define VEC_MAX   (1024UL)
+#define ARENA_SZ  (1UL<<20)
+#define RSP_LINE_MAX  (1UL<<17)
+#define BATCH_MAX (256UL)
+#define SZ_MAX    (1232UL)
+
+static uchar  arena[ ARENA_SZ ];
+static char   line [ RSP_LINE_MAX ];
+static uchar  bench_msg [ BATCH_MAX ][ SZ_MAX ];
+static uchar  bench_hash[ BATCH_MAX ][ 32 ];
+
+static void const * vec_msg [ VEC_MAX ];
+static ulong        vec_sz  [ VEC_MAX ];
+static uchar        vec_md  [ VEC_MAX ][ 32 ];
+static uchar        vec_hash[ VEC_MAX ][ 32 ];
+
+/* unhex decodes the hex cstr s (terminated by a non hex digit) into out
+   (which has room for max bytes).  Returns the number of bytes decoded
+   or ULONG_MAX on failure. */
+
+static ulong
+unhex( uchar *      out,
+       ulong        max,
+       char const * s ) {
+  ulong n = 0UL;
+  for(;;) {
+    int hi = s[0]; int lo = hi ? s[1] : 0;
+#   define NIBBLE(c) (((c)>='0' && (c)<='9') ? (c)-'0' : ((c)>='a' && (c)<='f') ? (c)-'a'+10 : ((c)>='A' && (c)<='F') ? (c)-'A'+10 : -1)
+    int h = NIBBLE( hi ); int l = NIBBLE( lo );
+#   undef NIBBLE
+    if( h<0 ) return n;
+    if( FD_UNLIKELY( (l<0) | (n>=max) ) ) return ULONG_MAX;
+    out[ n++ ] = (uchar)((h<<4) | l);
+    s += 2;
+  }
+}
+
+/* load_rsp appends the message tests in the CAVP response file at path
+   to the vec_* arrays.  Returns the updated number of vectors. */
+
+static ulong
+load_rsp( char const * path,
+          ulong        vec_cnt,
+          ulong *      arena_used ) {
+  FILE * file = fopen( path, "r" );
+  if( FD_UNLIKELY( !file ) ) FD_LOG_ERR(( "fopen(\"%s\") failed (%i-%s)", path, errno, strerror( errno ) ));
+
+  ulong bit_sz = ULONG_MAX;
+  ulong sz     = 0UL;
+  while( fgets( line, (int)RSP_LINE_MAX, file ) ) {
+    if( !strncmp( line, "Len = ", 6UL ) ) {
+      bit_sz = strtoul( line+6, NULL, 10 );
+      if( FD_UNLIKELY( bit_sz & 7UL ) ) FD_LOG_ERR(( "%s: unsupported bit oriented message", path ));
+    } else if( !strncmp( line, "Msg = ", 6UL ) ) {
+      if( FD_UNLIKELY( bit_sz==ULONG_MAX    ) ) FD_LOG_ERR(( "%s: Msg without Len", path ));
+      if( FD_UNLIKELY( vec_cnt>=VEC_MAX     ) ) FD_LOG_ERR(( "%s: too many vectors; increase VEC_MAX", path ));
+      uchar * msg = arena + *arena_used;
+      ulong   n   = unhex( msg, ARENA_SZ - *arena_used, line+6 );
+      if( FD_UNLIKELY( n==ULONG_MAX ) ) FD_LOG_ERR(( "%s: bad Msg (or increase ARENA_SZ)", path ));
+      sz = bit_sz>>3; /* Len = 0 tests have a single dummy Msg byte */
+      if( FD_UNLIKELY( n<sz ) ) FD_LOG_ERR(( "%s: Msg shorter than Len", path ));
+      vec_msg[ vec_cnt ] = sz ? msg : NULL;
+      vec_sz [ vec_cnt ] = sz;
+      *arena_used += sz;
+    } else if( !strncmp( line, "MD = ", 5UL ) ) {
+      if( FD_UNLIKELY( bit_sz==ULONG_MAX ) ) FD_LOG_ERR(( "%s: MD without Msg", path ));
+      if( FD_UNLIKELY( unhex( vec_md[ vec_cnt ], 32UL, line+5 )!=32UL ) ) FD_LOG_ERR(( "%s: bad MD", path ));
+      vec_cnt++;
+      bit_sz = ULONG_MAX;
+    }
+  }
+
+  fclose( file );
+  return vec_cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _rsp     = fd_env_strip_cmdline_cstr ( &argc, &argv, "--rsp",     NULL,
+                                                      "src/ballet/sha256/cavp/SHA256ShortMsg.rsp,"
+                                                      "src/ballet/sha256/cavp/SHA256LongMsg.rsp"    ); /* (opt) CAVP response files */
+  ulong        batch    = fd_env_strip_cmdline_ulong( &argc, &argv, "--batch",   NULL, 64UL          ); /* (opt) batch size */
+  ulong        iter_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",    NULL, 2000UL        ); /* (opt) batches per size */
+
+  if( FD_UNLIKELY( !batch || batch>BATCH_MAX ) ) FD_LOG_ERR(( "--batch should be in [1,%lu]", BATCH_MAX ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Validate against the CAVP vectors.  The vectors are hashed as one
+     big batch (many messages of wildly different sizes in flight at
+     once) and then in random sized batches. */
+
+  static char rsp_buf[ 4096 ];
+  char *      rsp[ 16 ];
+  if( FD_UNLIKELY( strlen( _rsp )>=sizeof(rsp_buf) ) ) FD_LOG_ERR(( "--rsp too long" ));
+  strcpy( rsp_buf, _rsp );
+  ulong rsp_cnt = fd_cstr_tokenize( rsp, 16UL, rsp_buf, ',' );
+  if( FD_UNLIKELY( rsp_cnt>16UL ) ) FD_LOG_ERR(( "too many --rsp files" ));
+
+  ulong vec_cnt    = 0UL;
+  ulong arena_used = 0UL;
+  for( ulong r=0UL; r<rsp_cnt; r++ ) {
+    ulong cnt = load_rsp( rsp[r], vec_cnt, &arena_used );
+    FD_LOG_NOTICE(( "Loaded %lu vectors from %s", cnt-vec_cnt, rsp[r] ));
+    vec_cnt = cnt;
+  }
+
+  void * vec_out[ VEC_MAX ];
+  for( ulong i=0UL; i<vec_cnt; i++ ) vec_out[i] = vec_hash[i];
+
+  fd_memset( vec_hash, 0, sizeof(vec_hash) );
+  fd_sha256_batch_hash( vec_msg, vec_sz, vec_out, vec_cnt );
+  for( ulong i=0UL; i<vec_cnt; i++ )
+    if( FD_UNLIKELY( memcmp( vec_hash[i], vec_md[i], 32UL ) ) ) FD_LOG_ERR(( "FAIL (vector %lu, sz %lu)", i, vec_sz[i] ));
+
+  fd_memset( vec_hash, 0, sizeof(vec_hash) );
+  for( ulong i0=0UL; i0<vec_cnt; ) {
+    ulong cnt = fd_ulong_min( vec_cnt-i0, fd_rng_ulong_roll( rng, 40UL ) );
+    fd_sha256_batch_hash( vec_msg+i0, vec_sz+i0, vec_out+i0, cnt );
+    i0 += cnt;
+  }
+  for( ulong i=0UL; i<vec_cnt; i++ )
+    if( FD_UNLIKELY( memcmp( vec_hash[i], vec_md[i], 32UL ) ) ) FD_LOG_ERR(( "FAIL (vector %lu, sz %lu)", i, vec_sz[i] ));
+
+  FD_LOG_NOTICE(( "OK: %lu CAVP vectors", vec_cnt ));
+
+  /* Benchmark */
+
+  for( ulong i=0UL; i<BATCH_MAX; i++ ) for( ulong b=0UL; b<SZ_MAX; b++ ) bench_msg[i][b] = fd_rng_uchar( rng );
+
+  void const * data[ BATCH_MAX ];
+  ulong        sz  [ BATCH_MAX ];
+  void *       out [ BATCH_MAX ];
+
+  static ulong const bench_sz[] = { 32UL, 33UL, 65UL, 128UL, 512UL, 1232UL };
+
+  FD_LOG_NOTICE(( "Benchmarking (--batch %lu)", batch ));
+  for( ulong idx=0UL; idx<sizeof(bench_sz)/sizeof(bench_sz[0]); idx++ ) {
+    ulong msg_sz = bench_sz[ idx ];
+    for( ulong i=0UL; i<batch; i++ ) { data[i] = bench_msg[i]; sz[i] = msg_sz; out[i] = bench_hash[i]; }
+
+    /* warmup */
+    for( ulong rem=10UL; rem; rem-- ) fd_sha256_batch_hash( data, sz, out, batch );
+    for( ulong rem=10UL; rem; rem-- ) for( ulong i=0UL; i<batch; i++ ) fd_sha256_hash( data[i], sz[i], out[i] );
+
+    /* for real */
+    long dt_batch = -fd_log_wallclock();
+    for( ulong rem=iter_max; rem; rem-- ) fd_sha256_batch_hash( data, sz, out, batch );
+    dt_batch += fd_log_wallclock();
+
+    long dt_one = -fd_log_wallclock();
+    for( ulong rem=iter_max; rem; rem-- ) for( ulong i=0UL; i<batch; i++ ) fd_sha256_hash( data[i], sz[i], out[i] );
+    dt_one += fd_log_wallclock();
+
+    float hash_cnt = (float)(iter_max*batch);
+    FD_LOG_NOTICE(( "sz %4lu: batch %8.3f Mhash/s/core %7.3f GB/s/core, fd_sha256_hash %8.3f Mhash/s/core %7.3f GB/s/core (%.2fx)",
+                    msg_sz,
+                    (double)(1e3f*hash_cnt/(float)dt_batch), (double)(hash_cnt*(float)msg_sz/(float)dt_batch),
+                    (double)(1e3f*hash_cnt/(float)dt_one  ), (double)(hash_cnt*(float)msg_sz/(float)dt_one  ),
+                    (double)((float)dt_one/(float)dt_batch) ));
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
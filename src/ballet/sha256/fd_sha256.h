@@ -138,6 +138,33 @@ fd_sha256_hash( void const * data,
                 ulong        sz,
                 void *       hash );
 
+/* fd_sha256_batch_hash computes the SHA-256 hashes of cnt independent
+   messages.  data[i] points to the first byte of the sz[i] byte message
+   i (data[i]==NULL fine if sz[i]==0) and hash[i] points to the first
+   byte of the 32-byte memory region where the hash of message i should
+   be stored for i in [0,cnt).  On return, hash[i] holds exactly what
+   fd_sha256_hash( data[i], sz[i], hash[i] ) would produce.
+
+   Under the hood, this hashes several messages at a time (16 in the
+   lanes of AVX-512 vectors on targets with AVX-512, 2 with interleaved
+   SHA extension instruction streams on targets with AVX and 1
+   otherwise).  Messages can have arbitrary and different sizes (a lane
+   that finishes a message moves on to the next message in the batch).
+   This improves throughput when there are many short messages to hash
+   (e.g. the nodes of a Merkle tree) but not the latency of an
+   individual hash (batches too small to fill a reasonable fraction of
+   the lanes are hashed a message at a time).
+
+   Does no input argument checking.  The caller takes a read interest in
+   the messages and a write interest in the hashes for the duration of
+   the call.  Hash regions should not overlap messages or each other. */
+
+void
+fd_sha256_batch_hash( void const * const * data,
+                      ulong const *        sz,
+                      void * const *       hash,
+                      ulong                cnt );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_sha256_fd_sha256_h */
@@ -0,0 +1,423 @@
+#include "fd_sha256.h"
+
+/* FD_SHA256_BATCH_IMPL selects the fd_sha256_batch_hash implementation:
+   0 hashes the messages one at a time with fd_sha256_hash, 1 hashes 2
+   messages at a time with interleaved SHA extension instruction streams
+   (a single stream is latency bound), 2 hashes 8 messages at a time in
+   the 32-bit lanes of AVX2 vectors and 3 hashes 16 messages at a time in
+   the 32-bit lanes of AVX-512 vectors.  Like fd_sha256_core_shaext, 1
+   assumes FD_HAS_AVX targets support the SHA extensions.  Defaults to
+   the fastest implementation supported by the build target (on cores
+   with the SHA extensions, 2 is typically no faster than a single SHA
+   extension stream so it is only used if explicitly requested). */
+
+#ifndef FD_SHA256_BATCH_IMPL
+#if FD_HAS_AVX512
+#define FD_SHA256_BATCH_IMPL 3
+#elif FD_HAS_AVX
+#define FD_SHA256_BATCH_IMPL 1
+#else
+#define FD_SHA256_BATCH_IMPL 0
+#endif
+#endif
+
+#if FD_SHA256_BATCH_IMPL==0
+
+void
+fd_sha256_batch_hash( void const * const * data,
+                      ulong const *        sz,
+                      void * const *       hash,
+                      ulong                cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) fd_sha256_hash( data[i], sz[i], hash[i] );
+}
+
+#else
+
+static uint const fd_sha256_batch_K[64] __attribute__((aligned(64))) = {
+  0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+  0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+  0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+  0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+  0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+  0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+  0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+  0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+static uint const fd_sha256_batch_IV[8] = {
+  0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU, 0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+};
+
+/* fd_sha256_batch_core updates the hash state of LANE_CNT independent
+   SHA-256 calculations with one 64-byte block each.  state holds the
+   calculation states (in an implementation defined layout) and block[l]
+   points to the (arbitrarily aligned) block for lane l.
+
+   fd_sha256_batch_state_iv initializes the calculation state of lane l
+   and fd_sha256_batch_state_hash unpacks the hash of lane l. */
+
+#if FD_SHA256_BATCH_IMPL==1
+
+#include <x86intrin.h>
+
+#define LANE_CNT (2UL)
+#define LANE_MIN (2UL)
+
+/* The below is the usual SHA extension formulation (message schedule
+   4 words at a time) with the instructions for the two lanes
+   interleaved.  The state of lane l is kept in the ABEF / CDGH order
+   these instructions use at state+8*l (i.e. F E B A H G D C).  This is
+   only compiled with the SHA extensions enabled (the rest of the build
+   doesn't assume them). */
+
+static inline void
+fd_sha256_batch_state_iv( uint * state,
+                          ulong  l ) {
+  uint const * iv = fd_sha256_batch_IV;
+  uint *       s  = state + 8UL*l;
+  s[0] = iv[5]; s[1] = iv[4]; s[2] = iv[1]; s[3] = iv[0];
+  s[4] = iv[7]; s[5] = iv[6]; s[6] = iv[3]; s[7] = iv[2];
+}
+
+static inline void
+fd_sha256_batch_state_hash( uint const * state,
+                            ulong        l,
+                            uint *       hash ) {
+  uint const * s = state + 8UL*l;
+  hash[0] = fd_uint_bswap( s[3] ); hash[1] = fd_uint_bswap( s[2] );
+  hash[2] = fd_uint_bswap( s[7] ); hash[3] = fd_uint_bswap( s[6] );
+  hash[4] = fd_uint_bswap( s[1] ); hash[5] = fd_uint_bswap( s[0] );
+  hash[6] = fd_uint_bswap( s[5] ); hash[7] = fd_uint_bswap( s[4] );
+}
+
+__attribute__((target("sha,sse4.1")))
+static void
+fd_sha256_batch_core( uint *                state,    /* 64-byte aligned, 8*LANE_CNT entries */
+                      uchar const * const * block ) { /* LANE_CNT */
+
+  __m128i const bswap = _mm_setr_epi8( 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12 );
+
+  __m128i abef0 = _mm_load_si128( (__m128i const *)(state     ) ); __m128i cdgh0 = _mm_load_si128( (__m128i const *)(state+ 4) );
+  __m128i abef1 = _mm_load_si128( (__m128i const *)(state+8UL ) ); __m128i cdgh1 = _mm_load_si128( (__m128i const *)(state+12) );
+
+  __m128i abef0_save = abef0; __m128i cdgh0_save = cdgh0;
+  __m128i abef1_save = abef1; __m128i cdgh1_save = cdgh1;
+
+  __m128i w0[4];
+  __m128i w1[4];
+
+  /* Quad round i: w[i] = msg2( msg1( w[i-4], w[i-3] ) + alignr( w[i-1], w[i-2] ), w[i-1] ) for i>=4 */
+
+# define QUAD_ROUND( i ) do {                                                                               \
+    __m128i x0;                                                                                             \
+    __m128i x1;                                                                                             \
+    if( (i)<4 ) {                                                                                           \
+      x0 = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i const *)(block[0] + 16*(i)) ), bswap );             \
+      x1 = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i const *)(block[1] + 16*(i)) ), bswap );             \
+    } else {                                                                                                \
+      x0 = _mm_sha256msg1_epu32( w0[(i)&3], w0[((i)-3)&3] );                                                \
+      x1 = _mm_sha256msg1_epu32( w1[(i)&3], w1[((i)-3)&3] );                                                \
+      x0 = _mm_add_epi32( x0, _mm_alignr_epi8( w0[((i)-1)&3], w0[((i)-2)&3], 4 ) );                         \
+      x1 = _mm_add_epi32( x1, _mm_alignr_epi8( w1[((i)-1)&3], w1[((i)-2)&3], 4 ) );                         \
+      x0 = _mm_sha256msg2_epu32( x0, w0[((i)-1)&3] );                                                       \
+      x1 = _mm_sha256msg2_epu32( x1, w1[((i)-1)&3] );                                                       \
+    }                                                                                                       \
+    w0[(i)&3] = x0;                                                                                         \
+    w1[(i)&3] = x1;                                                                                         \
+    __m128i k  = _mm_load_si128( (__m128i const *)(fd_sha256_batch_K + 4*(i)) );                           \
+    __m128i m0 = _mm_add_epi32( x0, k );                                                                    \
+    __m128i m1 = _mm_add_epi32( x1, k );                                                                    \
+    cdgh0 = _mm_sha256rnds2_epu32( cdgh0, abef0, m0 );                                                      \
+    cdgh1 = _mm_sha256rnds2_epu32( cdgh1, abef1, m1 );                                                      \
+    abef0 = _mm_sha256rnds2_epu32( abef0, cdgh0, _mm_shuffle_epi32( m0, 0x0e ) );                           \
+    abef1 = _mm_sha256rnds2_epu32( abef1, cdgh1, _mm_shuffle_epi32( m1, 0x0e ) );                           \
+  } while(0)
+
+  QUAD_ROUND(  0 ); QUAD_ROUND(  1 ); QUAD_ROUND(  2 ); QUAD_ROUND(  3 );
+  QUAD_ROUND(  4 ); QUAD_ROUND(  5 ); QUAD_ROUND(  6 ); QUAD_ROUND(  7 );
+  QUAD_ROUND(  8 ); QUAD_ROUND(  9 ); QUAD_ROUND( 10 ); QUAD_ROUND( 11 );
+  QUAD_ROUND( 12 ); QUAD_ROUND( 13 ); QUAD_ROUND( 14 ); QUAD_ROUND( 15 );
+
+# undef QUAD_ROUND
+
+  _mm_store_si128( (__m128i *)(state     ), _mm_add_epi32( abef0, abef0_save ) );
+  _mm_store_si128( (__m128i *)(state+ 4UL), _mm_add_epi32( cdgh0, cdgh0_save ) );
+  _mm_store_si128( (__m128i *)(state+ 8UL), _mm_add_epi32( abef1, abef1_save ) );
+  _mm_store_si128( (__m128i *)(state+12UL), _mm_add_epi32( cdgh1, cdgh1_save ) );
+}
+
+#else
+
+/* The lane parallel implementations.  The round function below is
+   written once in terms of the SHA256_BATCH_* vector ops defined by
+   each implementation. */
+
+#if FD_SHA256_BATCH_IMPL==2
+
+#include "../../util/simd/fd_avx.h"
+
+#define LANE_CNT (8UL)
+#define LANE_MIN (4UL)
+
+#define SHA256_BATCH_T             wu_t
+#define SHA256_BATCH_BCAST(x)      wu_bcast( x )
+#define SHA256_BATCH_ADD(a,b)      wu_add( (a), (b) )
+#define SHA256_BATCH_XOR3(a,b,c)   wu_xor( wu_xor( (a), (b) ), (c) )
+#define SHA256_BATCH_ROR(a,n)      wu_ror( (a), (n) )
+#define SHA256_BATCH_SHR(a,n)      wu_shr( (a), (n) )
+#define SHA256_BATCH_CH(x,y,z)     wu_xor( wu_and( (x), (y) ), wu_andnot( (x), (z) ) )
+#define SHA256_BATCH_MAJ(x,y,z)    wu_or( wu_and( (x), (y) ), wu_and( wu_or( (x), (y) ), (z) ) )
+#define SHA256_BATCH_LD(p)         wu_ld( (p) )
+#define SHA256_BATCH_ST(p,x)       wu_st( (p), (x) )
+
+/* Loads the 16 message words for each lane, transposed such that W[j]
+   holds word j of every lane and byte swapped to host order. */
+
+static inline void
+fd_sha256_batch_load( wu_t *                W,
+                      uchar const * const * block ) {
+  wu_t const bswap = _mm256_setr_epi8( 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+                                       3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12 );
+  for( ulong j=0UL; j<16UL; j+=8UL ) {
+    wu_t r0 = wu_ldu( (uint const *)block[0] + j ); wu_t r1 = wu_ldu( (uint const *)block[1] + j );
+    wu_t r2 = wu_ldu( (uint const *)block[2] + j ); wu_t r3 = wu_ldu( (uint const *)block[3] + j );
+    wu_t r4 = wu_ldu( (uint const *)block[4] + j ); wu_t r5 = wu_ldu( (uint const *)block[5] + j );
+    wu_t r6 = wu_ldu( (uint const *)block[6] + j ); wu_t r7 = wu_ldu( (uint const *)block[7] + j );
+
+    /* 8x8 transpose: interleave words, then word pairs, then 128-bit
+       halves */
+
+    wu_t t0 = _mm256_unpacklo_epi32( r0, r1 ); wu_t t1 = _mm256_unpackhi_epi32( r0, r1 );
+    wu_t t2 = _mm256_unpacklo_epi32( r2, r3 ); wu_t t3 = _mm256_unpackhi_epi32( r2, r3 );
+    wu_t t4 = _mm256_unpacklo_epi32( r4, r5 ); wu_t t5 = _mm256_unpackhi_epi32( r4, r5 );
+    wu_t t6 = _mm256_unpacklo_epi32( r6, r7 ); wu_t t7 = _mm256_unpackhi_epi32( r6, r7 );
+
+    wu_t u0 = _mm256_unpacklo_epi64( t0, t2 ); wu_t u1 = _mm256_unpackhi_epi64( t0, t2 );
+    wu_t u2 = _mm256_unpacklo_epi64( t1, t3 ); wu_t u3 = _mm256_unpackhi_epi64( t1, t3 );
+    wu_t u4 = _mm256_unpacklo_epi64( t4, t6 ); wu_t u5 = _mm256_unpackhi_epi64( t4, t6 );
+    wu_t u6 = _mm256_unpacklo_epi64( t5, t7 ); wu_t u7 = _mm256_unpackhi_epi64( t5, t7 );
+
+    W[j+0UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u0, u4, 0x20 ), bswap );
+    W[j+4UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u0, u4, 0x31 ), bswap );
+    W[j+1UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u1, u5, 0x20 ), bswap );
+    W[j+5UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u1, u5, 0x31 ), bswap );
+    W[j+2UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u2, u6, 0x20 ), bswap );
+    W[j+6UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u2, u6, 0x31 ), bswap );
+    W[j+3UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u3, u7, 0x20 ), bswap );
+    W[j+7UL] = _mm256_shuffle_epi8( _mm256_permute2x128_si256( u3, u7, 0x31 ), bswap );
+  }
+}
+
+#elif FD_SHA256_BATCH_IMPL==3
+
+#include <x86intrin.h>
+
+#define LANE_CNT (16UL)
+#define LANE_MIN (8UL)
+
+/* The ternary logic immediates are the truth tables of x^y^z, x?y:z and
+   majority(x,y,z) */
+
+#define SHA256_BATCH_T             __m512i
+#define SHA256_BATCH_BCAST(x)      _mm512_set1_epi32( (int)(x) )
+#define SHA256_BATCH_ADD(a,b)      _mm512_add_epi32( (a), (b) )
+#define SHA256_BATCH_XOR3(a,b,c)   _mm512_ternarylogic_epi32( (a), (b), (c), 0x96 )
+#define SHA256_BATCH_ROR(a,n)      _mm512_ror_epi32( (a), (n) )
+#define SHA256_BATCH_SHR(a,n)      _mm512_srli_epi32( (a), (n) )
+#define SHA256_BATCH_CH(x,y,z)     _mm512_ternarylogic_epi32( (x), (y), (z), 0xca )
+#define SHA256_BATCH_MAJ(x,y,z)    _mm512_ternarylogic_epi32( (x), (y), (z), 0xe8 )
+#define SHA256_BATCH_LD(p)         _mm512_load_si512( (p) )
+#define SHA256_BATCH_ST(p,x)       _mm512_store_si512( (p), (x) )
+
+static inline void
+fd_sha256_batch_load( __m512i *             W,
+                      uchar const * const * block ) {
+  __m512i const bswap = _mm512_set4_epi32( 0x0c0d0e0f, 0x08090a0b, 0x04050607, 0x00010203 );
+
+  /* 16x16 transpose: interleave words and word pairs (giving, in each
+     128-bit chunk c of v[g][o], word 4c+o of lanes 4g:4g+3) and then
+     gather the chunks (twice) */
+
+  __m512i v[4][4];
+  for( ulong g=0UL; g<4UL; g++ ) {
+    __m512i r0 = _mm512_loadu_si512( block[4UL*g+0UL] ); __m512i r1 = _mm512_loadu_si512( block[4UL*g+1UL] );
+    __m512i r2 = _mm512_loadu_si512( block[4UL*g+2UL] ); __m512i r3 = _mm512_loadu_si512( block[4UL*g+3UL] );
+    __m512i t0 = _mm512_unpacklo_epi32( r0, r1 ); __m512i t1 = _mm512_unpackhi_epi32( r0, r1 );
+    __m512i t2 = _mm512_unpacklo_epi32( r2, r3 ); __m512i t3 = _mm512_unpackhi_epi32( r2, r3 );
+    v[g][0] = _mm512_unpacklo_epi64( t0, t2 ); v[g][1] = _mm512_unpackhi_epi64( t0, t2 );
+    v[g][2] = _mm512_unpacklo_epi64( t1, t3 ); v[g][3] = _mm512_unpackhi_epi64( t1, t3 );
+  }
+
+  for( ulong o=0UL; o<4UL; o++ ) {
+    __m512i x0 = _mm512_shuffle_i32x4( v[0][o], v[1][o], 0x88 ); __m512i y0 = _mm512_shuffle_i32x4( v[0][o], v[1][o], 0xdd );
+    __m512i x1 = _mm512_shuffle_i32x4( v[2][o], v[3][o], 0x88 ); __m512i y1 = _mm512_shuffle_i32x4( v[2][o], v[3][o], 0xdd );
+    W[ 0UL+o] = _mm512_shuffle_epi8( _mm512_shuffle_i32x4( x0, x1, 0x88 ), bswap );
+    W[ 8UL+o] = _mm512_shuffle_epi8( _mm512_shuffle_i32x4( x0, x1, 0xdd ), bswap );
+    W[ 4UL+o] = _mm512_shuffle_epi8( _mm512_shuffle_i32x4( y0, y1, 0x88 ), bswap );
+    W[12UL+o] = _mm512_shuffle_epi8( _mm512_shuffle_i32x4( y0, y1, 0xdd ), bswap );
+  }
+}
+
+#else
+#error "Unsupported FD_SHA256_BATCH_IMPL"
+#endif
+
+/* The state is kept in lane major order (word k of lane l is at
+   state[k*LANE_CNT+l]) */
+
+static inline void
+fd_sha256_batch_state_iv( uint * state,
+                          ulong  l ) {
+  for( ulong k=0UL; k<8UL; k++ ) state[ k*LANE_CNT + l ] = fd_sha256_batch_IV[ k ];
+}
+
+static inline void
+fd_sha256_batch_state_hash( uint const * state,
+                            ulong        l,
+                            uint *       hash ) {
+  for( ulong k=0UL; k<8UL; k++ ) hash[k] = fd_uint_bswap( state[ k*LANE_CNT + l ] );
+}
+
+static void
+fd_sha256_batch_core( uint *                state,    /* 64-byte aligned, 8*LANE_CNT entries */
+                      uchar const * const * block ) { /* LANE_CNT */
+
+# define Sigma0(x) SHA256_BATCH_XOR3( SHA256_BATCH_ROR( (x), 2 ), SHA256_BATCH_ROR( (x),13 ), SHA256_BATCH_ROR( (x),22 ) )
+# define Sigma1(x) SHA256_BATCH_XOR3( SHA256_BATCH_ROR( (x), 6 ), SHA256_BATCH_ROR( (x),11 ), SHA256_BATCH_ROR( (x),25 ) )
+# define sigma0(x) SHA256_BATCH_XOR3( SHA256_BATCH_ROR( (x), 7 ), SHA256_BATCH_ROR( (x),18 ), SHA256_BATCH_SHR( (x), 3 ) )
+# define sigma1(x) SHA256_BATCH_XOR3( SHA256_BATCH_ROR( (x),17 ), SHA256_BATCH_ROR( (x),19 ), SHA256_BATCH_SHR( (x),10 ) )
+
+  SHA256_BATCH_T X[16];
+  fd_sha256_batch_load( X, block );
+
+  SHA256_BATCH_T a = SHA256_BATCH_LD( state + 0UL*LANE_CNT );
+  SHA256_BATCH_T b = SHA256_BATCH_LD( state + 1UL*LANE_CNT );
+  SHA256_BATCH_T c = SHA256_BATCH_LD( state + 2UL*LANE_CNT );
+  SHA256_BATCH_T d = SHA256_BATCH_LD( state + 3UL*LANE_CNT );
+  SHA256_BATCH_T e = SHA256_BATCH_LD( state + 4UL*LANE_CNT );
+  SHA256_BATCH_T f = SHA256_BATCH_LD( state + 5UL*LANE_CNT );
+  SHA256_BATCH_T g = SHA256_BATCH_LD( state + 6UL*LANE_CNT );
+  SHA256_BATCH_T h = SHA256_BATCH_LD( state + 7UL*LANE_CNT );
+
+  for( ulong i=0UL; i<64UL; i++ ) {
+    if( i>=16UL ) {
+      SHA256_BATCH_T s0 = sigma0( X[(i+ 1UL) & 15UL] );
+      SHA256_BATCH_T s1 = sigma1( X[(i+14UL) & 15UL] );
+      X[i & 15UL] = SHA256_BATCH_ADD( SHA256_BATCH_ADD( X[i & 15UL], X[(i+9UL) & 15UL] ), SHA256_BATCH_ADD( s0, s1 ) );
+    }
+    SHA256_BATCH_T T1 = SHA256_BATCH_ADD( SHA256_BATCH_ADD( SHA256_BATCH_ADD( h, Sigma1( e ) ), SHA256_BATCH_CH( e, f, g ) ),
+                                          SHA256_BATCH_ADD( X[i & 15UL], SHA256_BATCH_BCAST( fd_sha256_batch_K[i] ) ) );
+    SHA256_BATCH_T T2 = SHA256_BATCH_ADD( Sigma0( a ), SHA256_BATCH_MAJ( a, b, c ) );
+    h = g;
+    g = f;
+    f = e;
+    e = SHA256_BATCH_ADD( d, T1 );
+    d = c;
+    c = b;
+    b = a;
+    a = SHA256_BATCH_ADD( T1, T2 );
+  }
+
+  SHA256_BATCH_ST( state + 0UL*LANE_CNT, SHA256_BATCH_ADD( a, SHA256_BATCH_LD( state + 0UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 1UL*LANE_CNT, SHA256_BATCH_ADD( b, SHA256_BATCH_LD( state + 1UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 2UL*LANE_CNT, SHA256_BATCH_ADD( c, SHA256_BATCH_LD( state + 2UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 3UL*LANE_CNT, SHA256_BATCH_ADD( d, SHA256_BATCH_LD( state + 3UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 4UL*LANE_CNT, SHA256_BATCH_ADD( e, SHA256_BATCH_LD( state + 4UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 5UL*LANE_CNT, SHA256_BATCH_ADD( f, SHA256_BATCH_LD( state + 5UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 6UL*LANE_CNT, SHA256_BATCH_ADD( g, SHA256_BATCH_LD( state + 6UL*LANE_CNT ) ) );
+  SHA256_BATCH_ST( state + 7UL*LANE_CNT, SHA256_BATCH_ADD( h, SHA256_BATCH_LD( state + 7UL*LANE_CNT ) ) );
+
+# undef Sigma0
+# undef Sigma1
+# undef sigma0
+# undef sigma1
+}
+
+#endif
+
+void
+fd_sha256_batch_hash( void const * const * data,
+                      ulong const *        sz,
+                      void * const *       hash,
+                      ulong                cnt ) {
+
+  /* A handful of messages isn't worth the lanes (LANE_MIN is roughly
+     where filling the lanes starts to beat hashing the messages one at
+     a time) */
+
+  if( FD_UNLIKELY( cnt<LANE_MIN ) ) {
+    for( ulong i=0UL; i<cnt; i++ ) fd_sha256_hash( data[i], sz[i], hash[i] );
+    return;
+  }
+
+  /* Each lane works through its current message's whole blocks in
+     place and then through its padded tail (the leftover bytes, the
+     terminator and the bit count, 1 or 2 blocks) in tail.  When a lane
+     finishes a message, its hash is unpacked and the lane is restarted
+     on the next message not yet started.  Lanes thus stay busy even
+     when message sizes are wildly different.  Idle lanes (at the end of
+     the batch) hash a dummy block and their results are ignored. */
+
+  static uchar const idle_block[ FD_SHA256_PRIVATE_BUF_MAX ] __attribute__((aligned(64)));
+
+  uint          state[ 8UL*LANE_CNT ]                            __attribute__((aligned(64)));
+  uchar         tail [ LANE_CNT ][ 2UL*FD_SHA256_PRIVATE_BUF_MAX ] __attribute__((aligned(64)));
+  uchar const * block[ LANE_CNT ];
+  uchar const * nxt  [ LANE_CNT ]; /* Next block for the lane */
+  ulong         rem  [ LANE_CNT ]; /* Number of blocks left in the lane's message, 0 if lane idle */
+  ulong         tcnt [ LANE_CNT ]; /* Number of tail blocks in the lane's message */
+  ulong         idx  [ LANE_CNT ]; /* Message being hashed by the lane */
+
+  ulong msg_nxt = 0UL; /* Next message to start */
+  ulong busy    = 0UL; /* Number of non-idle lanes */
+
+# define LANE_START( l ) do {                                                                       \
+    ulong         _i    = msg_nxt++;                                                                \
+    ulong         _sz   = sz[ _i ];                                                                 \
+    ulong         _full = _sz >> FD_SHA256_PRIVATE_LG_BUF_MAX;                                      \
+    ulong         _used = _sz & (FD_SHA256_PRIVATE_BUF_MAX-1UL);                                    \
+    ulong         _tcnt = 1UL + (ulong)(_used > FD_SHA256_PRIVATE_BUF_MAX-9UL);                     \
+    uchar *       _t    = tail[ (l) ];                                                              \
+    uchar const * _d    = (uchar const *)data[ _i ];                                                \
+    ulong         _tsz  = _tcnt << FD_SHA256_PRIVATE_LG_BUF_MAX;                                    \
+    if( FD_LIKELY( _used ) ) fd_memcpy( _t, _d + (_full << FD_SHA256_PRIVATE_LG_BUF_MAX), _used );  \
+    _t[ _used ] = (uchar)0x80;                                                                      \
+    fd_memset( _t + _used + 1UL, 0, _tsz - 8UL - _used - 1UL );                                     \
+    *((ulong *)(_t + _tsz - 8UL)) = fd_ulong_bswap( _sz<<3 );                                       \
+    fd_sha256_batch_state_iv( state, (l) );                                                         \
+    nxt [ (l) ] = _full ? _d : _t;                                                                  \
+    rem [ (l) ] = _full + _tcnt;                                                                    \
+    tcnt[ (l) ] = _tcnt;                                                                            \
+    idx [ (l) ] = _i;                                                                               \
+    busy++;                                                                                         \
+  } while(0)
+
+  for( ulong l=0UL; l<LANE_CNT; l++ ) {
+    if( msg_nxt<cnt ) LANE_START( l );
+    else              rem[l] = 0UL;
+  }
+
+  while( busy ) {
+
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      ulong r = rem[l];
+      if( FD_UNLIKELY( !r ) ) { block[l] = idle_block; continue; }
+      block[l] = nxt[l];
+      nxt[l]   = (r==tcnt[l]+1UL) ? tail[l] : (nxt[l] + FD_SHA256_PRIVATE_BUF_MAX); /* switch to the tail after the last whole block */
+      rem[l]   = r-1UL;
+    }
+
+    fd_sha256_batch_core( state, block );
+
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      if( FD_LIKELY( rem[l] || block[l]==idle_block ) ) continue;
+      fd_sha256_batch_state_hash( state, l, (uint *)hash[ idx[l] ] );
+      busy--;
+      if( msg_nxt<cnt ) LANE_START( l );
+    }
+  }
+
+# undef LANE_START
+}
+
+#endif
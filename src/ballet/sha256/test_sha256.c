@@ -10,6 +10,55 @@ FD_STATIC_ASSERT( FD_SHA256_FOOTPRINT==sizeof (fd_sha256_t), unit_test );
 FD_STATIC_ASSERT( FD_SHA256_LG_HASH_SZ==5, unit_test );
 FD_STATIC_ASSERT( FD_SHA256_HASH_SZ==32UL, unit_test );
 
+/* test_sha256_batch checks fd_sha256_batch_hash against the test
+   vectors (hashed as a single batch) and against fd_sha256_hash for
+   batches of random sizes of messages of random sizes (exercising lanes
+   of wildly different message sizes, idle lanes, etc). */
+
+static void
+test_sha256_batch( fd_rng_t * rng ) {
+
+# define BATCH_MAX (64UL)
+# define MSG_MAX   (1024UL)
+
+  static uchar        msg [ BATCH_MAX ][ MSG_MAX ];
+  static uchar        hash[ BATCH_MAX ][ 32 ];
+  void const *        data[ BATCH_MAX ];
+  ulong               sz  [ BATCH_MAX ];
+  void *              out [ BATCH_MAX ];
+  uchar               ref [ 32 ];
+
+  fd_sha256_test_vector_t const * vec = fd_sha256_test_vector;
+  while( vec->msg ) {
+    ulong cnt = 0UL;
+    fd_sha256_test_vector_t const * v = vec;
+    for( ; vec->msg && cnt<BATCH_MAX; vec++, cnt++ ) { data[cnt] = vec->msg; sz[cnt] = vec->sz; out[cnt] = hash[cnt]; }
+    fd_sha256_batch_hash( data, sz, out, cnt );
+    for( ulong i=0UL; i<cnt; i++ )
+      if( FD_UNLIKELY( memcmp( hash[i], v[i].hash, 32UL ) ) ) FD_LOG_ERR(( "FAIL (sz %lu)", v[i].sz ));
+  }
+
+  for( ulong b=0UL; b<MSG_MAX; b++ ) for( ulong i=0UL; i<BATCH_MAX; i++ ) msg[i][b] = fd_rng_uchar( rng );
+
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    ulong max = 1UL << fd_rng_uint_roll( rng, 11U ); /* Mix of batches of small and large messages */
+    for( ulong i=0UL; i<cnt; i++ ) {
+      sz  [i] = fd_rng_ulong_roll( rng, fd_ulong_min( max, MSG_MAX-16UL )+1UL );
+      data[i] = sz[i] ? (void const *)(msg[i] + fd_rng_ulong_roll( rng, 16UL )) : NULL; /* Misaligned too */
+      out [i] = hash[i];
+    }
+    fd_sha256_batch_hash( data, sz, out, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_sha256_hash( data[i], sz[i], ref );
+      if( FD_UNLIKELY( memcmp( hash[i], ref, 32UL ) ) ) FD_LOG_ERR(( "FAIL (iter %lu cnt %lu i %lu sz %lu)", iter, cnt, i, sz[i] ));
+    }
+  }
+
+# undef MSG_MAX
+# undef BATCH_MAX
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -92,6 +141,9 @@ main( int     argc,
                    FD_LOG_HEX16_FMT_ARGS( expected    ), FD_LOG_HEX16_FMT_ARGS( expected+16 ) ));
   }
 
+  test_sha256_batch( rng );
+  FD_LOG_NOTICE(( "OK: Batched" ));
+
   /* do a quick benchmark of sha-256 on small and large UDP payload
      packets from UDP/IP4/VLAN/Ethernet */
 
@@ -173,6 +173,31 @@ fd_sha512_hash( void const * data,
                 ulong        sz,
                 void *       hash );
 
+/* fd_sha512_batch_hash computes the SHA-512 hashes of cnt independent
+   messages.  data[i] points to the first byte of the sz[i] byte message
+   i (data[i]==NULL fine if sz[i]==0) and hash[i] points to the first
+   byte of the 64-byte memory region where the hash of message i should
+   be stored for i in [0,cnt).  On return, hash[i] holds exactly what
+   fd_sha512_hash( data[i], sz[i], hash[i] ) would produce.
+
+   Under the hood, this hashes several messages at a time in the SIMD
+   lanes of the target (4 with AVX, 8 with AVX-512, 1 otherwise).
+   Messages can have arbitrary and different sizes (a lane that finishes
+   a message moves on to the next message in the batch).  This improves
+   throughput when there are many messages to hash (e.g. the challenges
+   of a batch of ed25519 signatures) but not the latency of an
+   individual hash.
+
+   Does no input argument checking.  The caller takes a read interest in
+   the messages and a write interest in the hashes for the duration of
+   the call.  Hash regions should not overlap messages or each other. */
+
+void
+fd_sha512_batch_hash( void const * const * data,
+                      ulong const *        sz,
+                      void * const *       hash,
+                      ulong                cnt );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_sha512_fd_sha512_h */
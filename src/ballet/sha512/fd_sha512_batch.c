@@ -0,0 +1,306 @@
+#include "fd_sha512.h"
+
+/* FD_SHA512_BATCH_IMPL selects the fd_sha512_batch_hash implementation:
+   0 hashes the messages one at a time with fd_sha512_hash, 1 hashes 4
+   messages at a time in the 64-bit lanes of AVX2 vectors and 2 hashes 8
+   messages at a time in the 64-bit lanes of AVX-512 vectors.  Defaults
+   to the widest implementation supported by the build target. */
+
+#ifndef FD_SHA512_BATCH_IMPL
+#if FD_HAS_AVX512
+#define FD_SHA512_BATCH_IMPL 2
+#elif FD_HAS_AVX
+#define FD_SHA512_BATCH_IMPL 1
+#else
+#define FD_SHA512_BATCH_IMPL 0
+#endif
+#endif
+
+#if FD_SHA512_BATCH_IMPL==0
+
+void
+fd_sha512_batch_hash( void const * const * data,
+                      ulong const *        sz,
+                      void * const *       hash,
+                      ulong                cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) fd_sha512_hash( data[i], sz[i], hash[i] );
+}
+
+#else
+
+static ulong const fd_sha512_batch_K[80] = {
+  0x428a2f98d728ae22UL, 0x7137449123ef65cdUL, 0xb5c0fbcfec4d3b2fUL, 0xe9b5dba58189dbbcUL,
+  0x3956c25bf348b538UL, 0x59f111f1b605d019UL, 0x923f82a4af194f9bUL, 0xab1c5ed5da6d8118UL,
+  0xd807aa98a3030242UL, 0x12835b0145706fbeUL, 0x243185be4ee4b28cUL, 0x550c7dc3d5ffb4e2UL,
+  0x72be5d74f27b896fUL, 0x80deb1fe3b1696b1UL, 0x9bdc06a725c71235UL, 0xc19bf174cf692694UL,
+  0xe49b69c19ef14ad2UL, 0xefbe4786384f25e3UL, 0x0fc19dc68b8cd5b5UL, 0x240ca1cc77ac9c65UL,
+  0x2de92c6f592b0275UL, 0x4a7484aa6ea6e483UL, 0x5cb0a9dcbd41fbd4UL, 0x76f988da831153b5UL,
+  0x983e5152ee66dfabUL, 0xa831c66d2db43210UL, 0xb00327c898fb213fUL, 0xbf597fc7beef0ee4UL,
+  0xc6e00bf33da88fc2UL, 0xd5a79147930aa725UL, 0x06ca6351e003826fUL, 0x142929670a0e6e70UL,
+  0x27b70a8546d22ffcUL, 0x2e1b21385c26c926UL, 0x4d2c6dfc5ac42aedUL, 0x53380d139d95b3dfUL,
+  0x650a73548baf63deUL, 0x766a0abb3c77b2a8UL, 0x81c2c92e47edaee6UL, 0x92722c851482353bUL,
+  0xa2bfe8a14cf10364UL, 0xa81a664bbc423001UL, 0xc24b8b70d0f89791UL, 0xc76c51a30654be30UL,
+  0xd192e819d6ef5218UL, 0xd69906245565a910UL, 0xf40e35855771202aUL, 0x106aa07032bbd1b8UL,
+  0x19a4c116b8d2d0c8UL, 0x1e376c085141ab53UL, 0x2748774cdf8eeb99UL, 0x34b0bcb5e19b48a8UL,
+  0x391c0cb3c5c95a63UL, 0x4ed8aa4ae3418acbUL, 0x5b9cca4f7763e373UL, 0x682e6ff3d6b2b8a3UL,
+  0x748f82ee5defb2fcUL, 0x78a5636f43172f60UL, 0x84c87814a1f0ab72UL, 0x8cc702081a6439ecUL,
+  0x90befffa23631e28UL, 0xa4506cebde82bde9UL, 0xbef9a3f7b2c67915UL, 0xc67178f2e372532bUL,
+  0xca273eceea26619cUL, 0xd186b8c721c0c207UL, 0xeada7dd6cde0eb1eUL, 0xf57d4f7fee6ed178UL,
+  0x06f067aa72176fbaUL, 0x0a637dc5a2c898a6UL, 0x113f9804bef90daeUL, 0x1b710b35131c471bUL,
+  0x28db77f523047d84UL, 0x32caab7b40c72493UL, 0x3c9ebe0a15c9bebcUL, 0x431d67c49c100d4cUL,
+  0x4cc5d4becb3e42b6UL, 0x597f299cfc657e2aUL, 0x5fcb6fab3ad6faecUL, 0x6c44198c4a475817UL
+};
+
+static ulong const fd_sha512_batch_IV[8] = {
+  0x6a09e667f3bcc908UL, 0xbb67ae8584caa73bUL, 0x3c6ef372fe94f82bUL, 0xa54ff53a5f1d36f1UL,
+  0x510e527fade682d1UL, 0x9b05688c2b3e6c1fUL, 0x1f83d9abfb41bd6bUL, 0x5be0cd19137e2179UL
+};
+
+/* fd_sha512_batch_core updates the hash state of LANE_CNT independent
+   SHA-512 calculations with one 128-byte block each.  state holds the
+   calculation states in lane major order (word k of lane l is at
+   state[k*LANE_CNT+l]) and block[l] points to the (arbitrarily aligned)
+   block for lane l.  The round function below is written once in terms
+   of the SHA512_BATCH_* vector ops defined by each implementation. */
+
+#if FD_SHA512_BATCH_IMPL==1
+
+#include "../../util/simd/fd_avx.h"
+
+#define LANE_CNT (4UL)
+
+#define SHA512_BATCH_T             wv_t
+#define SHA512_BATCH_BCAST(x)      wv_bcast( x )
+#define SHA512_BATCH_ADD(a,b)      wv_add( (a), (b) )
+#define SHA512_BATCH_XOR3(a,b,c)   wv_xor( wv_xor( (a), (b) ), (c) )
+#define SHA512_BATCH_ROR(a,n)      wv_ror( (a), (n) )
+#define SHA512_BATCH_SHR(a,n)      wv_shr( (a), (n) )
+#define SHA512_BATCH_CH(x,y,z)     wv_xor( wv_and( (x), (y) ), wv_andnot( (x), (z) ) )
+#define SHA512_BATCH_MAJ(x,y,z)    wv_or( wv_and( (x), (y) ), wv_and( wv_or( (x), (y) ), (z) ) )
+
+/* Loads the 16 message words for each lane, transposed such that W[j]
+   holds word j of every lane and byte swapped to host order. */
+
+static inline void
+fd_sha512_batch_load( wv_t *                W,
+                      uchar const * const * block ) {
+  wv_t const bswap = _mm256_setr_epi8( 7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+                                       7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8 );
+  for( ulong j=0UL; j<16UL; j+=4UL ) {
+    wv_t r0 = wv_ldu( (ulong const *)block[0] + j );
+    wv_t r1 = wv_ldu( (ulong const *)block[1] + j );
+    wv_t r2 = wv_ldu( (ulong const *)block[2] + j );
+    wv_t r3 = wv_ldu( (ulong const *)block[3] + j );
+    wv_transpose_4x4( r0,r1,r2,r3, W[j],W[j+1UL],W[j+2UL],W[j+3UL] );
+    for( ulong k=0UL; k<4UL; k++ ) W[j+k] = _mm256_shuffle_epi8( W[j+k], bswap );
+  }
+}
+
+#define SHA512_BATCH_LD(p)   wv_ld( (p) )
+#define SHA512_BATCH_ST(p,x) wv_st( (p), (x) )
+
+#elif FD_SHA512_BATCH_IMPL==2
+
+#include <x86intrin.h>
+
+#define LANE_CNT (8UL)
+
+/* The ternary logic immediates are the truth tables of x^y^z, x?y:z and
+   majority(x,y,z) */
+
+#define SHA512_BATCH_T             __m512i
+#define SHA512_BATCH_BCAST(x)      _mm512_set1_epi64( (long)(x) )
+#define SHA512_BATCH_ADD(a,b)      _mm512_add_epi64( (a), (b) )
+#define SHA512_BATCH_XOR3(a,b,c)   _mm512_ternarylogic_epi64( (a), (b), (c), 0x96 )
+#define SHA512_BATCH_ROR(a,n)      _mm512_ror_epi64( (a), (n) )
+#define SHA512_BATCH_SHR(a,n)      _mm512_srli_epi64( (a), (n) )
+#define SHA512_BATCH_CH(x,y,z)     _mm512_ternarylogic_epi64( (x), (y), (z), 0xca )
+#define SHA512_BATCH_MAJ(x,y,z)    _mm512_ternarylogic_epi64( (x), (y), (z), 0xe8 )
+
+static inline void
+fd_sha512_batch_load( __m512i *             W,
+                      uchar const * const * block ) {
+  __m512i const bswap = _mm512_set4_epi64( 0x08090a0b0c0d0e0fL, 0x0001020304050607L,
+                                           0x08090a0b0c0d0e0fL, 0x0001020304050607L );
+  for( ulong j=0UL; j<16UL; j+=8UL ) {
+    __m512i r0 = _mm512_loadu_si512( (ulong const *)block[0] + j );
+    __m512i r1 = _mm512_loadu_si512( (ulong const *)block[1] + j );
+    __m512i r2 = _mm512_loadu_si512( (ulong const *)block[2] + j );
+    __m512i r3 = _mm512_loadu_si512( (ulong const *)block[3] + j );
+    __m512i r4 = _mm512_loadu_si512( (ulong const *)block[4] + j );
+    __m512i r5 = _mm512_loadu_si512( (ulong const *)block[5] + j );
+    __m512i r6 = _mm512_loadu_si512( (ulong const *)block[6] + j );
+    __m512i r7 = _mm512_loadu_si512( (ulong const *)block[7] + j );
+
+    /* 8x8 transpose: interleave word pairs and then 128-bit chunks
+       (twice) */
+
+    __m512i t0 = _mm512_unpacklo_epi64( r0, r1 ); __m512i t1 = _mm512_unpackhi_epi64( r0, r1 );
+    __m512i t2 = _mm512_unpacklo_epi64( r2, r3 ); __m512i t3 = _mm512_unpackhi_epi64( r2, r3 );
+    __m512i t4 = _mm512_unpacklo_epi64( r4, r5 ); __m512i t5 = _mm512_unpackhi_epi64( r4, r5 );
+    __m512i t6 = _mm512_unpacklo_epi64( r6, r7 ); __m512i t7 = _mm512_unpackhi_epi64( r6, r7 );
+
+    __m512i u0 = _mm512_shuffle_i64x2( t0, t2, 0x88 ); __m512i u1 = _mm512_shuffle_i64x2( t0, t2, 0xdd );
+    __m512i u2 = _mm512_shuffle_i64x2( t1, t3, 0x88 ); __m512i u3 = _mm512_shuffle_i64x2( t1, t3, 0xdd );
+    __m512i u4 = _mm512_shuffle_i64x2( t4, t6, 0x88 ); __m512i u5 = _mm512_shuffle_i64x2( t4, t6, 0xdd );
+    __m512i u6 = _mm512_shuffle_i64x2( t5, t7, 0x88 ); __m512i u7 = _mm512_shuffle_i64x2( t5, t7, 0xdd );
+
+    W[j+0UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u0, u4, 0x88 ), bswap );
+    W[j+4UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u0, u4, 0xdd ), bswap );
+    W[j+2UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u1, u5, 0x88 ), bswap );
+    W[j+6UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u1, u5, 0xdd ), bswap );
+    W[j+1UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u2, u6, 0x88 ), bswap );
+    W[j+5UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u2, u6, 0xdd ), bswap );
+    W[j+3UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u3, u7, 0x88 ), bswap );
+    W[j+7UL] = _mm512_shuffle_epi8( _mm512_shuffle_i64x2( u3, u7, 0xdd ), bswap );
+  }
+}
+
+#define SHA512_BATCH_LD(p)   _mm512_load_si512( (p) )
+#define SHA512_BATCH_ST(p,x) _mm512_store_si512( (p), (x) )
+
+#else
+#error "Unsupported FD_SHA512_BATCH_IMPL"
+#endif
+
+static void
+fd_sha512_batch_core( ulong *               state,    /* 64-byte aligned, 8*LANE_CNT entries */
+                      uchar const * const * block ) { /* LANE_CNT */
+
+# define Sigma0(x) SHA512_BATCH_XOR3( SHA512_BATCH_ROR( (x),28 ), SHA512_BATCH_ROR( (x),34 ), SHA512_BATCH_ROR( (x),39 ) )
+# define Sigma1(x) SHA512_BATCH_XOR3( SHA512_BATCH_ROR( (x),14 ), SHA512_BATCH_ROR( (x),18 ), SHA512_BATCH_ROR( (x),41 ) )
+# define sigma0(x) SHA512_BATCH_XOR3( SHA512_BATCH_ROR( (x), 1 ), SHA512_BATCH_ROR( (x), 8 ), SHA512_BATCH_SHR( (x),7 ) )
+# define sigma1(x) SHA512_BATCH_XOR3( SHA512_BATCH_ROR( (x),19 ), SHA512_BATCH_ROR( (x),61 ), SHA512_BATCH_SHR( (x),6 ) )
+
+  SHA512_BATCH_T X[16];
+  fd_sha512_batch_load( X, block );
+
+  SHA512_BATCH_T a = SHA512_BATCH_LD( state + 0UL*LANE_CNT );
+  SHA512_BATCH_T b = SHA512_BATCH_LD( state + 1UL*LANE_CNT );
+  SHA512_BATCH_T c = SHA512_BATCH_LD( state + 2UL*LANE_CNT );
+  SHA512_BATCH_T d = SHA512_BATCH_LD( state + 3UL*LANE_CNT );
+  SHA512_BATCH_T e = SHA512_BATCH_LD( state + 4UL*LANE_CNT );
+  SHA512_BATCH_T f = SHA512_BATCH_LD( state + 5UL*LANE_CNT );
+  SHA512_BATCH_T g = SHA512_BATCH_LD( state + 6UL*LANE_CNT );
+  SHA512_BATCH_T h = SHA512_BATCH_LD( state + 7UL*LANE_CNT );
+
+  for( ulong i=0UL; i<80UL; i++ ) {
+    if( i>=16UL ) {
+      SHA512_BATCH_T s0 = sigma0( X[(i+ 1UL) & 15UL] );
+      SHA512_BATCH_T s1 = sigma1( X[(i+14UL) & 15UL] );
+      X[i & 15UL] = SHA512_BATCH_ADD( SHA512_BATCH_ADD( X[i & 15UL], X[(i+9UL) & 15UL] ), SHA512_BATCH_ADD( s0, s1 ) );
+    }
+    SHA512_BATCH_T T1 = SHA512_BATCH_ADD( SHA512_BATCH_ADD( SHA512_BATCH_ADD( h, Sigma1( e ) ), SHA512_BATCH_CH( e, f, g ) ),
+                                          SHA512_BATCH_ADD( X[i & 15UL], SHA512_BATCH_BCAST( fd_sha512_batch_K[i] ) ) );
+    SHA512_BATCH_T T2 = SHA512_BATCH_ADD( Sigma0( a ), SHA512_BATCH_MAJ( a, b, c ) );
+    h = g;
+    g = f;
+    f = e;
+    e = SHA512_BATCH_ADD( d, T1 );
+    d = c;
+    c = b;
+    b = a;
+    a = SHA512_BATCH_ADD( T1, T2 );
+  }
+
+  SHA512_BATCH_ST( state + 0UL*LANE_CNT, SHA512_BATCH_ADD( a, SHA512_BATCH_LD( state + 0UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 1UL*LANE_CNT, SHA512_BATCH_ADD( b, SHA512_BATCH_LD( state + 1UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 2UL*LANE_CNT, SHA512_BATCH_ADD( c, SHA512_BATCH_LD( state + 2UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 3UL*LANE_CNT, SHA512_BATCH_ADD( d, SHA512_BATCH_LD( state + 3UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 4UL*LANE_CNT, SHA512_BATCH_ADD( e, SHA512_BATCH_LD( state + 4UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 5UL*LANE_CNT, SHA512_BATCH_ADD( f, SHA512_BATCH_LD( state + 5UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 6UL*LANE_CNT, SHA512_BATCH_ADD( g, SHA512_BATCH_LD( state + 6UL*LANE_CNT ) ) );
+  SHA512_BATCH_ST( state + 7UL*LANE_CNT, SHA512_BATCH_ADD( h, SHA512_BATCH_LD( state + 7UL*LANE_CNT ) ) );
+
+# undef Sigma0
+# undef Sigma1
+# undef sigma0
+# undef sigma1
+}
+
+void
+fd_sha512_batch_hash( void const * const * data,
+                      ulong const *        sz,
+                      void * const *       hash,
+                      ulong                cnt ) {
+
+  /* A lone message isn't worth the lanes */
+
+  if( FD_UNLIKELY( cnt<2UL ) ) {
+    if( cnt ) fd_sha512_hash( data[0], sz[0], hash[0] );
+    return;
+  }
+
+  /* Each lane works through its current message's whole blocks in
+     place and then through its padded tail (the leftover bytes, the
+     terminator and the bit count, 1 or 2 blocks) in tail.  When a lane
+     finishes a message, its hash is unpacked and the lane is restarted
+     on the next message not yet started.  Lanes thus stay busy even
+     when message sizes are wildly different.  Idle lanes (at the end of
+     the batch) hash a dummy block and their results are ignored. */
+
+  static uchar const idle_block[ FD_SHA512_PRIVATE_BUF_MAX ] __attribute__((aligned(128)));
+
+  ulong         state[ 8UL*LANE_CNT ]                            __attribute__((aligned(64)));
+  uchar         tail [ LANE_CNT ][ 2UL*FD_SHA512_PRIVATE_BUF_MAX ] __attribute__((aligned(128)));
+  uchar const * block[ LANE_CNT ];
+  uchar const * nxt  [ LANE_CNT ]; /* Next block for the lane */
+  ulong         rem  [ LANE_CNT ]; /* Number of blocks left in the lane's message, 0 if lane idle */
+  ulong         tcnt [ LANE_CNT ]; /* Number of tail blocks in the lane's message */
+  ulong         idx  [ LANE_CNT ]; /* Message being hashed by the lane */
+
+  ulong msg_nxt = 0UL; /* Next message to start */
+  ulong busy    = 0UL; /* Number of non-idle lanes */
+
+# define LANE_START( l ) do {                                                                       \
+    ulong         _i    = msg_nxt++;                                                                \
+    ulong         _sz   = sz[ _i ];                                                                 \
+    ulong         _full = _sz >> FD_SHA512_PRIVATE_LG_BUF_MAX;                                      \
+    ulong         _used = _sz & (FD_SHA512_PRIVATE_BUF_MAX-1UL);                                    \
+    ulong         _tcnt = 1UL + (ulong)(_used > FD_SHA512_PRIVATE_BUF_MAX-17UL);                    \
+    uchar *       _t    = tail[ (l) ];                                                              \
+    uchar const * _d    = (uchar const *)data[ _i ];                                                \
+    ulong         _tsz  = _tcnt << FD_SHA512_PRIVATE_LG_BUF_MAX;                                    \
+    if( FD_LIKELY( _used ) ) fd_memcpy( _t, _d + (_full << FD_SHA512_PRIVATE_LG_BUF_MAX), _used );  \
+    _t[ _used ] = (uchar)0x80;                                                                      \
+    fd_memset( _t + _used + 1UL, 0, _tsz - 16UL - _used - 1UL );                                    \
+    *((ulong *)(_t + _tsz - 16UL)) = fd_ulong_bswap( _sz>>61 );                                     \
+    *((ulong *)(_t + _tsz -  8UL)) = fd_ulong_bswap( _sz<< 3 );                                     \
+    for( ulong _k=0UL; _k<8UL; _k++ ) state[ _k*LANE_CNT + (l) ] = fd_sha512_batch_IV[ _k ];       \
+    nxt[ (l) ] = _full ? _d : _t;                                                                   \
+    rem[ (l) ] = _full + _tcnt;                                                                     \
+    tcnt[ (l) ] = _tcnt;                                                                            \
+    idx[ (l) ] = _i;                                                                                \
+    busy++;                                                                                         \
+  } while(0)
+
+  for( ulong l=0UL; l<LANE_CNT; l++ ) {
+    if( msg_nxt<cnt ) LANE_START( l );
+    else              rem[l] = 0UL;
+  }
+
+  while( busy ) {
+
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      ulong r = rem[l];
+      if( FD_UNLIKELY( !r ) ) { block[l] = idle_block; continue; }
+      block[l] = nxt[l];
+      nxt[l]   = (r==tcnt[l]+1UL) ? tail[l] : (nxt[l] + FD_SHA512_PRIVATE_BUF_MAX); /* switch to the tail after the last whole block */
+      rem[l] = r-1UL;
+    }
+
+    fd_sha512_batch_core( state, block );
+
+    for( ulong l=0UL; l<LANE_CNT; l++ ) {
+      if( FD_LIKELY( rem[l] || block[l]==idle_block ) ) continue;
+      ulong * h = (ulong *)hash[ idx[l] ];
+      for( ulong k=0UL; k<8UL; k++ ) h[k] = fd_ulong_bswap( state[ k*LANE_CNT + l ] );
+      busy--;
+      if( msg_nxt<cnt ) LANE_START( l );
+    }
+  }
+
+# undef LANE_START
+}
+
+#endif
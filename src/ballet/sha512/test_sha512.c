@@ -92,6 +92,55 @@ test_sha512_vectors( fd_sha512_test_vector_t const * vec,
   }
 }
 
+/* test_sha512_batch checks fd_sha512_batch_hash against fd_sha512_hash
+   for the messages in vec (hashed as a single batch) and then for
+   batches of random sizes of messages of random sizes (exercising lanes
+   of wildly different message sizes, idle lanes, etc). */
+
+static void
+test_sha512_batch( fd_sha512_test_vector_t const * vec,
+                   fd_rng_t *                      rng ) {
+
+# define BATCH_MAX (64UL)
+# define MSG_MAX   (2048UL)
+
+  static uchar        msg [ BATCH_MAX ][ MSG_MAX ];
+  static uchar        hash[ BATCH_MAX ][ 64 ];
+  void const *        data[ BATCH_MAX ];
+  ulong               sz  [ BATCH_MAX ];
+  void *              out [ BATCH_MAX ];
+  uchar               ref [ 64 ];
+
+  while( vec->msg ) {
+    ulong cnt = 0UL;
+    fd_sha512_test_vector_t const * v = vec;
+    for( ; vec->msg && cnt<BATCH_MAX; vec++, cnt++ ) { data[cnt] = vec->msg; sz[cnt] = vec->sz; out[cnt] = hash[cnt]; }
+    fd_sha512_batch_hash( data, sz, out, cnt );
+    for( ulong i=0UL; i<cnt; i++ )
+      if( FD_UNLIKELY( memcmp( hash[i], v[i].hash, 64UL ) ) ) FD_LOG_ERR(( "FAIL (sz %lu)", v[i].sz ));
+  }
+
+  for( ulong b=0UL; b<MSG_MAX; b++ ) for( ulong i=0UL; i<BATCH_MAX; i++ ) msg[i][b] = fd_rng_uchar( rng );
+
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    ulong max = 1UL << fd_rng_uint_roll( rng, 12U ); /* Mix of batches of small and large messages */
+    for( ulong i=0UL; i<cnt; i++ ) {
+      sz  [i] = fd_rng_ulong_roll( rng, fd_ulong_min( max, MSG_MAX-16UL )+1UL );
+      data[i] = sz[i] ? (void const *)(msg[i] + fd_rng_ulong_roll( rng, 16UL )) : NULL; /* Misaligned too */
+      out [i] = hash[i];
+    }
+    fd_sha512_batch_hash( data, sz, out, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_sha512_hash( data[i], sz[i], ref );
+      if( FD_UNLIKELY( memcmp( hash[i], ref, 64UL ) ) ) FD_LOG_ERR(( "FAIL (iter %lu cnt %lu i %lu sz %lu)", iter, cnt, i, sz[i] ));
+    }
+  }
+
+# undef MSG_MAX
+# undef BATCH_MAX
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -126,6 +175,14 @@ main( int     argc,
   FD_LOG_NOTICE(( "OK: CAVP SHA512LongMsg.rsp" ));
 # endif
 
+  /* Test batched hashing */
+  test_sha512_batch( fd_sha512_test_vector, rng );
+# ifdef HAS_CAVP_TEST_VECTORS
+  test_sha512_batch( cavp_sha512_short, rng );
+  test_sha512_batch( cavp_sha512_long,  rng );
+# endif
+  FD_LOG_NOTICE(( "OK: Batched" ));
+
   /* do a quick benchmark of sha-512 on small and large UDP payloads
      packets from UDP/IP4/VLAN/Ethernet */
 
@@ -167,6 +224,31 @@ main( int     argc,
     FD_LOG_NOTICE(( "~%.3f Gbps Ethernet equiv throughput / core (sz %4lu)", (double)gbps, sz ));
   }
 
+  FD_LOG_NOTICE(( "Benchmarking batched" ));
+  for( ulong idx=0U; idx<2UL; idx++ ) {
+    ulong sz = bench_sz[ idx ];
+
+    /* Batches of 32 messages (e.g. a batch of ed25519 signature
+       challenges) */
+
+    void const * batch_data[ 32 ];
+    ulong        batch_sz  [ 32 ];
+    void *       batch_hash[ 32 ];
+    static uchar batch_out [ 32 ][ 64 ];
+    for( ulong i=0UL; i<32UL; i++ ) { batch_data[i] = buf; batch_sz[i] = sz; batch_hash[i] = batch_out[i]; }
+
+    /* warmup */
+    for( ulong rem=10UL; rem; rem-- ) fd_sha512_batch_hash( batch_data, batch_sz, batch_hash, 32UL );
+
+    /* for real */
+    ulong iter = 100000UL/32UL;
+    long  dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) fd_sha512_batch_hash( batch_data, batch_sz, batch_hash, 32UL );
+    dt += fd_log_wallclock();
+    float gbps = ((float)(8UL*(70UL+sz)*32UL*iter)) / ((float)dt);
+    FD_LOG_NOTICE(( "~%.3f Gbps Ethernet equiv throughput / core (sz %4lu)", (double)gbps, sz ));
+  }
+
   /* clean up */
 
   FD_TEST( fd_sha512_leave( NULL )==NULL ); /* null sha */
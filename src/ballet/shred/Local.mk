@@ -1,4 +1,9 @@
-$(call add-hdrs,fd_shred.h)
-$(call add-objs,fd_shred,fd_ballet)
+$(call add-hdrs,fd_shred.h fd_shredder.h fd_deshredder.h)
+$(call add-objs,fd_shred fd_shredder fd_deshredder,fd_ballet)
 $(call make-unit-test,test_shred,test_shred,fd_ballet fd_util)
+$(call make-unit-test,test_shredder,test_shredder,fd_ballet fd_util)
+$(call make-unit-test,test_deshredder,test_deshredder,fd_ballet fd_util)
+$(call make-unit-test,bench_shredder,bench_shredder,fd_ballet fd_util)
 $(call run-unit-test,test_shred,)
+$(call run-unit-test,test_shredder,)
+$(call run-unit-test,test_deshredder,)
@@ -0,0 +1,72 @@
+#include "../fd_ballet.h"
+
+/* bench_shredder benchmarks shredding a stream of entry batches into a
+   ring of shred sized chunks (as a shred tile would into its dcache)
+   and reports the entry batch throughput.  A block is at most ~48 MB
+   worth of entry batches (shred limits) so a leader needs to shred at
+   least that much per slot. */
+
+#define RING_CNT (1024UL)
+
+static uchar ring [ RING_CNT ][ FD_SHRED_SZ ];
+static uchar batch[ 1UL<<20 ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong batch_sz = fd_env_strip_cmdline_ulong( &argc, &argv, "--batch-sz", NULL, 64UL<<10 ); /* (opt) bytes per entry batch */
+  ulong tot_sz   = fd_env_strip_cmdline_ulong( &argc, &argv, "--tot-sz",   NULL, 48UL<<20 ); /* (opt) bytes to shred */
+  batch_sz = fd_ulong_min( batch_sz, sizeof(batch) );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong b=0UL; b<sizeof(batch); b++ ) batch[b] = fd_rng_uchar( rng );
+
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+  uchar private_key[ 32 ];
+  uchar public_key [ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( public_key, private_key, sha );
+
+  fd_shredder_t _shredder[1];
+  fd_shredder_t * shredder = fd_shredder_join( fd_shredder_new( _shredder, public_key, private_key ) );
+
+  fd_shredder_batch_meta_t meta[1] = {{ .slot = 1UL, .parent_off = 1, .version = 1, .ref_tick = 0, .block_complete = 0 }};
+
+  ulong batch_cnt = fd_ulong_max( tot_sz / batch_sz, 1UL );
+  ulong shred_cnt = 0UL;
+  ulong set_cnt   = 0UL;
+  ulong chunk     = 0UL;
+
+  long dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<batch_cnt; i++ ) {
+    fd_shredder_init_batch( shredder, batch, batch_sz, meta );
+    for(;;) {
+      uchar * data_shred  [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET ];
+      uchar * parity_shred[ FD_SHREDDER_PARITY_SHREDS_MAX       ];
+      for( ulong j=0UL; j<FD_SHREDDER_DATA_SHREDS_PER_FEC_SET; j++ ) data_shred  [j] = ring[ (chunk+j) % RING_CNT ];
+      for( ulong j=0UL; j<FD_SHREDDER_PARITY_SHREDS_MAX;       j++ ) parity_shred[j] = ring[ (chunk+FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+j) % RING_CNT ];
+
+      fd_shredder_fec_set_t fec[1];
+      if( !fd_shredder_next_fec_set( shredder, data_shred, parity_shred, fec ) ) break;
+      set_cnt++;
+      shred_cnt += fec->data_shred_cnt + fec->parity_shred_cnt;
+      chunk     += FD_SHREDDER_DATA_SHREDS_PER_FEC_SET + FD_SHREDDER_PARITY_SHREDS_MAX;
+    }
+  }
+  dt += fd_log_wallclock();
+
+  FD_LOG_NOTICE(( "%lu batches of %lu B: %.3f MB/s (%.3f Mshred/s, %.3f us per FEC set)",
+                  batch_cnt, batch_sz,
+                  1e3*(double)(batch_cnt*batch_sz)/(double)dt,
+                  1e3*(double)shred_cnt/(double)dt,
+                  1e-3*(double)dt/(double)set_cnt ));
+
+  fd_shredder_delete( fd_shredder_leave( shredder ) );
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
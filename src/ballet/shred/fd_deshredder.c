@@ -0,0 +1,699 @@
+#include "fd_deshredder.h"
+#include "../reedsol/fd_reedsol.h"
+
+#define FD_DESHREDDER_MAGIC (0xF17EDA2CEDE5E200UL) /* FIREDANCE DESHREDDER V0 */
+
+/* fd_deshredder_rcvd_t is a bitmap of the data or coding shreds of an
+   FEC set that are present (indexed by position in the set). */
+
+#define SET_NAME fd_deshredder_rcvd
+#define SET_MAX  FD_DESHREDDER_DATA_SHREDS_MAX
+#include "../../util/tmpl/fd_set.c"
+
+FD_STATIC_ASSERT( FD_DESHREDDER_PARITY_SHREDS_MAX<=FD_DESHREDDER_DATA_SHREDS_MAX, unsupported_parity_shreds_max );
+
+#define FD_DESHREDDER_SHREDS_MAX (FD_DESHREDDER_DATA_SHREDS_MAX+FD_DESHREDDER_PARITY_SHREDS_MAX)
+
+/* A fd_deshredder_fec_t is an FEC set buffer.  key is the map key of
+   the set held (0 if the buffer is free, in which case next is the
+   index of the next free buffer).  The data shreds of the set are
+   stored at shred[k] for k in [0,data_cnt) and the coding shreds at
+   shred[FD_DESHREDDER_DATA_SHREDS_MAX+j] for j in [0,parity_cnt).
+   data_cnt and parity_cnt are 0 until known (data_cnt is known from a
+   coding shred, from the data shred that ends a batch or from the data
+   shred at the last possible position, parity_cnt from a coding
+   shred).  The signature, Merkle root, version and number of Merkle
+   nodes are those of the first shred received and all shreds of the
+   set have to match them. */
+
+struct __attribute__((aligned(FD_DESHREDDER_ALIGN))) fd_deshredder_fec {
+  ulong                key;
+  ulong                slot;
+  uint                 fec_set_idx;
+  uint                 next;
+  uint                 code_idx0;  /* Index in the slot of the set's first coding shred (if parity_cnt is known) */
+  uchar                data_cnt;
+  uchar                parity_cnt;
+  uchar                merkle_cnt;
+  ushort               version;
+  fd_deshredder_rcvd_t data_rcvd[ fd_deshredder_rcvd_word_cnt ];
+  fd_deshredder_rcvd_t code_rcvd[ fd_deshredder_rcvd_word_cnt ];
+  uchar                signature[ FD_ED25519_SIG_SZ       ];
+  uchar                root     [ FD_SHRED_MERKLE_NODE_SZ ];
+  uchar                shred    [ FD_DESHREDDER_SHREDS_MAX ][ FD_SHRED_SZ ];
+};
+
+typedef struct fd_deshredder_fec fd_deshredder_fec_t;
+
+/* A fd_deshredder_slot_t tracks the consumption of a slot's data
+   shreds.  Slot slot uses entry slot%slot_max (unique within the
+   window).  cursor_idx is the index of the first data shred of the
+   next batch to emit and cursor_set is the fec_set_idx of the set
+   holding it.  Data shreds [cursor_idx,scan_idx) are known to be
+   present and none of them ends a batch (scan_set is the fec_set_idx
+   of the set holding scan_idx) such that checking for a complete batch
+   does not rescan them. */
+
+struct fd_deshredder_slot {
+  ulong slot;     /* ULONG_MAX if never used */
+  ulong set_cnt;  /* Number of FEC set buffers holding sets of the slot */
+  uint  cursor_idx;
+  uint  cursor_set;
+  uint  scan_idx;
+  uint  scan_set;
+  int   complete; /* 1 once the last batch of the slot was emitted */
+};
+
+typedef struct fd_deshredder_slot fd_deshredder_slot_t;
+
+/* The map maps the key of an FEC set buffered to its buffer index. */
+
+struct fd_deshredder_map {
+  ulong key;
+  ulong set_idx;
+};
+
+typedef struct fd_deshredder_map fd_deshredder_map_t;
+
+#define MAP_NAME    fd_deshredder_map
+#define MAP_T       fd_deshredder_map_t
+#define MAP_MEMOIZE 0
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+struct __attribute__((aligned(FD_DESHREDDER_ALIGN))) fd_deshredder_private {
+  ulong magic;       /* ==FD_DESHREDDER_MAGIC */
+  ulong set_max;
+  ulong slot_max;
+  ulong slot_min;
+  ulong last_slot;   /* Slot of the last shred inserted, ULONG_MAX if none */
+  ulong set_cnt;
+  ulong free;        /* Index of the first free FEC set buffer, set_max if none */
+  ulong recover_cnt;
+  ulong evict_cnt;
+  ulong drop_cnt;
+  ulong map_off;     /* map, slot and FEC set buffer array offsets relative to the deshredder */
+  ulong slot_off;
+  ulong set_off;
+
+  /* Scratch Merkle tree for checking recovered sets (fd_bmtree20_tree_build
+     layout, 127 nodes for the largest sets of 64 shreds) */
+
+  fd_bmtree20_node_t tree[ 127 ];
+
+  /* Padding to FD_DESHREDDER_ALIGN here */
+  /* map here */
+  /* slot array here */
+  /* FEC set buffer array here */
+};
+
+FD_FN_CONST static inline int
+fd_deshredder_lg_slot_cnt( ulong set_max ) {
+  return fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*set_max ) );
+}
+
+FD_FN_CONST static inline ulong
+fd_deshredder_map_off( void ) {
+  return fd_ulong_align_up( sizeof(fd_deshredder_t), fd_deshredder_map_align() );
+}
+
+FD_FN_CONST static inline ulong
+fd_deshredder_slot_off( ulong set_max ) {
+  ulong map_end = fd_deshredder_map_off() + fd_deshredder_map_footprint( fd_deshredder_lg_slot_cnt( set_max ) );
+  return fd_ulong_align_up( map_end, alignof(fd_deshredder_slot_t) );
+}
+
+FD_FN_CONST static inline ulong
+fd_deshredder_set_off( ulong set_max,
+                       ulong slot_max ) {
+  ulong slot_end = fd_deshredder_slot_off( set_max ) + slot_max*sizeof(fd_deshredder_slot_t);
+  return fd_ulong_align_up( slot_end, alignof(fd_deshredder_fec_t) );
+}
+
+FD_FN_PURE static inline fd_deshredder_map_t *
+fd_deshredder_map( fd_deshredder_t * deshredder ) {
+  return fd_deshredder_map_join( (void *)((ulong)deshredder + deshredder->map_off) );
+}
+
+FD_FN_PURE static inline fd_deshredder_slot_t *
+fd_deshredder_slot_entry( fd_deshredder_t * deshredder,
+                          ulong             slot ) {
+  return (fd_deshredder_slot_t *)((ulong)deshredder + deshredder->slot_off) + (slot % deshredder->slot_max);
+}
+
+FD_FN_PURE static inline fd_deshredder_fec_t *
+fd_deshredder_set( fd_deshredder_t * deshredder ) {
+  return (fd_deshredder_fec_t *)((ulong)deshredder + deshredder->set_off);
+}
+
+/* fd_deshredder_key returns the map key of FEC set (slot,fec_set_idx),
+   slot in [0,FD_DESHREDDER_SLOT_MAX) and fec_set_idx in
+   [0,FD_DESHREDDER_SLOT_DATA_SHREDS_MAX).  Never returns the null key. */
+
+FD_FN_CONST static inline ulong
+fd_deshredder_key( ulong slot,
+                   ulong fec_set_idx ) {
+  return ((slot<<15) | fec_set_idx) + 1UL;
+}
+
+FD_STATIC_ASSERT( FD_DESHREDDER_SLOT_DATA_SHREDS_MAX==(1UL<<15), update_fd_deshredder_key );
+
+static fd_deshredder_fec_t *
+fd_deshredder_query( fd_deshredder_t * deshredder,
+                     ulong             slot,
+                     ulong             fec_set_idx ) {
+  fd_deshredder_map_t * entry = fd_deshredder_map_query( fd_deshredder_map( deshredder ), fd_deshredder_key( slot, fec_set_idx ), NULL );
+  return entry ? fd_deshredder_set( deshredder ) + entry->set_idx : NULL;
+}
+
+/* fd_deshredder_rcvd_any_from returns 1 if any position in [k,max) of
+   rcvd is set and 0 otherwise. */
+
+FD_FN_PURE static inline int
+fd_deshredder_rcvd_any_from( fd_deshredder_rcvd_t const * rcvd,
+                             ulong                        k ) {
+  for( ; k<FD_DESHREDDER_DATA_SHREDS_MAX; k++ ) if( fd_deshredder_rcvd_test( rcvd, k ) ) return 1;
+  return 0;
+}
+
+/* fd_deshredder_free returns the buffer of set to the pool. */
+
+static void
+fd_deshredder_free( fd_deshredder_t *     deshredder,
+                    fd_deshredder_fec_t * set ) {
+  fd_deshredder_map_t * map = fd_deshredder_map( deshredder );
+  fd_deshredder_map_remove( map, fd_deshredder_map_query( map, set->key, NULL ) );
+
+  fd_deshredder_slot_entry( deshredder, set->slot )->set_cnt--;
+
+  set->key         = 0UL;
+  set->next        = (uint)deshredder->free;
+  deshredder->free = (ulong)(set - fd_deshredder_set( deshredder ));
+  deshredder->set_cnt--;
+}
+
+/* fd_deshredder_evict frees all the buffers holding sets of slots in
+   [slot_lo,slot_hi) and rewinds the scans of the slots that lost sets.
+   Returns the number of buffers freed. */
+
+static ulong
+fd_deshredder_evict( fd_deshredder_t * deshredder,
+                     ulong             slot_lo,
+                     ulong             slot_hi ) {
+  fd_deshredder_fec_t * set   = fd_deshredder_set( deshredder );
+  ulong                 freed = 0UL;
+  for( ulong i=0UL; i<deshredder->set_max; i++ ) {
+    if( FD_LIKELY( (!set[i].key) | (set[i].slot<slot_lo) | (set[i].slot>=slot_hi) ) ) continue;
+    fd_deshredder_slot_t * entry = fd_deshredder_slot_entry( deshredder, set[i].slot );
+    entry->scan_idx = entry->cursor_idx;
+    entry->scan_set = entry->cursor_set;
+    fd_deshredder_free( deshredder, set+i );
+    freed++;
+  }
+  return freed;
+}
+
+/* fd_deshredder_alloc returns a free FEC set buffer, evicting the sets
+   of the oldest slot with sets buffered if there is none. */
+
+static fd_deshredder_fec_t *
+fd_deshredder_alloc( fd_deshredder_t * deshredder ) {
+  if( FD_UNLIKELY( deshredder->free>=deshredder->set_max ) ) {
+    fd_deshredder_slot_t * entry  = (fd_deshredder_slot_t *)((ulong)deshredder + deshredder->slot_off);
+    ulong                  oldest = ULONG_MAX;
+    for( ulong i=0UL; i<deshredder->slot_max; i++ ) if( entry[i].set_cnt ) oldest = fd_ulong_min( oldest, entry[i].slot );
+    deshredder->evict_cnt += fd_deshredder_evict( deshredder, oldest, oldest+1UL );
+  }
+
+  fd_deshredder_fec_t * set = fd_deshredder_set( deshredder ) + deshredder->free;
+  deshredder->free = (ulong)set->next;
+  deshredder->set_cnt++;
+  return set;
+}
+
+/* fd_deshredder_data_hdr_ok returns 1 if the data shred specific
+   header fields of shred are sane and 0 otherwise. */
+
+FD_FN_PURE static inline int
+fd_deshredder_data_hdr_ok( fd_shred_t const * shred ) {
+  ulong sz = (ulong)shred->data.size;
+  return (sz>=FD_SHRED_DATA_HEADER_SZ) & (sz<=FD_SHRED_DATA_HEADER_SZ+fd_shred_data_capacity( shred->variant )) &
+         ((ulong)shred->data.parent_off<=shred->slot);
+}
+
+/* fd_deshredder_recover recovers the missing shreds of set, which has
+   at least data_cnt shreds present (coding shreds included).  Returns 1
+   on success (all shreds of set present) and 0 if the result does not
+   match the set's Merkle root or the recovered data shreds are
+   malformed (set is garbage). */
+
+static int
+fd_deshredder_recover( fd_deshredder_t *     deshredder,
+                       fd_deshredder_fec_t * set ) {
+  ulong d = (ulong)set->data_cnt;
+  ulong p = (ulong)set->parity_cnt;
+  ulong n = d + p;
+  if( FD_UNLIKELY( (!d) | (!p) ) ) return 0; /* Not reachable, d and p are known */
+
+  uchar data_variant = fd_shred_variant( FD_SHRED_TYPE_MERKLE_DATA, set->merkle_cnt );
+  uchar code_variant = fd_shred_variant( FD_SHRED_TYPE_MERKLE_CODE, set->merkle_cnt );
+  ulong merkle_off   = fd_shred_merkle_off( data_variant );
+  ulong erasure_sz   = fd_shred_erasure_sz( data_variant );
+  ulong data_end     = fd_shred_erasure_off( data_variant ) + erasure_sz;
+
+  uchar *       shred [ FD_DESHREDDER_SHREDS_MAX ];
+  uchar *       shard [ FD_DESHREDDER_SHREDS_MAX ];
+  uchar         erased[ FD_DESHREDDER_SHREDS_MAX ];
+  uchar const * code  = NULL; /* A coding shred received, for its headers */
+  for( ulong k=0UL; k<n; k++ ) {
+    int is_data = (k<d);
+    shred [k] = is_data ? set->shred[k] : set->shred[ FD_DESHREDDER_DATA_SHREDS_MAX+k-d ];
+    shard [k] = shred[k] + fd_shred_erasure_off( is_data ? data_variant : code_variant );
+    erased[k] = (uchar)!(is_data ? fd_deshredder_rcvd_test( set->data_rcvd, k ) : fd_deshredder_rcvd_test( set->code_rcvd, k-d ));
+    if( (!is_data) & (!erased[k]) ) code = shred[k];
+  }
+
+  if( FD_UNLIKELY( fd_reedsol_recover( erasure_sz, shard, erased, d, p )!=FD_REEDSOL_SUCCESS ) ) return 0;
+
+  /* Recovered shreds are missing everything outside their erasure
+     shard.  Data shreds are zero between the end of their erasure shard
+     and their Merkle nodes.  Coding shred headers are the same for all
+     coding shreds of a set but for the indices. */
+
+  for( ulong k=0UL; k<n; k++ ) {
+    if( !erased[k] ) continue;
+    fd_memcpy( shred[k], set->signature, FD_ED25519_SIG_SZ );
+    if( k<d ) {
+      fd_memset( shred[k] + data_end, 0, merkle_off - data_end );
+    } else {
+      fd_memcpy( shred[k] + FD_ED25519_SIG_SZ, code + FD_ED25519_SIG_SZ, FD_SHRED_CODE_HEADER_SZ - FD_ED25519_SIG_SZ );
+      fd_shred_t * hdr = (fd_shred_t *)shred[k];
+      hdr->idx      = set->code_idx0 + (uint)(k-d);
+      hdr->code.idx = (ushort)(k-d);
+    }
+  }
+
+  /* The set is only usable if it is the set the leader committed to */
+
+  void const * leaf   [ FD_DESHREDDER_SHREDS_MAX ];
+  ulong        leaf_sz[ FD_DESHREDDER_SHREDS_MAX ];
+  for( ulong k=0UL; k<n; k++ ) {
+    leaf   [k] = shred[k] + FD_ED25519_SIG_SZ;
+    leaf_sz[k] = merkle_off - FD_ED25519_SIG_SZ;
+  }
+  fd_bmtree20_hash_leaf_batch( deshredder->tree, leaf, leaf_sz, n );
+  uchar const * root = fd_bmtree20_tree_build( deshredder->tree, n );
+  if( FD_UNLIKELY( memcmp( root, set->root, FD_SHRED_MERKLE_NODE_SZ ) ) ) return 0;
+
+  /* Committed to doesn't mean well formed */
+
+  for( ulong k=0UL; k<d; k++ ) {
+    if( !erased[k] ) continue;
+    fd_shred_t const * hdr = (fd_shred_t const *)shred[k];
+    if( FD_UNLIKELY( (hdr->variant!=data_variant) | (hdr->slot!=set->slot) | (hdr->idx!=set->fec_set_idx+(uint)k) |
+                     (hdr->version!=set->version) | (hdr->fec_set_idx!=set->fec_set_idx) | !fd_deshredder_data_hdr_ok( hdr ) ) ) return 0;
+  }
+
+  /* Complete the recovered shreds with their Merkle nodes (set->merkle_cnt
+     is consistent with n, see fd_deshredder_insert) */
+
+  for( ulong k=0UL; k<n; k++ ) {
+    if( !erased[k] ) continue;
+    fd_memcpy( shred[k] + merkle_off, root, FD_SHRED_MERKLE_NODE_SZ );
+    fd_bmtree20_tree_proof( deshredder->tree, n, k, shred[k] + merkle_off + FD_SHRED_MERKLE_NODE_SZ );
+  }
+
+  for( ulong k=0UL; k<d; k++ ) fd_deshredder_rcvd_insert( set->data_rcvd, k );
+  for( ulong j=0UL; j<p; j++ ) fd_deshredder_rcvd_insert( set->code_rcvd, j );
+  deshredder->recover_cnt++;
+  return 1;
+}
+
+ulong
+fd_deshredder_align( void ) {
+  return FD_DESHREDDER_ALIGN;
+}
+
+ulong
+fd_deshredder_footprint( ulong set_max,
+                         ulong slot_max ) {
+  if( FD_UNLIKELY( (!set_max) | (set_max>(1UL<<20)) | (!slot_max) | (slot_max>(1UL<<20)) ) ) return 0UL;
+  return fd_ulong_align_up( fd_deshredder_set_off( set_max, slot_max ) + set_max*sizeof(fd_deshredder_fec_t), FD_DESHREDDER_ALIGN );
+}
+
+void *
+fd_deshredder_new( void * shmem,
+                   ulong  set_max,
+                   ulong  slot_max,
+                   ulong  slot_min0 ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_deshredder_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_deshredder_footprint( set_max, slot_max ) ) ) {
+    FD_LOG_WARNING(( "bad set_max (%lu) or slot_max (%lu)", set_max, slot_max ));
+    return NULL;
+  }
+
+  fd_deshredder_t * deshredder = (fd_deshredder_t *)shmem;
+  fd_memset( deshredder, 0, sizeof(fd_deshredder_t) );
+
+  deshredder->set_max     = set_max;
+  deshredder->slot_max    = slot_max;
+  deshredder->slot_min    = slot_min0;
+  deshredder->last_slot   = ULONG_MAX;
+  deshredder->set_cnt     = 0UL;
+  deshredder->free        = 0UL;
+  deshredder->recover_cnt = 0UL;
+  deshredder->evict_cnt   = 0UL;
+  deshredder->drop_cnt    = 0UL;
+  deshredder->map_off     = fd_deshredder_map_off();
+  deshredder->slot_off    = fd_deshredder_slot_off( set_max );
+  deshredder->set_off     = fd_deshredder_set_off( set_max, slot_max );
+
+  fd_deshredder_map_new( (void *)((ulong)shmem + deshredder->map_off), fd_deshredder_lg_slot_cnt( set_max ) );
+
+  fd_deshredder_slot_t * entry = (fd_deshredder_slot_t *)((ulong)shmem + deshredder->slot_off);
+  for( ulong i=0UL; i<slot_max; i++ ) {
+    fd_memset( entry+i, 0, sizeof(fd_deshredder_slot_t) );
+    entry[i].slot = ULONG_MAX;
+  }
+
+  /* Only the headers of the FEC set buffers are initialized (the shred
+     storage is written before it is read) */
+
+  fd_deshredder_fec_t * set = fd_deshredder_set( deshredder );
+  for( ulong i=0UL; i<set_max; i++ ) {
+    set[i].key  = 0UL;
+    set[i].next = (uint)(i+1UL);
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( deshredder->magic ) = FD_DESHREDDER_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_deshredder_t *
+fd_deshredder_join( void * shdeshredder ) {
+
+  if( FD_UNLIKELY( !shdeshredder ) ) {
+    FD_LOG_WARNING(( "NULL shdeshredder" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shdeshredder, fd_deshredder_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shdeshredder" ));
+    return NULL;
+  }
+
+  fd_deshredder_t * deshredder = (fd_deshredder_t *)shdeshredder;
+  if( FD_UNLIKELY( deshredder->magic!=FD_DESHREDDER_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return deshredder;
+}
+
+void *
+fd_deshredder_leave( fd_deshredder_t * deshredder ) {
+
+  if( FD_UNLIKELY( !deshredder ) ) {
+    FD_LOG_WARNING(( "NULL deshredder" ));
+    return NULL;
+  }
+
+  return (void *)deshredder;
+}
+
+void *
+fd_deshredder_delete( void * shdeshredder ) {
+
+  if( FD_UNLIKELY( !shdeshredder ) ) {
+    FD_LOG_WARNING(( "NULL shdeshredder" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shdeshredder, fd_deshredder_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shdeshredder" ));
+    return NULL;
+  }
+
+  fd_deshredder_t * deshredder = (fd_deshredder_t *)shdeshredder;
+  if( FD_UNLIKELY( deshredder->magic!=FD_DESHREDDER_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( deshredder->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shdeshredder;
+}
+
+ulong fd_deshredder_set_max    ( fd_deshredder_t const * deshredder ) { return deshredder->set_max;     }
+ulong fd_deshredder_slot_max   ( fd_deshredder_t const * deshredder ) { return deshredder->slot_max;    }
+ulong fd_deshredder_slot_min   ( fd_deshredder_t const * deshredder ) { return deshredder->slot_min;    }
+ulong fd_deshredder_set_cnt    ( fd_deshredder_t const * deshredder ) { return deshredder->set_cnt;     }
+ulong fd_deshredder_recover_cnt( fd_deshredder_t const * deshredder ) { return deshredder->recover_cnt; }
+ulong fd_deshredder_evict_cnt  ( fd_deshredder_t const * deshredder ) { return deshredder->evict_cnt;   }
+ulong fd_deshredder_drop_cnt   ( fd_deshredder_t const * deshredder ) { return deshredder->drop_cnt;    }
+
+int
+fd_deshredder_insert( fd_deshredder_t * deshredder,
+                      uchar const *     buf ) {
+
+  fd_shred_t const * shred = fd_shred_parse( buf );
+  if( FD_UNLIKELY( !shred ) ) return FD_DESHREDDER_ERR_INVALID;
+
+  uchar variant = shred->variant;
+  uchar type    = fd_shred_type( variant );
+  int   is_data = (type==FD_SHRED_TYPE_MERKLE_DATA);
+  if( FD_UNLIKELY( (!is_data) & (type!=FD_SHRED_TYPE_MERKLE_CODE) ) ) return FD_DESHREDDER_ERR_INVALID;
+
+  ulong slot        = shred->slot;
+  ulong idx         = (ulong)shred->idx;
+  ulong fec_set_idx = (ulong)shred->fec_set_idx;
+  if( FD_UNLIKELY( (slot<deshredder->slot_min) | (slot-deshredder->slot_min>=deshredder->slot_max) |
+                   (slot>=FD_DESHREDDER_SLOT_MAX) ) ) return FD_DESHREDDER_ERR_SLOT;
+
+  /* Checks that only depend on the shred */
+
+  ulong merkle_cnt = (ulong)fd_shred_merkle_cnt( variant );
+  ulong off        = 0UL; /* Position in the set */
+  ulong d          = 0UL;
+  ulong p          = 0UL;
+  if( is_data ) {
+    off = idx - fec_set_idx;
+    if( FD_UNLIKELY( (idx<fec_set_idx) | (off>=FD_DESHREDDER_DATA_SHREDS_MAX) | (idx>=FD_DESHREDDER_SLOT_DATA_SHREDS_MAX) |
+                     !fd_deshredder_data_hdr_ok( shred ) ) ) return FD_DESHREDDER_ERR_INVALID;
+  } else {
+    off = (ulong)shred->code.idx;
+    d   = (ulong)shred->code.data_cnt;
+    p   = (ulong)shred->code.code_cnt;
+    if( FD_UNLIKELY( (!d) | (d>FD_DESHREDDER_DATA_SHREDS_MAX) | (!p) | (p>FD_DESHREDDER_PARITY_SHREDS_MAX) |
+                     (off>=p) | (idx<off) | (fec_set_idx>=FD_DESHREDDER_SLOT_DATA_SHREDS_MAX) ) ) return FD_DESHREDDER_ERR_INVALID;
+
+    /* The Merkle proofs have to be exactly as long as the tree over the
+       set is deep (recovery writes them) */
+
+    if( FD_UNLIKELY( merkle_cnt!=2UL+(ulong)fd_ulong_find_msb( d+p-1UL ) ) ) return FD_DESHREDDER_ERR_INVALID;
+  }
+
+  /* Checks against the slot and the set */
+
+  fd_deshredder_slot_t * entry = fd_deshredder_slot_entry( deshredder, slot );
+  if( FD_UNLIKELY( entry->slot!=slot ) ) { /* First shred of the slot (entry is from a slot before the window) */
+    entry->slot       = slot;
+    entry->set_cnt    = 0UL;
+    entry->cursor_idx = 0U;
+    entry->cursor_set = 0U;
+    entry->scan_idx   = 0U;
+    entry->scan_set   = 0U;
+    entry->complete   = 0;
+  }
+
+  if( FD_UNLIKELY( entry->complete | (fec_set_idx<(ulong)entry->cursor_set) | (is_data & (idx<(ulong)entry->cursor_idx)) ) )
+    return FD_DESHREDDER_ERR_STALE;
+
+  uchar const *         root = (uchar const *)fd_shred_merkle_nodes( shred );
+  fd_deshredder_fec_t * set  = fd_deshredder_query( deshredder, slot, fec_set_idx );
+
+  ulong data_cnt = set ? (ulong)set->data_cnt : 0UL; /* data_cnt of the set after inserting, 0 if not known */
+  if( FD_LIKELY( set ) ) {
+    if( FD_UNLIKELY( (merkle_cnt!=(ulong)set->merkle_cnt) | (shred->version!=set->version) |
+                     !!memcmp( shred->signature, set->signature, FD_ED25519_SIG_SZ      ) |
+                     !!memcmp( root,             set->root,      FD_SHRED_MERKLE_NODE_SZ ) ) ) return FD_DESHREDDER_ERR_INVALID;
+  }
+
+  if( is_data ) {
+    if( FD_UNLIKELY( set && fd_deshredder_rcvd_test( set->data_rcvd, off ) ) ) return FD_DESHREDDER_ERR_DUPLICATE;
+
+    /* The data shred that ends a batch ends its set and no set has more
+       than FD_DESHREDDER_DATA_SHREDS_MAX data shreds */
+
+    ulong implied = 0UL;
+    if(      shred->data.flags & FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE ) implied = off+1UL;
+    else if( off==FD_DESHREDDER_DATA_SHREDS_MAX-1UL                  ) implied = FD_DESHREDDER_DATA_SHREDS_MAX;
+    if( implied ) {
+      if( FD_UNLIKELY( data_cnt && data_cnt!=implied ) ) return FD_DESHREDDER_ERR_INVALID;
+      if( FD_UNLIKELY( set && !data_cnt && fd_deshredder_rcvd_any_from( set->data_rcvd, implied ) ) ) return FD_DESHREDDER_ERR_INVALID;
+      data_cnt = implied;
+    }
+    if( FD_UNLIKELY( data_cnt && off>=data_cnt ) ) return FD_DESHREDDER_ERR_INVALID;
+  } else {
+    if( FD_UNLIKELY( set && fd_deshredder_rcvd_test( set->code_rcvd, off ) ) ) return FD_DESHREDDER_ERR_DUPLICATE;
+    if( FD_UNLIKELY( data_cnt && data_cnt!=d ) ) return FD_DESHREDDER_ERR_INVALID;
+    if( set ) {
+      if( FD_UNLIKELY( set->parity_cnt && ((ulong)set->parity_cnt!=p || (ulong)set->code_idx0!=idx-off) ) ) return FD_DESHREDDER_ERR_INVALID;
+      if( FD_UNLIKELY( fd_deshredder_rcvd_any_from( set->data_rcvd, d ) ) ) return FD_DESHREDDER_ERR_INVALID;
+    }
+    data_cnt = d;
+  }
+
+  /* Buffer the shred */
+
+  if( FD_UNLIKELY( !set ) ) {
+    set = fd_deshredder_alloc( deshredder );
+
+    set->key         = fd_deshredder_key( slot, fec_set_idx );
+    set->slot        = slot;
+    set->fec_set_idx = (uint)fec_set_idx;
+    set->code_idx0   = 0U;
+    set->data_cnt    = (uchar)0;
+    set->parity_cnt  = (uchar)0;
+    set->merkle_cnt  = (uchar)merkle_cnt;
+    set->version     = shred->version;
+    fd_deshredder_rcvd_null( set->data_rcvd );
+    fd_deshredder_rcvd_null( set->code_rcvd );
+    fd_memcpy( set->signature, shred->signature, FD_ED25519_SIG_SZ       );
+    fd_memcpy( set->root,      root,             FD_SHRED_MERKLE_NODE_SZ );
+
+    fd_deshredder_map_insert( fd_deshredder_map( deshredder ), set->key )->set_idx = (ulong)(set - fd_deshredder_set( deshredder ));
+    fd_deshredder_slot_entry( deshredder, slot )->set_cnt++;
+  }
+
+  set->data_cnt = (uchar)data_cnt;
+  if( is_data ) {
+    fd_memcpy( set->shred[ off ], buf, FD_SHRED_SZ );
+    fd_deshredder_rcvd_insert( set->data_rcvd, off );
+  } else {
+    fd_memcpy( set->shred[ FD_DESHREDDER_DATA_SHREDS_MAX+off ], buf, FD_SHRED_SZ );
+    fd_deshredder_rcvd_insert( set->code_rcvd, off );
+    set->parity_cnt = (uchar)p;
+    set->code_idx0  = (uint)(idx-off);
+  }
+
+  deshredder->last_slot = slot;
+
+  /* Recover the set as soon as there are enough shreds */
+
+  if( set->parity_cnt ) {
+    ulong data_rcvd_cnt = fd_deshredder_rcvd_cnt( set->data_rcvd );
+    if( (data_rcvd_cnt<data_cnt) && (data_rcvd_cnt+fd_deshredder_rcvd_cnt( set->code_rcvd )>=data_cnt) ) {
+      if( FD_UNLIKELY( !fd_deshredder_recover( deshredder, set ) ) ) {
+        fd_deshredder_free( deshredder, set );
+        entry->scan_idx = entry->cursor_idx;
+        entry->scan_set = entry->cursor_set;
+        deshredder->drop_cnt++;
+        return FD_DESHREDDER_ERR_INVALID;
+      }
+    }
+  }
+
+  return FD_DESHREDDER_SUCCESS;
+}
+
+fd_shredder_batch_meta_t *
+fd_deshredder_next_batch( fd_deshredder_t *          deshredder,
+                          uchar *                    batch,
+                          ulong                      batch_max,
+                          ulong *                    _batch_sz,
+                          fd_shredder_batch_meta_t * meta ) {
+  ulong slot = deshredder->last_slot;
+  if( FD_UNLIKELY( (slot==ULONG_MAX) || (slot<deshredder->slot_min) ) ) return NULL;
+
+  fd_deshredder_slot_t * entry = fd_deshredder_slot_entry( deshredder, slot );
+  if( FD_UNLIKELY( (entry->slot!=slot) | entry->complete ) ) return NULL;
+
+  for(;;) {
+
+    /* Extend the scan up to the end of the next batch */
+
+    fd_deshredder_fec_t * set = NULL;
+    for(;;) {
+      if( !set || set->fec_set_idx!=entry->scan_set ) {
+        set = fd_deshredder_query( deshredder, slot, (ulong)entry->scan_set );
+        if( !set ) return NULL;
+      }
+      ulong off = (ulong)(entry->scan_idx - entry->scan_set);
+      if( set->data_cnt && off>=(ulong)set->data_cnt ) { entry->scan_set += (uint)set->data_cnt; continue; }
+      if( (off>=FD_DESHREDDER_DATA_SHREDS_MAX) || !fd_deshredder_rcvd_test( set->data_rcvd, off ) ) return NULL;
+      entry->scan_idx++;
+      if( ((fd_shred_t const *)set->shred[ off ])->data.flags & FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE ) break;
+    }
+
+    /* Data shreds [cursor_idx,scan_idx) are the batch.  Copy it out,
+       releasing the sets it completes. */
+
+    ulong batch_sz = 0UL;
+    uchar flags    = (uchar)0;
+    set = fd_deshredder_query( deshredder, slot, (ulong)entry->cursor_set );
+    fd_shred_t const * first = (fd_shred_t const *)set->shred[ entry->cursor_idx - entry->cursor_set ];
+    meta->slot       = slot;
+    meta->parent_off = first->data.parent_off;
+    meta->version    = first->version;
+
+    for( uint idx=entry->cursor_idx; idx<entry->scan_idx; idx++ ) {
+      ulong              off   = (ulong)(idx - entry->cursor_set);
+      fd_shred_t const * shred = (fd_shred_t const *)set->shred[ off ];
+      ulong              sz    = (ulong)shred->data.size - FD_SHRED_DATA_HEADER_SZ;
+      if( FD_LIKELY( batch_sz+sz<=batch_max ) ) fd_memcpy( batch + batch_sz, fd_shred_data_payload( shred ), sz );
+      batch_sz += sz;
+      flags     = shred->data.flags;
+
+      if( off+1UL==(ulong)set->data_cnt ) { /* Last data shred of the set */
+        entry->cursor_set += (uint)set->data_cnt;
+        fd_deshredder_free( deshredder, set );
+        if( idx+1U<entry->scan_idx ) set = fd_deshredder_query( deshredder, slot, (ulong)entry->cursor_set );
+      }
+    }
+    entry->cursor_idx = entry->scan_idx;
+    entry->scan_set   = entry->cursor_set;
+
+    meta->ref_tick       = (uchar)(flags & FD_SHRED_DATA_REF_TICK_MASK);
+    meta->block_complete = (uchar)!!(flags & FD_SHRED_DATA_FLAG_SLOT_COMPLETE);
+
+    if( FD_UNLIKELY( meta->block_complete ) ) {
+      entry->complete = 1;
+      if( entry->set_cnt ) fd_deshredder_evict( deshredder, slot, slot+1UL ); /* Sets past the end of the slot */
+    }
+
+    if( FD_UNLIKELY( batch_sz>batch_max ) ) {
+      deshredder->drop_cnt++;
+      if( entry->complete ) return NULL;
+      continue;
+    }
+
+    *_batch_sz = batch_sz;
+    return meta;
+  }
+}
+
+fd_deshredder_t *
+fd_deshredder_advance( fd_deshredder_t * deshredder,
+                       ulong             slot_min ) {
+  if( FD_UNLIKELY( slot_min<=deshredder->slot_min ) ) return deshredder;
+  fd_deshredder_evict( deshredder, 0UL, slot_min );
+  deshredder->slot_min = slot_min;
+  return deshredder;
+}
@@ -44,6 +44,15 @@
 
    FEC sets and entry batches do not necessarily align.
 
+   The Reed-Solomon code (see ballet/reedsol) covers an equal sized
+   "erasure shard" of every shred in an FEC set: for coding shreds, the
+   coding payload and for data shreds, everything past the signature
+   (the whole shred for legacy data shreds) truncated to the size of a
+   coding payload.  Thus, data shreds carry a few bytes less payload
+   than coding shreds and the bytes of a data shred between its
+   erasure shard and its Merkle nodes are zero.  See
+   fd_shred_erasure_{off,sz}.
+
    ### Merkle Inclusion Proofs
 
    Data and coding shreds come in two variants respectively: legacy and merkle.
@@ -147,7 +156,8 @@ struct __attribute__((packed)) fd_shred {
           [..XX XXXX] Reference tick number */
       /* 0x55 */ uchar  flags;
 
-      /* Actual shred size including headers and Merkle proof */
+      /* Size of the headers plus the data payload (i.e. the offset of
+         the first byte past the data payload) */
       /* 0x56 */ ushort size;
     } data;
 
@@ -273,7 +283,33 @@ fd_shred_code_payload( fd_shred_t const * shred ) {
   return (uchar const *)shred + FD_SHRED_CODE_HEADER_SZ;
 }
 
-/*  */
+/* fd_shred_erasure_off: Returns the byte offset of the erasure shard of
+   a shred (the part of the shred covered by the Reed-Solomon code).
+   Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_erasure_off( uchar variant ) {
+  uchar type = fd_shred_type( variant );
+  if( FD_LIKELY( type==FD_SHRED_TYPE_MERKLE_DATA ) ) return FD_ED25519_SIG_SZ;
+  if( FD_LIKELY( type==FD_SHRED_TYPE_LEGACY_DATA ) ) return 0UL;
+  return FD_SHRED_CODE_HEADER_SZ;
+}
+
+/* fd_shred_erasure_sz: Returns the byte size of the erasure shard of a
+   shred.  This is the same for the data and coding shreds of an FEC set
+   (whose shreds all have the same number of Merkle nodes).
+   Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_erasure_sz( uchar variant ) {
+  return FD_SHRED_SZ - FD_SHRED_CODE_HEADER_SZ - fd_shred_merkle_sz( variant );
+}
+
+/* fd_shred_data_capacity: Returns the maximum data payload size of a
+   data shred (the part of fd_shred_payload_sz covered by the erasure
+   shard).  Returns an arbitrary value if the variant is invalid. */
+FD_FN_CONST static inline ulong
+fd_shred_data_capacity( uchar variant ) {
+  return fd_shred_erasure_off( variant ) + fd_shred_erasure_sz( variant ) - FD_SHRED_DATA_HEADER_SZ;
+}
 
 FD_PROTOTYPES_END
 
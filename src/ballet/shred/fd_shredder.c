@@ -0,0 +1,311 @@
+#include "fd_shredder.h"
+#include "../reedsol/fd_reedsol.h"
+
+FD_STATIC_ASSERT( alignof(fd_shredder_t)==FD_SHREDDER_ALIGN,     shredder_align     );
+FD_STATIC_ASSERT( sizeof (fd_shredder_t)==FD_SHREDDER_FOOTPRINT, shredder_footprint );
+
+FD_STATIC_ASSERT( FD_SHREDDER_DATA_SHREDS_PER_FEC_SET<=FD_REEDSOL_DATA_SHREDS_MAX,   shredder_reedsol );
+FD_STATIC_ASSERT( FD_SHREDDER_PARITY_SHREDS_MAX      <=FD_REEDSOL_PARITY_SHREDS_MAX, shredder_reedsol );
+
+ulong fd_shredder_align    ( void ) { return FD_SHREDDER_ALIGN;     }
+ulong fd_shredder_footprint( void ) { return FD_SHREDDER_FOOTPRINT; }
+
+void *
+fd_shredder_new( void *       shmem,
+                 void const * public_key,
+                 void const * private_key ) {
+  fd_shredder_t * shredder = (fd_shredder_t *)shmem;
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_shredder_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( (!public_key) | (!private_key) ) ) {
+    FD_LOG_WARNING(( "NULL key" ));
+    return NULL;
+  }
+
+  fd_memset( shredder, 0, fd_shredder_footprint() );
+
+  if( FD_UNLIKELY( !fd_sha512_join( fd_sha512_new( shredder->sha ) ) ) ) return NULL; /* logs details */
+
+  fd_memcpy( shredder->public_key,  public_key,  32UL );
+  fd_memcpy( shredder->private_key, private_key, 32UL );
+  shredder->slot = ULONG_MAX;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( shredder->magic ) = FD_SHREDDER_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return (void *)shredder;
+}
+
+fd_shredder_t *
+fd_shredder_join( void * shshredder ) {
+
+  if( FD_UNLIKELY( !shshredder ) ) {
+    FD_LOG_WARNING(( "NULL shshredder" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shshredder, fd_shredder_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shshredder" ));
+    return NULL;
+  }
+
+  fd_shredder_t * shredder = (fd_shredder_t *)shshredder;
+
+  if( FD_UNLIKELY( shredder->magic!=FD_SHREDDER_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return shredder;
+}
+
+void *
+fd_shredder_leave( fd_shredder_t * shredder ) {
+
+  if( FD_UNLIKELY( !shredder ) ) {
+    FD_LOG_WARNING(( "NULL shredder" ));
+    return NULL;
+  }
+
+  return (void *)shredder;
+}
+
+void *
+fd_shredder_delete( void * shshredder ) {
+
+  if( FD_UNLIKELY( !shshredder ) ) {
+    FD_LOG_WARNING(( "NULL shshredder" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shshredder, fd_shredder_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shshredder" ));
+    return NULL;
+  }
+
+  fd_shredder_t * shredder = (fd_shredder_t *)shshredder;
+
+  if( FD_UNLIKELY( shredder->magic!=FD_SHREDDER_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( shredder->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  fd_sha512_delete( fd_sha512_leave( shredder->sha ) );
+  fd_memset( shredder->private_key, 0, 32UL );
+  FD_COMPILER_MFENCE();
+
+  return (void *)shredder;
+}
+
+/* fd_shredder_private_merkle_cnt returns the number of Merkle nodes
+   (root plus inclusion proof) in the shreds of an FEC set with
+   data_shred_cnt data shreds.  The proof has one node per tree layer
+   below the root, ceil(log2(shred_cnt)) (shred_cnt is at least 18). */
+
+FD_FN_CONST static inline ulong
+fd_shredder_private_merkle_cnt( ulong data_shred_cnt ) {
+  ulong shred_cnt = data_shred_cnt + fd_shredder_parity_shred_cnt( data_shred_cnt );
+  return 2UL + (ulong)fd_ulong_find_msb( shred_cnt-1UL );
+}
+
+FD_FN_CONST static inline ulong
+fd_shredder_private_data_capacity( ulong data_shred_cnt ) {
+  uchar variant = fd_shred_variant( FD_SHRED_TYPE_MERKLE_DATA, (uchar)fd_shredder_private_merkle_cnt( data_shred_cnt ) );
+  return fd_shred_data_capacity( variant );
+}
+
+/* fd_shredder_private_last_set returns the number of data shreds in
+   the last FEC set of a batch with rem bytes left, assuming rem is at
+   most the payload of a full set.  This is the fewest that fit (the
+   data capacity of a shred shrinks as sets grow but set capacity still
+   grows with the data shred count). */
+
+FD_FN_CONST static ulong
+fd_shredder_private_last_set( ulong rem ) {
+  ulong d = 1UL;
+  while( d*fd_shredder_private_data_capacity( d )<rem ) d++;
+  return d;
+}
+
+/* fd_shredder_private_full_set_cnt returns the number of full FEC sets
+   preceding the last FEC set of a batch_sz byte batch. */
+
+FD_FN_CONST static inline ulong
+fd_shredder_private_full_set_cnt( ulong batch_sz ) {
+  ulong full_sz = FD_SHREDDER_DATA_SHREDS_PER_FEC_SET*fd_shredder_private_data_capacity( FD_SHREDDER_DATA_SHREDS_PER_FEC_SET );
+  return batch_sz ? (batch_sz-1UL)/full_sz : 0UL;
+}
+
+FD_FN_CONST static inline ulong
+fd_shredder_private_last_set_sz( ulong batch_sz ) {
+  ulong full_sz = FD_SHREDDER_DATA_SHREDS_PER_FEC_SET*fd_shredder_private_data_capacity( FD_SHREDDER_DATA_SHREDS_PER_FEC_SET );
+  return batch_sz - fd_shredder_private_full_set_cnt( batch_sz )*full_sz;
+}
+
+ulong
+fd_shredder_count_fec_sets( ulong batch_sz ) {
+  return fd_shredder_private_full_set_cnt( batch_sz ) + 1UL;
+}
+
+ulong
+fd_shredder_count_data_shreds( ulong batch_sz ) {
+  return fd_shredder_private_full_set_cnt( batch_sz )*FD_SHREDDER_DATA_SHREDS_PER_FEC_SET
+       + fd_shredder_private_last_set( fd_shredder_private_last_set_sz( batch_sz ) );
+}
+
+ulong
+fd_shredder_count_parity_shreds( ulong batch_sz ) {
+  return fd_shredder_private_full_set_cnt( batch_sz )*fd_shredder_parity_shred_cnt( FD_SHREDDER_DATA_SHREDS_PER_FEC_SET )
+       + fd_shredder_parity_shred_cnt( fd_shredder_private_last_set( fd_shredder_private_last_set_sz( batch_sz ) ) );
+}
+
+fd_shredder_t *
+fd_shredder_init_batch( fd_shredder_t *                  shredder,
+                        void const *                     batch,
+                        ulong                            batch_sz,
+                        fd_shredder_batch_meta_t const * meta ) {
+  if( FD_UNLIKELY( meta->slot!=shredder->slot ) ) {
+    shredder->slot       = meta->slot;
+    shredder->data_idx   = 0U;
+    shredder->parity_idx = 0U;
+  }
+
+  shredder->batch       = (uchar const *)batch;
+  shredder->batch_sz    = batch_sz;
+  shredder->batch_off   = 0UL;
+  shredder->fec_set_rem = fd_shredder_count_fec_sets( batch_sz );
+  shredder->meta        = *meta;
+  return shredder;
+}
+
+fd_shredder_fec_set_t *
+fd_shredder_next_fec_set( fd_shredder_t *         shredder,
+                          uchar * const *         data_shred,
+                          uchar * const *         parity_shred,
+                          fd_shredder_fec_set_t * fec ) {
+  if( FD_UNLIKELY( !shredder->fec_set_rem ) ) return NULL;
+
+  int   last_set = (shredder->fec_set_rem==1UL);
+  ulong rem      = shredder->batch_sz - shredder->batch_off;
+  ulong d        = last_set ? fd_shredder_private_last_set( rem ) : FD_SHREDDER_DATA_SHREDS_PER_FEC_SET;
+  ulong p        = fd_shredder_parity_shred_cnt( d );
+  ulong n        = d + p;
+
+  uchar merkle_cnt     = (uchar)fd_shredder_private_merkle_cnt( d );
+  uchar data_variant   = fd_shred_variant( FD_SHRED_TYPE_MERKLE_DATA, merkle_cnt );
+  uchar parity_variant = fd_shred_variant( FD_SHRED_TYPE_MERKLE_CODE, merkle_cnt );
+  ulong merkle_off     = fd_shred_merkle_off    ( data_variant );
+  ulong capacity       = fd_shred_data_capacity ( data_variant );
+  ulong erasure_sz     = fd_shred_erasure_sz    ( data_variant );
+  uint  fec_set_idx    = shredder->data_idx;
+
+  uchar ref_tick = (uchar)fd_ulong_min( (ulong)shredder->meta.ref_tick, (ulong)FD_SHRED_DATA_REF_TICK_MASK );
+
+  /* Data shreds: headers, payload, zero padding up to the Merkle nodes */
+
+  uchar const * payload = shredder->batch + shredder->batch_off;
+  for( ulong i=0UL; i<d; i++ ) {
+    uchar *      buf   = data_shred[i];
+    fd_shred_t * shred = (fd_shred_t *)buf;
+    ulong        sz    = fd_ulong_min( capacity, rem );
+
+    uchar flags = ref_tick;
+    if( FD_UNLIKELY( last_set & (i==d-1UL) ) ) {
+      flags |= FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE;
+      if( shredder->meta.block_complete ) flags |= FD_SHRED_DATA_FLAG_SLOT_COMPLETE;
+    }
+
+    shred->variant         = data_variant;
+    shred->slot            = shredder->slot;
+    shred->idx             = fec_set_idx + (uint)i;
+    shred->version         = shredder->meta.version;
+    shred->fec_set_idx     = fec_set_idx;
+    shred->data.parent_off = shredder->meta.parent_off;
+    shred->data.flags      = flags;
+    shred->data.size       = (ushort)(FD_SHRED_DATA_HEADER_SZ + sz);
+
+    fd_memcpy( buf + FD_SHRED_DATA_HEADER_SZ, payload, sz );
+    fd_memset( buf + FD_SHRED_DATA_HEADER_SZ + sz, 0, merkle_off - FD_SHRED_DATA_HEADER_SZ - sz );
+
+    payload += sz;
+    rem     -= sz;
+  }
+
+  /* Coding shreds: headers, then parity computed straight from the data
+     shreds' erasure shards */
+
+  uchar const * shard       [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET ];
+  uchar *       parity_shard[ FD_SHREDDER_PARITY_SHREDS_MAX       ];
+  for( ulong i=0UL; i<d; i++ ) shard[i] = data_shred[i] + fd_shred_erasure_off( data_variant );
+
+  for( ulong j=0UL; j<p; j++ ) {
+    fd_shred_t * shred = (fd_shred_t *)parity_shred[j];
+
+    shred->variant       = parity_variant;
+    shred->slot          = shredder->slot;
+    shred->idx           = shredder->parity_idx + (uint)j;
+    shred->version       = shredder->meta.version;
+    shred->fec_set_idx   = fec_set_idx;
+    shred->code.data_cnt = (ushort)d;
+    shred->code.code_cnt = (ushort)p;
+    shred->code.idx      = (ushort)j;
+
+    parity_shard[j] = parity_shred[j] + fd_shred_erasure_off( parity_variant );
+  }
+
+  fd_reedsol_encode( erasure_sz, shard, d, parity_shard, p );
+
+  /* Merkle tree over every shred past its signature and up to its
+     Merkle nodes, data shreds first */
+
+  uchar *      shred_buf[ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+FD_SHREDDER_PARITY_SHREDS_MAX ];
+  void const * leaf     [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+FD_SHREDDER_PARITY_SHREDS_MAX ];
+  ulong        leaf_sz  [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+FD_SHREDDER_PARITY_SHREDS_MAX ];
+  for( ulong i=0UL; i<d; i++ ) shred_buf[i  ] = data_shred  [i];
+  for( ulong j=0UL; j<p; j++ ) shred_buf[d+j] = parity_shred[j];
+  for( ulong k=0UL; k<n; k++ ) {
+    leaf   [k] = shred_buf[k] + FD_ED25519_SIG_SZ;
+    leaf_sz[k] = merkle_off - FD_ED25519_SIG_SZ;
+  }
+
+  fd_bmtree20_hash_leaf_batch( shredder->tree, leaf, leaf_sz, n );
+  uchar const * root = fd_bmtree20_tree_build( shredder->tree, n );
+
+  /* Sign the root and finish every shred with the signature, the root
+     and its inclusion proof */
+
+  fd_ed25519_sig_t sig;
+  fd_ed25519_sign( sig, root, FD_SHRED_MERKLE_NODE_SZ, shredder->public_key, shredder->private_key, shredder->sha );
+
+  for( ulong k=0UL; k<n; k++ ) {
+    uchar * buf = shred_buf[k];
+    fd_memcpy( buf,              sig,  FD_ED25519_SIG_SZ       );
+    fd_memcpy( buf + merkle_off, root, FD_SHRED_MERKLE_NODE_SZ );
+    fd_bmtree20_tree_proof( shredder->tree, n, k, buf + merkle_off + FD_SHRED_MERKLE_NODE_SZ );
+  }
+
+  fec->data_shred_cnt   = d;
+  fec->parity_shred_cnt = p;
+  fec->fec_set_idx      = fec_set_idx;
+  fd_memcpy( fec->merkle_root, root, FD_SHRED_MERKLE_NODE_SZ );
+
+  shredder->batch_off    = shredder->batch_sz - rem;
+  shredder->data_idx    += (uint)d;
+  shredder->parity_idx  += (uint)p;
+  shredder->fec_set_rem -= 1UL;
+  return fec;
+}
@@ -0,0 +1,306 @@
+#include "../fd_ballet.h"
+
+#define SLOT_CNT   (3UL)
+#define BATCH_CNT  (4UL)  /* Per slot */
+#define BATCH_MAX  (100000UL)
+#define SHRED_MAX  (4096UL)
+#define SET_SHREDS (FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+FD_SHREDDER_PARITY_SHREDS_MAX)
+
+static uchar mem[ 6UL<<20 ] __attribute__((aligned(FD_DESHREDDER_ALIGN)));
+
+static uchar batch   [ SLOT_CNT ][ BATCH_CNT ][ BATCH_MAX ];
+static ulong batch_sz[ SLOT_CNT ][ BATCH_CNT ];
+static uchar out     [ BATCH_MAX ];
+
+static uchar shred   [ SHRED_MAX ][ FD_SHRED_SZ ];
+static ulong shred_cnt;
+static uchar set_mem [ SET_SHREDS ][ FD_SHRED_SZ ];
+
+/* shred_batch shreds a batch with the given meta and appends its
+   shreds to shred, dropping up to as many shreds of every FEC set as
+   it can be recovered from (if lossy). */
+
+static void
+shred_batch( fd_shredder_t *                  shredder,
+             uchar const *                    data,
+             ulong                            data_sz,
+             fd_shredder_batch_meta_t const * meta,
+             int                              lossy,
+             fd_rng_t *                       rng ) {
+  uchar * data_shred  [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET ];
+  uchar * parity_shred[ FD_SHREDDER_PARITY_SHREDS_MAX       ];
+  for( ulong i=0UL; i<FD_SHREDDER_DATA_SHREDS_PER_FEC_SET; i++ ) data_shred  [i] = set_mem[i];
+  for( ulong j=0UL; j<FD_SHREDDER_PARITY_SHREDS_MAX;       j++ ) parity_shred[j] = set_mem[FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+j];
+
+  fd_shredder_init_batch( shredder, data, data_sz, meta );
+  fd_shredder_fec_set_t fec[1];
+  while( fd_shredder_next_fec_set( shredder, data_shred, parity_shred, fec ) ) {
+    ulong d = fec->data_shred_cnt;
+    ulong p = fec->parity_shred_cnt;
+    ulong drop_rem = lossy ? fd_rng_ulong_roll( rng, p+1UL ) : 0UL;
+    for( ulong k=0UL; k<d+p; k++ ) {
+      if( drop_rem && fd_rng_uint_roll( rng, 2U ) ) { drop_rem--; continue; }
+      FD_TEST( shred_cnt<SHRED_MAX );
+      fd_memcpy( shred[ shred_cnt++ ], k<d ? data_shred[k] : parity_shred[k-d], FD_SHRED_SZ );
+    }
+  }
+}
+
+static void
+shuffle( fd_rng_t * rng,
+         ulong      lo,
+         ulong      hi ) {
+  static uchar tmp[ FD_SHRED_SZ ];
+  for( ulong i=hi-1UL; i>lo; i-- ) {
+    ulong j = lo + fd_rng_ulong_roll( rng, i-lo+1UL );
+    fd_memcpy( tmp,      shred[i], FD_SHRED_SZ );
+    fd_memcpy( shred[i], shred[j], FD_SHRED_SZ );
+    fd_memcpy( shred[j], tmp,      FD_SHRED_SZ );
+  }
+}
+
+/* drain emits all batches that are ready and checks them against the
+   batches of the slots [slot0,slot0+SLOT_CNT).  Returns the number of
+   batches emitted. */
+
+static ulong
+drain( fd_deshredder_t * deshredder,
+       ulong             slot0,
+       ulong *           next_batch ) {
+  ulong cnt = 0UL;
+  fd_shredder_batch_meta_t meta[1];
+  ulong sz;
+  while( fd_deshredder_next_batch( deshredder, out, BATCH_MAX, &sz, meta ) ) {
+    FD_TEST( meta->slot>=slot0 && meta->slot<slot0+SLOT_CNT );
+    ulong s = meta->slot - slot0;
+    ulong b = next_batch[s]++;
+    FD_TEST( b<BATCH_CNT );
+    FD_TEST( sz==batch_sz[s][b] && !memcmp( out, batch[s][b], sz ) );
+    FD_TEST( meta->parent_off    ==1     );
+    FD_TEST( meta->version       ==4321  );
+    FD_TEST( meta->ref_tick      ==(uchar)b );
+    FD_TEST( meta->block_complete==(uchar)(b==BATCH_CNT-1UL) );
+    cnt++;
+  }
+  return cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+  uchar private_key[ 32 ];
+  uchar public_key [ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( public_key, private_key, sha );
+
+  fd_shredder_t _shredder[1];
+  fd_shredder_t * shredder = fd_shredder_join( fd_shredder_new( _shredder, public_key, private_key ) );
+  FD_TEST( shredder );
+
+  /* Construction */
+
+  ulong set_max  = 64UL;
+  ulong slot_max = 8UL;
+  FD_TEST( fd_deshredder_align()==FD_DESHREDDER_ALIGN );
+  FD_TEST( !fd_deshredder_footprint( 0UL,          slot_max     ) );
+  FD_TEST( !fd_deshredder_footprint( set_max,      0UL          ) );
+  FD_TEST( !fd_deshredder_footprint( 1UL+(1UL<<20), slot_max    ) );
+  FD_TEST( !fd_deshredder_footprint( set_max,      1UL+(1UL<<20) ) );
+  ulong footprint = fd_deshredder_footprint( set_max, slot_max );
+  FD_TEST( footprint && footprint<=sizeof(mem) );
+  FD_TEST( fd_ulong_is_aligned( footprint, FD_DESHREDDER_ALIGN ) );
+
+  FD_TEST( !fd_deshredder_new( NULL,       set_max, slot_max, 0UL ) );
+  FD_TEST( !fd_deshredder_new( mem+1UL,    set_max, slot_max, 0UL ) );
+  FD_TEST( !fd_deshredder_new( mem,        0UL,     slot_max, 0UL ) );
+  FD_TEST( !fd_deshredder_join( mem ) );
+
+  ulong slot0 = 1000UL;
+  fd_deshredder_t * deshredder = fd_deshredder_join( fd_deshredder_new( mem, set_max, slot_max, slot0 ) );
+  FD_TEST( deshredder );
+  FD_TEST( fd_deshredder_set_max ( deshredder )==set_max  );
+  FD_TEST( fd_deshredder_slot_max( deshredder )==slot_max );
+  FD_TEST( fd_deshredder_slot_min( deshredder )==slot0    );
+  FD_TEST( fd_deshredder_set_cnt ( deshredder )==0UL      );
+
+  fd_shredder_batch_meta_t meta   [1] = {{ .slot = 0UL, .parent_off = 1, .version = 4321, .ref_tick = 0, .block_complete = 0 }};
+  fd_shredder_batch_meta_t emitted[1];
+  ulong sz;
+
+  /* Interleaved slots, shreds lost (up to recoverable) and shuffled
+     across each slot */
+
+  for( ulong iter=0UL; iter<4UL; iter++ ) {
+    shred_cnt = 0UL;
+    for( ulong s=0UL; s<SLOT_CNT; s++ ) {
+      meta->slot = slot0 + s;
+      for( ulong b=0UL; b<BATCH_CNT; b++ ) {
+        batch_sz[s][b] = b==1UL ? 0UL : fd_rng_ulong_roll( rng, BATCH_MAX+1UL ); /* an empty batch too */
+        for( ulong i=0UL; i<batch_sz[s][b]; i++ ) batch[s][b][i] = fd_rng_uchar( rng );
+        meta->ref_tick       = (uchar)b;
+        meta->block_complete = (uchar)(b==BATCH_CNT-1UL);
+        shred_batch( shredder, batch[s][b], batch_sz[s][b], meta, 1, rng );
+      }
+    }
+    shuffle( rng, 0UL, shred_cnt );
+
+    ulong next_batch[ SLOT_CNT ] = { 0UL };
+    ulong recover_cnt = fd_deshredder_recover_cnt( deshredder );
+    for( ulong i=0UL; i<shred_cnt; i++ ) {
+      int err = fd_deshredder_insert( deshredder, shred[i] );
+      FD_TEST( err==FD_DESHREDDER_SUCCESS || err==FD_DESHREDDER_ERR_DUPLICATE || err==FD_DESHREDDER_ERR_STALE );
+      if( err==FD_DESHREDDER_SUCCESS ) drain( deshredder, slot0, next_batch );
+      FD_TEST( fd_deshredder_set_cnt( deshredder )<=set_max );
+    }
+    for( ulong s=0UL; s<SLOT_CNT; s++ ) FD_TEST( next_batch[s]==BATCH_CNT );
+    FD_TEST( fd_deshredder_recover_cnt( deshredder )>recover_cnt );
+    FD_TEST( fd_deshredder_set_cnt    ( deshredder )==0UL         );
+    FD_TEST( fd_deshredder_evict_cnt  ( deshredder )==0UL         );
+    FD_TEST( fd_deshredder_drop_cnt   ( deshredder )==0UL         );
+
+    /* Slots are complete */
+
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_TEST( fd_deshredder_insert( deshredder, shred[i] )==FD_DESHREDDER_ERR_STALE );
+    FD_TEST( !fd_deshredder_next_batch( deshredder, out, BATCH_MAX, &sz, emitted ) );
+
+    FD_TEST( fd_deshredder_advance( deshredder, slot0+SLOT_CNT )==deshredder );
+    FD_TEST( fd_deshredder_slot_min( deshredder )==slot0+SLOT_CNT );
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_TEST( fd_deshredder_insert( deshredder, shred[i] )==FD_DESHREDDER_ERR_SLOT );
+    slot0 += SLOT_CNT;
+  }
+
+  FD_TEST( fd_deshredder_advance( deshredder, 0UL )==deshredder ); /* backwards is ignored */
+  FD_TEST( fd_deshredder_slot_min( deshredder )==slot0 );
+
+  /* Shreds of one batch in a fresh slot: malformed shreds, duplicates,
+     window and inconsistent shreds */
+
+  shred_cnt  = 0UL;
+  meta->slot = slot0; meta->ref_tick = 0; meta->block_complete = 0;
+  batch_sz[0][0] = 5000UL;
+  shred_batch( shredder, batch[0][0], batch_sz[0][0], meta, 0, rng );
+  ulong d = fd_shredder_count_data_shreds( batch_sz[0][0] );
+  FD_TEST( shred_cnt==d+fd_shredder_count_parity_shreds( batch_sz[0][0] ) );
+
+  uchar tmp[ FD_SHRED_SZ ];
+  fd_shred_t * hdr = (fd_shred_t *)tmp;
+
+  /* TEST_INSERT inserts a copy of shred src modified by expression mod
+     and checks the result is err */
+
+# define TEST_INSERT( src, mod, err ) do {                          \
+    fd_memcpy( tmp, (src), FD_SHRED_SZ );                           \
+    mod;                                                            \
+    FD_TEST( fd_deshredder_insert( deshredder, tmp )==(err) );      \
+  } while(0)
+
+  TEST_INSERT( shred[0], hdr->variant   = (uchar)0x15,                                 FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[0], hdr->variant   = (uchar)0xa5,                                 FD_DESHREDDER_ERR_INVALID ); /* legacy */
+  TEST_INSERT( shred[0], hdr->data.size = (ushort)(FD_SHRED_DATA_HEADER_SZ-1UL),       FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[0], hdr->data.size = (ushort)FD_SHRED_SZ,                         FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[0], hdr->idx       = hdr->fec_set_idx+32U,                        FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[0], hdr->slot      = slot0-1UL,                                   FD_DESHREDDER_ERR_SLOT    );
+  TEST_INSERT( shred[0], hdr->slot      = slot0+slot_max,                              FD_DESHREDDER_ERR_SLOT    );
+  TEST_INSERT( shred[d], hdr->code.idx  = hdr->code.code_cnt,                          FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[d], hdr->code.data_cnt = (ushort)(FD_DESHREDDER_DATA_SHREDS_MAX+1UL), FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[d], (hdr->variant  = fd_shred_variant( FD_SHRED_TYPE_MERKLE_CODE, 8 )), FD_DESHREDDER_ERR_INVALID ); /* proof length */
+  FD_TEST( fd_deshredder_set_cnt( deshredder )==0UL );
+
+  FD_TEST( fd_deshredder_insert( deshredder, shred[1] )==FD_DESHREDDER_SUCCESS       );
+  FD_TEST( fd_deshredder_insert( deshredder, shred[1] )==FD_DESHREDDER_ERR_DUPLICATE );
+  FD_TEST( fd_deshredder_set_cnt( deshredder )==1UL );
+  FD_TEST( !fd_deshredder_next_batch( deshredder, out, BATCH_MAX, &sz, emitted ) ); /* shred 0 missing */
+
+  /* Shreds inconsistent with the set: signature, root, shred 0 ending
+     the set before shred 1 and a coding shred with 1 data shred */
+
+  TEST_INSERT( shred[0], tmp[0] ^= (uchar)1,                                           FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[0], tmp[ fd_shred_merkle_off( hdr->variant ) ] ^= (uchar)1,       FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[0], hdr->data.flags |= FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE,       FD_DESHREDDER_ERR_INVALID );
+  TEST_INSERT( shred[d], (hdr->code.data_cnt = (ushort)1,
+                          hdr->code.code_cnt = (ushort)(d+fd_shredder_parity_shred_cnt( d )-1UL)), FD_DESHREDDER_ERR_INVALID );
+
+# undef TEST_INSERT
+
+  /* Recovery from a corrupted coding shred doesn't check out: the set
+     is dropped.  Then recovery from good ones. */
+
+  for( ulong k=d; k<shred_cnt; k++ ) {
+    fd_memcpy( tmp, shred[k], FD_SHRED_SZ );
+    tmp[ FD_SHRED_CODE_HEADER_SZ ] ^= (uchar)1;
+    int err = fd_deshredder_insert( deshredder, tmp );
+    if( err!=FD_DESHREDDER_SUCCESS ) { FD_TEST( err==FD_DESHREDDER_ERR_INVALID ); break; }
+  }
+  FD_TEST( fd_deshredder_drop_cnt( deshredder )==1UL );
+  FD_TEST( fd_deshredder_set_cnt ( deshredder )==0UL );
+
+  ulong next_batch[ SLOT_CNT ] = { 0UL };
+  meta->ref_tick = 0;
+  for( ulong k=d; k<shred_cnt; k++ ) {
+    FD_TEST( fd_deshredder_insert( deshredder, shred[k] )==FD_DESHREDDER_SUCCESS ); /* Recovered once there are d shreds */
+    if( drain( deshredder, slot0, next_batch ) ) break;
+  }
+  FD_TEST( next_batch[0]==1UL );
+  for( ulong k=0UL; k<shred_cnt; k++ ) FD_TEST( fd_deshredder_insert( deshredder, shred[k] )==FD_DESHREDDER_ERR_STALE );
+  FD_TEST( fd_deshredder_set_cnt( deshredder )==0UL );
+
+  /* Batches larger than the output buffer are dropped */
+
+  shred_cnt  = 0UL;
+  shred_batch( shredder, batch[0][0], batch_sz[0][0], meta, 0, rng );
+  for( ulong k=0UL; k<shred_cnt; k++ ) FD_TEST( fd_deshredder_insert( deshredder, shred[k] )==FD_DESHREDDER_SUCCESS );
+  FD_TEST( !fd_deshredder_next_batch( deshredder, out, batch_sz[0][0]-1UL, &sz, emitted ) );
+  FD_TEST( fd_deshredder_drop_cnt( deshredder )==2UL );
+  FD_TEST( fd_deshredder_set_cnt ( deshredder )==0UL );
+
+  FD_TEST( fd_deshredder_delete( fd_deshredder_leave( deshredder ) )==mem );
+  FD_TEST( !fd_deshredder_join( mem ) );
+
+  /* A flood of slots cannot grow a small deshredder.  The oldest slots
+     are evicted. */
+
+  set_max = 4UL;
+  slot_max = 64UL;
+  deshredder = fd_deshredder_join( fd_deshredder_new( mem, set_max, slot_max, 0UL ) );
+  FD_TEST( deshredder );
+
+  meta->slot = 0UL;
+  for( ulong s=1UL; s<=32UL; s++ ) {
+    shred_cnt  = 0UL;
+    meta->slot = s;
+    shred_batch( shredder, batch[0][0], batch_sz[0][0], meta, 0, rng );
+    FD_TEST( fd_deshredder_insert( deshredder, shred[1] )==FD_DESHREDDER_SUCCESS ); /* Never completes */
+    FD_TEST( fd_deshredder_set_cnt( deshredder )==fd_ulong_min( s, set_max ) );
+  }
+  FD_TEST( fd_deshredder_evict_cnt( deshredder )==32UL-set_max );
+
+  /* The most recent slots are still there */
+
+  for( ulong k=0UL; k<d; k++ ) if( k!=1UL ) FD_TEST( fd_deshredder_insert( deshredder, shred[k] )==FD_DESHREDDER_SUCCESS );
+  FD_TEST( fd_deshredder_next_batch( deshredder, out, BATCH_MAX, &sz, emitted ) );
+  FD_TEST( emitted->slot==32UL && sz==batch_sz[0][0] && !memcmp( out, batch[0][0], sz ) );
+  FD_TEST( fd_deshredder_set_cnt( deshredder )==set_max-1UL );
+
+  /* Advancing drops the slots left behind */
+
+  fd_deshredder_advance( deshredder, 31UL );
+  FD_TEST( fd_deshredder_set_cnt( deshredder )==1UL );
+  fd_deshredder_advance( deshredder, 33UL );
+  FD_TEST( fd_deshredder_set_cnt( deshredder )==0UL );
+  FD_TEST( fd_deshredder_evict_cnt( deshredder )==32UL-set_max );
+
+  FD_TEST( fd_deshredder_delete( fd_deshredder_leave( deshredder ) )==mem );
+
+  fd_shredder_delete( fd_shredder_leave( shredder ) );
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -105,6 +105,17 @@ main( int     argc,
       FD_TEST( fd_shred_header_sz ( shred->variant )==header_sz  );
       FD_TEST( fd_shred_payload_sz( shred->variant )==payload_sz );
       FD_TEST( fd_shred_merkle_sz ( shred->variant )==merkle_sz  );
+
+      /* Test erasure shard geometry (equal sized shards for data and
+         coding shreds, covering the data headers) */
+      ulong erasure_off = is_code ? 0x59UL : (is_legacy ? 0UL : 0x40UL);
+      ulong erasure_sz  = sizeof(buf) - 0x59UL - merkle_sz;
+      FD_TEST( fd_shred_erasure_off( shred->variant )==erasure_off );
+      FD_TEST( fd_shred_erasure_sz ( shred->variant )==erasure_sz  );
+      if( is_data ) {
+        FD_TEST( fd_shred_data_capacity( shred->variant )==erasure_off+erasure_sz-header_sz );
+        FD_TEST( fd_shred_data_capacity( shred->variant )<=payload_sz );
+      }
     } else {
       FD_LOG_NOTICE(( "shred type 0x%02x: invalid", i ));
       /* Invalid shred types should always be rejected irrespective of buffer size */
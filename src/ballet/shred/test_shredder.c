@@ -0,0 +1,194 @@
+#include "../fd_ballet.h"
+
+FD_STATIC_ASSERT( FD_SHREDDER_ALIGN    ==alignof(fd_shredder_t), unit_test );
+FD_STATIC_ASSERT( FD_SHREDDER_FOOTPRINT==sizeof (fd_shredder_t), unit_test );
+
+#define BATCH_MAX (1UL<<18)
+#define SET_MAX   (FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+FD_SHREDDER_PARITY_SHREDS_MAX)
+
+static uchar batch   [ BATCH_MAX ];
+static uchar reasm   [ BATCH_MAX ];
+static uchar shred_mem[ SET_MAX ][ FD_SHRED_SZ+1UL ]; /* +1 to test unaligned shreds */
+static uchar saved    [ SET_MAX ][ FD_SHRED_SZ ];
+
+/* shred_batch shreds batch_sz bytes of batch and validates every
+   shred produced.  Returns the number of data shreds. */
+
+static ulong
+shred_batch( fd_shredder_t *                  shredder,
+             ulong                            batch_sz,
+             fd_shredder_batch_meta_t const * meta,
+             uchar const *                    public_key,
+             fd_sha512_t *                    sha,
+             uint                             expected_data_idx,
+             uint                             expected_parity_idx ) {
+  uchar * data_shred  [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET ];
+  uchar * parity_shred[ FD_SHREDDER_PARITY_SHREDS_MAX       ];
+  for( ulong i=0UL; i<FD_SHREDDER_DATA_SHREDS_PER_FEC_SET; i++ ) data_shred  [i] = shred_mem[i] + (i&1UL);
+  for( ulong j=0UL; j<FD_SHREDDER_PARITY_SHREDS_MAX;       j++ ) parity_shred[j] = shred_mem[ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+j ] + (j&1UL);
+
+  FD_TEST( fd_shredder_init_batch( shredder, batch, batch_sz, meta )==shredder );
+
+  ulong reasm_sz   = 0UL;
+  ulong set_cnt    = 0UL;
+  ulong data_cnt   = 0UL;
+  ulong parity_cnt = 0UL;
+  uint  data_idx   = expected_data_idx;
+  uint  parity_idx = expected_parity_idx;
+
+  fd_shredder_fec_set_t fec[1];
+  while( fd_shredder_next_fec_set( shredder, data_shred, parity_shred, fec ) ) {
+    ulong d = fec->data_shred_cnt;
+    ulong p = fec->parity_shred_cnt;
+    ulong n = d+p;
+    FD_TEST( d>=1UL && d<=FD_SHREDDER_DATA_SHREDS_PER_FEC_SET );
+    FD_TEST( p==fd_shredder_parity_shred_cnt( d ) );
+    FD_TEST( fec->fec_set_idx==data_idx );
+    set_cnt++;
+    int last_set = (set_cnt==fd_shredder_count_fec_sets( batch_sz ));
+    if( !last_set ) FD_TEST( d==FD_SHREDDER_DATA_SHREDS_PER_FEC_SET );
+
+    /* Signature covers the root */
+
+    uchar const * sig = data_shred[0];
+    FD_TEST( fd_ed25519_verify( fec->merkle_root, FD_SHRED_MERKLE_NODE_SZ, sig, public_key, sha )==FD_ED25519_SUCCESS );
+
+    for( ulong k=0UL; k<n; k++ ) {
+      uchar const *      buf   = k<d ? data_shred[k] : parity_shred[k-d];
+      fd_shred_t const * shred = fd_shred_parse( buf );
+      FD_TEST( shred );
+      FD_TEST( fd_shred_type( shred->variant )==(k<d ? FD_SHRED_TYPE_MERKLE_DATA : FD_SHRED_TYPE_MERKLE_CODE) );
+      FD_TEST( shred->slot       ==meta->slot     );
+      FD_TEST( shred->version    ==meta->version  );
+      FD_TEST( shred->fec_set_idx==fec->fec_set_idx );
+      FD_TEST( !memcmp( shred->signature, sig, FD_ED25519_SIG_SZ ) );
+
+      /* Root and inclusion proof */
+
+      ulong                     merkle_cnt = fd_shred_merkle_cnt( shred->variant );
+      fd_shred_merkle_t const * node       = fd_shred_merkle_nodes( shred );
+      FD_TEST( !memcmp( node[0], fec->merkle_root, FD_SHRED_MERKLE_NODE_SZ ) );
+      fd_bmtree20_node_t leaf[1];
+      fd_bmtree20_hash_leaf( leaf, buf + FD_ED25519_SIG_SZ, fd_shred_merkle_off( shred->variant ) - FD_ED25519_SIG_SZ );
+      FD_TEST(  fd_bmtree20_proof_verify( fec->merkle_root, leaf, k, (uchar const *)node[1], merkle_cnt-1UL ) );
+      leaf->hash[0] ^= (uchar)1;
+      FD_TEST( !fd_bmtree20_proof_verify( fec->merkle_root, leaf, k, (uchar const *)node[1], merkle_cnt-1UL ) );
+
+      if( k<d ) {
+        FD_TEST( shred->idx            ==data_idx++ );
+        FD_TEST( shred->data.parent_off==meta->parent_off );
+        ulong sz = (ulong)shred->data.size - FD_SHRED_DATA_HEADER_SZ;
+        FD_TEST( sz<=fd_shred_data_capacity( shred->variant ) );
+        if( batch_sz ) FD_TEST( sz ); /* no empty data shreds unless the batch is empty */
+        fd_memcpy( reasm + reasm_sz, fd_shred_data_payload( shred ), sz );
+        reasm_sz += sz;
+        for( ulong b=(ulong)shred->data.size; b<fd_shred_merkle_off( shred->variant ); b++ ) FD_TEST( !buf[b] );
+
+        uchar flags = (uchar)fd_ulong_min( meta->ref_tick, FD_SHRED_DATA_REF_TICK_MASK );
+        if( last_set & (k==d-1UL) ) flags |= meta->block_complete ? (uchar)0xc0 : FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE;
+        FD_TEST( shred->data.flags==flags );
+      } else {
+        FD_TEST( shred->idx          ==parity_idx++ );
+        FD_TEST( shred->code.data_cnt==d );
+        FD_TEST( shred->code.code_cnt==p );
+        FD_TEST( shred->code.idx     ==k-d );
+      }
+    }
+
+    /* Erase as many data shreds as we can and recover them from the
+       rest (this also checks the parity) */
+
+    uchar * shard [ SET_MAX ];
+    uchar   erased[ SET_MAX ];
+    uchar   variant = ((fd_shred_t const *)data_shred[0])->variant;
+    for( ulong k=0UL; k<n; k++ ) {
+      uchar * buf = k<d ? data_shred[k] : parity_shred[k-d];
+      fd_memcpy( saved[k], buf, FD_SHRED_SZ );
+      shard [k] = buf + fd_shred_erasure_off( ((fd_shred_t const *)buf)->variant );
+      erased[k] = (uchar)(k<fd_ulong_min( d, p ));
+      if( erased[k] ) fd_memset( shard[k], 0, fd_shred_erasure_sz( variant ) );
+    }
+    FD_TEST( fd_reedsol_recover( fd_shred_erasure_sz( variant ), shard, erased, d, p )==FD_REEDSOL_SUCCESS );
+    for( ulong k=0UL; k<n; k++ ) FD_TEST( !memcmp( saved[k], k<d ? data_shred[k] : parity_shred[k-d], FD_SHRED_SZ ) );
+
+    data_cnt   += d;
+    parity_cnt += p;
+  }
+
+  FD_TEST( !fd_shredder_next_fec_set( shredder, data_shred, parity_shred, fec ) ); /* stays exhausted */
+
+  FD_TEST( set_cnt   ==fd_shredder_count_fec_sets     ( batch_sz ) );
+  FD_TEST( data_cnt  ==fd_shredder_count_data_shreds  ( batch_sz ) );
+  FD_TEST( parity_cnt==fd_shredder_count_parity_shreds( batch_sz ) );
+  FD_TEST( reasm_sz==batch_sz && !memcmp( reasm, batch, batch_sz ) );
+  return data_cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+
+  uchar private_key[ 32 ];
+  uchar public_key [ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( public_key, private_key, sha );
+
+  for( ulong b=0UL; b<BATCH_MAX; b++ ) batch[b] = fd_rng_uchar( rng );
+
+  fd_shredder_t _shredder[1];
+  FD_TEST( fd_shredder_align()    ==FD_SHREDDER_ALIGN     );
+  FD_TEST( fd_shredder_footprint()==FD_SHREDDER_FOOTPRINT );
+  FD_TEST( !fd_shredder_new( NULL, public_key, private_key ) );
+  FD_TEST( !fd_shredder_new( (uchar *)_shredder+1UL, public_key, private_key ) );
+  fd_shredder_t * shredder = fd_shredder_join( fd_shredder_new( _shredder, public_key, private_key ) );
+  FD_TEST( shredder );
+
+  /* Parity count table sanity (more relative parity for small sets) */
+
+  FD_TEST( fd_shredder_parity_shred_cnt(  1UL )==17UL );
+  FD_TEST( fd_shredder_parity_shred_cnt( 32UL )==32UL );
+  for( ulong d=1UL; d<=FD_SHREDDER_DATA_SHREDS_PER_FEC_SET; d++ ) FD_TEST( fd_shredder_parity_shred_cnt( d )<=FD_SHREDDER_PARITY_SHREDS_MAX );
+
+  /* Batch sizes around FEC set boundaries.  Full sets have 64 shreds
+     with 7 Merkle nodes each. */
+
+  ulong full_cap = FD_SHREDDER_DATA_SHREDS_PER_FEC_SET*fd_shred_data_capacity( fd_shred_variant( FD_SHRED_TYPE_MERKLE_DATA, 7 ) );
+  ulong sizes[] = { 0UL, 1UL, 1000UL, full_cap-1UL, full_cap, full_cap+1UL, 2UL*full_cap, 3UL*full_cap+17UL };
+  fd_shredder_batch_meta_t meta[1] = {{ .slot = 42UL, .parent_off = 1, .version = 1234, .ref_tick = 7, .block_complete = 0 }};
+
+  uint data_idx   = 0U;
+  uint parity_idx = 0U;
+  for( ulong i=0UL; i<sizeof(sizes)/sizeof(sizes[0]); i++ ) {
+    meta->block_complete = (uchar)(i==sizeof(sizes)/sizeof(sizes[0])-1UL);
+    data_idx   += (uint)shred_batch( shredder, sizes[i], meta, public_key, sha, data_idx, parity_idx );
+    parity_idx += (uint)fd_shredder_count_parity_shreds( sizes[i] );
+  }
+  FD_TEST( fd_shredder_count_fec_sets( full_cap   )==1UL );
+  FD_TEST( fd_shredder_count_fec_sets( full_cap+1 )==2UL );
+
+  /* Random batches, new slot every few batches (indices restart) */
+
+  for( ulong iter=0UL; iter<32UL; iter++ ) {
+    if( !(iter & 3UL) ) { meta->slot++; data_idx = 0U; parity_idx = 0U; }
+    meta->ref_tick       = (uchar)fd_rng_uint_roll( rng, 128U ); /* saturates */
+    meta->block_complete = (uchar)((iter & 3UL)==3UL);
+    ulong batch_sz = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    data_idx   += (uint)shred_batch( shredder, batch_sz, meta, public_key, sha, data_idx, parity_idx );
+    parity_idx += (uint)fd_shredder_count_parity_shreds( batch_sz );
+  }
+
+  FD_TEST( fd_shredder_delete( fd_shredder_leave( shredder ) )==_shredder );
+  FD_TEST( !fd_shredder_join( _shredder ) );
+
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -1,10 +1,13 @@
-$(call add-hdrs,fd_txn.h )
-$(call add-objs,fd_txn_parse,fd_ballet)
+$(call add-hdrs,fd_txn.h fd_alut.h fd_txn_build.h)
+$(call add-objs,fd_txn_parse fd_alut fd_txn_build,fd_ballet)
 $(call make-unit-test,test_txn_parse,test_txn_parse,fd_ballet fd_util)
 $(call make-unit-test,test_txn,test_txn,fd_ballet fd_util)
 $(call make-unit-test,test_compact_u16,test_compact_u16,fd_ballet fd_util)
+$(call make-unit-test,test_alut,test_alut,fd_ballet fd_util)
+$(call make-unit-test,test_txn_build,test_txn_build,fd_ballet fd_util)
 
 $(call run-unit-test,test_txn_parse,)
 $(call run-unit-test,test_txn,)
 $(call run-unit-test,test_compact_u16,)
-
+$(call run-unit-test,test_alut,)
+$(call run-unit-test,test_txn_build,)
@@ -0,0 +1,396 @@
+#include "fd_alut.h"
+
+#define FD_ALUT_MAGIC (0xf17eda2ce7a1a700UL) /* firedancer alut ver 0 */
+
+/* A fd_alut_ent_t is a table in the store.  The table's addresses are
+   in the storage block with index addr_idx. */
+
+struct fd_alut_ent {
+  fd_txn_acct_addr_t key;
+  uint               hash;
+  uint               addr_idx;
+  ulong              last_extended_slot;
+  ulong              deactivation_slot;
+  ushort             addr_cnt;
+  ushort             last_extended_start;
+  uint               _pad;
+};
+
+typedef struct fd_alut_ent fd_alut_ent_t;
+
+FD_STATIC_ASSERT( sizeof(fd_alut_ent_t)==64UL, layout );
+
+#define FD_ALUT_NULL ((fd_txn_acct_addr_t){ .ul={ 0UL, 0UL, 0UL, 0UL } })
+
+#define FD_ALUT_ADDR_EQUAL(k0,k1) (((k0).ul[0]==(k1).ul[0]) & ((k0).ul[1]==(k1).ul[1]) & \
+                                   ((k0).ul[2]==(k1).ul[2]) & ((k0).ul[3]==(k1).ul[3]))
+#define FD_ALUT_ADDR_HASH(k)      ((uint)fd_ulong_hash( (k).ul[0] ^ (k).ul[1] ^ (k).ul[2] ^ (k).ul[3] ))
+
+#define MAP_NAME              fd_alut_map
+#define MAP_T                 fd_alut_ent_t
+#define MAP_KEY_T             fd_txn_acct_addr_t
+#define MAP_KEY_NULL          FD_ALUT_NULL
+#define MAP_KEY_INVAL(k)      (!((k).ul[0] | (k).ul[1] | (k).ul[2] | (k).ul[3]))
+#define MAP_KEY_EQUAL(k0,k1)  FD_ALUT_ADDR_EQUAL(k0,k1)
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_KEY_HASH(k)       FD_ALUT_ADDR_HASH(k)
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+/* The store is laid out as the header, the map, a stack of free
+   address storage block indices and table_max address storage blocks
+   of FD_ALUT_ADDR_MAX addresses each. */
+
+struct __attribute__((aligned(FD_ALUT_ALIGN))) fd_alut_private {
+  ulong magic;     /* ==FD_ALUT_MAGIC */
+  ulong table_max;
+  ulong map_off;   /* Offset of the map relative to the store */
+  ulong free_off;  /* Offset of the free block stack relative to the store */
+  ulong addr_off;  /* Offset of the address storage relative to the store */
+  ulong free_cnt;  /* Number of free blocks, free blocks are free[i] for i in [0,free_cnt) */
+  /* Padding to map align here */
+  /* map here */
+  /* free block stack here */
+  /* address storage here */
+};
+
+#define FD_ALUT_BLOCK_SZ (FD_ALUT_ADDR_MAX*sizeof(fd_txn_acct_addr_t))
+
+/* fd_alut_lg_slot_cnt returns the log2 of the number of map slots used
+   for table_max tables.  The map is kept at most half full such that
+   probe sequences stay short. */
+
+FD_FN_CONST static inline int
+fd_alut_lg_slot_cnt( ulong table_max ) {
+  return fd_ulong_find_msb( 2UL*table_max-1UL ) + 1;
+}
+
+FD_FN_CONST static inline ulong
+fd_alut_map_off( void ) {
+  return fd_ulong_align_up( sizeof(fd_alut_t), fd_alut_map_align() );
+}
+
+FD_FN_CONST static inline ulong
+fd_alut_free_off( ulong table_max ) {
+  return fd_ulong_align_up( fd_alut_map_off() + fd_alut_map_footprint( fd_alut_lg_slot_cnt( table_max ) ), alignof(uint) );
+}
+
+FD_FN_CONST static inline ulong
+fd_alut_addr_off( ulong table_max ) {
+  return fd_ulong_align_up( fd_alut_free_off( table_max ) + table_max*sizeof(uint), FD_ALUT_ALIGN );
+}
+
+FD_FN_PURE static inline fd_alut_ent_t *
+fd_alut_map( fd_alut_t const * alut ) {
+  return fd_alut_map_join( (void *)((ulong)alut + alut->map_off) );
+}
+
+FD_FN_PURE static inline uint *
+fd_alut_free( fd_alut_t const * alut ) {
+  return (uint *)((ulong)alut + alut->free_off);
+}
+
+FD_FN_PURE static inline fd_txn_acct_addr_t *
+fd_alut_block( fd_alut_t const * alut,
+               ulong             addr_idx ) {
+  return (fd_txn_acct_addr_t *)((ulong)alut + alut->addr_off + addr_idx*FD_ALUT_BLOCK_SZ);
+}
+
+ulong
+fd_alut_align( void ) {
+  return FD_ALUT_ALIGN;
+}
+
+ulong
+fd_alut_footprint( ulong table_max ) {
+  if( FD_UNLIKELY( (!table_max) | (table_max>FD_ALUT_TABLE_MAX) ) ) return 0UL;
+  return fd_alut_addr_off( table_max ) + table_max*FD_ALUT_BLOCK_SZ;
+}
+
+void *
+fd_alut_new( void * shmem,
+             ulong  table_max ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_alut_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_alut_footprint( table_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad table_max (%lu)", table_max ));
+    return NULL;
+  }
+
+  fd_alut_t * alut = (fd_alut_t *)shmem;
+
+  alut->table_max = table_max;
+  alut->map_off   = fd_alut_map_off();
+  alut->free_off  = fd_alut_free_off( table_max );
+  alut->addr_off  = fd_alut_addr_off( table_max );
+  alut->free_cnt  = table_max;
+
+  fd_alut_map_new( (void *)((ulong)shmem + alut->map_off), fd_alut_lg_slot_cnt( table_max ) );
+
+  uint * free = fd_alut_free( alut );
+  for( ulong i=0UL; i<table_max; i++ ) free[ i ] = (uint)(table_max-1UL-i); /* Hand out low blocks first */
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( alut->magic ) = FD_ALUT_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_alut_t *
+fd_alut_join( void * shalut ) {
+
+  if( FD_UNLIKELY( !shalut ) ) {
+    FD_LOG_WARNING(( "NULL shalut" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shalut, fd_alut_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shalut" ));
+    return NULL;
+  }
+
+  fd_alut_t * alut = (fd_alut_t *)shalut;
+  if( FD_UNLIKELY( alut->magic!=FD_ALUT_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return alut;
+}
+
+void *
+fd_alut_leave( fd_alut_t * alut ) {
+
+  if( FD_UNLIKELY( !alut ) ) {
+    FD_LOG_WARNING(( "NULL alut" ));
+    return NULL;
+  }
+
+  return (void *)alut;
+}
+
+void *
+fd_alut_delete( void * shalut ) {
+
+  if( FD_UNLIKELY( !shalut ) ) {
+    FD_LOG_WARNING(( "NULL shalut" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shalut, fd_alut_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shalut" ));
+    return NULL;
+  }
+
+  fd_alut_t * alut = (fd_alut_t *)shalut;
+  if( FD_UNLIKELY( alut->magic!=FD_ALUT_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( alut->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shalut;
+}
+
+ulong fd_alut_table_max( fd_alut_t const * alut ) { return alut->table_max; }
+ulong fd_alut_table_cnt( fd_alut_t const * alut ) { return fd_alut_map_key_cnt( fd_alut_map( alut ) ); }
+
+int
+fd_alut_upsert( fd_alut_t *                alut,
+                fd_txn_acct_addr_t const * key,
+                uchar const *              addr,
+                ulong                      addr_cnt,
+                ulong                      last_extended_slot,
+                ulong                      last_extended_start,
+                ulong                      deactivation_slot ) {
+
+  if( FD_UNLIKELY( fd_alut_map_key_inval( *key ) | (addr_cnt>FD_ALUT_ADDR_MAX) | (last_extended_start>addr_cnt) ) )
+    return FD_ALUT_ERR_INVAL;
+
+  fd_alut_ent_t * map = fd_alut_map( alut );
+  fd_alut_ent_t * ent = fd_alut_map_query( map, *key, NULL );
+  if( FD_UNLIKELY( !ent ) ) {
+    if( FD_UNLIKELY( !alut->free_cnt ) ) return FD_ALUT_ERR_FULL;
+    ent = fd_alut_map_insert( map, *key ); /* Can't fail */
+    ent->addr_idx = fd_alut_free( alut )[ --alut->free_cnt ];
+  }
+
+  ent->last_extended_slot  = last_extended_slot;
+  ent->deactivation_slot   = deactivation_slot;
+  ent->addr_cnt            = (ushort)addr_cnt;
+  ent->last_extended_start = (ushort)last_extended_start;
+  fd_memcpy( fd_alut_block( alut, ent->addr_idx ), addr, addr_cnt*FD_TXN_ACCT_ADDR_SZ );
+
+  return FD_ALUT_SUCCESS;
+}
+
+int
+fd_alut_remove( fd_alut_t *                alut,
+                fd_txn_acct_addr_t const * key ) {
+  if( FD_UNLIKELY( fd_alut_map_key_inval( *key ) ) ) return 0;
+  fd_alut_ent_t * map = fd_alut_map( alut );
+  fd_alut_ent_t * ent = fd_alut_map_query( map, *key, NULL );
+  if( FD_UNLIKELY( !ent ) ) return 0;
+  fd_alut_free( alut )[ alut->free_cnt++ ] = ent->addr_idx;
+  fd_alut_map_remove( map, ent );
+  return 1;
+}
+
+/* fd_alut_private_lookup is fd_alut_lookup without the argument
+   checking. */
+
+static inline fd_txn_acct_addr_t const *
+fd_alut_private_lookup( fd_alut_t const *          alut,
+                        fd_alut_ent_t *            map,
+                        fd_txn_acct_addr_t const * key,
+                        ulong                      slot,
+                        ulong *                    _addr_cnt ) {
+  fd_alut_ent_t const * ent = fd_alut_map_query( map, *key, NULL );
+  if( FD_UNLIKELY( !ent ) ) return NULL;
+
+  ulong deactivation_slot = ent->deactivation_slot;
+  int   usable            = (slot<deactivation_slot) | ((slot-deactivation_slot)<=FD_ALUT_DEACTIVATION_COOLDOWN);
+  if( FD_UNLIKELY( !usable ) ) return NULL;
+
+  *_addr_cnt = slot>ent->last_extended_slot ? (ulong)ent->addr_cnt : (ulong)ent->last_extended_start;
+  return fd_alut_block( alut, ent->addr_idx );
+}
+
+fd_txn_acct_addr_t const *
+fd_alut_lookup( fd_alut_t const *          alut,
+                fd_txn_acct_addr_t const * key,
+                ulong                      slot,
+                ulong *                    _addr_cnt ) {
+  if( FD_UNLIKELY( fd_alut_map_key_inval( *key ) ) ) return NULL;
+  return fd_alut_private_lookup( alut, fd_alut_map( alut ), key, slot, _addr_cnt );
+}
+
+/* fd_alut_private_dedup_t is the set used by fd_alut_resolve to find
+   repeated addresses.  It is a small open addressed hash table (sized
+   for the transaction at hand, at most half full) whose non-zero slots
+   hold 1 + the index in out of an address. */
+
+struct fd_alut_private_dedup {
+  ulong  mask;
+  ushort slot[ 2UL*FD_TXN_ACCT_ADDR_MAX ];
+};
+
+typedef struct fd_alut_private_dedup fd_alut_private_dedup_t;
+
+/* fd_alut_private_add appends the account (addr,writable) to out (which
+   currently has cnt accounts) if addr is not already in out and merges
+   writable into the existing account otherwise.  Returns the new number
+   of accounts in out. */
+
+static inline ulong
+fd_alut_private_add( fd_alut_private_dedup_t * dedup,
+                     fd_alut_acct_t *          out,
+                     ulong                     cnt,
+                     fd_txn_acct_addr_t        addr,
+                     int                       writable ) {
+  ulong mask = dedup->mask;
+  ulong h    = ((addr.ul[0] ^ addr.ul[1] ^ addr.ul[2] ^ addr.ul[3])*0x9e3779b97f4a7c15UL) >> 55; /* Cheaper than FD_ALUT_ADDR_HASH */
+  for(;;) {
+    ulong s = (ulong)dedup->slot[ h & mask ];
+    if( FD_LIKELY( !s ) ) break;
+    if( FD_LIKELY( FD_ALUT_ADDR_EQUAL( out[ s-1UL ].addr, addr ) ) ) {
+      out[ s-1UL ].writable |= writable;
+      return cnt;
+    }
+    h++;
+  }
+  dedup->slot[ h & mask ] = (ushort)(cnt+1UL);
+  out[ cnt ].addr     = addr;
+  out[ cnt ].writable = writable;
+  return cnt+1UL;
+}
+
+int
+fd_alut_resolve( fd_alut_t const * alut,
+                 fd_txn_t const *  txn,
+                 uchar const *     payload,
+                 ulong             slot,
+                 fd_alut_acct_t *  out,
+                 ulong *           _acct_cnt ) {
+
+  ulong sig_cnt               = (ulong)txn->signature_cnt;
+  ulong acct_cnt              = (ulong)txn->acct_addr_cnt;
+  ulong writable_signed_cnt   = sig_cnt  - (ulong)txn->readonly_signed_cnt;
+  ulong writable_unsigned_end = acct_cnt - (ulong)txn->readonly_unsigned_cnt;
+  ulong lut_cnt               = (ulong)txn->addr_table_lookup_cnt;
+  ulong max_cnt               = acct_cnt + (ulong)txn->addr_table_adtl_cnt; /* In [1,FD_TXN_ACCT_ADDR_MAX] */
+
+  fd_alut_private_dedup_t dedup[1];
+  dedup->mask = (1UL << (fd_ulong_find_msb( 2UL*max_cnt-1UL ) + 1)) - 1UL;
+  fd_memset( dedup->slot, 0, (dedup->mask+1UL)*sizeof(ushort) );
+
+  /* Static accounts */
+
+  uchar const * acct_addr = payload + txn->acct_addr_off;
+  ulong         cnt       = 0UL;
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    fd_txn_acct_addr_t addr;
+    memcpy( addr.b, acct_addr + i*FD_TXN_ACCT_ADDR_SZ, FD_TXN_ACCT_ADDR_SZ );
+    int writable = (i<writable_signed_cnt) | ((i>=sig_cnt) & (i<writable_unsigned_end));
+    cnt = fd_alut_private_add( dedup, out, cnt, addr, writable );
+  }
+
+  if( FD_LIKELY( !lut_cnt ) ) {
+    *_acct_cnt = cnt;
+    return FD_ALUT_SUCCESS;
+  }
+
+  /* Look up the tables and check the selected indices.  Then append the
+     writable accounts of all tables followed by the readonly ones. */
+
+  fd_txn_acct_addr_lut_t const * lut = fd_txn_get_address_tables( (fd_txn_t *)txn );
+  fd_alut_ent_t *                map = fd_alut_map( alut );
+
+  fd_txn_acct_addr_t const * table[ FD_TXN_ADDR_TABLE_LOOKUP_MAX ];
+  for( ulong j=0UL; j<lut_cnt; j++ ) {
+    fd_txn_acct_addr_t key;
+    memcpy( key.b, payload + lut[ j ].addr_off, FD_TXN_ACCT_ADDR_SZ );
+    ulong addr_cnt = 0UL;
+    table[ j ] = fd_alut_map_key_inval( key ) ? NULL : fd_alut_private_lookup( alut, map, &key, slot, &addr_cnt );
+    if( FD_UNLIKELY( !table[ j ] ) ) return FD_ALUT_ERR_TABLE;
+
+    uchar const * writable_idx = payload + lut[ j ].writable_off;
+    uchar const * readonly_idx = payload + lut[ j ].readonly_off;
+    ulong         idx_max      = 0UL;
+    for( ulong k=0UL; k<(ulong)lut[ j ].writable_cnt; k++ ) idx_max = fd_ulong_max( idx_max, (ulong)writable_idx[ k ] + 1UL );
+    for( ulong k=0UL; k<(ulong)lut[ j ].readonly_cnt; k++ ) idx_max = fd_ulong_max( idx_max, (ulong)readonly_idx[ k ] + 1UL );
+    if( FD_UNLIKELY( idx_max>addr_cnt ) ) return FD_ALUT_ERR_IDX;
+  }
+
+  for( ulong j=0UL; j<lut_cnt; j++ ) {
+    uchar const * writable_idx = payload + lut[ j ].writable_off;
+    for( ulong k=0UL; k<(ulong)lut[ j ].writable_cnt; k++ )
+      cnt = fd_alut_private_add( dedup, out, cnt, table[ j ][ writable_idx[ k ] ], 1 );
+  }
+
+  for( ulong j=0UL; j<lut_cnt; j++ ) {
+    uchar const * readonly_idx = payload + lut[ j ].readonly_off;
+    for( ulong k=0UL; k<(ulong)lut[ j ].readonly_cnt; k++ )
+      cnt = fd_alut_private_add( dedup, out, cnt, table[ j ][ readonly_idx[ k ] ], 0 );
+  }
+
+  *_acct_cnt = cnt;
+  return FD_ALUT_SUCCESS;
+}
+
+#undef FD_ALUT_BLOCK_SZ
+#undef FD_ALUT_ADDR_HASH
+#undef FD_ALUT_ADDR_EQUAL
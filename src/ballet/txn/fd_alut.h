@@ -0,0 +1,191 @@
+#ifndef HEADER_fd_src_ballet_txn_fd_alut_h
+#define HEADER_fd_src_ballet_txn_fd_alut_h
+
+/* fd_alut provides a store of address lookup tables (ALUTs) and a
+   resolver that expands the account list of a v0 transaction, which
+   may load accounts from ALUTs, into concrete account addresses.
+
+   An ALUT is an on-chain account holding a list of up to
+   FD_ALUT_ADDR_MAX account addresses.  A v0 transaction references
+   ALUTs by their address and selects accounts from them by index (see
+   fd_txn_acct_addr_lut_t).  The store mirrors the state of the ALUT
+   accounts the caller cares about: the caller upserts a table whenever
+   the underlying account changes (created, extended, deactivated) and
+   removes it when the account is closed.  Following the runtime:
+
+   - Addresses appended in the table's most recent extension (those at
+     index last_extended_start and above) can only be used in slots
+     after last_extended_slot.
+
+   - A deactivated table can still be used up to and including
+     FD_ALUT_DEACTIVATION_COOLDOWN slots after its deactivation slot
+     (the runtime allows it while the deactivation slot is still in the
+     slot hashes sysvar).
+
+   The store is an open addressed hash map (keyed by table address) and
+   has room for up to table_max tables.  Each table gets room for
+   FD_ALUT_ADDR_MAX addresses (8 KiB) such that tables can be replaced in
+   place.  It can be located in a workspace but should only be used by
+   one thread at a time. */
+
+#include "fd_txn.h"
+
+#define FD_ALUT_ALIGN (128UL)
+
+/* FD_ALUT_TABLE_MAX is the maximum table_max supported.
+   FD_ALUT_ADDR_MAX is the maximum number of addresses in a table. */
+
+#define FD_ALUT_TABLE_MAX (1UL<<20)
+#define FD_ALUT_ADDR_MAX  (256UL)
+
+/* FD_ALUT_DEACTIVATION_COOLDOWN is the number of entries in the slot
+   hashes sysvar.  A table deactivated in slot d is usable through slot
+   d+FD_ALUT_DEACTIVATION_COOLDOWN inclusive. */
+
+#define FD_ALUT_DEACTIVATION_COOLDOWN (512UL)
+
+/* FD_ALUT_SLOT_NONE is the deactivation_slot of a table that has not
+   been deactivated. */
+
+#define FD_ALUT_SLOT_NONE (ULONG_MAX)
+
+/* FD_ALUT_{SUCCESS,ERR_*} give the results of the fd_alut operations
+   that can fail. */
+
+#define FD_ALUT_SUCCESS     ( 0) /* success */
+#define FD_ALUT_ERR_INVAL   (-1) /* bad input arguments (e.g. too many addresses) */
+#define FD_ALUT_ERR_FULL    (-2) /* no room for another table */
+#define FD_ALUT_ERR_TABLE   (-3) /* the transaction uses a table that is not in the store or not usable in the slot */
+#define FD_ALUT_ERR_IDX     (-4) /* the transaction selects an address past the end of the table's usable addresses */
+
+/* fd_alut_acct_t is an account of a resolved transaction. */
+
+struct fd_alut_acct {
+  fd_txn_acct_addr_t addr;     /* Account address */
+  int                writable; /* 1 if the transaction writes the account and 0 if it only reads it */
+};
+
+typedef struct fd_alut_acct fd_alut_acct_t;
+
+/* fd_alut_t is an opaque handle of a join to an address lookup table
+   store. */
+
+struct fd_alut_private;
+typedef struct fd_alut_private fd_alut_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_alut_{align,footprint} return the alignment and footprint required
+   for a memory region to be used as an address lookup table store that
+   can hold up to table_max tables.  footprint returns 0 if table_max is
+   not in [1,FD_ALUT_TABLE_MAX] (the footprint is about 8 KiB per
+   table).
+
+   fd_alut_new formats a memory region with the appropriate alignment
+   and footprint into an empty store.  Returns shmem on success and NULL
+   on failure (logs details).  Caller is not joined on return.
+
+   fd_alut_join joins the caller to a store.  Returns a handle to the
+   caller's local join on success and NULL on failure (logs details).
+
+   fd_alut_leave leaves a current local join.  Returns the underlying
+   shared memory region on success and NULL on failure (logs details).
+
+   fd_alut_delete unformats a memory region used as a store.  Assumes
+   nobody is joined.  Returns shmem on success and NULL on failure (logs
+   details). */
+
+FD_FN_CONST ulong
+fd_alut_align( void );
+
+FD_FN_CONST ulong
+fd_alut_footprint( ulong table_max );
+
+void *
+fd_alut_new( void * shmem,
+             ulong  table_max );
+
+fd_alut_t *
+fd_alut_join( void * shalut );
+
+void *
+fd_alut_leave( fd_alut_t * alut );
+
+void *
+fd_alut_delete( void * shalut );
+
+/* fd_alut_{table_max,table_cnt} return the maximum / current number of
+   tables in the store. */
+
+FD_FN_PURE ulong fd_alut_table_max( fd_alut_t const * alut );
+FD_FN_PURE ulong fd_alut_table_cnt( fd_alut_t const * alut );
+
+/* fd_alut_upsert inserts the table at address key into the store or
+   replaces its current contents.  The table holds the addr_cnt
+   addresses at addr + i*FD_TXN_ACCT_ADDR_SZ for i in [0,addr_cnt)
+   (unaligned okay).  last_extended_slot, last_extended_start and
+   deactivation_slot are as in the table's on-chain metadata (use
+   FD_ALUT_SLOT_NONE for a table that is not deactivated).  Returns
+   FD_ALUT_SUCCESS on success and FD_ALUT_ERR_INVAL (key is the all zero
+   address, addr_cnt is more than FD_ALUT_ADDR_MAX or
+   last_extended_start is more than addr_cnt) or FD_ALUT_ERR_FULL (key
+   is not in the store and the store has table_max tables) on failure
+   (the store is unchanged on failure).
+
+   fd_alut_remove removes the table at address key from the store.
+   Returns 1 if the table was in the store and 0 otherwise. */
+
+int
+fd_alut_upsert( fd_alut_t *                alut,
+                fd_txn_acct_addr_t const * key,
+                uchar const *              addr,
+                ulong                      addr_cnt,
+                ulong                      last_extended_slot,
+                ulong                      last_extended_start,
+                ulong                      deactivation_slot );
+
+int
+fd_alut_remove( fd_alut_t *                alut,
+                fd_txn_acct_addr_t const * key );
+
+/* fd_alut_lookup returns the addresses of the table at address key that
+   can be used in slot and stores their number in *_addr_cnt.  Returns
+   NULL (and does not touch *_addr_cnt) if the table is not in the store
+   or can't be used in slot.  The returned addresses are valid until the
+   next upsert or remove. */
+
+fd_txn_acct_addr_t const *
+fd_alut_lookup( fd_alut_t const *          alut,
+                fd_txn_acct_addr_t const * key,
+                ulong                      slot,
+                ulong *                    _addr_cnt );
+
+/* fd_alut_resolve expands the accounts of the transaction described by
+   txn, whose payload is pointed to by payload, as if it was executed in
+   slot.  The accounts are written to out (which should have room for
+   FD_TXN_ACCT_ADDR_MAX accounts) in the transaction's account order:
+   the static accounts, then the writable accounts selected from each
+   table (in table order) and then the readonly accounts selected from
+   each table.  An address that appears more than once is only written
+   the first time and is writable if any of its appearances is writable.
+   Returns FD_ALUT_SUCCESS on success (*_acct_cnt is set to the number
+   of accounts written) and FD_ALUT_ERR_TABLE or FD_ALUT_ERR_IDX on
+   failure (the contents of out and *_acct_cnt are undefined).  Does no
+   dynamic allocation.  Works for legacy transactions too (they have no
+   tables).
+
+   The resolved writable flags are those the transaction requests.  The
+   runtime's demotion of writes to reserved accounts (e.g. sysvars) is
+   not applied. */
+
+int
+fd_alut_resolve( fd_alut_t const * alut,
+                 fd_txn_t const *  txn,
+                 uchar const *     payload,
+                 ulong             slot,
+                 fd_alut_acct_t *  out,
+                 ulong *           _acct_cnt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_txn_fd_alut_h */
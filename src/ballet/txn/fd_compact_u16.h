@@ -1,7 +1,7 @@
 #ifndef HEADER_fd_src_ballet_txn_fd_compact_u16_h
 #define HEADER_fd_src_ballet_txn_fd_compact_u16_h
 
-/* This file declares some utility methods for decoding compact-u16, a variable
+/* This file declares some utility methods for coding compact-u16, a variable
    length encoding format for unsigned 16 bit numbers that Solana transactions
    use in the wireline format.
    The format is documented at
@@ -88,5 +88,34 @@ fd_cu16_dec( uchar const * buf,
   return sz;
 }
 
+/* fd_cu16_enc_sz: Returns the number of bytes in the (minimal) compact-u16
+   encoding of v.  Result will be in {1, 2, 3}. */
+FD_FN_CONST static inline ulong
+fd_cu16_enc_sz( ushort v ) {
+  return 1UL + (ulong)(v>=(ushort)0x80) + (ulong)(v>=(ushort)0x4000);
+}
+
+/* fd_cu16_enc: Writes the compact-u16 encoding of v to the location pointed
+   to by buf.  Returns the length of the encoding, i.e. fd_cu16_enc_sz( v ),
+   which is exactly the number of bytes written. */
+static inline ulong
+fd_cu16_enc( ushort  v,
+             uchar * buf ) {
+  ulong w = (ulong)v;
+  if( FD_LIKELY( w<0x80UL ) ) {
+    buf[0] = (uchar)w;
+    return 1UL;
+  }
+  if( FD_LIKELY( w<0x4000UL ) ) {
+    buf[0] = (uchar)(0x80UL | (w&0x7FUL));
+    buf[1] = (uchar)(w>>7);
+    return 2UL;
+  }
+  buf[0] = (uchar)(0x80UL | ( w     &0x7FUL));
+  buf[1] = (uchar)(0x80UL | ((w>>7 )&0x7FUL));
+  buf[2] = (uchar)(w>>14);
+  return 3UL;
+}
+
 FD_PROTOTYPES_END
 #endif /* HEADER_fd_src_ballet_txn_fd_compact_u16_h */
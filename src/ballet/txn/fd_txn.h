@@ -51,6 +51,15 @@
    SHA256 hash, giving a size of 256 bits = 32 bytes. */
 #define FD_TXN_BLOCKHASH_SZ (32UL)
 
+/* fd_txn_acct_addr_t: An account address, as a value type (e.g. for use as
+   a map key).  Account addresses inside a payload are unaligned, so copy
+   them out with memcpy rather than casting a pointer into the payload. */
+union fd_txn_acct_addr {
+  uchar b [ FD_TXN_ACCT_ADDR_SZ ];
+  ulong ul[ FD_TXN_ACCT_ADDR_SZ/sizeof(ulong) ];
+};
+typedef union fd_txn_acct_addr fd_txn_acct_addr_t;
+
 
 /* FD_TXN_SIG_MAX: The (inclusive) maximum number of signatures a transaction
    can have.  Note: for the current MTU size of 1232 B, the maximum that a
@@ -91,6 +100,11 @@
    payer), and tons of empty instructions (no accounts, no data). */
 #define FD_TXN_MAX_SZ                (3570UL)
 
+/* FD_TXN_MTU: The maximum size (in bytes) of a serialized transaction, i.e.
+   the largest payload the network accepts.  This is the IPv6 minimum MTU of
+   1280 B less 48 B for the IPv6 and UDP headers. */
+#define FD_TXN_MTU                   (1232UL)
+
 
 /* A Solana transaction instruction, i.e. one command or step to execute in a
    transaction.
@@ -388,6 +402,24 @@ fd_txn_footprint( ulong instr_cnt,
    payload. */
 ulong fd_txn_parse( uchar const * payload, ulong payload_sz, void * out_buf, fd_txn_parse_counters_t * counters_opt );
 
+/* fd_txn_parse_batch: Parses txn_cnt transactions.  For txn_idx in
+   [0,txn_cnt), parses the payload_sz[ txn_idx ] byte transaction pointed to by
+   payload[ txn_idx ] into out_buf[ txn_idx ] (which must have room for at
+   least FD_TXN_MAX_SZ bytes) and stores the fd_txn_parse return value in
+   out_sz[ txn_idx ].  Returns the number of transactions that parsed
+   successfully.  Accepts and rejects exactly the same payloads as (and produces
+   the same output as) fd_txn_parse, but uses vectorized validation where
+   available.  This is the preferred API for parsing at ingress rates.
+   counters_opt is accumulated into as by fd_txn_parse (the line numbers in the
+   failure ring might differ). */
+ulong
+fd_txn_parse_batch( uchar const * const *     payload,
+                    ulong const *             payload_sz,
+                    ulong                     txn_cnt,
+                    void * const *            out_buf,
+                    ulong *                   out_sz,
+                    fd_txn_parse_counters_t * counters_opt );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_txn_fd_txn_h */
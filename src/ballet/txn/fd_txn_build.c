@@ -0,0 +1,209 @@
+#include "fd_txn_build.h"
+#include "fd_compact_u16.h"
+
+ulong
+fd_txn_build_payload_sz( fd_txn_build_t const * b ) {
+  ulong acct_addr_cnt = (ulong)b->acct_addr_cnt;
+
+  /* signature_cnt is always a 1 byte compact-u16 as it is at most
+     FD_TXN_SIG_MAX.  The message header is the optional version byte
+     followed by the 3 count bytes. */
+  ulong sz = 1UL + FD_TXN_SIGNATURE_SZ*(ulong)b->signature_cnt
+           + (ulong)(b->transaction_version==FD_TXN_V0) + 3UL
+           + fd_cu16_enc_sz( b->acct_addr_cnt ) + FD_TXN_ACCT_ADDR_SZ*acct_addr_cnt
+           + FD_TXN_BLOCKHASH_SZ
+           + fd_cu16_enc_sz( b->instr_cnt );
+
+  for( ulong j=0UL; j<(ulong)b->instr_cnt; j++ ) {
+    fd_txn_build_instr_t const * instr = b->instr + j;
+    sz += 1UL + fd_cu16_enc_sz( instr->acct_cnt ) + (ulong)instr->acct_cnt
+              + fd_cu16_enc_sz( instr->data_sz  ) + (ulong)instr->data_sz;
+  }
+
+  if( FD_LIKELY( b->transaction_version==FD_TXN_V0 ) ) {
+    sz += fd_cu16_enc_sz( (ushort)b->addr_table_lookup_cnt );
+    for( ulong j=0UL; j<(ulong)b->addr_table_lookup_cnt; j++ ) {
+      fd_txn_build_lut_t const * lut = b->addr_table_lookup + j;
+      sz += FD_TXN_ACCT_ADDR_SZ + fd_cu16_enc_sz( (ushort)lut->writable_cnt ) + (ulong)lut->writable_cnt
+                                + fd_cu16_enc_sz( (ushort)lut->readonly_cnt ) + (ulong)lut->readonly_cnt;
+    }
+  }
+
+  return sz;
+}
+
+ulong
+fd_txn_build( fd_txn_build_t const * b,
+              uchar *                payload,
+              ulong                  payload_max,
+              void *                 out_buf,
+              ulong *                _payload_sz ) {
+
+  /* Validate the description first (with the same checks and in the
+     same order as fd_txn_parse) such that nothing gets written on
+     failure.  This only touches the description, which is much smaller
+     than the payload. */
+
+  uchar transaction_version   = b->transaction_version;
+  ulong signature_cnt         = (ulong)b->signature_cnt;
+  ulong ro_signed_cnt         = (ulong)b->readonly_signed_cnt;
+  ulong ro_unsigned_cnt       = (ulong)b->readonly_unsigned_cnt;
+  ulong acct_addr_cnt         = (ulong)b->acct_addr_cnt;
+  ulong instr_cnt             = (ulong)b->instr_cnt;
+  ulong addr_table_lookup_cnt = (ulong)b->addr_table_lookup_cnt;
+
+  int v0 = (transaction_version==FD_TXN_V0);
+  if( FD_UNLIKELY( (!v0) & (transaction_version!=FD_TXN_VLEGACY) ) ) return 0UL;
+  if( FD_UNLIKELY( (!v0) & (addr_table_lookup_cnt>0UL)           ) ) return 0UL; /* Legacy transactions have no tables */
+
+  if( FD_UNLIKELY( !((1UL<=signature_cnt) & (signature_cnt<=FD_TXN_SIG_MAX))           ) ) return 0UL;
+  if( FD_UNLIKELY( !(ro_signed_cnt<signature_cnt)                                       ) ) return 0UL;
+  if( FD_UNLIKELY( !((signature_cnt<=acct_addr_cnt) & (acct_addr_cnt<=FD_TXN_ACCT_ADDR_MAX)) ) ) return 0UL;
+  if( FD_UNLIKELY( !(signature_cnt+ro_unsigned_cnt<=acct_addr_cnt)                      ) ) return 0UL;
+  if( FD_UNLIKELY( !(addr_table_lookup_cnt<=FD_TXN_ADDR_TABLE_LOOKUP_MAX)               ) ) return 0UL;
+
+  ulong addr_table_adtl_writable_cnt = 0UL;
+  ulong addr_table_adtl_cnt          = 0UL;
+  for( ulong j=0UL; j<addr_table_lookup_cnt; j++ ) {
+    fd_txn_build_lut_t const * lut = b->addr_table_lookup + j;
+    ulong writable_cnt = (ulong)lut->writable_cnt;
+    ulong readonly_cnt = (ulong)lut->readonly_cnt;
+    if( FD_UNLIKELY( (writable_cnt>0UL) & (!lut->writable) ) ) return 0UL;
+    if( FD_UNLIKELY( (readonly_cnt>0UL) & (!lut->readonly) ) ) return 0UL;
+    if( FD_UNLIKELY( writable_cnt>FD_TXN_ACCT_ADDR_MAX-acct_addr_cnt ) ) return 0UL;
+    if( FD_UNLIKELY( readonly_cnt>FD_TXN_ACCT_ADDR_MAX-acct_addr_cnt ) ) return 0UL;
+    addr_table_adtl_writable_cnt += writable_cnt;
+    addr_table_adtl_cnt          += writable_cnt + readonly_cnt;
+  }
+  if( FD_UNLIKELY( acct_addr_cnt+addr_table_adtl_cnt>FD_TXN_ACCT_ADDR_MAX ) ) return 0UL;
+
+  ulong idx_cnt = acct_addr_cnt + addr_table_adtl_cnt;
+  for( ulong j=0UL; j<instr_cnt; j++ ) {
+    fd_txn_build_instr_t const * instr = b->instr + j;
+    ulong acct_cnt = (ulong)instr->acct_cnt;
+    /* Account 0 is the fee payer, which can't be the program (see
+       fd_txn_parse) */
+    if( FD_UNLIKELY( !((0UL<(ulong)instr->program_id) & ((ulong)instr->program_id<idx_cnt)) ) ) return 0UL;
+    if( FD_UNLIKELY( (acct_cnt>0UL) & (!instr->acct) ) ) return 0UL;
+    for( ulong k=0UL; k<acct_cnt; k++ ) if( FD_UNLIKELY( (ulong)instr->acct[ k ]>=idx_cnt ) ) return 0UL;
+  }
+
+  ulong footprint = fd_txn_footprint( instr_cnt, addr_table_lookup_cnt );
+  if( FD_UNLIKELY( footprint>FD_TXN_MAX_SZ ) ) return 0UL;
+
+  ulong payload_sz = fd_txn_build_payload_sz( b );
+  if( FD_UNLIKELY( payload_sz>fd_ulong_min( payload_max, USHORT_MAX ) ) ) return 0UL;
+
+  /* Serialize.  Since payload_sz<=USHORT_MAX, all the offsets below fit
+     in a ushort. */
+
+  fd_txn_t * txn = (fd_txn_t *)out_buf;
+  ulong      i   = 0UL;
+
+  payload[ i++ ] = (uchar)signature_cnt;
+  ulong signature_off = i;
+  memset( payload+i, 0, FD_TXN_SIGNATURE_SZ*signature_cnt );
+  i += FD_TXN_SIGNATURE_SZ*signature_cnt;
+
+  ulong message_off = i;
+  if( FD_LIKELY( v0 ) ) payload[ i++ ] = (uchar)(0x80U | (uint)FD_TXN_V0);
+  payload[ i++ ] = (uchar)signature_cnt;
+  payload[ i++ ] = (uchar)ro_signed_cnt;
+  payload[ i++ ] = (uchar)ro_unsigned_cnt;
+
+  i += fd_cu16_enc( (ushort)acct_addr_cnt, payload+i );
+  ulong acct_addr_off = i;
+  if( FD_LIKELY( b->acct_addr ) ) memcpy( payload+i, b->acct_addr, FD_TXN_ACCT_ADDR_SZ*acct_addr_cnt );
+  i += FD_TXN_ACCT_ADDR_SZ*acct_addr_cnt;
+
+  ulong recent_blockhash_off = i;
+  if( FD_LIKELY( b->recent_blockhash ) ) memcpy( payload+i, b->recent_blockhash, FD_TXN_BLOCKHASH_SZ );
+  i += FD_TXN_BLOCKHASH_SZ;
+
+  txn->transaction_version          = transaction_version;
+  txn->signature_cnt                = (uchar)signature_cnt;
+  txn->signature_off                = (ushort)signature_off;
+  txn->message_off                  = (ushort)message_off;
+  txn->readonly_signed_cnt          = (uchar)ro_signed_cnt;
+  txn->readonly_unsigned_cnt        = (uchar)ro_unsigned_cnt;
+  txn->acct_addr_cnt                = (ushort)acct_addr_cnt;
+  txn->acct_addr_off                = (ushort)acct_addr_off;
+  txn->recent_blockhash_off         = (ushort)recent_blockhash_off;
+  txn->addr_table_lookup_cnt        = (uchar)addr_table_lookup_cnt;
+  txn->addr_table_adtl_writable_cnt = (uchar)addr_table_adtl_writable_cnt;
+  txn->addr_table_adtl_cnt          = (uchar)addr_table_adtl_cnt;
+  txn->_padding_reserved_1          = (uchar)0;
+  txn->instr_cnt                    = (ushort)instr_cnt;
+
+  i += fd_cu16_enc( (ushort)instr_cnt, payload+i );
+  for( ulong j=0UL; j<instr_cnt; j++ ) {
+    fd_txn_build_instr_t const * instr = b->instr + j;
+    ulong acct_cnt = (ulong)instr->acct_cnt;
+    ulong data_sz  = (ulong)instr->data_sz;
+
+    payload[ i++ ] = instr->program_id;
+    i += fd_cu16_enc( instr->acct_cnt, payload+i );
+    ulong acct_off = i;
+    if( FD_LIKELY( acct_cnt ) ) memcpy( payload+i, instr->acct, acct_cnt );
+    i += acct_cnt;
+    i += fd_cu16_enc( instr->data_sz, payload+i );
+    ulong data_off = i;
+    if( FD_LIKELY( instr->data && data_sz ) ) memcpy( payload+i, instr->data, data_sz );
+    i += data_sz;
+
+    txn->instr[ j ].program_id          = instr->program_id;
+    txn->instr[ j ]._padding_reserved_1 = (uchar)0;
+    txn->instr[ j ].acct_cnt            = (ushort)acct_cnt;
+    txn->instr[ j ].data_sz             = (ushort)data_sz;
+    txn->instr[ j ].acct_off            = (ushort)acct_off;
+    txn->instr[ j ].data_off            = (ushort)data_off;
+  }
+
+  if( FD_LIKELY( v0 ) ) {
+    fd_txn_acct_addr_lut_t * address_tables = fd_txn_get_address_tables( txn ); /* instr_cnt set above */
+    i += fd_cu16_enc( (ushort)addr_table_lookup_cnt, payload+i );
+    for( ulong j=0UL; j<addr_table_lookup_cnt; j++ ) {
+      fd_txn_build_lut_t const * lut = b->addr_table_lookup + j;
+      ulong writable_cnt = (ulong)lut->writable_cnt;
+      ulong readonly_cnt = (ulong)lut->readonly_cnt;
+
+      ulong addr_off = i;
+      if( FD_LIKELY( lut->addr ) ) memcpy( payload+i, lut->addr, FD_TXN_ACCT_ADDR_SZ );
+      i += FD_TXN_ACCT_ADDR_SZ;
+      i += fd_cu16_enc( (ushort)writable_cnt, payload+i );
+      ulong writable_off = i;
+      if( FD_LIKELY( writable_cnt ) ) memcpy( payload+i, lut->writable, writable_cnt );
+      i += writable_cnt;
+      i += fd_cu16_enc( (ushort)readonly_cnt, payload+i );
+      ulong readonly_off = i;
+      if( FD_LIKELY( readonly_cnt ) ) memcpy( payload+i, lut->readonly, readonly_cnt );
+      i += readonly_cnt;
+
+      address_tables[ j ].addr_off     = (ushort)addr_off;
+      address_tables[ j ].writable_cnt = (uchar)writable_cnt;
+      address_tables[ j ].readonly_cnt = (uchar)readonly_cnt;
+      address_tables[ j ].writable_off = (ushort)writable_off;
+      address_tables[ j ].readonly_off = (ushort)readonly_off;
+    }
+  }
+
+#if FD_TXN_HANDHOLDING
+  FD_TEST( i==payload_sz );
+#endif
+
+  *_payload_sz = payload_sz;
+  return footprint;
+}
+
+void
+fd_txn_build_sign( uchar *          payload,
+                   ulong            payload_sz,
+                   fd_txn_t const * txn,
+                   ulong            sig_idx,
+                   void const *     public_key,
+                   void const *     private_key,
+                   fd_sha512_t *    sha ) {
+  fd_ed25519_sign( payload + (ulong)txn->signature_off + FD_TXN_SIGNATURE_SZ*sig_idx,
+                   payload + (ulong)txn->message_off, payload_sz - (ulong)txn->message_off,
+                   public_key, private_key, sha );
+}
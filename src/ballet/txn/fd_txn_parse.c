@@ -1,13 +1,53 @@
 #include "fd_txn.h"
 #include "fd_compact_u16.h"
 
-
-
-ulong
-fd_txn_parse( uchar const             * payload,
-              ulong                     payload_sz,
-              void                    * out_buf,
-              fd_txn_parse_counters_t * counters_opt ) {
+#if FD_HAS_AVX
+#include <x86intrin.h>
+
+/* fd_txn_parse_acct_idx_ok returns 1 if the cnt account indices at
+   payload[off,off+cnt) are all less than idx_cnt and 0 otherwise.
+   Assumes off+cnt<=payload_sz and idx_cnt in [1,256].  Checks up to 32
+   indices per iteration.  Loads never go past payload_sz: the (rare)
+   instructions whose account indices end within 32 bytes of the end of
+   the payload finish with the scalar loop. */
+
+static inline int
+fd_txn_parse_acct_idx_ok( uchar const * payload,
+                          ulong         payload_sz,
+                          ulong         off,
+                          ulong         cnt,
+                          ulong         idx_cnt ) {
+  __m256i idx_max = _mm256_set1_epi8( (char)(uchar)(idx_cnt-1UL) );
+  __m256i lane    = _mm256_setr_epi8(  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+                                      16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 );
+  while( cnt ) {
+    if( FD_UNLIKELY( 32UL>payload_sz-off ) ) break;
+    ulong   n   = fd_ulong_min( cnt, 32UL );
+    __m256i idx = _mm256_loadu_si256( (__m256i const *)(payload+off) );
+    __m256i use = _mm256_cmpgt_epi8( _mm256_set1_epi8( (char)n ), lane );                 /* lanes [0,n) */
+    __m256i ok  = _mm256_cmpeq_epi8( _mm256_min_epu8( idx, idx_max ), idx );                /* idx<=idx_cnt-1 */
+    if( FD_UNLIKELY( _mm256_movemask_epi8( _mm256_andnot_si256( ok, use ) ) ) ) return 0;
+    off += n;
+    cnt -= n;
+  }
+  for( ulong k=0UL; k<cnt; k++ ) if( FD_UNLIKELY( payload[ off+k ]>=idx_cnt ) ) return 0;
+  return 1;
+}
+#endif
+
+/* fd_txn_parse_core does the actual parsing for fd_txn_parse and
+   fd_txn_parse_batch.  vec is a compile time constant selecting the
+   vectorized validation paths (the scalar paths are kept as the
+   reference implementation used by fd_txn_parse).  Both accept and
+   reject exactly the same payloads and produce identical output. */
+
+static inline __attribute__((always_inline)) ulong
+fd_txn_parse_core( uchar const             * payload,
+                   ulong                     payload_sz,
+                   void                    * out_buf,
+                   fd_txn_parse_counters_t * counters_opt,
+                   int                       vec ) {
+  (void)vec;
   ulong i = 0UL;
   /* This code does non-trivial parsing of untrusted user input, which is a potentially dangerous thing.
      The main invariants we need to ensure are
@@ -58,14 +98,21 @@ fd_txn_parse( uchar const             * payload,
   #define CHECK_LEFT( n ) CHECK( (n)<=(payload_sz-i) )
   /* READ_CHECKED_COMPACT_U16 safely reads a compact-u16 from the indicated
      location in the payload.  It stores the resulting value in the ushort
-     variable called var_name.  It stores the size in out_sz. */
-  #define READ_CHECKED_COMPACT_U16( out_sz, var_name, where )               \
-    do {                                                                    \
-      ulong _where = (where);                                               \
-      ulong _out_sz = fd_cu16_dec_sz( payload+_where, payload_sz-_where );  \
-      CHECK( _out_sz );                                                     \
-      (var_name) = fd_cu16_dec_fixed( payload+_where, _out_sz );            \
-      (out_sz)   = _out_sz;                                                 \
+     variable called var_name.  It stores the size in out_sz.  Nearly all
+     compact-u16s in practice are a single byte, which gets its own fast
+     path. */
+  #define READ_CHECKED_COMPACT_U16( out_sz, var_name, where )                 \
+    do {                                                                      \
+      ulong _where = (where);                                                 \
+      if( FD_LIKELY( (_where<payload_sz) && !(0x80 & payload[ _where ]) ) ) { \
+        (var_name) = (ushort)payload[ _where ];                               \
+        (out_sz)   = 1UL;                                                     \
+        break;                                                                \
+      }                                                                       \
+      ulong _out_sz = fd_cu16_dec_sz( payload+_where, payload_sz-_where );    \
+      CHECK( _out_sz );                                                       \
+      (var_name) = fd_cu16_dec_fixed( payload+_where, _out_sz );              \
+      (out_sz)   = _out_sz;                                                   \
     } while( 0 )
 
   /* Minimal instr has 1B for program id, 1B acct_addr list, 1B for no data */
@@ -198,6 +245,13 @@ fd_txn_parse( uchar const             * payload,
        program must be an executable account and the system program is not
        permitted to own any executable account. */
     CHECK( (0 < parsed->instr[ j ].program_id) & (parsed->instr[ j ].program_id < acct_addr_cnt + addr_table_adtl_cnt) );
+#if FD_HAS_AVX
+    if( vec ) {
+      CHECK( fd_txn_parse_acct_idx_ok( payload, payload_sz, parsed->instr[ j ].acct_off, parsed->instr[ j ].acct_cnt,
+                                       acct_addr_cnt + addr_table_adtl_cnt ) );
+      continue;
+    }
+#endif
     for( ulong k=0; k<parsed->instr[ j ].acct_cnt; k++ ) {
       CHECK( payload[ parsed->instr[ j ].acct_off + k ] < acct_addr_cnt + addr_table_adtl_cnt );
     }
@@ -215,3 +269,27 @@ fd_txn_parse( uchar const             * payload,
   #undef CHECK_LEFT
   #undef READ_CHECKED_COMPACT_U16
 }
+
+ulong
+fd_txn_parse( uchar const             * payload,
+              ulong                     payload_sz,
+              void                    * out_buf,
+              fd_txn_parse_counters_t * counters_opt ) {
+  return fd_txn_parse_core( payload, payload_sz, out_buf, counters_opt, 0 );
+}
+
+ulong
+fd_txn_parse_batch( uchar const * const *     payload,
+                    ulong const *             payload_sz,
+                    ulong                     txn_cnt,
+                    void * const *            out_buf,
+                    ulong *                   out_sz,
+                    fd_txn_parse_counters_t * counters_opt ) {
+  ulong ok_cnt = 0UL;
+  for( ulong txn_idx=0UL; txn_idx<txn_cnt; txn_idx++ ) {
+    ulong sz = fd_txn_parse_core( payload[ txn_idx ], payload_sz[ txn_idx ], out_buf[ txn_idx ], counters_opt, 1 );
+    out_sz[ txn_idx ] = sz;
+    ok_cnt += (ulong)!!sz;
+  }
+  return ok_cnt;
+}
@@ -34,5 +34,30 @@ LLVMFuzzerTestOneInput( uchar const * data,
     FD_TEST( fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt )<=FD_TXN_MAX_SZ );
   }
 
+  /* Differential check of the batch parser against the reference.  The
+     input is parsed at the very end of a heap allocation such that
+     reads past the payload get caught by the sanitizers. */
+
+  ulong   alloc_sz = fd_ulong_max( size, 1UL );
+  uchar * alloc    = (uchar *)malloc( alloc_sz );
+  FD_TEST( alloc );
+  uchar * payload  = alloc + alloc_sz - size;
+  fd_memcpy( payload, data, size );
+
+  uchar __attribute__((aligned((alignof(fd_txn_t))))) batch_buf[ FD_TXN_MAX_SZ ];
+  uchar const * batch_payload[1] = { payload   };
+  ulong         batch_sz     [1] = { size      };
+  void *        batch_out    [1] = { batch_buf };
+  ulong         batch_out_sz [1];
+  fd_txn_parse_counters_t batch_counters = {0};
+
+  FD_TEST( fd_txn_parse_batch( batch_payload, batch_sz, 1UL, batch_out, batch_out_sz, &batch_counters )==(ulong)!!sz );
+  FD_TEST( batch_out_sz[0]==sz );
+  FD_TEST( batch_counters.success_cnt==counters.success_cnt );
+  FD_TEST( batch_counters.failure_cnt==counters.failure_cnt );
+  if( FD_LIKELY( sz>0UL ) ) FD_TEST( !memcmp( batch_buf, txn_buf, sz ) );
+
+  free( alloc );
+
   return 0;
 }
@@ -0,0 +1,326 @@
+#include "../fd_ballet.h"
+
+/* This transaction landed on mainnet.  It loads 21 accounts from 3
+   address lookup tables. */
+FD_IMPORT_BINARY( transaction2, "src/ballet/txn/fixtures/transaction2.bin" );
+
+#define TABLE_MAX (64UL)
+#define UNIVERSE  (64UL) /* Addresses used by the randomized test are numbered [1,UNIVERSE] */
+
+static uchar alut_mem[ 1UL<<20 ] __attribute__((aligned(FD_ALUT_ALIGN)));
+
+static uchar txn_mem[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+static uchar payload[ 8192UL ];
+
+static fd_alut_acct_t out[ FD_TXN_ACCT_ADDR_MAX ];
+static fd_alut_acct_t ref[ FD_TXN_ACCT_ADDR_MAX ];
+
+#define TXN ((fd_txn_t *)txn_mem)
+
+static fd_txn_acct_addr_t
+addr_of( ulong a ) {
+  fd_txn_acct_addr_t addr;
+  fd_memset( addr.b, 0, FD_TXN_ACCT_ADDR_SZ );
+  memcpy( addr.b + 5UL, &a, sizeof(ulong) );
+  return addr;
+}
+
+/* Shadow of the store contents */
+
+static ulong table_addr_cnt[ TABLE_MAX ];
+static ulong table_addr    [ TABLE_MAX ][ FD_ALUT_ADDR_MAX ];
+static ulong table_ext_slot[ TABLE_MAX ];
+static ulong table_ext_start[ TABLE_MAX ];
+static ulong table_deact   [ TABLE_MAX ];
+static int   table_present [ TABLE_MAX ];
+
+static void
+upsert( fd_alut_t * alut,
+        ulong       t,
+        ulong       addr_cnt,
+        ulong       ext_slot,
+        ulong       ext_start,
+        ulong       deact,
+        fd_rng_t *  rng ) {
+  static uchar buf[ FD_ALUT_ADDR_MAX*FD_TXN_ACCT_ADDR_SZ+1UL ];
+  for( ulong i=0UL; i<addr_cnt; i++ ) {
+    table_addr[ t ][ i ] = 1UL + fd_rng_ulong_roll( rng, UNIVERSE );
+    fd_txn_acct_addr_t a = addr_of( table_addr[ t ][ i ] );
+    memcpy( buf + 1UL + i*FD_TXN_ACCT_ADDR_SZ, a.b, FD_TXN_ACCT_ADDR_SZ ); /* Unaligned on purpose */
+  }
+  fd_txn_acct_addr_t key = addr_of( 1000UL + t );
+  FD_TEST( fd_alut_upsert( alut, &key, buf+1UL, addr_cnt, ext_slot, ext_start, deact )==FD_ALUT_SUCCESS );
+  table_addr_cnt [ t ] = addr_cnt;
+  table_ext_slot [ t ] = ext_slot;
+  table_ext_start[ t ] = ext_start;
+  table_deact    [ t ] = deact;
+  table_present  [ t ] = 1;
+}
+
+/* ref_add and ref_resolve are a straightforward implementation of
+   fd_alut_resolve on top of the shadow. */
+
+static ulong
+ref_add( ulong cnt,
+         ulong a,
+         int   writable ) {
+  fd_txn_acct_addr_t addr = addr_of( a );
+  for( ulong i=0UL; i<cnt; i++ ) if( !memcmp( ref[ i ].addr.b, addr.b, FD_TXN_ACCT_ADDR_SZ ) ) { ref[ i ].writable |= writable; return cnt; }
+  ref[ cnt ].addr     = addr;
+  ref[ cnt ].writable = writable;
+  return cnt+1UL;
+}
+
+static int
+ref_resolve( ulong const * acct,
+             ulong         acct_cnt,
+             ulong const * lut_table,
+             ulong const * lut_w, ulong const * lut_w_cnt,
+             ulong const * lut_r, ulong const * lut_r_cnt,
+             ulong         lut_cnt,
+             ulong         slot,
+             ulong *       _cnt ) {
+  ulong sig_cnt = TXN->signature_cnt;
+  ulong cnt     = 0UL;
+  for( ulong i=0UL; i<acct_cnt; i++ )
+    cnt = ref_add( cnt, acct[ i ], (i<sig_cnt-TXN->readonly_signed_cnt) | ((i>=sig_cnt) & (i<acct_cnt-TXN->readonly_unsigned_cnt)) );
+  for( ulong j=0UL; j<lut_cnt; j++ ) {
+    ulong t = lut_table[ j ];
+    if( t>=TABLE_MAX || !table_present[ t ] ) return FD_ALUT_ERR_TABLE;
+    if( table_deact[ t ]!=FD_ALUT_SLOT_NONE && slot>=table_deact[ t ] && slot-table_deact[ t ]>FD_ALUT_DEACTIVATION_COOLDOWN )
+      return FD_ALUT_ERR_TABLE;
+    ulong usable = slot>table_ext_slot[ t ] ? table_addr_cnt[ t ] : table_ext_start[ t ];
+    for( ulong k=0UL; k<lut_w_cnt[ j ]; k++ ) if( lut_w[ j*8UL+k ]>=usable ) return FD_ALUT_ERR_IDX;
+    for( ulong k=0UL; k<lut_r_cnt[ j ]; k++ ) if( lut_r[ j*8UL+k ]>=usable ) return FD_ALUT_ERR_IDX;
+  }
+  for( ulong j=0UL; j<lut_cnt; j++ )
+    for( ulong k=0UL; k<lut_w_cnt[ j ]; k++ ) cnt = ref_add( cnt, table_addr[ lut_table[ j ] ][ lut_w[ j*8UL+k ] ], 1 );
+  for( ulong j=0UL; j<lut_cnt; j++ )
+    for( ulong k=0UL; k<lut_r_cnt[ j ]; k++ ) cnt = ref_add( cnt, table_addr[ lut_table[ j ] ][ lut_r[ j*8UL+k ] ], 0 );
+  *_cnt = cnt;
+  return FD_ALUT_SUCCESS;
+}
+
+static void
+test_random( fd_alut_t * alut,
+             fd_rng_t *  rng ) {
+  ulong ok_cnt = 0UL;
+  ulong err_cnt[ 5 ] = {0UL};
+  for( ulong iter=0UL; iter<200000UL; iter++ ) {
+
+    /* Churn the store */
+
+    ulong t = fd_rng_ulong_roll( rng, TABLE_MAX );
+    if( !fd_rng_uint_roll( rng, 16U ) ) {
+      fd_txn_acct_addr_t key = addr_of( 1000UL + t );
+      FD_TEST( fd_alut_remove( alut, &key )==table_present[ t ] );
+      table_present[ t ] = 0;
+    } else if( !fd_rng_uint_roll( rng, 4U ) ) {
+      ulong addr_cnt  = fd_rng_ulong_roll( rng, 33UL );
+      ulong ext_start = fd_rng_ulong_roll( rng, addr_cnt+1UL );
+      ulong deact     = fd_rng_uint_roll( rng, 4U ) ? FD_ALUT_SLOT_NONE : 1000UL + fd_rng_ulong_roll( rng, 2000UL );
+      upsert( alut, t, addr_cnt, 1000UL + fd_rng_ulong_roll( rng, 2000UL ), ext_start, deact, rng );
+    }
+
+    ulong present_cnt = 0UL;
+    for( ulong i=0UL; i<TABLE_MAX; i++ ) present_cnt += (ulong)table_present[ i ];
+    FD_TEST( fd_alut_table_cnt( alut )==present_cnt );
+
+    /* Make a random transaction: static accounts at the start of the
+       payload, then the table addresses, then the selected indices. */
+
+    ulong acct_cnt    = 1UL + fd_rng_ulong_roll( rng, 12UL );
+    ulong sig_cnt     = 1UL + fd_rng_ulong_roll( rng, acct_cnt );
+    ulong ro_signed   = fd_rng_ulong_roll( rng, sig_cnt );
+    ulong ro_unsigned = fd_rng_ulong_roll( rng, acct_cnt-sig_cnt+1UL );
+    ulong lut_cnt     = fd_rng_ulong_roll( rng, 5UL );
+    ulong slot        = 1000UL + fd_rng_ulong_roll( rng, 3000UL );
+
+    ulong acct[ 16 ];
+    ulong lut_table[ 4 ]; ulong lut_w[ 32 ]; ulong lut_w_cnt[ 4 ]; ulong lut_r[ 32 ]; ulong lut_r_cnt[ 4 ];
+
+    fd_memset( txn_mem, 0, sizeof(txn_mem) );
+    TXN->transaction_version   = lut_cnt ? FD_TXN_V0 : FD_TXN_VLEGACY;
+    TXN->signature_cnt         = (uchar)sig_cnt;
+    TXN->readonly_signed_cnt   = (uchar)ro_signed;
+    TXN->readonly_unsigned_cnt = (uchar)ro_unsigned;
+    TXN->acct_addr_cnt         = (ushort)acct_cnt;
+    TXN->acct_addr_off         = (ushort)1;
+    TXN->instr_cnt             = (ushort)0;
+    TXN->addr_table_lookup_cnt = (uchar)lut_cnt;
+
+    ulong off = 1UL;
+    for( ulong i=0UL; i<acct_cnt; i++ ) {
+      acct[ i ] = 1UL + fd_rng_ulong_roll( rng, UNIVERSE );
+      fd_txn_acct_addr_t a = addr_of( acct[ i ] );
+      memcpy( payload + off, a.b, FD_TXN_ACCT_ADDR_SZ );
+      off += FD_TXN_ACCT_ADDR_SZ;
+    }
+
+    fd_txn_acct_addr_lut_t * lut = fd_txn_get_address_tables( TXN );
+    ulong adtl_cnt = 0UL;
+    ulong adtl_w   = 0UL;
+    for( ulong j=0UL; j<lut_cnt; j++ ) {
+      lut_table[ j ] = fd_rng_ulong_roll( rng, TABLE_MAX+1UL ); /* TABLE_MAX is never in the store */
+      fd_txn_acct_addr_t key = addr_of( 1000UL + lut_table[ j ] );
+      lut[ j ].addr_off = (ushort)off;
+      memcpy( payload + off, key.b, FD_TXN_ACCT_ADDR_SZ );
+      off += FD_TXN_ACCT_ADDR_SZ;
+
+      lut_w_cnt[ j ] = fd_rng_ulong_roll( rng, 9UL );
+      lut_r_cnt[ j ] = fd_rng_ulong_roll( rng, 9UL );
+      lut[ j ].writable_cnt = (uchar)lut_w_cnt[ j ];
+      lut[ j ].readonly_cnt = (uchar)lut_r_cnt[ j ];
+      lut[ j ].writable_off = (ushort)off;
+      for( ulong k=0UL; k<lut_w_cnt[ j ]; k++ ) { lut_w[ j*8UL+k ] = fd_rng_ulong_roll( rng, 34UL ); payload[ off++ ] = (uchar)lut_w[ j*8UL+k ]; }
+      lut[ j ].readonly_off = (ushort)off;
+      for( ulong k=0UL; k<lut_r_cnt[ j ]; k++ ) { lut_r[ j*8UL+k ] = fd_rng_ulong_roll( rng, 34UL ); payload[ off++ ] = (uchar)lut_r[ j*8UL+k ]; }
+      adtl_cnt += lut_w_cnt[ j ] + lut_r_cnt[ j ];
+      adtl_w   += lut_w_cnt[ j ];
+    }
+    TXN->addr_table_adtl_cnt          = (uchar)adtl_cnt;
+    TXN->addr_table_adtl_writable_cnt = (uchar)adtl_w;
+
+    ulong cnt = 0UL; ulong ref_cnt = 0UL;
+    int err     = fd_alut_resolve( alut, TXN, payload, slot, out, &cnt );
+    int ref_err = ref_resolve( acct, acct_cnt, lut_table, lut_w, lut_w_cnt, lut_r, lut_r_cnt, lut_cnt, slot, &ref_cnt );
+    FD_TEST( err==ref_err );
+    err_cnt[ -err ]++;
+    if( err ) continue;
+    ok_cnt++;
+    FD_TEST( cnt==ref_cnt );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      FD_TEST( !memcmp( out[ i ].addr.b, ref[ i ].addr.b, FD_TXN_ACCT_ADDR_SZ ) );
+      FD_TEST( out[ i ].writable==ref[ i ].writable );
+    }
+  }
+  FD_LOG_NOTICE(( "ok %lu err_table %lu err_idx %lu", ok_cnt, err_cnt[ -FD_ALUT_ERR_TABLE ], err_cnt[ -FD_ALUT_ERR_IDX ] ));
+  FD_TEST( ok_cnt && err_cnt[ -FD_ALUT_ERR_TABLE ] && err_cnt[ -FD_ALUT_ERR_IDX ] );
+}
+
+/* test_fixture resolves a real v0 transaction against tables populated
+   with random addresses and times it. */
+
+static void
+test_fixture( fd_alut_t * alut,
+              fd_rng_t *  rng ) {
+  FD_TEST( fd_txn_parse( transaction2, transaction2_sz, txn_mem, NULL ) );
+  fd_txn_acct_addr_lut_t const * lut = fd_txn_get_address_tables( TXN );
+  FD_TEST( TXN->addr_table_lookup_cnt==3UL );
+
+  static uchar buf[ 3UL*FD_ALUT_ADDR_MAX*FD_TXN_ACCT_ADDR_SZ ];
+  for( ulong i=0UL; i<sizeof(buf); i++ ) buf[ i ] = fd_rng_uchar( rng );
+  for( ulong j=0UL; j<TXN->addr_table_lookup_cnt; j++ ) {
+    fd_txn_acct_addr_t key;
+    memcpy( key.b, transaction2 + lut[ j ].addr_off, FD_TXN_ACCT_ADDR_SZ );
+    FD_TEST( fd_alut_upsert( alut, &key, buf + j*FD_ALUT_ADDR_MAX*FD_TXN_ACCT_ADDR_SZ, FD_ALUT_ADDR_MAX, 10UL, 0UL, FD_ALUT_SLOT_NONE )==FD_ALUT_SUCCESS );
+
+    ulong addr_cnt = 0UL;
+    FD_TEST( fd_alut_lookup( alut, &key, 10UL, &addr_cnt )==NULL || addr_cnt==0UL ); /* Freshly extended, not usable yet */
+    FD_TEST( fd_alut_lookup( alut, &key, 11UL, &addr_cnt ) );
+    FD_TEST( addr_cnt==FD_ALUT_ADDR_MAX );
+  }
+
+  ulong cnt = 0UL;
+  FD_TEST( fd_alut_resolve( alut, TXN, transaction2, 10UL, out, &cnt )==FD_ALUT_ERR_IDX );
+  FD_TEST( fd_alut_resolve( alut, TXN, transaction2, 11UL, out, &cnt )==FD_ALUT_SUCCESS );
+  FD_TEST( cnt==(ulong)TXN->acct_addr_cnt + (ulong)TXN->addr_table_adtl_cnt ); /* All distinct */
+  ulong w_cnt = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) w_cnt += (ulong)out[ i ].writable;
+  FD_TEST( w_cnt==(ulong)(TXN->signature_cnt - TXN->readonly_signed_cnt) + (ulong)(TXN->acct_addr_cnt - TXN->signature_cnt - TXN->readonly_unsigned_cnt) +
+                  (ulong)TXN->addr_table_adtl_writable_cnt );
+
+  ulong iter_cnt = 1000000UL;
+  long  dt       = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    FD_TEST( !fd_alut_resolve( alut, TXN, transaction2, 11UL, out, &cnt ) );
+    FD_COMPILER_FORGET( cnt );
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "Average time per resolve (%lu accounts): %f ns", cnt, (double)dt/(double)iter_cnt ));
+
+  for( ulong j=0UL; j<TXN->addr_table_lookup_cnt; j++ ) {
+    fd_txn_acct_addr_t key;
+    memcpy( key.b, transaction2 + lut[ j ].addr_off, FD_TXN_ACCT_ADDR_SZ );
+    FD_TEST( fd_alut_remove( alut, &key )==1 );
+    FD_TEST( fd_alut_remove( alut, &key )==0 );
+  }
+  FD_TEST( fd_alut_resolve( alut, TXN, transaction2, 11UL, out, &cnt )==FD_ALUT_ERR_TABLE );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_alut_align()==FD_ALUT_ALIGN );
+  FD_TEST( !fd_alut_footprint( 0UL ) );
+  FD_TEST( !fd_alut_footprint( FD_ALUT_TABLE_MAX+1UL ) );
+  FD_TEST( fd_alut_footprint( FD_ALUT_TABLE_MAX ) );
+  ulong footprint = fd_alut_footprint( TABLE_MAX );
+  FD_TEST( footprint && footprint<=sizeof(alut_mem) );
+  FD_TEST( fd_ulong_is_aligned( footprint, FD_ALUT_ALIGN ) );
+
+  FD_TEST( !fd_alut_new( NULL,         TABLE_MAX ) );
+  FD_TEST( !fd_alut_new( alut_mem+1UL, TABLE_MAX ) );
+  FD_TEST( !fd_alut_new( alut_mem,     0UL       ) );
+  void * shalut = fd_alut_new( alut_mem, TABLE_MAX ); FD_TEST( shalut==alut_mem );
+
+  FD_TEST( !fd_alut_join( NULL         ) );
+  FD_TEST( !fd_alut_join( alut_mem+1UL ) );
+  fd_alut_t * alut = fd_alut_join( shalut ); FD_TEST( alut );
+
+  FD_TEST( fd_alut_table_max( alut )==TABLE_MAX );
+  FD_TEST( fd_alut_table_cnt( alut )==0UL       );
+
+  /* Bad upserts and full store */
+
+  fd_txn_acct_addr_t zero = addr_of( 0UL );
+  uchar dummy[ (FD_ALUT_ADDR_MAX+1UL)*FD_TXN_ACCT_ADDR_SZ ] = {0};
+  fd_txn_acct_addr_t key = addr_of( 1UL );
+  FD_TEST( fd_alut_upsert( alut, &zero, dummy, 1UL,                  0UL, 0UL, FD_ALUT_SLOT_NONE )==FD_ALUT_ERR_INVAL );
+  FD_TEST( fd_alut_upsert( alut, &key,  dummy, FD_ALUT_ADDR_MAX+1UL, 0UL, 0UL, FD_ALUT_SLOT_NONE )==FD_ALUT_ERR_INVAL );
+  FD_TEST( fd_alut_upsert( alut, &key,  dummy, 1UL,                  0UL, 2UL, FD_ALUT_SLOT_NONE )==FD_ALUT_ERR_INVAL );
+  FD_TEST( !fd_alut_remove( alut, &zero ) );
+  FD_TEST( !fd_alut_lookup( alut, &zero, 0UL, &footprint ) );
+  for( ulong t=0UL; t<TABLE_MAX; t++ ) {
+    key = addr_of( 1UL+t );
+    FD_TEST( fd_alut_upsert( alut, &key, dummy, t, 0UL, t, FD_ALUT_SLOT_NONE )==FD_ALUT_SUCCESS );
+  }
+  key = addr_of( 1UL+TABLE_MAX );
+  FD_TEST( fd_alut_upsert( alut, &key, dummy, 1UL, 0UL, 0UL, FD_ALUT_SLOT_NONE )==FD_ALUT_ERR_FULL );
+  key = addr_of( 1UL );
+  FD_TEST( fd_alut_upsert( alut, &key, dummy, 1UL, 0UL, 0UL, FD_ALUT_SLOT_NONE )==FD_ALUT_SUCCESS ); /* Replacing works when full */
+  FD_TEST( fd_alut_table_cnt( alut )==TABLE_MAX );
+
+  /* Deactivation */
+
+  ulong addr_cnt = 0UL;
+  FD_TEST( fd_alut_upsert( alut, &key, dummy, 1UL, 0UL, 0UL, 100UL )==FD_ALUT_SUCCESS );
+  FD_TEST( fd_alut_lookup( alut, &key, 99UL,                                    &addr_cnt ) && addr_cnt==1UL );
+  FD_TEST( fd_alut_lookup( alut, &key, 100UL+FD_ALUT_DEACTIVATION_COOLDOWN,     &addr_cnt ) && addr_cnt==1UL );
+  FD_TEST( !fd_alut_lookup( alut, &key, 100UL+FD_ALUT_DEACTIVATION_COOLDOWN+1UL, &addr_cnt ) );
+
+  for( ulong t=0UL; t<TABLE_MAX; t++ ) { key = addr_of( 1UL+t ); FD_TEST( fd_alut_remove( alut, &key )==1 ); }
+  FD_TEST( fd_alut_table_cnt( alut )==0UL );
+
+  test_fixture( alut, rng );
+  test_random ( alut, rng );
+
+  FD_TEST( fd_alut_leave( NULL )==NULL );
+  FD_TEST( fd_alut_leave( alut )==shalut );
+
+  FD_TEST( !fd_alut_delete( NULL         ) );
+  FD_TEST( !fd_alut_delete( alut_mem+1UL ) );
+  FD_TEST( fd_alut_delete( shalut )==alut_mem );
+  FD_TEST( !fd_alut_join  ( shalut ) );
+  FD_TEST( !fd_alut_delete( shalut ) );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -57,6 +57,20 @@ main( int     argc,
   for( ulong i = 0UL;          i <=  USHORT_MAX; i++ )    FD_TEST(  found[ i ] );
   for( ulong i = USHORT_MAX+1; i < TEST_U16_MAX; i++ )    FD_TEST( !found[ i ] );
 
+  /* The encoder produces exactly the reference encoding and round trips
+     through the decoder. */
+  for( ulong i = 0UL; i <= USHORT_MAX; i++ ) {
+    uchar buf[ TEST_U16_BUF_SZ ] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    ulong sz = fd_cu16_enc( (ushort)i, buf );
+    FD_TEST( sz==encoded_sz[ i ] );
+    FD_TEST( sz==fd_cu16_enc_sz( (ushort)i ) );
+    FD_TEST( !memcmp( buf, compact_u16[ i ], sz ) );
+    for( ulong j = sz; j < TEST_U16_BUF_SZ; j++ ) FD_TEST( buf[ j ]==0xFF );
+    ushort result = (ushort)0;
+    FD_TEST( fd_cu16_dec( buf, sz, &result )==sz );
+    FD_TEST( result==(ushort)i );
+  }
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
@@ -0,0 +1,374 @@
+#include "fd_txn_build.h"
+
+FD_IMPORT_BINARY( transaction1, "src/ballet/txn/fixtures/transaction1.bin" );
+FD_IMPORT_BINARY( transaction2, "src/ballet/txn/fixtures/transaction2.bin" );
+FD_IMPORT_BINARY( transaction3, "src/ballet/txn/fixtures/transaction3.bin" );
+
+#define BUF_SZ (1UL<<18)
+
+static uchar payload_mem[ BUF_SZ ];
+static uchar ref_payload[ BUF_SZ ];
+static uchar out_buf [ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+static uchar test_buf[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+
+/* Storage for the descriptions */
+
+#define INSTR_MAX (512UL)
+#define LUT_MAX   (255UL)
+
+static fd_txn_build_instr_t instr_mem[ INSTR_MAX ];
+static fd_txn_build_lut_t   lut_mem  [ LUT_MAX   ];
+static uchar                acct_addr_mem[ 300UL*FD_TXN_ACCT_ADDR_SZ ];
+static uchar                blockhash_mem[ FD_TXN_BLOCKHASH_SZ ];
+static uchar                idx_mem [ 1UL<<16 ];
+static uchar                data_mem[ 1UL<<17 ];
+
+/* desc_from_txn fills b with the description of the transaction txn
+   parsed from payload. */
+
+static void
+desc_from_txn( fd_txn_build_t * b,
+               fd_txn_t const * txn,
+               uchar const *    payload ) {
+  b->transaction_version   = txn->transaction_version;
+  b->signature_cnt         = txn->signature_cnt;
+  b->readonly_signed_cnt   = txn->readonly_signed_cnt;
+  b->readonly_unsigned_cnt = txn->readonly_unsigned_cnt;
+  b->acct_addr_cnt         = txn->acct_addr_cnt;
+  b->acct_addr             = payload + txn->acct_addr_off;
+  b->recent_blockhash      = payload + txn->recent_blockhash_off;
+  b->instr_cnt             = txn->instr_cnt;
+  b->instr                 = instr_mem;
+  b->addr_table_lookup_cnt = txn->addr_table_lookup_cnt;
+  b->addr_table_lookup     = lut_mem;
+  FD_TEST( txn->instr_cnt<=INSTR_MAX );
+  for( ulong j=0UL; j<txn->instr_cnt; j++ ) {
+    instr_mem[ j ].program_id = txn->instr[ j ].program_id;
+    instr_mem[ j ].acct_cnt   = txn->instr[ j ].acct_cnt;
+    instr_mem[ j ].data_sz    = txn->instr[ j ].data_sz;
+    instr_mem[ j ].acct       = payload + txn->instr[ j ].acct_off;
+    instr_mem[ j ].data       = payload + txn->instr[ j ].data_off;
+  }
+  fd_txn_acct_addr_lut_t const * lut = fd_txn_get_address_tables( (fd_txn_t *)txn );
+  for( ulong j=0UL; j<txn->addr_table_lookup_cnt; j++ ) {
+    lut_mem[ j ].addr         = payload + lut[ j ].addr_off;
+    lut_mem[ j ].writable_cnt = lut[ j ].writable_cnt;
+    lut_mem[ j ].readonly_cnt = lut[ j ].readonly_cnt;
+    lut_mem[ j ].writable     = payload + lut[ j ].writable_off;
+    lut_mem[ j ].readonly     = payload + lut[ j ].readonly_off;
+  }
+}
+
+/* test_fixture checks that rebuilding a parsed transaction reproduces
+   it exactly (other than the signatures) along with its fd_txn_t. */
+
+static void
+test_fixture( uchar const * payload,
+              ulong         payload_sz ) {
+  fd_txn_t const * ref = (fd_txn_t const *)test_buf;
+  ulong ref_footprint = fd_txn_parse( payload, payload_sz, test_buf, NULL );
+  FD_TEST( ref_footprint );
+
+  fd_txn_build_t b[1];
+  desc_from_txn( b, ref, payload );
+  FD_TEST( fd_txn_build_payload_sz( b )==payload_sz );
+
+  ulong sz = 0UL;
+  FD_TEST( !fd_txn_build( b, payload_mem, payload_sz-1UL, out_buf, &sz ) );
+  FD_TEST( !sz );
+  FD_TEST( fd_txn_build( b, payload_mem, payload_sz, out_buf, &sz )==ref_footprint );
+  FD_TEST( sz==payload_sz );
+  FD_TEST( !memcmp( out_buf, test_buf, ref_footprint ) );
+  FD_TEST( !memcmp( payload_mem+ref->message_off, payload+ref->message_off, payload_sz-ref->message_off ) );
+  for( ulong k=ref->signature_off; k<ref->message_off; k++ ) FD_TEST( !payload_mem[ k ] );
+}
+
+/* ref_serialize is a simple reference serializer that does no
+   validation.  Reserved byte ranges are skipped.  Returns the size. */
+
+static ulong
+ref_cu16( ulong   v,
+          uchar * buf ) {
+  ulong j = 0UL;
+  do {
+    buf[ j ] = (uchar)(v & 0x7FUL);
+    v >>= 7;
+    if( v ) buf[ j ] |= (uchar)0x80;
+    j++;
+  } while( v );
+  return j;
+}
+
+static ulong
+ref_serialize( fd_txn_build_t const * b,
+               uchar *                p ) {
+  ulong i = 0UL;
+  p[ i++ ] = b->signature_cnt;
+  memset( p+i, 0, FD_TXN_SIGNATURE_SZ*b->signature_cnt ); i += FD_TXN_SIGNATURE_SZ*b->signature_cnt;
+  if( b->transaction_version!=FD_TXN_VLEGACY ) p[ i++ ] = (uchar)(0x80 | b->transaction_version);
+  p[ i++ ] = b->signature_cnt;
+  p[ i++ ] = b->readonly_signed_cnt;
+  p[ i++ ] = b->readonly_unsigned_cnt;
+  i += ref_cu16( b->acct_addr_cnt, p+i );
+  if( b->acct_addr ) memcpy( p+i, b->acct_addr, FD_TXN_ACCT_ADDR_SZ*b->acct_addr_cnt );
+  i += FD_TXN_ACCT_ADDR_SZ*b->acct_addr_cnt;
+  if( b->recent_blockhash ) memcpy( p+i, b->recent_blockhash, FD_TXN_BLOCKHASH_SZ );
+  i += FD_TXN_BLOCKHASH_SZ;
+  i += ref_cu16( b->instr_cnt, p+i );
+  for( ulong j=0UL; j<b->instr_cnt; j++ ) {
+    p[ i++ ] = b->instr[ j ].program_id;
+    i += ref_cu16( b->instr[ j ].acct_cnt, p+i );
+    memcpy( p+i, b->instr[ j ].acct, b->instr[ j ].acct_cnt ); i += b->instr[ j ].acct_cnt;
+    i += ref_cu16( b->instr[ j ].data_sz, p+i );
+    if( b->instr[ j ].data ) memcpy( p+i, b->instr[ j ].data, b->instr[ j ].data_sz );
+    i += b->instr[ j ].data_sz;
+  }
+  /* Tables in a legacy transaction end up as trailing bytes */
+  if( (b->transaction_version!=FD_TXN_VLEGACY) | (b->addr_table_lookup_cnt>0) ) {
+    i += ref_cu16( b->addr_table_lookup_cnt, p+i );
+    for( ulong j=0UL; j<b->addr_table_lookup_cnt; j++ ) {
+      if( b->addr_table_lookup[ j ].addr ) memcpy( p+i, b->addr_table_lookup[ j ].addr, FD_TXN_ACCT_ADDR_SZ );
+      i += FD_TXN_ACCT_ADDR_SZ;
+      i += ref_cu16( b->addr_table_lookup[ j ].writable_cnt, p+i );
+      memcpy( p+i, b->addr_table_lookup[ j ].writable, b->addr_table_lookup[ j ].writable_cnt ); i += b->addr_table_lookup[ j ].writable_cnt;
+      i += ref_cu16( b->addr_table_lookup[ j ].readonly_cnt, p+i );
+      memcpy( p+i, b->addr_table_lookup[ j ].readonly, b->addr_table_lookup[ j ].readonly_cnt ); i += b->addr_table_lookup[ j ].readonly_cnt;
+    }
+  }
+  return i;
+}
+
+/* rand_cnt returns a random count biased towards small values that
+   occasionally exceeds the valid range [lo,hi]. */
+
+static ulong
+rand_cnt( fd_rng_t * rng,
+          ulong      lo,
+          ulong      hi ) {
+  if( FD_UNLIKELY( !fd_rng_uint_roll( rng, 64U ) ) ) return fd_rng_ulong_roll( rng, hi+2UL );
+  return lo + fd_rng_ulong_roll( rng, fd_ulong_min( hi-lo+1UL, 1UL+fd_rng_ulong_roll( rng, 16UL ) ) );
+}
+
+/* test_random checks fd_txn_build against ref_serialize and fd_txn_parse
+   on random, mostly valid, descriptions. */
+
+static void
+test_random( fd_rng_t * rng ) {
+  ulong ok_cnt = 0UL;
+  ulong iter_cnt = 100000UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_txn_build_t b[1];
+    uint r = fd_rng_uint_roll( rng, 64U );
+    b->transaction_version   = r ? (fd_rng_uint( rng ) & 1U ? FD_TXN_V0 : FD_TXN_VLEGACY) : (uchar)(fd_rng_uint_roll( rng, 4U ));
+    b->signature_cnt         = (uchar)rand_cnt( rng, 1UL, 12UL );
+    b->readonly_signed_cnt   = (uchar)rand_cnt( rng, 0UL, fd_ulong_max( b->signature_cnt, 1UL )-1UL );
+    b->acct_addr_cnt         = (ushort)rand_cnt( rng, b->signature_cnt, fd_rng_uint_roll( rng, 32U ) ? 40UL : 256UL );
+    b->readonly_unsigned_cnt = (uchar)rand_cnt( rng, 0UL, (ulong)b->acct_addr_cnt - fd_ulong_min( b->signature_cnt, b->acct_addr_cnt ) );
+    b->acct_addr             = fd_rng_uint_roll( rng, 8U ) ? acct_addr_mem : NULL;
+    b->recent_blockhash      = fd_rng_uint_roll( rng, 8U ) ? blockhash_mem : NULL;
+    b->instr_cnt             = (ushort)rand_cnt( rng, 0UL, 8UL );
+    b->instr                 = instr_mem;
+    b->addr_table_lookup_cnt = (b->transaction_version==FD_TXN_VLEGACY && fd_rng_uint_roll( rng, 64U )) ? (uchar)0 : (uchar)rand_cnt( rng, 0UL, 8UL );
+    b->addr_table_lookup     = lut_mem;
+
+    ulong idx_cnt = (ulong)b->acct_addr_cnt;
+    ulong idx_off = 0UL;
+    for( ulong j=0UL; j<b->addr_table_lookup_cnt; j++ ) {
+      ulong w = rand_cnt( rng, 0UL, 4UL );
+      ulong o = rand_cnt( rng, 0UL, 4UL );
+      lut_mem[ j ].addr         = fd_rng_uint_roll( rng, 8U ) ? acct_addr_mem + FD_TXN_ACCT_ADDR_SZ*j : NULL;
+      lut_mem[ j ].writable_cnt = (uchar)w;
+      lut_mem[ j ].readonly_cnt = (uchar)o;
+      lut_mem[ j ].writable     = idx_mem + idx_off; idx_off += w;
+      lut_mem[ j ].readonly     = idx_mem + idx_off; idx_off += o;
+      idx_cnt += w + o;
+    }
+    for( ulong j=0UL; j<b->instr_cnt; j++ ) {
+      ulong acct_cnt = fd_rng_uint_roll( rng, 32U ) ? fd_rng_ulong_roll( rng, 8UL ) : fd_rng_ulong_roll( rng, 300UL );
+      ulong data_sz  = fd_rng_uint_roll( rng, 32U ) ? fd_rng_ulong_roll( rng, 200UL ) : fd_rng_ulong_roll( rng, 20000UL );
+      instr_mem[ j ].program_id = (uchar)rand_cnt( rng, 1UL, fd_ulong_max( idx_cnt, 2UL )-1UL );
+      instr_mem[ j ].acct_cnt   = (ushort)acct_cnt;
+      instr_mem[ j ].data_sz    = (ushort)data_sz;
+      instr_mem[ j ].acct       = idx_mem + idx_off;
+      instr_mem[ j ].data       = fd_rng_uint_roll( rng, 8U ) ? data_mem + fd_rng_ulong_roll( rng, 1024UL ) : NULL;
+      for( ulong k=0UL; k<acct_cnt; k++ ) idx_mem[ idx_off+k ] = (uchar)rand_cnt( rng, 0UL, fd_ulong_max( idx_cnt, 1UL )-1UL );
+      idx_off += acct_cnt;
+    }
+
+    /* Both serializations start from the same garbage such that the
+       reserved byte ranges match. */
+
+    ulong ref_sz = ref_serialize( b, ref_payload );
+    FD_TEST( ref_sz<=BUF_SZ );
+    int ver_ok = (b->transaction_version==FD_TXN_V0) | ((b->transaction_version==FD_TXN_VLEGACY) & !b->addr_table_lookup_cnt);
+    if( ver_ok ) FD_TEST( fd_txn_build_payload_sz( b )==ref_sz );
+    ulong fill_sz = fd_ulong_min( ref_sz+64UL, BUF_SZ );
+    memset( ref_payload, 0xA5, fill_sz );
+    memset( payload_mem, 0xA5, fill_sz );
+    memset( out_buf,     0x5A, FD_TXN_MAX_SZ );
+    FD_TEST( ref_serialize( b, ref_payload )==ref_sz );
+
+    ulong ref_footprint = ref_sz<=USHORT_MAX ? fd_txn_parse( ref_payload, ref_sz, test_buf, NULL ) : 0UL;
+    ulong sz            = 0UL;
+    ulong footprint     = fd_txn_build( b, payload_mem, BUF_SZ, out_buf, &sz );
+
+    if( FD_UNLIKELY( footprint!=ref_footprint ) )
+      FD_LOG_ERR(( "iter %lu: footprint %lu ref_footprint %lu (ver %u sig %u ro_signed %u ro_unsigned %u acct %u instr %u lut %u)",
+                   iter, footprint, ref_footprint, (uint)b->transaction_version, (uint)b->signature_cnt, (uint)b->readonly_signed_cnt,
+                   (uint)b->readonly_unsigned_cnt, (uint)b->acct_addr_cnt, (uint)b->instr_cnt, (uint)b->addr_table_lookup_cnt ));
+    if( footprint ) {
+      FD_TEST( sz==ref_sz );
+      FD_TEST( !memcmp( payload_mem, ref_payload, fill_sz ) );
+      FD_TEST( !memcmp( out_buf, test_buf, footprint ) );
+
+      /* Exactly enough room works, one byte less does not */
+      FD_TEST( fd_txn_build( b, payload_mem, sz,     out_buf, &sz )==footprint );
+      FD_TEST( !fd_txn_build( b, payload_mem, sz-1UL, out_buf, &sz ) );
+      ok_cnt++;
+    } else {
+      /* Nothing written on failure */
+      FD_TEST( !sz );
+      for( ulong k=0UL; k<fill_sz;       k++ ) FD_TEST( payload_mem[ k ]==0xA5 );
+      for( ulong k=0UL; k<FD_TXN_MAX_SZ; k++ ) FD_TEST( out_buf    [ k ]==0x5A );
+    }
+  }
+  FD_LOG_NOTICE(( "built %lu of %lu random descriptions", ok_cnt, iter_cnt ));
+  FD_TEST( ok_cnt>iter_cnt/4UL );
+  FD_TEST( ok_cnt<iter_cnt    );
+}
+
+/* test_limits checks the cases fd_txn_parse would accept but that do
+   not fit in the caller's buffers. */
+
+static void
+test_limits( void ) {
+  fd_txn_build_t b[1] = {{
+    .transaction_version   = FD_TXN_VLEGACY,
+    .signature_cnt         = 1,
+    .acct_addr_cnt         = 2,
+    .acct_addr             = acct_addr_mem,
+    .recent_blockhash      = blockhash_mem,
+    .instr                 = instr_mem,
+  }};
+  for( ulong j=0UL; j<INSTR_MAX; j++ ) instr_mem[ j ] = (fd_txn_build_instr_t){ .program_id = 1 };
+
+  /* The largest fd_txn_t that fits in FD_TXN_MAX_SZ */
+  ulong instr_max = (FD_TXN_MAX_SZ - sizeof(fd_txn_t))/sizeof(fd_txn_instr_t);
+  ulong sz;
+  b->instr_cnt = (ushort)instr_max;
+  FD_TEST( fd_txn_build( b, payload_mem, BUF_SZ, out_buf, &sz )==fd_txn_footprint( instr_max, 0UL ) );
+  FD_TEST( fd_txn_parse( payload_mem, sz, test_buf, NULL )==fd_txn_footprint( instr_max, 0UL ) );
+  FD_TEST( !memcmp( out_buf, test_buf, fd_txn_footprint( instr_max, 0UL ) ) );
+  b->instr_cnt = (ushort)(instr_max+1UL);
+  FD_TEST( !fd_txn_build( b, payload_mem, BUF_SZ, out_buf, &sz ) );
+
+  /* Payloads larger than USHORT_MAX can't be described by a fd_txn_t */
+  b->instr_cnt          = 4;
+  instr_mem[ 0 ].data_sz = USHORT_MAX;
+  instr_mem[ 0 ].data    = NULL;
+  FD_TEST( fd_txn_build_payload_sz( b )>USHORT_MAX );
+  FD_TEST( !fd_txn_build( b, payload_mem, BUF_SZ, out_buf, &sz ) );
+  instr_mem[ 0 ].data_sz = (ushort)(USHORT_MAX - (fd_txn_build_payload_sz( b ) - USHORT_MAX));
+  FD_TEST( fd_txn_build_payload_sz( b )==USHORT_MAX );
+  FD_TEST( fd_txn_build( b, payload_mem, BUF_SZ, out_buf, &sz ) );
+  FD_TEST( sz==USHORT_MAX );
+  FD_TEST( fd_txn_parse( payload_mem, sz, test_buf, NULL ) );
+  instr_mem[ 0 ].data_sz = 0;
+}
+
+/* test_sign builds and signs a typical transfer like transaction with
+   two signers and checks the signatures verify. */
+
+static void
+test_sign( fd_rng_t *    rng,
+           fd_sha512_t * sha ) {
+  uchar private_key[ 2 ][ 32 ];
+  uchar acct_addr[ 3*FD_TXN_ACCT_ADDR_SZ ];
+  for( ulong s=0UL; s<2UL; s++ ) {
+    for( ulong k=0UL; k<32UL; k++ ) private_key[ s ][ k ] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( acct_addr + s*FD_TXN_ACCT_ADDR_SZ, private_key[ s ], sha );
+  }
+  memset( acct_addr + 2UL*FD_TXN_ACCT_ADDR_SZ, 0, FD_TXN_ACCT_ADDR_SZ ); /* system program */
+
+  uchar                acct[ 2 ] = { 0, 1 };
+  uchar                data[ 12 ] = { 2, 0, 0, 0, 0x40, 0x42, 0x0f, 0, 0, 0, 0, 0 }; /* transfer 1,000,000 lamports */
+  fd_txn_build_instr_t instr[ 1 ] = {{ .program_id = 2, .acct_cnt = 2, .data_sz = 12, .acct = acct, .data = data }};
+  fd_txn_build_t b[1] = {{
+    .transaction_version   = FD_TXN_V0,
+    .signature_cnt         = 2,
+    .readonly_signed_cnt   = 0,
+    .readonly_unsigned_cnt = 1,
+    .acct_addr_cnt         = 3,
+    .acct_addr             = acct_addr,
+    .recent_blockhash      = NULL,  /* filled in place below */
+    .instr_cnt             = 1,
+    .instr                 = instr,
+    .addr_table_lookup_cnt = 0
+  }};
+
+  ulong sz;
+  FD_TEST( fd_txn_build( b, payload_mem, FD_TXN_MTU, out_buf, &sz ) );
+  fd_txn_t const * txn = (fd_txn_t const *)out_buf;
+  memset( payload_mem + txn->recent_blockhash_off, 0x17, FD_TXN_BLOCKHASH_SZ );
+  for( ulong s=0UL; s<2UL; s++ ) fd_txn_build_sign( payload_mem, sz, txn, s, acct_addr + s*FD_TXN_ACCT_ADDR_SZ, private_key[ s ], sha );
+
+  FD_TEST( fd_txn_parse( payload_mem, sz, test_buf, NULL ) );
+  FD_TEST( !memcmp( out_buf, test_buf, fd_txn_footprint( 1UL, 0UL ) ) );
+  fd_ed25519_sig_t const * sig = fd_txn_get_signatures( txn, payload_mem );
+  for( ulong s=0UL; s<2UL; s++ )
+    FD_TEST( fd_ed25519_verify( payload_mem + txn->message_off, sz - txn->message_off, sig[ s ],
+                                acct_addr + s*FD_TXN_ACCT_ADDR_SZ, sha )==FD_ED25519_SUCCESS );
+
+  /* Changing the message invalidates the signatures */
+  payload_mem[ sz-1UL ]++;
+  FD_TEST( fd_ed25519_verify( payload_mem + txn->message_off, sz - txn->message_off, sig[ 0 ],
+                              acct_addr, sha )!=FD_ED25519_SUCCESS );
+}
+
+static void
+test_performance( uchar const * payload,
+                  ulong         payload_sz ) {
+  fd_txn_build_t b[1];
+  FD_TEST( fd_txn_parse( payload, payload_sz, test_buf, NULL ) );
+  desc_from_txn( b, (fd_txn_t const *)test_buf, payload );
+
+  const ulong test_count = 1000000UL;
+  ulong sz;
+  long start = fd_log_wallclock( );
+  for( ulong i = 0; i < test_count; i++ ) {
+    FD_TEST( fd_txn_build( b, payload_mem, FD_TXN_MTU, out_buf, &sz ) );
+  }
+  long end = fd_log_wallclock( );
+  FD_LOG_NOTICE(( "Average time per build (%lu B): %f ns", payload_sz, (double)(end-start)/(double)test_count ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+
+  for( ulong k=0UL; k<sizeof(acct_addr_mem); k++ ) acct_addr_mem[ k ] = fd_rng_uchar( rng );
+  for( ulong k=0UL; k<sizeof(blockhash_mem); k++ ) blockhash_mem[ k ] = fd_rng_uchar( rng );
+  for( ulong k=0UL; k<sizeof(data_mem);      k++ ) data_mem     [ k ] = fd_rng_uchar( rng );
+
+  test_fixture( transaction1, transaction1_sz );
+  test_fixture( transaction2, transaction2_sz );
+  test_fixture( transaction3, transaction3_sz );
+
+  test_random( rng );
+  test_limits( );
+  test_sign( rng, sha );
+
+  test_performance( transaction1, transaction1_sz );
+  test_performance( transaction2, transaction2_sz );
+
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -217,6 +217,82 @@ void test_performance( uchar const * payload,
   FD_LOG_NOTICE(( "Average time per parse: %f ns", (double)(end-start)/(double)test_count ));
 }
 
+/* test_batch checks fd_txn_parse_batch against fd_txn_parse on random
+   mutations and truncations of the given payloads.  Mutations are
+   biased towards small values such that a decent fraction of them still
+   parse.  Each payload sits at the end of its buffer to catch
+   vectorized reads past the end of the payload. */
+
+#define BATCH_MAX (16UL)
+
+static uchar batch_payload_mem[ BATCH_MAX ][ 1232UL ];
+static uchar batch_out_mem    [ BATCH_MAX ][ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+
+void test_batch( fd_rng_t *          rng,
+                 uchar const * const txn[],
+                 ulong const         txn_sz[],
+                 ulong               txn_cnt ) {
+  fd_txn_parse_counters_t counters       = {0};
+  fd_txn_parse_counters_t batch_counters = {0};
+
+  uchar const * payload   [ BATCH_MAX ];
+  ulong         payload_sz[ BATCH_MAX ];
+  void *        out       [ BATCH_MAX ];
+  ulong         out_sz    [ BATCH_MAX ];
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) out[ j ] = batch_out_mem[ j ];
+
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong batch_cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      ulong   t   = fd_rng_ulong_roll( rng, txn_cnt );
+      ulong   sz  = txn_sz[ t ];
+      if( !fd_rng_uint_roll( rng, 8U ) ) sz = fd_rng_ulong_roll( rng, sz+1UL ); /* truncate */
+      uchar * buf = batch_payload_mem[ j ] + 1232UL - sz;
+      fd_memcpy( buf, txn[ t ], sz );
+      ulong mut_cnt = fd_rng_ulong_roll( rng, 3UL );
+      for( ulong k=0UL; sz && k<mut_cnt; k++ ) buf[ fd_rng_ulong_roll( rng, sz ) ] = (uchar)fd_rng_ulong_roll( rng, 1UL<<fd_rng_ulong_roll( rng, 9UL ) );
+      payload   [ j ] = buf;
+      payload_sz[ j ] = sz;
+    }
+
+    ulong ok_cnt = fd_txn_parse_batch( payload, payload_sz, batch_cnt, out, out_sz, &batch_counters );
+    ulong ref_ok_cnt = 0UL;
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      ulong ref_sz = fd_txn_parse( payload[ j ], payload_sz[ j ], test_buf, &counters );
+      FD_TEST( out_sz[ j ]==ref_sz );
+      if( ref_sz ) FD_TEST( !memcmp( out[ j ], test_buf, ref_sz ) );
+      ref_ok_cnt += (ulong)!!ref_sz;
+    }
+    FD_TEST( ok_cnt==ref_ok_cnt );
+  }
+  FD_TEST( batch_counters.success_cnt==counters.success_cnt );
+  FD_TEST( batch_counters.failure_cnt==counters.failure_cnt );
+  FD_TEST( counters.success_cnt );
+  FD_TEST( counters.failure_cnt );
+
+  /* Batch parsing performance on a mix of the first two payloads
+     (typical transactions, unlike a maximum size one) */
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+    ulong t = j & 1UL;
+    payload   [ j ] = txn   [ t ];
+    payload_sz[ j ] = txn_sz[ t ];
+  }
+  const ulong test_count = 1000000UL/BATCH_MAX;
+  long start = fd_log_wallclock( );
+  for( ulong i = 0; i < test_count; i++ ) {
+    for( ulong j=0UL; j<BATCH_MAX; j++ ) FD_TEST( fd_txn_parse( payload[ j ], payload_sz[ j ], out[ j ], NULL ) );
+  }
+  long end = fd_log_wallclock( );
+  FD_LOG_NOTICE(( "Average time per parse (mix): %f ns", (double)(end-start)/(double)(test_count*BATCH_MAX) ));
+  start = fd_log_wallclock( );
+  for( ulong i = 0; i < test_count; i++ ) {
+    FD_TEST( fd_txn_parse_batch( payload, payload_sz, BATCH_MAX, out, out_sz, NULL )==BATCH_MAX );
+  }
+  end = fd_log_wallclock( );
+  FD_LOG_NOTICE(( "Average time per batch parse (mix): %f ns", (double)(end-start)/(double)(test_count*BATCH_MAX) ));
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -234,6 +310,11 @@ main( int     argc,
   test_mutate( transaction2, transaction2_sz );
 
   FD_TEST( FD_TXN_MAX_SZ == fd_txn_parse( transaction3, transaction3_sz, out_buf, NULL ) );
+
+  uchar const * txn   [3] = { transaction1,    transaction2,    transaction3    };
+  ulong         txn_sz[3] = { transaction1_sz, transaction2_sz, transaction3_sz };
+  test_batch( rng, txn, txn_sz, 3UL );
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
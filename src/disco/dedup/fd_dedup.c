@@ -98,6 +98,8 @@ fd_dedup_tile( fd_cnc_t *              cnc,
                fd_frag_meta_t const ** in_mcache,
                ulong **                in_fseq,
                fd_tcache_t *           tcache,
+               ulong                   shard_cnt,
+               ulong                   shard_idx,
                fd_frag_meta_t *        mcache,
                ulong                   out_cnt,
                ulong **                _out_fseq,
@@ -110,6 +112,8 @@ fd_dedup_tile( fd_cnc_t *              cnc,
   ulong * cnc_diag;           /* ==fd_cnc_app_laddr( cnc ), local address of the dedup tile cnc diagnostic region */
   ulong   cnc_diag_in_backp;  /* is the run loop currently backpressured by one or more of the outs, in [0,1] */
   ulong   cnc_diag_backp_cnt; /* Accumulates number of transitions of tile to backpressured between housekeeping events */
+  ulong   cnc_diag_shard_cnt; /* Accumulates number of frags for other shards between housekeeping events */
+  ulong   cnc_diag_shard_sz;  /* Accumulates size of frags for other shards between housekeeping events */
 
   /* in frag stream state */
   ulong              in_seq; /* current position in input poll sequence, in [0,in_cnt) */
@@ -145,9 +149,11 @@ fd_dedup_tile( fd_cnc_t *              cnc,
 
   do {
 
-    FD_LOG_INFO(( "Booting dedup (in-cnt %lu, out-cnt %lu)", in_cnt, out_cnt ));
+    FD_LOG_INFO(( "Booting dedup (in-cnt %lu, out-cnt %lu, shard %lu of %lu)", in_cnt, out_cnt, shard_idx, shard_cnt ));
     if( FD_UNLIKELY( in_cnt >FD_DEDUP_TILE_IN_MAX  ) ) { FD_LOG_WARNING(( "in_cnt too large"  )); return 1; }
     if( FD_UNLIKELY( out_cnt>FD_DEDUP_TILE_OUT_MAX ) ) { FD_LOG_WARNING(( "out_cnt too large" )); return 1; }
+    if( FD_UNLIKELY( !((1UL<=shard_cnt) & (shard_cnt<=FD_DEDUP_TILE_SHARD_MAX)) ) ) { FD_LOG_WARNING(( "bad shard_cnt" )); return 1; }
+    if( FD_UNLIKELY( shard_idx>=shard_cnt ) ) { FD_LOG_WARNING(( "bad shard_idx" )); return 1; }
 
     if( FD_UNLIKELY( !scratch ) ) {
       FD_LOG_WARNING(( "NULL scratch" ));
@@ -164,7 +170,7 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     /* cnc state init */
 
     if( FD_UNLIKELY( !cnc ) ) { FD_LOG_WARNING(( "NULL cnc" )); return 1; }
-    if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<16UL ) ) { FD_LOG_WARNING(( "cnc app sz must be at least 16" )); return 1; }
+    if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<32UL ) ) { FD_LOG_WARNING(( "cnc app sz must be at least 32" )); return 1; }
     if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) { FD_LOG_WARNING(( "already booted" )); return 1; }
 
     cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
@@ -173,6 +179,8 @@ fd_dedup_tile( fd_cnc_t *              cnc,
        cleared during first housekeeping if credits available */
     cnc_diag_in_backp  = 1UL;
     cnc_diag_backp_cnt = 0UL;
+    cnc_diag_shard_cnt = 0UL;
+    cnc_diag_shard_sz  = 0UL;
 
     /* in frag stream init */
 
@@ -384,10 +392,14 @@ fd_dedup_tile( fd_cnc_t *              cnc,
            of execution. */
         fd_cnc_heartbeat( cnc, now );
         FD_COMPILER_MFENCE();
-        cnc_diag[ FD_CNC_DIAG_IN_BACKP  ]  = cnc_diag_in_backp;
-        cnc_diag[ FD_CNC_DIAG_BACKP_CNT ] += cnc_diag_backp_cnt;
+        cnc_diag[ FD_DEDUP_CNC_DIAG_IN_BACKP       ]  = cnc_diag_in_backp;
+        cnc_diag[ FD_DEDUP_CNC_DIAG_BACKP_CNT      ] += cnc_diag_backp_cnt;
+        cnc_diag[ FD_DEDUP_CNC_DIAG_SHARD_FILT_CNT ] += cnc_diag_shard_cnt;
+        cnc_diag[ FD_DEDUP_CNC_DIAG_SHARD_FILT_SZ  ] += cnc_diag_shard_sz;
         FD_COMPILER_MFENCE();
         cnc_diag_backp_cnt = 0UL;
+        cnc_diag_shard_cnt = 0UL;
+        cnc_diag_shard_sz  = 0UL;
 
         /* Receive command-and-control signals */
         ulong s = fd_cnc_signal_query( cnc );
@@ -530,10 +542,15 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     }
 
     /* We have successfully loaded the metadata.  Decide whether it
-       is interesting downstream and publish or filter accordingly. */
+       is interesting downstream and publish or filter accordingly.
+       Frags for other shards (impossible if the producers are steering
+       frags to the shards correctly) are filtered without touching the
+       tcache. */
 
     int is_dup;
-    FD_TCACHE_INSERT( is_dup, tcache_sync, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, sig );
+    int is_other = (fd_dedup_tile_shard( sig, shard_cnt )!=shard_idx);
+    if( FD_LIKELY( !is_other ) ) FD_TCACHE_INSERT( is_dup, tcache_sync, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, sig );
+    else                         is_dup = 1;
     if( FD_UNLIKELY( is_dup ) ) { /* Optimize for forwarding path */
       now = fd_tickcount();
       /* If there are any frags from this in that are currently exposed
@@ -561,6 +578,12 @@ fd_dedup_tile( fd_cnc_t *              cnc,
     this_in->seq   = this_in_seq;
     this_in->mline = this_in->mcache + fd_mcache_line_idx( this_in_seq, this_in->depth );
 
+    if( FD_UNLIKELY( is_other ) ) {
+      cnc_diag_shard_cnt++;
+      cnc_diag_shard_sz += sz;
+      continue;
+    }
+
     ulong diag_idx = FD_FSEQ_DIAG_PUB_CNT + 2UL*(ulong)is_dup;
     this_in->accum[ diag_idx     ]++;
     this_in->accum[ diag_idx+1UL ] += (uint)sz;
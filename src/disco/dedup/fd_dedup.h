@@ -21,6 +21,22 @@
 
 #define FD_DEDUP_CNC_SIGNAL_ACK (4UL)
 
+/* FD_DEDUP_CNC_DIAG_* are FD_CNC_DIAG_* style diagnostics and thus the
+   same considerations apply.  Beyond the standard FD_CNC_DIAG_IN_BACKP
+   and FD_CNC_DIAG_BACKP_CNT:
+
+     SHARD_FILT_{CNT,SZ} is the number of frags (and their total size)
+     that a sharded dedup tile received for another shard and filtered
+     without deduping (see fd_dedup_tile_shard below).  These are not
+     counted as duplicates in the in fseq diagnostics.  Ideally never
+     (non-zero indicates a producer is not steering frags to the right
+     shard). */
+
+#define FD_DEDUP_CNC_DIAG_IN_BACKP       FD_CNC_DIAG_IN_BACKP  /* ==0 */
+#define FD_DEDUP_CNC_DIAG_BACKP_CNT      FD_CNC_DIAG_BACKP_CNT /* ==1 */
+#define FD_DEDUP_CNC_DIAG_SHARD_FILT_CNT (2UL)                 /* updated by the dedup, ideally never */
+#define FD_DEDUP_CNC_DIAG_SHARD_FILT_SZ  (3UL)                 /* " */
+
 /* FD_DEDUP_TILE_IN_MAX and FD_DEDUP_TILE_OUT_MAX are the maximum number
    of inputs and outputs respectively that a dedup tile can have.  These
    limits are more or less arbitrary from a functional correctness POV.
@@ -32,6 +48,12 @@
 #define FD_DEDUP_TILE_IN_MAX  FD_FRAG_META_ORIG_MAX
 #define FD_DEDUP_TILE_OUT_MAX FD_FRAG_META_ORIG_MAX
 
+/* FD_DEDUP_TILE_SHARD_MAX is the maximum number of dedup tiles that can
+   cooperatively dedup the same set of ins (see fd_dedup_tile_shard
+   below).  This is also more or less arbitrary. */
+
+#define FD_DEDUP_TILE_SHARD_MAX (64UL)
+
 /* FD_DEDUP_TILE_SCRATCH_{ALIGN,FOOTPRINT} specify the alignment and
    footprint needed for a dedup tile scratch region that can support
    in_cnt mcaches and out_cnt reliable outputs.  ALIGN is an integer
@@ -55,6 +77,22 @@
 
 FD_PROTOTYPES_BEGIN
 
+/* fd_dedup_tile_shard returns the shard in [0,shard_cnt) responsible
+   for deduping frags with signature sig when the dedup is sharded over
+   shard_cnt dedup tiles.  Producers use this to steer each frag to the
+   right shard.  shard_cnt is assumed in [1,FD_DEDUP_TILE_SHARD_MAX].
+   This uses the high 32 bits of sig while fd_tcache_map_start uses the
+   low bits such that each shard's tcache sees uniformly distributed map
+   starts.  Like the tcache, this assumes sigs of distinct frags are
+   well randomized (otherwise the load will not be balanced across the
+   shards). */
+
+FD_FN_CONST static inline ulong
+fd_dedup_tile_shard( ulong sig,
+                     ulong shard_cnt ) {
+  return ((sig>>32)*shard_cnt)>>32;
+}
+
 /* fd_dedup_tile deduplicates multiple fragment streams described by the
    in_mcaches into a single out_mcache that can be consumed by out_cnt
    reliable consumers and an arbitrary number of unreliable consumers.
@@ -94,6 +132,23 @@ FD_PROTOTYPES_BEGIN
    in many common use cases) as it will provides strong guarantees in
    adversarial cases.
 
+   The dedup can be sharded over multiple tiles to scale beyond what a
+   single tile can handle.  shard_cnt dedup tiles, indexed by shard_idx
+   in [0,shard_cnt), each have their own in_mcaches, tcache and output
+   mcache.  Producers steer every frag to the shard given by
+   fd_dedup_tile_shard( sig, shard_cnt ) (e.g. a producer has one
+   mcache per shard and publishes each frag only to the mcache of the
+   frag's shard) such that a shard only sees the frags it is
+   responsible for.  Since duplicates have the same sig, they always
+   land on the same shard and the union of the shard outputs is the
+   same as what a single unsharded dedup (with a tcache depth equal to
+   the sum of the shard tcache depths) would produce.  A shard filters
+   any frag it receives for another shard without touching its tcache
+   and counts it in the FD_DEDUP_CNC_DIAG_SHARD_FILT_{CNT,SZ} cnc
+   diagnostics (not as a duplicate).  The shard outputs can be merged
+   back into a single sequenced stream with a mux tile (fd_mux_tile).
+   For an unsharded dedup, shard_cnt is 1 and shard_idx is 0.
+
    The order of frags among a group of streams covered by a single
    in_mcache will be preserved.  Frags from different groups of streams
    can be arbitrarily interleaved (but this makes an extreme best effort
@@ -214,7 +269,9 @@ FD_PROTOTYPES_BEGIN
    as FD_DEDUP_TILE_SCRATCH_FOOTPRINT.
 
    A fd_dedup_tile will use the application regions of the fseqs and
-   cncs for accumulating standard diagnostics in the standard ways.
+   cncs for accumulating standard diagnostics in the standard ways (and
+   the FD_DEDUP_CNC_DIAG_SHARD_FILT_{CNT,SZ} diagnostics above, the cnc
+   app region should be at least 32 bytes).
    Except for FD_CNC_DIAG_IN_BACKP, none of the diagnostics are cleared
    at boot (as such that they can be accumulated over multiple runs).
    Clearing is up to monitoring scripts.  It is recommend that inputs
@@ -251,6 +308,8 @@ fd_dedup_tile( fd_cnc_t *              cnc,       /* Local join to the dedup's c
                fd_frag_meta_t const ** in_mcache, /* in_mcache[in_idx] is the local join to input in_idx's mcache */
                ulong **                in_fseq,   /* in_fseq  [in_idx] is the local join to input in_idx's fseq */
                fd_tcache_t *           tcache,    /* Local join to the dedup's unique signature cache */
+               ulong                   shard_cnt, /* Number of dedup shards, in [1,FD_DEDUP_TILE_SHARD_MAX] */
+               ulong                   shard_idx, /* Shard handled by this dedup, in [0,shard_cnt) */
                fd_frag_meta_t *        mcache,    /* Local join to the dedup's frag stream output mcache */
                ulong                   out_cnt,   /* Number of reliable consumers, reliable consumers are indexed [0,out_cnt) */
                ulong **                out_fseq,  /* out_fseq[out_idx] is the local join to reliable consumer out_idx's fseq */
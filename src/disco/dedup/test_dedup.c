@@ -289,7 +289,7 @@ dedup_tile_main( int     argc,
   fd_rng_t _rng[1];
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, cfg->dedup_seed, 0UL ) );
 
-  int err = fd_dedup_tile( cnc, cfg->tx_cnt, tx_mcache, tx_fseq, dedup_tcache, dedup_mcache, cfg->rx_cnt, rx_fseq,
+  int err = fd_dedup_tile( cnc, cfg->tx_cnt, tx_mcache, tx_fseq, dedup_tcache, 1UL, 0UL, dedup_mcache, cfg->rx_cnt, rx_fseq,
                            cfg->dedup_cr_max, cfg->dedup_lazy, rng, cfg->dedup_scratch_mem );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_dedup_tile failed (%i)", err ));
 
@@ -442,6 +442,241 @@ rx_tile_main( int     argc,
   return 0;
 }
 
+/* SHARD test *********************************************************/
+
+/* test_shard runs an end-to-end test of a dedup sharded over SHARD_CNT
+   tiles with no merge.  SHARD_TX_CNT producers steer a stream of frags
+   with duplicates to the shards (each producer has one mcache per
+   shard) and the shard outputs are checked directly.  The mcaches are
+   deep enough to hold all the frags so flow control is not needed. */
+
+#define SHARD_CNT      (2UL)
+#define SHARD_TX_CNT   (2UL)
+#define SHARD_UNIQ_CNT (4096UL)
+#define SHARD_MIS_CNT  (64UL)    /* Frags deliberately steered to the wrong shard */
+#define SHARD_DEPTH    (16384UL) /* Holds all frags published to any one mcache */
+
+struct shard_cfg {
+  fd_cnc_t *             cnc;
+  fd_frag_meta_t const * in_mcache[ SHARD_TX_CNT ];
+  ulong *                in_fseq  [ SHARD_TX_CNT ];
+  fd_tcache_t *          tcache;
+  fd_frag_meta_t *       mcache;
+  ulong                  shard_idx;
+  void *                 scratch;
+  uint                   seed;
+};
+
+typedef struct shard_cfg shard_cfg_t;
+
+static int
+shard_tile_main( int     argc,
+                 char ** argv ) {
+  (void)argc;
+  shard_cfg_t * cfg = (shard_cfg_t *)argv;
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, cfg->seed, 0UL ) );
+
+  int err = fd_dedup_tile( cfg->cnc, SHARD_TX_CNT, cfg->in_mcache, cfg->in_fseq, cfg->tcache, SHARD_CNT, cfg->shard_idx,
+                           cfg->mcache, 0UL, NULL, 0UL, 0L, rng, cfg->scratch );
+  if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_dedup_tile failed (%i)", err ));
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return 0;
+}
+
+static void
+test_shard( fd_wksp_t * wksp,
+            fd_rng_t *  rng ) {
+
+  FD_LOG_NOTICE(( "Testing sharded dedup (shard-cnt %lu, tx-cnt %lu)", SHARD_CNT, SHARD_TX_CNT ));
+
+  ulong cnc_footprint     = fd_cnc_footprint( 64UL );
+  ulong mcache_footprint  = fd_mcache_footprint( SHARD_DEPTH, 0UL );
+  ulong tcache_footprint  = fd_tcache_footprint( SHARD_UNIQ_CNT, 0UL );
+  ulong scratch_footprint = fd_dedup_tile_scratch_footprint( SHARD_TX_CNT, 0UL );
+
+  ulong link_cnt = SHARD_TX_CNT*SHARD_CNT; /* Link tx_idx->shard_idx is link tx_idx*SHARD_CNT+shard_idx */
+
+  uchar * cnc_mem     = (uchar *)fd_wksp_alloc_laddr( wksp, fd_cnc_align(),    cnc_footprint    *SHARD_CNT,              1UL );
+  uchar * tx_mem      = (uchar *)fd_wksp_alloc_laddr( wksp, fd_mcache_align(), mcache_footprint *link_cnt,               1UL );
+  uchar * fseq_mem    = (uchar *)fd_wksp_alloc_laddr( wksp, fd_fseq_align(),   fd_fseq_footprint()*link_cnt,             1UL );
+  uchar * tcache_mem  = (uchar *)fd_wksp_alloc_laddr( wksp, fd_tcache_align(), tcache_footprint *SHARD_CNT,              1UL );
+  uchar * mcache_mem  = (uchar *)fd_wksp_alloc_laddr( wksp, fd_mcache_align(), mcache_footprint *SHARD_CNT,              1UL );
+  uchar * scratch_mem = (uchar *)fd_wksp_alloc_laddr( wksp, fd_dedup_tile_scratch_align(), scratch_footprint*SHARD_CNT, 1UL );
+  FD_TEST( cnc_mem ); FD_TEST( tx_mem ); FD_TEST( fseq_mem ); FD_TEST( tcache_mem ); FD_TEST( mcache_mem ); FD_TEST( scratch_mem );
+
+  fd_frag_meta_t * tx_mcache[ SHARD_TX_CNT*SHARD_CNT ];
+  ulong *          tx_fseq  [ SHARD_TX_CNT*SHARD_CNT ];
+  ulong            tx_seq   [ SHARD_TX_CNT*SHARD_CNT ];
+  for( ulong link_idx=0UL; link_idx<link_cnt; link_idx++ ) {
+    ulong seq0 = fd_rng_ulong( rng );
+    tx_mcache[ link_idx ] = fd_mcache_join( fd_mcache_new( tx_mem + link_idx*mcache_footprint, SHARD_DEPTH, 0UL, seq0 ) );
+    tx_fseq  [ link_idx ] = fd_fseq_join  ( fd_fseq_new  ( fseq_mem + link_idx*fd_fseq_footprint(), seq0 ) );
+    tx_seq   [ link_idx ] = seq0;
+    FD_TEST( tx_mcache[ link_idx ] ); FD_TEST( tx_fseq[ link_idx ] );
+  }
+
+  shard_cfg_t cfg [ SHARD_CNT ];
+  ulong       seq0[ SHARD_CNT ];
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+    seq0[ shard_idx ] = fd_rng_ulong( rng );
+    shard_cfg_t * c = cfg + shard_idx;
+    c->cnc    = fd_cnc_join   ( fd_cnc_new   ( cnc_mem    + shard_idx*cnc_footprint,    64UL, 1UL, fd_tickcount() ) );
+    c->tcache = fd_tcache_join( fd_tcache_new( tcache_mem + shard_idx*tcache_footprint, SHARD_UNIQ_CNT, 0UL     ) );
+    c->mcache = fd_mcache_join( fd_mcache_new( mcache_mem + shard_idx*mcache_footprint, SHARD_DEPTH, 0UL, seq0[ shard_idx ] ) );
+    FD_TEST( c->cnc ); FD_TEST( c->tcache ); FD_TEST( c->mcache );
+    for( ulong tx_idx=0UL; tx_idx<SHARD_TX_CNT; tx_idx++ ) {
+      c->in_mcache[ tx_idx ] = tx_mcache[ tx_idx*SHARD_CNT+shard_idx ];
+      c->in_fseq  [ tx_idx ] = tx_fseq  [ tx_idx*SHARD_CNT+shard_idx ];
+    }
+    c->shard_idx = shard_idx;
+    c->scratch   = scratch_mem + shard_idx*scratch_footprint;
+    c->seed      = fd_rng_uint( rng );
+  }
+
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ )
+    FD_TEST( fd_tile_exec_new( 1UL+shard_idx, shard_tile_main, 0, (char **)fd_type_pun( cfg+shard_idx ) ) );
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ )
+    FD_TEST( fd_cnc_wait( cfg[ shard_idx ].cnc, FD_CNC_SIGNAL_BOOT, (long)5e9, NULL )==FD_CNC_SIGNAL_RUN );
+
+  /* Publish every unique sig once, interleaved with duplicates of sigs
+     already published, from random producers.  Each frag is steered to
+     the mcache of its shard.  Then steer a few duplicates to the wrong
+     shard. */
+
+  static ulong uniq[ SHARD_UNIQ_CNT ];
+  for( ulong uniq_idx=0UL; uniq_idx<SHARD_UNIQ_CNT; uniq_idx++ ) {
+    ulong sig; do sig = fd_rng_ulong( rng ); while( fd_tcache_tag_is_null( sig ) );
+    uniq[ uniq_idx ] = sig;
+  }
+
+  ulong uniq_cnt[ SHARD_CNT ]; ulong dup_cnt[ SHARD_CNT ]; ulong dup_sz[ SHARD_CNT ]; ulong mis_cnt[ SHARD_CNT ]; ulong mis_sz[ SHARD_CNT ];
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+    uniq_cnt[ shard_idx ] = 0UL; dup_cnt[ shard_idx ] = 0UL; dup_sz[ shard_idx ] = 0UL; mis_cnt[ shard_idx ] = 0UL; mis_sz[ shard_idx ] = 0UL;
+  }
+
+  ulong pub_cnt = 0UL; /* Number of unique sigs published so far (and then number of misrouted frags) */
+  while( pub_cnt<SHARD_UNIQ_CNT+SHARD_MIS_CNT ) {
+    int   is_mis = (pub_cnt>=SHARD_UNIQ_CNT);
+    int   is_dup = (!is_mis) & (!!pub_cnt) & (!!fd_rng_uint_roll( rng, 2U ));
+    ulong sig    = uniq[ (is_dup | is_mis) ? fd_rng_ulong_roll( rng, fd_ulong_min( pub_cnt, SHARD_UNIQ_CNT ) ) : pub_cnt ];
+    ulong sz     = 1UL + (sig & 1023UL);
+
+    ulong shard_idx = fd_dedup_tile_shard( sig, SHARD_CNT );
+    if(      is_mis ) { shard_idx = (shard_idx+1UL) % SHARD_CNT; mis_cnt[ shard_idx ]++; mis_sz[ shard_idx ] += sz; }
+    else if( is_dup ) {                                          dup_cnt[ shard_idx ]++; dup_sz[ shard_idx ] += sz; }
+    else              {                                          uniq_cnt[ shard_idx ]++;                            }
+
+    ulong link_idx = fd_rng_ulong_roll( rng, SHARD_TX_CNT )*SHARD_CNT + shard_idx;
+    ulong ctl      = fd_frag_meta_ctl( link_idx, 1, 1, 0 );
+    ulong tspub    = fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_mcache_publish( tx_mcache[ link_idx ], SHARD_DEPTH, tx_seq[ link_idx ], sig, 0UL, sz, ctl, 0UL, tspub );
+    tx_seq[ link_idx ] = fd_seq_inc( tx_seq[ link_idx ], 1UL );
+    pub_cnt += (ulong)!is_dup;
+  }
+
+  /* Wait for the shards to consume everything and report the misrouted
+     frags */
+
+  long deadline = fd_log_wallclock() + (long)10e9;
+  for(;;) {
+    int done = 1;
+    for( ulong link_idx=0UL; link_idx<link_cnt; link_idx++ ) done &= (fd_fseq_query( tx_fseq[ link_idx ] )==tx_seq[ link_idx ]);
+    for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+      ulong const * cnc_diag = (ulong const *)fd_cnc_app_laddr_const( cfg[ shard_idx ].cnc );
+      done &= (FD_VOLATILE_CONST( cnc_diag[ FD_DEDUP_CNC_DIAG_SHARD_FILT_CNT ] )==mis_cnt[ shard_idx ]);
+    }
+    if( done ) break;
+    FD_TEST( fd_log_wallclock()<deadline );
+    FD_YIELD();
+  }
+
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+    FD_TEST( !fd_cnc_open( cfg[ shard_idx ].cnc ) );
+    fd_cnc_signal( cfg[ shard_idx ].cnc, FD_CNC_SIGNAL_HALT );
+    fd_cnc_close( cfg[ shard_idx ].cnc );
+  }
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+    FD_TEST( fd_cnc_wait( cfg[ shard_idx ].cnc, FD_CNC_SIGNAL_HALT, (long)5e9, NULL )==FD_CNC_SIGNAL_BOOT );
+    int ret;
+    FD_TEST( !fd_tile_exec_delete( fd_tile_exec( 1UL+shard_idx ), &ret ) );
+    FD_TEST( !ret );
+  }
+
+  /* Each shard should have published exactly the unique sigs of its
+     shard (so the shard outputs don't overlap and their union is all
+     the unique sigs), counted only real duplicates as filtered in the
+     in diagnostics and counted the misrouted frags separately. */
+
+  static uchar seen[ SHARD_UNIQ_CNT ];
+  for( ulong uniq_idx=0UL; uniq_idx<SHARD_UNIQ_CNT; uniq_idx++ ) seen[ uniq_idx ] = (uchar)0;
+
+  ulong seen_cnt = 0UL;
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+    fd_frag_meta_t const * mcache = cfg[ shard_idx ].mcache;
+    ulong seq = seq0[ shard_idx ];
+    for( ulong out_idx=0UL; out_idx<uniq_cnt[ shard_idx ]; out_idx++ ) {
+      fd_frag_meta_t const * mline = mcache + fd_mcache_line_idx( seq, SHARD_DEPTH );
+      FD_TEST( mline->seq==seq );
+      ulong sig = mline->sig;
+      FD_TEST( fd_dedup_tile_shard( sig, SHARD_CNT )==shard_idx );
+      FD_TEST( (ulong)mline->sz==1UL+(sig & 1023UL) );
+      ulong uniq_idx = 0UL;
+      while( (uniq_idx<SHARD_UNIQ_CNT) && (uniq[ uniq_idx ]!=sig) ) uniq_idx++;
+      FD_TEST( uniq_idx<SHARD_UNIQ_CNT );
+      FD_TEST( !seen[ uniq_idx ] );
+      seen[ uniq_idx ] = (uchar)1;
+      seen_cnt++;
+      seq = fd_seq_inc( seq, 1UL );
+    }
+    FD_TEST( fd_seq_ne( mcache[ fd_mcache_line_idx( seq, SHARD_DEPTH ) ].seq, seq ) ); /* Nothing else published */
+
+    ulong pub_cnt_diag = 0UL; ulong filt_cnt_diag = 0UL; ulong filt_sz_diag = 0UL;
+    for( ulong tx_idx=0UL; tx_idx<SHARD_TX_CNT; tx_idx++ ) {
+      ulong const * fseq_diag = (ulong const *)fd_fseq_app_laddr_const( cfg[ shard_idx ].in_fseq[ tx_idx ] );
+      pub_cnt_diag  += fseq_diag[ FD_FSEQ_DIAG_PUB_CNT  ];
+      filt_cnt_diag += fseq_diag[ FD_FSEQ_DIAG_FILT_CNT ];
+      filt_sz_diag  += fseq_diag[ FD_FSEQ_DIAG_FILT_SZ  ];
+    }
+    FD_TEST( pub_cnt_diag ==uniq_cnt[ shard_idx ] );
+    FD_TEST( filt_cnt_diag==dup_cnt [ shard_idx ] );
+    FD_TEST( filt_sz_diag ==dup_sz  [ shard_idx ] );
+
+    ulong const * cnc_diag = (ulong const *)fd_cnc_app_laddr_const( cfg[ shard_idx ].cnc );
+    FD_TEST( cnc_diag[ FD_DEDUP_CNC_DIAG_SHARD_FILT_CNT ]==mis_cnt[ shard_idx ] );
+    FD_TEST( cnc_diag[ FD_DEDUP_CNC_DIAG_SHARD_FILT_SZ  ]==mis_sz [ shard_idx ] );
+
+    FD_LOG_NOTICE(( "shard %lu: %lu unique, %lu dup, %lu misrouted", shard_idx, uniq_cnt[ shard_idx ], dup_cnt[ shard_idx ],
+                    mis_cnt[ shard_idx ] ));
+  }
+  FD_TEST( seen_cnt==SHARD_UNIQ_CNT );
+
+  for( ulong shard_idx=0UL; shard_idx<SHARD_CNT; shard_idx++ ) {
+    FD_TEST( fd_mcache_delete( fd_mcache_leave( cfg[ shard_idx ].mcache ) ) );
+    FD_TEST( fd_tcache_delete( fd_tcache_leave( cfg[ shard_idx ].tcache ) ) );
+    FD_TEST( fd_cnc_delete   ( fd_cnc_leave   ( cfg[ shard_idx ].cnc    ) ) );
+  }
+  for( ulong link_idx=0UL; link_idx<link_cnt; link_idx++ ) {
+    FD_TEST( fd_fseq_delete  ( fd_fseq_leave  ( tx_fseq  [ link_idx ] ) ) );
+    FD_TEST( fd_mcache_delete( fd_mcache_leave( tx_mcache[ link_idx ] ) ) );
+  }
+
+  fd_wksp_free_laddr( scratch_mem );
+  fd_wksp_free_laddr( mcache_mem  );
+  fd_wksp_free_laddr( tcache_mem  );
+  fd_wksp_free_laddr( fseq_mem    );
+  fd_wksp_free_laddr( tx_mem      );
+  fd_wksp_free_laddr( cnc_mem     );
+}
+
+#undef SHARD_DEPTH
+#undef SHARD_MIS_CNT
+#undef SHARD_UNIQ_CNT
+#undef SHARD_TX_CNT
+#undef SHARD_CNT
+
 /* CNC tile ***********************************************************/
 
 int
@@ -461,6 +696,26 @@ main( int     argc,
     FD_TEST( fd_dedup_tile_scratch_footprint( in_cnt, out_cnt )==FD_DEDUP_TILE_SCRATCH_FOOTPRINT( in_cnt, out_cnt ) );
   }
 
+  /* Shard selection should be in range, only depend on the high sig
+     bits (the low bits pick the tcache map slot) and be roughly
+     uniform */
+
+  FD_TEST( fd_dedup_tile_shard( 0UL,       FD_DEDUP_TILE_SHARD_MAX )==0UL                         );
+  FD_TEST( fd_dedup_tile_shard( ULONG_MAX, FD_DEDUP_TILE_SHARD_MAX )==FD_DEDUP_TILE_SHARD_MAX-1UL );
+  for( ulong shard_cnt=1UL; shard_cnt<=FD_DEDUP_TILE_SHARD_MAX; shard_cnt++ ) {
+    ulong shard_hit[ FD_DEDUP_TILE_SHARD_MAX ];
+    for( ulong shard_idx=0UL; shard_idx<shard_cnt; shard_idx++ ) shard_hit[ shard_idx ] = 0UL;
+    ulong iter_cnt = 1024UL*shard_cnt;
+    for( ulong iter_rem=iter_cnt; iter_rem; iter_rem-- ) {
+      ulong sig       = fd_rng_ulong( rng );
+      ulong shard_idx = fd_dedup_tile_shard( sig, shard_cnt );
+      FD_TEST( shard_idx<shard_cnt );
+      FD_TEST( fd_dedup_tile_shard( sig ^ (ulong)fd_rng_uint( rng ), shard_cnt )==shard_idx );
+      shard_hit[ shard_idx ]++;
+    }
+    for( ulong shard_idx=0UL; shard_idx<shard_cnt; shard_idx++ ) FD_TEST( (768UL<shard_hit[ shard_idx ]) & (shard_hit[ shard_idx ]<1280UL) );
+  }
+
   ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
   if( cpu_idx>=fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
 
@@ -530,6 +785,8 @@ main( int     argc,
   fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
   FD_TEST( wksp );
 
+  test_shard( wksp, rng );
+
   FD_LOG_NOTICE(( "Creating cncs (--tx-cnt %lu, dedup-cnt 1, --rx-cnt %lu, app-sz 64)", tx_cnt, rx_cnt ));
   ulong   cnc_footprint = fd_cnc_footprint( 64UL ); /* Room for 8 64-bit diagnostic counters */
   uchar * cnc_mem       = (uchar *)fd_wksp_alloc_laddr( wksp, fd_cnc_align(), cnc_footprint*(tx_cnt+1UL+rx_cnt), 1UL );
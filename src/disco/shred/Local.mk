@@ -0,0 +1,4 @@
+$(call add-hdrs,fd_shred_ingest.h)
+$(call add-objs,fd_shred_ingest,fd_disco)
+$(call make-unit-test,test_shred_ingest,test_shred_ingest,fd_disco fd_ballet fd_tango fd_util)
+$(call make-bin,fd_shred_ingest_tile,fd_shred_ingest_tile,fd_disco fd_ballet fd_tango fd_util)
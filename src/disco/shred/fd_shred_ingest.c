@@ -0,0 +1,540 @@
+#include "fd_shred_ingest.h"
+
+#if FD_HAS_HOSTED && FD_HAS_X86
+
+#include "../../ballet/fd_ballet.h"
+
+/* A fd_shred_ingest_set remembers the signature and Merkle root of the
+   most recently verified FEC set whose (slot,fec_set_idx) maps to its
+   entry.  Since ed25519 verification is deterministic, a shred with the
+   same (slot,fec_set_idx,signature,root) needs no verification.  It
+   fits on exactly two cache lines. */
+
+struct __attribute__((aligned(128))) fd_shred_ingest_set {
+  ulong slot;
+  uint  fec_set_idx;
+  uint  used;        /* 0 if this entry has never been filled */
+  uchar root     [ FD_SHRED_MERKLE_NODE_SZ ];
+  uchar signature[ FD_ED25519_SIG_SZ       ];
+};
+
+typedef struct fd_shred_ingest_set fd_shred_ingest_set_t;
+
+FD_STATIC_ASSERT( sizeof(fd_shred_ingest_set_t)==128UL, layout );
+FD_STATIC_ASSERT( FD_BMTREE20_HASH_SZ==FD_SHRED_MERKLE_NODE_SZ, layout );
+
+/* fd_shred_ingest_set_idx returns the set entry for the FEC set
+   (slot,fec_set_idx).  (fec_set_idx is typically a multiple of the data
+   shred count of the previous sets so we hash it too.) */
+
+FD_FN_CONST static inline ulong
+fd_shred_ingest_set_idx( ulong slot,
+                         uint  fec_set_idx ) {
+  return fd_ulong_hash( fd_ulong_hash( slot ) ^ (ulong)fec_set_idx ) & (FD_SHRED_INGEST_TILE_SET_MAX-1UL);
+}
+
+/* fd_shred_ingest_tag returns the tcache tag of the shred
+   (slot,idx,type).  Never FD_TCACHE_TAG_NULL. */
+
+FD_FN_CONST static inline ulong
+fd_shred_ingest_tag( ulong slot,
+                     uint  idx,
+                     int   is_code ) {
+  ulong tag = fd_ulong_hash( fd_ulong_hash( slot ) ^ (((ulong)idx<<1) | (ulong)is_code) );
+  return fd_ulong_if( fd_tcache_tag_is_null( tag ), 1UL, tag );
+}
+
+/* fd_shred_ingest_leaf_idx returns the index of the Merkle tree leaf of
+   the FD_SHRED_SZ shred at buf within its FEC set or ULONG_MAX if buf
+   is not a Merkle shred or its indices are inconsistent.  (Whether the
+   index fits the depth of the tree is checked with the proof.) */
+
+static inline ulong
+fd_shred_ingest_leaf_idx( uchar const * buf ) {
+  fd_shred_t const * shred = fd_shred_parse( buf );
+  if( FD_UNLIKELY( !shred ) ) return ULONG_MAX;
+  uchar type = fd_shred_type( shred->variant );
+  if( FD_LIKELY( type==FD_SHRED_TYPE_MERKLE_DATA ) ) {
+    if( FD_UNLIKELY( shred->idx<shred->fec_set_idx ) ) return ULONG_MAX;
+    return (ulong)(shred->idx - shred->fec_set_idx);
+  }
+  if( FD_LIKELY( type==FD_SHRED_TYPE_MERKLE_CODE ) ) {
+    if( FD_UNLIKELY( (!shred->code.data_cnt) | (shred->code.idx>=shred->code.code_cnt) ) ) return ULONG_MAX;
+    return (ulong)shred->code.data_cnt + (ulong)shred->code.idx;
+  }
+  return ULONG_MAX; /* Legacy shred */
+}
+
+#define SCRATCH_ALLOC( a, s ) (__extension__({                    \
+    ulong _scratch_alloc = fd_ulong_align_up( scratch_top, (a) ); \
+    scratch_top = _scratch_alloc + (s);                           \
+    (void *)_scratch_alloc;                                       \
+  }))
+
+FD_STATIC_ASSERT( FD_FCTL_ALIGN                 <=FD_SHRED_INGEST_TILE_SCRATCH_ALIGN, packing );
+FD_STATIC_ASSERT( FD_SHA512_ALIGN               <=FD_SHRED_INGEST_TILE_SCRATCH_ALIGN, packing );
+FD_STATIC_ASSERT( alignof(fd_shred_ingest_set_t)<=FD_SHRED_INGEST_TILE_SCRATCH_ALIGN, packing );
+FD_STATIC_ASSERT( !(FD_SHRED_INGEST_TILE_SET_MAX & (FD_SHRED_INGEST_TILE_SET_MAX-1UL)), config );
+
+ulong
+fd_shred_ingest_tile_scratch_align( void ) {
+  return FD_SHRED_INGEST_TILE_SCRATCH_ALIGN;
+}
+
+ulong
+fd_shred_ingest_tile_scratch_footprint( ulong out_cnt ) {
+  if( FD_UNLIKELY( out_cnt>FD_SHRED_INGEST_TILE_OUT_MAX ) ) return 0UL;
+  ulong scratch_top = 0UL;
+  SCRATCH_ALLOC( fd_fctl_align(),                fd_fctl_footprint( out_cnt )                                ); /* fctl */
+  SCRATCH_ALLOC( fd_sha512_align(),              fd_sha512_footprint()                                       ); /* sha */
+  SCRATCH_ALLOC( alignof(fd_shred_ingest_set_t), FD_SHRED_INGEST_TILE_SET_MAX*sizeof(fd_shred_ingest_set_t) ); /* set */
+  return fd_ulong_align_up( scratch_top, fd_shred_ingest_tile_scratch_align() );
+}
+
+int
+fd_shred_ingest_tile( fd_cnc_t *             cnc,
+                      ulong                  orig,
+                      fd_frag_meta_t const * in_mcache,
+                      ulong *                in_fseq,
+                      ulong                  hdr_sz,
+                      uchar const *          leader,
+                      fd_tcache_t *          tcache,
+                      fd_frag_meta_t *       mcache,
+                      uchar *                dcache,
+                      ulong                  out_cnt,
+                      ulong **               out_fseq,
+                      ulong                  cr_max,
+                      long                   lazy,
+                      fd_rng_t *             rng,
+                      void *                 scratch ) {
+
+  /* cnc state */
+  ulong * cnc_diag;                /* ==fd_cnc_app_laddr( cnc ), local address of the shred ingest tile cnc diagnostic region */
+  ulong   cnc_diag_in_backp;       /* is the run loop currently backpressured by one or more of the outs, in [0,1] */
+  ulong   cnc_diag_backp_cnt;      /* Accumulates number of transitions of tile to backpressured between housekeeping events */
+  ulong   cnc_diag_parse_filt_cnt; /* Accumulates number of malformed / unsupported frags dropped between housekeeping events */
+  ulong   cnc_diag_dup_filt_cnt;   /* Accumulates number of duplicate shreds dropped between housekeeping events */
+  ulong   cnc_diag_proof_filt_cnt; /* Accumulates number of shreds with a bad inclusion proof between housekeeping events */
+  ulong   cnc_diag_sig_filt_cnt;   /* Accumulates number of shreds with a bad signature between housekeeping events */
+  ulong   cnc_diag_sig_cnt;        /* Accumulates number of signature verifications between housekeeping events */
+  ulong   cnc_diag_sig_hit_cnt;    /* Accumulates number of shreds matching a verified set between housekeeping events */
+
+  /* in frag stream state */
+  ulong                  in_depth; /* ==fd_mcache_depth( in_mcache ), depth of the in mcache / positive integer power of 2 */
+  ulong                  in_seq;   /* sequence number of next frag expected from the upstream producer */
+  fd_frag_meta_t const * in_mline; /* ==in_mcache + fd_mcache_line_idx( in_seq, in_depth ), location to poll next */
+  fd_wksp_t *            in_wksp;  /* ==fd_wksp_containing( in_mcache ), in chunk reference address in the local address space */
+  ulong                  in_accum[6]; /* local in_fseq diagnostic accumulators, drained during housekeeping */
+                                      /* Assumes FD_FSEQ_DIAG_{PUB_CNT,PUB_SZ,FILT_CNT,FILT_SZ,OVRNP_CNT,OVRNR_CONT} are 0:5 */
+
+  /* shred authentication state */
+  uchar                   pubkey[ 32 ]; /* leader's public key */
+  fd_sha512_t *           sha;          /* sha512 calculator for verifying signatures */
+  fd_shred_ingest_set_t * set;          /* set[ fd_shred_ingest_set_idx( slot, fec_set_idx ) ] is the most recently
+                                           verified FEC set with that index, indexed [0,FD_SHRED_INGEST_TILE_SET_MAX) */
+
+  /* tcache filter state */
+  ulong   tcache_depth;   /* ==fd_tcache_depth       ( tcache ), maximum unique tags held by the tcache */
+  ulong   tcache_map_cnt; /* ==fd_tcache_map_cnt     ( tcache ), number of map slots, integer power of 2 >= depth+2 */
+  ulong * _tcache_sync;   /* ==fd_tcache_oldest_laddr( tcache ), location where tcache sync info is updated */
+  ulong * _tcache_ring;   /* ==fd_tcache_ring_laddr  ( tcache ), ring of unique tags, indexed [0,depth) */
+  ulong * _tcache_map;    /* ==fd_tcache_map_laddr   ( tcache ), map slots, indexed [0,map_cnt) */
+  ulong   tcache_sync;    /* location of the oldest tag in ring, in [0,depth) */
+
+  /* out frag stream state */
+  ulong   depth;  /* ==fd_mcache_depth( mcache ), depth of the mcache / positive integer power of 2 */
+  ulong * sync;   /* ==fd_mcache_seq_laddr( mcache ), local addr where shred ingest mcache sync info is published */
+  ulong   seq;    /* next shred ingest frag sequence number to publish */
+
+  void *  base;   /* ==fd_wksp_containing( dcache ), chunk reference address in the tile's local address space */
+  ulong   chunk0; /* ==fd_dcache_compact_chunk0( base, dcache ) */
+  ulong   wmark;  /* ==fd_dcache_compact_wmark ( base, dcache, FD_SHRED_SZ ), shred chunks start in [chunk0,wmark] */
+  ulong   chunk;  /* Chunk where next shred will be written, in [chunk0,wmark] */
+
+  /* flow control state */
+  fd_fctl_t * fctl;     /* output flow control */
+  ulong       cr_avail; /* number of flow control credits available to publish downstream, in [0,cr_max] */
+
+  /* housekeeping state */
+  ulong async_min; /* minimum number of ticks between processing a housekeeping event, positive integer power of 2 */
+
+  do {
+
+    FD_LOG_INFO(( "Booting shred ingest (out-cnt %lu)", out_cnt ));
+    if( FD_UNLIKELY( out_cnt>FD_SHRED_INGEST_TILE_OUT_MAX ) ) { FD_LOG_WARNING(( "out_cnt too large" )); return 1; }
+
+    if( FD_UNLIKELY( !scratch ) ) {
+      FD_LOG_WARNING(( "NULL scratch" ));
+      return 1;
+    }
+
+    if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)scratch, fd_shred_ingest_tile_scratch_align() ) ) ) {
+      FD_LOG_WARNING(( "misaligned scratch" ));
+      return 1;
+    }
+
+    ulong scratch_top = (ulong)scratch;
+
+    /* cnc state init */
+
+    if( FD_UNLIKELY( !cnc ) ) { FD_LOG_WARNING(( "NULL cnc" )); return 1; }
+    if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<64UL ) ) { FD_LOG_WARNING(( "cnc app sz must be at least 64" )); return 1; }
+    if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) { FD_LOG_WARNING(( "already booted" )); return 1; }
+
+    cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
+
+    /* in_backp==1, backp_cnt==0 indicates waiting for initial credits,
+       cleared during first housekeeping if credits available */
+    cnc_diag_in_backp       = 1UL;
+    cnc_diag_backp_cnt      = 0UL;
+    cnc_diag_parse_filt_cnt = 0UL;
+    cnc_diag_dup_filt_cnt   = 0UL;
+    cnc_diag_proof_filt_cnt = 0UL;
+    cnc_diag_sig_filt_cnt   = 0UL;
+    cnc_diag_sig_cnt        = 0UL;
+    cnc_diag_sig_hit_cnt    = 0UL;
+
+    /* in frag stream init */
+
+    if( FD_UNLIKELY( !in_mcache ) ) { FD_LOG_WARNING(( "NULL in_mcache" )); return 1; }
+    if( FD_UNLIKELY( !in_fseq   ) ) { FD_LOG_WARNING(( "NULL in_fseq"   )); return 1; }
+
+    in_depth = fd_mcache_depth( in_mcache );
+    in_seq   = fd_mcache_seq_query( fd_mcache_seq_laddr_const( in_mcache ) ); /* FIXME: ALLOW OPTION FOR MANUAL SPECIFICATION? */
+    in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+
+    in_wksp = fd_wksp_containing( in_mcache );
+    if( FD_UNLIKELY( !in_wksp ) ) { FD_LOG_WARNING(( "fd_wksp_containing failed" )); return 1; }
+
+    for( ulong diag_idx=0UL; diag_idx<6UL; diag_idx++ ) in_accum[ diag_idx ] = 0UL;
+
+    /* shred authentication init */
+
+    if( FD_UNLIKELY( hdr_sz>(ulong)USHORT_MAX-FD_SHRED_SZ ) ) { FD_LOG_WARNING(( "hdr_sz too large" )); return 1; }
+    if( FD_UNLIKELY( !leader ) ) { FD_LOG_WARNING(( "NULL leader" )); return 1; }
+    fd_memcpy( pubkey, leader, 32UL );
+
+    sha = fd_sha512_join( fd_sha512_new( SCRATCH_ALLOC( fd_sha512_align(), fd_sha512_footprint() ) ) );
+    if( FD_UNLIKELY( !sha ) ) { FD_LOG_WARNING(( "fd_sha512_join failed" )); return 1; }
+
+    set = (fd_shred_ingest_set_t *)
+      SCRATCH_ALLOC( alignof(fd_shred_ingest_set_t), FD_SHRED_INGEST_TILE_SET_MAX*sizeof(fd_shred_ingest_set_t) );
+    fd_memset( set, 0, FD_SHRED_INGEST_TILE_SET_MAX*sizeof(fd_shred_ingest_set_t) );
+
+    /* tcache filter init */
+
+    if( FD_UNLIKELY( !tcache ) ) { FD_LOG_WARNING(( "NULL tcache" )); return 1; }
+
+    tcache_depth   = fd_tcache_depth       ( tcache );
+    tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
+    _tcache_sync   = fd_tcache_oldest_laddr( tcache );
+    _tcache_ring   = fd_tcache_ring_laddr  ( tcache );
+    _tcache_map    = fd_tcache_map_laddr   ( tcache );
+
+    FD_COMPILER_MFENCE();
+    tcache_sync = FD_VOLATILE_CONST( *_tcache_sync );
+    FD_COMPILER_MFENCE();
+
+    /* out frag stream init */
+
+    if( FD_UNLIKELY( !mcache ) ) { FD_LOG_WARNING(( "NULL mcache" )); return 1; }
+    depth = fd_mcache_depth    ( mcache );
+    sync  = fd_mcache_seq_laddr( mcache );
+
+    seq = fd_mcache_seq_query( sync ); /* FIXME: ALLOW OPTION FOR MANUAL SPECIFICATION */
+
+    if( FD_UNLIKELY( !dcache ) ) { FD_LOG_WARNING(( "NULL dcache" )); return 1; }
+
+    base = fd_wksp_containing( dcache );
+    if( FD_UNLIKELY( !base ) ) { FD_LOG_WARNING(( "fd_wksp_containing failed" )); return 1; }
+
+    if( FD_UNLIKELY( !fd_dcache_compact_is_safe( base, dcache, FD_SHRED_SZ, depth ) ) ) {
+      FD_LOG_WARNING(( "dcache not compatible with wksp base, FD_SHRED_SZ and mcache depth" ));
+      return 1;
+    }
+
+    chunk0 = fd_dcache_compact_chunk0( base, dcache );
+    wmark  = fd_dcache_compact_wmark ( base, dcache, FD_SHRED_SZ );
+    chunk  = chunk0;
+
+    /* out flow control init */
+
+    if( FD_UNLIKELY( !!out_cnt && !out_fseq ) ) { FD_LOG_WARNING(( "NULL out_fseq" )); return 1; }
+
+    fctl = fd_fctl_join( fd_fctl_new( SCRATCH_ALLOC( fd_fctl_align(), fd_fctl_footprint( out_cnt ) ), out_cnt ) );
+    if( FD_UNLIKELY( !fctl ) ) { FD_LOG_WARNING(( "join failed" )); return 1; }
+
+    for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) {
+
+      ulong * fseq = out_fseq[ out_idx ];
+      if( FD_UNLIKELY( !fseq ) ) { FD_LOG_WARNING(( "NULL out_fseq[%lu]", out_idx )); return 1; }
+      ulong * fseq_diag = (ulong *)fd_fseq_app_laddr( fseq );
+
+      /* Assumes lag_max==depth */
+      if( FD_UNLIKELY( !fd_fctl_cfg_rx_add( fctl, depth, fseq, &fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ) ) ) {
+        FD_LOG_WARNING(( "fd_fctl_cfg_rx_add failed" ));
+        return 1;
+      }
+    }
+
+    /* cr_burst is 1 because we only send at most 1 fragment metadata
+       between checking cr_avail.  We use defaults for cr_resume and
+       cr_refill (and possible cr_max if the user wanted to use defaults
+       here too). */
+
+    if( FD_UNLIKELY( !fd_fctl_cfg_done( fctl, 1UL, cr_max, 0UL, 0UL ) ) ) {
+      FD_LOG_WARNING(( "fd_fctl_cfg_done failed" ));
+      return 1;
+    }
+    FD_LOG_INFO(( "cr_burst %lu cr_max %lu cr_resume %lu cr_refill %lu",
+                  fd_fctl_cr_burst( fctl ), fd_fctl_cr_max( fctl ), fd_fctl_cr_resume( fctl ), fd_fctl_cr_refill( fctl ) ));
+
+    cr_max   = fd_fctl_cr_max( fctl );
+    cr_avail = 0UL; /* Will be initialized by run loop */
+
+    /* housekeeping init */
+
+    if( lazy<=0L ) lazy = fd_tempo_lazy_default( cr_max );
+    FD_LOG_INFO(( "Configuring housekeeping (lazy %li ns)", lazy ));
+
+    async_min = fd_tempo_async_min( lazy, 1UL /*event_cnt*/, (float)fd_tempo_tick_per_ns( NULL ) );
+    if( FD_UNLIKELY( !async_min ) ) { FD_LOG_WARNING(( "bad lazy" )); return 1; }
+
+  } while(0);
+
+  FD_LOG_INFO(( "Running shred ingest (orig %lu)", orig ));
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
+  long then = fd_tickcount();
+  long now  = then;
+  for(;;) {
+
+    /* Do housekeeping at a low rate in the background */
+    if( FD_UNLIKELY( (now-then)>=0L ) ) {
+
+      /* Send synchronization info */
+      fd_mcache_seq_update( sync, seq );
+      FD_COMPILER_MFENCE();
+      FD_VOLATILE( *_tcache_sync ) = tcache_sync;
+      FD_COMPILER_MFENCE();
+
+      /* Send diagnostic info */
+      /* When we drain, we don't do a fully atomic update of the
+         diagnostics as it is only diagnostic and it will still be
+         correct the usual case where individual diagnostic counters
+         aren't used by multiple writers spread over different threads
+         of execution. */
+      fd_cnc_heartbeat( cnc, now );
+      FD_COMPILER_MFENCE();
+      cnc_diag[ FD_CNC_DIAG_IN_BACKP                   ]  = cnc_diag_in_backp;
+      cnc_diag[ FD_CNC_DIAG_BACKP_CNT                  ] += cnc_diag_backp_cnt;
+      cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_PARSE_FILT_CNT ] += cnc_diag_parse_filt_cnt;
+      cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_DUP_FILT_CNT   ] += cnc_diag_dup_filt_cnt;
+      cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_PROOF_FILT_CNT ] += cnc_diag_proof_filt_cnt;
+      cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_FILT_CNT   ] += cnc_diag_sig_filt_cnt;
+      cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_CNT        ] += cnc_diag_sig_cnt;
+      cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_HIT_CNT    ] += cnc_diag_sig_hit_cnt;
+      FD_COMPILER_MFENCE();
+      cnc_diag_backp_cnt      = 0UL;
+      cnc_diag_parse_filt_cnt = 0UL;
+      cnc_diag_dup_filt_cnt   = 0UL;
+      cnc_diag_proof_filt_cnt = 0UL;
+      cnc_diag_sig_filt_cnt   = 0UL;
+      cnc_diag_sig_cnt        = 0UL;
+      cnc_diag_sig_hit_cnt    = 0UL;
+
+      /* Send flow control credits and drain flow control diagnostics to
+         the in.  We copy every frag before processing it so nothing
+         from the in is exposed downstream. */
+      fd_fctl_rx_cr_return( in_fseq, in_seq );
+      ulong * in_diag = (ulong *)fd_fseq_app_laddr( in_fseq );
+      FD_COMPILER_MFENCE();
+      for( ulong diag_idx=0UL; diag_idx<6UL; diag_idx++ ) in_diag[ diag_idx ] += in_accum[ diag_idx ];
+      FD_COMPILER_MFENCE();
+      for( ulong diag_idx=0UL; diag_idx<6UL; diag_idx++ ) in_accum[ diag_idx ] = 0UL;
+
+      /* Receive command-and-control signals */
+      ulong s = fd_cnc_signal_query( cnc );
+      if( FD_UNLIKELY( s!=FD_CNC_SIGNAL_RUN ) ) {
+        if( FD_LIKELY( s==FD_CNC_SIGNAL_HALT ) ) break;
+        if( FD_UNLIKELY( s!=FD_SHRED_INGEST_CNC_SIGNAL_ACK ) ) {
+          char buf[ FD_CNC_SIGNAL_CSTR_BUF_MAX ];
+          FD_LOG_WARNING(( "Unexpected signal %s (%lu) received; trying to resume", fd_cnc_signal_cstr( s, buf ), s ));
+        }
+        fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
+      }
+
+      /* Receive flow control credits */
+      cr_avail = fd_fctl_tx_cr_update( fctl, cr_avail, seq );
+
+      /* Reload housekeeping timer */
+      then = now + (long)fd_tempo_async_reload( rng, async_min );
+    }
+
+    /* Check if we are backpressured.  If so, count any transition into
+       a backpressured regime and spin to wait for flow control credits
+       to return.  We don't do a fully atomic update here as it is only
+       diagnostic and it will still be correct the usual case where
+       individual diagnostic counters aren't used by writers in
+       different threads of execution.  We only count the transition
+       from not backpressured to backpressured. */
+
+    if( FD_UNLIKELY( !cr_avail ) ) {
+      cnc_diag_backp_cnt += (ulong)!cnc_diag_in_backp;
+      cnc_diag_in_backp   = 1UL;
+      FD_SPIN_PAUSE();
+      now = fd_tickcount();
+      continue;
+    }
+    cnc_diag_in_backp = 0UL;
+
+    /* Check if the in has any new shreds */
+
+    FD_COMPILER_MFENCE();
+    ulong seq_found = in_mline->seq;
+    FD_COMPILER_MFENCE();
+
+    long diff = fd_seq_diff( in_seq, seq_found );
+    if( FD_UNLIKELY( diff ) ) { /* Caught up or overrun, optimize for new frag case */
+      if( FD_UNLIKELY( diff<0L ) ) { /* Overrun (impossible if in is honoring our flow control) */
+        in_seq   = seq_found; /* Resume from here (probably reasonably current, could query in mcache sync directly instead) */
+        in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+        in_accum[ FD_FSEQ_DIAG_OVRNP_CNT ]++;
+      }
+      FD_SPIN_PAUSE();
+      now = fd_tickcount();
+      continue;
+    }
+
+    /* We have a new frag.  Copy the shred it holds (if it has the
+       right size) to where we would publish it and then check we
+       weren't overrun while copying.  This attempt should always be
+       successful if the in is honoring our flow control.  All further
+       processing is done on our copy such that the shred we publish is
+       the shred we authenticated. */
+
+    FD_COMPILER_MFENCE();
+    ulong in_chunk = (ulong)in_mline->chunk;
+    ulong sz       = (ulong)in_mline->sz;
+    ulong tsorig   = (ulong)in_mline->tsorig;
+    FD_COMPILER_MFENCE();
+
+    uchar * shred = (uchar *)fd_chunk_to_laddr( base, chunk );
+    int     bad   = (sz!=hdr_sz+FD_SHRED_SZ);
+    if( FD_LIKELY( !bad ) ) fd_memcpy( shred, (uchar const *)fd_chunk_to_laddr_const( in_wksp, in_chunk ) + hdr_sz, FD_SHRED_SZ );
+
+    FD_COMPILER_MFENCE();
+    ulong seq_test = in_mline->seq;
+    FD_COMPILER_MFENCE();
+
+    if( FD_UNLIKELY( fd_seq_ne( seq_test, seq_found ) ) ) { /* Overrun while reading (impossible if in honoring our fctl) */
+      in_seq   = seq_test; /* Resume from here (probably reasonably current, could query in mcache sync instead) */
+      in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+      in_accum[ FD_FSEQ_DIAG_OVRNR_CNT ]++;
+      now = fd_tickcount();
+      continue;
+    }
+
+    /* Filter malformed shreds, duplicates (cheap) and then shreds that
+       fail authentication (expensive).  We only insert into the tcache
+       after authentication. */
+
+    ulong leaf_idx = bad ? ULONG_MAX : fd_shred_ingest_leaf_idx( shred );
+    ulong tag      = 0UL;
+    do {
+
+      if( FD_UNLIKELY( leaf_idx==ULONG_MAX ) ) { bad = 1; cnc_diag_parse_filt_cnt++; break; }
+
+      fd_shred_t const * hdr     = (fd_shred_t const *)shred;
+      int                is_code = (fd_shred_type( hdr->variant )==FD_SHRED_TYPE_MERKLE_CODE);
+      tag = fd_shred_ingest_tag( hdr->slot, hdr->idx, is_code );
+
+      int   found;
+      ulong map_idx;
+      FD_TCACHE_QUERY( found, map_idx, _tcache_map, tcache_map_cnt, tag );
+      (void)map_idx;
+      if( FD_UNLIKELY( found ) ) { bad = 1; cnc_diag_dup_filt_cnt++; break; }
+
+      /* The shred is authentic if its leaf and inclusion proof yield
+         the Merkle root it carries and the leader signed that root. */
+
+      fd_shred_merkle_t const * node = fd_shred_merkle_nodes( hdr );
+      uchar const *             root = node[0];
+
+      fd_bmtree20_node_t leaf[1];
+      fd_bmtree20_hash_leaf( leaf, shred + FD_ED25519_SIG_SZ, fd_shred_merkle_off( hdr->variant ) - FD_ED25519_SIG_SZ );
+      if( FD_UNLIKELY( !fd_bmtree20_proof_verify( root, leaf, leaf_idx, node[1], fd_shred_merkle_cnt( hdr->variant )-1UL ) ) ) {
+        bad = 1; cnc_diag_proof_filt_cnt++;
+        break;
+      }
+
+      fd_shred_ingest_set_t * this_set = set + fd_shred_ingest_set_idx( hdr->slot, hdr->fec_set_idx );
+      int hit = (this_set->used==1U)                                                    &
+                (this_set->slot       ==hdr->slot       )                              &
+                (this_set->fec_set_idx==hdr->fec_set_idx)                              &
+                !memcmp( this_set->root,      root,           FD_SHRED_MERKLE_NODE_SZ ) &
+                !memcmp( this_set->signature, hdr->signature, FD_ED25519_SIG_SZ       );
+      if( FD_LIKELY( hit ) ) { cnc_diag_sig_hit_cnt++; break; }
+
+      cnc_diag_sig_cnt++;
+      if( FD_UNLIKELY( fd_ed25519_verify( root, FD_SHRED_MERKLE_NODE_SZ, hdr->signature, pubkey, sha )!=FD_ED25519_SUCCESS ) ) {
+        bad = 1; cnc_diag_sig_filt_cnt++;
+        break;
+      }
+
+      this_set->slot        = hdr->slot;
+      this_set->fec_set_idx = hdr->fec_set_idx;
+      this_set->used        = 1U;
+      fd_memcpy( this_set->root,      root,           FD_SHRED_MERKLE_NODE_SZ );
+      fd_memcpy( this_set->signature, hdr->signature, FD_ED25519_SIG_SZ       );
+
+    } while(0);
+
+    now = fd_tickcount();
+
+    if( FD_LIKELY( !bad ) ) {
+      int is_dup;
+      FD_TCACHE_INSERT( is_dup, tcache_sync, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, tag );
+      (void)is_dup; /* Not a dup, queried above */
+
+      ulong ctl   = fd_frag_meta_ctl( orig, 1 /*som*/, 1 /*eom*/, 0 /*err*/ );
+      ulong tspub = fd_frag_meta_ts_comp( now );
+      fd_mcache_publish( mcache, depth, seq, tag, chunk, FD_SHRED_SZ, ctl, tsorig, tspub );
+
+      chunk = fd_dcache_compact_next( chunk, FD_SHRED_SZ, chunk0, wmark );
+      seq   = fd_seq_inc( seq, 1UL );
+      cr_avail--;
+    }
+
+    /* Windup for the next in poll and accumulate diagnostics */
+
+    in_seq   = fd_seq_inc( in_seq, 1UL );
+    in_mline = in_mcache + fd_mcache_line_idx( in_seq, in_depth );
+
+    ulong diag_idx = FD_FSEQ_DIAG_PUB_CNT + 2UL*(ulong)bad;
+    in_accum[ diag_idx     ]++;
+    in_accum[ diag_idx+1UL ] += sz;
+  }
+
+  do {
+
+    FD_LOG_INFO(( "Halting shred ingest" ));
+
+    fd_fctl_rx_cr_return( in_fseq, in_seq );
+
+    FD_LOG_INFO(( "Destroying fctl" ));
+    fd_fctl_delete( fd_fctl_leave( fctl ) );
+
+    FD_LOG_INFO(( "Destroying sha" ));
+    fd_sha512_delete( fd_sha512_leave( sha ) );
+
+    FD_LOG_INFO(( "Halted shred ingest" ));
+    fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
+
+  } while(0);
+
+  return 0;
+}
+
+#undef SCRATCH_ALLOC
+
+#endif
@@ -0,0 +1,497 @@
+#include "../fd_disco.h"
+
+#if FD_HAS_HOSTED && FD_HAS_X86
+
+#include "../../ballet/fd_ballet.h"
+
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_SIGNAL_ACK==4UL, unit_test );
+
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_DIAG_PARSE_FILT_CNT==2UL, unit_test );
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_DIAG_DUP_FILT_CNT  ==3UL, unit_test );
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_DIAG_PROOF_FILT_CNT==4UL, unit_test );
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_DIAG_SIG_FILT_CNT  ==5UL, unit_test );
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_DIAG_SIG_CNT       ==6UL, unit_test );
+FD_STATIC_ASSERT( FD_SHRED_INGEST_CNC_DIAG_SIG_HIT_CNT   ==7UL, unit_test );
+
+FD_STATIC_ASSERT( FD_SHRED_INGEST_TILE_OUT_MAX==8192UL, unit_test );
+
+FD_STATIC_ASSERT( FD_SHRED_INGEST_TILE_SCRATCH_ALIGN==128UL, unit_test );
+
+/* The tx tile replays a precomputed list of frags (shreds behind HDR_SZ
+   bytes of junk headers, interleaved with duplicates, forgeries and
+   garbage) into the shred ingest tile.  The rx tile checks that exactly
+   the genuine shreds come out, once each and in order. */
+
+#define HDR_SZ    (42UL)
+#define TX_MTU    (HDR_SZ+FD_SHRED_SZ+1UL)
+#define SHRED_MAX (1024UL)
+#define FRAG_MAX  (2048UL)
+
+static uchar shred  [ SHRED_MAX ][ FD_SHRED_SZ ]; /* Genuine shreds in the order they are expected downstream */
+static uchar tx_frag[ FRAG_MAX  ][ TX_MTU      ];
+static ulong tx_sz  [ FRAG_MAX  ];
+static uchar batch  [ 1UL<<17 ];
+
+static uchar scratch[ FD_SHRED_INGEST_TILE_SCRATCH_FOOTPRINT( 1UL ) ] __attribute__((aligned( FD_SHRED_INGEST_TILE_SCRATCH_ALIGN )));
+
+struct test_cfg {
+  fd_wksp_t *      wksp;
+
+  ulong            shred_cnt;
+  ulong            frag_cnt;
+  uchar            leader[ 32 ];
+
+  fd_cnc_t *       tx_cnc;
+  fd_frag_meta_t * tx_mcache;
+  uchar *          tx_dcache;
+
+  fd_cnc_t *       ingest_cnc;
+  ulong *          ingest_in_fseq;
+  fd_tcache_t *    ingest_tcache;
+  fd_frag_meta_t * ingest_mcache;
+  uchar *          ingest_dcache;
+  uint             ingest_seed;
+
+  fd_cnc_t *       rx_cnc;
+  ulong *          rx_fseq;
+  ulong            rx_cnt;
+};
+
+typedef struct test_cfg test_cfg_t;
+
+/* TX tile ************************************************************/
+
+static int
+tx_tile_main( int     argc,
+              char ** argv ) {
+  (void)argc;
+  test_cfg_t * cfg = (test_cfg_t *)argv;
+
+  fd_frag_meta_t * mcache  = cfg->tx_mcache;
+  ulong            depth   = fd_mcache_depth( mcache );
+  ulong            seq     = fd_mcache_seq_query( fd_mcache_seq_laddr( mcache ) );
+  ulong const *    fseq    = cfg->ingest_in_fseq;
+  uchar *          dcache  = cfg->tx_dcache;
+  ulong            chunk0  = fd_dcache_compact_chunk0( cfg->wksp, dcache );
+  ulong            wmark   = fd_dcache_compact_wmark ( cfg->wksp, dcache, TX_MTU );
+  ulong            chunk   = chunk0;
+
+  fd_cnc_signal( cfg->tx_cnc, FD_CNC_SIGNAL_RUN );
+
+  for( ulong frag_idx=0UL; frag_idx<cfg->frag_cnt; frag_idx++ ) {
+    while( fd_seq_diff( seq, fd_fseq_query( fseq ) )>=(long)depth ) FD_SPIN_PAUSE(); /* Wait for credits */
+    ulong sz = tx_sz[ frag_idx ];
+    fd_memcpy( fd_chunk_to_laddr( cfg->wksp, chunk ), tx_frag[ frag_idx ], sz );
+    ulong ts = fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_mcache_publish( mcache, depth, seq, 0UL, chunk, sz, fd_frag_meta_ctl( 0UL, 1, 1, 0 ), ts, ts );
+    chunk = fd_dcache_compact_next( chunk, sz, chunk0, wmark );
+    seq   = fd_seq_inc( seq, 1UL );
+  }
+  fd_mcache_seq_update( fd_mcache_seq_laddr( mcache ), seq );
+
+  fd_cnc_signal( cfg->tx_cnc, FD_CNC_SIGNAL_BOOT );
+  return 0;
+}
+
+/* INGEST tile ********************************************************/
+
+static int
+ingest_tile_main( int     argc,
+                  char ** argv ) {
+  (void)argc;
+  test_cfg_t * cfg = (test_cfg_t *)argv;
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, cfg->ingest_seed, 0UL ) );
+
+  FD_TEST( !fd_shred_ingest_tile( cfg->ingest_cnc, 1UL, cfg->tx_mcache, cfg->ingest_in_fseq, HDR_SZ, cfg->leader,
+                                  cfg->ingest_tcache, cfg->ingest_mcache, cfg->ingest_dcache, 1UL, &cfg->rx_fseq,
+                                  0UL, 0L, rng, scratch ) );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return 0;
+}
+
+/* RX tile ************************************************************/
+
+static int
+rx_tile_main( int     argc,
+              char ** argv ) {
+  (void)argc;
+  test_cfg_t * cfg = (test_cfg_t *)argv;
+
+  fd_cnc_t *             cnc    = cfg->rx_cnc;
+  fd_frag_meta_t const * mcache = cfg->ingest_mcache;
+  ulong                  depth  = fd_mcache_depth( mcache );
+  ulong                  seq    = fd_mcache_seq_query( fd_mcache_seq_laddr_const( mcache ) );
+  ulong *                fseq   = cfg->rx_fseq;
+  ulong                  rx_cnt = 0UL;
+
+  ulong async_rem = 1UL; /* Do housekeeping on first iteration */
+
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
+  for(;;) {
+
+    fd_frag_meta_t const * mline;
+    ulong                  seq_found;
+    long                   diff;
+
+    ulong sig;
+    ulong chunk;
+    ulong sz;
+    ulong ctl;
+    ulong tsorig;
+    ulong tspub;
+    FD_MCACHE_WAIT_REG( sig, chunk, sz, ctl, tsorig, tspub, mline, seq_found, diff, async_rem, mcache, depth, seq );
+    if( FD_UNLIKELY( !async_rem ) ) {
+      fd_fctl_rx_cr_return( fseq, seq );
+      FD_COMPILER_MFENCE();
+      FD_VOLATILE( cfg->rx_cnt ) = rx_cnt;
+      FD_COMPILER_MFENCE();
+      ulong s = fd_cnc_signal_query( cnc );
+      if( FD_UNLIKELY( s!=FD_CNC_SIGNAL_RUN ) ) {
+        if( FD_UNLIKELY( s!=FD_CNC_SIGNAL_HALT ) ) FD_LOG_ERR(( "Unexpected signal" ));
+        break;
+      }
+      async_rem = 1024UL;
+      continue;
+    }
+
+    if( FD_UNLIKELY( diff ) ) FD_LOG_ERR(( "Overrun while polling" ));
+
+    /* Check we got the next genuine shred */
+
+    (void)tsorig; (void)tspub;
+    FD_TEST( rx_cnt<cfg->shred_cnt );
+    FD_TEST( sz==FD_SHRED_SZ );
+    FD_TEST( fd_frag_meta_ctl_orig( ctl )==1UL );
+    FD_TEST( sig );
+    FD_TEST( !memcmp( fd_chunk_to_laddr_const( cfg->wksp, chunk ), shred[ rx_cnt ], FD_SHRED_SZ ) );
+
+    seq_found = fd_frag_meta_seq_query( mline );
+    if( FD_UNLIKELY( fd_seq_ne( seq_found, seq ) ) ) FD_LOG_ERR(( "Overrun while reading" ));
+
+    rx_cnt++;
+    seq = fd_seq_inc( seq, 1UL );
+  }
+
+  fd_cnc_signal( cnc, FD_CNC_SIGNAL_BOOT );
+  return 0;
+}
+
+/* Workload ***********************************************************/
+
+static void
+tx_push( test_cfg_t *  cfg,
+         fd_rng_t *    rng,
+         uchar const * buf,
+         ulong         buf_sz ) {
+  FD_TEST( cfg->frag_cnt<FRAG_MAX );
+  uchar * frag = tx_frag[ cfg->frag_cnt ];
+  for( ulong b=0UL; b<HDR_SZ; b++ ) frag[b] = fd_rng_uchar( rng );
+  fd_memcpy( frag + HDR_SZ, buf, buf_sz );
+  tx_sz[ cfg->frag_cnt ] = HDR_SZ + buf_sz;
+  cfg->frag_cnt++;
+}
+
+/* shred_batch shreds a batch of batch_sz bytes for slot with shredder
+   and appends the shreds to the tx workload.  If genuine, the shreds
+   are also appended to the expected output and every shred is mixed
+   with a forgery or garbage now and then.  Returns the number of FEC
+   sets. */
+
+static ulong
+shred_batch( test_cfg_t *    cfg,
+             fd_rng_t *      rng,
+             fd_shredder_t * shredder,
+             ulong           slot,
+             ulong           batch_sz,
+             int             genuine,
+             ulong *         diag ) {
+  fd_shredder_batch_meta_t meta[1] = {{ .slot = slot, .parent_off = 1, .version = 1, .ref_tick = 0, .block_complete = 0 }};
+  FD_TEST( fd_shredder_init_batch( shredder, batch, batch_sz, meta ) );
+
+  static uchar set_mem[ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+FD_SHREDDER_PARITY_SHREDS_MAX ][ FD_SHRED_SZ ];
+  uchar * data_shred  [ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET ];
+  uchar * parity_shred[ FD_SHREDDER_PARITY_SHREDS_MAX       ];
+  for( ulong j=0UL; j<FD_SHREDDER_DATA_SHREDS_PER_FEC_SET; j++ ) data_shred  [j] = set_mem[ j ];
+  for( ulong j=0UL; j<FD_SHREDDER_PARITY_SHREDS_MAX;       j++ ) parity_shred[j] = set_mem[ FD_SHREDDER_DATA_SHREDS_PER_FEC_SET+j ];
+
+  ulong set_cnt = 0UL;
+  fd_shredder_fec_set_t fec[1];
+  while( fd_shredder_next_fec_set( shredder, data_shred, parity_shred, fec ) ) {
+    ulong d = fec->data_shred_cnt;
+    ulong n = d + fec->parity_shred_cnt;
+    set_cnt++;
+    for( ulong k=0UL; k<n; k++ ) {
+      uchar const * buf = k<d ? data_shred[k] : parity_shred[k-d];
+
+      if( !genuine ) { tx_push( cfg, rng, buf, FD_SHRED_SZ ); diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_FILT_CNT ]++; diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_CNT ]++; continue; }
+
+      uchar tmp[ FD_SHRED_SZ ];
+      switch( fd_rng_uint_roll( rng, 8U ) ) {
+      case 0U: /* Forged payload ahead of the genuine shred */
+        fd_memcpy( tmp, buf, FD_SHRED_SZ );
+        tmp[ FD_SHRED_CODE_HEADER_SZ + fd_rng_ulong_roll( rng, 256UL ) ]++;
+        tx_push( cfg, rng, tmp, FD_SHRED_SZ );
+        diag[ FD_SHRED_INGEST_CNC_DIAG_PROOF_FILT_CNT ]++;
+        break;
+      case 1U: /* Forged signature ahead of the genuine shred */
+        fd_memcpy( tmp, buf, FD_SHRED_SZ );
+        tmp[ fd_rng_ulong_roll( rng, FD_ED25519_SIG_SZ ) ]++;
+        tx_push( cfg, rng, tmp, FD_SHRED_SZ );
+        diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_FILT_CNT ]++;
+        diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_CNT      ]++;
+        break;
+      case 2U: /* Truncated and legacy shreds */
+        tx_push( cfg, rng, buf, FD_SHRED_SZ-1UL );
+        fd_memcpy( tmp, buf, FD_SHRED_SZ );
+        tmp[ 0x40 ] = (uchar)0xa5;
+        tx_push( cfg, rng, tmp, FD_SHRED_SZ );
+        diag[ FD_SHRED_INGEST_CNC_DIAG_PARSE_FILT_CNT ] += 2UL;
+        break;
+      default:
+        break;
+      }
+
+      tx_push( cfg, rng, buf, FD_SHRED_SZ );
+      FD_TEST( cfg->shred_cnt<SHRED_MAX );
+      fd_memcpy( shred[ cfg->shred_cnt++ ], buf, FD_SHRED_SZ );
+
+      if( !fd_rng_uint_roll( rng, 8U ) ) { tx_push( cfg, rng, buf, FD_SHRED_SZ ); diag[ FD_SHRED_INGEST_CNC_DIAG_DUP_FILT_CNT ]++; }
+    }
+    if( genuine ) {
+      diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_CNT     ]++;
+      diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_HIT_CNT ] += n-1UL;
+    }
+  }
+  return set_cnt;
+}
+
+/* MAIN tail **********************************************************/
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  uint rng_seq = 0U;
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seq++, 0UL ) );
+
+  FD_TEST( fd_shred_ingest_tile_scratch_align()==FD_SHRED_INGEST_TILE_SCRATCH_ALIGN );
+  FD_TEST( !fd_shred_ingest_tile_scratch_footprint( FD_SHRED_INGEST_TILE_OUT_MAX+1UL ) );
+  for( ulong iter_rem=10000000UL; iter_rem; iter_rem-- ) {
+    ulong out_cnt = fd_rng_ulong_roll( rng, FD_SHRED_INGEST_TILE_OUT_MAX+1UL );
+    FD_TEST( fd_shred_ingest_tile_scratch_footprint( out_cnt )==FD_SHRED_INGEST_TILE_SCRATCH_FOOTPRINT( out_cnt ) );
+  }
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                          );
+  ulong        numa_idx  = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        depth     = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",    NULL, 128UL                        );
+  long         duration  = fd_env_strip_cmdline_long ( &argc, &argv, "--duration", NULL, (long)10e9                   );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  if( FD_UNLIKELY( fd_tile_cnt()<4UL ) ) FD_LOG_ERR(( "this unit test requires at least 4 tiles" ));
+
+  long  hb0  = fd_tickcount();
+  ulong seq0 = fd_rng_ulong( rng );
+
+  static test_cfg_t cfg[1];
+
+  /* Generate the workload: a few slots of genuine shreds (mixed with
+     garbage, forgeries and duplicates) and a batch signed by somebody
+     else than the leader. */
+
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+  uchar private_key[ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( cfg->leader, private_key, sha );
+  fd_shredder_t _leader[1];
+  fd_shredder_t * leader = fd_shredder_join( fd_shredder_new( _leader, cfg->leader, private_key ) ); FD_TEST( leader );
+
+  uchar imposter_key[ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( imposter_key, private_key, sha );
+  fd_shredder_t _imposter[1];
+  fd_shredder_t * imposter = fd_shredder_join( fd_shredder_new( _imposter, imposter_key, private_key ) ); FD_TEST( imposter );
+
+  for( ulong b=0UL; b<sizeof(batch); b++ ) batch[b] = fd_rng_uchar( rng );
+
+  ulong diag[ 8 ] = {0};
+  ulong set_cnt = 0UL;
+  set_cnt += shred_batch( cfg, rng, leader,   1UL,  50000UL, 1, diag );
+  set_cnt += shred_batch( cfg, rng, leader,   1UL,      0UL, 1, diag );
+  set_cnt += shred_batch( cfg, rng, imposter, 2UL,  10000UL, 0, diag );
+  set_cnt += shred_batch( cfg, rng, leader,   2UL, 100000UL, 1, diag );
+  FD_LOG_NOTICE(( "%lu FEC sets, %lu genuine shreds, %lu frags", set_cnt, cfg->shred_cnt, cfg->frag_cnt ));
+
+  /* A replay of everything (after the sets got verified) is all
+     duplicates */
+
+  ulong replay_cnt = cfg->frag_cnt;
+  for( ulong frag_idx=0UL; frag_idx<replay_cnt; frag_idx++ ) {
+    if( tx_sz[ frag_idx ]!=HDR_SZ+FD_SHRED_SZ || tx_frag[ frag_idx ][ HDR_SZ+0x40 ]==(uchar)0xa5 ) continue;
+    uchar tmp[ FD_SHRED_SZ ];
+    fd_memcpy( tmp, tx_frag[ frag_idx ] + HDR_SZ, FD_SHRED_SZ );
+    tx_push( cfg, rng, tmp, FD_SHRED_SZ );
+  }
+  ulong replay_filt_cnt = cfg->frag_cnt - replay_cnt;
+
+  fd_shredder_delete( fd_shredder_leave( imposter ) );
+  fd_shredder_delete( fd_shredder_leave( leader   ) );
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+
+  /* Create the IPC objects */
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+  cfg->wksp = wksp;
+
+  cfg->tx_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( wksp, fd_cnc_align(), fd_cnc_footprint( 64UL ), 1UL ),
+                                         64UL, 0UL, hb0 ) );
+  FD_TEST( cfg->tx_cnc );
+  cfg->tx_mcache = fd_mcache_join( fd_mcache_new( fd_wksp_alloc_laddr( wksp, fd_mcache_align(), fd_mcache_footprint( depth, 0UL ),
+                                                                       1UL ),
+                                                  depth, 0UL, seq0 ) );
+  FD_TEST( cfg->tx_mcache );
+  ulong tx_data_sz = fd_dcache_req_data_sz( TX_MTU, depth, 1UL, 1 ); FD_TEST( tx_data_sz );
+  cfg->tx_dcache = fd_dcache_join( fd_dcache_new( fd_wksp_alloc_laddr( wksp, fd_dcache_align(), fd_dcache_footprint( tx_data_sz, 0UL ),
+                                                                       1UL ),
+                                                  tx_data_sz, 0UL ) );
+  FD_TEST( cfg->tx_dcache );
+
+  cfg->ingest_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( wksp, fd_cnc_align(), fd_cnc_footprint( 64UL ), 1UL ),
+                                             64UL, 1UL, hb0 ) );
+  FD_TEST( cfg->ingest_cnc );
+  cfg->ingest_in_fseq = fd_fseq_join( fd_fseq_new( fd_wksp_alloc_laddr( wksp, fd_fseq_align(), fd_fseq_footprint(), 1UL ), seq0 ) );
+  FD_TEST( cfg->ingest_in_fseq );
+  ulong tcache_map_cnt = fd_tcache_map_cnt_default( 4096UL );
+  cfg->ingest_tcache = fd_tcache_join( fd_tcache_new( fd_wksp_alloc_laddr( wksp, fd_tcache_align(),
+                                                                           fd_tcache_footprint( 4096UL, tcache_map_cnt ), 1UL ),
+                                                      4096UL, tcache_map_cnt ) );
+  FD_TEST( cfg->ingest_tcache );
+  cfg->ingest_mcache = fd_mcache_join( fd_mcache_new( fd_wksp_alloc_laddr( wksp, fd_mcache_align(),
+                                                                           fd_mcache_footprint( depth, 0UL ), 1UL ),
+                                                      depth, 0UL, seq0 ) );
+  FD_TEST( cfg->ingest_mcache );
+  ulong data_sz = fd_dcache_req_data_sz( FD_SHRED_SZ, depth, 1UL, 1 ); FD_TEST( data_sz );
+  cfg->ingest_dcache = fd_dcache_join( fd_dcache_new( fd_wksp_alloc_laddr( wksp, fd_dcache_align(),
+                                                                           fd_dcache_footprint( data_sz, 0UL ), 1UL ),
+                                                      data_sz, 0UL ) );
+  FD_TEST( cfg->ingest_dcache );
+  cfg->ingest_seed = rng_seq++;
+
+  cfg->rx_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( wksp, fd_cnc_align(), fd_cnc_footprint( 64UL ), 1UL ),
+                                         64UL, 2UL, hb0 ) );
+  FD_TEST( cfg->rx_cnc );
+  cfg->rx_fseq = fd_fseq_join( fd_fseq_new( fd_wksp_alloc_laddr( wksp, fd_fseq_align(), fd_fseq_footprint(), 1UL ), seq0 ) );
+  FD_TEST( cfg->rx_fseq );
+  cfg->rx_cnt = 0UL;
+
+  /* Run the workload through the tiles */
+
+  FD_LOG_NOTICE(( "Booting" ));
+
+  fd_tile_exec_t * rx_exec     = fd_tile_exec_new( 3UL, rx_tile_main,     0, (char **)fd_type_pun( cfg ) ); FD_TEST( rx_exec     );
+  fd_tile_exec_t * ingest_exec = fd_tile_exec_new( 2UL, ingest_tile_main, 0, (char **)fd_type_pun( cfg ) ); FD_TEST( ingest_exec );
+  FD_TEST( fd_cnc_wait( cfg->rx_cnc,     FD_CNC_SIGNAL_BOOT, (long)5e9, NULL )==FD_CNC_SIGNAL_RUN );
+  FD_TEST( fd_cnc_wait( cfg->ingest_cnc, FD_CNC_SIGNAL_BOOT, (long)5e9, NULL )==FD_CNC_SIGNAL_RUN );
+  fd_tile_exec_t * tx_exec     = fd_tile_exec_new( 1UL, tx_tile_main,     0, (char **)fd_type_pun( cfg ) ); FD_TEST( tx_exec     );
+
+  FD_LOG_NOTICE(( "Running (--duration %li ns, --depth %lu)", duration, depth ));
+
+  long done = fd_log_wallclock() + duration;
+  for(;;) {
+    FD_COMPILER_MFENCE();
+    ulong rx_cnt = FD_VOLATILE_CONST( cfg->rx_cnt );
+    FD_COMPILER_MFENCE();
+    if( rx_cnt==cfg->shred_cnt ) break;
+    if( FD_UNLIKELY( (fd_log_wallclock()-done)>=0L ) ) FD_LOG_ERR(( "only %lu of %lu shreds received", rx_cnt, cfg->shred_cnt ));
+    FD_YIELD();
+  }
+  FD_TEST( fd_cnc_wait( cfg->tx_cnc, FD_CNC_SIGNAL_RUN, (long)5e9, NULL )==FD_CNC_SIGNAL_BOOT );
+
+  /* Wait for the ingest to return all its credits (it has consumed the
+     whole workload) */
+
+  for(;;) {
+    if( fd_seq_diff( fd_fseq_query( cfg->ingest_in_fseq ), seq0 )==(long)cfg->frag_cnt ) break;
+    if( FD_UNLIKELY( (fd_log_wallclock()-done)>=0L ) ) FD_LOG_ERR(( "ingest did not consume the workload" ));
+    FD_YIELD();
+  }
+
+  FD_LOG_NOTICE(( "Halting" ));
+
+  FD_TEST( !fd_cnc_open( cfg->ingest_cnc ) );
+  FD_TEST( !fd_cnc_open( cfg->rx_cnc     ) );
+
+  fd_cnc_signal( cfg->ingest_cnc, FD_CNC_SIGNAL_HALT );
+  FD_TEST( fd_cnc_wait( cfg->ingest_cnc, FD_CNC_SIGNAL_HALT, (long)5e9, NULL )==FD_CNC_SIGNAL_BOOT );
+  fd_cnc_signal( cfg->rx_cnc, FD_CNC_SIGNAL_HALT );
+  FD_TEST( fd_cnc_wait( cfg->rx_cnc,     FD_CNC_SIGNAL_HALT, (long)5e9, NULL )==FD_CNC_SIGNAL_BOOT );
+
+  fd_cnc_close( cfg->ingest_cnc );
+  fd_cnc_close( cfg->rx_cnc     );
+
+  int ret;
+  FD_TEST( !fd_tile_exec_delete( tx_exec,     &ret ) ); FD_TEST( !ret );
+  FD_TEST( !fd_tile_exec_delete( ingest_exec, &ret ) ); FD_TEST( !ret );
+  FD_TEST( !fd_tile_exec_delete( rx_exec,     &ret ) ); FD_TEST( !ret );
+
+  /* Check the filter diagnostics (flushed by the ingest on halt) */
+
+  ulong const * cnc_diag = (ulong const *)fd_cnc_app_laddr_const( cfg->ingest_cnc );
+  ulong const * in_diag  = (ulong const *)fd_fseq_app_laddr_const( cfg->ingest_in_fseq );
+  diag[ FD_SHRED_INGEST_CNC_DIAG_DUP_FILT_CNT ] += replay_filt_cnt;
+  FD_LOG_NOTICE(( "parse_filt %lu dup_filt %lu proof_filt %lu sig_filt %lu sig %lu sig_hit %lu",
+                  cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_PARSE_FILT_CNT ], cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_DUP_FILT_CNT ],
+                  cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_PROOF_FILT_CNT ], cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_FILT_CNT ],
+                  cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_CNT        ], cnc_diag[ FD_SHRED_INGEST_CNC_DIAG_SIG_HIT_CNT  ] ));
+  for( ulong diag_idx=FD_SHRED_INGEST_CNC_DIAG_PARSE_FILT_CNT; diag_idx<=FD_SHRED_INGEST_CNC_DIAG_SIG_HIT_CNT; diag_idx++ )
+    FD_TEST( cnc_diag[ diag_idx ]==diag[ diag_idx ] );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_PUB_CNT   ]==cfg->shred_cnt                 );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_FILT_CNT  ]==cfg->frag_cnt-cfg->shred_cnt   );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_OVRNP_CNT ]==0UL                            );
+  FD_TEST( in_diag[ FD_FSEQ_DIAG_OVRNR_CNT ]==0UL                            );
+
+  FD_LOG_NOTICE(( "Cleaning up" ));
+
+  fd_wksp_free_laddr( fd_fseq_delete  ( fd_fseq_leave  ( cfg->rx_fseq        ) ) );
+  fd_wksp_free_laddr( fd_cnc_delete   ( fd_cnc_leave   ( cfg->rx_cnc         ) ) );
+  fd_wksp_free_laddr( fd_dcache_delete( fd_dcache_leave( cfg->ingest_dcache  ) ) );
+  fd_wksp_free_laddr( fd_mcache_delete( fd_mcache_leave( cfg->ingest_mcache  ) ) );
+  fd_wksp_free_laddr( fd_tcache_delete( fd_tcache_leave( cfg->ingest_tcache  ) ) );
+  fd_wksp_free_laddr( fd_fseq_delete  ( fd_fseq_leave  ( cfg->ingest_in_fseq ) ) );
+  fd_wksp_free_laddr( fd_cnc_delete   ( fd_cnc_leave   ( cfg->ingest_cnc     ) ) );
+  fd_wksp_free_laddr( fd_dcache_delete( fd_dcache_leave( cfg->tx_dcache      ) ) );
+  fd_wksp_free_laddr( fd_mcache_delete( fd_mcache_leave( cfg->tx_mcache      ) ) );
+  fd_wksp_free_laddr( fd_cnc_delete   ( fd_cnc_leave   ( cfg->tx_cnc         ) ) );
+
+  fd_wksp_delete_anonymous( wksp );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED and FD_HAS_X86 capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
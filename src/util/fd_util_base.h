@@ -155,6 +155,15 @@
 #define FD_HAS_AVX 0
 #endif
 
+/* FD_HAS_AVX512 indicates the target supports Intel AVX-512 style SIMD
+   (basically do the 512-bit wide parts of "x86intrin.h" work) with the
+   F, VL, BW, DQ and IFMA extensions (i.e. Ice Lake server and newer).
+   Implies FD_HAS_AVX. */
+
+#ifndef FD_HAS_AVX512
+#define FD_HAS_AVX512 0
+#endif
+
 /* Base development environment ***************************************/
 
 /* The functionality provided by these vanilla headers are always